@@ -0,0 +1,340 @@
+/***********************************************************************************************************************
+ * File Name    : pcdc_stream.c
+ * Description  : Contains data structures and functions used in pcdc_stream.c
+ **********************************************************************************************************************/
+
+/*
+* Copyright (c) 2024 Renesas Electronics Corporation and/or its affiliates
+*
+* SPDX-License-Identifier: BSD-3-Clause
+*/
+
+#include "usb_composite_thread.h"
+#include "common_utils.h"
+#include "pcdc_stream.h"
+
+/*******************************************************************************************************************//**
+ * @addtogroup pcdc_stream
+ * @{
+ **********************************************************************************************************************/
+
+/** Private macros **/
+#define MAX_PACKET_SIZE_HS_BULK     (512U)
+#define MAX_PACKET_SIZE_FS_BULK     (64U)
+#define DEVICE_ADDRESS              (0U)        /* Peripheral mode ignores the address */
+
+/** Private variables **/
+static uint8_t g_rx_buf[PCDC_STREAM_RX_BUF_NUM][PCDC_STREAM_READ_LEN] BSP_ALIGN_VARIABLE(4);
+static uint32_t g_rx_len[PCDC_STREAM_RX_BUF_NUM];     /* Bytes received into the buffer */
+static uint32_t g_rx_off[PCDC_STREAM_RX_BUF_NUM];     /* Bytes already moved to the TX ring */
+static uint32_t g_rx_idx = RESET_VALUE;               /* Buffer armed, or to be armed next */
+static bool g_rx_armed = false;
+static uint8_t g_tx_ring_buf[PCDC_STREAM_TX_RING_SIZE] BSP_ALIGN_VARIABLE(4);
+static pcdc_ring_t g_tx_ring = {g_tx_ring_buf, PCDC_STREAM_TX_RING_SIZE, RESET_VALUE, RESET_VALUE, RESET_VALUE, RESET_VALUE};
+static volatile bool g_tx_busy = false;
+static uint32_t g_tx_len = RESET_VALUE;
+static uint32_t g_max_packet_size = MAX_PACKET_SIZE_FS_BULK;
+static usb_ctrl_t * gp_ctrl = NULL;
+static pcdc_stream_stats_t g_stats;
+
+/** Private functions **/
+static fsp_err_t stream_pump(void);
+static fsp_err_t stream_tx_kick(void);
+static uint32_t ring_used(pcdc_ring_t const * p_ring);
+static uint32_t ring_span(pcdc_ring_t const * p_ring, uint8_t ** pp_data);
+static uint32_t ring_put(pcdc_ring_t * p_ring, uint8_t const * p_src, uint32_t size);
+
+/*******************************************************************************************************************//**
+ * @brief       Start the batched loopback once the device is configured.
+ * @param[IN]   p_ctrl    opened USB instance
+ * @retval      Any Other Error code apart from FSP_SUCCESS on Unsuccessful operation.
+ **********************************************************************************************************************/
+fsp_err_t pcdc_stream_start(usb_ctrl_t * p_ctrl)
+{
+    usb_info_t info = {RESET_VALUE};
+
+    memset(g_rx_len, RESET_VALUE, sizeof(g_rx_len));
+    memset(g_rx_off, RESET_VALUE, sizeof(g_rx_off));
+    memset(&g_stats, RESET_VALUE, sizeof(g_stats));
+    g_rx_idx          = RESET_VALUE;
+    g_rx_armed        = false;
+    g_tx_ring.head    = g_tx_ring.tail = g_tx_ring.reserve = RESET_VALUE;
+    g_tx_ring.writers = RESET_VALUE;
+    g_tx_busy         = false;
+
+    /* The ZLP avoidance in stream_tx_kick() needs the bulk max packet size of the negotiated speed */
+    if ((FSP_SUCCESS == R_USB_InfoGet(p_ctrl, &info, DEVICE_ADDRESS)) && (USB_SPEED_HS == info.speed))
+    {
+        g_max_packet_size = MAX_PACKET_SIZE_HS_BULK;
+    }
+    else
+    {
+        g_max_packet_size = MAX_PACKET_SIZE_FS_BULK;
+    }
+
+    gp_ctrl = p_ctrl;
+    return stream_pump();
+}
+
+/*******************************************************************************************************************//**
+ * @brief       Stop on detach or suspend. Data in flight is dropped.
+ * @param[IN]   None
+ * @retval      None
+ **********************************************************************************************************************/
+void pcdc_stream_stop(void)
+{
+    gp_ctrl = NULL;
+}
+
+/*******************************************************************************************************************//**
+ * @brief       Handle USB_STATUS_READ_COMPLETE. The other buffer is armed at once, if its data has been echoed, so
+ *              the host can keep sending while this buffer is moved to the TX ring.
+ * @param[IN]   p_event   USB event information
+ * @retval      Any Other Error code apart from FSP_SUCCESS on Unsuccessful operation.
+ **********************************************************************************************************************/
+fsp_err_t pcdc_stream_read_complete(usb_event_info_t const * p_event)
+{
+    uint32_t done = g_rx_idx;
+
+    if ((NULL == gp_ctrl) || (true != g_rx_armed))
+    {
+        return FSP_SUCCESS;
+    }
+
+    g_rx_armed     = false;
+    g_rx_len[done] = p_event->data_size;
+    g_rx_off[done] = RESET_VALUE;
+    g_rx_idx       = (done + 1U) % PCDC_STREAM_RX_BUF_NUM;
+    g_stats.rx_bytes += p_event->data_size;
+
+    return stream_pump();
+}
+
+/*******************************************************************************************************************//**
+ * @brief       Handle USB_STATUS_WRITE_COMPLETE. Releases the sent block and starts the next one.
+ * @param[IN]   p_event   USB event information
+ * @retval      Any Other Error code apart from FSP_SUCCESS on Unsuccessful operation.
+ **********************************************************************************************************************/
+fsp_err_t pcdc_stream_write_complete(usb_event_info_t const * p_event)
+{
+    FSP_PARAMETER_NOT_USED(p_event);
+
+    if ((NULL == gp_ctrl) || (true != g_tx_busy))
+    {
+        return FSP_SUCCESS;
+    }
+
+    g_stats.tx_bytes += g_tx_len;
+    g_tx_ring.tail   += g_tx_len;
+    g_tx_busy         = false;
+
+    /* TX ring space was freed, a read held back for lack of room can be resumed */
+    return stream_pump();
+}
+
+/*******************************************************************************************************************//**
+ * @brief       Queue application data (e.g. log output) for the host without blocking. May be called from another
+ *              task than the USB event task.
+ * @param[IN]   p_src     data to send
+ * @param[IN]   size      number of bytes
+ * @retval      number of bytes queued, less than size if the TX ring is full
+ **********************************************************************************************************************/
+uint32_t pcdc_stream_write(uint8_t const * p_src, uint32_t size)
+{
+    uint32_t queued = RESET_VALUE;
+
+    if (NULL == gp_ctrl)
+    {
+        return RESET_VALUE;
+    }
+
+    /* The loopback in the USB event task shares the TX ring, ring_put() serializes the producers */
+    queued = ring_put(&g_tx_ring, p_src, size);
+
+    stream_tx_kick();
+    return queued;
+}
+
+/*******************************************************************************************************************//**
+ * @brief       Report whether the stream is running.
+ * @param[IN]   None
+ * @retval      true after pcdc_stream_start() until pcdc_stream_stop()
+ **********************************************************************************************************************/
+bool pcdc_stream_active(void)
+{
+    return (NULL != gp_ctrl);
+}
+
+/*******************************************************************************************************************//**
+ * @brief       Copy the streaming counters.
+ * @param[IN]   p_stats   destination
+ * @retval      None
+ **********************************************************************************************************************/
+void pcdc_stream_stats_get(pcdc_stream_stats_t * p_stats)
+{
+    *p_stats = g_stats;
+}
+
+/*******************************************************************************************************************//**
+ * @brief       Move received data into the TX ring, oldest buffer first, then re-arm the read and the write.
+ *              A read is only armed into a buffer whose data has been echoed completely, so a full TX ring slows
+ *              the host down through NAK instead of losing data.
+ * @param[IN]   None
+ * @retval      Any Other Error code apart from FSP_SUCCESS on Unsuccessful operation.
+ **********************************************************************************************************************/
+static fsp_err_t stream_pump(void)
+{
+    fsp_err_t err   = FSP_SUCCESS;
+    uint32_t  buf   = RESET_VALUE;
+    uint32_t  moved = RESET_VALUE;
+
+    for (uint32_t cnt = RESET_VALUE; cnt < PCDC_STREAM_RX_BUF_NUM; cnt++)
+    {
+        buf = (g_rx_idx + cnt) % PCDC_STREAM_RX_BUF_NUM;
+        if (g_rx_off[buf] == g_rx_len[buf])
+        {
+            continue;
+        }
+
+        moved = ring_put(&g_tx_ring, &g_rx_buf[buf][g_rx_off[buf]], g_rx_len[buf] - g_rx_off[buf]);
+
+        g_rx_off[buf] += moved;
+        if (g_rx_off[buf] != g_rx_len[buf])
+        {
+            break;
+        }
+    }
+
+    if ((true != g_rx_armed) && (NULL != gp_ctrl))
+    {
+        if (g_rx_off[g_rx_idx] == g_rx_len[g_rx_idx])
+        {
+            err = R_USB_Read(gp_ctrl, g_rx_buf[g_rx_idx], PCDC_STREAM_READ_LEN, USB_CLASS_PCDC);
+            if (FSP_SUCCESS != err)
+            {
+                APP_ERR_PRINT("\r\nR_USB_Read API failed.\r\n");
+                return err;
+            }
+            g_rx_armed = true;
+        }
+        else
+        {
+            g_stats.rx_stalls++;
+        }
+    }
+
+    return stream_tx_kick();
+}
+
+/*******************************************************************************************************************//**
+ * @brief       Hand the next contiguous block of the TX ring to the driver if no write is in progress.
+ *              r_usb_basic does not terminate a write whose length is a multiple of the max packet size with a ZLP,
+ *              so the last byte of such a block is held back and opens the next block instead.
+ * @param[IN]   None
+ * @retval      Any Other Error code apart from FSP_SUCCESS on Unsuccessful operation.
+ **********************************************************************************************************************/
+static fsp_err_t stream_tx_kick(void)
+{
+    fsp_err_t err    = FSP_SUCCESS;
+    uint8_t * p_data = NULL;
+    uint32_t  len    = RESET_VALUE;
+
+    taskENTER_CRITICAL();
+    if ((true == g_tx_busy) || (NULL == gp_ctrl))
+    {
+        taskEXIT_CRITICAL();
+        return FSP_SUCCESS;
+    }
+    len = ring_span(&g_tx_ring, &p_data);
+    if (len > PCDC_STREAM_WRITE_MAX)
+    {
+        len = PCDC_STREAM_WRITE_MAX;
+    }
+    if ((RESET_VALUE != len) && (RESET_VALUE == (len % g_max_packet_size)))
+    {
+        len--;
+    }
+    if (RESET_VALUE != len)
+    {
+        g_tx_busy = true;
+        g_tx_len  = len;
+    }
+    taskEXIT_CRITICAL();
+
+    if (RESET_VALUE == len)
+    {
+        return FSP_SUCCESS;
+    }
+
+    err = R_USB_Write(gp_ctrl, p_data, len, USB_CLASS_PCDC);
+    if (FSP_SUCCESS != err)
+    {
+        APP_ERR_PRINT("\r\nR_USB_Write API failed.\r\n");
+        g_tx_busy = false;
+        return err;
+    }
+    g_stats.tx_writes++;
+    return FSP_SUCCESS;
+}
+
+/*******************************************************************************************************************//**
+ * @brief       Ring helpers. The producers claim space and publish head under the lock, the copy runs outside it, and
+ *              the consumer only writes tail. The data barrier orders the payload against the index update.
+ **********************************************************************************************************************/
+static uint32_t ring_used(pcdc_ring_t const * p_ring)
+{
+    return p_ring->head - p_ring->tail;
+}
+
+static uint32_t ring_span(pcdc_ring_t const * p_ring, uint8_t ** pp_data)
+{
+    uint32_t used   = ring_used(p_ring);
+    uint32_t offset = p_ring->tail & (p_ring->size - 1U);
+    uint32_t span   = p_ring->size - offset;
+
+    *pp_data = &p_ring->p_buf[offset];
+    return (used < span) ? used : span;
+}
+
+static uint32_t ring_put(pcdc_ring_t * p_ring, uint8_t const * p_src, uint32_t size)
+{
+    uint32_t offset = RESET_VALUE;
+    uint32_t space  = RESET_VALUE;
+    uint32_t first  = RESET_VALUE;
+
+    /* Only claim the space under the lock, the copy into it runs with interrupts enabled */
+    taskENTER_CRITICAL();
+    space = p_ring->size - (p_ring->reserve - p_ring->tail);
+    if (size > space)
+    {
+        size = space;
+    }
+    offset           = p_ring->reserve & (p_ring->size - 1U);
+    p_ring->reserve += size;
+    p_ring->writers++;
+    taskEXIT_CRITICAL();
+
+    first = p_ring->size - offset;
+    if (first > size)
+    {
+        first = size;
+    }
+    memcpy(&p_ring->p_buf[offset], p_src, first);
+    memcpy(&p_ring->p_buf[RESET_VALUE], p_src + first, size - first);
+
+    /* The last producer to finish publishes the space claimed by all of them */
+    taskENTER_CRITICAL();
+    p_ring->writers--;
+    if (RESET_VALUE == p_ring->writers)
+    {
+        __DMB();
+        p_ring->head = p_ring->reserve;
+    }
+    taskEXIT_CRITICAL();
+
+    return size;
+}
+
+/*******************************************************************************************************************//**
+ * @} (end addtogroup pcdc_stream)
+ **********************************************************************************************************************/
@@ -0,0 +1,52 @@
+/***********************************************************************************************************************
+ * File Name    : pcdc_stream.h
+ * Description  : Contains data structures and functions used in pcdc_stream.c
+ **********************************************************************************************************************/
+
+/*
+* Copyright (c) 2024 Renesas Electronics Corporation and/or its affiliates
+*
+* SPDX-License-Identifier: BSD-3-Clause
+*/
+
+#ifndef PCDC_STREAM_H_
+#define PCDC_STREAM_H_
+
+#include "hal_data.h"
+
+/** Macros definitions **/
+#define PCDC_STREAM_READ_LEN        (4096U)     /* Bytes per R_USB_Read, two reads are double buffered */
+#define PCDC_STREAM_TX_RING_SIZE    (16384U)    /* Must be a power of two */
+#define PCDC_STREAM_WRITE_MAX       (8192U)     /* Bytes per R_USB_Write */
+#define PCDC_STREAM_RX_BUF_NUM      (2U)
+
+/** Multiple producer / single consumer byte ring. Indexes run freely and are masked on access. **/
+typedef struct st_pcdc_ring
+{
+    uint8_t         * p_buf;
+    uint32_t          size;
+    volatile uint32_t head;    /* End of the data the consumer may take */
+    volatile uint32_t tail;    /* Written by the consumer only */
+    uint32_t          reserve; /* End of the space claimed by the producers, head once they are all done */
+    uint32_t          writers; /* Producers copying into the claimed space */
+} pcdc_ring_t;
+
+/** Streaming counters, accumulated since pcdc_stream_start() **/
+typedef struct st_pcdc_stream_stats
+{
+    uint32_t rx_bytes;         /* Bytes received from the host */
+    uint32_t tx_bytes;         /* Bytes sent to the host */
+    uint32_t rx_stalls;        /* Reads delayed because the TX ring had no room for the echo */
+    uint32_t tx_writes;        /* R_USB_Write requests */
+} pcdc_stream_stats_t;
+
+/** Function declarations **/
+fsp_err_t pcdc_stream_start(usb_ctrl_t * p_ctrl);
+void      pcdc_stream_stop(void);
+fsp_err_t pcdc_stream_read_complete(usb_event_info_t const * p_event);
+fsp_err_t pcdc_stream_write_complete(usb_event_info_t const * p_event);
+uint32_t  pcdc_stream_write(uint8_t const * p_src, uint32_t size);
+bool      pcdc_stream_active(void);
+void      pcdc_stream_stats_get(pcdc_stream_stats_t * p_stats);
+
+#endif /* PCDC_STREAM_H_ */
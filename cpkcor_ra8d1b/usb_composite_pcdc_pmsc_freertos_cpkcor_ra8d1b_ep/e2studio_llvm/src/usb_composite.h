@@ -27,6 +27,10 @@
 #define DATA_LEN                 (512U)                 // Data Length
 /* Led toggle delay */
 #define TOGGLE_DELAY             (5U)
+/* 1: batched echo through pcdc_stream.c for throughput tests, 0: per-packet echo */
+#define PCDC_STREAM_MODE         (1)
+/* Period of the throughput report in stream mode */
+#define STREAM_REPORT_MS         (1000U)
 
 
 #define EP_INFO                 "\r\nThis project demonstrates the basic functionality of USB Composite driver on Renesas RA MCUs\r\n" \
@@ -42,5 +46,6 @@
 fsp_err_t process_usb_events(void);                /* Process usb events */
 fsp_err_t usb_status_request(void);                /* Process usb status request */
 void handle_error(fsp_err_t err, char * err_str);  /* handle error */
+void stream_report(void);                          /* Print stream throughput */
 
 #endif /* USB_COMPOSITE_H_ */
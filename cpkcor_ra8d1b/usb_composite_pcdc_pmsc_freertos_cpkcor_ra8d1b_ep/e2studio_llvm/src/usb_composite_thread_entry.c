@@ -24,6 +24,7 @@
 #include "usb_composite_thread.h"
 #include "common_utils.h"
 #include "usb_composite.h"
+#include "pcdc_stream.h"
 
 /*******************************************************************************************************************//**
  * @addtogroup usb_composite_ep
@@ -37,6 +38,8 @@ static volatile bool g_err_flag = false;
 static bool  b_usb_attach = false;
 static bsp_io_level_t pin_level   = BSP_IO_LEVEL_LOW;
 static usb_pcdc_linecoding_t g_line_coding;
+static pcdc_stream_stats_t g_stream_last;
+static TickType_t g_stream_tick = RESET_VALUE;
 
 /* Board's user LED */
 extern bsp_leds_t g_bsp_leds;
@@ -63,6 +66,7 @@ void usb_composite_thread_entry(void *pvParameters)
     fsp_err_t err              = FSP_SUCCESS;
     fsp_pack_version_t version = { RESET_VALUE };
     BaseType_t err_queue       = pdFALSE;
+    TickType_t wait_ticks      = portMAX_DELAY;
 
     /* version get API for FLEX pack information */
     R_FSP_VersionGet(&version);
@@ -90,18 +94,34 @@ void usb_composite_thread_entry(void *pvParameters)
             handle_error(FSP_ERR_ABORTED, "\r\nError in sending usb event through queue\r\n");
         }
 
+        /* While streaming, wake up periodically to report the throughput */
+        wait_ticks = pcdc_stream_active() ? pdMS_TO_TICKS(STREAM_REPORT_MS) : portMAX_DELAY;
+
         /* Receive message from queue */
-        err_queue = xQueueReceive(g_event_queue, &p_usb_event,(portMAX_DELAY));
-        if(pdTRUE != err_queue)
+        err_queue = xQueueReceive(g_event_queue, &p_usb_event, wait_ticks);
+        if (pdTRUE != err_queue)
         {
-            handle_error(FSP_ERR_ABORTED, "\r\nError in receiving event through queue\r\n");
+            if (portMAX_DELAY == wait_ticks)
+            {
+                handle_error(FSP_ERR_ABORTED, "\r\nError in receiving event through queue\r\n");
+            }
+            stream_report();
+            continue;
         }
 
         /* process usb events */
         err = process_usb_events();
         handle_error(err, "\r\nprocess_usb_events failed.\r\n");
 
-        vTaskDelay (1);
+        if (pcdc_stream_active())
+        {
+            /* Completions are handled back to back, the next transfer is already queued */
+            stream_report();
+        }
+        else
+        {
+            vTaskDelay (1);
+        }
     }
 }
 
@@ -119,6 +139,14 @@ fsp_err_t process_usb_events(void)
         case USB_STATUS_CONFIGURED: /* Configured State */
         {
             APP_PRINT("USB Configured Successfully\r\n");
+            if (PCDC_STREAM_MODE)
+            {
+                /* Double buffered reads and ring buffered writes, see pcdc_stream.c */
+                err = pcdc_stream_start (&g_basic_ctrl);
+                g_stream_tick = xTaskGetTickCount();
+                memset (&g_stream_last, RESET_VALUE, sizeof(g_stream_last));
+                break;
+            }
             /* Read data from tera term */
             err = R_USB_Read (&g_basic_ctrl, g_buf, DATA_LEN, USB_CLASS_PCDC);
             if (FSP_SUCCESS != err)
@@ -130,6 +158,11 @@ fsp_err_t process_usb_events(void)
 
         case USB_STATUS_WRITE_COMPLETE: /* Write Complete State */
         {
+            if (pcdc_stream_active() && (USB_CLASS_PCDC == p_usb_event->type))
+            {
+                err = pcdc_stream_write_complete ((usb_event_info_t const *) p_usb_event);
+                break;
+            }
             APP_PRINT("\nUSB STATUS : USB_STATUS_WRITE_COMPLETE\r\n");
             if(b_usb_attach)
             {
@@ -149,6 +182,11 @@ fsp_err_t process_usb_events(void)
 
         case USB_STATUS_READ_COMPLETE: /* Read Complete State */
         {
+            if (pcdc_stream_active() && (USB_CLASS_PCDC == p_usb_event->type))
+            {
+                err = pcdc_stream_read_complete ((usb_event_info_t const *) p_usb_event);
+                break;
+            }
             APP_PRINT("\nUSB STATUS : USB_STATUS_READ_COMPLETE\r\n");
             if(b_usb_attach)
             {
@@ -201,6 +239,11 @@ fsp_err_t process_usb_events(void)
             /* Reset the usb attached flag as indicating usb is removed.*/
             b_usb_attach = false;
             memset (g_buf, RESET_VALUE, sizeof(g_buf));
+            if (USB_STATUS_DETACH == p_usb_event->event)
+            {
+                /* The transfers in flight are cancelled by the driver, start again on the next configuration */
+                pcdc_stream_stop();
+            }
             break;
         }
         case USB_STATUS_RESUME:
@@ -284,6 +327,38 @@ fsp_err_t usb_status_request(void)
     return err;
 }
 
+/*******************************************************************************************************************//**
+ * @brief     Prints the stream throughput once per STREAM_REPORT_MS while the stream is running.
+ * @param[IN] None
+ * @retval    None
+ **********************************************************************************************************************/
+void stream_report(void)
+{
+    pcdc_stream_stats_t stats = {RESET_VALUE};
+    TickType_t now            = xTaskGetTickCount();
+    uint32_t elapsed_ms       = RESET_VALUE;
+
+    if (!pcdc_stream_active())
+    {
+        return;
+    }
+    elapsed_ms = (uint32_t) ((now - g_stream_tick) * portTICK_PERIOD_MS);
+    if (elapsed_ms < STREAM_REPORT_MS)
+    {
+        return;
+    }
+
+    pcdc_stream_stats_get(&stats);
+    APP_PRINT("\r\nStream RX %u KB/s, TX %u KB/s, writes %u, rx stalls %u\r\n",
+              (unsigned) ((stats.rx_bytes - g_stream_last.rx_bytes) / elapsed_ms),
+              (unsigned) ((stats.tx_bytes - g_stream_last.tx_bytes) / elapsed_ms),
+              (unsigned) (stats.tx_writes - g_stream_last.tx_writes),
+              (unsigned) (stats.rx_stalls - g_stream_last.rx_stalls));
+
+    g_stream_last = stats;
+    g_stream_tick = now;
+}
+
 /*******************************************************************************************************************//**
  * @brief       This function is callback for FreeRTOS+Composite.
  * @param[IN]   usb_event_info_t  *p_event_info
@@ -0,0 +1,380 @@
+/***********************************************************************************************************************
+ * File Name    : usb_vnd_stream.c
+ * Description  : Bulk streaming of the host vendor example. The IN pipe reads the device's sequence numbered
+ *                transfers and verifies them, the OUT pipe generates transfers for the device. Both keep a ring of
+ *                buffers queued and measure throughput and pipe idle time.
+ **********************************************************************************************************************/
+
+/*
+* Copyright (c) 2024 Renesas Electronics Corporation and/or its affiliates
+*
+* SPDX-License-Identifier: BSD-3-Clause
+*/
+
+#include "common_utils.h"
+#include "usb_vnd_stream.h"
+
+/*******************************************************************************************************************//**
+ * @addtogroup usb_vnd_stream
+ * @{
+ **********************************************************************************************************************/
+
+/** Private macros **/
+#define DWT_DEMCR               (*(volatile uint32_t *) 0xE000EDFCU)   /* Debug Exception and Monitor Control */
+#define DWT_DEMCR_TRCENA        (1U << 24)
+#define DWT_CTRL_CYCCNTENA      (1U << 0)
+#define STREAM_PATTERN_MASK     (0xFFU)
+#define CYCLES_PER_US           (SystemCoreClock / 1000000U)
+#define CYCLES_PER_MS           (SystemCoreClock / 1000U)
+
+/** Private functions **/
+static void      stream_timer_init(void);
+static uint32_t  stream_timer_get(void);
+static fsp_err_t stream_arm(usb_vnd_stream_t * p_stream);
+static void      stream_fill(usb_vnd_stream_t * p_stream, uint8_t * p_buf);
+static void      stream_verify(usb_vnd_stream_t * p_stream, uint8_t const * p_buf, uint32_t size);
+
+/*******************************************************************************************************************//**
+ * @brief       Bind a stream to a bulk pipe and its buffer ring.
+ * @param[IN]   p_stream    stream to initialize
+ * @param[IN]   p_ctrl      opened USB instance
+ * @param[IN]   pipe        bulk pipe number
+ * @param[IN]   dir         USB_VND_STREAM_DIR_RX to read from the pipe, USB_VND_STREAM_DIR_TX to write to it
+ * @param[IN]   p_buf       USB_VND_STREAM_DEPTH buffers, declared with USB_VND_STREAM_BUF_DECLARE
+ * @retval      FSP_SUCCESS on successful operation
+ * @retval      FSP_ERR_ASSERTION on invalid arguments
+ * @retval      FSP_ERR_IN_USE while the stream is started, its transfers may still be in flight
+ **********************************************************************************************************************/
+fsp_err_t usb_vnd_stream_open(usb_vnd_stream_t * p_stream, usb_ctrl_t * p_ctrl, uint8_t pipe,
+                              usb_vnd_stream_dir_t dir, uint8_t (* p_buf)[USB_VND_STREAM_XFER_SIZE])
+{
+    if ((NULL == p_stream) || (NULL == p_ctrl) || (NULL == p_buf))
+    {
+        return FSP_ERR_ASSERTION;
+    }
+    if (true == p_stream->active)
+    {
+        return FSP_ERR_IN_USE;
+    }
+
+    memset(p_stream, RESET_VALUE, sizeof(usb_vnd_stream_t));
+    p_stream->p_ctrl = p_ctrl;
+    p_stream->pipe   = pipe;
+    p_stream->dir    = dir;
+    p_stream->p_buf  = p_buf;
+    p_stream->stats.gap_min = UINT32_MAX;
+
+    stream_timer_init();
+
+    return FSP_SUCCESS;
+}
+
+/*******************************************************************************************************************//**
+ * @brief       Prime the ring and queue the first transfer.
+ * @param[IN]   p_stream    opened stream
+ * @retval      Any Other Error code apart from FSP_SUCCESS on Unsuccessful operation.
+ **********************************************************************************************************************/
+fsp_err_t usb_vnd_stream_start(usb_vnd_stream_t * p_stream)
+{
+    p_stream->active              = true;
+    p_stream->stats.window_start  = stream_timer_get();
+
+    /* TX fills every slot here, RX finds nothing to verify and just arms the first slot */
+    return usb_vnd_stream_process(p_stream);
+}
+
+/*******************************************************************************************************************//**
+ * @brief       Stop queueing new transfers, e.g. on detach. Pending data in the ring is dropped.
+ * @param[IN]   p_stream    stream to stop
+ * @retval      None
+ **********************************************************************************************************************/
+void usb_vnd_stream_stop(usb_vnd_stream_t * p_stream)
+{
+    p_stream->active    = false;
+    p_stream->in_flight = false;
+}
+
+/*******************************************************************************************************************//**
+ * @brief       Handle USB_STATUS_READ_COMPLETE / USB_STATUS_WRITE_COMPLETE of the stream pipe.
+ *              The next slot is handed to the driver before anything else is done so the pipe idles as little as
+ *              possible. Verification and refill of the completed slot are left to usb_vnd_stream_process().
+ * @param[IN]   p_stream    stream the event belongs to
+ * @param[IN]   p_event     USB event information
+ * @retval      Any Other Error code apart from FSP_SUCCESS on Unsuccessful operation.
+ **********************************************************************************************************************/
+fsp_err_t usb_vnd_stream_complete(usb_vnd_stream_t * p_stream, usb_event_info_t const * p_event)
+{
+    fsp_err_t err  = FSP_SUCCESS;
+    uint32_t  slot = RESET_VALUE;
+    uint32_t  size = RESET_VALUE;
+
+    if ((true != p_stream->active) || (true != p_stream->in_flight) || (p_event->pipe != p_stream->pipe))
+    {
+        return FSP_SUCCESS;
+    }
+
+    p_stream->complete_stamp = stream_timer_get();
+    p_stream->in_flight      = false;
+
+    slot = (p_stream->arm_idx - 1U) % USB_VND_STREAM_DEPTH;
+    if (USB_VND_STREAM_DIR_RX == p_stream->dir)
+    {
+        size = p_event->data_size;
+        p_stream->state[slot] = USB_VND_SLOT_DONE;
+        p_stream->len[slot]   = size;
+    }
+    else
+    {
+        size = USB_VND_STREAM_XFER_SIZE;
+        p_stream->state[slot] = USB_VND_SLOT_FREE;
+    }
+
+    if (FSP_ERR_USB_FAILED == p_event->status)
+    {
+        /* Keep the ring moving, the verifier flags the slot through the sequence check */
+        p_stream->stats.data_errors++;
+        size = RESET_VALUE;
+        p_stream->len[slot] = RESET_VALUE;
+    }
+
+    p_stream->stats.transfers++;
+    p_stream->stats.total_bytes  += size;
+    p_stream->stats.window_bytes += size;
+
+    err = stream_arm(p_stream);
+    if ((FSP_SUCCESS == err) && (true != p_stream->in_flight))
+    {
+        /* Ring ran dry, the pipe stays idle until the application catches up */
+        p_stream->stats.stalls++;
+    }
+
+    return err;
+}
+
+/*******************************************************************************************************************//**
+ * @brief       Application side of the ring: verify received slots (RX) or refill sent slots (TX), then re-arm the
+ *              pipe if the completion handler found no slot available.
+ * @param[IN]   p_stream    stream to service
+ * @retval      Any Other Error code apart from FSP_SUCCESS on Unsuccessful operation.
+ **********************************************************************************************************************/
+fsp_err_t usb_vnd_stream_process(usb_vnd_stream_t * p_stream)
+{
+    uint32_t slot = RESET_VALUE;
+
+    if (true != p_stream->active)
+    {
+        return FSP_SUCCESS;
+    }
+
+    for (uint32_t cnt = RESET_VALUE; cnt < USB_VND_STREAM_DEPTH; cnt++)
+    {
+        slot = p_stream->proc_idx % USB_VND_STREAM_DEPTH;
+
+        if ((USB_VND_STREAM_DIR_RX == p_stream->dir) && (USB_VND_SLOT_DONE == p_stream->state[slot]))
+        {
+            stream_verify(p_stream, p_stream->p_buf[slot], p_stream->len[slot]);
+            p_stream->state[slot] = USB_VND_SLOT_FREE;
+        }
+        else if ((USB_VND_STREAM_DIR_TX == p_stream->dir) && (USB_VND_SLOT_FREE == p_stream->state[slot]))
+        {
+            stream_fill(p_stream, p_stream->p_buf[slot]);
+            p_stream->state[slot] = USB_VND_SLOT_READY;
+        }
+        else
+        {
+            break;
+        }
+        p_stream->proc_idx++;
+    }
+
+    return stream_arm(p_stream);
+}
+
+/*******************************************************************************************************************//**
+ * @brief       Print throughput and pipe idle time once every USB_VND_STREAM_REPORT_MS, then restart the window.
+ * @param[IN]   p_stream    stream to report
+ * @param[IN]   p_name      label printed in front of the statistics
+ * @retval      None
+ **********************************************************************************************************************/
+void usb_vnd_stream_report(usb_vnd_stream_t * p_stream, char const * p_name)
+{
+    usb_vnd_stream_stats_t * p_stats = &p_stream->stats;
+    uint32_t now          = stream_timer_get();
+    uint32_t elapsed      = now - p_stats->window_start;
+    uint32_t bytes_per_ms = RESET_VALUE;
+    uint32_t gap_avg      = RESET_VALUE;
+
+    if ((true != p_stream->active) || (elapsed < (USB_VND_STREAM_REPORT_MS * CYCLES_PER_MS)))
+    {
+        return;
+    }
+
+    /* Bytes per millisecond is kB/s, print it as MB/s with three decimals */
+    bytes_per_ms = (uint32_t) (((uint64_t) p_stats->window_bytes * CYCLES_PER_MS) / elapsed);
+    if (RESET_VALUE != p_stats->gap_count)
+    {
+        gap_avg = (uint32_t) (p_stats->gap_sum / p_stats->gap_count);
+    }
+    else
+    {
+        p_stats->gap_min = RESET_VALUE;
+    }
+
+    APP_PRINT("\r\n%s: %u.%03u MB/s, %u KB total, %u xfers, gap us min/avg/max %u/%u/%u, "
+              "stalls %u, seq err %u, data err %u",
+              p_name, bytes_per_ms / 1000U, bytes_per_ms % 1000U, (uint32_t) (p_stats->total_bytes / 1024U),
+              p_stats->transfers, p_stats->gap_min / CYCLES_PER_US, gap_avg / CYCLES_PER_US,
+              p_stats->gap_max / CYCLES_PER_US, p_stats->stalls, p_stats->seq_errors, p_stats->data_errors);
+
+    p_stats->window_start = now;
+    p_stats->window_bytes = RESET_VALUE;
+    p_stats->gap_min      = UINT32_MAX;
+    p_stats->gap_max      = RESET_VALUE;
+    p_stats->gap_sum      = RESET_VALUE;
+    p_stats->gap_count    = RESET_VALUE;
+}
+
+/*******************************************************************************************************************//**
+ * @brief       Queue the next slot of the ring in the USB driver, if it is available.
+ * @param[IN]   p_stream    stream to arm
+ * @retval      Any Other Error code apart from FSP_SUCCESS on Unsuccessful operation.
+ **********************************************************************************************************************/
+static fsp_err_t stream_arm(usb_vnd_stream_t * p_stream)
+{
+    fsp_err_t err  = FSP_SUCCESS;
+    uint32_t  slot = p_stream->arm_idx % USB_VND_STREAM_DEPTH;
+    uint32_t  gap  = RESET_VALUE;
+
+    if ((true != p_stream->active) || (true == p_stream->in_flight))
+    {
+        return FSP_SUCCESS;
+    }
+
+    if (USB_VND_STREAM_DIR_RX == p_stream->dir)
+    {
+        if (USB_VND_SLOT_FREE != p_stream->state[slot])
+        {
+            /* Verifier is behind, usb_vnd_stream_process() arms once it frees the slot */
+            return FSP_SUCCESS;
+        }
+        err = R_USB_PipeRead(p_stream->p_ctrl, p_stream->p_buf[slot], USB_VND_STREAM_XFER_SIZE, p_stream->pipe);
+    }
+    else
+    {
+        if (USB_VND_SLOT_READY != p_stream->state[slot])
+        {
+            /* Producer is behind, usb_vnd_stream_process() arms once it fills the slot */
+            return FSP_SUCCESS;
+        }
+        err = R_USB_PipeWrite(p_stream->p_ctrl, p_stream->p_buf[slot], USB_VND_STREAM_XFER_SIZE, p_stream->pipe);
+    }
+
+    if (FSP_SUCCESS != err)
+    {
+        APP_ERR_PRINT("\r\nStream pipe %d arm failed\r\n", p_stream->pipe);
+        return err;
+    }
+
+    p_stream->state[slot] = USB_VND_SLOT_BUSY;
+    p_stream->in_flight   = true;
+    p_stream->arm_idx++;
+
+    /* Pipe idle time between the previous completion and this request */
+    if (RESET_VALUE != p_stream->stats.transfers)
+    {
+        gap = stream_timer_get() - p_stream->complete_stamp;
+        p_stream->stats.gap_sum += gap;
+        p_stream->stats.gap_count++;
+        if (gap < p_stream->stats.gap_min)
+        {
+            p_stream->stats.gap_min = gap;
+        }
+        if (gap > p_stream->stats.gap_max)
+        {
+            p_stream->stats.gap_max = gap;
+        }
+    }
+
+    return FSP_SUCCESS;
+}
+
+/*******************************************************************************************************************//**
+ * @brief       Fill one transfer with the sequence number followed by the test pattern.
+ * @param[IN]   p_stream    TX stream
+ * @param[IN]   p_buf       slot to fill
+ * @retval      None
+ **********************************************************************************************************************/
+static void stream_fill(usb_vnd_stream_t * p_stream, uint8_t * p_buf)
+{
+    uint32_t seq = p_stream->seq++;
+
+    memcpy(p_buf, &seq, USB_VND_STREAM_SEQ_BYTES);
+    for (uint32_t cnt = USB_VND_STREAM_SEQ_BYTES; cnt < USB_VND_STREAM_XFER_SIZE; cnt++)
+    {
+        p_buf[cnt] = (uint8_t) ((seq + cnt) & STREAM_PATTERN_MASK);
+    }
+}
+
+/*******************************************************************************************************************//**
+ * @brief       Check the sequence number and the test pattern of one received transfer.
+ * @param[IN]   p_stream    RX stream
+ * @param[IN]   p_buf       slot to verify
+ * @param[IN]   size        bytes received into the slot, 0 for a failed transfer
+ * @retval      None
+ **********************************************************************************************************************/
+static void stream_verify(usb_vnd_stream_t * p_stream, uint8_t const * p_buf, uint32_t size)
+{
+    uint32_t seq = RESET_VALUE;
+
+    if (size < USB_VND_STREAM_SEQ_BYTES)
+    {
+        /* A failed transfer is counted on completion, the next sequence check flags the loss */
+        if (RESET_VALUE != size)
+        {
+            p_stream->stats.data_errors++;
+        }
+        return;
+    }
+
+    memcpy(&seq, p_buf, USB_VND_STREAM_SEQ_BYTES);
+    if (seq != p_stream->seq)
+    {
+        /* Resynchronize on the received number so one loss is counted once */
+        p_stream->stats.seq_errors++;
+    }
+    p_stream->seq = seq + 1U;
+
+    for (uint32_t cnt = USB_VND_STREAM_SEQ_BYTES; cnt < size; cnt++)
+    {
+        if ((uint8_t) ((seq + cnt) & STREAM_PATTERN_MASK) != p_buf[cnt])
+        {
+            p_stream->stats.data_errors++;
+            break;
+        }
+    }
+}
+
+/*******************************************************************************************************************//**
+ * @brief       Start the DWT cycle counter used for time stamps.
+ * @param[IN]   None
+ * @retval      None
+ **********************************************************************************************************************/
+static void stream_timer_init(void)
+{
+    DWT_DEMCR  |= DWT_DEMCR_TRCENA;
+    DWT->CTRL  |= DWT_CTRL_CYCCNTENA;
+}
+
+/*******************************************************************************************************************//**
+ * @brief       Read the DWT cycle counter.
+ * @param[IN]   None
+ * @retval      Current cycle count
+ **********************************************************************************************************************/
+static uint32_t stream_timer_get(void)
+{
+    return DWT->CYCCNT;
+}
+
+/*******************************************************************************************************************//**
+ * @} (end addtogroup usb_vnd_stream)
+ **********************************************************************************************************************/
@@ -23,6 +23,7 @@
 #include "usb_peri_vendor_thread.h"
 #include "common_utils.h"
 #include "usb_peri_vendor_thread_entry.h"
+#include "usb_vnd_stream.h"
 /*******************************************************************************************************************//**
  * @addtogroup usb_peripheral_vendor_ep
  * @{
@@ -37,6 +38,13 @@ volatile uint8_t g_pipe = RESET_VALUE;
 uint8_t g_bulk_in_pipe = RESET_VALUE;       /* Bulk In  Pipe */
 uint8_t g_bulk_out_pipe = RESET_VALUE;      /* Bulk Out Pipe */
 uint16_t g_max_packet_size = USB_APL_MXPS;
+#if USB_VND_STREAM_MODE
+/* Bulk IN carries the uplink to the host, bulk OUT the downlink from it */
+USB_VND_STREAM_BUF_DECLARE(g_stream_in_buf);
+USB_VND_STREAM_BUF_DECLARE(g_stream_out_buf);
+static usb_vnd_stream_t g_stream_in;
+static usb_vnd_stream_t g_stream_out;
+#endif
 
 /* Function definitions */
 static fsp_err_t process_usb_events(void);
@@ -44,6 +52,10 @@ static fsp_err_t usb_configured_event_process(void);
 static fsp_err_t usb_status_request(void);
 static void handle_error(fsp_err_t err, char * err_str);
 static fsp_err_t buffer_check (uint32_t length);
+#if USB_VND_STREAM_MODE
+static fsp_err_t stream_start(void);
+static void stream_service(void);
+#endif
 
 /*******************************************************************************************************************//**
  * @brief     Entry function of USB peripheral vendor thread.
@@ -57,6 +69,7 @@ void usb_peri_vendor_thread_entry(void *pvParameters)
     fsp_pack_version_t version = {RESET_VALUE};
     fsp_err_t err              = FSP_SUCCESS;
     BaseType_t err_queue       = pdFALSE;
+    TickType_t wait_ticks      = portMAX_DELAY;
 
     /* Version get API for FLEX pack information */
     R_FSP_VersionGet(&version);
@@ -93,17 +106,32 @@ void usb_peri_vendor_thread_entry(void *pvParameters)
             handle_error(FSP_ERR_ABORTED, "\r\nError in sending usb event through queue\r\n");
         }
 
+#if USB_VND_STREAM_MODE
+        /* Wake up periodically while streaming to verify, refill and report */
+        wait_ticks = g_stream_in.active ? pdMS_TO_TICKS(STREAM_EVENT_WAIT_MS) : portMAX_DELAY;
+#endif
+
         /* Receive message from queue */
-        err_queue = xQueueReceive(g_queue, &p_usb_event,(portMAX_DELAY));
-        /* Handle error */
-        if (pdTRUE != err_queue)
+        err_queue = xQueueReceive(g_queue, &p_usb_event, wait_ticks);
+        if (pdTRUE == err_queue)
+        {
+            /* process USB events */
+            err = process_usb_events();
+            handle_error(err, "\r\nprocess_usb_events failed.\r\n");
+        }
+        else if (portMAX_DELAY == wait_ticks)
         {
+            /* Handle error */
             handle_error(FSP_ERR_ABORTED, "\r\nError in receiving event through queue\r\n");
         }
+        else
+        {
+            /* Timeout while streaming, nothing to do but service the rings */
+        }
 
-        /* process USB events */
-        err = process_usb_events();
-        handle_error(err, "\r\nprocess_usb_events failed.\r\n");
+#if USB_VND_STREAM_MODE
+        stream_service();
+#endif
     }
 }
 
@@ -132,6 +160,14 @@ fsp_err_t process_usb_events(void)
 
         case USB_STATUS_READ_COMPLETE:
         {
+#if USB_VND_STREAM_MODE
+            if (true == g_stream_out.active)
+            {
+                /* Re-arm the pipe first, the data is verified later in stream_service() */
+                err = usb_vnd_stream_complete(&g_stream_out, (usb_event_info_t const *) p_usb_event);
+                break;
+            }
+#endif
             /* check for out pipe */
             if ((g_bulk_out_pipe == p_usb_event->pipe) && (FSP_ERR_USB_FAILED != p_usb_event->status))
             {
@@ -178,6 +214,14 @@ fsp_err_t process_usb_events(void)
 
         case USB_STATUS_WRITE_COMPLETE:
         {
+#if USB_VND_STREAM_MODE
+            if (true == g_stream_in.active)
+            {
+                /* Queue the next filled slot, the sent one is refilled later in stream_service() */
+                err = usb_vnd_stream_complete(&g_stream_in, (usb_event_info_t const *) p_usb_event);
+                break;
+            }
+#endif
             /* check for in pipe */
             if ((g_bulk_in_pipe == p_usb_event->pipe) && (FSP_ERR_USB_FAILED != p_usb_event->status))
             {
@@ -230,6 +274,10 @@ fsp_err_t process_usb_events(void)
         {
             if (USB_GET_VENDOR == (p_usb_event->setup.request_type & USB_BREQUEST))
             {
+#if USB_VND_STREAM_MODE
+                /* Start streaming on both bulk pipes */
+                err = stream_start();
+#else
                 /* Start reading data */
                 err = R_USB_PipeRead(&g_basic_ctrl, &g_buf[RESET_VALUE], (BUF_SIZE), g_bulk_out_pipe);
                 if (FSP_SUCCESS != err)
@@ -240,12 +288,17 @@ fsp_err_t process_usb_events(void)
                 {
                     APP_PRINT("\r\nUSB Read operation  initiated from Peripheral Vendor class\r\n");
                 }
+#endif
             }
             break;
         }
 
         case USB_STATUS_DETACH:
         {
+#if USB_VND_STREAM_MODE
+            usb_vnd_stream_stop(&g_stream_in);
+            usb_vnd_stream_stop(&g_stream_out);
+#endif
             APP_PRINT("\nUSB STATUS : USB_STATUS_DETACH\r\n");
             break;
         }
@@ -446,6 +499,62 @@ static fsp_err_t buffer_check (uint32_t length)
     return FSP_SUCCESS;
 }
 
+#if USB_VND_STREAM_MODE
+/*******************************************************************************************************************//**
+ *  @brief       Start streaming on both bulk pipes once the host finished the vendor requests.
+ *  @param[IN]   None
+ *  @retval      Any Other Error code apart from FSP_SUCCESS on Unsuccessful operation.
+ **********************************************************************************************************************/
+static fsp_err_t stream_start(void)
+{
+    fsp_err_t err = FSP_SUCCESS;
+
+    /* A repeated GET_VENDOR finds the streams running, their transfers are still in flight */
+    if ((true == g_stream_in.active) || (true == g_stream_out.active))
+    {
+        return FSP_SUCCESS;
+    }
+
+    err = usb_vnd_stream_open(&g_stream_in, &g_basic_ctrl, g_bulk_in_pipe, USB_VND_STREAM_DIR_TX, g_stream_in_buf);
+    if (FSP_SUCCESS == err)
+    {
+        err = usb_vnd_stream_open(&g_stream_out, &g_basic_ctrl, g_bulk_out_pipe, USB_VND_STREAM_DIR_RX, g_stream_out_buf);
+    }
+    if (FSP_SUCCESS == err)
+    {
+        err = usb_vnd_stream_start(&g_stream_out);
+    }
+    if (FSP_SUCCESS == err)
+    {
+        err = usb_vnd_stream_start(&g_stream_in);
+    }
+
+    if (FSP_SUCCESS != err)
+    {
+        APP_ERR_PRINT("\r\nStream start failed\r\n");
+    }
+    else
+    {
+        APP_PRINT("\r\nStreaming %d byte transfers, %d deep rings\r\n", USB_VND_STREAM_XFER_SIZE, USB_VND_STREAM_DEPTH);
+    }
+    return err;
+}
+
+/*******************************************************************************************************************//**
+ *  @brief       Verify received data, refill sent buffers and print statistics, outside the completion path.
+ *  @param[IN]   None
+ *  @retval      None
+ **********************************************************************************************************************/
+static void stream_service(void)
+{
+    handle_error(usb_vnd_stream_process(&g_stream_out), "\r\nStream OUT processing failed.\r\n");
+    handle_error(usb_vnd_stream_process(&g_stream_in), "\r\nStream IN processing failed.\r\n");
+
+    usb_vnd_stream_report(&g_stream_out, "OUT (host->dev)");
+    usb_vnd_stream_report(&g_stream_in, "IN  (dev->host)");
+}
+#endif
+
 /*******************************************************************************************************************//**
  * @} (end addtogroup usb_peripheral_vendor_ep)
  **********************************************************************************************************************/
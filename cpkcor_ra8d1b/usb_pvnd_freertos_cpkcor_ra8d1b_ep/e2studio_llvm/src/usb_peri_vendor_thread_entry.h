@@ -38,6 +38,8 @@
 #define SET_VENDOR             (USB_SET_VENDOR | USB_HOST_TO_DEV | USB_VENDOR | USB_INTERFACE)
 #define GET_VENDOR             (USB_GET_VENDOR | USB_DEV_TO_HOST | USB_VENDOR | USB_INTERFACE)
 #define DELAY                  (10U)               // Delay for print
+#define USB_VND_STREAM_MODE    (1)                 // 1: stream both bulk pipes continuously, 0: echo demo
+#define STREAM_EVENT_WAIT_MS   (10U)               // Queue timeout while streaming, services the rings
 #if defined (BOARD_RA6M3_EK) || defined (BOARD_RA6M3G_EK) || defined (BOARD_RA8D1_EK)
 #define USB_APL_MXPS           (512U)              // Max packet size high speed
 #else
@@ -0,0 +1,88 @@
+/***********************************************************************************************************************
+ * File Name    : usb_vnd_stream.h
+ * Description  : Contains data structures and functions of the peripheral side bulk streams, see usb_vnd_stream.c.
+ **********************************************************************************************************************/
+
+/*
+* Copyright (c) 2024 Renesas Electronics Corporation and/or its affiliates
+*
+* SPDX-License-Identifier: BSD-3-Clause
+*/
+
+#ifndef USB_VND_STREAM_H_
+#define USB_VND_STREAM_H_
+
+#include "hal_data.h"
+
+/** Macros definitions **/
+#define USB_VND_STREAM_DEPTH            (4U)                /* Buffers in each pipe ring */
+#define USB_VND_STREAM_XFER_SIZE        (16U * 1024U)       /* Bytes per R_USB_PipeRead/R_USB_PipeWrite */
+#define USB_VND_STREAM_BUF_ALIGN        (32U)               /* Cache line size, buffers are DMA targets */
+#define USB_VND_STREAM_REPORT_MS        (1000U)             /* Statistics print interval */
+#define USB_VND_STREAM_SEQ_BYTES        (4U)                /* Sequence number at the head of every transfer */
+
+/* Declare the ring storage of one stream. Place it in the non-cached region so the USB DMA and the CPU agree. */
+#define USB_VND_STREAM_BUF_DECLARE(name) \
+    static uint8_t name[USB_VND_STREAM_DEPTH][USB_VND_STREAM_XFER_SIZE] \
+    BSP_ALIGN_VARIABLE(USB_VND_STREAM_BUF_ALIGN) BSP_PLACE_IN_SECTION(".nocache")
+
+/** Stream direction, seen from this board **/
+typedef enum e_usb_vnd_stream_dir
+{
+    USB_VND_STREAM_DIR_RX = 0,         /* Data is read from the pipe and verified */
+    USB_VND_STREAM_DIR_TX,             /* Data is generated and written to the pipe */
+} usb_vnd_stream_dir_t;
+
+/** Ring slot ownership **/
+typedef enum e_usb_vnd_slot_state
+{
+    USB_VND_SLOT_FREE = 0,             /* RX: empty, may be armed. TX: needs to be filled */
+    USB_VND_SLOT_READY,                /* TX only: filled, may be armed */
+    USB_VND_SLOT_BUSY,                 /* Owned by the USB driver */
+    USB_VND_SLOT_DONE,                 /* RX only: received, waiting for verification */
+} usb_vnd_slot_state_t;
+
+/** Throughput and timing statistics of one stream **/
+typedef struct st_usb_vnd_stream_stats
+{
+    uint64_t total_bytes;              /* Bytes transferred since start */
+    uint32_t transfers;                /* Completed transfers since start */
+    uint32_t window_bytes;             /* Bytes transferred since the last report */
+    uint32_t window_start;             /* DWT cycle count at the last report */
+    uint32_t gap_min;                  /* Shortest pipe idle time between two transfers, in cycles */
+    uint32_t gap_max;                  /* Longest pipe idle time between two transfers, in cycles */
+    uint64_t gap_sum;                  /* Sum of the pipe idle times, in cycles */
+    uint32_t gap_count;                /* Number of idle times summed up */
+    uint32_t stalls;                   /* Completions which found the next slot not yet available */
+    uint32_t seq_errors;               /* Transfers lost or reordered */
+    uint32_t data_errors;              /* Transfers whose payload did not match the pattern */
+} usb_vnd_stream_stats_t;
+
+/** One streaming pipe with its buffer ring **/
+typedef struct st_usb_vnd_stream
+{
+    usb_ctrl_t           * p_ctrl;     /* USB instance the pipe belongs to */
+    uint8_t                pipe;       /* Bulk pipe number */
+    usb_vnd_stream_dir_t   dir;        /* Transfer direction */
+    bool                   active;     /* Stream is started */
+    bool                   in_flight;  /* A transfer is queued in the driver */
+    uint8_t             (* p_buf)[USB_VND_STREAM_XFER_SIZE];
+    usb_vnd_slot_state_t   state[USB_VND_STREAM_DEPTH];
+    uint32_t               len[USB_VND_STREAM_DEPTH]; /* RX only: bytes received into the slot */
+    uint32_t               arm_idx;    /* Next slot handed to the driver */
+    uint32_t               proc_idx;   /* Next slot filled (TX) or verified (RX) by the application */
+    uint32_t               seq;        /* Next sequence number generated (TX) or expected (RX) */
+    uint32_t               complete_stamp; /* DWT cycle count of the last completion */
+    usb_vnd_stream_stats_t stats;
+} usb_vnd_stream_t;
+
+/** Function declarations **/
+fsp_err_t usb_vnd_stream_open(usb_vnd_stream_t * p_stream, usb_ctrl_t * p_ctrl, uint8_t pipe,
+                              usb_vnd_stream_dir_t dir, uint8_t (* p_buf)[USB_VND_STREAM_XFER_SIZE]);
+fsp_err_t usb_vnd_stream_start(usb_vnd_stream_t * p_stream);
+void      usb_vnd_stream_stop(usb_vnd_stream_t * p_stream);
+fsp_err_t usb_vnd_stream_complete(usb_vnd_stream_t * p_stream, usb_event_info_t const * p_event);
+fsp_err_t usb_vnd_stream_process(usb_vnd_stream_t * p_stream);
+void      usb_vnd_stream_report(usb_vnd_stream_t * p_stream, char const * p_name);
+
+#endif /* USB_VND_STREAM_H_ */
@@ -87,6 +87,17 @@
 #define USB_APL_OFF                 (0U)
 #define USB_MAX_PACKET_SIZE_IN      (200U)
 #define USB_MAX_PACKET_SZIE_OUT     (192U)
+
+/* Audio streaming pipeline, see usbx_paud_stream.c */
+#define USB_AUDIO_BYTES_PER_SAMPLE  (2U)        /* bSubslotSize of both streaming interfaces */
+#define USB_AUDIO_FRAME_BYTES       (4U)        /* One stereo sample frame on the bus */
+#define USB_AUDIO_PACKET_FRAMES     (48U)       /* Sample frames per 1 ms packet at the nominal rate */
+#define STORE_BYTES_PER_SAMPLE      (2U)        /* Sample width kept in GLOBAL_BUFF, 3 or 4 for a 24/32-bit codec */
+#define RX_TARGET_BYTES             (PAUD_RING_SIZE / 2U)   /* OUT ring level before playback starts */
+#define TX_TARGET_BYTES             (8U * USB_AUDIO_PACKET_FRAMES * USB_AUDIO_FRAME_BYTES)
+#define MAX_FRAMES_DUE              (4096U)     /* Bound on catch-up after a long stall */
+#define STREAM_REPORT_TICKS         (TX_TIMER_TICKS_PER_SECOND)
+#define STREAM_MSG_LEN              (112U)
 #define USB_APL_DETACH              (0)
 #define USB_APL_DEFAULT             (1)
 #define USB_APL_CONFIGURED          (2)
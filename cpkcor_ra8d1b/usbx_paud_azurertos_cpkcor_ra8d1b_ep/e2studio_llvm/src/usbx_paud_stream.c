@@ -0,0 +1,361 @@
+/***********************************************************************************************************************
+ * File Name    : usbx_paud_stream.c
+ * Description  : Contains the audio ring, local sample clock and sample format conversion
+ **********************************************************************************************************************/
+
+/*
+* Copyright (c) 2024 Renesas Electronics Corporation and/or its affiliates
+*
+* SPDX-License-Identifier: BSD-3-Clause
+*/
+
+#include "hal_data.h"
+#include "usbx_paud_stream.h"
+
+#if defined(__ARM_FEATURE_MVE) && (__ARM_FEATURE_MVE & 1)
+ #include <arm_mve.h>
+ #define PAUD_USE_MVE                   (1)
+#else
+ #define PAUD_USE_MVE                   (0)
+#endif
+
+/*******************************************************************************************************************//**
+ * @addtogroup usbx_paud_stream
+ * @{
+ **********************************************************************************************************************/
+
+/******************************************************************************
+ Macro definitions
+ ******************************************************************************/
+#define DWT_DEMCR               (*(volatile uint32_t *) 0xE000EDFCU)   /* Debug Exception and Monitor Control */
+#define DWT_DEMCR_TRCENA        (1U << 24)
+#define DWT_CTRL_CYCCNTENA      (1U << 0)
+#define Q31_SHIFT_16            (16U)
+#define Q31_SHIFT_24            (8U)
+#define MVE_LANES               (4U)
+
+/******************************************************************************
+ Private functions
+ ******************************************************************************/
+static void pcm24_to_planar(uint8_t const * p_src, int32_t * p_left, int32_t * p_right, uint32_t frames);
+static void planar_to_pcm24(int32_t const * p_left, int32_t const * p_right, uint8_t * p_dest, uint32_t frames);
+
+/******************************************************************************
+ * Function Name   : paud_ring_init
+ * Description     : Bind a ring to its storage and empty it
+ * Arguments       : paud_ring_t * : ring
+ *                 : uint8_t *     : storage
+ *                 : uint32_t      : storage size, a power of two
+ * Return value    : None
+ ******************************************************************************/
+void paud_ring_init (paud_ring_t * p_ring, uint8_t * p_buf, uint32_t size)
+{
+    p_ring->p_buf = p_buf;
+    p_ring->size  = size;
+    p_ring->head  = 0U;
+    p_ring->tail  = 0U;
+}
+
+/******************************************************************************
+ * Function Name   : paud_ring_used
+ * Description     : Bytes available to the consumer
+ * Arguments       : paud_ring_t const * : ring
+ * Return value    : Number of bytes
+ ******************************************************************************/
+uint32_t paud_ring_used (paud_ring_t const * p_ring)
+{
+    return p_ring->head - p_ring->tail;
+}
+
+/******************************************************************************
+ * Function Name   : paud_ring_free
+ * Description     : Bytes available to the producer
+ * Arguments       : paud_ring_t const * : ring
+ * Return value    : Number of bytes
+ ******************************************************************************/
+uint32_t paud_ring_free (paud_ring_t const * p_ring)
+{
+    return p_ring->size - paud_ring_used(p_ring);
+}
+
+/******************************************************************************
+ * Function Name   : paud_ring_write
+ * Description     : Producer side. Copies as much as fits, the index is published after the data.
+ * Arguments       : paud_ring_t *    : ring
+ *                 : uint8_t const *  : source
+ *                 : uint32_t         : number of bytes
+ * Return value    : Number of bytes written
+ ******************************************************************************/
+uint32_t paud_ring_write (paud_ring_t * p_ring, uint8_t const * p_src, uint32_t size)
+{
+    uint32_t space  = paud_ring_free(p_ring);
+    uint32_t offset = p_ring->head & (p_ring->size - 1U);
+    uint32_t first  = 0U;
+
+    if (size > space)
+    {
+        size = space;
+    }
+    first = p_ring->size - offset;
+    if (first > size)
+    {
+        first = size;
+    }
+    memcpy(&p_ring->p_buf[offset], p_src, first);
+    memcpy(&p_ring->p_buf[0], p_src + first, size - first);
+
+    __DMB();
+    p_ring->head += size;
+    return size;
+}
+
+/******************************************************************************
+ * Function Name   : paud_ring_read
+ * Description     : Consumer side. Copies as much as is available, the index is published after the data.
+ * Arguments       : paud_ring_t * : ring
+ *                 : uint8_t *     : destination
+ *                 : uint32_t      : number of bytes
+ * Return value    : Number of bytes read
+ ******************************************************************************/
+uint32_t paud_ring_read (paud_ring_t * p_ring, uint8_t * p_dest, uint32_t size)
+{
+    uint32_t used   = paud_ring_used(p_ring);
+    uint32_t offset = p_ring->tail & (p_ring->size - 1U);
+    uint32_t first  = 0U;
+
+    if (size > used)
+    {
+        size = used;
+    }
+    first = p_ring->size - offset;
+    if (first > size)
+    {
+        first = size;
+    }
+    memcpy(p_dest, &p_ring->p_buf[offset], first);
+    memcpy(p_dest + first, &p_ring->p_buf[0], size - first);
+
+    __DMB();
+    p_ring->tail += size;
+    return size;
+}
+
+/******************************************************************************
+ * Function Name   : paud_clock_init
+ * Description     : Start a sample clock running from the DWT cycle counter. It stands in for the codec clock,
+ *                   so the ring level follows the drift between the host and the local crystal.
+ * Arguments       : paud_clock_t * : clock
+ *                 : uint32_t       : sample frames per second
+ * Return value    : None
+ ******************************************************************************/
+void paud_clock_init (paud_clock_t * p_clock, uint32_t rate)
+{
+    DWT_DEMCR  |= DWT_DEMCR_TRCENA;
+    DWT->CTRL  |= DWT_CTRL_CYCCNTENA;
+
+    p_clock->rate        = rate;
+    p_clock->last_cycles = DWT->CYCCNT;
+    p_clock->acc         = 0U;
+}
+
+/******************************************************************************
+ * Function Name   : paud_clock_frames_due
+ * Description     : Sample frames elapsed since the previous call. Must be called more often than the
+ *                   cycle counter wraps (about 8 s at 480 MHz).
+ * Arguments       : paud_clock_t * : clock
+ * Return value    : Number of sample frames
+ ******************************************************************************/
+uint32_t paud_clock_frames_due (paud_clock_t * p_clock)
+{
+    uint32_t now    = DWT->CYCCNT;
+    uint32_t frames = 0U;
+
+    p_clock->acc        += (uint64_t) (now - p_clock->last_cycles) * p_clock->rate;
+    p_clock->last_cycles = now;
+
+    frames        = (uint32_t) (p_clock->acc / SystemCoreClock);
+    p_clock->acc -= (uint64_t) frames * SystemCoreClock;
+    return frames;
+}
+
+/******************************************************************************
+ * Function Name   : paud_pcm_to_planar
+ * Description     : Split interleaved stereo PCM into left/right Q31 blocks.
+ *                   16 and 32-bit samples use Helium gather loads on the Cortex-M85, 24-bit packed
+ *                   samples are not word aligned and take the scalar path.
+ * Arguments       : uint8_t const * : interleaved PCM, little endian
+ *                 : uint32_t        : bytes per sample, 2, 3 or 4
+ *                 : int32_t *       : left channel output
+ *                 : int32_t *       : right channel output
+ *                 : uint32_t        : number of sample frames
+ * Return value    : None
+ ******************************************************************************/
+void paud_pcm_to_planar (uint8_t const * p_src, uint32_t bytes_per_sample,
+                         int32_t * p_left, int32_t * p_right, uint32_t frames)
+{
+    if (3U == bytes_per_sample)
+    {
+        pcm24_to_planar(p_src, p_left, p_right, frames);
+        return;
+    }
+
+#if PAUD_USE_MVE
+    /* Lane n of the left vector reads sample 2n, the right vector reads sample 2n + 1 */
+    uint32x4_t off_left  = vidupq_n_u32(0U, 2);
+    uint32x4_t off_right = vaddq_n_u32(off_left, 1U);
+
+    while (frames > 0U)
+    {
+        mve_pred16_t pred = vctp32q(frames);
+        int32x4_t    left;
+        int32x4_t    right;
+
+        if (2U == bytes_per_sample)
+        {
+            int16_t const * p_s16 = (int16_t const *) p_src;
+            left  = vshlq_n_s32(vldrhq_gather_shifted_offset_z_s32(p_s16, off_left, pred), Q31_SHIFT_16);
+            right = vshlq_n_s32(vldrhq_gather_shifted_offset_z_s32(p_s16, off_right, pred), Q31_SHIFT_16);
+        }
+        else
+        {
+            int32_t const * p_s32 = (int32_t const *) p_src;
+            left  = vldrwq_gather_shifted_offset_z_s32(p_s32, off_left, pred);
+            right = vldrwq_gather_shifted_offset_z_s32(p_s32, off_right, pred);
+        }
+        vstrwq_p_s32(p_left, left, pred);
+        vstrwq_p_s32(p_right, right, pred);
+
+        p_src   += MVE_LANES * PAUD_CHANNELS * bytes_per_sample;
+        p_left  += MVE_LANES;
+        p_right += MVE_LANES;
+        frames   = (frames > MVE_LANES) ? (frames - MVE_LANES) : 0U;
+    }
+#else
+    for (uint32_t i = 0U; i < frames; i++)
+    {
+        if (2U == bytes_per_sample)
+        {
+            int16_t const * p_s16 = (int16_t const *) p_src;
+            p_left[i]  = (int32_t) ((uint32_t) (int32_t) p_s16[2U * i] << Q31_SHIFT_16);
+            p_right[i] = (int32_t) ((uint32_t) (int32_t) p_s16[2U * i + 1U] << Q31_SHIFT_16);
+        }
+        else
+        {
+            int32_t const * p_s32 = (int32_t const *) p_src;
+            p_left[i]  = p_s32[2U * i];
+            p_right[i] = p_s32[2U * i + 1U];
+        }
+    }
+#endif
+}
+
+/******************************************************************************
+ * Function Name   : paud_planar_to_pcm
+ * Description     : Interleave left/right Q31 blocks into stereo PCM, truncating to the output width.
+ *                   16 and 32-bit samples use Helium scatter stores on the Cortex-M85.
+ * Arguments       : int32_t const * : left channel input
+ *                 : int32_t const * : right channel input
+ *                 : uint8_t *       : interleaved PCM output, little endian
+ *                 : uint32_t        : bytes per sample, 2, 3 or 4
+ *                 : uint32_t        : number of sample frames
+ * Return value    : None
+ ******************************************************************************/
+void paud_planar_to_pcm (int32_t const * p_left, int32_t const * p_right,
+                         uint8_t * p_dest, uint32_t bytes_per_sample, uint32_t frames)
+{
+    if (3U == bytes_per_sample)
+    {
+        planar_to_pcm24(p_left, p_right, p_dest, frames);
+        return;
+    }
+
+#if PAUD_USE_MVE
+    uint32x4_t off_left  = vidupq_n_u32(0U, 2);
+    uint32x4_t off_right = vaddq_n_u32(off_left, 1U);
+
+    while (frames > 0U)
+    {
+        mve_pred16_t pred  = vctp32q(frames);
+        int32x4_t    left  = vldrwq_z_s32(p_left, pred);
+        int32x4_t    right = vldrwq_z_s32(p_right, pred);
+
+        if (2U == bytes_per_sample)
+        {
+            /* Narrowing halfword scatter keeps the low 16 bits of each lane */
+            int16_t * p_s16 = (int16_t *) p_dest;
+            vstrhq_scatter_shifted_offset_p_s32(p_s16, off_left, vshrq_n_s32(left, Q31_SHIFT_16), pred);
+            vstrhq_scatter_shifted_offset_p_s32(p_s16, off_right, vshrq_n_s32(right, Q31_SHIFT_16), pred);
+        }
+        else
+        {
+            int32_t * p_s32 = (int32_t *) p_dest;
+            vstrwq_scatter_shifted_offset_p_s32(p_s32, off_left, left, pred);
+            vstrwq_scatter_shifted_offset_p_s32(p_s32, off_right, right, pred);
+        }
+
+        p_dest  += MVE_LANES * PAUD_CHANNELS * bytes_per_sample;
+        p_left  += MVE_LANES;
+        p_right += MVE_LANES;
+        frames   = (frames > MVE_LANES) ? (frames - MVE_LANES) : 0U;
+    }
+#else
+    for (uint32_t i = 0U; i < frames; i++)
+    {
+        if (2U == bytes_per_sample)
+        {
+            int16_t * p_s16 = (int16_t *) p_dest;
+            p_s16[2U * i]      = (int16_t) (p_left[i] >> Q31_SHIFT_16);
+            p_s16[2U * i + 1U] = (int16_t) (p_right[i] >> Q31_SHIFT_16);
+        }
+        else
+        {
+            int32_t * p_s32 = (int32_t *) p_dest;
+            p_s32[2U * i]      = p_left[i];
+            p_s32[2U * i + 1U] = p_right[i];
+        }
+    }
+#endif
+}
+
+/******************************************************************************
+ * Function Name   : pcm24_to_planar
+ * Description     : 24-bit packed little endian to Q31
+ * Arguments       : See paud_pcm_to_planar
+ * Return value    : None
+ ******************************************************************************/
+static void pcm24_to_planar (uint8_t const * p_src, int32_t * p_left, int32_t * p_right, uint32_t frames)
+{
+    for (uint32_t i = 0U; i < frames; i++)
+    {
+        p_left[i]  = (int32_t) (((uint32_t) p_src[0] << 8) | ((uint32_t) p_src[1] << 16) | ((uint32_t) p_src[2] << 24));
+        p_right[i] = (int32_t) (((uint32_t) p_src[3] << 8) | ((uint32_t) p_src[4] << 16) | ((uint32_t) p_src[5] << 24));
+        p_src     += 6U;
+    }
+}
+
+/******************************************************************************
+ * Function Name   : planar_to_pcm24
+ * Description     : Q31 to 24-bit packed little endian
+ * Arguments       : See paud_planar_to_pcm
+ * Return value    : None
+ ******************************************************************************/
+static void planar_to_pcm24 (int32_t const * p_left, int32_t const * p_right, uint8_t * p_dest, uint32_t frames)
+{
+    for (uint32_t i = 0U; i < frames; i++)
+    {
+        uint32_t left  = (uint32_t) p_left[i] >> Q31_SHIFT_24;
+        uint32_t right = (uint32_t) p_right[i] >> Q31_SHIFT_24;
+
+        p_dest[0] = (uint8_t) left;
+        p_dest[1] = (uint8_t) (left >> 8);
+        p_dest[2] = (uint8_t) (left >> 16);
+        p_dest[3] = (uint8_t) right;
+        p_dest[4] = (uint8_t) (right >> 8);
+        p_dest[5] = (uint8_t) (right >> 16);
+        p_dest   += 6U;
+    }
+}
+
+/*******************************************************************************************************************//**
+ * @} (end addtogroup usbx_paud_stream)
+ **********************************************************************************************************************/
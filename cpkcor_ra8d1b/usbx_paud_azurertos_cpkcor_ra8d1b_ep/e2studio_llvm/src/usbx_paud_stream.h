@@ -0,0 +1,81 @@
+/***********************************************************************************************************************
+ * File Name    : usbx_paud_stream.h
+ * Description  : Contains data structures and functions used in usbx_paud_stream.c
+ **********************************************************************************************************************/
+
+/*
+* Copyright (c) 2024 Renesas Electronics Corporation and/or its affiliates
+*
+* SPDX-License-Identifier: BSD-3-Clause
+*/
+
+#ifndef USBX_PAUD_STREAM_H_
+#define USBX_PAUD_STREAM_H_
+
+#include <stdint.h>
+
+/*******************************************************************************************************************//**
+ * @addtogroup usbx_paud_stream
+ * @{
+ **********************************************************************************************************************/
+
+/******************************************************************************
+ Macro definitions
+ ******************************************************************************/
+#define PAUD_CHANNELS                   (2U)
+#define PAUD_RING_SIZE                  (16384U)    /* Must be a power of two, about 85 ms of 48 kHz 16-bit stereo */
+#define PAUD_BLOCK_FRAMES               (48U)       /* Sample frames converted per block */
+#define PAUD_MAX_BYTES_PER_SAMPLE       (4U)
+
+/******************************************************************************
+ Typedef definitions
+ ******************************************************************************/
+/** Single producer / single consumer byte ring. Indexes run freely and are masked on access. */
+typedef struct st_paud_ring
+{
+    uint8_t         * p_buf;
+    uint32_t          size;
+    volatile uint32_t head;    /* Written by the producer only */
+    volatile uint32_t tail;    /* Written by the consumer only */
+} paud_ring_t;
+
+/** Local sample clock derived from the CPU cycle counter */
+typedef struct st_paud_clock
+{
+    uint32_t rate;             /* Sample frames per second */
+    uint32_t last_cycles;
+    uint64_t acc;              /* Fraction of a frame, in cycles * rate */
+} paud_clock_t;
+
+/** Streaming counters */
+typedef struct st_paud_stream_stats
+{
+    uint32_t rx_frames;        /* Sample frames played from the OUT ring */
+    uint32_t tx_frames;        /* Sample frames queued for IN */
+    uint32_t rx_overruns;      /* OUT packets dropped because the ring was full */
+    uint32_t rx_underruns;     /* Blocks padded with silence because the OUT ring ran dry */
+    uint32_t tx_underruns;     /* IN packets sent as silence because the IN ring ran dry */
+} paud_stream_stats_t;
+
+/******************************************************************************
+ Function prototypes
+ ******************************************************************************/
+void     paud_ring_init(paud_ring_t * p_ring, uint8_t * p_buf, uint32_t size);
+uint32_t paud_ring_used(paud_ring_t const * p_ring);
+uint32_t paud_ring_free(paud_ring_t const * p_ring);
+uint32_t paud_ring_write(paud_ring_t * p_ring, uint8_t const * p_src, uint32_t size);
+uint32_t paud_ring_read(paud_ring_t * p_ring, uint8_t * p_dest, uint32_t size);
+
+void     paud_clock_init(paud_clock_t * p_clock, uint32_t rate);
+uint32_t paud_clock_frames_due(paud_clock_t * p_clock);
+
+void     paud_pcm_to_planar(uint8_t const * p_src, uint32_t bytes_per_sample,
+                            int32_t * p_left, int32_t * p_right, uint32_t frames);
+void     paud_planar_to_pcm(int32_t const * p_left, int32_t const * p_right,
+                            uint8_t * p_dest, uint32_t bytes_per_sample, uint32_t frames);
+
+/*******************************************************************************************************************//**
+ * @} (end addtogroup usbx_paud_stream)
+ **********************************************************************************************************************/
+
+#endif /* USBX_PAUD_STREAM_H_ */
@@ -25,12 +25,14 @@
 #include "r_usb_basic.h"
 #include "r_usb_basic_cfg.h"
 #include "common_utils.h"
+#include "usbx_paud_stream.h"
 #include "usbx_paud_ep.h"
 #include "ux_api.h"
 #include "ux_system.h"
 #include "ux_device_class_audio.h"
 #include "ux_device_class_audio10.h"
 #include "ux_device_class_audio20.h"
+#include "ux_utility.h"
 
 /*******************************************************************************************************************//**
  * @addtogroup usbx_paud_ep
@@ -68,6 +70,22 @@ static uint16_t g_control_mute[VALUE_2];
 static uint32_t g_ux_pool_memory[MEMPOOL_SIZE / VALUE_4];
 static unsigned char GLOBAL_BUFF[GBUFF_SIZE];
 
+/* OUT data flows from the USBX read thread to this thread, IN data from this thread to the USBX write thread */
+static uint8_t g_rx_ring_buf[PAUD_RING_SIZE] BSP_ALIGN_VARIABLE(4);
+static uint8_t g_tx_ring_buf[PAUD_RING_SIZE] BSP_ALIGN_VARIABLE(4);
+static paud_ring_t g_rx_ring;
+static paud_ring_t g_tx_ring;
+static paud_clock_t g_audio_clock;
+static paud_stream_stats_t g_stream_stats;
+static paud_stream_stats_t g_stream_last;
+static bool g_rx_primed                             = false;
+static bool g_tx_primed                             = false;
+static uint32_t g_store_rp                          = RESET_VALUE;
+static ULONG g_report_time                          = RESET_VALUE;
+static int32_t g_work_left[PAUD_BLOCK_FRAMES];
+static int32_t g_work_right[PAUD_BLOCK_FRAMES];
+static uint8_t g_pcm_block[PAUD_BLOCK_FRAMES * PAUD_CHANNELS * PAUD_MAX_BYTES_PER_SAMPLE] BSP_ALIGN_VARIABLE(4);
+
 #ifdef APL_AUDIO_20
 static UX_DEVICE_CLASS_AUDIO20_CONTROL_GROUP g_audio20_control_group;
 static UX_DEVICE_CLASS_AUDIO20_CONTROL       g_audio20_control[VALUE_2];
@@ -86,6 +104,10 @@ static void apl_audio_write_change (UX_DEVICE_CLASS_AUDIO_STREAM * p_stream, ULO
 static void apl_audio_write_done (UX_DEVICE_CLASS_AUDIO_STREAM * p_stream, ULONG actual_length);
 static void apl_audio_instance_activate (void * p_instance);
 static void apl_audio_instance_deactivate (void * p_instance);
+static void apl_audio_process (void);
+static void apl_audio_play_block (uint32_t frames);
+static void apl_audio_record_block (uint32_t frames);
+static void apl_audio_report (void);
 
 /* USBX paud entry function */
 void usbx_paud_thread_entry(void)
@@ -226,6 +248,11 @@ void usbx_paud_thread_entry(void)
     /* clear write buffer */
     memset(g_write_buf, VALUE_0, USB_MAX_PACKET_SIZE_IN);
 
+    /* Streaming pipeline */
+    paud_ring_init(&g_rx_ring, g_rx_ring_buf, PAUD_RING_SIZE);
+    paud_ring_init(&g_tx_ring, g_tx_ring_buf, PAUD_RING_SIZE);
+    paud_clock_init(&g_audio_clock, A20_SAMPLING_FREQUENCY);
+
     /* Open usb driver */
     status = R_USB_Open(&g_basic0_ctrl, &g_basic0_cfg);
     /* Error Handle */
@@ -274,6 +301,9 @@ void usbx_paud_thread_entry(void)
             /* Reset the event flag */
             actual_flags = RESET_VALUE;
         }
+
+        /* Consume OUT and produce IN audio at the local sample rate */
+        apl_audio_process();
         tx_thread_sleep (1);
     }
 }
@@ -351,6 +381,7 @@ static void apl_audio_read_change (UX_DEVICE_CLASS_AUDIO_STREAM * p_stream, ULON
             g_read_frame_num    = RESET_VALUE;
             g_read_wp           = RESET_VALUE;
             g_length            = RESET_VALUE;
+            g_store_rp          = RESET_VALUE;
             if(g_flag == VALUE_1)
             {
                 PRINT_INFO_STR("USB Read Completed");
@@ -388,13 +419,16 @@ static void apl_audio_read_done (UX_DEVICE_CLASS_AUDIO_STREAM * p_stream, ULONG
         ux_err = ux_device_class_audio_read_frame_get(p_stream, &p_buffer, &length);
         if (UX_SUCCESS == ux_err)
         {
-            if (g_counter < GBUFF_SIZE - VALUE_1)
+            /* Drop the whole packet rather than part of it, a partial sample frame would swap the channels */
+            if (paud_ring_free(&g_rx_ring) >= length)
             {
-                for (UINT index = RESET_VALUE; index < length; index++)
-                {
-                    GLOBAL_BUFF[g_counter++] =  *(p_buffer + index);
-                }
+                paud_ring_write(&g_rx_ring, p_buffer, length);
+            }
+            else
+            {
+                g_stream_stats.rx_overruns++;
             }
+
             g_read_frame_num++;
             g_length = g_length + length;
             g_read_counter++ ;
@@ -434,7 +468,12 @@ static void apl_audio_write_change (UX_DEVICE_CLASS_AUDIO_STREAM * p_stream, ULO
 
     if (USB_APL_ON == alternate_setting)
     {
-        ux_err = ux_device_class_audio_frame_write(p_stream, g_write_buf, USB_MAX_PACKET_SIZE_IN);
+        /* The write thread is idle until transmission starts, so the consumer index can be reset here */
+        g_tx_ring.tail = g_tx_ring.head;
+        g_tx_primed    = false;
+
+        ux_err = ux_device_class_audio_frame_write(p_stream, g_write_buf,
+                                                   USB_AUDIO_PACKET_FRAMES * USB_AUDIO_FRAME_BYTES);
         if (UX_SUCCESS == ux_err)
         {
             ux_err = ux_device_class_audio_transmission_start(p_stream);
@@ -477,21 +516,63 @@ static void apl_audio_write_change (UX_DEVICE_CLASS_AUDIO_STREAM * p_stream, ULO
  ******************************************************************************/
 static void apl_audio_write_done (UX_DEVICE_CLASS_AUDIO_STREAM * p_stream, ULONG actual_length)
 {
-    static uint32_t write_counter = VALUE_0;
     FSP_PARAMETER_NOT_USED(actual_length);
-    UINT ux_err                   = UX_SUCCESS;
+    UINT     ux_err               = UX_SUCCESS;
+    UCHAR  * p_buffer             = NULL;
+    ULONG    max_length           = VALUE_0;
+    ULONG    length               = USB_AUDIO_PACKET_FRAMES * USB_AUDIO_FRAME_BYTES;
+    uint32_t level                = paud_ring_used(&g_tx_ring);
 
     if (USB_APL_ON == g_write_alternate_setting)
     {
-        ux_err=ux_device_class_audio_frame_write(p_stream, GLOBAL_BUFF + write_counter, USB_MAX_PACKET_SIZE_IN);
+        /* Asynchronous source: one sample frame more or less per packet holds the IN ring at its target */
+        if (level > (TX_TARGET_BYTES + length))
+        {
+            length += USB_AUDIO_FRAME_BYTES;
+        }
+        else if (level < (TX_TARGET_BYTES - length))
+        {
+            length -= USB_AUDIO_FRAME_BYTES;
+        }
+        else
+        {
+            /* Nominal packet */
+        }
+
+        ux_err = ux_device_class_audio_write_frame_get(p_stream, &p_buffer, &max_length);
+        if (UX_SUCCESS != ux_err)
+        {
+            PRINT_ERR_STR("ux_device_class_audio_write_frame_get is failed");
+            return;
+        }
+        if (length > max_length)
+        {
+            length = max_length;
+        }
+
+        /* Silence until the ring has built up its cushion, and again whenever it runs dry */
+        if ((true == g_tx_primed) || (level >= TX_TARGET_BYTES))
+        {
+            g_tx_primed = true;
+            if (paud_ring_read(&g_tx_ring, p_buffer, length) < length)
+            {
+                memset(p_buffer, VALUE_0, length);
+                g_stream_stats.tx_underruns++;
+                g_tx_primed = false;
+            }
+        }
+        else
+        {
+            memset(p_buffer, VALUE_0, length);
+        }
+
+        ux_err = ux_device_class_audio_write_frame_commit(p_stream, length);
         if (ux_err != UX_SUCCESS)
         {
-            PRINT_ERR_STR("ux_device_class_audio_frame_write is failed");
+            PRINT_ERR_STR("ux_device_class_audio_write_frame_commit is failed");
         }
         else
         {
-            write_counter = write_counter + USB_MAX_PACKET_SIZE_IN;
-            write_counter %= GBUFF_SIZE ;
             g_write_counter++;
             if(g_write_counter == VALUE_1)
             {
@@ -506,6 +587,163 @@ static void apl_audio_write_done (UX_DEVICE_CLASS_AUDIO_STREAM * p_stream, ULONG
  * End of function apl_audio_write_done
  ******************************************************************************/
 
+/******************************************************************************
+ * Function Name   : apl_audio_process
+ * Description     : Runs the pipeline for the sample frames elapsed on the local clock, in blocks of
+ *                   PAUD_BLOCK_FRAMES
+ * Arguments       : None
+ * Return value    : None
+ ******************************************************************************/
+static void apl_audio_process (void)
+{
+    uint32_t due    = paud_clock_frames_due(&g_audio_clock);
+    uint32_t frames = VALUE_0;
+
+    if (due > MAX_FRAMES_DUE)
+    {
+        due = MAX_FRAMES_DUE;
+    }
+
+    while (due > VALUE_0)
+    {
+        frames = (due > PAUD_BLOCK_FRAMES) ? PAUD_BLOCK_FRAMES : due;
+        apl_audio_play_block(frames);
+        apl_audio_record_block(frames);
+        due -= frames;
+    }
+
+    apl_audio_report();
+}
+
+/******************************************************************************
+ * End of function apl_audio_process
+ ******************************************************************************/
+
+/******************************************************************************
+ * Function Name   : apl_audio_play_block
+ * Description     : Consumer of the OUT ring. Converts one block from the bus format to Q31 planar and stores it
+ *                   in GLOBAL_BUFF in the sink format, the place where a codec driver would take the samples.
+ * Arguments       : uint32_t : number of sample frames
+ * Return value    : None
+ ******************************************************************************/
+static void apl_audio_play_block (uint32_t frames)
+{
+    uint32_t bus_bytes   = frames * USB_AUDIO_FRAME_BYTES;
+    uint32_t store_bytes = frames * PAUD_CHANNELS * STORE_BYTES_PER_SAMPLE;
+
+    if (USB_APL_ON != g_read_alternate_setting)
+    {
+        /* Producer has stopped, discard what is left */
+        g_rx_ring.tail = g_rx_ring.head;
+        g_rx_primed    = false;
+        return;
+    }
+
+    /* Start consuming once the ring holds its target level, so jitter on either side is absorbed */
+    if (true != g_rx_primed)
+    {
+        if (paud_ring_used(&g_rx_ring) < RX_TARGET_BYTES)
+        {
+            return;
+        }
+        g_rx_primed = true;
+    }
+
+    if (paud_ring_read(&g_rx_ring, g_pcm_block, bus_bytes) < bus_bytes)
+    {
+        /* Pad with silence and build the cushion up again */
+        memset(g_pcm_block, VALUE_0, bus_bytes);
+        g_stream_stats.rx_underruns++;
+        g_rx_primed = false;
+    }
+    g_stream_stats.rx_frames += frames;
+
+    paud_pcm_to_planar(g_pcm_block, USB_AUDIO_BYTES_PER_SAMPLE, g_work_left, g_work_right, frames);
+    paud_planar_to_pcm(g_work_left, g_work_right, g_pcm_block, STORE_BYTES_PER_SAMPLE, frames);
+
+    if ((g_counter + store_bytes) <= GBUFF_SIZE)
+    {
+        memcpy(&GLOBAL_BUFF[g_counter], g_pcm_block, store_bytes);
+        g_counter += store_bytes;
+    }
+}
+
+/******************************************************************************
+ * End of function apl_audio_play_block
+ ******************************************************************************/
+
+/******************************************************************************
+ * Function Name   : apl_audio_record_block
+ * Description     : Producer of the IN ring. Takes one block of the stored audio in the sink format and converts
+ *                   it to the bus format.
+ * Arguments       : uint32_t : number of sample frames
+ * Return value    : None
+ ******************************************************************************/
+static void apl_audio_record_block (uint32_t frames)
+{
+    uint32_t bus_bytes   = frames * USB_AUDIO_FRAME_BYTES;
+    uint32_t store_bytes = frames * PAUD_CHANNELS * STORE_BYTES_PER_SAMPLE;
+    uint32_t first       = GBUFF_SIZE - g_store_rp;
+
+    /* Nothing to do while the host is not recording, or is not taking the data */
+    if ((USB_APL_ON != g_write_alternate_setting) || (paud_ring_free(&g_tx_ring) < bus_bytes))
+    {
+        return;
+    }
+
+    if (first > store_bytes)
+    {
+        first = store_bytes;
+    }
+    memcpy(g_pcm_block, &GLOBAL_BUFF[g_store_rp], first);
+    memcpy(g_pcm_block + first, &GLOBAL_BUFF[VALUE_0], store_bytes - first);
+    g_store_rp = (g_store_rp + store_bytes) % GBUFF_SIZE;
+
+    paud_pcm_to_planar(g_pcm_block, STORE_BYTES_PER_SAMPLE, g_work_left, g_work_right, frames);
+    paud_planar_to_pcm(g_work_left, g_work_right, g_pcm_block, USB_AUDIO_BYTES_PER_SAMPLE, frames);
+
+    paud_ring_write(&g_tx_ring, g_pcm_block, bus_bytes);
+    g_stream_stats.tx_frames += frames;
+}
+
+/******************************************************************************
+ * End of function apl_audio_record_block
+ ******************************************************************************/
+
+/******************************************************************************
+ * Function Name   : apl_audio_report
+ * Description     : Prints the pipeline counters once per second while a stream is active
+ * Arguments       : None
+ * Return value    : None
+ ******************************************************************************/
+static void apl_audio_report (void)
+{
+    char  msg[STREAM_MSG_LEN] = {RESET_VALUE};
+    ULONG now                 = tx_time_get();
+
+    if ((now - g_report_time) < STREAM_REPORT_TICKS)
+    {
+        return;
+    }
+    g_report_time = now;
+
+    if ((USB_APL_ON == g_read_alternate_setting) || (USB_APL_ON == g_write_alternate_setting))
+    {
+        snprintf(msg, sizeof(msg), "Audio out %lu in %lu frames/s, out overrun %lu underrun %lu, in underrun %lu",
+                 (unsigned long) (g_stream_stats.rx_frames - g_stream_last.rx_frames),
+                 (unsigned long) (g_stream_stats.tx_frames - g_stream_last.tx_frames),
+                 (unsigned long) g_stream_stats.rx_overruns,
+                 (unsigned long) g_stream_stats.rx_underruns,
+                 (unsigned long) g_stream_stats.tx_underruns);
+        app_rtt_print_data(RTT_OUTPUT_MESSAGE_APP_INFO_STR, (uint32_t) (strlen(msg) + VALUE_1), msg);
+    }
+    g_stream_last = g_stream_stats;
+}
+
+/******************************************************************************
+ * End of function apl_audio_report
+ ******************************************************************************/
+
 /******************************************************************************
  * Function Name   : apl_audio_read_instance_activate
  * Description     : Get instance
@@ -24,6 +24,7 @@
 #include "pcdc_acm_thread.h"
 #include "ux_api.h"
 #include "ux_device_class_cdc_acm.h"
+#include "usbx_pcdc_stream.h"
 #include "usbx_pcdc_acm_ep.h"
 #include "common_utils.h"
 /*******************************************************************************************************************//**
@@ -58,6 +59,8 @@ static void ux_cdc_device0_instance_activate(void * cdc_instance);
 static void ux_cdc_device0_instance_deactivate(void * cdc_instance);
 static void usb_connection_status_check(void);
 static void usbx_pcdc_operations(void);
+static void usbx_pcdc_stream_operations(void);
+static void usbx_pcdc_stream_report(ULONG elapsed_ticks);
 /* Mempool size of 18k is required for USBX device class pre built libraries
  * and it is valid only if it with default USBX configurations. */
 static uint32_t g_ux_pool_memory[MEMPOOL_SIZE / BYTE_SIZE];
@@ -181,8 +184,15 @@ void pcdc_acm_thread_entry(void)
     /* usb pcdc operations will echo the user input on serial terminal*/
     while (true)
     {
-        usbx_pcdc_operations ();
-        tx_thread_sleep (1);
+        if (PCDC_STREAM_MODE)
+        {
+            usbx_pcdc_stream_operations ();
+        }
+        else
+        {
+            usbx_pcdc_operations ();
+            tx_thread_sleep (1);
+        }
     }
 }
 
@@ -276,6 +286,90 @@ static void usbx_pcdc_operations(void)
     }
 }
 
+/*******************************************************************************************************************//**
+ * @brief     In this function, it runs the batched loopback until the instance is deactivated. Reception and
+ *            transmission are driven by the USBX transmission callbacks, this thread only moves data from the RX
+ *            ring to the TX ring whenever the callbacks signal progress, and reports the throughput once a second.
+ * @param[IN] none
+ * @retval    none
+ **********************************************************************************************************************/
+static void usbx_pcdc_stream_operations(void)
+{
+    UINT status = UX_SUCCESS;
+    ULONG actual_flags = RESET_VALUE;
+    ULONG report_tick = RESET_VALUE;
+    volatile UX_SLAVE_DEVICE *device;
+    device = &_ux_system_slave->ux_system_slave_device;
+
+    /* Verify the status of usb */
+    usb_connection_status_check ();
+
+    /* Wait until usb device is configured to slave and the cdc instance is activated */
+    while ((device->ux_slave_device_state != UX_DEVICE_CONFIGURED) || (UX_NULL == g_cdc))
+    {
+        tx_thread_sleep (1);
+    }
+
+    status = pcdc_stream_start (g_cdc, &g_cdcacm_event_flags0);
+    /* Error Handle */
+    if (UX_SUCCESS != status)
+    {
+        PRINT_ERR_STR("pcdc_stream_start failed..");
+        ERROR_TRAP(status);
+    }
+
+    PRINT_INFO_STR("CDC stream loopback started, send data from the host to measure the throughput");
+
+    report_tick = tx_time_get ();
+    while (UX_NULL != g_cdc)
+    {
+        /* Wake up on received data or freed TX space, at least once per report interval */
+        tx_event_flags_get (&g_cdcacm_event_flags0, PCDC_STREAM_FLAG, TX_OR_CLEAR, &actual_flags, STREAM_REPORT_TICKS);
+
+        pcdc_stream_echo ();
+
+        if ((tx_time_get () - report_tick) >= STREAM_REPORT_TICKS)
+        {
+            usbx_pcdc_stream_report (tx_time_get () - report_tick);
+            report_tick = tx_time_get ();
+        }
+    }
+
+    pcdc_stream_stop ();
+    PRINT_INFO_STR("CDC stream loopback stopped");
+}
+
+/*******************************************************************************************************************//**
+ * @brief     In this function, it prints the loopback throughput of the last interval, if there was traffic.
+ * @param[IN] elapsed_ticks    length of the interval
+ * @retval    none
+ **********************************************************************************************************************/
+static void usbx_pcdc_stream_report(ULONG elapsed_ticks)
+{
+    static pcdc_stream_stats_t last_stats;
+    pcdc_stream_stats_t stats;
+    char msg[STREAM_MSG_LEN] = {RESET_VALUE};
+    uint32_t rx_kbps = RESET_VALUE;
+    uint32_t tx_kbps = RESET_VALUE;
+
+    pcdc_stream_stats_get (&stats);
+    if ((stats.rx_bytes == last_stats.rx_bytes) && (stats.tx_bytes == last_stats.tx_bytes))
+    {
+        last_stats = stats;
+        return;
+    }
+
+    rx_kbps = (uint32_t) (((uint64_t) (stats.rx_bytes - last_stats.rx_bytes) * TX_TIMER_TICKS_PER_SECOND) / (elapsed_ticks * 1024U));
+    tx_kbps = (uint32_t) (((uint64_t) (stats.tx_bytes - last_stats.tx_bytes) * TX_TIMER_TICKS_PER_SECOND) / (elapsed_ticks * 1024U));
+
+    snprintf (msg, sizeof(msg), "RX %lu KB/s TX %lu KB/s writes %lu stalls %lu errors %lu",
+              (unsigned long) rx_kbps, (unsigned long) tx_kbps, (unsigned long) (stats.tx_writes - last_stats.tx_writes),
+              (unsigned long) stats.rx_stalls, (unsigned long) stats.errors);
+    app_rtt_print_data (RTT_OUTPUT_MESSAGE_APP_INFO_STR, strlen (msg) + 1U, msg);
+
+    last_stats = stats;
+}
+
 /*******************************************************************************************************************//**
  * @brief     In this function, it activates the cdc instance.
  * @param[IN] cdc_instance    Pointer to the area store the instance pointer
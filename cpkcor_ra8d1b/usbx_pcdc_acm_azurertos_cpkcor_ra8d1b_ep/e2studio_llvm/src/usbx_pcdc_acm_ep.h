@@ -53,12 +53,19 @@
 #define CONFIG_NUMB                                 (1U)
 #define INTERFACE_NUMB0                             (0x00)
 #define INTERFACE_NUMB1                             (0x01)
+#define PCDC_STREAM_MODE                            (1)     /* 1: batched loopback with throughput report, 0: echo demo */
+#if PCDC_STREAM_MODE
+#define MEMPOOL_SIZE                                (18432U + PCDC_STREAM_MEMPOOL_SIZE)
+#else
 #define MEMPOOL_SIZE                                (18432U)
+#endif
 #define BYTE_SIZE                                   (4U)
 #define DATA_LEN                                    (2048U)
 #define WRITE_DATA_LEN                              (62U)
 #define MAX_PACKET_SIZE_HS                          (512U)
 #define MAX_PACKET_SIZE_FS                          (64U)
+#define STREAM_REPORT_TICKS                         (TX_TIMER_TICKS_PER_SECOND)
+#define STREAM_MSG_LEN                              (96U)
 
 
 #endif /* USBX_PCDC_ACM_EP_H_ */
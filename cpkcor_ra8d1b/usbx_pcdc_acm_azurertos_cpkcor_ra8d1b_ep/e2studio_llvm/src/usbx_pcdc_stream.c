@@ -0,0 +1,401 @@
+/***********************************************************************************************************************
+ * File Name    : usbx_pcdc_stream.c
+ * Description  : Contains macros and functions used in usbx_pcdc_stream.c
+ **********************************************************************************************************************/
+
+/*
+* Copyright (c) 2024 Renesas Electronics Corporation and/or its affiliates
+*
+* SPDX-License-Identifier: BSD-3-Clause
+*/
+
+#include "common_utils.h"
+#include "usbx_pcdc_stream.h"
+
+/*******************************************************************************************************************//**
+ * @addtogroup usbx_pcdc_stream
+ * @{
+ **********************************************************************************************************************/
+
+/******************************************************************************
+ Macro definitions
+ ******************************************************************************/
+#define MAX_PACKET_SIZE_HS_BULK         (512U)
+#define MAX_PACKET_SIZE_FS_BULK         (64U)
+
+/******************************************************************************
+ Private global variables and functions
+ ******************************************************************************/
+static uint8_t g_rx_ring_buf[PCDC_STREAM_RX_RING_SIZE];
+static uint8_t g_tx_ring_buf[PCDC_STREAM_TX_RING_SIZE];
+static pcdc_ring_t g_rx_ring = {g_rx_ring_buf, PCDC_STREAM_RX_RING_SIZE, RESET_VALUE, RESET_VALUE};
+static pcdc_ring_t g_tx_ring = {g_tx_ring_buf, PCDC_STREAM_TX_RING_SIZE, RESET_VALUE, RESET_VALUE};
+static UX_SLAVE_CLASS_CDC_ACM * volatile gp_cdc = UX_NULL;
+static TX_EVENT_FLAGS_GROUP * gp_flags = UX_NULL;
+static volatile bool g_tx_busy = false;
+static volatile bool g_rx_held = false;
+static uint32_t g_tx_len = RESET_VALUE;
+static uint32_t g_max_packet_size = MAX_PACKET_SIZE_FS_BULK;
+static pcdc_stream_stats_t g_stats;
+
+static uint32_t ring_used(pcdc_ring_t const * p_ring);
+static uint32_t ring_free(pcdc_ring_t const * p_ring);
+static uint32_t ring_span(pcdc_ring_t const * p_ring, uint8_t ** pp_data);
+static uint32_t ring_put(pcdc_ring_t * p_ring, uint8_t const * p_src, uint32_t size);
+static uint32_t ring_get(pcdc_ring_t * p_ring, uint8_t * p_dest, uint32_t size);
+static void stream_tx_kick(void);
+static void stream_rx_release(void);
+static UINT stream_read_callback(UX_SLAVE_CLASS_CDC_ACM * p_cdc, UINT status, UCHAR * p_data, ULONG length);
+static UINT stream_write_callback(UX_SLAVE_CLASS_CDC_ACM * p_cdc, UINT status, ULONG length);
+
+/*******************************************************************************************************************//**
+ * @brief     Switch the CDC instance to transmission mode. From here on USBX keeps the bulk OUT pipe armed from its
+ *            own thread and hands every completed transfer to the read callback, so reception never waits for the
+ *            application. ux_device_class_cdc_acm_read/write must not be used until pcdc_stream_stop().
+ * @param[IN] p_cdc      activated CDC-ACM instance
+ * @param[IN] p_flags    event flags group PCDC_STREAM_FLAG is signalled on
+ * @retval    UX_SUCCESS or the ux_device_class_cdc_acm_ioctl error
+ **********************************************************************************************************************/
+UINT pcdc_stream_start(UX_SLAVE_CLASS_CDC_ACM * p_cdc, TX_EVENT_FLAGS_GROUP * p_flags)
+{
+    UX_SLAVE_CLASS_CDC_ACM_CALLBACK_PARAMETER callback_info;
+    UINT status = UX_SUCCESS;
+
+    /* Start from empty rings, nothing is in flight yet */
+    g_rx_ring.head = g_rx_ring.tail = RESET_VALUE;
+    g_tx_ring.head = g_tx_ring.tail = RESET_VALUE;
+    g_tx_busy      = false;
+    g_rx_held      = false;
+    memset(&g_stats, RESET_VALUE, sizeof(g_stats));
+
+    g_max_packet_size = (UX_HIGH_SPEED_DEVICE == _ux_system_slave->ux_system_slave_speed) ?
+                        MAX_PACKET_SIZE_HS_BULK : MAX_PACKET_SIZE_FS_BULK;
+    gp_flags = p_flags;
+
+    callback_info.ux_device_class_cdc_acm_parameter_write_buffer_size = PCDC_STREAM_WRITE_SIZE;
+    callback_info.ux_device_class_cdc_acm_parameter_read_buffer_size  = PCDC_STREAM_READ_SIZE;
+    callback_info.ux_device_class_cdc_acm_parameter_write_callback    = stream_write_callback;
+    callback_info.ux_device_class_cdc_acm_parameter_read_callback     = stream_read_callback;
+
+    status = ux_device_class_cdc_acm_ioctl(p_cdc, UX_SLAVE_CLASS_CDC_ACM_IOCTL_TRANSMISSION_START, &callback_info);
+    if (UX_SUCCESS == status)
+    {
+        gp_cdc = p_cdc;
+    }
+    return status;
+}
+
+/*******************************************************************************************************************//**
+ * @brief     Leave transmission mode. Data still in the rings, or held by the read callback, is dropped.
+ * @param[IN] none
+ * @retval    UX_SUCCESS or the ux_device_class_cdc_acm_ioctl error
+ **********************************************************************************************************************/
+UINT pcdc_stream_stop(void)
+{
+    UX_SLAVE_CLASS_CDC_ACM * p_cdc = gp_cdc;
+
+    gp_cdc = UX_NULL;
+    if (UX_NULL == p_cdc)
+    {
+        return UX_SUCCESS;
+    }
+
+    /* Release a read callback waiting for RX ring space, it sees the stream stopped */
+    tx_event_flags_set(gp_flags, PCDC_STREAM_RX_SPACE_FLAG, TX_OR);
+    return ux_device_class_cdc_acm_ioctl(p_cdc, UX_SLAVE_CLASS_CDC_ACM_IOCTL_TRANSMISSION_STOP, UX_NULL);
+}
+
+/*******************************************************************************************************************//**
+ * @brief     Take received data out of the RX ring without blocking.
+ * @param[IN] p_dest    destination buffer
+ * @param[IN] size      size of the destination buffer
+ * @retval    number of bytes copied
+ **********************************************************************************************************************/
+uint32_t pcdc_stream_read(uint8_t * p_dest, uint32_t size)
+{
+    uint32_t taken = ring_get(&g_rx_ring, p_dest, size);
+
+    if (RESET_VALUE != taken)
+    {
+        stream_rx_release();
+    }
+    return taken;
+}
+
+/*******************************************************************************************************************//**
+ * @brief     Queue data for the host without blocking. Consecutive calls are batched into one bulk IN request.
+ * @param[IN] p_src     data to send
+ * @param[IN] size      number of bytes
+ * @retval    number of bytes queued, less than size if the TX ring is full
+ **********************************************************************************************************************/
+uint32_t pcdc_stream_write(uint8_t const * p_src, uint32_t size)
+{
+    uint32_t queued = ring_put(&g_tx_ring, p_src, size);
+
+    stream_tx_kick();
+    return queued;
+}
+
+/*******************************************************************************************************************//**
+ * @brief     Loopback: move as much as possible from the RX ring into the TX ring, without an intermediate copy.
+ * @param[IN] none
+ * @retval    number of bytes echoed
+ **********************************************************************************************************************/
+uint32_t pcdc_stream_echo(void)
+{
+    uint8_t * p_data = NULL;
+    uint32_t  span   = RESET_VALUE;
+    uint32_t  moved  = RESET_VALUE;
+    uint32_t  total  = RESET_VALUE;
+
+    /* At most two spans, the RX ring wraps once */
+    for (uint32_t cnt = RESET_VALUE; cnt < 2U; cnt++)
+    {
+        span = ring_span(&g_rx_ring, &p_data);
+        if (RESET_VALUE == span)
+        {
+            break;
+        }
+        moved = ring_put(&g_tx_ring, p_data, span);
+        __DMB();
+        g_rx_ring.tail += moved;
+        total += moved;
+        if (moved < span)
+        {
+            /* TX ring full, the rest goes out after the next write completion */
+            break;
+        }
+    }
+
+    if (RESET_VALUE != total)
+    {
+        stream_rx_release();
+    }
+    stream_tx_kick();
+    return total;
+}
+
+/*******************************************************************************************************************//**
+ * @brief     Copy the streaming counters.
+ * @param[IN] p_stats   destination
+ * @retval    none
+ **********************************************************************************************************************/
+void pcdc_stream_stats_get(pcdc_stream_stats_t * p_stats)
+{
+    *p_stats = g_stats;
+}
+
+/*******************************************************************************************************************//**
+ * @brief     Hand the next contiguous block of the TX ring to USBX if no write is in progress.
+ *            A block whose length is a multiple of the max packet size would need a ZLP to terminate the transfer on
+ *            the host. The last byte is held back instead, it opens the next block, so no ZLP is ever required.
+ * @param[IN] none
+ * @retval    none
+ **********************************************************************************************************************/
+static void stream_tx_kick(void)
+{
+    TX_INTERRUPT_SAVE_AREA
+    UX_SLAVE_CLASS_CDC_ACM * p_cdc = gp_cdc;
+    uint8_t * p_data = NULL;
+    uint32_t  len    = RESET_VALUE;
+    UINT      status = UX_SUCCESS;
+
+    if (UX_NULL == p_cdc)
+    {
+        return;
+    }
+
+    /* Kicked from the application thread and from the write callback, only one of them may start the write */
+    TX_DISABLE
+    if (true == g_tx_busy)
+    {
+        TX_RESTORE
+        return;
+    }
+    len = ring_span(&g_tx_ring, &p_data);
+    if (len > PCDC_STREAM_WRITE_MAX)
+    {
+        len = PCDC_STREAM_WRITE_MAX;
+    }
+    if ((RESET_VALUE != len) && (RESET_VALUE == (len % g_max_packet_size)))
+    {
+        len--;
+    }
+    if (RESET_VALUE == len)
+    {
+        TX_RESTORE
+        return;
+    }
+    g_tx_busy = true;
+    g_tx_len  = len;
+    TX_RESTORE
+
+    status = ux_device_class_cdc_acm_write_with_callback(p_cdc, p_data, len);
+    if (UX_SUCCESS != status)
+    {
+        g_stats.errors++;
+        g_tx_busy = false;
+    }
+    else
+    {
+        g_stats.tx_writes++;
+    }
+}
+
+/*******************************************************************************************************************//**
+ * @brief     Wake the read callback if it waits for the RX ring space the application just freed.
+ * @param[IN] none
+ * @retval    none
+ **********************************************************************************************************************/
+static void stream_rx_release(void)
+{
+    /* Pairs with the barrier in stream_read_callback, either the callback sees the new tail or this sees it held */
+    __DMB();
+    if (true == g_rx_held)
+    {
+        tx_event_flags_set(gp_flags, PCDC_STREAM_RX_SPACE_FLAG, TX_OR);
+    }
+}
+
+/*******************************************************************************************************************//**
+ * @brief     Called by the USBX bulk OUT thread with every completed transfer. The USBX buffer is re-armed as soon as
+ *            this returns, so while the RX ring is full the transfer is held here instead. The bulk OUT pipe stays
+ *            unarmed and NAKs the host until the application frees space, so no received data is dropped.
+ **********************************************************************************************************************/
+static UINT stream_read_callback(UX_SLAVE_CLASS_CDC_ACM * p_cdc, UINT status, UCHAR * p_data, ULONG length)
+{
+    ULONG    actual_flags = RESET_VALUE;
+    uint32_t left         = (uint32_t) length;
+    uint32_t stored       = RESET_VALUE;
+
+    FSP_PARAMETER_NOT_USED(p_cdc);
+
+    if (UX_SUCCESS != status)
+    {
+        g_stats.errors++;
+        return UX_SUCCESS;
+    }
+
+    g_stats.rx_bytes += (uint32_t) length;
+    while (true)
+    {
+        stored  = ring_put(&g_rx_ring, p_data, left);
+        p_data += stored;
+        left   -= stored;
+        tx_event_flags_set(gp_flags, PCDC_STREAM_FLAG, TX_OR);
+        if ((RESET_VALUE == left) || (UX_NULL == gp_cdc))
+        {
+            break;
+        }
+
+        g_rx_held = true;
+        __DMB();
+        if (RESET_VALUE == ring_free(&g_rx_ring))
+        {
+            g_stats.rx_stalls++;
+            tx_event_flags_get(gp_flags, PCDC_STREAM_RX_SPACE_FLAG, TX_OR_CLEAR, &actual_flags, TX_WAIT_FOREVER);
+        }
+        g_rx_held = false;
+    }
+
+    return UX_SUCCESS;
+}
+
+/*******************************************************************************************************************//**
+ * @brief     Called by the USBX bulk IN thread when a write_with_callback request is done. Releases the block from
+ *            the TX ring and starts the next one.
+ **********************************************************************************************************************/
+static UINT stream_write_callback(UX_SLAVE_CLASS_CDC_ACM * p_cdc, UINT status, ULONG length)
+{
+    FSP_PARAMETER_NOT_USED(p_cdc);
+
+    if (UX_SUCCESS != status)
+    {
+        g_stats.errors++;
+    }
+    g_stats.tx_bytes += (uint32_t) length;
+
+    g_tx_ring.tail += g_tx_len;
+    g_tx_busy = false;
+
+    stream_tx_kick();
+
+    /* TX ring space was freed, let the application refill it */
+    tx_event_flags_set(gp_flags, PCDC_STREAM_FLAG, TX_OR);
+    return UX_SUCCESS;
+}
+
+/*******************************************************************************************************************//**
+ * @brief     Ring helpers. The producer only writes head, the consumer only writes tail, and the data barrier orders
+ *            the payload against the index update, so no lock is needed between the USBX threads and the
+ *            application.
+ **********************************************************************************************************************/
+static uint32_t ring_used(pcdc_ring_t const * p_ring)
+{
+    return p_ring->head - p_ring->tail;
+}
+
+static uint32_t ring_free(pcdc_ring_t const * p_ring)
+{
+    return p_ring->size - ring_used(p_ring);
+}
+
+static uint32_t ring_span(pcdc_ring_t const * p_ring, uint8_t ** pp_data)
+{
+    uint32_t used   = ring_used(p_ring);
+    uint32_t offset = p_ring->tail & (p_ring->size - 1U);
+    uint32_t span   = p_ring->size - offset;
+
+    *pp_data = &p_ring->p_buf[offset];
+    return (used < span) ? used : span;
+}
+
+static uint32_t ring_put(pcdc_ring_t * p_ring, uint8_t const * p_src, uint32_t size)
+{
+    uint32_t offset = p_ring->head & (p_ring->size - 1U);
+    uint32_t first  = RESET_VALUE;
+    uint32_t space  = ring_free(p_ring);
+
+    if (size > space)
+    {
+        size = space;
+    }
+    first = p_ring->size - offset;
+    if (first > size)
+    {
+        first = size;
+    }
+    memcpy(&p_ring->p_buf[offset], p_src, first);
+    memcpy(&p_ring->p_buf[RESET_VALUE], p_src + first, size - first);
+
+    __DMB();
+    p_ring->head += size;
+    return size;
+}
+
+static uint32_t ring_get(pcdc_ring_t * p_ring, uint8_t * p_dest, uint32_t size)
+{
+    uint32_t offset = p_ring->tail & (p_ring->size - 1U);
+    uint32_t first  = RESET_VALUE;
+    uint32_t used   = ring_used(p_ring);
+
+    if (size > used)
+    {
+        size = used;
+    }
+    first = p_ring->size - offset;
+    if (first > size)
+    {
+        first = size;
+    }
+    memcpy(p_dest, &p_ring->p_buf[offset], first);
+    memcpy(p_dest + first, &p_ring->p_buf[RESET_VALUE], size - first);
+
+    __DMB();
+    p_ring->tail += size;
+    return size;
+}
+
+/*******************************************************************************************************************//**
+ * @} (end addtogroup usbx_pcdc_stream)
+ **********************************************************************************************************************/
@@ -0,0 +1,76 @@
+/***********************************************************************************************************************
+ * File Name    : usbx_pcdc_stream.h
+ * Description  : Contains data structures and functions used in usbx_pcdc_stream.c
+ **********************************************************************************************************************/
+
+/*
+* Copyright (c) 2024 Renesas Electronics Corporation and/or its affiliates
+*
+* SPDX-License-Identifier: BSD-3-Clause
+*/
+
+#ifndef USBX_PCDC_STREAM_H_
+#define USBX_PCDC_STREAM_H_
+
+#include "ux_api.h"
+#include "ux_device_class_cdc_acm.h"
+
+/*******************************************************************************************************************//**
+ * @addtogroup usbx_pcdc_stream
+ * @{
+ **********************************************************************************************************************/
+
+/******************************************************************************
+ Macro definitions
+ ******************************************************************************/
+#define PCDC_STREAM_RX_RING_SIZE        (16384U)   /* Must be a power of two */
+#define PCDC_STREAM_TX_RING_SIZE        (16384U)   /* Must be a power of two */
+#define PCDC_STREAM_READ_SIZE           (UX_SLAVE_REQUEST_DATA_MAX_LENGTH)  /* Bytes per bulk OUT transfer */
+#define PCDC_STREAM_WRITE_SIZE          (UX_SLAVE_REQUEST_DATA_MAX_LENGTH)  /* Bytes per bulk IN transfer */
+#define PCDC_STREAM_WRITE_MAX           (PCDC_STREAM_TX_RING_SIZE / 2U)     /* Bytes per write_with_callback */
+/* USBX allocates the bulk IN/OUT threads of transmission mode from the USBX memory pool */
+#define PCDC_STREAM_MEMPOOL_SIZE        (2U * UX_THREAD_STACK_SIZE + 1024U)
+
+/* Event flag set when data arrives or TX ring space is freed, the application blocks on it */
+#define PCDC_STREAM_FLAG                ((ULONG) 0x0010)
+/* Event flag set when RX ring space is freed while a received transfer waits for it, the USBX bulk OUT thread
+ * blocks on it */
+#define PCDC_STREAM_RX_SPACE_FLAG       ((ULONG) 0x0020)
+
+/******************************************************************************
+ Typedef definitions
+ ******************************************************************************/
+/** Single producer / single consumer byte ring. Indexes run freely and are masked on access. */
+typedef struct st_pcdc_ring
+{
+    uint8_t         * p_buf;
+    uint32_t          size;
+    volatile uint32_t head;    /* Written by the producer only */
+    volatile uint32_t tail;    /* Written by the consumer only */
+} pcdc_ring_t;
+
+/** Streaming counters, accumulated since pcdc_stream_start() */
+typedef struct st_pcdc_stream_stats
+{
+    uint32_t rx_bytes;         /* Bytes received from the host */
+    uint32_t tx_bytes;         /* Bytes sent to the host */
+    uint32_t rx_stalls;        /* Waits of the bulk OUT thread for RX ring space */
+    uint32_t tx_writes;        /* write_with_callback requests */
+    uint32_t errors;           /* Failed transfers */
+} pcdc_stream_stats_t;
+
+/******************************************************************************
+ Function prototypes
+ ******************************************************************************/
+UINT     pcdc_stream_start(UX_SLAVE_CLASS_CDC_ACM * p_cdc, TX_EVENT_FLAGS_GROUP * p_flags);
+UINT     pcdc_stream_stop(void);
+uint32_t pcdc_stream_read(uint8_t * p_dest, uint32_t size);
+uint32_t pcdc_stream_write(uint8_t const * p_src, uint32_t size);
+uint32_t pcdc_stream_echo(void);
+void     pcdc_stream_stats_get(pcdc_stream_stats_t * p_stats);
+
+/*******************************************************************************************************************//**
+ * @} (end addtogroup usbx_pcdc_stream)
+ **********************************************************************************************************************/
+
+#endif /* USBX_PCDC_STREAM_H_ */
@@ -0,0 +1,1329 @@
+/***********************************************************************************************************************
+ * File Name    : iperf.c
+ * Description  : iperf2 / iperf3 compatible throughput server and client. The protocol logic is independent of the
+ *                network stack, see iperf_port.h for the services a port provides.
+ **********************************************************************************************************************/
+
+/*
+* Copyright (c) 2024 Renesas Electronics Corporation and/or its affiliates
+*
+* SPDX-License-Identifier: BSD-3-Clause
+*/
+
+#include <stdio.h>
+#include <string.h>
+#include "iperf.h"
+#include "iperf_port.h"
+
+/*******************************************************************************************************************//**
+ * @addtogroup iperf
+ * @{
+ **********************************************************************************************************************/
+
+/******************************************************************************
+ Macro definitions
+ ******************************************************************************/
+#define IPERF_WAIT_FOREVER          (0xFFFFFFFFU)
+#define IPERF_POLL_MS               (100U)      /* Workers and the session loop check for stop this often */
+#define IPERF_CTRL_TIMEOUT_MS       (10000U)
+#define IPERF_UDP_IDLE_MS           (5000U)     /* A UDP server session ends after this long without datagrams */
+#define IPERF_UDP_LINGER_MS         (500U)      /* Keep answering repeated FINs after the last stream ended */
+
+/* iperf 2.0.x wire format */
+#define IPERF2_CLIENT_HDR_SIZE      (24U)       /* flags, numThreads, mPort, bufferlen, mWinBand, mAmount */
+#define IPERF2_UDP_HDR_SIZE         (12U)       /* id, tv_sec, tv_usec */
+#define IPERF2_SERVER_HDR_SIZE      (40U)       /* Report returned with the FIN acknowledgement */
+#define IPERF2_HEADER_VERSION1      (0x80000000U)
+#define IPERF2_FIN_RETRIES          (10U)
+#define IPERF2_FIN_WAIT_MS          (250U)
+
+/* iperf3 control protocol */
+#define IPERF3_COOKIE_SIZE          (37U)
+#define IPERF3_JSON_MAX             (512U)
+#define IPERF3_TEST_START           (1)
+#define IPERF3_TEST_RUNNING         (2)
+#define IPERF3_TEST_END             (4)
+#define IPERF3_PARAM_EXCHANGE       (9)
+#define IPERF3_CREATE_STREAMS       (10)
+#define IPERF3_EXCHANGE_RESULTS     (13)
+#define IPERF3_DISPLAY_RESULTS      (14)
+#define IPERF3_IPERF_DONE           (16)
+#define IPERF3_ACCESS_DENIED        (-1)
+
+/******************************************************************************
+ Typedef definitions
+ ******************************************************************************/
+typedef struct st_iperf_stream
+{
+    iperf_sock_t    * p_sock;
+    uint32_t          slot;
+    uint32_t          id;                       /* iperf3 stream id */
+    bool              sender;
+    bool              running;
+    volatile bool     done;
+    volatile uint32_t bytes;                    /* Updated by the worker, wraps */
+    uint32_t          bytes_seen;               /* Part of bytes already reported */
+    uint64_t          total;
+
+    /* UDP */
+    uint32_t          ip;
+    uint16_t          port;
+    uint32_t          kbps;
+    int32_t           next_id;
+    uint32_t          lost;
+    uint32_t          out_of_order;
+    uint32_t          jitter_us;
+    int32_t           last_transit;
+    bool              fin;
+    bool              acked;
+} iperf_stream_t;
+
+typedef struct st_iperf_session
+{
+    iperf_cfg_t       cfg;
+    iperf_report_cb_t report;
+    iperf_stream_t    streams[IPERF_MAX_STREAMS];
+    uint32_t          count;
+    volatile bool     stop;
+    uint32_t          t0;
+    uint32_t          t_last;
+    uint64_t          cpu_weighted;             /* cpu_load * ms */
+    uint32_t          cpu_ms;
+} iperf_session_t;
+
+/******************************************************************************
+ Private global variables and functions
+ ******************************************************************************/
+static iperf_session_t g_iperf;
+static uint8_t         g_iperf_buf[IPERF_MAX_STREAMS][IPERF_BUF_SIZE];
+static char            g_iperf_json[IPERF3_JSON_MAX];
+
+static int32_t          iperf2_tcp_server(void);
+static int32_t          iperf2_udp_server(void);
+static int32_t          iperf2_udp_client(void);
+static int32_t          iperf3_server(void);
+static int32_t          iperf_tcp_client(void);
+
+static void             iperf_tcp_worker(void * p_arg);
+static void             iperf_udp_worker(void * p_arg);
+static iperf_stream_t * iperf_stream_add(iperf_sock_t * p_sock, bool sender);
+static int32_t          iperf_streams_start(void (* p_entry)(void * p_arg));
+static bool             iperf_streams_done(void);
+static void             iperf_streams_close(void);
+static void             iperf_interval_poll(bool final);
+static void             iperf_udp_account(iperf_stream_t * p_st, uint8_t const * p_buf, uint32_t size);
+static void             iperf_udp_fin_ack(iperf_stream_t * p_st, iperf_sock_t * p_sock, uint8_t * p_buf, int32_t size);
+
+static int32_t          iperf_send_all(iperf_sock_t * p_sock, void const * p_buf, uint32_t size);
+static int32_t          iperf_recv_exact(iperf_sock_t * p_sock, void * p_buf, uint32_t size, uint32_t timeout_ms);
+static int32_t          iperf3_state_send(iperf_sock_t * p_ctrl, int8_t state);
+static int32_t          iperf3_state_expect(iperf_sock_t * p_ctrl, int8_t state);
+static int32_t          iperf3_json_send(iperf_sock_t * p_ctrl, char const * p_json);
+static int32_t          iperf3_json_recv(iperf_sock_t * p_ctrl);
+static void             iperf3_results_json(void);
+static char const     * iperf_json_find(char const * p_json, char const * p_key);
+static uint64_t         iperf_json_uint(char const * p_json, char const * p_key, uint64_t def);
+static uint64_t         iperf_json_number(char const * p_value, uint64_t def);
+static char const     * iperf_u64_str(uint64_t value, char * p_buf);
+static void             iperf_put_be32(uint8_t * p_buf, uint32_t value);
+static uint32_t         iperf_get_be32(uint8_t const * p_buf);
+
+/*******************************************************************************************************************//**
+ * @brief       Fill in the defaults for a session: iperf2 or iperf3 default port, one stream, 10 s, 1 s reports.
+ * @param[OUT]  p_cfg     configuration to initialize
+ * @param[IN]   mode      server or client
+ * @param[IN]   proto     TCP or UDP
+ * @param[IN]   version   iperf2 or iperf3 wire format
+ * @retval      None
+ **********************************************************************************************************************/
+void iperf_cfg_init(iperf_cfg_t * p_cfg, iperf_mode_t mode, iperf_proto_t proto, iperf_version_t version)
+{
+    memset(p_cfg, 0, sizeof(*p_cfg));
+    p_cfg->mode        = mode;
+    p_cfg->proto       = proto;
+    p_cfg->version     = version;
+    p_cfg->port        = (IPERF_VERSION_3 == version) ? IPERF3_DEFAULT_PORT : IPERF2_DEFAULT_PORT;
+    p_cfg->streams     = 1U;
+    p_cfg->duration_ms = IPERF_DEFAULT_DURATION_MS;
+    p_cfg->interval_ms = IPERF_DEFAULT_INTERVAL_MS;
+    p_cfg->udp_kbps    = IPERF_DEFAULT_UDP_KBPS;
+    p_cfg->len         = (IPERF_PROTO_UDP == proto) ? IPERF_UDP_DEFAULT_LEN : IPERF_BUF_SIZE;
+}
+
+/*******************************************************************************************************************//**
+ * @brief       Run one session. A server returns after serving one test, a client after the configured duration.
+ *              Reports are passed to the callback from the calling thread.
+ * @param[IN]   p_cfg     session parameters
+ * @param[IN]   report    report callback, may be NULL
+ * @retval      IPERF_OK or one of the IPERF_ERR_ codes
+ **********************************************************************************************************************/
+int32_t iperf_run(iperf_cfg_t const * p_cfg, iperf_report_cb_t report)
+{
+    int32_t err = IPERF_ERR_ARG;
+
+    if ((IPERF_VERSION_3 == p_cfg->version) && (IPERF_PROTO_UDP == p_cfg->proto))
+    {
+        return IPERF_ERR_ARG;
+    }
+
+    memset(&g_iperf, 0, sizeof(g_iperf));
+    g_iperf.cfg    = *p_cfg;
+    g_iperf.report = report;
+
+    if ((0U == g_iperf.cfg.streams) || (g_iperf.cfg.streams > IPERF_MAX_STREAMS))
+    {
+        g_iperf.cfg.streams = (0U == g_iperf.cfg.streams) ? 1U : IPERF_MAX_STREAMS;
+    }
+    if (g_iperf.cfg.len > IPERF_BUF_SIZE)
+    {
+        g_iperf.cfg.len = IPERF_BUF_SIZE;
+    }
+    if (g_iperf.cfg.len < IPERF2_CLIENT_HDR_SIZE)
+    {
+        g_iperf.cfg.len = IPERF2_CLIENT_HDR_SIZE;
+    }
+
+    iperf_port_cpu_start();
+
+    if (IPERF_MODE_SERVER == g_iperf.cfg.mode)
+    {
+        if (IPERF_VERSION_3 == g_iperf.cfg.version)
+        {
+            err = iperf3_server();
+        }
+        else
+        {
+            err = (IPERF_PROTO_UDP == g_iperf.cfg.proto) ? iperf2_udp_server() : iperf2_tcp_server();
+        }
+    }
+    else
+    {
+        err = (IPERF_PROTO_UDP == g_iperf.cfg.proto) ? iperf2_udp_client() : iperf_tcp_client();
+    }
+
+    iperf_port_cpu_stop();
+    return err;
+}
+
+/*******************************************************************************************************************//**
+ * @brief       Format a report as one line, iperf style.
+ * @param[IN]   p_report  report to format
+ * @param[OUT]  p_buf     destination
+ * @param[IN]   size      size of the destination
+ * @retval      length of the line
+ **********************************************************************************************************************/
+uint32_t iperf_report_format(iperf_report_t const * p_report, char * p_buf, uint32_t size)
+{
+    char cpu[12] = "  -";
+    int  len     = 0;
+
+    if (IPERF_CPU_UNKNOWN != p_report->cpu_load)
+    {
+        snprintf(cpu, sizeof(cpu), "%3lu%%", (unsigned long) p_report->cpu_load);
+    }
+    len = snprintf(p_buf, size, "[%s] %2lu.%02lu-%2lu.%02lu sec %7lu KBytes %4lu.%02lu Mbits/sec  CPU %s%s",
+                       (p_report->streams > 1U) ? "SUM" : "  1",
+                       (unsigned long) (p_report->start_ms / 1000U), (unsigned long) ((p_report->start_ms % 1000U) / 10U),
+                       (unsigned long) (p_report->end_ms / 1000U), (unsigned long) ((p_report->end_ms % 1000U) / 10U),
+                       (unsigned long) (p_report->bytes / 1024U),
+                       (unsigned long) (p_report->kbps / 1000U), (unsigned long) ((p_report->kbps % 1000U) / 10U),
+                       cpu,
+                       p_report->final ? (p_report->sender ? "  sender" : "  receiver") : "");
+
+    if ((len > 0) && ((uint32_t) len < size) && (0U != p_report->datagrams))
+    {
+        len += snprintf(p_buf + len, size - (uint32_t) len, "  lost %lu/%lu ooo %lu jitter %lu.%03lu ms",
+                        (unsigned long) p_report->lost, (unsigned long) p_report->datagrams,
+                        (unsigned long) p_report->out_of_order,
+                        (unsigned long) (p_report->jitter_us / 1000U), (unsigned long) (p_report->jitter_us % 1000U));
+    }
+
+    return (len < 0) ? 0U : (((uint32_t) len < size) ? (uint32_t) len : size - 1U);
+}
+
+/*******************************************************************************************************************//**
+ * @brief       iperf2 TCP server. Accepts up to IPERF_MAX_STREAMS connections, the session ends when all of them
+ *              are closed by the client. The data is discarded without being copied.
+ * @retval      IPERF_OK or error code
+ **********************************************************************************************************************/
+static int32_t iperf2_tcp_server(void)
+{
+    iperf_sock_t   * p_listener = iperf_port_tcp_listen(g_iperf.cfg.port);
+    iperf_sock_t   * p_sock     = NULL;
+
+    if (NULL == p_listener)
+    {
+        return IPERF_ERR_SOCKET;
+    }
+
+    p_sock = iperf_port_tcp_accept(p_listener, IPERF_WAIT_FOREVER);
+    if (NULL == p_sock)
+    {
+        iperf_port_close(p_listener);
+        return IPERF_ERR_SOCKET;
+    }
+
+    g_iperf.t0     = iperf_port_time_ms();
+    g_iperf.t_last = g_iperf.t0;
+    iperf_stream_add(p_sock, false);
+    iperf_streams_start(iperf_tcp_worker);
+
+    /* Late -P connections join while the first ones are running */
+    while (!iperf_streams_done())
+    {
+        if (g_iperf.count < IPERF_MAX_STREAMS)
+        {
+            p_sock = iperf_port_tcp_accept(p_listener, IPERF_POLL_MS);
+            if (NULL != p_sock)
+            {
+                iperf_stream_add(p_sock, false);
+                iperf_streams_start(iperf_tcp_worker);
+            }
+        }
+        else
+        {
+            iperf_port_sleep_ms(IPERF_POLL_MS);
+        }
+        iperf_interval_poll(false);
+    }
+
+    iperf_port_close(p_listener);
+    iperf_streams_close();
+    iperf_interval_poll(true);
+    return IPERF_OK;
+}
+
+/*******************************************************************************************************************//**
+ * @brief       iperf2 UDP server. Datagrams are told apart by source address, one stream per client socket. Each
+ *              stream counts loss, reordering and jitter and answers the client's FIN with the server report.
+ * @retval      IPERF_OK or error code
+ **********************************************************************************************************************/
+static int32_t iperf2_udp_server(void)
+{
+    iperf_sock_t   * p_sock   = iperf_port_udp_open(g_iperf.cfg.port);
+    uint8_t        * p_buf    = g_iperf_buf[0];
+    iperf_stream_t * p_st     = NULL;
+    bool             started  = false;
+    uint32_t         last_rx  = 0U;
+    uint32_t         linger   = 0U;
+    uint32_t         ip       = 0U;
+    uint16_t         port     = 0U;
+    int32_t          n        = 0;
+
+    if (NULL == p_sock)
+    {
+        return IPERF_ERR_SOCKET;
+    }
+
+    while (true)
+    {
+        n = iperf_port_recvfrom(p_sock, p_buf, IPERF_BUF_SIZE, &ip, &port, IPERF_POLL_MS);
+        if (n < 0)
+        {
+            break;
+        }
+
+        if (n >= (int32_t) IPERF2_UDP_HDR_SIZE)
+        {
+            int32_t id = (int32_t) iperf_get_be32(p_buf);
+
+            p_st = NULL;
+            for (uint32_t i = 0U; i < g_iperf.count; i++)
+            {
+                if ((g_iperf.streams[i].ip == ip) && (g_iperf.streams[i].port == port))
+                {
+                    p_st = &g_iperf.streams[i];
+                }
+            }
+
+            /* A FIN from an unknown source is left over from the previous session */
+            if ((NULL == p_st) && (id >= 0) && (g_iperf.count < IPERF_MAX_STREAMS) && (0U == linger))
+            {
+                if (!started)
+                {
+                    started        = true;
+                    g_iperf.t0     = iperf_port_time_ms();
+                    g_iperf.t_last = g_iperf.t0;
+                }
+                p_st       = iperf_stream_add(NULL, false);
+                p_st->ip   = ip;
+                p_st->port = port;
+                p_st->done = false;
+            }
+
+            if (NULL != p_st)
+            {
+                last_rx = iperf_port_time_ms();
+                if (id >= 0)
+                {
+                    iperf_udp_account(p_st, p_buf, (uint32_t) n);
+                }
+                else
+                {
+                    p_st->fin  = true;
+                    p_st->done = true;
+                    iperf_udp_fin_ack(p_st, p_sock, p_buf, n);
+                }
+            }
+        }
+
+        if (!started)
+        {
+            continue;
+        }
+
+        iperf_interval_poll(false);
+
+        /* The session ends with the last FIN, the totals are reported before lingering */
+        if ((0U == linger) && iperf_streams_done())
+        {
+            iperf_interval_poll(true);
+            linger = iperf_port_time_ms();
+        }
+        if ((0U != linger) && ((iperf_port_time_ms() - linger) >= IPERF_UDP_LINGER_MS))
+        {
+            break;
+        }
+        if ((iperf_port_time_ms() - last_rx) >= IPERF_UDP_IDLE_MS)
+        {
+            break;
+        }
+    }
+
+    iperf_port_close(p_sock);
+    if (started && (0U == linger))
+    {
+        iperf_interval_poll(true);
+    }
+    return (n < 0) ? IPERF_ERR_SOCKET : IPERF_OK;
+}
+
+/*******************************************************************************************************************//**
+ * @brief       iperf2 UDP client. Each stream has its own socket and sends at udp_kbps / streams. At the end every
+ *              stream sends FIN datagrams until the server acknowledges with its report.
+ * @retval      IPERF_OK or error code
+ **********************************************************************************************************************/
+static int32_t iperf2_udp_client(void)
+{
+    iperf_stream_t * p_st  = NULL;
+    iperf_sock_t   * p_sock = NULL;
+    int32_t          n      = 0;
+    uint32_t         ip     = 0U;
+    uint16_t         port   = 0U;
+
+    for (uint32_t i = 0U; i < g_iperf.cfg.streams; i++)
+    {
+        p_sock = iperf_port_udp_open(0U);
+        if (NULL == p_sock)
+        {
+            iperf_streams_close();
+            return IPERF_ERR_SOCKET;
+        }
+        p_st       = iperf_stream_add(p_sock, true);
+        p_st->ip   = g_iperf.cfg.server_ip;
+        p_st->port = g_iperf.cfg.port;
+        p_st->kbps = g_iperf.cfg.udp_kbps / g_iperf.cfg.streams;
+    }
+
+    g_iperf.t0     = iperf_port_time_ms();
+    g_iperf.t_last = g_iperf.t0;
+    if (IPERF_OK != iperf_streams_start(iperf_udp_worker))
+    {
+        g_iperf.stop = true;
+    }
+
+    while (!g_iperf.stop && !iperf_streams_done())
+    {
+        iperf_port_sleep_ms(IPERF_POLL_MS);
+        iperf_interval_poll(false);
+        if ((iperf_port_time_ms() - g_iperf.t0) >= g_iperf.cfg.duration_ms)
+        {
+            g_iperf.stop = true;
+        }
+    }
+    g_iperf.stop = true;
+    for (uint32_t i = 0U; i < g_iperf.count; i++)
+    {
+        if (g_iperf.streams[i].running)
+        {
+            iperf_port_thread_join(g_iperf.streams[i].slot);
+            g_iperf.streams[i].running = false;
+        }
+    }
+    iperf_interval_poll(true);
+
+    /* FIN handshake, the acknowledgement carries the server's view of the stream */
+    for (uint32_t i = 0U; i < g_iperf.count; i++)
+    {
+        uint8_t * p_buf = g_iperf_buf[i];
+
+        p_st = &g_iperf.streams[i];
+        for (uint32_t retry = 0U; (retry < IPERF2_FIN_RETRIES) && !p_st->acked; retry++)
+        {
+            uint32_t now = iperf_port_time_ms();
+
+            iperf_put_be32(p_buf, (uint32_t) -p_st->next_id);
+            iperf_put_be32(p_buf + 4, now / 1000U);
+            iperf_put_be32(p_buf + 8, (now % 1000U) * 1000U);
+            iperf_port_sendto(p_st->p_sock, p_st->ip, p_st->port, p_buf, g_iperf.cfg.len);
+
+            n = iperf_port_recvfrom(p_st->p_sock, p_buf, IPERF_BUF_SIZE, &ip, &port, IPERF2_FIN_WAIT_MS);
+            if ((n >= (int32_t) (IPERF2_UDP_HDR_SIZE + IPERF2_SERVER_HDR_SIZE)) &&
+                ((int32_t) iperf_get_be32(p_buf) < 0) &&
+                (0U != (iperf_get_be32(p_buf + IPERF2_UDP_HDR_SIZE) & IPERF2_HEADER_VERSION1)))
+            {
+                uint8_t const * p_hdr = p_buf + IPERF2_UDP_HDR_SIZE;
+
+                p_st->acked        = true;
+                p_st->total        = ((uint64_t) iperf_get_be32(p_hdr + 4) << 32) | iperf_get_be32(p_hdr + 8);
+                p_st->lost         = iperf_get_be32(p_hdr + 20);
+                p_st->out_of_order = iperf_get_be32(p_hdr + 24);
+                p_st->next_id      = (int32_t) iperf_get_be32(p_hdr + 28);
+                p_st->jitter_us    = (iperf_get_be32(p_hdr + 32) * 1000000U) + iperf_get_be32(p_hdr + 36);
+            }
+        }
+    }
+
+    /* Server side report, when every stream was acknowledged */
+    if ((NULL != g_iperf.report) && (g_iperf.count > 0U))
+    {
+        iperf_report_t rep = {0};
+        bool           all = true;
+
+        rep.end_ms   = g_iperf.t_last - g_iperf.t0;
+        rep.streams  = g_iperf.count;
+        rep.cpu_load = IPERF_CPU_UNKNOWN;
+        rep.final    = true;
+        for (uint32_t i = 0U; i < g_iperf.count; i++)
+        {
+            p_st           = &g_iperf.streams[i];
+            all            = all && p_st->acked;
+            rep.bytes     += p_st->total;
+            rep.datagrams += (uint32_t) p_st->next_id;
+            rep.lost      += p_st->lost;
+            rep.out_of_order += p_st->out_of_order;
+            rep.jitter_us  = (p_st->jitter_us > rep.jitter_us) ? p_st->jitter_us : rep.jitter_us;
+        }
+        rep.kbps = (rep.end_ms > 0U) ? (uint32_t) ((rep.bytes * 8U) / rep.end_ms) : 0U;
+        if (all)
+        {
+            g_iperf.report(&rep);
+        }
+    }
+
+    iperf_streams_close();
+    return IPERF_OK;
+}
+
+/*******************************************************************************************************************//**
+ * @brief       iperf3 server, TCP. Runs the control connection state machine: parameter exchange, stream creation,
+ *              test, result exchange. Supports -P and -R (the board sends).
+ * @retval      IPERF_OK or error code
+ **********************************************************************************************************************/
+static int32_t iperf3_server(void)
+{
+    iperf_sock_t * p_listener = iperf_port_tcp_listen(g_iperf.cfg.port);
+    iperf_sock_t * p_ctrl     = NULL;
+    iperf_sock_t * p_sock     = NULL;
+    uint8_t        cookie[IPERF3_COOKIE_SIZE];
+    uint32_t       streams    = 0U;
+    bool           reverse    = false;
+    int8_t         state      = 0;
+    int32_t        err        = IPERF_ERR_PROTOCOL;
+    int32_t        n          = 0;
+
+    if (NULL == p_listener)
+    {
+        return IPERF_ERR_SOCKET;
+    }
+
+    p_ctrl = iperf_port_tcp_accept(p_listener, IPERF_WAIT_FOREVER);
+    if (NULL == p_ctrl)
+    {
+        iperf_port_close(p_listener);
+        return IPERF_ERR_SOCKET;
+    }
+
+    if ((IPERF_OK != iperf_recv_exact(p_ctrl, cookie, IPERF3_COOKIE_SIZE, IPERF_CTRL_TIMEOUT_MS)) ||
+        (IPERF_OK != iperf3_state_send(p_ctrl, IPERF3_PARAM_EXCHANGE)) ||
+        (IPERF_OK != iperf3_json_recv(p_ctrl)))
+    {
+        goto exit;
+    }
+
+    streams = (uint32_t) iperf_json_uint(g_iperf_json, "parallel", 1U);
+    reverse = (NULL != strstr(g_iperf_json, "\"reverse\":true"));
+    if (NULL != strstr(g_iperf_json, "\"len\""))
+    {
+        g_iperf.cfg.len = (uint32_t) iperf_json_uint(g_iperf_json, "len", IPERF_BUF_SIZE);
+        g_iperf.cfg.len = (g_iperf.cfg.len > IPERF_BUF_SIZE) ? IPERF_BUF_SIZE : g_iperf.cfg.len;
+    }
+
+    /* UDP and more streams than we have workers for are refused, the client reports the server as busy */
+    if ((NULL != strstr(g_iperf_json, "\"udp\":true")) || (0U == streams) || (streams > IPERF_MAX_STREAMS))
+    {
+        iperf3_state_send(p_ctrl, IPERF3_ACCESS_DENIED);
+        goto exit;
+    }
+
+    if (IPERF_OK != iperf3_state_send(p_ctrl, IPERF3_CREATE_STREAMS))
+    {
+        goto exit;
+    }
+    for (uint32_t i = 0U; i < streams; i++)
+    {
+        p_sock = iperf_port_tcp_accept(p_listener, IPERF_CTRL_TIMEOUT_MS);
+        if (NULL == p_sock)
+        {
+            goto exit;
+        }
+        iperf_stream_add(p_sock, reverse);
+        if (IPERF_OK != iperf_recv_exact(p_sock, cookie, IPERF3_COOKIE_SIZE, IPERF_CTRL_TIMEOUT_MS))
+        {
+            goto exit;
+        }
+    }
+
+    if ((IPERF_OK != iperf3_state_send(p_ctrl, IPERF3_TEST_START)) ||
+        (IPERF_OK != iperf3_state_send(p_ctrl, IPERF3_TEST_RUNNING)))
+    {
+        goto exit;
+    }
+
+    g_iperf.t0     = iperf_port_time_ms();
+    g_iperf.t_last = g_iperf.t0;
+    if (IPERF_OK != iperf_streams_start(iperf_tcp_worker))
+    {
+        err = IPERF_ERR_THREAD;
+        goto exit;
+    }
+
+    /* The client decides when the test ends */
+    while (true)
+    {
+        n = iperf_port_recv(p_ctrl, &state, 1U, IPERF_POLL_MS);
+        if ((n < 0) || ((1 == n) && (IPERF3_TEST_END == state)))
+        {
+            break;
+        }
+        iperf_interval_poll(false);
+    }
+    g_iperf.stop = true;
+    iperf_streams_close();
+    iperf_interval_poll(true);
+
+    if ((n < 0) ||
+        (IPERF_OK != iperf3_state_send(p_ctrl, IPERF3_EXCHANGE_RESULTS)) ||
+        (IPERF_OK != iperf3_json_recv(p_ctrl)))
+    {
+        goto exit;
+    }
+    iperf3_results_json();
+    if ((IPERF_OK != iperf3_json_send(p_ctrl, g_iperf_json)) ||
+        (IPERF_OK != iperf3_state_send(p_ctrl, IPERF3_DISPLAY_RESULTS)))
+    {
+        goto exit;
+    }
+    iperf3_state_expect(p_ctrl, IPERF3_IPERF_DONE);
+    err = IPERF_OK;
+
+exit:
+    g_iperf.stop = true;
+    iperf_streams_close();
+    iperf_port_close(p_ctrl);
+    iperf_port_close(p_listener);
+    return err;
+}
+
+/*******************************************************************************************************************//**
+ * @brief       TCP client for both versions. For iperf3 the data streams are set up and torn down through the
+ *              control connection and the server's byte count is reported as the receiver side.
+ * @retval      IPERF_OK or error code
+ **********************************************************************************************************************/
+static int32_t iperf_tcp_client(void)
+{
+    bool           v3     = (IPERF_VERSION_3 == g_iperf.cfg.version);
+    iperf_sock_t * p_ctrl = NULL;
+    iperf_sock_t * p_sock = NULL;
+    uint8_t        cookie[IPERF3_COOKIE_SIZE];
+    uint32_t       seed   = iperf_port_time_ms();
+    int32_t        err    = IPERF_ERR_PROTOCOL;
+
+    if (v3)
+    {
+        for (uint32_t i = 0U; i < (IPERF3_COOKIE_SIZE - 1U); i++)
+        {
+            seed      = (seed * 1103515245U) + 12345U;
+            cookie[i] = (uint8_t) "abcdefghijklmnopqrstuvwxyz234567"[(seed >> 16) & 31U];
+        }
+        cookie[IPERF3_COOKIE_SIZE - 1U] = 0U;
+
+        p_ctrl = iperf_port_tcp_connect(g_iperf.cfg.server_ip, g_iperf.cfg.port, IPERF_CTRL_TIMEOUT_MS);
+        if (NULL == p_ctrl)
+        {
+            return IPERF_ERR_CONNECT;
+        }
+
+        snprintf(g_iperf_json, sizeof(g_iperf_json),
+                 "{\"tcp\":true,\"omit\":0,\"time\":%lu,\"parallel\":%lu,\"len\":%lu,\"client_version\":\"3.1.3\"}",
+                 (unsigned long) ((g_iperf.cfg.duration_ms + 999U) / 1000U), (unsigned long) g_iperf.cfg.streams,
+                 (unsigned long) g_iperf.cfg.len);
+        if ((IPERF_OK != iperf_send_all(p_ctrl, cookie, IPERF3_COOKIE_SIZE)) ||
+            (IPERF_OK != iperf3_state_expect(p_ctrl, IPERF3_PARAM_EXCHANGE)) ||
+            (IPERF_OK != iperf3_json_send(p_ctrl, g_iperf_json)) ||
+            (IPERF_OK != iperf3_state_expect(p_ctrl, IPERF3_CREATE_STREAMS)))
+        {
+            goto exit;
+        }
+    }
+
+    for (uint32_t i = 0U; i < g_iperf.cfg.streams; i++)
+    {
+        p_sock = iperf_port_tcp_connect(g_iperf.cfg.server_ip, g_iperf.cfg.port, IPERF_CTRL_TIMEOUT_MS);
+        if (NULL == p_sock)
+        {
+            err = IPERF_ERR_CONNECT;
+            goto exit;
+        }
+        iperf_stream_add(p_sock, true);
+        if (v3 && (IPERF_OK != iperf_send_all(p_sock, cookie, IPERF3_COOKIE_SIZE)))
+        {
+            goto exit;
+        }
+    }
+
+    if (v3 &&
+        ((IPERF_OK != iperf3_state_expect(p_ctrl, IPERF3_TEST_START)) ||
+         (IPERF_OK != iperf3_state_expect(p_ctrl, IPERF3_TEST_RUNNING))))
+    {
+        goto exit;
+    }
+
+    g_iperf.t0     = iperf_port_time_ms();
+    g_iperf.t_last = g_iperf.t0;
+    if (IPERF_OK != iperf_streams_start(iperf_tcp_worker))
+    {
+        err = IPERF_ERR_THREAD;
+        goto exit;
+    }
+
+    while (!iperf_streams_done() && ((iperf_port_time_ms() - g_iperf.t0) < g_iperf.cfg.duration_ms))
+    {
+        iperf_port_sleep_ms(IPERF_POLL_MS);
+        iperf_interval_poll(false);
+    }
+    g_iperf.stop = true;
+    for (uint32_t i = 0U; i < g_iperf.count; i++)
+    {
+        if (g_iperf.streams[i].running)
+        {
+            iperf_port_thread_join(g_iperf.streams[i].slot);
+            g_iperf.streams[i].running = false;
+        }
+    }
+    iperf_interval_poll(true);
+    err = IPERF_OK;
+
+    if (v3)
+    {
+        err = IPERF_ERR_PROTOCOL;
+        iperf3_results_json();
+        if ((IPERF_OK != iperf3_state_send(p_ctrl, IPERF3_TEST_END)) ||
+            (IPERF_OK != iperf3_state_expect(p_ctrl, IPERF3_EXCHANGE_RESULTS)) ||
+            (IPERF_OK != iperf3_json_send(p_ctrl, g_iperf_json)) ||
+            (IPERF_OK != iperf3_json_recv(p_ctrl)))
+        {
+            goto exit;
+        }
+
+        /* Receiver side: sum of the byte counts of the server's streams */
+        if (NULL != g_iperf.report)
+        {
+            iperf_report_t rep = {0};
+
+            for (char const * p = iperf_json_find(g_iperf_json, "bytes"); NULL != p; p = iperf_json_find(p, "bytes"))
+            {
+                rep.bytes += iperf_json_number(p, 0U);
+            }
+            rep.end_ms  = g_iperf.t_last - g_iperf.t0;
+            rep.kbps    = (rep.end_ms > 0U) ? (uint32_t) ((rep.bytes * 8U) / rep.end_ms) : 0U;
+            rep.streams = g_iperf.count;
+            rep.cpu_load = (uint32_t) iperf_json_uint(g_iperf_json, "cpu_util_total", 0U);
+            rep.final   = true;
+            g_iperf.report(&rep);
+        }
+
+        if (IPERF_OK == iperf3_state_expect(p_ctrl, IPERF3_DISPLAY_RESULTS))
+        {
+            iperf3_state_send(p_ctrl, IPERF3_IPERF_DONE);
+            err = IPERF_OK;
+        }
+    }
+
+exit:
+    g_iperf.stop = true;
+    iperf_streams_close();
+    if (NULL != p_ctrl)
+    {
+        iperf_port_close(p_ctrl);
+    }
+    return err;
+}
+
+/*******************************************************************************************************************//**
+ * @brief       TCP stream worker. Sends the stream buffer or discards received data until stopped or closed.
+ * @param[IN]   p_arg     iperf_stream_t
+ * @retval      None
+ **********************************************************************************************************************/
+static void iperf_tcp_worker(void * p_arg)
+{
+    iperf_stream_t * p_st  = (iperf_stream_t *) p_arg;
+    uint8_t        * p_buf = g_iperf_buf[p_st->slot];
+    int32_t          n     = 0;
+
+    while (!g_iperf.stop)
+    {
+        if (p_st->sender)
+        {
+            n = iperf_port_send(p_st->p_sock, p_buf, g_iperf.cfg.len);
+        }
+        else
+        {
+            n = iperf_port_recv(p_st->p_sock, NULL, IPERF_BUF_SIZE, IPERF_POLL_MS);
+        }
+        if (n < 0)
+        {
+            break;
+        }
+        p_st->bytes += (uint32_t) n;
+    }
+
+    p_st->done = true;
+}
+
+/*******************************************************************************************************************//**
+ * @brief       UDP stream worker. Paces datagrams against the stream's share of the target rate.
+ * @param[IN]   p_arg     iperf_stream_t
+ * @retval      None
+ **********************************************************************************************************************/
+static void iperf_udp_worker(void * p_arg)
+{
+    iperf_stream_t * p_st  = (iperf_stream_t *) p_arg;
+    uint8_t        * p_buf = g_iperf_buf[p_st->slot];
+    uint32_t         start = iperf_port_time_ms();
+    uint64_t         sent  = 0U;
+    uint32_t         now   = 0U;
+    int32_t          n     = 0;
+
+    while (!g_iperf.stop)
+    {
+        now = iperf_port_time_ms();
+
+        /* kbit/s times ms is bits */
+        if ((sent * 8U) > ((uint64_t) p_st->kbps * (now - start)))
+        {
+            iperf_port_sleep_ms(1U);
+            continue;
+        }
+
+        iperf_put_be32(p_buf, (uint32_t) p_st->next_id);
+        iperf_put_be32(p_buf + 4, now / 1000U);
+        iperf_put_be32(p_buf + 8, (now % 1000U) * 1000U);
+        n = iperf_port_sendto(p_st->p_sock, p_st->ip, p_st->port, p_buf, g_iperf.cfg.len);
+        if (n < 0)
+        {
+            break;
+        }
+        if (n > 0)
+        {
+            p_st->next_id++;
+            sent        += (uint32_t) n;
+            p_st->bytes += (uint32_t) n;
+        }
+    }
+
+    p_st->done = true;
+}
+
+/*******************************************************************************************************************//**
+ * @brief       Add a stream to the session. iperf3 numbers streams 1, 3, 4, ... and the client checks the ids.
+ * @param[IN]   p_sock    data socket, NULL for UDP server streams
+ * @param[IN]   sender    true if this side sends
+ * @retval      the stream
+ **********************************************************************************************************************/
+static iperf_stream_t * iperf_stream_add(iperf_sock_t * p_sock, bool sender)
+{
+    iperf_stream_t * p_st  = &g_iperf.streams[g_iperf.count];
+    uint8_t        * p_buf = g_iperf_buf[g_iperf.count];
+
+    memset(p_st, 0, sizeof(*p_st));
+    p_st->p_sock = p_sock;
+    p_st->slot   = g_iperf.count;
+    p_st->id     = (0U == g_iperf.count) ? 1U : g_iperf.count + 2U;
+    p_st->sender = sender;
+    p_st->done   = (NULL == p_sock);
+    g_iperf.count++;
+
+    if (sender)
+    {
+        for (uint32_t i = 0U; i < IPERF_BUF_SIZE; i++)
+        {
+            p_buf[i] = (uint8_t) ('0' + (i % 10U));
+        }
+
+        /* An all zero iperf2 client header means no options (no -d / -r) */
+        if ((IPERF_VERSION_2 == g_iperf.cfg.version) && (IPERF_PROTO_TCP == g_iperf.cfg.proto))
+        {
+            memset(p_buf, 0, IPERF2_CLIENT_HDR_SIZE);
+        }
+    }
+
+    return p_st;
+}
+
+/*******************************************************************************************************************//**
+ * @brief       Start a worker for each stream that has none yet.
+ * @param[IN]   p_entry   worker function
+ * @retval      IPERF_OK or IPERF_ERR_THREAD
+ **********************************************************************************************************************/
+static int32_t iperf_streams_start(void (* p_entry)(void * p_arg))
+{
+    for (uint32_t i = 0U; i < g_iperf.count; i++)
+    {
+        iperf_stream_t * p_st = &g_iperf.streams[i];
+
+        if (!p_st->running && (NULL != p_st->p_sock))
+        {
+            p_st->done = false;
+            if (0 != iperf_port_thread_start(p_st->slot, p_entry, p_st))
+            {
+                p_st->done = true;
+                return IPERF_ERR_THREAD;
+            }
+            p_st->running = true;
+        }
+    }
+
+    return IPERF_OK;
+}
+
+/*******************************************************************************************************************//**
+ * @brief       Check whether every stream has ended.
+ * @retval      true if no stream is active
+ **********************************************************************************************************************/
+static bool iperf_streams_done(void)
+{
+    for (uint32_t i = 0U; i < g_iperf.count; i++)
+    {
+        if (!g_iperf.streams[i].done)
+        {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+/*******************************************************************************************************************//**
+ * @brief       Stop and join the workers, then close the data sockets.
+ * @retval      None
+ **********************************************************************************************************************/
+static void iperf_streams_close(void)
+{
+    g_iperf.stop = true;
+    for (uint32_t i = 0U; i < g_iperf.count; i++)
+    {
+        iperf_stream_t * p_st = &g_iperf.streams[i];
+
+        if (p_st->running)
+        {
+            iperf_port_thread_join(p_st->slot);
+            p_st->running = false;
+        }
+        if (NULL != p_st->p_sock)
+        {
+            iperf_port_close(p_st->p_sock);
+            p_st->p_sock = NULL;
+        }
+    }
+}
+
+/*******************************************************************************************************************//**
+ * @brief       Collect the byte counters of all streams and report once per interval. The final call reports the
+ *              last partial interval and the session totals.
+ * @param[IN]   final     true at the end of the session
+ * @retval      None
+ **********************************************************************************************************************/
+static void iperf_interval_poll(bool final)
+{
+    uint32_t       now    = iperf_port_time_ms();
+    uint32_t       dt     = now - g_iperf.t_last;
+    uint32_t       period = (0U != g_iperf.cfg.interval_ms) ? g_iperf.cfg.interval_ms : IPERF_DEFAULT_INTERVAL_MS;
+    iperf_report_t rep    = {0};
+
+    /* Sampled at least every default interval even when reports are off, to keep the CPU meter in range */
+    if (!final && (dt < period))
+    {
+        return;
+    }
+
+    rep.start_ms = g_iperf.t_last - g_iperf.t0;
+    rep.end_ms   = now - g_iperf.t0;
+    rep.streams  = g_iperf.count;
+    rep.sender   = (g_iperf.count > 0U) && g_iperf.streams[0].sender;
+    for (uint32_t i = 0U; i < g_iperf.count; i++)
+    {
+        iperf_stream_t * p_st  = &g_iperf.streams[i];
+        uint32_t         delta = p_st->bytes - p_st->bytes_seen;
+
+        p_st->bytes_seen += delta;
+        p_st->total      += delta;
+        rep.bytes        += delta;
+    }
+    rep.kbps              = (dt > 0U) ? (uint32_t) ((rep.bytes * 8U) / dt) : 0U;
+    rep.cpu_load          = iperf_port_cpu_load();
+    g_iperf.cpu_weighted += (uint64_t) rep.cpu_load * dt;
+    g_iperf.cpu_ms       += dt;
+    g_iperf.t_last        = now;
+
+    /* A sliver of an interval left at the end is only part of the totals */
+    if ((NULL != g_iperf.report) && (0U != g_iperf.cfg.interval_ms) && (dt > (period / 10U)))
+    {
+        g_iperf.report(&rep);
+    }
+
+    if (final)
+    {
+        rep.start_ms = 0U;
+        rep.bytes    = 0U;
+        for (uint32_t i = 0U; i < g_iperf.count; i++)
+        {
+            iperf_stream_t * p_st = &g_iperf.streams[i];
+
+            rep.bytes        += p_st->total;
+            rep.datagrams    += p_st->sender ? 0U : (uint32_t) p_st->next_id;
+            rep.lost         += p_st->lost;
+            rep.out_of_order += p_st->out_of_order;
+            rep.jitter_us     = (p_st->jitter_us > rep.jitter_us) ? p_st->jitter_us : rep.jitter_us;
+        }
+        rep.kbps     = (rep.end_ms > 0U) ? (uint32_t) ((rep.bytes * 8U) / rep.end_ms) : 0U;
+        rep.cpu_load = (g_iperf.cpu_ms > 0U) ? (uint32_t) (g_iperf.cpu_weighted / g_iperf.cpu_ms) : 0U;
+        rep.final    = true;
+        if (NULL != g_iperf.report)
+        {
+            g_iperf.report(&rep);
+        }
+    }
+}
+
+/*******************************************************************************************************************//**
+ * @brief       Account one received datagram: sequence gaps, reordering and the RFC 1889 jitter estimate.
+ * @param[IN]   p_st      stream of the sender
+ * @param[IN]   p_buf     datagram
+ * @param[IN]   size      datagram size
+ * @retval      None
+ **********************************************************************************************************************/
+static void iperf_udp_account(iperf_stream_t * p_st, uint8_t const * p_buf, uint32_t size)
+{
+    int32_t  id      = (int32_t) iperf_get_be32(p_buf);
+    uint32_t sent_ms = (iperf_get_be32(p_buf + 4) * 1000U) + (iperf_get_be32(p_buf + 8) / 1000U);
+    int32_t  transit = (int32_t) (iperf_port_time_ms() - sent_ms);
+    int32_t  d       = 0;
+
+    if (id >= p_st->next_id)
+    {
+        p_st->lost   += (uint32_t) (id - p_st->next_id);
+        p_st->next_id = id + 1;
+    }
+    else
+    {
+        p_st->out_of_order++;
+        p_st->lost -= (p_st->lost > 0U) ? 1U : 0U;
+    }
+
+    if (p_st->bytes > 0U)
+    {
+        d                = (transit > p_st->last_transit) ? (transit - p_st->last_transit) : (p_st->last_transit - transit);
+        p_st->jitter_us  = (uint32_t) ((int32_t) p_st->jitter_us + ((d * 1000) - (int32_t) p_st->jitter_us) / 16);
+    }
+    p_st->last_transit = transit;
+    p_st->bytes       += size;
+}
+
+/*******************************************************************************************************************//**
+ * @brief       Answer a FIN datagram with the iperf2 server report placed behind the UDP header.
+ * @param[IN]   p_st      stream of the sender
+ * @param[IN]   p_sock    server socket
+ * @param[IN]   p_buf     received FIN, reused for the answer
+ * @param[IN]   size      size of the FIN
+ * @retval      None
+ **********************************************************************************************************************/
+static void iperf_udp_fin_ack(iperf_stream_t * p_st, iperf_sock_t * p_sock, uint8_t * p_buf, int32_t size)
+{
+    uint8_t * p_hdr   = p_buf + IPERF2_UDP_HDR_SIZE;
+    uint64_t  total   = p_st->total + (uint32_t) (p_st->bytes - p_st->bytes_seen);
+    uint32_t  elapsed = iperf_port_time_ms() - g_iperf.t0;
+
+    iperf_put_be32(p_hdr, IPERF2_HEADER_VERSION1);
+    iperf_put_be32(p_hdr + 4, (uint32_t) (total >> 32));
+    iperf_put_be32(p_hdr + 8, (uint32_t) total);
+    iperf_put_be32(p_hdr + 12, elapsed / 1000U);
+    iperf_put_be32(p_hdr + 16, (elapsed % 1000U) * 1000U);
+    iperf_put_be32(p_hdr + 20, p_st->lost);
+    iperf_put_be32(p_hdr + 24, p_st->out_of_order);
+    iperf_put_be32(p_hdr + 28, (uint32_t) p_st->next_id);
+    iperf_put_be32(p_hdr + 32, p_st->jitter_us / 1000000U);
+    iperf_put_be32(p_hdr + 36, p_st->jitter_us % 1000000U);
+
+    if (size < (int32_t) (IPERF2_UDP_HDR_SIZE + IPERF2_SERVER_HDR_SIZE))
+    {
+        size = (int32_t) (IPERF2_UDP_HDR_SIZE + IPERF2_SERVER_HDR_SIZE);
+    }
+    iperf_port_sendto(p_sock, p_st->ip, p_st->port, p_buf, (uint32_t) size);
+}
+
+/*******************************************************************************************************************//**
+ * @brief       Send a whole buffer, retrying short writes until the control timeout.
+ * @retval      IPERF_OK or IPERF_ERR_SOCKET
+ **********************************************************************************************************************/
+static int32_t iperf_send_all(iperf_sock_t * p_sock, void const * p_buf, uint32_t size)
+{
+    uint8_t const * p_src = (uint8_t const *) p_buf;
+    uint32_t        start = iperf_port_time_ms();
+    int32_t         n     = 0;
+
+    while (size > 0U)
+    {
+        n = iperf_port_send(p_sock, p_src, size);
+        if ((n < 0) || ((iperf_port_time_ms() - start) >= IPERF_CTRL_TIMEOUT_MS))
+        {
+            return IPERF_ERR_SOCKET;
+        }
+        p_src += n;
+        size  -= (uint32_t) n;
+    }
+
+    return IPERF_OK;
+}
+
+/*******************************************************************************************************************//**
+ * @brief       Receive exactly size bytes within timeout_ms.
+ * @retval      IPERF_OK or IPERF_ERR_SOCKET
+ **********************************************************************************************************************/
+static int32_t iperf_recv_exact(iperf_sock_t * p_sock, void * p_buf, uint32_t size, uint32_t timeout_ms)
+{
+    uint8_t * p_dest = (uint8_t *) p_buf;
+    uint32_t  start  = iperf_port_time_ms();
+    int32_t   n      = 0;
+
+    while (size > 0U)
+    {
+        n = iperf_port_recv(p_sock, p_dest, size, IPERF_POLL_MS);
+        if ((n < 0) || ((iperf_port_time_ms() - start) >= timeout_ms))
+        {
+            return IPERF_ERR_SOCKET;
+        }
+        p_dest += n;
+        size   -= (uint32_t) n;
+    }
+
+    return IPERF_OK;
+}
+
+/*******************************************************************************************************************//**
+ * @brief       Send an iperf3 state byte on the control connection.
+ * @retval      IPERF_OK or IPERF_ERR_SOCKET
+ **********************************************************************************************************************/
+static int32_t iperf3_state_send(iperf_sock_t * p_ctrl, int8_t state)
+{
+    return iperf_send_all(p_ctrl, &state, 1U);
+}
+
+/*******************************************************************************************************************//**
+ * @brief       Wait for a given iperf3 state byte on the control connection.
+ * @retval      IPERF_OK, IPERF_ERR_PROTOCOL on another state
+ **********************************************************************************************************************/
+static int32_t iperf3_state_expect(iperf_sock_t * p_ctrl, int8_t state)
+{
+    int8_t got = 0;
+
+    if (IPERF_OK != iperf_recv_exact(p_ctrl, &got, 1U, IPERF_CTRL_TIMEOUT_MS))
+    {
+        return IPERF_ERR_SOCKET;
+    }
+
+    return (got == state) ? IPERF_OK : IPERF_ERR_PROTOCOL;
+}
+
+/*******************************************************************************************************************//**
+ * @brief       Send a JSON object with its 32-bit big endian length prefix.
+ * @retval      IPERF_OK or IPERF_ERR_SOCKET
+ **********************************************************************************************************************/
+static int32_t iperf3_json_send(iperf_sock_t * p_ctrl, char const * p_json)
+{
+    uint8_t  len[4];
+    uint32_t size = (uint32_t) strlen(p_json);
+
+    iperf_put_be32(len, size);
+    if (IPERF_OK != iperf_send_all(p_ctrl, len, sizeof(len)))
+    {
+        return IPERF_ERR_SOCKET;
+    }
+
+    return iperf_send_all(p_ctrl, p_json, size);
+}
+
+/*******************************************************************************************************************//**
+ * @brief       Receive a length prefixed JSON object into g_iperf_json.
+ * @retval      IPERF_OK, IPERF_ERR_PROTOCOL if it does not fit
+ **********************************************************************************************************************/
+static int32_t iperf3_json_recv(iperf_sock_t * p_ctrl)
+{
+    uint8_t  len[4];
+    uint32_t size = 0U;
+
+    if (IPERF_OK != iperf_recv_exact(p_ctrl, len, sizeof(len), IPERF_CTRL_TIMEOUT_MS))
+    {
+        return IPERF_ERR_SOCKET;
+    }
+    size = iperf_get_be32(len);
+    if (size >= sizeof(g_iperf_json))
+    {
+        return IPERF_ERR_PROTOCOL;
+    }
+    if (IPERF_OK != iperf_recv_exact(p_ctrl, g_iperf_json, size, IPERF_CTRL_TIMEOUT_MS))
+    {
+        return IPERF_ERR_SOCKET;
+    }
+    g_iperf_json[size] = '\0';
+
+    return IPERF_OK;
+}
+
+/*******************************************************************************************************************//**
+ * @brief       Build this side's iperf3 results object in g_iperf_json. Retransmits are not known to the stack port.
+ * @retval      None
+ **********************************************************************************************************************/
+static void iperf3_results_json(void)
+{
+    uint32_t elapsed = g_iperf.t_last - g_iperf.t0;
+    uint32_t cpu     = (g_iperf.cpu_ms > 0U) ? (uint32_t) (g_iperf.cpu_weighted / g_iperf.cpu_ms) : 0U;
+    char     num[21];
+    int      len     = 0;
+
+    len = snprintf(g_iperf_json, sizeof(g_iperf_json),
+                   "{\"cpu_util_total\":%lu,\"cpu_util_user\":%lu,\"cpu_util_system\":0,"
+                   "\"sender_has_retransmits\":-1,\"streams\":[",
+                   (unsigned long) cpu, (unsigned long) cpu);
+    for (uint32_t i = 0U; (i < g_iperf.count) && (len > 0) && ((uint32_t) len < sizeof(g_iperf_json)); i++)
+    {
+        len += snprintf(g_iperf_json + len, sizeof(g_iperf_json) - (uint32_t) len,
+                        "%s{\"id\":%lu,\"bytes\":%s,\"retransmits\":-1,\"jitter\":0,\"errors\":0,\"packets\":0,"
+                        "\"start_time\":0,\"end_time\":%lu.%03lu}",
+                        (0U == i) ? "" : ",", (unsigned long) g_iperf.streams[i].id,
+                        iperf_u64_str(g_iperf.streams[i].total, num),
+                        (unsigned long) (elapsed / 1000U), (unsigned long) (elapsed % 1000U));
+    }
+    if ((len > 0) && ((uint32_t) len < sizeof(g_iperf_json)))
+    {
+        snprintf(g_iperf_json + len, sizeof(g_iperf_json) - (uint32_t) len, "]}");
+    }
+}
+
+/*******************************************************************************************************************//**
+ * @brief       Find the value of "key" in a flat JSON text.
+ * @retval      pointer to the value or NULL
+ **********************************************************************************************************************/
+static char const * iperf_json_find(char const * p_json, char const * p_key)
+{
+    size_t key_len = strlen(p_key);
+
+    for (char const * p = strchr(p_json, '"'); NULL != p; p = strchr(p + 1, '"'))
+    {
+        if ((0 == strncmp(p + 1, p_key, key_len)) && ('"' == p[key_len + 1U]))
+        {
+            p += key_len + 2U;
+            while ((' ' == *p) || (':' == *p))
+            {
+                p++;
+            }
+
+            return p;
+        }
+    }
+
+    return NULL;
+}
+
+/*******************************************************************************************************************//**
+ * @brief       Read an unsigned integer value from a flat JSON text.
+ * @retval      value, def if the key is missing
+ **********************************************************************************************************************/
+static uint64_t iperf_json_uint(char const * p_json, char const * p_key, uint64_t def)
+{
+    return iperf_json_number(iperf_json_find(p_json, p_key), def);
+}
+
+/*******************************************************************************************************************//**
+ * @brief       Parse an unsigned JSON number, fractions are dropped.
+ * @retval      value, def if p_value is NULL or not a number
+ **********************************************************************************************************************/
+static uint64_t iperf_json_number(char const * p_value, uint64_t def)
+{
+    char const * p     = p_value;
+    uint64_t     value = 0U;
+
+    if ((NULL == p) || (*p < '0') || (*p > '9'))
+    {
+        return def;
+    }
+    while ((*p >= '0') && (*p <= '9'))
+    {
+        value = (value * 10U) + (uint64_t) (*p - '0');
+        p++;
+    }
+
+    return value;
+}
+
+/*******************************************************************************************************************//**
+ * @brief       Decimal string of a 64-bit value, the C library printf may lack %llu.
+ * @param[OUT]  p_buf     at least 21 bytes
+ * @retval      p_buf
+ **********************************************************************************************************************/
+static char const * iperf_u64_str(uint64_t value, char * p_buf)
+{
+    char     tmp[20];
+    uint32_t n = 0U;
+
+    do
+    {
+        tmp[n++] = (char) ('0' + (value % 10U));
+        value   /= 10U;
+    } while (0U != value);
+
+    for (uint32_t i = 0U; i < n; i++)
+    {
+        p_buf[i] = tmp[n - 1U - i];
+    }
+    p_buf[n] = '\0';
+
+    return p_buf;
+}
+
+static void iperf_put_be32(uint8_t * p_buf, uint32_t value)
+{
+    p_buf[0] = (uint8_t) (value >> 24);
+    p_buf[1] = (uint8_t) (value >> 16);
+    p_buf[2] = (uint8_t) (value >> 8);
+    p_buf[3] = (uint8_t) value;
+}
+
+static uint32_t iperf_get_be32(uint8_t const * p_buf)
+{
+    return ((uint32_t) p_buf[0] << 24) | ((uint32_t) p_buf[1] << 16) | ((uint32_t) p_buf[2] << 8) | p_buf[3];
+}
+
+/*******************************************************************************************************************//**
+ * @} (end addtogroup iperf)
+ **********************************************************************************************************************/
@@ -0,0 +1,426 @@
+/***********************************************************************************************************************
+ * File Name    : iperf_port_freertos.c
+ * Description  : iperf port on FreeRTOS+TCP and FreeRTOS
+ **********************************************************************************************************************/
+
+/*
+* Copyright (c) 2024 Renesas Electronics Corporation and/or its affiliates
+*
+* SPDX-License-Identifier: BSD-3-Clause
+*/
+
+#include <string.h>
+#include "net_thread.h"
+#include "FreeRTOS_IP.h"
+#include "FreeRTOS_Sockets.h"
+#include "semphr.h"
+#include "iperf.h"
+#include "iperf_port.h"
+
+/*******************************************************************************************************************//**
+ * @addtogroup iperf
+ * @{
+ **********************************************************************************************************************/
+
+/******************************************************************************
+ Macro definitions
+ ******************************************************************************/
+#define RTOS_SOCKETS                (IPERF_MAX_STREAMS + 2U)    /* Streams, control and listener */
+#define RTOS_THREAD_STACK_WORDS     (512U)
+#define RTOS_CPU_SLOT               (IPERF_MAX_STREAMS)         /* Thread slot of the CPU meter */
+#define RTOS_CPU_GAP_CYCLES         (1024U)                     /* ~2 us, a longer gap between two reads means preempted */
+#define RTOS_CLOSE_WAIT_MS          (1000U)                     /* Graceful shutdown limit */
+
+#define DWT_DEMCR                   (*(volatile uint32_t *) 0xE000EDFCU)   /* Debug Exception and Monitor Control */
+#define DWT_DEMCR_TRCENA            (1U << 24)
+#define DWT_CTRL_CYCCNTENA          (1U << 0)
+
+/* FreeRTOS+TCP V4 keeps the IPv4 address in a union */
+#if defined(ipconfigUSE_IPv4)
+ #define RTOS_SIN_ADDR(addr)        ((addr).sin_address.ulIP_IPv4)
+#else
+ #define RTOS_SIN_ADDR(addr)        ((addr).sin_addr)
+#endif
+
+/******************************************************************************
+ Typedef definitions
+ ******************************************************************************/
+struct st_iperf_sock
+{
+    bool       used;
+    bool       tcp;
+    Socket_t   socket;
+    TickType_t rcv_timeout;                 /* Last FREERTOS_SO_RCVTIMEO set on the socket */
+};
+
+typedef struct st_rtos_slot
+{
+    TaskHandle_t      task;
+    StaticTask_t      tcb;
+    SemaphoreHandle_t done;
+    StaticSemaphore_t done_buf;
+    void           (* p_entry)(void * p_arg);
+    void            * p_arg;
+} rtos_slot_t;
+
+/******************************************************************************
+ Private global variables and functions
+ ******************************************************************************/
+static iperf_sock_t      g_rtos_socks[RTOS_SOCKETS];
+static rtos_slot_t       g_rtos_slots[IPERF_MAX_STREAMS + 1U];
+static StackType_t       g_rtos_stacks[IPERF_MAX_STREAMS + 1U][RTOS_THREAD_STACK_WORDS];
+static volatile bool     g_rtos_cpu_run;
+static volatile uint32_t g_rtos_cpu_idle;
+static uint32_t          g_rtos_cpu_last_cycles;
+static uint32_t          g_rtos_cpu_last_idle;
+
+static iperf_sock_t * rtos_sock_new(Socket_t socket, bool tcp);
+static void           rtos_sock_timeout(iperf_sock_t * p_sock, uint32_t timeout_ms);
+static TickType_t     rtos_ticks(uint32_t ms);
+static void           rtos_addr(struct freertos_sockaddr * p_addr, uint32_t ip, uint16_t port);
+static int32_t        rtos_slot_start(uint32_t slot, void (* p_entry)(void * p_arg), void * p_arg, UBaseType_t priority);
+static void           rtos_slot_entry(void * p_arg);
+static void           rtos_cpu_meter(void * p_arg);
+
+iperf_sock_t * iperf_port_tcp_listen(uint16_t port)
+{
+    struct freertos_sockaddr addr;
+    Socket_t                 socket = FreeRTOS_socket(FREERTOS_AF_INET, FREERTOS_SOCK_STREAM, FREERTOS_IPPROTO_TCP);
+
+    if (FREERTOS_INVALID_SOCKET == socket)
+    {
+        return NULL;
+    }
+    rtos_addr(&addr, 0U, port);
+    if ((0 != FreeRTOS_bind(socket, &addr, sizeof(addr))) ||
+        (0 != FreeRTOS_listen(socket, (BaseType_t) IPERF_MAX_STREAMS + 1)))
+    {
+        FreeRTOS_closesocket(socket);
+        return NULL;
+    }
+
+    return rtos_sock_new(socket, true);
+}
+
+iperf_sock_t * iperf_port_tcp_accept(iperf_sock_t * p_listener, uint32_t timeout_ms)
+{
+    struct freertos_sockaddr addr;
+    socklen_t                len    = sizeof(addr);
+    Socket_t                 socket = NULL;
+
+    rtos_sock_timeout(p_listener, timeout_ms);
+    socket = FreeRTOS_accept(p_listener->socket, &addr, &len);
+    if ((NULL == socket) || (FREERTOS_INVALID_SOCKET == socket))
+    {
+        return NULL;
+    }
+
+    return rtos_sock_new(socket, true);
+}
+
+iperf_sock_t * iperf_port_tcp_connect(uint32_t ip, uint16_t port, uint32_t timeout_ms)
+{
+    struct freertos_sockaddr addr;
+    TickType_t               ticks  = rtos_ticks(timeout_ms);
+    Socket_t                 socket = FreeRTOS_socket(FREERTOS_AF_INET, FREERTOS_SOCK_STREAM, FREERTOS_IPPROTO_TCP);
+
+    if (FREERTOS_INVALID_SOCKET == socket)
+    {
+        return NULL;
+    }
+    FreeRTOS_setsockopt(socket, 0, FREERTOS_SO_RCVTIMEO, &ticks, sizeof(ticks));
+    FreeRTOS_setsockopt(socket, 0, FREERTOS_SO_SNDTIMEO, &ticks, sizeof(ticks));
+    rtos_addr(&addr, ip, port);
+    if (0 != FreeRTOS_connect(socket, &addr, sizeof(addr)))
+    {
+        FreeRTOS_closesocket(socket);
+        return NULL;
+    }
+
+    return rtos_sock_new(socket, true);
+}
+
+iperf_sock_t * iperf_port_udp_open(uint16_t port)
+{
+    struct freertos_sockaddr addr;
+    TickType_t               ticks  = rtos_ticks(100U);
+    Socket_t                 socket = FreeRTOS_socket(FREERTOS_AF_INET, FREERTOS_SOCK_DGRAM, FREERTOS_IPPROTO_UDP);
+
+    if (FREERTOS_INVALID_SOCKET == socket)
+    {
+        return NULL;
+    }
+    /* A paced sender must not stall on a missing network buffer */
+    FreeRTOS_setsockopt(socket, 0, FREERTOS_SO_SNDTIMEO, &ticks, sizeof(ticks));
+    rtos_addr(&addr, 0U, port);
+    if (0 != FreeRTOS_bind(socket, &addr, sizeof(addr)))
+    {
+        FreeRTOS_closesocket(socket);
+        return NULL;
+    }
+
+    return rtos_sock_new(socket, false);
+}
+
+int32_t iperf_port_send(iperf_sock_t * p_sock, void const * p_buf, uint32_t size)
+{
+    BaseType_t n = FreeRTOS_send(p_sock->socket, p_buf, size, 0);
+
+    if (n > 0)
+    {
+        return (int32_t) n;
+    }
+
+    /* -pdFREERTOS_ERRNO_ENOSPC: the send timeout expired with the stream buffer full */
+    return ((0 == n) || (-pdFREERTOS_ERRNO_ENOSPC == n)) ? 0 : -1;
+}
+
+/*******************************************************************************************************************//**
+ * @brief       With p_buf NULL the received bytes are dropped straight out of the socket's stream buffer.
+ **********************************************************************************************************************/
+int32_t iperf_port_recv(iperf_sock_t * p_sock, void * p_buf, uint32_t size, uint32_t timeout_ms)
+{
+    uint8_t  * p_data = NULL;
+    BaseType_t n      = 0;
+
+    rtos_sock_timeout(p_sock, timeout_ms);
+    if (NULL == p_buf)
+    {
+        n = FreeRTOS_recv(p_sock->socket, &p_data, size, FREERTOS_ZERO_COPY);
+        if (n > 0)
+        {
+            FreeRTOS_recv(p_sock->socket, NULL, (size_t) n, 0);
+        }
+    }
+    else
+    {
+        n = FreeRTOS_recv(p_sock->socket, p_buf, size, 0);
+    }
+
+    return (n < 0) ? -1 : (int32_t) n;
+}
+
+int32_t iperf_port_sendto(iperf_sock_t * p_sock, uint32_t ip, uint16_t port, void const * p_buf, uint32_t size)
+{
+    struct freertos_sockaddr addr;
+    int32_t                  n = 0;
+
+    rtos_addr(&addr, ip, port);
+    n = FreeRTOS_sendto(p_sock->socket, p_buf, size, 0, &addr, sizeof(addr));
+
+    /* No network buffer in time is transient for a paced UDP sender */
+    return (n > 0) ? n : 0;
+}
+
+int32_t iperf_port_recvfrom(iperf_sock_t * p_sock, void * p_buf, uint32_t size, uint32_t * p_ip,
+                            uint16_t * p_port, uint32_t timeout_ms)
+{
+    struct freertos_sockaddr addr;
+    socklen_t                len = sizeof(addr);
+    int32_t                  n   = 0;
+
+    rtos_sock_timeout(p_sock, timeout_ms);
+    n = FreeRTOS_recvfrom(p_sock->socket, p_buf, size, 0, &addr, &len);
+    if (n <= 0)
+    {
+        return 0;
+    }
+    *p_ip   = FreeRTOS_ntohl(RTOS_SIN_ADDR(addr));
+    *p_port = FreeRTOS_ntohs(addr.sin_port);
+
+    return n;
+}
+
+void iperf_port_close(iperf_sock_t * p_sock)
+{
+    uint32_t start = iperf_port_time_ms();
+
+    if (p_sock->tcp && (0 == FreeRTOS_shutdown(p_sock->socket, FREERTOS_SHUT_RDWR)))
+    {
+        /* Drain until the peer has closed too, so the FIN handshake completes before the socket is freed */
+        while (((iperf_port_time_ms() - start) < RTOS_CLOSE_WAIT_MS) && (iperf_port_recv(p_sock, NULL, 1460U, 100U) >= 0))
+        {
+            ;
+        }
+    }
+    FreeRTOS_closesocket(p_sock->socket);
+    p_sock->used = false;
+}
+
+uint32_t iperf_port_time_ms(void)
+{
+    return (uint32_t) (((uint64_t) xTaskGetTickCount() * 1000U) / configTICK_RATE_HZ);
+}
+
+void iperf_port_sleep_ms(uint32_t ms)
+{
+    vTaskDelay(rtos_ticks(ms));
+}
+
+/*******************************************************************************************************************//**
+ * @brief       Workers run at the priority of the calling task, on static stacks to keep them off the heap.
+ **********************************************************************************************************************/
+int32_t iperf_port_thread_start(uint32_t slot, void (* p_entry)(void * p_arg), void * p_arg)
+{
+    return rtos_slot_start(slot, p_entry, p_arg, uxTaskPriorityGet(NULL));
+}
+
+void iperf_port_thread_join(uint32_t slot)
+{
+    rtos_slot_t * p_slot = &g_rtos_slots[slot];
+
+    xSemaphoreTake(p_slot->done, portMAX_DELAY);
+    vTaskDelete(p_slot->task);
+    vSemaphoreDelete(p_slot->done);
+}
+
+/*******************************************************************************************************************//**
+ * @brief       CPU load from a spin loop at idle priority, see iperf_port_netx.c in the ThreadX example.
+ **********************************************************************************************************************/
+void iperf_port_cpu_start(void)
+{
+    DWT_DEMCR  |= DWT_DEMCR_TRCENA;
+    DWT->CTRL  |= DWT_CTRL_CYCCNTENA;
+
+    g_rtos_cpu_idle        = 0U;
+    g_rtos_cpu_last_idle   = 0U;
+    g_rtos_cpu_last_cycles = DWT->CYCCNT;
+    g_rtos_cpu_run         = true;
+    if (0 != rtos_slot_start(RTOS_CPU_SLOT, rtos_cpu_meter, NULL, tskIDLE_PRIORITY))
+    {
+        g_rtos_cpu_run = false;
+    }
+}
+
+uint32_t iperf_port_cpu_load(void)
+{
+    uint32_t cycles = DWT->CYCCNT;
+    uint32_t idle   = g_rtos_cpu_idle;
+    uint32_t total  = cycles - g_rtos_cpu_last_cycles;
+    uint32_t quiet  = idle - g_rtos_cpu_last_idle;
+
+    g_rtos_cpu_last_cycles = cycles;
+    g_rtos_cpu_last_idle   = idle;
+    if (!g_rtos_cpu_run || (0U == total) || (quiet > total))
+    {
+        return 0U;
+    }
+
+    return (uint32_t) (((uint64_t) (total - quiet) * 100U) / total);
+}
+
+void iperf_port_cpu_stop(void)
+{
+    if (g_rtos_cpu_run)
+    {
+        g_rtos_cpu_run = false;
+        iperf_port_thread_join(RTOS_CPU_SLOT);
+    }
+}
+
+static iperf_sock_t * rtos_sock_new(Socket_t socket, bool tcp)
+{
+    TickType_t ticks = rtos_ticks(1000U);
+
+    /* Bound blocking sends so the session timer keeps running with the window closed */
+    if (tcp)
+    {
+        FreeRTOS_setsockopt(socket, 0, FREERTOS_SO_SNDTIMEO, &ticks, sizeof(ticks));
+    }
+
+    for (uint32_t i = 0U; i < RTOS_SOCKETS; i++)
+    {
+        if (!g_rtos_socks[i].used)
+        {
+            g_rtos_socks[i].used        = true;
+            g_rtos_socks[i].tcp         = tcp;
+            g_rtos_socks[i].socket      = socket;
+            g_rtos_socks[i].rcv_timeout = portMAX_DELAY;
+
+            return &g_rtos_socks[i];
+        }
+    }
+    FreeRTOS_closesocket(socket);
+
+    return NULL;
+}
+
+static void rtos_sock_timeout(iperf_sock_t * p_sock, uint32_t timeout_ms)
+{
+    TickType_t ticks = rtos_ticks(timeout_ms);
+
+    if (ticks != p_sock->rcv_timeout)
+    {
+        FreeRTOS_setsockopt(p_sock->socket, 0, FREERTOS_SO_RCVTIMEO, &ticks, sizeof(ticks));
+        p_sock->rcv_timeout = ticks;
+    }
+}
+
+static TickType_t rtos_ticks(uint32_t ms)
+{
+    if (0xFFFFFFFFU == ms)
+    {
+        return portMAX_DELAY;
+    }
+
+    return (TickType_t) ((((uint64_t) ms * configTICK_RATE_HZ) + 999U) / 1000U);
+}
+
+static void rtos_addr(struct freertos_sockaddr * p_addr, uint32_t ip, uint16_t port)
+{
+    memset(p_addr, 0, sizeof(*p_addr));
+    p_addr->sin_family   = FREERTOS_AF_INET;
+    p_addr->sin_port     = FreeRTOS_htons(port);
+    RTOS_SIN_ADDR(*p_addr) = FreeRTOS_htonl(ip);
+}
+
+static int32_t rtos_slot_start(uint32_t slot, void (* p_entry)(void * p_arg), void * p_arg, UBaseType_t priority)
+{
+    rtos_slot_t * p_slot = &g_rtos_slots[slot];
+
+    p_slot->p_entry = p_entry;
+    p_slot->p_arg   = p_arg;
+    p_slot->done    = xSemaphoreCreateBinaryStatic(&p_slot->done_buf);
+    p_slot->task    = xTaskCreateStatic(rtos_slot_entry, "iperf", RTOS_THREAD_STACK_WORDS, p_slot, priority,
+                                        g_rtos_stacks[slot], &p_slot->tcb);
+    if (NULL == p_slot->task)
+    {
+        vSemaphoreDelete(p_slot->done);
+        return -1;
+    }
+
+    return 0;
+}
+
+static void rtos_slot_entry(void * p_arg)
+{
+    rtos_slot_t * p_slot = (rtos_slot_t *) p_arg;
+
+    p_slot->p_entry(p_slot->p_arg);
+    xSemaphoreGive(p_slot->done);
+
+    /* Deleted by iperf_port_thread_join() */
+    vTaskSuspend(NULL);
+}
+
+static void rtos_cpu_meter(void * p_arg)
+{
+    uint32_t last = DWT->CYCCNT;
+    uint32_t now  = 0U;
+
+    FSP_PARAMETER_NOT_USED(p_arg);
+
+    while (g_rtos_cpu_run)
+    {
+        now = DWT->CYCCNT;
+        if ((now - last) < RTOS_CPU_GAP_CYCLES)
+        {
+            g_rtos_cpu_idle += now - last;
+        }
+        last = now;
+    }
+}
+
+/*******************************************************************************************************************//**
+ * @} (end addtogroup iperf)
+ **********************************************************************************************************************/
@@ -4,6 +4,7 @@
 #include "FreeRTOS_Sockets.h"
 #include "common_utils.h"
 #include "usr_app.h"
+#include "iperf.h"
 
 /* Domain for the DNS Host lookup is used in this Example Project.
  * The project can be built with different *gp_domain_name to validate the DNS client
@@ -222,6 +223,10 @@ void net_thread_entry(void *pvParameters)
                 print_pingResult();
                 usr_print_ability |= PRINT_NWK_USR_MSG_DISABLE;
             }
+#if (USR_IPERF_MODE != USR_IPERF_NONE)
+            /* Does not return, the link state is no longer monitored from here on */
+            usr_iperf_process();
+#endif
         }
         else
         {
@@ -450,3 +455,65 @@ const char *pcApplicationHostnameHook(void)
     return KIT_NAME;
 }
 #endif
+
+#if (USR_IPERF_MODE != USR_IPERF_NONE)
+/*******************************************************************************************************************//**
+ * @brief      Print an iperf interval or final report on the RTT console.
+ * @param[in]  p_report  report from iperf_run()
+ * @retval     None
+ **********************************************************************************************************************/
+static void usr_iperf_report(iperf_report_t const *p_report)
+{
+    char line[128];
+
+    iperf_report_format(p_report, line, sizeof(line));
+    APP_PRINT("%s\r\n", line);
+}
+
+/*******************************************************************************************************************//**
+ * @brief      Run the iperf test selected by USR_IPERF_MODE. Never returns.
+ * @param[in]  None
+ * @retval     None
+ **********************************************************************************************************************/
+void usr_iperf_process(void)
+{
+    iperf_cfg_t     cfg;
+    iperf_mode_t    mode    = IPERF_MODE_SERVER;
+    iperf_proto_t   proto   = IPERF_PROTO_TCP;
+    iperf_version_t version = IPERF_VERSION_2;
+    int32_t         err     = IPERF_OK;
+
+    if ((USR_IPERF_TCP_CLIENT == USR_IPERF_MODE) || (USR_IPERF_UDP_CLIENT == USR_IPERF_MODE) ||
+        (USR_IPERF3_CLIENT == USR_IPERF_MODE))
+    {
+        mode = IPERF_MODE_CLIENT;
+    }
+    if ((USR_IPERF_UDP_SERVER == USR_IPERF_MODE) || (USR_IPERF_UDP_CLIENT == USR_IPERF_MODE))
+    {
+        proto = IPERF_PROTO_UDP;
+    }
+    if ((USR_IPERF3_SERVER == USR_IPERF_MODE) || (USR_IPERF3_CLIENT == USR_IPERF_MODE))
+    {
+        version = IPERF_VERSION_3;
+    }
+
+    iperf_cfg_init(&cfg, mode, proto, version);
+    cfg.server_ip = FreeRTOS_ntohl(FreeRTOS_inet_addr(USR_IPERF_SERVER_IP));
+    cfg.streams   = USR_IPERF_STREAMS;
+    cfg.udp_kbps  = USR_IPERF_UDP_KBPS;
+
+    APP_PRINT("\r\niperf %s started\r\n", (IPERF_MODE_CLIENT == mode) ? "client" : "server");
+    while (true)
+    {
+        err = iperf_run(&cfg, usr_iperf_report);
+        if (IPERF_OK != err)
+        {
+            APP_PRINT("iperf session failed: %d\r\n", (int) err);
+        }
+        if ((IPERF_OK != err) || (IPERF_MODE_CLIENT == mode))
+        {
+            vTaskDelay(pdMS_TO_TICKS(USR_IPERF_PAUSE_MS));
+        }
+    }
+}
+#endif
@@ -32,6 +32,22 @@
 #define USR_TEST_PING_IP "172.217.160.174"
 #define USR_PING_COUNT (100)
 
+/* iperf throughput test, run once the ping test is done. Servers run forever, clients repeat after a pause.
+ * PC side: "iperf -c <board ip> [-u] [-P n]" / "iperf -s [-u]" / "iperf3 -c <board ip> [-P n]" / "iperf3 -s" */
+#define USR_IPERF_NONE (0)
+#define USR_IPERF_TCP_SERVER (1)
+#define USR_IPERF_TCP_CLIENT (2)
+#define USR_IPERF_UDP_SERVER (3)
+#define USR_IPERF_UDP_CLIENT (4)
+#define USR_IPERF3_SERVER (5)
+#define USR_IPERF3_CLIENT (6)
+
+#define USR_IPERF_MODE (USR_IPERF_NONE)
+#define USR_IPERF_SERVER_IP "192.168.0.100"
+#define USR_IPERF_STREAMS (1)
+#define USR_IPERF_UDP_KBPS (20000)
+#define USR_IPERF_PAUSE_MS (5000)
+
 #define SUCCESS (0)
 #define PRINT_UP_MSG_DISABLE (0x01)
 #define PRINT_DOWN_MSG_DISABLE (0x02)
@@ -69,6 +85,9 @@ BaseType_t vSendPing( const char *pcIPAddress);
 void print_ipconfig(void);
 void print_pingResult(void);
 void dnsQuerryFunc(char *domain_name);
+#if (USR_IPERF_MODE != USR_IPERF_NONE)
+void usr_iperf_process(void);
+#endif
 
 typedef struct st_ping_data
 {
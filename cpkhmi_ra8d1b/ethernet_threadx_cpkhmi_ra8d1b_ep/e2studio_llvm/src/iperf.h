@@ -0,0 +1,110 @@
+/***********************************************************************************************************************
+ * File Name    : iperf.h
+ * Description  : Contains data structures and functions used in iperf.c
+ **********************************************************************************************************************/
+
+/*
+* Copyright (c) 2024 Renesas Electronics Corporation and/or its affiliates
+*
+* SPDX-License-Identifier: BSD-3-Clause
+*/
+
+#ifndef IPERF_H_
+#define IPERF_H_
+
+#include <stdint.h>
+#include <stdbool.h>
+
+/*******************************************************************************************************************//**
+ * @addtogroup iperf
+ * @{
+ **********************************************************************************************************************/
+
+/******************************************************************************
+ Macro definitions
+ ******************************************************************************/
+#define IPERF_MAX_STREAMS           (4U)        /* Parallel data streams per session (-P) */
+#define IPERF_BUF_SIZE              (4096U)     /* Per stream I/O buffer */
+#define IPERF2_DEFAULT_PORT         (5001U)
+#define IPERF3_DEFAULT_PORT         (5201U)
+#define IPERF_UDP_DEFAULT_LEN       (1470U)     /* iperf2 default datagram size */
+#define IPERF_DEFAULT_DURATION_MS   (10000U)
+#define IPERF_DEFAULT_INTERVAL_MS   (1000U)     /* Keep below 4 s, the firmware CPU meter wraps at ~4.4 s */
+#define IPERF_DEFAULT_UDP_KBPS      (1000U)     /* iperf2 default of 1 Mbit/s */
+#define IPERF_CPU_UNKNOWN           (0xFFFFFFFFU)   /* cpu_load of a report taken from the peer */
+
+/* Return codes of iperf_run() */
+#define IPERF_OK                    (0)
+#define IPERF_ERR_ARG               (-1)
+#define IPERF_ERR_SOCKET            (-2)
+#define IPERF_ERR_CONNECT           (-3)
+#define IPERF_ERR_PROTOCOL          (-4)
+#define IPERF_ERR_THREAD            (-5)
+
+/******************************************************************************
+ Typedef definitions
+ ******************************************************************************/
+typedef enum e_iperf_mode
+{
+    IPERF_MODE_SERVER,
+    IPERF_MODE_CLIENT,
+} iperf_mode_t;
+
+typedef enum e_iperf_proto
+{
+    IPERF_PROTO_TCP,
+    IPERF_PROTO_UDP,                            /* iperf2 only */
+} iperf_proto_t;
+
+typedef enum e_iperf_version
+{
+    IPERF_VERSION_2,                            /* Interoperates with iperf 2.0.x */
+    IPERF_VERSION_3,                            /* Interoperates with iperf3, TCP only */
+} iperf_version_t;
+
+/** Session parameters, see iperf_cfg_init() for the defaults */
+typedef struct st_iperf_cfg
+{
+    iperf_mode_t    mode;
+    iperf_proto_t   proto;
+    iperf_version_t version;
+    uint32_t        server_ip;                  /* Client mode, host byte order */
+    uint16_t        port;
+    uint32_t        streams;                    /* Client mode, 1..IPERF_MAX_STREAMS */
+    uint32_t        duration_ms;                /* Client mode */
+    uint32_t        interval_ms;                /* 0 disables interval reports */
+    uint32_t        udp_kbps;                   /* UDP client target rate over all streams */
+    uint32_t        len;                        /* Write size, datagram size for UDP */
+} iperf_cfg_t;
+
+/** Throughput over one interval or, with final set, over the whole session. Sums all streams. */
+typedef struct st_iperf_report
+{
+    uint32_t start_ms;                          /* Relative to the start of the session */
+    uint32_t end_ms;
+    uint64_t bytes;
+    uint32_t kbps;
+    uint32_t streams;
+    uint32_t cpu_load;                          /* Percent, average over the period, or IPERF_CPU_UNKNOWN */
+    uint32_t datagrams;                         /* UDP server only */
+    uint32_t lost;
+    uint32_t out_of_order;
+    uint32_t jitter_us;
+    bool     sender;
+    bool     final;
+} iperf_report_t;
+
+typedef void (* iperf_report_cb_t)(iperf_report_t const * p_report);
+
+/******************************************************************************
+ Function prototypes
+ ******************************************************************************/
+void     iperf_cfg_init(iperf_cfg_t * p_cfg, iperf_mode_t mode, iperf_proto_t proto, iperf_version_t version);
+int32_t  iperf_run(iperf_cfg_t const * p_cfg, iperf_report_cb_t report);
+uint32_t iperf_report_format(iperf_report_t const * p_report, char * p_buf, uint32_t size);
+
+/*******************************************************************************************************************//**
+ * @} (end addtogroup iperf)
+ **********************************************************************************************************************/
+
+#endif /* IPERF_H_ */
@@ -0,0 +1,53 @@
+/***********************************************************************************************************************
+ * File Name    : iperf_port.h
+ * Description  : Network stack and RTOS services used by iperf.c. One implementation per stack.
+ **********************************************************************************************************************/
+
+/*
+* Copyright (c) 2024 Renesas Electronics Corporation and/or its affiliates
+*
+* SPDX-License-Identifier: BSD-3-Clause
+*/
+
+#ifndef IPERF_PORT_H_
+#define IPERF_PORT_H_
+
+#include <stdint.h>
+
+/*******************************************************************************************************************//**
+ * @addtogroup iperf
+ * @{
+ **********************************************************************************************************************/
+
+/** Socket handle, defined by the port */
+typedef struct st_iperf_sock iperf_sock_t;
+
+/* Sockets: NULL / negative return values are errors, recv returns 0 on timeout.
+ * A NULL buffer to iperf_port_recv discards the data without copying it, the return value may then exceed size. */
+iperf_sock_t * iperf_port_tcp_listen(uint16_t port);
+iperf_sock_t * iperf_port_tcp_accept(iperf_sock_t * p_listener, uint32_t timeout_ms);
+iperf_sock_t * iperf_port_tcp_connect(uint32_t ip, uint16_t port, uint32_t timeout_ms);
+iperf_sock_t * iperf_port_udp_open(uint16_t port);
+int32_t        iperf_port_send(iperf_sock_t * p_sock, void const * p_buf, uint32_t size);
+int32_t        iperf_port_recv(iperf_sock_t * p_sock, void * p_buf, uint32_t size, uint32_t timeout_ms);
+int32_t        iperf_port_sendto(iperf_sock_t * p_sock, uint32_t ip, uint16_t port, void const * p_buf, uint32_t size);
+int32_t        iperf_port_recvfrom(iperf_sock_t * p_sock, void * p_buf, uint32_t size, uint32_t * p_ip,
+                                   uint16_t * p_port, uint32_t timeout_ms);
+void           iperf_port_close(iperf_sock_t * p_sock);
+
+/* Time and threads. Slots run from 0 to IPERF_MAX_STREAMS - 1 and are joined before reuse. */
+uint32_t       iperf_port_time_ms(void);
+void           iperf_port_sleep_ms(uint32_t ms);
+int32_t        iperf_port_thread_start(uint32_t slot, void (* p_entry)(void * p_arg), void * p_arg);
+void           iperf_port_thread_join(uint32_t slot);
+
+/* CPU load in percent since the previous call, between start and stop */
+void           iperf_port_cpu_start(void);
+uint32_t       iperf_port_cpu_load(void);
+void           iperf_port_cpu_stop(void);
+
+/*******************************************************************************************************************//**
+ * @} (end addtogroup iperf)
+ **********************************************************************************************************************/
+
+#endif /* IPERF_PORT_H_ */
@@ -0,0 +1,534 @@
+/***********************************************************************************************************************
+ * File Name    : iperf_port_netx.c
+ * Description  : iperf port on NetX Duo and ThreadX
+ **********************************************************************************************************************/
+
+/*
+* Copyright (c) 2024 Renesas Electronics Corporation and/or its affiliates
+*
+* SPDX-License-Identifier: BSD-3-Clause
+*/
+
+#include <string.h>
+#include "network_thread.h"
+#include "iperf.h"
+#include "iperf_port.h"
+#include "nx_stream.h"
+
+/*******************************************************************************************************************//**
+ * @addtogroup iperf
+ * @{
+ **********************************************************************************************************************/
+
+/******************************************************************************
+ Macro definitions
+ ******************************************************************************/
+#define NETX_TCP_WINDOW             (32 * 1024)                 /* Window scaling is disabled in this configuration */
+#define NETX_UDP_QUEUE_MAX          (16)
+#define NETX_SOCKETS                (IPERF_MAX_STREAMS + 3U)    /* Streams, control, listener and its waiting socket */
+#define NETX_THREAD_STACK_SIZE      (2048U)
+#define NETX_CPU_SLOT               (IPERF_MAX_STREAMS)         /* Thread slot of the CPU meter */
+#define NETX_CPU_GAP_CYCLES         (1024U)                     /* ~2 us, a longer gap between two reads means preempted */
+
+#define DWT_DEMCR                   (*(volatile uint32_t *) 0xE000EDFCU)   /* Debug Exception and Monitor Control */
+#define DWT_DEMCR_TRCENA            (1U << 24)
+#define DWT_CTRL_CYCCNTENA          (1U << 0)
+
+/******************************************************************************
+ Typedef definitions
+ ******************************************************************************/
+struct st_iperf_sock
+{
+    bool           used;
+    bool           tcp;
+    bool           server;                  /* Accepted, as opposed to connected */
+    bool           listener;
+    bool           listening;
+    UINT           port;
+    NX_TCP_SOCKET  tcp_socket;
+    NX_UDP_SOCKET  udp_socket;
+    NX_PACKET    * p_pending;               /* Partly read packet */
+    ULONG          offset;
+    iperf_sock_t * p_waiting;               /* Listener: socket queued on the listen port */
+};
+
+typedef struct st_netx_slot
+{
+    TX_THREAD    thread;
+    TX_SEMAPHORE done;
+    void      (* p_entry)(void * p_arg);
+    void       * p_arg;
+} netx_slot_t;
+
+/******************************************************************************
+ Private global variables and functions
+ ******************************************************************************/
+/* Defined in network_thread_entry.c */
+extern NX_IP          g_ip0;
+extern NX_PACKET_POOL g_packet_pool0;
+
+static iperf_sock_t      g_netx_socks[NETX_SOCKETS];
+static netx_slot_t       g_netx_slots[IPERF_MAX_STREAMS + 1U];
+static uint8_t           g_netx_stacks[IPERF_MAX_STREAMS + 1U][NETX_THREAD_STACK_SIZE] BSP_PLACE_IN_SECTION(".stack.iperf") BSP_ALIGN_VARIABLE(BSP_STACK_ALIGNMENT);
+static volatile bool     g_netx_cpu_run;
+static volatile uint32_t g_netx_cpu_idle;
+static uint32_t          g_netx_cpu_last_cycles;
+static uint32_t          g_netx_cpu_last_idle;
+
+static iperf_sock_t * netx_sock_alloc(void);
+static void           netx_sock_free(iperf_sock_t * p_sock);
+static ULONG          netx_ticks(uint32_t ms);
+static int32_t        netx_slot_start(uint32_t slot, void (* p_entry)(void * p_arg), void * p_arg, UINT priority);
+static VOID           netx_slot_entry(ULONG slot);
+static void           netx_cpu_meter(void * p_arg);
+
+iperf_sock_t * iperf_port_tcp_listen(uint16_t port)
+{
+    iperf_sock_t * p_sock = netx_sock_alloc();
+
+    if (NULL != p_sock)
+    {
+        p_sock->listener = true;
+        p_sock->port     = port;
+    }
+
+    return p_sock;
+}
+
+/*******************************************************************************************************************//**
+ * @brief       NetX serves a listen port with one socket at a time: the first accept registers the port, later ones
+ *              relisten with a fresh socket. A socket that timed out stays queued for the next call.
+ **********************************************************************************************************************/
+iperf_sock_t * iperf_port_tcp_accept(iperf_sock_t * p_listener, uint32_t timeout_ms)
+{
+    iperf_sock_t * p_sock = p_listener->p_waiting;
+    UINT           status = NX_SUCCESS;
+
+    if (NULL == p_sock)
+    {
+        p_sock = netx_sock_alloc();
+        if (NULL == p_sock)
+        {
+            return NULL;
+        }
+        status = nx_tcp_socket_create(&g_ip0, &p_sock->tcp_socket, "iperf", NX_IP_NORMAL, NX_FRAGMENT_OKAY,
+                                      NX_IP_TIME_TO_LIVE, NETX_TCP_WINDOW, NX_NULL, NX_NULL);
+        if (NX_SUCCESS != status)
+        {
+            netx_sock_free(p_sock);
+            return NULL;
+        }
+        p_sock->tcp    = true;
+        p_sock->server = true;
+
+        if (!p_listener->listening)
+        {
+            status = nx_tcp_server_socket_listen(&g_ip0, p_listener->port, &p_sock->tcp_socket,
+                                                 IPERF_MAX_STREAMS + 1U, NX_NULL);
+            p_listener->listening = (NX_SUCCESS == status);
+        }
+        else
+        {
+            status = nx_tcp_server_socket_relisten(&g_ip0, p_listener->port, &p_sock->tcp_socket);
+            status = (NX_CONNECTION_PENDING == status) ? NX_SUCCESS : status;
+        }
+        if (NX_SUCCESS != status)
+        {
+            nx_tcp_socket_delete(&p_sock->tcp_socket);
+            netx_sock_free(p_sock);
+            return NULL;
+        }
+        p_listener->p_waiting = p_sock;
+    }
+
+    status = nx_tcp_server_socket_accept(&p_sock->tcp_socket, netx_ticks(timeout_ms));
+    if (NX_SUCCESS != status)
+    {
+        /* Put the socket back on the port in a clean state */
+        nx_tcp_server_socket_unaccept(&p_sock->tcp_socket);
+        nx_tcp_server_socket_relisten(&g_ip0, p_listener->port, &p_sock->tcp_socket);
+        return NULL;
+    }
+
+    p_listener->p_waiting = NULL;
+    return p_sock;
+}
+
+iperf_sock_t * iperf_port_tcp_connect(uint32_t ip, uint16_t port, uint32_t timeout_ms)
+{
+    iperf_sock_t * p_sock = netx_sock_alloc();
+    UINT           status = NX_SUCCESS;
+
+    if (NULL == p_sock)
+    {
+        return NULL;
+    }
+    status = nx_tcp_socket_create(&g_ip0, &p_sock->tcp_socket, "iperf", NX_IP_NORMAL, NX_FRAGMENT_OKAY,
+                                  NX_IP_TIME_TO_LIVE, NETX_TCP_WINDOW, NX_NULL, NX_NULL);
+    if (NX_SUCCESS != status)
+    {
+        netx_sock_free(p_sock);
+        return NULL;
+    }
+    p_sock->tcp = true;
+
+    status = nx_tcp_client_socket_bind(&p_sock->tcp_socket, NX_ANY_PORT, netx_ticks(timeout_ms));
+    if (NX_SUCCESS == status)
+    {
+        status = nx_tcp_client_socket_connect(&p_sock->tcp_socket, ip, port, netx_ticks(timeout_ms));
+        if (NX_SUCCESS != status)
+        {
+            nx_tcp_client_socket_unbind(&p_sock->tcp_socket);
+        }
+    }
+    if (NX_SUCCESS != status)
+    {
+        nx_tcp_socket_delete(&p_sock->tcp_socket);
+        netx_sock_free(p_sock);
+        return NULL;
+    }
+
+    return p_sock;
+}
+
+iperf_sock_t * iperf_port_udp_open(uint16_t port)
+{
+    iperf_sock_t * p_sock = netx_sock_alloc();
+
+    if (NULL == p_sock)
+    {
+        return NULL;
+    }
+    if (NX_SUCCESS != nx_udp_socket_create(&g_ip0, &p_sock->udp_socket, "iperf", NX_IP_NORMAL, NX_FRAGMENT_OKAY,
+                                           NX_IP_TIME_TO_LIVE, NETX_UDP_QUEUE_MAX))
+    {
+        netx_sock_free(p_sock);
+        return NULL;
+    }
+    if (NX_SUCCESS != nx_udp_socket_bind(&p_sock->udp_socket, (0U == port) ? NX_ANY_PORT : port, TX_NO_WAIT))
+    {
+        nx_udp_socket_delete(&p_sock->udp_socket);
+        netx_sock_free(p_sock);
+        return NULL;
+    }
+
+    return p_sock;
+}
+
+/*******************************************************************************************************************//**
+ * @brief       Send one MSS per packet through nx_stream so partial progress is known when the window stays full.
+ **********************************************************************************************************************/
+int32_t iperf_port_send(iperf_sock_t * p_sock, void const * p_buf, uint32_t size)
+{
+    nx_stream_source_t src  = {NX_NULL, 0U, 0U};
+    ULONG              mss  = 0U;
+    uint32_t           sent = 0U;
+    uint32_t           chunk;
+    UINT               status;
+
+    if (NX_SUCCESS != nx_tcp_socket_mss_get(&p_sock->tcp_socket, &mss))
+    {
+        return -1;
+    }
+
+    while (sent < size)
+    {
+        chunk      = ((size - sent) < mss) ? (size - sent) : mss;
+        src.p_data = (UCHAR const *) p_buf + sent;
+        src.size   = chunk;
+        src.offset = 0U;
+        status     = nx_stream_tcp_send(&p_sock->tcp_socket, &g_packet_pool0, chunk, nx_stream_copy_fill, &src,
+                                        NX_IP_PERIODIC_RATE);
+        if (NX_SUCCESS != status)
+        {
+            if (sent > 0U)
+            {
+                break;
+            }
+
+            return ((NX_WINDOW_OVERFLOW == status) || (NX_NO_PACKET == status) || (NX_TX_QUEUE_DEPTH == status) ||
+                    (NX_WAIT_ABORTED == status)) ? 0 : -1;
+        }
+        sent += chunk;
+    }
+
+    return (int32_t) sent;
+}
+
+/*******************************************************************************************************************//**
+ * @brief       Copy out of a pending packet, or with p_buf NULL drop whole packets without touching the payload.
+ **********************************************************************************************************************/
+int32_t iperf_port_recv(iperf_sock_t * p_sock, void * p_buf, uint32_t size, uint32_t timeout_ms)
+{
+    ULONG n      = 0U;
+    UINT  status = NX_SUCCESS;
+
+    if ((NX_NULL == p_sock->p_pending) && (NULL == p_buf))
+    {
+        status = nx_stream_tcp_receive(&p_sock->tcp_socket, NX_NULL, NX_NULL, &n, netx_ticks(timeout_ms));
+
+        return (NX_SUCCESS == status) ? (int32_t) n : ((NX_NO_PACKET == status) ? 0 : -1);
+    }
+
+    if (NX_NULL == p_sock->p_pending)
+    {
+        status = nx_tcp_socket_receive(&p_sock->tcp_socket, &p_sock->p_pending, netx_ticks(timeout_ms));
+        if (NX_SUCCESS != status)
+        {
+            p_sock->p_pending = NX_NULL;
+            return (NX_NO_PACKET == status) ? 0 : -1;
+        }
+        p_sock->offset = 0U;
+    }
+
+    if (NULL == p_buf)
+    {
+        n = p_sock->p_pending->nx_packet_length - p_sock->offset;
+    }
+    else
+    {
+        nx_packet_data_extract_offset(p_sock->p_pending, p_sock->offset, p_buf, size, &n);
+    }
+    p_sock->offset += n;
+    if (p_sock->offset >= p_sock->p_pending->nx_packet_length)
+    {
+        nx_packet_release(p_sock->p_pending);
+        p_sock->p_pending = NX_NULL;
+    }
+
+    return (int32_t) n;
+}
+
+int32_t iperf_port_sendto(iperf_sock_t * p_sock, uint32_t ip, uint16_t port, void const * p_buf, uint32_t size)
+{
+    nx_stream_source_t src    = {(UCHAR const *) p_buf, size, 0U};
+    UINT               status = nx_stream_udp_send(&p_sock->udp_socket, &g_packet_pool0, ip, port, size,
+                                                   nx_stream_copy_fill, &src, netx_ticks(100U));
+
+    if (NX_SUCCESS != status)
+    {
+        return (NX_NO_PACKET == status) ? 0 : -1;
+    }
+
+    return (int32_t) size;
+}
+
+int32_t iperf_port_recvfrom(iperf_sock_t * p_sock, void * p_buf, uint32_t size, uint32_t * p_ip,
+                            uint16_t * p_port, uint32_t timeout_ms)
+{
+    NX_PACKET * p_packet = NX_NULL;
+    ULONG       ip       = 0U;
+    UINT        port     = 0U;
+    ULONG       n        = 0U;
+    UINT        status   = nx_udp_socket_receive(&p_sock->udp_socket, &p_packet, netx_ticks(timeout_ms));
+
+    if (NX_SUCCESS != status)
+    {
+        return (NX_NO_PACKET == status) ? 0 : -1;
+    }
+
+    nx_udp_source_extract(p_packet, &ip, &port);
+    nx_packet_data_extract_offset(p_packet, 0U, p_buf, size, &n);
+    nx_packet_release(p_packet);
+    *p_ip   = ip;
+    *p_port = (uint16_t) port;
+
+    return (int32_t) n;
+}
+
+void iperf_port_close(iperf_sock_t * p_sock)
+{
+    if (p_sock->listener)
+    {
+        if (NULL != p_sock->p_waiting)
+        {
+            nx_tcp_server_socket_unaccept(&p_sock->p_waiting->tcp_socket);
+            nx_tcp_socket_delete(&p_sock->p_waiting->tcp_socket);
+            netx_sock_free(p_sock->p_waiting);
+        }
+        if (p_sock->listening)
+        {
+            nx_tcp_server_socket_unlisten(&g_ip0, p_sock->port);
+        }
+    }
+    else if (p_sock->tcp)
+    {
+        if (NX_NULL != p_sock->p_pending)
+        {
+            nx_packet_release(p_sock->p_pending);
+        }
+        nx_tcp_socket_disconnect(&p_sock->tcp_socket, NX_IP_PERIODIC_RATE);
+        if (p_sock->server)
+        {
+            nx_tcp_server_socket_unaccept(&p_sock->tcp_socket);
+        }
+        else
+        {
+            nx_tcp_client_socket_unbind(&p_sock->tcp_socket);
+        }
+        nx_tcp_socket_delete(&p_sock->tcp_socket);
+    }
+    else
+    {
+        nx_udp_socket_unbind(&p_sock->udp_socket);
+        nx_udp_socket_delete(&p_sock->udp_socket);
+    }
+
+    netx_sock_free(p_sock);
+}
+
+uint32_t iperf_port_time_ms(void)
+{
+    return (uint32_t) (((uint64_t) tx_time_get() * 1000U) / NX_IP_PERIODIC_RATE);
+}
+
+void iperf_port_sleep_ms(uint32_t ms)
+{
+    tx_thread_sleep(netx_ticks(ms));
+}
+
+/*******************************************************************************************************************//**
+ * @brief       Workers run at the priority of the calling thread.
+ **********************************************************************************************************************/
+int32_t iperf_port_thread_start(uint32_t slot, void (* p_entry)(void * p_arg), void * p_arg)
+{
+    UINT priority = 0U;
+
+    tx_thread_info_get(tx_thread_identify(), NX_NULL, NX_NULL, NX_NULL, &priority, NX_NULL, NX_NULL, NX_NULL, NX_NULL);
+
+    return netx_slot_start(slot, p_entry, p_arg, priority);
+}
+
+void iperf_port_thread_join(uint32_t slot)
+{
+    netx_slot_t * p_slot = &g_netx_slots[slot];
+
+    tx_semaphore_get(&p_slot->done, TX_WAIT_FOREVER);
+    tx_thread_terminate(&p_slot->thread);
+    tx_thread_delete(&p_slot->thread);
+    tx_semaphore_delete(&p_slot->done);
+}
+
+/*******************************************************************************************************************//**
+ * @brief       CPU load from a spin loop at the lowest priority. It only runs when nothing else does; the cycles
+ *              between two of its DWT reads are idle time unless the gap shows it was preempted.
+ **********************************************************************************************************************/
+void iperf_port_cpu_start(void)
+{
+    DWT_DEMCR  |= DWT_DEMCR_TRCENA;
+    DWT->CTRL  |= DWT_CTRL_CYCCNTENA;
+
+    g_netx_cpu_idle        = 0U;
+    g_netx_cpu_last_idle   = 0U;
+    g_netx_cpu_last_cycles = DWT->CYCCNT;
+    g_netx_cpu_run         = true;
+    if (0 != netx_slot_start(NETX_CPU_SLOT, netx_cpu_meter, NX_NULL, TX_MAX_PRIORITIES - 1U))
+    {
+        g_netx_cpu_run = false;
+    }
+}
+
+uint32_t iperf_port_cpu_load(void)
+{
+    uint32_t cycles = DWT->CYCCNT;
+    uint32_t idle   = g_netx_cpu_idle;
+    uint32_t total  = cycles - g_netx_cpu_last_cycles;
+    uint32_t quiet  = idle - g_netx_cpu_last_idle;
+
+    g_netx_cpu_last_cycles = cycles;
+    g_netx_cpu_last_idle   = idle;
+    if (!g_netx_cpu_run || (0U == total) || (quiet > total))
+    {
+        return 0U;
+    }
+
+    return (uint32_t) (((uint64_t) (total - quiet) * 100U) / total);
+}
+
+void iperf_port_cpu_stop(void)
+{
+    if (g_netx_cpu_run)
+    {
+        g_netx_cpu_run = false;
+        iperf_port_thread_join(NETX_CPU_SLOT);
+    }
+}
+
+static iperf_sock_t * netx_sock_alloc(void)
+{
+    for (uint32_t i = 0U; i < NETX_SOCKETS; i++)
+    {
+        if (!g_netx_socks[i].used)
+        {
+            memset(&g_netx_socks[i], 0, sizeof(g_netx_socks[i]));
+            g_netx_socks[i].used = true;
+
+            return &g_netx_socks[i];
+        }
+    }
+
+    return NULL;
+}
+
+static void netx_sock_free(iperf_sock_t * p_sock)
+{
+    p_sock->used = false;
+}
+
+static ULONG netx_ticks(uint32_t ms)
+{
+    if (0xFFFFFFFFU == ms)
+    {
+        return NX_WAIT_FOREVER;
+    }
+
+    return (ULONG) ((((uint64_t) ms * NX_IP_PERIODIC_RATE) + 999U) / 1000U);
+}
+
+static int32_t netx_slot_start(uint32_t slot, void (* p_entry)(void * p_arg), void * p_arg, UINT priority)
+{
+    netx_slot_t * p_slot = &g_netx_slots[slot];
+
+    p_slot->p_entry = p_entry;
+    p_slot->p_arg   = p_arg;
+    if (TX_SUCCESS != tx_semaphore_create(&p_slot->done, "iperf done", 0U))
+    {
+        return -1;
+    }
+    if (TX_SUCCESS != tx_thread_create(&p_slot->thread, "iperf", netx_slot_entry, slot, g_netx_stacks[slot],
+                                       NETX_THREAD_STACK_SIZE, priority, priority, TX_NO_TIME_SLICE, TX_AUTO_START))
+    {
+        tx_semaphore_delete(&p_slot->done);
+        return -1;
+    }
+
+    return 0;
+}
+
+static VOID netx_slot_entry(ULONG slot)
+{
+    g_netx_slots[slot].p_entry(g_netx_slots[slot].p_arg);
+    tx_semaphore_put(&g_netx_slots[slot].done);
+}
+
+static void netx_cpu_meter(void * p_arg)
+{
+    uint32_t last = DWT->CYCCNT;
+    uint32_t now  = 0U;
+
+    FSP_PARAMETER_NOT_USED(p_arg);
+
+    while (g_netx_cpu_run)
+    {
+        now = DWT->CYCCNT;
+        if ((now - last) < NETX_CPU_GAP_CYCLES)
+        {
+            g_netx_cpu_idle += now - last;
+        }
+        last = now;
+    }
+}
+
+/*******************************************************************************************************************//**
+ * @} (end addtogroup iperf)
+ **********************************************************************************************************************/
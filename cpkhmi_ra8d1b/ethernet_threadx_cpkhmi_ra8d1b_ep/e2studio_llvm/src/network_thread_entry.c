@@ -1,6 +1,8 @@
 #include "network_thread.h"
 #include "common_utils.h"
 #include "dhcpv4_client_ep.h"
+#include "nx_stream.h"
+#include "iperf.h"
 
 /*******************************************************************************************************************//**
  * @addtogroup NetX_dhcpv4_client_ep
@@ -16,14 +18,31 @@
 #define UDP_SERVER      (3)
 #define UDP_CLIENT      (4)
 
+/* Throughput test against iperf on the PC, see iperf.c. Servers run forever, clients repeat after a pause.
+ * PC side: "iperf -c <board ip> [-u] [-P n]" / "iperf -s [-u]" / "iperf3 -c <board ip> [-P n]" / "iperf3 -s" */
+#define IPERF_TCP_SERVER    (5)
+#define IPERF_TCP_CLIENT    (6)
+#define IPERF_UDP_SERVER    (7)
+#define IPERF_UDP_CLIENT    (8)
+#define IPERF3_SERVER       (9)
+#define IPERF3_CLIENT       (10)
+
 //#define PROTOCOL_TYPE  TCP_SERVER
 //#define PROTOCOL_TYPE  TCP_CLIENT
 #define PROTOCOL_TYPE  UDP_SERVER
 //#define PROTOCOL_TYPE  UDP_CLIENT
+//#define PROTOCOL_TYPE  IPERF_TCP_SERVER
+//#define PROTOCOL_TYPE  IPERF_TCP_CLIENT
+//#define PROTOCOL_TYPE  IPERF_UDP_SERVER
+//#define PROTOCOL_TYPE  IPERF_UDP_CLIENT
+//#define PROTOCOL_TYPE  IPERF3_SERVER
+//#define PROTOCOL_TYPE  IPERF3_CLIENT
 
 #define SERVER_ADDRESS              IP_ADDRESS(192,168,1,104)   // server IP
 #define TCP_PORT                    56789                       // tcp port
 #define UDP_PORT                    50000                       // udp port
+#define IPERF_STREAMS               1                           // iperf client parallel streams (-P)
+#define IPERF_UDP_KBPS              50000                       // iperf UDP client rate over all streams (-b)
 
 
 
@@ -31,6 +50,25 @@
 #define IPERF_BUFSZ     (4 * 1024)
 #define MAX_PACKET_SIZE  (1500)
 
+#define TCP_WINDOW_SIZE     (32 * 1024)
+#define IPERF_PAUSE_TICKS   (5 * NX_IP_PERIODIC_RATE)           // pause between two client sessions
+
+#define IS_TCP_PROTOCOL     ((PROTOCOL_TYPE==TCP_SERVER) || (PROTOCOL_TYPE==TCP_CLIENT))
+#define IS_IPERF_PROTOCOL   (PROTOCOL_TYPE >= IPERF_TCP_SERVER)
+
+#if (PROTOCOL_TYPE==IPERF_TCP_SERVER) || (PROTOCOL_TYPE==IPERF_TCP_CLIENT)
+#define IPERF_PROTO         IPERF_PROTO_TCP
+#define IPERF_VERSION       IPERF_VERSION_2
+#elif (PROTOCOL_TYPE==IPERF_UDP_SERVER) || (PROTOCOL_TYPE==IPERF_UDP_CLIENT)
+#define IPERF_PROTO         IPERF_PROTO_UDP
+#define IPERF_VERSION       IPERF_VERSION_2
+#else
+#define IPERF_PROTO         IPERF_PROTO_TCP
+#define IPERF_VERSION       IPERF_VERSION_3
+#endif
+#define IPERF_MODE          (((PROTOCOL_TYPE==IPERF_TCP_CLIENT) || (PROTOCOL_TYPE==IPERF_UDP_CLIENT) || \
+                              (PROTOCOL_TYPE==IPERF3_CLIENT)) ? IPERF_MODE_CLIENT : IPERF_MODE_SERVER)
+
 /* Function declarations*/
 /* Define the function to call for running a DHCP Client session. */
 static UINT run_dhcp_client_session(NX_DHCP *client_ptr, NX_IP *ip_ptr);
@@ -60,18 +98,23 @@ uint8_t g_packet_pool0_pool_memory[G_PACKET_POOL0_PACKET_NUM * (G_PACKET_POOL0_P
 
 UCHAR send_buf[IPERF_BUFSZ];
 
-#if (PROTOCOL_TYPE==TCP_SERVER) || (PROTOCOL_TYPE==TCP_CLIENT)
+#if IS_TCP_PROTOCOL
 NX_TCP_SOCKET           g_tcp_socket;
 #elif (PROTOCOL_TYPE==UDP_SERVER) || (PROTOCOL_TYPE==UDP_CLIENT)
 NX_UDP_SOCKET           g_udp_socket;
 #endif
 
-#if (PROTOCOL_TYPE==TCP_SERVER) || (PROTOCOL_TYPE==TCP_CLIENT)
-void send_data_over_tcp(char *data, UINT data_size);
+#if IS_TCP_PROTOCOL
+UINT send_data_over_tcp(UCHAR *data, UINT data_size);
+#elif (PROTOCOL_TYPE==UDP_SERVER) || (PROTOCOL_TYPE==UDP_CLIENT)
+UINT send_data_over_udp(UCHAR *data, UINT data_size);
 #endif
-
-void send_data_over_udp(char *data, UINT data_size);
 void netcomm_process(void);
+
+#if IS_IPERF_PROTOCOL
+static void iperf_report_print(iperf_report_t const *p_report);
+#endif
+
 /* Network Thread entry function */
 void network_thread_entry(void)
 {
@@ -113,13 +156,11 @@ void netcomm_process(void)
 {
     UINT               status  = NX_SUCCESS;
 
-
-    NX_PACKET *data_packet;
+#if !IS_IPERF_PROTOCOL
     ULONG bytes_read;
+#endif
 
-    UCHAR data_buffer[500];
-#if (PROTOCOL_TYPE==TCP_SERVER) || (PROTOCOL_TYPE==TCP_CLIENT)
-    ULONG socket_state;
+#if IS_TCP_PROTOCOL
     /* Enable NX TCP Module */
     status = nx_tcp_enable(&g_ip0);
     if(NX_SUCCESS != status)
@@ -134,7 +175,7 @@ void netcomm_process(void)
      for (int i = 0; i < IPERF_BUFSZ; i ++)
          send_buf[i] = i & 0xff;
 
-    nx_tcp_socket_create(&g_ip0, &g_tcp_socket,"TCP demo Socket",NX_IP_NORMAL,NX_FRAGMENT_OKAY,NX_IP_TIME_TO_LIVE,32 * 1024,NX_NULL,NX_NULL);
+    status = nx_tcp_socket_create(&g_ip0, &g_tcp_socket,"TCP demo Socket",NX_IP_NORMAL,NX_FRAGMENT_OKAY,NX_IP_TIME_TO_LIVE,TCP_WINDOW_SIZE,NX_NULL,NX_NULL);
 
     if(NX_SUCCESS != status)
     {
@@ -153,10 +194,39 @@ void netcomm_process(void)
         return;
     }
 
+#elif IS_IPERF_PROTOCOL
+    iperf_cfg_t cfg;
+
+    /* Enable NX TCP Module, UDP is enabled in ip_init0() */
+    status = nx_tcp_enable(&g_ip0);
+    if(NX_SUCCESS != status)
+    {
+        APP_PRINT(" NX TCP Enable err = %d\r\n", status);
+        return;
+    }
+
+    iperf_cfg_init(&cfg, IPERF_MODE, IPERF_PROTO, IPERF_VERSION);
+    cfg.server_ip = SERVER_ADDRESS;
+    cfg.streams   = IPERF_STREAMS;
+    cfg.udp_kbps  = IPERF_UDP_KBPS;
+
+    while (true)
+    {
+        int32_t err = iperf_run(&cfg, iperf_report_print);
+        if (IPERF_OK != err)
+        {
+            APP_PRINT("iperf session failed: %d\r\n", (int) err);
+        }
+        if ((IPERF_OK != err) || (IPERF_MODE_CLIENT == cfg.mode))
+        {
+            tx_thread_sleep(IPERF_PAUSE_TICKS);
+        }
+    }
+
 #endif
 
 #if (PROTOCOL_TYPE==TCP_SERVER)
-
+    ULONG socket_state;
 
     status = nx_tcp_server_socket_listen(&g_ip0,TCP_PORT, &g_tcp_socket,MAX_TCP_CLIENTS, NULL); 
     if(NX_SUCCESS != status)
@@ -183,46 +253,26 @@ void netcomm_process(void)
             {
                 APP_PRINT ("socket accept failed: 0x%x\n", status);
             }
+            continue;
         }
 
-        if((socket_state == NX_TCP_ESTABLISHED)&&(status == NX_SUCCESS))
+        /* receive the TCP client data, the payload is read where the driver put it and released at once */
+        status = nx_stream_tcp_receive(&g_tcp_socket, NX_NULL, NX_NULL, &bytes_read, NX_WAIT_FOREVER);
+        if (status == NX_SUCCESS)
         {
-
-            while (1)
-            {                   
-                /* receive the TCP client data */
-                status = nx_tcp_socket_receive(&g_tcp_socket,&data_packet, NX_WAIT_FOREVER);  /* wait forever */
-                if (status == NX_SUCCESS)
-                {
-                    /* received data */
-                    status = nx_packet_data_retrieve(data_packet,data_buffer,&bytes_read);
-
-                    if (status == NX_SUCCESS)
-                    {
- 
-                       APP_PRINT("received %d data \r\n ",bytes_read);
-
-                    }
-                    // release buffer is necessary
-                    nx_packet_release(data_packet);                   
-
-                    tx_thread_sleep (10);
-                }
-                else
-                {
-                    /* disconnection */
-                    nx_tcp_socket_disconnect(&g_tcp_socket,NX_WAIT_FOREVER);
+            APP_PRINT("received %d data \r\n ",bytes_read);
+        }
+        else
+        {
+            /* disconnection */
+            nx_tcp_socket_disconnect(&g_tcp_socket,NX_WAIT_FOREVER);
 
 
-                    nx_tcp_server_socket_unaccept(&g_tcp_socket);
+            nx_tcp_server_socket_unaccept(&g_tcp_socket);
 
-                    /* relisten */
-                    nx_tcp_server_socket_relisten(&g_ip0,TCP_PORT,&g_tcp_socket);
-                }
-            }
-            tx_thread_sleep (10);
+            /* relisten */
+            nx_tcp_server_socket_relisten(&g_ip0,TCP_PORT,&g_tcp_socket);
         }
-
     }
 
 #elif (PROTOCOL_TYPE==TCP_CLIENT)
@@ -253,7 +303,7 @@ void netcomm_process(void)
     while (1)
     {
         /* send data */
-        send_data_over_tcp(send_buf,1500);
+        status = send_data_over_tcp(send_buf,1500);
         if (status != NX_SUCCESS)
         {
             app_rtt_print_data(RTT_OUTPUT_MESSAGE_APP_ERR_STR, sizeof("TCP send failed."), "TCP send failed.");
@@ -275,27 +325,11 @@ void netcomm_process(void)
 
     while(1)
     {
-        /* wait for receiving data */
-        status = nx_udp_socket_receive(&g_udp_socket, &data_packet, NX_WAIT_FOREVER);
+        /* wait for receiving data, the datagram is read in place and released at once */
+        status = nx_stream_udp_receive(&g_udp_socket, NX_NULL, NX_NULL, &bytes_read, NX_WAIT_FOREVER);
         if(status == NX_SUCCESS)
         {
-            /* received data */
-            status = nx_packet_data_retrieve(data_packet,data_buffer,&bytes_read);
-
-            if (status == NX_SUCCESS)
-            {
-
-               APP_PRINT("received %d data \r\n ",bytes_read);
-
-            }
-            // release buffer is necessary
-            nx_packet_release(data_packet);
-
-            tx_thread_sleep (10);
-        }
-        else
-        {
-            continue;
+            APP_PRINT("received %d data \r\n ",bytes_read);
         }
     }
 
@@ -321,83 +355,64 @@ void netcomm_process(void)
 
 
 
-#if (PROTOCOL_TYPE==TCP_SERVER) || (PROTOCOL_TYPE==TCP_CLIENT)
-void send_data_over_tcp(char *data, UINT data_size) {
-    UINT bytes_remaining = data_size;
-    UINT bytes_to_send;
-    char *data_ptr = data;
-
-    NX_PACKET   *my_packet        = NULL;
-    UINT               status  = NX_SUCCESS;
-
-    // Loop until all data is sent
-    while (bytes_remaining > 0) {
-        // Allocate a packet from the packet pool
-        status = nx_packet_allocate(&g_packet_pool0, &my_packet, NX_TCP_PACKET,NX_WAIT_FOREVER);
-        if (status != NX_SUCCESS) {
-            // Handle error
-            app_rtt_print_data(RTT_OUTPUT_MESSAGE_APP_ERR_STR, sizeof("nx_packet_allocate failed."), "nx_packet_allocate failed.");
-            break;
-        }
-
-        // Calculate how many bytes to send in this packet
-        bytes_to_send = (bytes_remaining > MAX_PACKET_SIZE) ? MAX_PACKET_SIZE : bytes_remaining;
-
-        nx_packet_data_append(my_packet, data_ptr,bytes_to_send,&g_packet_pool0, NX_WAIT_FOREVER);
-
-        // Advance pointers
-        data_ptr += bytes_to_send;
-        bytes_remaining -= bytes_to_send;
+#if IS_TCP_PROTOCOL
+/*******************************************************************************************************************//**
+ * @brief     Send an application buffer over the TCP socket. Each packet carries one MSS, the data is written once
+ *            into the packet payload instead of going through nx_packet_data_append().
+ * @param[IN] data       data to send
+ * @param[IN] data_size  number of bytes
+ * @retval    NX_SUCCESS on successful operation, otherwise the NetX error
+ **********************************************************************************************************************/
+UINT send_data_over_tcp(UCHAR *data, UINT data_size)
+{
+    nx_stream_source_t src = {data, data_size, 0};
+    UINT               status;
 
-        // Send packet over TCP
-        status = nx_tcp_socket_send(&g_tcp_socket, my_packet, NX_WAIT_FOREVER);
-        if (status != NX_SUCCESS) {
-            // Handle error
-            app_rtt_print_data(RTT_OUTPUT_MESSAGE_APP_ERR_STR, sizeof("nx_tcp_socket_send error."), "nx_tcp_socket_send error.");
-            break;
-        }
+    status = nx_stream_tcp_send(&g_tcp_socket, &g_packet_pool0, data_size, nx_stream_copy_fill, &src, NX_WAIT_FOREVER);
+    if (status != NX_SUCCESS)
+    {
+        app_rtt_print_data(RTT_OUTPUT_MESSAGE_APP_ERR_STR, sizeof("nx_tcp_socket_send error."), "nx_tcp_socket_send error.");
     }
+    return status;
 }
 
 #elif (PROTOCOL_TYPE==UDP_SERVER) || (PROTOCOL_TYPE==UDP_CLIENT)
 
-void send_data_over_udp(char *data, UINT data_size) {
-    UINT bytes_remaining = data_size;
-    UINT bytes_to_send;
-    char *data_ptr = data;
-
-    NX_PACKET   *my_packet        = NULL;
-    UINT               status  = NX_SUCCESS;
-
-    // Loop until all data is sent
-    while (bytes_remaining > 0) {
-        // Allocate a packet from the packet pool
-        status = nx_packet_allocate(&g_packet_pool0, &my_packet, NX_UDP_PACKET,NX_WAIT_FOREVER);
-        if (status != NX_SUCCESS) {
-            // Handle error
-            app_rtt_print_data(RTT_OUTPUT_MESSAGE_APP_ERR_STR, sizeof("nx_packet_allocate failed."), "nx_packet_allocate failed.");
-            break;
-        }
+/*******************************************************************************************************************//**
+ * @brief     Send an application buffer to the server as UDP datagrams, see send_data_over_tcp().
+ * @param[IN] data       data to send
+ * @param[IN] data_size  number of bytes
+ * @retval    NX_SUCCESS on successful operation, otherwise the NetX error
+ **********************************************************************************************************************/
+UINT send_data_over_udp(UCHAR *data, UINT data_size)
+{
+    nx_stream_source_t src = {data, data_size, 0};
+    UINT               status;
 
-        // Calculate how many bytes to send in this packet
-        bytes_to_send = (bytes_remaining > MAX_PACKET_SIZE) ? MAX_PACKET_SIZE : bytes_remaining;
+    status = nx_stream_udp_send(&g_udp_socket, &g_packet_pool0, SERVER_ADDRESS, UDP_PORT, data_size,
+                                nx_stream_copy_fill, &src, NX_WAIT_FOREVER);
+    if (status != NX_SUCCESS)
+    {
+        app_rtt_print_data(RTT_OUTPUT_MESSAGE_APP_ERR_STR, sizeof("nx_udp_socket_send error."), "nx_udp_socket_send error.");
+    }
+    return status;
+}
 
-        nx_packet_data_append(my_packet, data_ptr,bytes_to_send,&g_packet_pool0, NX_WAIT_FOREVER);
+#endif
 
-        // Advance pointers
-        data_ptr += bytes_to_send;
-        bytes_remaining -= bytes_to_send;
+#if IS_IPERF_PROTOCOL
+/*******************************************************************************************************************//**
+ * @brief     Print an iperf interval or final report.
+ * @param[IN] p_report  report from iperf_run()
+ * @retval    None
+ **********************************************************************************************************************/
+static void iperf_report_print(iperf_report_t const *p_report)
+{
+    char line[128];
 
-        // Send packet over UDP
-        status = nx_udp_socket_send(&g_udp_socket, my_packet, SERVER_ADDRESS, UDP_PORT);
-        if (status != NX_SUCCESS) {
-            // Handle error
-            app_rtt_print_data(RTT_OUTPUT_MESSAGE_APP_ERR_STR, sizeof("nx_udp_socket_send error."), "nx_udp_socket_send error.");
-            break;
-        }
-    }
+    iperf_report_format(p_report, line, sizeof(line));
+    APP_PRINT("%s\r\n", line);
 }
-
 #endif
 
 /*******************************************************************************************************************//**
@@ -0,0 +1,271 @@
+/***********************************************************************************************************************
+ * File Name    : nx_stream.c
+ * Description  : Zero-copy TCP/UDP streaming on top of the NetX Duo packet pool
+ **********************************************************************************************************************/
+
+/*
+* Copyright (c) 2024 Renesas Electronics Corporation and/or its affiliates
+*
+* SPDX-License-Identifier: BSD-3-Clause
+*/
+
+#include <string.h>
+#include "nx_stream.h"
+
+/*******************************************************************************************************************//**
+ * @addtogroup nx_stream
+ * @{
+ **********************************************************************************************************************/
+
+static UINT  stream_packet_fill(NX_PACKET * p_packet, ULONG limit, nx_stream_fill_t fill, void * p_ctx,
+                                ULONG * p_filled);
+static ULONG stream_chain_process(NX_PACKET * p_packet, nx_stream_sink_t sink, void * p_ctx);
+
+/*******************************************************************************************************************//**
+ * @brief       Send size bytes on a connected TCP socket. Each packet is allocated from the pool and the producer
+ *              writes one MSS of payload directly behind the headroom NetX reserved for the headers, so the data is
+ *              never staged in an application buffer.
+ * @param[IN]   p_socket      connected TCP socket
+ * @param[IN]   p_pool        packet pool to allocate from
+ * @param[IN]   size          number of bytes to send
+ * @param[IN]   fill          producer callback
+ * @param[IN]   p_ctx         producer context
+ * @param[IN]   wait_option   wait for packets and window space
+ * @retval      NX_SUCCESS on successful operation, otherwise the NetX error
+ **********************************************************************************************************************/
+UINT nx_stream_tcp_send(NX_TCP_SOCKET * p_socket, NX_PACKET_POOL * p_pool, ULONG size,
+                        nx_stream_fill_t fill, void * p_ctx, ULONG wait_option)
+{
+    UINT        status   = NX_SUCCESS;
+    NX_PACKET * p_packet = NX_NULL;
+    ULONG       mss      = 0U;
+    ULONG       filled   = 0U;
+
+    status = nx_tcp_socket_mss_get(p_socket, &mss);
+    if (NX_SUCCESS != status)
+    {
+        return status;
+    }
+
+    while (size > 0U)
+    {
+        status = nx_packet_allocate(p_pool, &p_packet, NX_TCP_PACKET, wait_option);
+        if (NX_SUCCESS != status)
+        {
+            return status;
+        }
+
+        status = stream_packet_fill(p_packet, (size < mss) ? size : mss, fill, p_ctx, &filled);
+        if (NX_SUCCESS != status)
+        {
+            nx_packet_release(p_packet);
+            return status;
+        }
+
+        status = nx_tcp_socket_send(p_socket, p_packet, wait_option);
+        if (NX_SUCCESS != status)
+        {
+            /* NetX only takes ownership of the packet on success */
+            nx_packet_release(p_packet);
+            return status;
+        }
+        size -= filled;
+    }
+
+    return NX_SUCCESS;
+}
+
+/*******************************************************************************************************************//**
+ * @brief       Send size bytes as UDP datagrams of at most NX_STREAM_UDP_PAYLOAD_MAX bytes, written in place like
+ *              nx_stream_tcp_send().
+ * @param[IN]   p_socket      bound UDP socket
+ * @param[IN]   p_pool        packet pool to allocate from
+ * @param[IN]   ip_address    destination address
+ * @param[IN]   port          destination port
+ * @param[IN]   size          number of bytes to send
+ * @param[IN]   fill          producer callback
+ * @param[IN]   p_ctx         producer context
+ * @param[IN]   wait_option   wait for packets
+ * @retval      NX_SUCCESS on successful operation, otherwise the NetX error
+ **********************************************************************************************************************/
+UINT nx_stream_udp_send(NX_UDP_SOCKET * p_socket, NX_PACKET_POOL * p_pool, ULONG ip_address, UINT port,
+                        ULONG size, nx_stream_fill_t fill, void * p_ctx, ULONG wait_option)
+{
+    UINT        status   = NX_SUCCESS;
+    NX_PACKET * p_packet = NX_NULL;
+    ULONG       filled   = 0U;
+
+    while (size > 0U)
+    {
+        status = nx_packet_allocate(p_pool, &p_packet, NX_UDP_PACKET, wait_option);
+        if (NX_SUCCESS != status)
+        {
+            return status;
+        }
+
+        status = stream_packet_fill(p_packet, (size < NX_STREAM_UDP_PAYLOAD_MAX) ? size : NX_STREAM_UDP_PAYLOAD_MAX,
+                                    fill, p_ctx, &filled);
+        if (NX_SUCCESS != status)
+        {
+            nx_packet_release(p_packet);
+            return status;
+        }
+
+        status = nx_udp_socket_send(p_socket, p_packet, ip_address, port);
+        if (NX_SUCCESS != status)
+        {
+            nx_packet_release(p_packet);
+            return status;
+        }
+        size -= filled;
+    }
+
+    return NX_SUCCESS;
+}
+
+/*******************************************************************************************************************//**
+ * @brief       Receive one packet (chain) from a TCP socket and hand each buffer of the chain to the sink where it
+ *              lies in the pool, then release it.
+ * @param[IN]   p_socket      connected TCP socket
+ * @param[IN]   sink          consumer callback, may be NULL to only count the data
+ * @param[IN]   p_ctx         consumer context
+ * @param[OUT]  p_bytes       bytes received
+ * @param[IN]   wait_option   wait for data
+ * @retval      NX_SUCCESS on successful operation, NX_NO_PACKET on timeout, otherwise the NetX error
+ **********************************************************************************************************************/
+UINT nx_stream_tcp_receive(NX_TCP_SOCKET * p_socket, nx_stream_sink_t sink, void * p_ctx,
+                           ULONG * p_bytes, ULONG wait_option)
+{
+    UINT        status   = NX_SUCCESS;
+    NX_PACKET * p_packet = NX_NULL;
+
+    *p_bytes = 0U;
+    status   = nx_tcp_socket_receive(p_socket, &p_packet, wait_option);
+    if (NX_SUCCESS != status)
+    {
+        return status;
+    }
+
+    *p_bytes = stream_chain_process(p_packet, sink, p_ctx);
+    nx_packet_release(p_packet);
+    return NX_SUCCESS;
+}
+
+/*******************************************************************************************************************//**
+ * @brief       Receive one datagram from a UDP socket and process it in place, see nx_stream_tcp_receive().
+ * @param[IN]   p_socket      bound UDP socket
+ * @param[IN]   sink          consumer callback, may be NULL to only count the data
+ * @param[IN]   p_ctx         consumer context
+ * @param[OUT]  p_bytes       bytes received
+ * @param[IN]   wait_option   wait for data
+ * @retval      NX_SUCCESS on successful operation, NX_NO_PACKET on timeout, otherwise the NetX error
+ **********************************************************************************************************************/
+UINT nx_stream_udp_receive(NX_UDP_SOCKET * p_socket, nx_stream_sink_t sink, void * p_ctx,
+                           ULONG * p_bytes, ULONG wait_option)
+{
+    UINT        status   = NX_SUCCESS;
+    NX_PACKET * p_packet = NX_NULL;
+
+    *p_bytes = 0U;
+    status   = nx_udp_socket_receive(p_socket, &p_packet, wait_option);
+    if (NX_SUCCESS != status)
+    {
+        return status;
+    }
+
+    *p_bytes = stream_chain_process(p_packet, sink, p_ctx);
+    nx_packet_release(p_packet);
+    return NX_SUCCESS;
+}
+
+/*******************************************************************************************************************//**
+ * @brief       Producer for data held in an application buffer, wrapping around at its end. This is the one copy
+ *              that remains when the data does not originate in the payload.
+ * @param[IN]   p_dest    packet payload
+ * @param[IN]   size      bytes requested
+ * @param[IN]   p_ctx     nx_stream_source_t
+ * @retval      bytes written
+ **********************************************************************************************************************/
+ULONG nx_stream_copy_fill(UCHAR * p_dest, ULONG size, void * p_ctx)
+{
+    nx_stream_source_t * p_src = (nx_stream_source_t *) p_ctx;
+    ULONG                done  = 0U;
+    ULONG                chunk = 0U;
+
+    while (done < size)
+    {
+        chunk = p_src->size - p_src->offset;
+        if (chunk > (size - done))
+        {
+            chunk = size - done;
+        }
+        memcpy(p_dest + done, p_src->p_data + p_src->offset, chunk);
+        done          += chunk;
+        p_src->offset += chunk;
+        if (p_src->offset == p_src->size)
+        {
+            p_src->offset = 0U;
+        }
+    }
+
+    return done;
+}
+
+/*******************************************************************************************************************//**
+ * @brief       Let the producer write into a freshly allocated packet and account for the payload.
+ * @param[IN]   p_packet  packet with headroom reserved by nx_packet_allocate
+ * @param[IN]   limit     bytes wanted in this packet
+ * @param[IN]   fill      producer callback
+ * @param[IN]   p_ctx     producer context
+ * @param[OUT]  p_filled  bytes written
+ * @retval      NX_SUCCESS, NX_NO_MORE_ENTRIES if the producer ended the stream
+ **********************************************************************************************************************/
+static UINT stream_packet_fill(NX_PACKET * p_packet, ULONG limit, nx_stream_fill_t fill, void * p_ctx,
+                               ULONG * p_filled)
+{
+    ULONG room = (ULONG) (p_packet->nx_packet_data_end - p_packet->nx_packet_append_ptr);
+
+    if (limit > room)
+    {
+        limit = room;
+    }
+
+    *p_filled = fill(p_packet->nx_packet_append_ptr, limit, p_ctx);
+    if (0U == *p_filled)
+    {
+        return NX_NO_MORE_ENTRIES;
+    }
+
+    p_packet->nx_packet_append_ptr += *p_filled;
+    p_packet->nx_packet_length     += *p_filled;
+    return NX_SUCCESS;
+}
+
+/*******************************************************************************************************************//**
+ * @brief       Walk a received packet chain and pass each buffer to the sink.
+ * @param[IN]   p_packet  head of the chain
+ * @param[IN]   sink      consumer callback or NULL
+ * @param[IN]   p_ctx     consumer context
+ * @retval      total payload bytes
+ **********************************************************************************************************************/
+static ULONG stream_chain_process(NX_PACKET * p_packet, nx_stream_sink_t sink, void * p_ctx)
+{
+    if (NX_NULL != sink)
+    {
+#ifndef NX_DISABLE_PACKET_CHAIN
+        for (NX_PACKET * p_buf = p_packet; NX_NULL != p_buf; p_buf = p_buf->nx_packet_next)
+        {
+            sink(p_buf->nx_packet_prepend_ptr, (ULONG) (p_buf->nx_packet_append_ptr - p_buf->nx_packet_prepend_ptr),
+                 p_ctx);
+        }
+#else
+        sink(p_packet->nx_packet_prepend_ptr, p_packet->nx_packet_length, p_ctx);
+#endif
+    }
+
+    return p_packet->nx_packet_length;
+}
+
+/*******************************************************************************************************************//**
+ * @} (end addtogroup nx_stream)
+ **********************************************************************************************************************/
@@ -0,0 +1,54 @@
+/***********************************************************************************************************************
+ * File Name    : nx_stream.h
+ * Description  : Contains data structures and functions used in nx_stream.c
+ **********************************************************************************************************************/
+
+/*
+* Copyright (c) 2024 Renesas Electronics Corporation and/or its affiliates
+*
+* SPDX-License-Identifier: BSD-3-Clause
+*/
+
+#ifndef NX_STREAM_H_
+#define NX_STREAM_H_
+
+#include "nx_api.h"
+
+/*******************************************************************************************************************//**
+ * @addtogroup nx_stream
+ * @{
+ **********************************************************************************************************************/
+
+/* Largest UDP payload that is not fragmented on a 1500 byte MTU */
+#define NX_STREAM_UDP_PAYLOAD_MAX   (1472U)
+
+/** Producer callback. Writes up to size bytes straight into the packet payload at p_dest.
+ *  Returns the number of bytes written, 0 ends the send. */
+typedef ULONG (* nx_stream_fill_t)(UCHAR * p_dest, ULONG size, void * p_ctx);
+
+/** Consumer callback. Called once per packet of a received chain, with the payload left in the pool buffer. */
+typedef void (* nx_stream_sink_t)(UCHAR const * p_data, ULONG size, void * p_ctx);
+
+/** Cyclic source for nx_stream_copy_fill, for data that already lives in an application buffer */
+typedef struct st_nx_stream_source
+{
+    UCHAR const * p_data;
+    ULONG         size;
+    ULONG         offset;
+} nx_stream_source_t;
+
+UINT  nx_stream_tcp_send(NX_TCP_SOCKET * p_socket, NX_PACKET_POOL * p_pool, ULONG size,
+                         nx_stream_fill_t fill, void * p_ctx, ULONG wait_option);
+UINT  nx_stream_udp_send(NX_UDP_SOCKET * p_socket, NX_PACKET_POOL * p_pool, ULONG ip_address, UINT port,
+                         ULONG size, nx_stream_fill_t fill, void * p_ctx, ULONG wait_option);
+UINT  nx_stream_tcp_receive(NX_TCP_SOCKET * p_socket, nx_stream_sink_t sink, void * p_ctx,
+                            ULONG * p_bytes, ULONG wait_option);
+UINT  nx_stream_udp_receive(NX_UDP_SOCKET * p_socket, nx_stream_sink_t sink, void * p_ctx,
+                            ULONG * p_bytes, ULONG wait_option);
+ULONG nx_stream_copy_fill(UCHAR * p_dest, ULONG size, void * p_ctx);
+
+/*******************************************************************************************************************//**
+ * @} (end addtogroup nx_stream)
+ **********************************************************************************************************************/
+
+#endif /* NX_STREAM_H_ */
@@ -0,0 +1,102 @@
+/***********************************************************************************************************************
+ * File Name    : iperf_host.c
+ * Description  : Command line front end for running the firmware iperf engine on a host.
+ *
+ *   gcc -O2 -pthread -I../e2studio_llvm/src ../e2studio_llvm/src/iperf.c iperf_port_posix.c iperf_host.c -o iperf_host
+ *
+ *   ./iperf_host -s [-u] [-3] [-p port] [-n sessions]
+ *   ./iperf_host -c ip [-u] [-3] [-p port] [-P streams] [-t sec] [-i sec] [-b kbit/s] [-l len]
+ **********************************************************************************************************************/
+
+/*
+* Copyright (c) 2024 Renesas Electronics Corporation and/or its affiliates
+*
+* SPDX-License-Identifier: BSD-3-Clause
+*/
+
+#include <arpa/inet.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include "iperf.h"
+
+static void host_report(iperf_report_t const * p_report)
+{
+    char line[160];
+
+    iperf_report_format(p_report, line, sizeof(line));
+    printf("%s\n", line);
+    fflush(stdout);
+}
+
+int main(int argc, char * argv[])
+{
+    iperf_cfg_t     cfg;
+    iperf_mode_t    mode     = IPERF_MODE_SERVER;
+    iperf_proto_t   proto    = IPERF_PROTO_TCP;
+    iperf_version_t version  = IPERF_VERSION_2;
+    char const    * p_server = NULL;
+    long            port     = -1;
+    long            streams  = 1;
+    long            duration = 10;
+    long            interval = 1;
+    long            kbps     = -1;
+    long            len      = -1;
+    long            sessions = 1;
+    int             opt      = 0;
+    int32_t         err      = IPERF_OK;
+
+    while (-1 != (opt = getopt(argc, argv, "sc:u3p:P:t:i:b:l:n:")))
+    {
+        switch (opt)
+        {
+            case 's': mode = IPERF_MODE_SERVER; break;
+            case 'c': mode = IPERF_MODE_CLIENT; p_server = optarg; break;
+            case 'u': proto = IPERF_PROTO_UDP; break;
+            case '3': version = IPERF_VERSION_3; break;
+            case 'p': port = strtol(optarg, NULL, 0); break;
+            case 'P': streams = strtol(optarg, NULL, 0); break;
+            case 't': duration = strtol(optarg, NULL, 0); break;
+            case 'i': interval = strtol(optarg, NULL, 0); break;
+            case 'b': kbps = strtol(optarg, NULL, 0); break;
+            case 'l': len = strtol(optarg, NULL, 0); break;
+            case 'n': sessions = strtol(optarg, NULL, 0); break;
+            default:
+                fprintf(stderr, "usage: %s -s | -c ip [-u] [-3] [-p port] [-P n] [-t s] [-i s] [-b kbit/s] [-l len] "
+                                "[-n sessions]\n", argv[0]);
+                return 2;
+        }
+    }
+
+    iperf_cfg_init(&cfg, mode, proto, version);
+    if (NULL != p_server)
+    {
+        struct in_addr addr;
+
+        if (0 == inet_aton(p_server, &addr))
+        {
+            fprintf(stderr, "bad address %s\n", p_server);
+            return 2;
+        }
+        cfg.server_ip = ntohl(addr.s_addr);
+    }
+    cfg.port        = (port > 0) ? (uint16_t) port : cfg.port;
+    cfg.streams     = (uint32_t) streams;
+    cfg.duration_ms = (uint32_t) duration * 1000U;
+    cfg.interval_ms = (uint32_t) interval * 1000U;
+    cfg.udp_kbps    = (kbps > 0) ? (uint32_t) kbps : cfg.udp_kbps;
+    cfg.len         = (len > 0) ? (uint32_t) len : cfg.len;
+
+    for (long i = 0; (0 == sessions) || (i < sessions); i++)
+    {
+        err = iperf_run(&cfg, host_report);
+        if (IPERF_OK != err)
+        {
+            fprintf(stderr, "iperf_run failed: %d\n", (int) err);
+            break;
+        }
+    }
+
+    return (IPERF_OK == err) ? 0 : 1;
+}
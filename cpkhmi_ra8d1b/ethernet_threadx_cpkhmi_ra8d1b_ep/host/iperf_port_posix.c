@@ -0,0 +1,301 @@
+/***********************************************************************************************************************
+ * File Name    : iperf_port_posix.c
+ * Description  : iperf port on BSD sockets and pthreads, for running iperf.c on a host against loopback or a TAP
+ *                interface.
+ **********************************************************************************************************************/
+
+/*
+* Copyright (c) 2024 Renesas Electronics Corporation and/or its affiliates
+*
+* SPDX-License-Identifier: BSD-3-Clause
+*/
+
+#define _DEFAULT_SOURCE
+#include <arpa/inet.h>
+#include <errno.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <poll.h>
+#include <pthread.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/resource.h>
+#include <sys/socket.h>
+#include <time.h>
+#include <unistd.h>
+#include "iperf.h"
+#include "iperf_port.h"
+
+struct st_iperf_sock
+{
+    int fd;
+};
+
+typedef struct st_posix_slot
+{
+    pthread_t thread;
+    void   (* p_entry)(void * p_arg);
+    void    * p_arg;
+} posix_slot_t;
+
+static posix_slot_t g_slots[IPERF_MAX_STREAMS];
+static uint64_t     g_cpu_wall_us;
+static uint64_t     g_cpu_used_us;
+
+static iperf_sock_t * posix_sock_new(int fd)
+{
+    iperf_sock_t * p_sock = NULL;
+
+    if (fd < 0)
+    {
+        return NULL;
+    }
+    p_sock = malloc(sizeof(*p_sock));
+    if (NULL == p_sock)
+    {
+        close(fd);
+        return NULL;
+    }
+    p_sock->fd = fd;
+
+    return p_sock;
+}
+
+static int posix_wait(int fd, short events, uint32_t timeout_ms)
+{
+    struct pollfd pfd = {.fd = fd, .events = events, .revents = 0};
+
+    return poll(&pfd, 1, (0xFFFFFFFFU == timeout_ms) ? -1 : (int) timeout_ms);
+}
+
+static void posix_addr(struct sockaddr_in * p_addr, uint32_t ip, uint16_t port)
+{
+    memset(p_addr, 0, sizeof(*p_addr));
+    p_addr->sin_family      = AF_INET;
+    p_addr->sin_port        = htons(port);
+    p_addr->sin_addr.s_addr = htonl(ip);
+}
+
+static uint64_t posix_time_us(void)
+{
+    struct timespec ts;
+
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ((uint64_t) ts.tv_sec * 1000000U) + ((uint64_t) ts.tv_nsec / 1000U);
+}
+
+static uint64_t posix_cpu_us(void)
+{
+    struct rusage ru;
+
+    getrusage(RUSAGE_SELF, &ru);
+    return ((uint64_t) (ru.ru_utime.tv_sec + ru.ru_stime.tv_sec) * 1000000U) +
+           (uint64_t) (ru.ru_utime.tv_usec + ru.ru_stime.tv_usec);
+}
+
+iperf_sock_t * iperf_port_tcp_listen(uint16_t port)
+{
+    struct sockaddr_in addr;
+    int                one = 1;
+    int                fd  = socket(AF_INET, SOCK_STREAM, 0);
+
+    if (fd < 0)
+    {
+        return NULL;
+    }
+    setsockopt(fd, SOL_SOCKET, SO_REUSEADDR, &one, sizeof(one));
+    posix_addr(&addr, INADDR_ANY, port);
+    if ((0 != bind(fd, (struct sockaddr *) &addr, sizeof(addr))) || (0 != listen(fd, IPERF_MAX_STREAMS + 1)))
+    {
+        close(fd);
+        return NULL;
+    }
+
+    return posix_sock_new(fd);
+}
+
+iperf_sock_t * iperf_port_tcp_accept(iperf_sock_t * p_listener, uint32_t timeout_ms)
+{
+    int one = 1;
+    int fd  = -1;
+
+    if (posix_wait(p_listener->fd, POLLIN, timeout_ms) <= 0)
+    {
+        return NULL;
+    }
+    fd = accept(p_listener->fd, NULL, NULL);
+    if (fd >= 0)
+    {
+        setsockopt(fd, IPPROTO_TCP, TCP_NODELAY, &one, sizeof(one));
+    }
+
+    return posix_sock_new(fd);
+}
+
+iperf_sock_t * iperf_port_tcp_connect(uint32_t ip, uint16_t port, uint32_t timeout_ms)
+{
+    struct sockaddr_in addr;
+    struct timeval     tv = {.tv_sec = (time_t) (timeout_ms / 1000U), .tv_usec = 0};
+    int                one = 1;
+    int                fd  = socket(AF_INET, SOCK_STREAM, 0);
+
+    if (fd < 0)
+    {
+        return NULL;
+    }
+    setsockopt(fd, SOL_SOCKET, SO_SNDTIMEO, &tv, sizeof(tv));
+    setsockopt(fd, IPPROTO_TCP, TCP_NODELAY, &one, sizeof(one));
+    posix_addr(&addr, ip, port);
+    if (0 != connect(fd, (struct sockaddr *) &addr, sizeof(addr)))
+    {
+        close(fd);
+        return NULL;
+    }
+
+    return posix_sock_new(fd);
+}
+
+iperf_sock_t * iperf_port_udp_open(uint16_t port)
+{
+    struct sockaddr_in addr;
+    int                fd = socket(AF_INET, SOCK_DGRAM, 0);
+
+    if (fd < 0)
+    {
+        return NULL;
+    }
+    posix_addr(&addr, INADDR_ANY, port);
+    if (0 != bind(fd, (struct sockaddr *) &addr, sizeof(addr)))
+    {
+        close(fd);
+        return NULL;
+    }
+
+    return posix_sock_new(fd);
+}
+
+int32_t iperf_port_send(iperf_sock_t * p_sock, void const * p_buf, uint32_t size)
+{
+    ssize_t n = 0;
+
+    if (posix_wait(p_sock->fd, POLLOUT, 1000U) <= 0)
+    {
+        return 0;
+    }
+    n = send(p_sock->fd, p_buf, size, MSG_NOSIGNAL);
+
+    return (n < 0) ? (((EAGAIN == errno) || (EINTR == errno)) ? 0 : -1) : (int32_t) n;
+}
+
+int32_t iperf_port_recv(iperf_sock_t * p_sock, void * p_buf, uint32_t size, uint32_t timeout_ms)
+{
+    static __thread uint8_t discard[IPERF_BUF_SIZE];
+    ssize_t                 n = 0;
+
+    if (posix_wait(p_sock->fd, POLLIN, timeout_ms) <= 0)
+    {
+        return 0;
+    }
+    if (NULL == p_buf)
+    {
+        p_buf = discard;
+        size  = (size > sizeof(discard)) ? sizeof(discard) : size;
+    }
+    n = recv(p_sock->fd, p_buf, size, 0);
+
+    return (n <= 0) ? -1 : (int32_t) n;
+}
+
+int32_t iperf_port_sendto(iperf_sock_t * p_sock, uint32_t ip, uint16_t port, void const * p_buf, uint32_t size)
+{
+    struct sockaddr_in addr;
+    ssize_t            n = 0;
+
+    posix_addr(&addr, ip, port);
+    n = sendto(p_sock->fd, p_buf, size, 0, (struct sockaddr *) &addr, sizeof(addr));
+
+    /* ENOBUFS / ECONNREFUSED are transient for a paced UDP sender */
+    return (n < 0) ? 0 : (int32_t) n;
+}
+
+int32_t iperf_port_recvfrom(iperf_sock_t * p_sock, void * p_buf, uint32_t size, uint32_t * p_ip,
+                            uint16_t * p_port, uint32_t timeout_ms)
+{
+    struct sockaddr_in addr;
+    socklen_t          len = sizeof(addr);
+    ssize_t            n   = 0;
+
+    if (posix_wait(p_sock->fd, POLLIN, timeout_ms) <= 0)
+    {
+        return 0;
+    }
+    n = recvfrom(p_sock->fd, p_buf, size, 0, (struct sockaddr *) &addr, &len);
+    if (n < 0)
+    {
+        return (ECONNREFUSED == errno) ? 0 : -1;
+    }
+    *p_ip   = ntohl(addr.sin_addr.s_addr);
+    *p_port = ntohs(addr.sin_port);
+
+    return (int32_t) n;
+}
+
+void iperf_port_close(iperf_sock_t * p_sock)
+{
+    close(p_sock->fd);
+    free(p_sock);
+}
+
+uint32_t iperf_port_time_ms(void)
+{
+    return (uint32_t) (posix_time_us() / 1000U);
+}
+
+void iperf_port_sleep_ms(uint32_t ms)
+{
+    usleep(ms * 1000U);
+}
+
+static void * posix_thread_entry(void * p_arg)
+{
+    posix_slot_t * p_slot = (posix_slot_t *) p_arg;
+
+    p_slot->p_entry(p_slot->p_arg);
+    return NULL;
+}
+
+int32_t iperf_port_thread_start(uint32_t slot, void (* p_entry)(void * p_arg), void * p_arg)
+{
+    g_slots[slot].p_entry = p_entry;
+    g_slots[slot].p_arg   = p_arg;
+
+    return (0 == pthread_create(&g_slots[slot].thread, NULL, posix_thread_entry, &g_slots[slot])) ? 0 : -1;
+}
+
+void iperf_port_thread_join(uint32_t slot)
+{
+    pthread_join(g_slots[slot].thread, NULL);
+}
+
+/* Process CPU time over wall time, 100 % is one core */
+void iperf_port_cpu_start(void)
+{
+    g_cpu_wall_us = posix_time_us();
+    g_cpu_used_us = posix_cpu_us();
+}
+
+uint32_t iperf_port_cpu_load(void)
+{
+    uint64_t wall = posix_time_us();
+    uint64_t used = posix_cpu_us();
+    uint64_t load = (wall > g_cpu_wall_us) ? ((used - g_cpu_used_us) * 100U) / (wall - g_cpu_wall_us) : 0U;
+
+    g_cpu_wall_us = wall;
+    g_cpu_used_us = used;
+
+    return (load > 100U) ? 100U : (uint32_t) load;
+}
+
+void iperf_port_cpu_stop(void)
+{
+}
@@ -7,6 +7,7 @@
 #include "lvgl.h"
 #include "port/lv_port_disp.h"
 #include "port/lv_port_indev.h"
+#include "port/lv_port_fs_ospi.h"
 #include "lvgl/demos/lv_demos.h"
 #include "board_sdram.h"
 //#include "renesas_logo.c"
@@ -97,6 +98,11 @@ void hal_entry(void)
 
     lv_port_indev_init();
 
+#if LV_USE_FS_OSPI
+    /* 图片/字体资源直接从 OSPI 映射地址读取, OSPI 需先配置为内存映射模式 */
+    lv_port_fs_ospi_init();
+#endif
+
     uint16_t * p_fb = (uint16_t *)&fb_foreground[0][0];
 
 
@@ -38,8 +38,15 @@ typedef struct {
     uint32_t render_avg_time;
     uint32_t flush_avg_time;
     uint32_t measurement_cnt;
+    lv_demo_benchmark_result_t result;
 } scene_dsc_t;
 
+typedef struct {
+    lv_draw_unit_t base_unit;
+    uint32_t task_cnt;
+    uint32_t layer_mem_max_kb;
+} task_counter_unit_t;
+
 /**********************
  *  STATIC PROTOTYPES
  **********************/
@@ -53,6 +60,12 @@ static void next_scene_timer_cb(lv_timer_t * timer);
 
 static void summary_create(void);
 
+static uint32_t virtual_tick_cb(void);
+static void render_time_event_cb(lv_event_t * e);
+static int32_t task_counter_evaluate(lv_draw_unit_t * draw_unit, lv_draw_task_t * task);
+static int32_t task_counter_dispatch(lv_draw_unit_t * draw_unit, lv_layer_t * layer);
+static int32_t task_counter_delete(lv_draw_unit_t * draw_unit);
+
 static void rnd_reset(void);
 static int32_t rnd_next(int32_t min, int32_t max);
 static void shake_anim_y_cb(void * var, int32_t v);
@@ -393,6 +406,13 @@ static scene_dsc_t scenes[] = {
 static uint32_t scene_act;
 static uint32_t rnd_act;
 
+static uint32_t headless_frame_cnt;
+static uint32_t headless_frame_period;
+static uint32_t virtual_tick;
+static uint32_t (*headless_time_cb)(void);
+static uint32_t render_start_time;
+static task_counter_unit_t * task_counter;
+
 /**********************
  *      MACROS
  **********************/
@@ -431,6 +451,120 @@ void lv_demo_benchmark(void)
 #endif
 }
 
+void lv_demo_benchmark_run_headless(uint32_t frame_cnt, uint32_t frame_period, uint32_t (*time_cb)(void))
+{
+    lv_display_t * disp = lv_display_get_default();
+    if(disp == NULL) {
+        LV_LOG_WARN("No display registered");
+        return;
+    }
+
+    /*Count the draw tasks with a draw unit which only evaluates them*/
+    task_counter = lv_draw_create_unit(sizeof(task_counter_unit_t));
+    task_counter->base_unit.evaluate_cb = task_counter_evaluate;
+    task_counter->base_unit.dispatch_cb = task_counter_dispatch;
+    task_counter->base_unit.delete_cb = task_counter_delete;
+
+    headless_frame_cnt = frame_cnt;
+    headless_frame_period = frame_period;
+    headless_time_cb = time_cb;
+
+    /*Drive the timers and animations from a virtual tick*/
+    lv_tick_get_cb_t tick_cb_ori = LV_GLOBAL_DEFAULT()->tick_state.tick_get_cb;
+    uint32_t tick_start = lv_tick_get();
+    virtual_tick = tick_start;
+    lv_tick_set_cb(virtual_tick_cb);
+
+    lv_display_add_event_cb(disp, render_time_event_cb, LV_EVENT_ALL, NULL);
+
+    lv_obj_t * scr = lv_screen_active();
+    lv_obj_remove_style_all(scr);
+    lv_obj_set_style_bg_opa(scr, LV_OPA_COVER, 0);
+
+    for(scene_act = 0; scenes[scene_act].create_cb; scene_act++) {
+        lv_demo_benchmark_result_t * res = &scenes[scene_act].result;
+        lv_memzero(res, sizeof(lv_demo_benchmark_result_t));
+        res->name = scenes[scene_act].name;
+
+        load_scene(scene_act);
+
+        uint32_t task_cnt_start = task_counter->task_cnt;
+        task_counter->layer_mem_max_kb = 0;
+
+        uint32_t i;
+        for(i = 0; i < frame_cnt; i++) {
+            virtual_tick += frame_period;
+            uint32_t t = time_cb ? time_cb() : 0;
+            lv_timer_handler();
+            /*Render the frame even if the refresh period is longer than the frame period*/
+            lv_refr_now(disp);
+            if(time_cb) res->frame_time_us += time_cb() - t;
+            res->frame_cnt++;
+
+            lv_mem_monitor_t mon;
+            lv_mem_monitor(&mon);
+            if(mon.total_size) res->mem_max_used = LV_MAX(res->mem_max_used, mon.total_size - mon.free_size);
+        }
+
+        res->draw_task_cnt = task_counter->task_cnt - task_cnt_start;
+        res->layer_mem_max_kb = task_counter->layer_mem_max_kb;
+    }
+
+    /*Clean up with the closing empty scene*/
+    load_scene(scene_act);
+    lv_obj_invalidate(scr);
+
+    lv_display_remove_event_cb_with_user_data(disp, render_time_event_cb, NULL);
+    lv_draw_delete_unit(&task_counter->base_unit);
+
+    lv_tick_set_cb(tick_cb_ori);
+    /*Let the tick counted by `lv_tick_inc` continue from the virtual tick*/
+    if(tick_cb_ori == NULL) lv_tick_inc(virtual_tick - tick_start);
+}
+
+const lv_demo_benchmark_result_t * lv_demo_benchmark_get_result(uint32_t scene)
+{
+    uint32_t i;
+    for(i = 0; i < scene; i++) {
+        if(scenes[i].create_cb == NULL) return NULL;
+    }
+
+    if(scenes[scene].create_cb == NULL) return NULL;
+    return &scenes[scene].result;
+}
+
+uint32_t lv_demo_benchmark_get_json(char * buf, uint32_t buf_size)
+{
+    uint32_t len = 0;
+    int32_t ret;
+
+    ret = lv_snprintf(buf, buf_size, "{\n  \"lvgl\": \"%d.%d.%d\",\n  \"frame_cnt\": %" LV_PRIu32
+                      ",\n  \"frame_period\": %" LV_PRIu32 ",\n  \"scenes\": [\n",
+                      LVGL_VERSION_MAJOR, LVGL_VERSION_MINOR, LVGL_VERSION_PATCH,
+                      headless_frame_cnt, headless_frame_period);
+    if(ret < 0 || (uint32_t)ret >= buf_size) return 0;
+    len += ret;
+
+    uint32_t i;
+    for(i = 0; scenes[i].create_cb; i++) {
+        const lv_demo_benchmark_result_t * res = &scenes[i].result;
+        ret = lv_snprintf(buf + len, buf_size - len,
+                          "    {\"name\": \"%s\", \"frame_cnt\": %" LV_PRIu32 ", \"render_time_us\": %" LV_PRIu32
+                          ", \"frame_time_us\": %" LV_PRIu32 ", \"draw_task_cnt\": %" LV_PRIu32
+                          ", \"layer_mem_max_kb\": %" LV_PRIu32 ", \"mem_max_used\": %" LV_PRIu32 "}%s\n",
+                          scenes[i].name, res->frame_cnt, res->render_time_us, res->frame_time_us, res->draw_task_cnt,
+                          res->layer_mem_max_kb, res->mem_max_used, scenes[i + 1].create_cb ? "," : "");
+        if(ret < 0 || (uint32_t)ret >= buf_size - len) return 0;
+        len += ret;
+    }
+
+    ret = lv_snprintf(buf + len, buf_size - len, "  ]\n}\n");
+    if(ret < 0 || (uint32_t)ret >= buf_size - len) return 0;
+    len += ret;
+
+    return len;
+}
+
 /**********************
  *   STATIC FUNCTIONS
  **********************/
@@ -455,6 +589,7 @@ static void load_scene(uint32_t scene)
     lv_obj_set_style_bg_opa(lv_layer_top(), LV_OPA_TRANSP, 0);
 
     rnd_reset();
+    lv_rand_set_seed(0x1234ABCD);
     if(scenes[scene].create_cb) scenes[scene].create_cb();
 }
 
@@ -641,6 +776,54 @@ static void summary_create(void)
     }
 }
 
+/*----------------
+ * HEADLESS RUN
+ *----------------*/
+
+static uint32_t virtual_tick_cb(void)
+{
+    return virtual_tick;
+}
+
+static void render_time_event_cb(lv_event_t * e)
+{
+    if(headless_time_cb == NULL) return;
+
+    lv_event_code_t code = lv_event_get_code(e);
+    if(code == LV_EVENT_RENDER_START) {
+        render_start_time = headless_time_cb();
+    }
+    else if(code == LV_EVENT_RENDER_READY) {
+        scenes[scene_act].result.render_time_us += headless_time_cb() - render_start_time;
+    }
+}
+
+static int32_t task_counter_evaluate(lv_draw_unit_t * draw_unit, lv_draw_task_t * task)
+{
+    LV_UNUSED(task);
+    task_counter_unit_t * u = (task_counter_unit_t *)draw_unit;
+    u->task_cnt++;
+    return 0;
+}
+
+static int32_t task_counter_dispatch(lv_draw_unit_t * draw_unit, lv_layer_t * layer)
+{
+    LV_UNUSED(layer);
+    /*The layers are allocated while they are dispatched*/
+    task_counter_unit_t * u = (task_counter_unit_t *)draw_unit;
+    u->layer_mem_max_kb = LV_MAX(u->layer_mem_max_kb, LV_GLOBAL_DEFAULT()->draw_info.used_memory_for_layers_kb);
+
+    /*Never take a task*/
+    return -1;
+}
+
+static int32_t task_counter_delete(lv_draw_unit_t * draw_unit)
+{
+    LV_UNUSED(draw_unit);
+    task_counter = NULL;
+    return 0;
+}
+
 /*----------------
  * SCENE HELPERS
  *----------------*/
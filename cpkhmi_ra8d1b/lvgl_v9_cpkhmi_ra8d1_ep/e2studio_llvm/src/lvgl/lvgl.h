@@ -24,6 +24,7 @@ extern "C" {
 #include "src/lv_init.h"
 
 #include "src/stdlib/lv_mem.h"
+#include "src/stdlib/lv_mem_slab.h"
 #include "src/stdlib/lv_string.h"
 #include "src/stdlib/lv_sprintf.h"
 
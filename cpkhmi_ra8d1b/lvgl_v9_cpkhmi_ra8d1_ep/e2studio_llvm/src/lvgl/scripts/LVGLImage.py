@@ -356,31 +356,66 @@ class LVGLCompressData:
     def __init__(self,
                  cf: ColorFormat,
                  method: CompressMethod,
-                 raw_data: bytes = b''):
+                 raw_data: bytes = b'',
+                 stride: int = 0,
+                 band_rows: int = 0):
         self.blk_size = (cf.bpp + 7) // 8
         self.compress = method
         self.raw_data = raw_data
         self.raw_data_len = len(raw_data)
+        self.band_rows = band_rows if method != CompressMethod.NONE else 0
+        if self.band_rows:
+            # bands are streamed by the decoder, only formats it can draw
+            # line by line are supported
+            if cf not in (ColorFormat.ARGB8888, ColorFormat.XRGB8888,
+                          ColorFormat.RGB888, ColorFormat.RGB565):
+                raise ParameterError(f"Banded compression not supported "
+                                     f"for {cf.name}")
+            if not 0 < self.band_rows < 4096 or stride <= 0:
+                raise ParameterError(f"Invalid band rows: {band_rows}")
+        self.stride = stride
         self.compressed = self._compress(raw_data)
 
-    def _compress(self, raw_data: bytes) -> bytearray:
-        if self.compress == CompressMethod.NONE:
-            return raw_data
-
+    def _compress_block(self, raw_data: bytes):
         if self.compress == CompressMethod.RLE:
             # RLE compression performs on pixel unit, pad data to pixel unit
-            pad = b'\x00' * (self.blk_size - self.raw_data_len % self.blk_size)
-            self.raw_data_len += len(pad)
-            compressed = RLEImage().rle_compress(raw_data + pad, self.blk_size)
+            pad = b'\x00' * (self.blk_size - len(raw_data) % self.blk_size)
+            return RLEImage().rle_compress(raw_data + pad, self.blk_size), len(pad)
         elif self.compress == CompressMethod.LZ4:
-            compressed = lz4.block.compress(raw_data, store_size=False)
+            return lz4.block.compress(raw_data, store_size=False), 0
         else:
             raise ParameterError(f"Invalid compress method: {self.compress}")
 
+    def _compress_bands(self, raw_data: bytes) -> bytearray:
+        # offset table of all bands and the end, then the bands, each
+        # compressed on its own so they can be decompressed in any order
+        band_size = self.band_rows * self.stride
+        bands = [
+            self._compress_block(raw_data[i:i + band_size])[0]
+            for i in range(0, len(raw_data), band_size)
+        ]
+        offset = (len(bands) + 1) * 4
+        table = bytearray()
+        for band in bands:
+            table += uint32_t(offset)
+            offset += len(band)
+        table += uint32_t(offset)
+        return table + b''.join(bands)
+
+    def _compress(self, raw_data: bytes) -> bytearray:
+        if self.compress == CompressMethod.NONE:
+            return raw_data
+
+        if self.band_rows:
+            compressed = self._compress_bands(raw_data)
+        else:
+            compressed, pad = self._compress_block(raw_data)
+            self.raw_data_len += pad
+
         self.compressed_len = len(compressed)
 
         bin = bytearray()
-        bin += uint32_t(self.compress.value)
+        bin += uint32_t(self.compress.value | (self.band_rows << 4))
         bin += uint32_t(self.compressed_len)
         bin += uint32_t(self.raw_data_len)
         bin += compressed
@@ -547,7 +582,8 @@ class LVGLImage:
 
     def to_bin(self,
                filename: str,
-               compress: CompressMethod = CompressMethod.NONE):
+               compress: CompressMethod = CompressMethod.NONE,
+               band_rows: int = 0):
         """
         Write this image to file, filename should be ended with '.bin'
         """
@@ -565,7 +601,8 @@ class LVGLImage:
                                      self.stride,
                                      flags=flags)
             bin += header.binary
-            compressed = LVGLCompressData(self.cf, compress, self.data)
+            compressed = LVGLCompressData(self.cf, compress, self.data,
+                                          self.stride, band_rows)
             bin += compressed.compressed
 
             f.write(bin)
@@ -574,7 +611,8 @@ class LVGLImage:
 
     def to_c_array(self,
                    filename: str,
-                   compress: CompressMethod = CompressMethod.NONE):
+                   compress: CompressMethod = CompressMethod.NONE,
+                   band_rows: int = 0):
         self._check_ext(filename, ".c")
         self._check_dir(filename)
 
@@ -586,7 +624,8 @@ class LVGLImage:
         if compress is not CompressMethod.NONE:
             flags += " | LV_IMAGE_FLAGS_COMPRESSED"
 
-        compressed = LVGLCompressData(self.cf, compress, self.data)
+        compressed = LVGLCompressData(self.cf, compress, self.data,
+                                      self.stride, band_rows)
 
         header = f'''
 #if defined(LV_LVGL_H_INCLUDE_SIMPLE)
@@ -1013,6 +1052,7 @@ class PNGConverter:
                  background: int = 0x00,
                  align: int = 1,
                  compress: CompressMethod = CompressMethod.NONE,
+                 band_rows: int = 0,
                  keep_folder=True) -> None:
         self.files = files
         self.cf = cf
@@ -1022,6 +1062,7 @@ class PNGConverter:
         self.keep_folder = keep_folder
         self.align = align
         self.compress = compress
+        self.band_rows = band_rows
         self.background = background
 
     def _replace_ext(self, input, ext):
@@ -1041,10 +1082,12 @@ class PNGConverter:
             output.append((f, img))
             if self.ofmt == OutputFormat.BIN_FILE:
                 img.to_bin(self._replace_ext(f, ".bin"),
-                           compress=self.compress)
+                           compress=self.compress,
+                           band_rows=self.band_rows)
             elif self.ofmt == OutputFormat.C_ARRAY:
                 img.to_c_array(self._replace_ext(f, ".c"),
-                               compress=self.compress)
+                               compress=self.compress,
+                               band_rows=self.band_rows)
             elif self.ofmt == OutputFormat.PNG_FILE:
                 img.to_png(self._replace_ext(f, ".png"))
 
@@ -1073,6 +1116,14 @@ def main():
                         default="NONE",
                         choices=["NONE", "RLE", "LZ4"])
 
+    parser.add_argument('--band-rows',
+                        help=("compress in bands of this many lines, which "
+                              "the decoder streams instead of decompressing "
+                              "the whole image, default to 0 (one band)"),
+                        default=0,
+                        type=int,
+                        metavar='rows')
+
     parser.add_argument('--align',
                         help="stride alignment in bytes for bin image",
                         default=1,
@@ -1122,6 +1173,7 @@ def main():
                              background=args.background,
                              align=args.align,
                              compress=compress,
+                             band_rows=args.band_rows,
                              keep_folder=False)
     output = converter.convert()
     for f, img in output:
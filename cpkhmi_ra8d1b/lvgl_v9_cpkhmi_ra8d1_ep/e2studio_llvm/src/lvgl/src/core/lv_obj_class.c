@@ -11,11 +11,14 @@
 #include "../display/lv_display.h"
 #include "../display/lv_display_private.h"
 #include "../stdlib/lv_string.h"
+#include "../core/lv_global.h"
 
 /*********************
  *      DEFINES
  *********************/
 #define MY_CLASS &lv_obj_class
+#define obj_slab_p &(LV_GLOBAL_DEFAULT()->obj_slab)
+#define obj_large_slab_p &(LV_GLOBAL_DEFAULT()->obj_large_slab)
 
 /**********************
  *      TYPEDEFS
@@ -30,6 +33,7 @@
  **********************/
 static void lv_obj_construct(const lv_obj_class_t * class_p, lv_obj_t * obj);
 static uint32_t get_instance_size(const lv_obj_class_t * class_p);
+static lv_mem_slab_t * get_obj_slab(uint32_t instance_size);
 
 /**********************
  *  STATIC VARIABLES
@@ -47,8 +51,10 @@ lv_obj_t * lv_obj_class_create_obj(const lv_obj_class_t * class_p, lv_obj_t * pa
 {
     LV_TRACE_OBJ_CREATE("Creating object with %p class on %p parent", (void *)class_p, (void *)parent);
     uint32_t s = get_instance_size(class_p);
-    lv_obj_t * obj = lv_malloc_zeroed(s);
+    lv_mem_slab_t * slab = get_obj_slab(s);
+    lv_obj_t * obj = lv_mem_slab_alloc_zeroed(slab, s);
     if(obj == NULL) return NULL;
+    obj->large_slab = slab == obj_large_slab_p;
     obj->class_p = class_p;
     obj->parent = parent;
 
@@ -58,7 +64,7 @@ lv_obj_t * lv_obj_class_create_obj(const lv_obj_class_t * class_p, lv_obj_t * pa
         lv_display_t * disp = lv_display_get_default();
         if(!disp) {
             LV_LOG_WARN("No display created yet. No place to assign the new screen");
-            lv_free(obj);
+            _lv_obj_free(obj);
             return NULL;
         }
 
@@ -136,6 +142,11 @@ void _lv_obj_destruct(lv_obj_t * obj)
     }
 }
 
+void _lv_obj_free(lv_obj_t * obj)
+{
+    lv_mem_slab_free(obj->large_slab ? obj_large_slab_p : obj_slab_p, obj);
+}
+
 bool lv_obj_is_editable(lv_obj_t * obj)
 {
     const lv_obj_class_t * class_p = obj->class_p;
@@ -192,3 +203,10 @@ static uint32_t get_instance_size(const lv_obj_class_t * class_p)
 
     return base->instance_size;
 }
+
+static lv_mem_slab_t * get_obj_slab(uint32_t instance_size)
+{
+    lv_mem_slab_t * obj_slab = obj_slab_p;
+    if(instance_size <= obj_slab->block_size) return obj_slab;
+    else return obj_large_slab_p;
+}
@@ -91,6 +91,12 @@ void lv_obj_class_init_obj(lv_obj_t * obj);
 
 void _lv_obj_destruct(lv_obj_t * obj);
 
+/**
+ * Free the memory of an object allocated by `lv_obj_class_create_obj()`
+ * @param obj       pointer to an object
+ */
+void _lv_obj_free(lv_obj_t * obj);
+
 bool lv_obj_is_editable(lv_obj_t * obj);
 
 bool lv_obj_is_group_def(lv_obj_t * obj);
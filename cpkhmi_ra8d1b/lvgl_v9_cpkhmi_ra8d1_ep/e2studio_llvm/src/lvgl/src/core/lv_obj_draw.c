@@ -11,6 +11,7 @@
 #include "../display/lv_display.h"
 #include "../indev/lv_indev.h"
 #include "../stdlib/lv_string.h"
+#include "../misc/cache/lv_image_cache.h"
 
 /*********************
  *      DEFINES
@@ -321,6 +322,29 @@ lv_layer_type_t _lv_obj_get_layer_type(const lv_obj_t * obj)
     else return LV_LAYER_TYPE_NONE;
 }
 
+void _lv_obj_invalidate_bitmap_cache(const lv_obj_t * obj)
+{
+    while(obj) {
+        if(obj->spec_attr) obj->spec_attr->bitmap_cache_valid = 0;
+        obj = obj->parent;
+    }
+}
+
+void _lv_obj_free_bitmap_cache(lv_obj_t * obj)
+{
+    if(obj->spec_attr == NULL || obj->spec_attr->bitmap_cache == NULL) return;
+
+    /*The buffer is drawn as an image so forget it in the image caches too.
+     *A new buffer can be allocated on the same address later.*/
+    lv_draw_buf_t * cache = obj->spec_attr->bitmap_cache;
+    lv_image_cache_drop(cache);
+    lv_image_header_cache_drop(cache);
+    lv_draw_buf_destroy(cache);
+
+    obj->spec_attr->bitmap_cache = NULL;
+    obj->spec_attr->bitmap_cache_valid = 0;
+}
+
 /**********************
  *   STATIC FUNCTIONS
  **********************/
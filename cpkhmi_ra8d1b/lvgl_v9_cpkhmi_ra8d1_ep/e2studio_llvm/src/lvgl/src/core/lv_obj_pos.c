@@ -28,6 +28,8 @@
 static int32_t calc_content_width(lv_obj_t * obj);
 static int32_t calc_content_height(lv_obj_t * obj);
 static void layout_update_core(lv_obj_t * obj);
+static lv_obj_t * mark_ancestors_as_dirty(lv_obj_t * obj);
+static void scrollbar_invalidate_in_layout(lv_obj_t * obj);
 static void transform_point(const lv_obj_t * obj, lv_point_t * p, bool inv);
 
 /**********************
@@ -171,7 +173,7 @@ bool lv_obj_refr_size(lv_obj_t * obj)
     /*If the object is already out of the parent and its position is changes
      *surely the scrollbars also changes so invalidate them*/
     bool on1 = _lv_area_is_in(&ori, &parent_fit_area, 0);
-    if(!on1) lv_obj_scrollbar_invalidate(parent);
+    if(!on1) scrollbar_invalidate_in_layout(parent);
 
     /*Set the length and height
      *Be sure the content is not scrolled in an invalid position on the new size*/
@@ -193,11 +195,12 @@ bool lv_obj_refr_size(lv_obj_t * obj)
     lv_obj_invalidate(obj);
 
     obj->readjust_scroll_after_layout = 1;
+    mark_ancestors_as_dirty(obj);
 
     /*If the object was out of the parent invalidate the new scrollbar area too.
      *If it wasn't out of the parent but out now, also invalidate the scrollbars*/
     bool on2 = _lv_area_is_in(&obj->coords, &parent_fit_area, 0);
-    if(on1 || (!on1 && on2)) lv_obj_scrollbar_invalidate(parent);
+    if(on1 || (!on1 && on2)) scrollbar_invalidate_in_layout(parent);
 
     lv_obj_refresh_ext_draw_size(obj);
 
@@ -277,8 +280,9 @@ void lv_obj_mark_layout_as_dirty(lv_obj_t * obj)
 {
     obj->layout_inv = 1;
 
-    /*Mark the screen as dirty too to mark that there is something to do on this screen*/
-    lv_obj_t * scr = lv_obj_get_screen(obj);
+    /*Mark the path to the screen so that only the affected subtrees are visited,
+     *and mark the screen as dirty too to mark that there is something to do on this screen*/
+    lv_obj_t * scr = mark_ancestors_as_dirty(obj);
     scr->scr_layout_inv = 1;
 
     /*Make the display refreshing*/
@@ -296,6 +300,10 @@ void lv_obj_update_layout(const lv_obj_t * obj)
     update_layout_mutex = true;
 
     lv_obj_t * scr = lv_obj_get_screen(obj);
+#if LV_USE_SYSMON && LV_USE_PERF_MONITOR
+    uint32_t t_start = lv_tick_get();
+    bool updated = scr->scr_layout_inv;
+#endif
     /*Repeat until there are no more layout invalidations*/
     while(scr->scr_layout_inv) {
         LV_LOG_TRACE("Layout update begin");
@@ -304,6 +312,13 @@ void lv_obj_update_layout(const lv_obj_t * obj)
         LV_LOG_TRACE("Layout update end");
     }
 
+#if LV_USE_SYSMON && LV_USE_PERF_MONITOR
+    if(updated) {
+        LV_GLOBAL_DEFAULT()->layout_elaps_sum += lv_tick_elaps(t_start);
+        LV_GLOBAL_DEFAULT()->layout_cnt++;
+    }
+#endif
+
     update_layout_mutex = false;
     LV_PROFILER_END;
 }
@@ -803,6 +818,9 @@ void lv_obj_invalidate_area(const lv_obj_t * obj, const lv_area_t * area)
 {
     LV_ASSERT_OBJ(obj, MY_CLASS);
 
+    /*Even if it's not visible now, the cached bitmaps can't be used anymore*/
+    _lv_obj_invalidate_bitmap_cache(obj);
+
     lv_display_t * disp   = lv_obj_get_display(obj);
     if(!lv_display_is_invalidation_enabled(disp)) return;
 
@@ -1093,13 +1111,46 @@ static int32_t calc_content_height(lv_obj_t * obj)
     return LV_MAX(self_h, child_res + space_bottom);
 }
 
+static lv_obj_t * mark_ancestors_as_dirty(lv_obj_t * obj)
+{
+    while(obj->parent) {
+        obj = obj->parent;
+        obj->child_layout_inv = 1;
+    }
+
+    return obj;
+}
+
+/**
+ * Getting the scrollbar area checks all the children, so doing it for every resized child would be O(n^2).
+ * If the parent is being updated, invalidate the scrollbars only for the first child (to invalidate the old area)
+ * and once again when the parent's layout update is finished.
+ */
+static void scrollbar_invalidate_in_layout(lv_obj_t * obj)
+{
+    if(obj->layout_visiting) {
+        if(obj->scrollbar_inv_after_layout) return;
+        obj->scrollbar_inv_after_layout = 1;
+    }
+
+    lv_obj_scrollbar_invalidate(obj);
+}
+
 static void layout_update_core(lv_obj_t * obj)
 {
     uint32_t i;
     uint32_t child_cnt = lv_obj_get_child_count(obj);
-    for(i = 0; i < child_cnt; i++) {
-        lv_obj_t * child = obj->spec_attr->children[i];
-        layout_update_core(child);
+    obj->layout_visiting = 1;
+
+    /*Cleared before the children are processed, so if they invalidate something again it's kept for the next round*/
+    if(obj->child_layout_inv) {
+        obj->child_layout_inv = 0;
+        for(i = 0; i < child_cnt; i++) {
+            lv_obj_t * child = obj->spec_attr->children[i];
+            if(child->layout_inv || child->child_layout_inv || child->readjust_scroll_after_layout) {
+                layout_update_core(child);
+            }
+        }
     }
 
     if(obj->layout_inv) {
@@ -1116,6 +1167,12 @@ static void layout_update_core(lv_obj_t * obj)
         obj->readjust_scroll_after_layout = 0;
         lv_obj_readjust_scroll(obj, LV_ANIM_OFF);
     }
+
+    obj->layout_visiting = 0;
+    if(obj->scrollbar_inv_after_layout) {
+        obj->scrollbar_inv_after_layout = 0;
+        lv_obj_scrollbar_invalidate(obj);
+    }
 }
 
 static void transform_point(const lv_obj_t * obj, lv_point_t * p, bool inv)
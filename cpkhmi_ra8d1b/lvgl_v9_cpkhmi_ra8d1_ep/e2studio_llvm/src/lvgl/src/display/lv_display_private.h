@@ -99,6 +99,14 @@ struct _lv_display_t {
     /** Double buffer sync areas (redrawn during last refresh) */
     lv_ll_t sync_areas;
 
+#if LV_SCROLL_BLIT
+    /** Area whose rendered pixels are moved by `scroll_blit_delta` in the next refresh*/
+    lv_area_t scroll_blit_area;
+    lv_point_t scroll_blit_delta;
+    uint32_t scroll_blit_pending : 1;   /**< 1: `scroll_blit_area` is set*/
+    uint32_t scroll_blit_act : 1;       /**< 1: the pixels are moved in the current refresh*/
+#endif
+
     lv_draw_buf_t _static_buf1; /*Used when user pass in a raw buffer as display draw buffer*/
     lv_draw_buf_t _static_buf2;
     /*---------------------
@@ -7,6 +7,7 @@
  *      INCLUDES
  *********************/
 #include "lv_draw.h"
+#include "lv_draw_vector.h"
 #include "sw/lv_draw_sw.h"
 #include "../display/lv_display_private.h"
 #include "../core/lv_global.h"
@@ -25,12 +26,21 @@
 /**********************
  *  STATIC PROTOTYPES
  **********************/
-static bool is_independent(lv_layer_t * layer, lv_draw_task_t * t_check);
+static void add_dependencies(lv_layer_t * layer, lv_draw_task_t * t);
+static void remove_task(lv_display_t * disp, lv_layer_t * layer, lv_draw_task_t * t);
+static uint8_t get_ready_queue_idx(lv_layer_t * layer, uint8_t draw_unit_id);
+static void queue_add(lv_layer_t * layer, lv_draw_task_t * t, uint8_t idx, bool to_head);
+static void queue_remove(lv_layer_t * layer, lv_draw_task_t * t);
 
 static inline uint32_t get_layer_size_kb(uint32_t size_byte)
 {
     return size_byte < 1024 ? 1 : size_byte >> 10;
 }
+
+static inline bool is_overlapping(const lv_area_t * a1, const lv_area_t * a2)
+{
+    return a1->x1 <= a2->x2 && a1->x2 >= a2->x1 && a1->y1 <= a2->y2 && a1->y2 >= a2->y1;
+}
 /**********************
  *  STATIC VARIABLES
  **********************/
@@ -52,6 +62,25 @@ void lv_draw_init(void)
 #if LV_USE_OS
     lv_thread_sync_init(&_draw_info.sync);
 #endif
+
+    /*The descriptors of the built-in draw tasks fit into the blocks*/
+    typedef union {
+        lv_draw_fill_dsc_t fill;
+        lv_draw_border_dsc_t border;
+        lv_draw_box_shadow_dsc_t box_shadow;
+        lv_draw_label_dsc_t label;
+        lv_draw_image_dsc_t image;
+        lv_draw_arc_dsc_t arc;
+        lv_draw_line_dsc_t line;
+        lv_draw_triangle_dsc_t triangle;
+        lv_draw_mask_rect_dsc_t mask_rect;
+#if LV_USE_VECTOR_GRAPHIC
+        lv_draw_vector_task_dsc_t vector;
+#endif
+    } dsc_union_t;
+
+    lv_mem_slab_init(&_draw_info.task_slab, "draw_task", sizeof(lv_draw_task_t), 32);
+    lv_mem_slab_init(&_draw_info.dsc_slab, "draw_dsc", sizeof(dsc_union_t), 32);
 }
 
 void lv_draw_deinit(void)
@@ -69,6 +98,9 @@ void lv_draw_deinit(void)
         lv_free(cur_unit);
     }
     _draw_info.unit_head = NULL;
+
+    lv_mem_slab_deinit(&_draw_info.task_slab);
+    lv_mem_slab_deinit(&_draw_info.dsc_slab);
 }
 
 void * lv_draw_create_unit(size_t size)
@@ -81,31 +113,51 @@ void * lv_draw_create_unit(size_t size)
     return new_unit;
 }
 
+void lv_draw_delete_unit(lv_draw_unit_t * draw_unit)
+{
+    LV_ASSERT_NULL(draw_unit);
+
+    lv_draw_unit_t ** u = &_draw_info.unit_head;
+    while(*u) {
+        if(*u == draw_unit) {
+            *u = draw_unit->next;
+            break;
+        }
+        u = &(*u)->next;
+    }
+
+    if(draw_unit->delete_cb) draw_unit->delete_cb(draw_unit);
+    lv_free(draw_unit);
+}
+
 lv_draw_task_t * lv_draw_add_task(lv_layer_t * layer, const lv_area_t * coords)
 {
     LV_PROFILER_BEGIN;
-    lv_draw_task_t * new_task = lv_malloc_zeroed(sizeof(lv_draw_task_t));
+    lv_draw_task_t * new_task = lv_mem_slab_alloc_zeroed(&_draw_info.task_slab, sizeof(lv_draw_task_t));
 
     new_task->area = *coords;
     new_task->_real_area = *coords;
     new_task->clip_area = layer->_clip_area;
     new_task->state = LV_DRAW_TASK_STATE_QUEUED;
 
-    /*Find the tail*/
     if(layer->draw_task_head == NULL) {
         layer->draw_task_head = new_task;
     }
     else {
-        lv_draw_task_t * tail = layer->draw_task_head;
-        while(tail->next) tail = tail->next;
-
-        tail->next = new_task;
+        layer->_draw_task_tail->next = new_task;
+        new_task->_prev = layer->_draw_task_tail;
     }
+    layer->_draw_task_tail = new_task;
 
     LV_PROFILER_END;
     return new_task;
 }
 
+void * lv_draw_dsc_malloc(size_t size)
+{
+    return lv_mem_slab_alloc(&_draw_info.dsc_slab, size);
+}
+
 void lv_draw_finalize_task_creation(lv_layer_t * layer, lv_draw_task_t * t)
 {
     LV_PROFILER_BEGIN;
@@ -135,6 +187,18 @@ void lv_draw_finalize_task_creation(lv_layer_t * layer, lv_draw_task_t * t)
             u = u->next;
         }
 
+        /*Add the task and the tasks added in the event to the dependency graph in order*/
+        lv_draw_task_t * t_add = t;
+        while(t_add) {
+            if(!t_add->_dep_added) {
+                add_dependencies(layer, t_add);
+                if(t_add->_dep_cnt == 0 && t_add->state == LV_DRAW_TASK_STATE_QUEUED) {
+                    queue_add(layer, t_add, get_ready_queue_idx(layer, t_add->preferred_draw_unit_id), false);
+                }
+            }
+            t_add = t_add->next;
+        }
+
         lv_draw_dispatch();
     }
     else {
@@ -173,59 +237,13 @@ void lv_draw_dispatch(void)
 bool lv_draw_dispatch_layer(lv_display_t * disp, lv_layer_t * layer)
 {
     LV_PROFILER_BEGIN;
-    /*Remove the finished tasks first*/
-    lv_draw_task_t * t_prev = NULL;
-    lv_draw_task_t * t = layer->draw_task_head;
+    /*Remove the finished tasks first. Only the taken tasks can be finished.*/
+    lv_draw_task_t * t = layer->_taken.head;
     while(t) {
-        lv_draw_task_t * t_next = t->next;
+        lv_draw_task_t * t_next = t->_queue_next;
         if(t->state == LV_DRAW_TASK_STATE_READY) {
-            if(t_prev) t_prev->next = t->next;      /*Remove by it by assigning the next task to the previous*/
-            else layer->draw_task_head = t_next;    /*If it was the head, set the next as head*/
-
-            /*If it was layer drawing free the layer too*/
-            if(t->type == LV_DRAW_TASK_TYPE_LAYER) {
-                lv_draw_image_dsc_t * draw_image_dsc = t->draw_dsc;
-                lv_layer_t * layer_drawn = (lv_layer_t *)draw_image_dsc->src;
-
-                if(layer_drawn->draw_buf) {
-                    int32_t h = lv_area_get_height(&layer_drawn->buf_area);
-                    int32_t w = lv_area_get_width(&layer_drawn->buf_area);
-                    uint32_t layer_size_byte = h * lv_draw_buf_width_to_stride(w, layer_drawn->color_format);
-
-                    _draw_info.used_memory_for_layers_kb -= get_layer_size_kb(layer_size_byte);
-                    LV_LOG_INFO("Layer memory used: %" LV_PRIu32 " kB\n", _draw_info.used_memory_for_layers_kb);
-                    lv_draw_buf_destroy(layer_drawn->draw_buf);
-                    layer_drawn->draw_buf = NULL;
-                }
-
-                /*Remove the layer from  the display's*/
-                if(disp) {
-                    lv_layer_t * l2 = disp->layer_head;
-                    while(l2) {
-                        if(l2->next == layer_drawn) {
-                            l2->next = layer_drawn->next;
-                            break;
-                        }
-                        l2 = l2->next;
-                    }
-
-                    if(disp->layer_deinit) disp->layer_deinit(disp, layer_drawn);
-                    lv_free(layer_drawn);
-                }
-            }
-            if(t->type == LV_DRAW_TASK_TYPE_LABEL) {
-                lv_draw_label_dsc_t * draw_label_dsc = t->draw_dsc;
-                if(draw_label_dsc->text_local) {
-                    lv_free((void *)draw_label_dsc->text);
-                    draw_label_dsc->text = NULL;
-                }
-            }
-
-            lv_free(t->draw_dsc);
-            lv_free(t);
-        }
-        else {
-            t_prev = t;
+            queue_remove(layer, t);
+            remove_task(disp, layer, t);
         }
         t = t_next;
     }
@@ -241,6 +259,10 @@ bool lv_draw_dispatch_layer(lv_display_t * disp, lv_layer_t * layer)
                 lv_draw_image_dsc_t * draw_dsc = t_src->draw_dsc;
                 if(draw_dsc->src == layer) {
                     t_src->state = LV_DRAW_TASK_STATE_QUEUED;
+                    if(t_src->_dep_added && t_src->_dep_cnt == 0) {
+                        uint8_t idx = get_ready_queue_idx(layer->parent, t_src->preferred_draw_unit_id);
+                        queue_add(layer->parent, t_src, idx, false);
+                    }
                     lv_draw_dispatch_request();
                     break;
                 }
@@ -286,54 +308,54 @@ void lv_draw_dispatch_request(void)
 lv_draw_task_t * lv_draw_get_next_available_task(lv_layer_t * layer, lv_draw_task_t * t_prev, uint8_t draw_unit_id)
 {
     LV_PROFILER_BEGIN;
-    /*If the first task is screen sized, there cannot be independent areas*/
-    if(layer->draw_task_head) {
-        int32_t hor_res = lv_display_get_horizontal_resolution(_lv_refr_get_disp_refreshing());
-        int32_t ver_res = lv_display_get_vertical_resolution(_lv_refr_get_disp_refreshing());
-        lv_draw_task_t * t = layer->draw_task_head;
-        if(t->state != LV_DRAW_TASK_STATE_QUEUED &&
-           t->area.x1 <= 0 && t->area.x2 >= hor_res - 1 &&
-           t->area.y1 <= 0 && t->area.y2 >= ver_res - 1) {
-            LV_PROFILER_END;
-            return NULL;
+    /*Put back the tasks which were returned earlier but were not taken by the draw units.
+     *Go backward to keep their order as they are added to the head.*/
+    lv_draw_task_t * t;
+    if(t_prev == NULL) {
+        t = layer->_taken.tail;
+        while(t) {
+            lv_draw_task_t * t_queue_prev = t->_queue_prev;
+            if(t->state == LV_DRAW_TASK_STATE_QUEUED) {
+                queue_remove(layer, t);
+                queue_add(layer, t, get_ready_queue_idx(layer, t->preferred_draw_unit_id), true);
+            }
+            t = t_queue_prev;
         }
     }
 
-    lv_draw_task_t * t = t_prev ? t_prev->next : layer->draw_task_head;
-    while(t) {
-        /*Find a queued and independent task*/
-        if(t->state == LV_DRAW_TASK_STATE_QUEUED &&
-           (t->preferred_draw_unit_id == LV_DRAW_UNIT_ID_ANY || t->preferred_draw_unit_id == draw_unit_id) &&
-           is_independent(layer, t)) {
-            LV_PROFILER_END;
-            return t;
+    /*The returned tasks are moved away from the ready queues,
+     *so the first task of the queues is the next one even with `t_prev`*/
+    t = NULL;
+    uint32_t i;
+    for(i = 1; i < LV_DRAW_READY_QUEUE_CNT - 1; i++) {
+        lv_draw_task_queue_t * q = &layer->_ready_queues[i];
+        if(q->head && q->draw_unit_id == draw_unit_id) {
+            t = q->head;
+            break;
         }
-        t = t->next;
+    }
+
+    if(t == NULL) t = layer->_ready_queues[0].head;
+
+    if(t == NULL) {
+        t = layer->_ready_queues[LV_DRAW_READY_QUEUE_CNT - 1].head;
+        while(t && t->preferred_draw_unit_id != draw_unit_id) t = t->_queue_next;
+    }
+
+    if(t) {
+        queue_remove(layer, t);
+        queue_add(layer, t, LV_DRAW_READY_QUEUE_CNT, false);
     }
 
     LV_PROFILER_END;
-    return NULL;
+    return t;
 }
 
 uint32_t lv_draw_get_dependent_count(lv_draw_task_t * t_check)
 {
     if(t_check == NULL) return 0;
-    if(t_check->next == NULL) return 0;
-
-    LV_PROFILER_BEGIN;
-    uint32_t cnt = 0;
-
-    lv_draw_task_t * t = t_check->next;
-    while(t) {
-        if((t->state == LV_DRAW_TASK_STATE_QUEUED || t->state == LV_DRAW_TASK_STATE_WAITING) &&
-           _lv_area_is_on(&t_check->area, &t->area)) {
-            cnt++;
-        }
 
-        t = t->next;
-    }
-    LV_PROFILER_END;
-    return cnt;
+    return t_check->_dependent_cnt;
 }
 
 lv_layer_t * lv_draw_layer_create(lv_layer_t * parent_layer, lv_color_format_t color_format, const lv_area_t * area)
@@ -378,6 +400,10 @@ void * lv_draw_layer_alloc_buf(lv_layer_t * layer)
         return NULL;
     }
 
+    uint32_t layer_size_byte = h * lv_draw_buf_width_to_stride(w, layer->color_format);
+    _draw_info.used_memory_for_layers_kb += get_layer_size_kb(layer_size_byte);
+    LV_LOG_INFO("Layer memory used: %" LV_PRIu32 " kB\n", _draw_info.used_memory_for_layers_kb);
+
     if(lv_color_format_has_alpha(layer->color_format)) {
         lv_area_t a;
         a.x1 = 0;
@@ -400,28 +426,169 @@ void * lv_draw_layer_go_to_xy(lv_layer_t * layer, int32_t x, int32_t y)
  **********************/
 
 /**
- * Check if there are older draw task overlapping the area of `t_check`
- * @param layer      the draw ctx to search in
- * @param t_check       check this task if it overlaps with the older ones
- * @return              true: `t_check` is not overlapping with older tasks so it's independent
+ * Count the earlier overlapping draw tasks of `t` and register `t` as their dependent
+ * @param layer     pointer to the layer of `t`
+ * @param t         pointer to a draw task
  */
-static bool is_independent(lv_layer_t * layer, lv_draw_task_t * t_check)
+static void add_dependencies(lv_layer_t * layer, lv_draw_task_t * t)
 {
     LV_PROFILER_BEGIN;
-    lv_draw_task_t * t = layer->draw_task_head;
-
-    /*If t_check is outside of the older tasks then it's independent*/
-    while(t && t != t_check) {
-        if(t->state != LV_DRAW_TASK_STATE_READY) {
-            lv_area_t a;
-            if(_lv_area_intersect(&a, &t->_real_area, &t_check->_real_area)) {
-                LV_PROFILER_END;
-                return false;
-            }
+    t->_dep_added = 1;
+    t->_dep_cnt = 0;
+
+    /*The finished but not removed tasks are counted too as
+     *the same tasks are found again when they are removed*/
+    lv_draw_task_t * t_prev = layer->draw_task_head;
+    while(t_prev != t) {
+        if(is_overlapping(&t_prev->_real_area, &t->_real_area)) {
+            t->_dep_cnt++;
+            t_prev->_dependent_cnt++;
         }
-        t = t->next;
+        t_prev = t_prev->next;
     }
     LV_PROFILER_END;
+}
+
+/**
+ * Remove a ready draw task from the layer, let its dependents start and free it
+ * @param disp      pointer to the display of the layer or NULL
+ * @param layer     pointer to a layer
+ * @param t         pointer to a ready draw task of `layer`
+ */
+static void remove_task(lv_display_t * disp, lv_layer_t * layer, lv_draw_task_t * t)
+{
+    if(t->_prev) t->_prev->next = t->next;
+    else layer->draw_task_head = t->next;
+
+    if(t->next) t->next->_prev = t->_prev;
+    else layer->_draw_task_tail = t->_prev;
+
+    /*Find the dependents in the same way as they were counted*/
+    lv_draw_task_t * t_dep = t->next;
+    while(t_dep && t->_dependent_cnt > 0) {
+        if(t_dep->_dep_added && is_overlapping(&t->_real_area, &t_dep->_real_area)) {
+            t->_dependent_cnt--;
+            t_dep->_dep_cnt--;
+            if(t_dep->_dep_cnt == 0 && t_dep->state == LV_DRAW_TASK_STATE_QUEUED) {
+                queue_add(layer, t_dep, get_ready_queue_idx(layer, t_dep->preferred_draw_unit_id), false);
+            }
+        }
+        t_dep = t_dep->next;
+    }
+
+    /*If it was layer drawing free the layer too*/
+    if(t->type == LV_DRAW_TASK_TYPE_LAYER) {
+        lv_draw_image_dsc_t * draw_image_dsc = t->draw_dsc;
+        lv_layer_t * layer_drawn = (lv_layer_t *)draw_image_dsc->src;
+
+        if(layer_drawn->draw_buf) {
+            int32_t h = lv_area_get_height(&layer_drawn->buf_area);
+            int32_t w = lv_area_get_width(&layer_drawn->buf_area);
+            uint32_t layer_size_byte = h * lv_draw_buf_width_to_stride(w, layer_drawn->color_format);
+
+            _draw_info.used_memory_for_layers_kb -= get_layer_size_kb(layer_size_byte);
+            LV_LOG_INFO("Layer memory used: %" LV_PRIu32 " kB\n", _draw_info.used_memory_for_layers_kb);
+            lv_draw_buf_destroy(layer_drawn->draw_buf);
+            layer_drawn->draw_buf = NULL;
+        }
+
+        /*Remove the layer from  the display's*/
+        if(disp) {
+            lv_layer_t * l2 = disp->layer_head;
+            while(l2) {
+                if(l2->next == layer_drawn) {
+                    l2->next = layer_drawn->next;
+                    break;
+                }
+                l2 = l2->next;
+            }
+
+            if(disp->layer_deinit) disp->layer_deinit(disp, layer_drawn);
+            lv_free(layer_drawn);
+        }
+    }
+    if(t->type == LV_DRAW_TASK_TYPE_LABEL) {
+        lv_draw_label_dsc_t * draw_label_dsc = t->draw_dsc;
+        if(draw_label_dsc->text_local) {
+            lv_free((void *)draw_label_dsc->text);
+            draw_label_dsc->text = NULL;
+        }
+    }
+
+    lv_mem_slab_free(&_draw_info.dsc_slab, t->draw_dsc);
+    lv_mem_slab_free(&_draw_info.task_slab, t);
+}
+
+/**
+ * Get the ready queue of a draw unit ID. Claim a free queue if it has none yet.
+ * @param layer         pointer to a layer
+ * @param draw_unit_id  the preferred draw unit ID of a task
+ * @return              index of the ready queue
+ */
+static uint8_t get_ready_queue_idx(lv_layer_t * layer, uint8_t draw_unit_id)
+{
+    if(draw_unit_id == LV_DRAW_UNIT_ID_ANY) return 0;
+
+    uint8_t free_idx = LV_DRAW_READY_QUEUE_CNT - 1;
+    uint8_t i;
+    for(i = 1; i < LV_DRAW_READY_QUEUE_CNT - 1; i++) {
+        lv_draw_task_queue_t * q = &layer->_ready_queues[i];
+        if(q->head == NULL) {
+            if(free_idx == LV_DRAW_READY_QUEUE_CNT - 1) free_idx = i;
+        }
+        else if(q->draw_unit_id == draw_unit_id) {
+            return i;
+        }
+    }
+
+    return free_idx;
+}
+
+/**
+ * Add a draw task to a ready queue or to the taken tasks
+ * @param layer     pointer to a layer
+ * @param t         pointer to draw task which is not in any queue
+ * @param idx       index of the ready queue or `LV_DRAW_READY_QUEUE_CNT` for the taken tasks
+ * @param to_head   true: add as the first task; false: add as the last task
+ */
+static void queue_add(lv_layer_t * layer, lv_draw_task_t * t, uint8_t idx, bool to_head)
+{
+    lv_draw_task_queue_t * q = idx < LV_DRAW_READY_QUEUE_CNT ? &layer->_ready_queues[idx] : &layer->_taken;
+    if(q->head == NULL) q->draw_unit_id = t->preferred_draw_unit_id;
+
+    t->_queue_idx = idx;
+    if(to_head) {
+        t->_queue_prev = NULL;
+        t->_queue_next = q->head;
+        if(q->head) q->head->_queue_prev = t;
+        else q->tail = t;
+        q->head = t;
+    }
+    else {
+        t->_queue_next = NULL;
+        t->_queue_prev = q->tail;
+        if(q->tail) q->tail->_queue_next = t;
+        else q->head = t;
+        q->tail = t;
+    }
+}
+
+/**
+ * Remove a draw task from its queue
+ * @param layer     pointer to a layer
+ * @param t         pointer to draw task which is in a queue
+ */
+static void queue_remove(lv_layer_t * layer, lv_draw_task_t * t)
+{
+    lv_draw_task_queue_t * q = t->_queue_idx < LV_DRAW_READY_QUEUE_CNT ? &layer->_ready_queues[t->_queue_idx] :
+                               &layer->_taken;
+
+    if(t->_queue_prev) t->_queue_prev->_queue_next = t->_queue_next;
+    else q->head = t->_queue_next;
+
+    if(t->_queue_next) t->_queue_next->_queue_prev = t->_queue_prev;
+    else q->tail = t->_queue_prev;
 
-    return true;
+    t->_queue_next = NULL;
+    t->_queue_prev = NULL;
 }
@@ -21,6 +21,7 @@ extern "C" {
 #include "../misc/lv_profiler.h"
 #include "lv_image_decoder.h"
 #include "../osal/lv_os.h"
+#include "../stdlib/lv_mem_slab.h"
 #include "lv_draw_buf.h"
 
 /*********************
@@ -28,6 +29,10 @@ extern "C" {
  *********************/
 #define LV_DRAW_UNIT_ID_ANY  0
 
+/*Number of ready queues in a layer. The first is for `LV_DRAW_UNIT_ID_ANY`,
+ *the last is shared by the draw unit IDs which didn't get an own queue*/
+#define LV_DRAW_READY_QUEUE_CNT  4
+
 /**********************
  *      TYPEDEFS
  **********************/
@@ -54,6 +59,15 @@ typedef enum {
     LV_DRAW_TASK_STATE_READY,
 } lv_draw_task_state_t;
 
+/**
+ * List of the draw tasks which can be drawn right now
+ */
+typedef struct {
+    lv_draw_task_t * head;
+    lv_draw_task_t * tail;
+    uint8_t draw_unit_id;
+} lv_draw_task_queue_t;
+
 struct _lv_draw_task_t {
     lv_draw_task_t * next;
 
@@ -96,6 +110,18 @@ struct _lv_draw_task_t {
      */
     uint8_t preference_score;
 
+    /**
+     * Used internally to track the dependencies.
+     * A task depends on the earlier tasks whose `_real_area` overlaps its `_real_area`.
+     * The edges are not stored, they are found again by the area when a task gets ready.
+     */
+    lv_draw_task_t * _prev;
+    lv_draw_task_t * _queue_next;
+    lv_draw_task_t * _queue_prev;
+    uint32_t _dep_cnt;          /**< Number of earlier tasks this task depends on which are not removed yet*/
+    uint32_t _dependent_cnt;    /**< Number of later tasks depending on this task*/
+    uint8_t _queue_idx;         /**< Index of the ready queue or `LV_DRAW_READY_QUEUE_CNT` if it was taken*/
+    uint8_t _dep_added : 1;     /**< Already added to the dependency graph*/
 };
 
 typedef struct {
@@ -167,6 +193,13 @@ struct _lv_layer_t  {
 
     /** Linked list of draw tasks */
     lv_draw_task_t * draw_task_head;
+    lv_draw_task_t * _draw_task_tail;
+
+    /** The queued draw tasks without pending dependencies grouped by `preferred_draw_unit_id` */
+    lv_draw_task_queue_t _ready_queues[LV_DRAW_READY_QUEUE_CNT];
+
+    /** The draw tasks returned by `lv_draw_get_next_available_task` */
+    lv_draw_task_queue_t _taken;
 
     lv_layer_t * parent;
     lv_layer_t * next;
@@ -194,6 +227,8 @@ typedef struct {
 #endif
     lv_mutex_t circle_cache_mutex;
     bool task_running;
+    lv_mem_slab_t task_slab;
+    lv_mem_slab_t dsc_slab;
 } lv_draw_global_info_t;
 
 /**********************
@@ -217,6 +252,13 @@ void lv_draw_deinit(void);
  */
 void * lv_draw_create_unit(size_t size);
 
+/**
+ * Remove a draw unit from the list of draw units, call its `delete_cb` and free it.
+ * The draw unit must not be drawing a task when it's deleted.
+ * @param draw_unit pointer to a draw unit created by `lv_draw_create_unit()`
+ */
+void lv_draw_delete_unit(lv_draw_unit_t * draw_unit);
+
 /**
  * Add an empty draw task to the draw task list of a layer.
  * @param layer     pointer to a layer
@@ -226,6 +268,14 @@ void * lv_draw_create_unit(size_t size);
  */
 lv_draw_task_t * lv_draw_add_task(lv_layer_t * layer, const lv_area_t * coords);
 
+/**
+ * Allocate memory for the draw descriptor of a draw task.
+ * It's freed by LVGL when the draw task is finished.
+ * @param size      size of the draw descriptor, e.g. `sizeof(lv_draw_fill_dsc_t)`
+ * @return          pointer to the allocated memory
+ */
+void * lv_draw_dsc_malloc(size_t size);
+
 /**
  * Needs to be called when a draw task is created and configured.
  * It will send an event about the new draw task to the widget
@@ -261,7 +311,10 @@ void lv_draw_dispatch_wait_for_request(void);
 void lv_draw_dispatch_request(void);
 
 /**
- * Find and available draw task
+ * Find and available draw task.
+ * Only the ready queues are searched, so the tasks waiting for earlier overlapping tasks are not checked again.
+ * If the returned task is left in `LV_DRAW_TASK_STATE_QUEUED` it will be returned again
+ * when searching with `t_prev == NULL`.
  * @param layer             the draw ctx to search in
  * @param t_prev            continue searching from this task
  * @param draw_unit_id      check the task where `preferred_draw_unit_id` equals this value or `LV_DRAW_UNIT_ID_ANY`
@@ -270,7 +323,7 @@ void lv_draw_dispatch_request(void);
 lv_draw_task_t * lv_draw_get_next_available_task(lv_layer_t * layer, lv_draw_task_t * t_prev, uint8_t draw_unit_id);
 
 /**
- * Tell how many draw task are waiting to be drawn on the area of `t_check`.
+ * Tell how many draw task are waiting for `t_check` because they overlap it.
  * It can be used to determine if a GPU shall combine many draw tasks in to one or not.
  * If a lot of tasks are waiting for the current ones it makes sense to draw them one-by-one
  * to not block the dependent tasks' rendering
@@ -78,12 +78,15 @@ typedef void (*lv_draw_buf_invalidate_cache_cb)(void * buf, uint32_t stride, lv_
 
 typedef uint32_t (*lv_draw_buf_width_to_stride_cb)(uint32_t w, lv_color_format_t color_format);
 
+typedef void (*lv_draw_buf_move_cb)(lv_draw_buf_t * draw_buf, const lv_area_t * area, int32_t dx, int32_t dy);
+
 typedef struct {
     lv_draw_buf_malloc_cb buf_malloc_cb;
     lv_draw_buf_free_cb buf_free_cb;
     lv_draw_buf_align_cb align_pointer_cb;
     lv_draw_buf_invalidate_cache_cb invalidate_cache_cb;
     lv_draw_buf_width_to_stride_cb width_to_stride_cb;
+    lv_draw_buf_move_cb buf_move_cb;
 } lv_draw_buf_handlers_t;
 
 /**********************
@@ -146,6 +149,16 @@ void lv_draw_buf_clear(lv_draw_buf_t * draw_buf, const lv_area_t * a);
 void lv_draw_buf_copy(lv_draw_buf_t * dest, const lv_area_t * dest_area,
                       const lv_draw_buf_t * src, const lv_area_t * src_area);
 
+/**
+ * Move the pixels of an area within a buffer. The source and the destination can overlap.
+ * @param draw_buf  pointer to a draw buffer
+ * @param area      the area to move. Only the pixels inside `area` are read and written.
+ * @param dx        move the pixels by this many pixels horizontally
+ * @param dy        move the pixels by this many pixels vertically
+ * @note            the pixels of `area` which are not covered by the moved area are not changed
+ */
+void lv_draw_buf_move(lv_draw_buf_t * draw_buf, const lv_area_t * area, int32_t dx, int32_t dy);
+
 /**
  * Note: Eventually, lv_draw_buf_malloc/free will be kept as private.
  *       For now, we use `create` to distinguish with malloc.
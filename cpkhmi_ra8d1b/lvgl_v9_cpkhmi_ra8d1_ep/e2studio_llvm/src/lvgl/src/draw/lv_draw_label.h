@@ -45,6 +45,30 @@ typedef struct _lv_draw_label_hint_t {
     int32_t coord_y;
 } lv_draw_label_hint_t;
 
+/** A line of `lv_draw_label_lines_t`*/
+typedef struct {
+    uint32_t start;         /**< Byte index of the first letter of the line*/
+    uint32_t letter_start;  /**< Index of the first letter of the line in `letter_w`*/
+    int32_t w;              /**< Width of the line*/
+} lv_draw_label_line_t;
+
+/** Line breaks and letter widths of a text calculated in advance (e.g. by the label)
+ * to draw the text without measuring it again.
+ * They are valid only with the text, font, letter space, width and flags they were calculated with.*/
+typedef struct _lv_draw_label_lines_t {
+    /** `line_cnt + 1` elements, the `start` of the last one is the length of the text*/
+    lv_draw_label_line_t * line;
+
+    /** Width of each letter (as returned by `lv_font_get_glyph_width`) or NULL to measure them while drawing*/
+    uint16_t * letter_w;
+
+    uint32_t line_cnt;
+    const lv_font_t * font;
+    int32_t letter_space;
+    int32_t max_w;
+    lv_text_flag_t flag;
+} lv_draw_label_lines_t;
+
 typedef struct {
     lv_draw_dsc_base_t base;
 
@@ -70,6 +94,9 @@ typedef struct {
      * 0: `text` is const and it's pointer will be valid during rendering.*/
     uint8_t text_local : 1;
     lv_draw_label_hint_t * hint;
+    /** If set, the line breaks and letter widths are not calculated while drawing.
+     * Not used with `LV_TEXT_FLAG_EXPAND`.*/
+    const lv_draw_label_lines_t * lines;
 } lv_draw_label_dsc_t;
 
 typedef enum {
@@ -42,6 +42,10 @@ static d2_s32 lv_dave2d_init(void);
 
 static void lv_draw_buf_dave2d_init_handlers(void);
 
+#if LV_SCROLL_BLIT
+static void _dave2d_buf_move(lv_draw_buf_t * draw_buf, const lv_area_t * area, int32_t dx, int32_t dy);
+#endif
+
 void dave2d_execute_dlist_and_flush(void);
 
 /**********************
@@ -119,6 +123,10 @@ static void lv_draw_buf_dave2d_init_handlers(void)
     handlers->invalidate_cache_cb = _dave2d_buf_invalidate_cache_cb;
 #endif
 #endif
+
+#if LV_SCROLL_BLIT
+    handlers->buf_move_cb = _dave2d_buf_move;
+#endif
 }
 
 #if defined(RENESAS_CORTEX_M85)
@@ -144,6 +152,134 @@ static void _dave2d_buf_invalidate_cache_cb(void * buf, uint32_t stride, lv_colo
 #endif
 #endif
 
+#if LV_SCROLL_BLIT
+/**
+ * Move the pixels of an area in a draw buffer with D/AVE 2D blits.
+ * The source and destination of a blit can't overlap, so the area is copied in bands
+ * as wide or high as the movement. The bands are blitted starting from the side the
+ * pixels are moved to, so a band reads only pixels which are overwritten by the later bands.
+ */
+static void _dave2d_buf_move(lv_draw_buf_t * draw_buf, const lv_area_t * area, int32_t dx, int32_t dy)
+{
+    d2_s32     result;
+
+    /*Only the part of the area where the pixels are moved to is written*/
+    lv_area_t dest_area = *area;
+    lv_area_move(&dest_area, dx, dy);
+    if(!_lv_area_intersect(&dest_area, &dest_area, area)) return;
+
+    lv_color_format_t cf = draw_buf->header.cf;
+    uint32_t stride = draw_buf->header.stride;
+
+    /*Write the pixels rendered by the CPU to the memory before D/AVE 2D reads them*/
+    lv_draw_buf_invalidate_cache(draw_buf->data, stride, cf, area);
+
+#if LV_USE_OS
+    lv_result_t  status;
+
+    status = lv_mutex_lock(&xd2Semaphore);
+    if(LV_RESULT_OK != status) {
+        __BKPT(0);
+    }
+#endif
+
+    d2_u32 src_blend_mode = d2_getblendmodesrc(_d2_handle);
+    d2_u32 dst_blend_mode = d2_getblendmodedst(_d2_handle);
+
+    result = d2_selectrenderbuffer(_d2_handle, _blit_renderbuffer);
+    if(D2_OK != result) {
+        __BKPT(0);
+    }
+
+    result = d2_setblendmode(_d2_handle, d2_bm_one, d2_bm_zero);
+    if(D2_OK != result) {
+        __BKPT(0);
+    }
+
+    d2_s32 pitch = (d2_s32)(stride / lv_color_format_get_size(cf));
+    d2_u32 d2_fmt = lv_draw_dave2d_lv_colour_fmt_to_d2_fmt(cf);
+
+    result = d2_framebuffer(_d2_handle, draw_buf->data, pitch, (d2_u32)draw_buf->header.w, (d2_u32)draw_buf->header.h,
+                            d2_fmt);
+    if(D2_OK != result) {
+        __BKPT(0);
+    }
+
+    result = d2_setblitsrc(_d2_handle, draw_buf->data, pitch, (d2_s32)draw_buf->header.w, (d2_s32)draw_buf->header.h,
+                           d2_fmt);
+    if(D2_OK != result) {
+        __BKPT(0);
+    }
+
+    /*Horizontal bands if moved vertically, else vertical bands*/
+    bool vertical = dy != 0;
+    int32_t band_size = vertical ? LV_ABS(dy) : LV_ABS(dx);
+    int32_t start = vertical ? dest_area.y1 : dest_area.x1;
+    int32_t end = vertical ? dest_area.y2 : dest_area.x2;
+    bool reverse = vertical ? dy > 0 : dx > 0;
+
+    int32_t band_cnt = (end - start + band_size) / band_size;
+    int32_t i;
+    for(i = 0; i < band_cnt; i++) {
+        int32_t band_i = reverse ? band_cnt - 1 - i : i;
+        lv_area_t band = dest_area;
+        if(vertical) {
+            band.y1 = start + band_i * band_size;
+            band.y2 = LV_MIN(band.y1 + band_size - 1, end);
+        }
+        else {
+            band.x1 = start + band_i * band_size;
+            band.x2 = LV_MIN(band.x1 + band_size - 1, end);
+        }
+
+        int32_t band_w = lv_area_get_width(&band);
+        int32_t band_h = lv_area_get_height(&band);
+
+        result = d2_cliprect(_d2_handle, (d2_border)band.x1, (d2_border)band.y1, (d2_border)band.x2, (d2_border)band.y2);
+        if(D2_OK != result) {
+            __BKPT(0);
+        }
+
+        result = d2_blitcopy(_d2_handle, (d2_s32)band_w, (d2_s32)band_h, (d2_blitpos)(band.x1 - dx), (d2_blitpos)(band.y1 - dy),
+                             D2_FIX4(band_w), D2_FIX4(band_h), D2_FIX4(band.x1), D2_FIX4(band.y1), 0);
+        if(D2_OK != result) {
+            __BKPT(0);
+        }
+    }
+
+    // Execute render operations
+    result = d2_executerenderbuffer(_d2_handle, _blit_renderbuffer, 0);
+    if(D2_OK != result) {
+        __BKPT(0);
+    }
+
+    result = d2_flushframe(_d2_handle);
+    if(D2_OK != result) {
+        __BKPT(0);
+    }
+
+    result = d2_selectrenderbuffer(_d2_handle, _renderbuffer);
+    if(D2_OK != result) {
+        __BKPT(0);
+    }
+
+    result = d2_setblendmode(_d2_handle, src_blend_mode, dst_blend_mode);
+    if(D2_OK != result) {
+        __BKPT(0);
+    }
+
+#if LV_USE_OS
+    status = lv_mutex_unlock(&xd2Semaphore);
+    if(LV_RESULT_OK != status) {
+        __BKPT(0);
+    }
+#endif
+
+    /*Don't read the old pixels from the cache*/
+    lv_draw_buf_invalidate_cache(draw_buf->data, stride, cf, &dest_area);
+}
+#endif /*LV_SCROLL_BLIT*/
+
 /**
  * @todo
  * LVGL needs to use hardware acceleration for buf_copy and do not affect GPU rendering.
@@ -134,6 +134,10 @@ void lv_draw_sw_init(void)
     lv_draw_sw_mask_init();
 #endif
 
+#if LV_DRAW_SW_SHADOW_CACHE_SIZE
+    _lv_draw_sw_box_shadow_cache_init();
+#endif
+
     uint32_t i;
     for(i = 0; i < LV_DRAW_SW_DRAW_UNIT_CNT; i++) {
         lv_draw_sw_unit_t * draw_sw_unit = lv_draw_create_unit(sizeof(lv_draw_sw_unit_t));
@@ -161,6 +165,10 @@ void lv_draw_sw_deinit(void)
 #if LV_DRAW_SW_COMPLEX == 1
     lv_draw_sw_mask_deinit();
 #endif
+
+#if LV_DRAW_SW_SHADOW_CACHE_SIZE
+    _lv_draw_sw_box_shadow_cache_deinit();
+#endif
 }
 
 static int32_t lv_draw_sw_delete(lv_draw_unit_t * draw_unit)
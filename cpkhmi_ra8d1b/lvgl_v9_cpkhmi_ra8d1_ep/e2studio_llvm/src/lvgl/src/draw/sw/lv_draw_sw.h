@@ -45,9 +45,19 @@ typedef struct {
 
 #if LV_DRAW_SW_SHADOW_CACHE_SIZE
 typedef struct {
-    uint8_t cache[LV_DRAW_SW_SHADOW_CACHE_SIZE * LV_DRAW_SW_SHADOW_CACHE_SIZE];
-    int32_t cache_size;
-    int32_t cache_r;
+    lv_opa_t * buf;             /*The blurred corner and its mirrored version, `2 * (sw + r)^2` bytes*/
+    int32_t sw;                 /*Shadow width*/
+    int32_t r;                  /*Radius of the shadow*/
+    int32_t w;                  /*Size of the blurred rectangle, clamped to the size where it still matters*/
+    int32_t h;
+    int32_t life;               /*How many times the entry was used*/
+    uint32_t used_cnt;          /*Like a semaphore to count the shadows being drawn from the entry*/
+    bool ready;                 /*The corner is calculated. Until then only the unit calculating it uses the entry.*/
+} _lv_draw_sw_shadow_cache_entry_t;
+
+typedef struct {
+    _lv_draw_sw_shadow_cache_entry_t entries[LV_DRAW_SW_SHADOW_CACHE_CNT];
+    lv_mutex_t mutex;
 } lv_draw_sw_shadow_cache_t;
 #endif
 
@@ -90,6 +100,18 @@ void lv_draw_sw_border(lv_draw_unit_t * draw_unit, const lv_draw_border_dsc_t *
  */
 void lv_draw_sw_box_shadow(lv_draw_unit_t * draw_unit, const lv_draw_box_shadow_dsc_t * dsc, const lv_area_t * coords);
 
+#if LV_DRAW_SW_SHADOW_CACHE_SIZE
+/**
+ * Initialize the cache of the blurred shadow corners. Called internally.
+ */
+void _lv_draw_sw_box_shadow_cache_init(void);
+
+/**
+ * Free the cached shadow corners. Called internally.
+ */
+void _lv_draw_sw_box_shadow_cache_deinit(void);
+#endif
+
 /**
  * Draw an image with SW render. It handles image decoding, tiling, transformations, and recoloring.
  * @param draw_unit     pointer to a draw unit
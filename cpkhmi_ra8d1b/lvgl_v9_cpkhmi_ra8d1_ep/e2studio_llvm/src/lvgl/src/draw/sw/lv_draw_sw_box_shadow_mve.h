@@ -0,0 +1,93 @@
+/**
+ * @file lv_draw_sw_box_shadow_mve.h
+ *
+ */
+
+#ifndef LV_DRAW_SW_BOX_SHADOW_MVE_H
+#define LV_DRAW_SW_BOX_SHADOW_MVE_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*********************
+ *      INCLUDES
+ *********************/
+#include <stdint.h>
+
+/*********************
+ *      DEFINES
+ *********************/
+
+#define LV_DRAW_SW_SHADOW_NORMALIZE(buf, recip, len) \
+    _lv_draw_sw_shadow_normalize_mve(buf, recip, len)
+
+#define LV_DRAW_SW_SHADOW_BLUR_ROW(sum_buf, top_row, bottom_row, res_row, len) \
+    _lv_draw_sw_shadow_blur_row_mve(sum_buf, top_row, bottom_row, res_row, len)
+
+/**********************
+ *      MACROS
+ **********************/
+
+/**********************
+ *      TYPEDEFS
+ **********************/
+
+/**********************
+ * GLOBAL PROTOTYPES
+ **********************/
+
+/*Divide 4 values at once by multiplying with the reciprocal and keeping the upper 32 bits*/
+static inline void _lv_draw_sw_shadow_normalize_mve(uint16_t * buf, uint32_t recip, int32_t len)
+{
+    __asm volatile(
+        ".p2align 2                                             \n"
+        "vdup.32            q1, %[recip]                        \n"
+        "wlstp.32           lr, %[len], 1f                      \n"
+        "2:                                                     \n"
+        "vldrh.u32          q0, [%[buf]]                        \n"
+        "vmulh.u32          q0, q0, q1                          \n"
+        "vstrh.32           q0, [%[buf]], #8                    \n"
+        "letp               lr, 2b                              \n"
+        "1:                                                     \n"
+        : [buf] "+r"(buf)
+        : [recip] "r"(recip),
+        [len] "r"(len)
+        : "q0", "q1", "memory", "r14", "cc");
+}
+
+/*One row step of the vertical blur on 4 columns at once:
+ *save the current sums shifted back by 6 (`SHADOW_UPSCALE_SHIFT`) and clamped to 0,
+ *then subtract the top row and add the bottom row. The tail is predicated.*/
+static inline void _lv_draw_sw_shadow_blur_row_mve(int32_t * sum_buf, const uint16_t * top_row,
+                                                   const uint16_t * bottom_row, uint16_t * res_row, int32_t len)
+{
+    __asm volatile(
+        ".p2align 2                                             \n"
+        "vmov.i32           q3, #0                              \n"
+        "wlstp.32           lr, %[len], 1f                      \n"
+        "2:                                                     \n"
+        "vldrw.32           q0, [%[sum]]                        \n"
+        "vmax.s32           q1, q0, q3                          \n"
+        "vshr.s32           q1, q1, #6                          \n"
+        "vstrh.32           q1, [%[res]], #8                    \n"
+        "vldrh.u32          q1, [%[top]], #8                    \n"
+        "vldrh.u32          q2, [%[bottom]], #8                 \n"
+        "vsub.i32           q0, q0, q1                          \n"
+        "vadd.i32           q0, q0, q2                          \n"
+        "vstrw.32           q0, [%[sum]], #16                   \n"
+        "letp               lr, 2b                              \n"
+        "1:                                                     \n"
+        : [sum] "+r"(sum_buf),
+        [top] "+r"(top_row),
+        [bottom] "+r"(bottom_row),
+        [res] "+r"(res_row)
+        : [len] "r"(len)
+        : "q0", "q1", "q2", "q3", "memory", "r14", "cc");
+}
+
+#ifdef __cplusplus
+} /*extern "C"*/
+#endif
+
+#endif /*LV_DRAW_SW_BOX_SHADOW_MVE_H*/
@@ -133,13 +133,21 @@ typedef struct  {
     lv_opa_t * cir_opa;         /*Opacity of values on the circumference of an 1/4 circle*/
     uint16_t * x_start_on_y;        /*The x coordinate of the circle for each y value*/
     uint16_t * opa_start_on_y;      /*The index of `cir_opa` for each y value*/
-    int32_t life;               /*How many times the entry way used*/
-    uint32_t used_cnt;          /*Like a semaphore to count the referencing masks*/
+    int32_t life;               /*How many times the entry way used. -1: not cached, free it with the mask*/
     int32_t radius;          /*The radius of the entry*/
 } _lv_draw_sw_mask_radius_circle_dsc_t;
 
 typedef _lv_draw_sw_mask_radius_circle_dsc_t _lv_draw_sw_mask_radius_circle_dsc_arr_t[LV_DRAW_SW_CIRCLE_CACHE_SIZE];
 
+typedef struct {
+    /*Hash table indexed by the radius. It's changed only between refreshes so it's read without locking*/
+    _lv_draw_sw_mask_radius_circle_dsc_arr_t entries;
+
+    /*Circles calculated during the current refresh. Protected by `circle_cache_mutex`*/
+    _lv_draw_sw_mask_radius_circle_dsc_arr_t new_entries;
+    uint32_t new_cnt;
+} _lv_draw_sw_mask_circle_cache_t;
+
 typedef struct {
     /*The first element must be the common descriptor*/
     _lv_draw_sw_mask_common_dsc_t dsc;
@@ -216,8 +224,8 @@ LV_ATTRIBUTE_FAST_MEM lv_draw_sw_mask_res_t lv_draw_sw_mask_apply(void * masks[]
 void lv_draw_sw_mask_free_param(void * p);
 
 /**
- * Called by LVGL the rendering of a screen is ready to clean up
- * the temporal (cache) data of the masks
+ * Called by LVGL when the rendering of a screen is ready.
+ * Moves the circles calculated during the rendering into the cache.
  */
 void _lv_draw_sw_mask_cleanup(void);
 
@@ -14,17 +14,31 @@
 #include "../misc/lv_log.h"
 #include "../misc/lv_utils.h"
 #include "../stdlib/lv_mem.h"
+#include "../stdlib/lv_string.h"
+#include "../misc/cache/lv_cache.h"
+
+#if LV_USE_FONT_COMPRESSED && LV_USE_DRAW_SW_ASM == LV_DRAW_SW_ASM_HELIUM
+    #include "lv_font_fmt_txt_mve.h"
+#endif
 
 /*********************
  *      DEFINES
  *********************/
-#if LV_USE_FONT_COMPRESSED
-    #define font_rle LV_GLOBAL_DEFAULT()->font_fmt_rle
-#endif /*LV_USE_FONT_COMPRESSED*/
+#if LV_USE_FONT_COMPRESSED && LV_FONT_FMT_TXT_CACHE_SIZE > 0
+    #define font_cache LV_GLOBAL_DEFAULT()->font_fmt_txt_cache
+#endif
 
 /**********************
  *      TYPEDEFS
  **********************/
+#if LV_USE_FONT_COMPRESSED && LV_FONT_FMT_TXT_CACHE_SIZE > 0
+typedef struct {
+    lv_cache_slot_size_t slot;
+    const lv_font_t * font;
+    uint32_t gid;
+    uint8_t * bitmap;           /*The decompressed A8 glyph, stride is `box_w`*/
+} font_cache_data_t;
+#endif
 
 /**********************
  *  STATIC PROTOTYPES
@@ -36,13 +50,20 @@ static int32_t kern_pair_8_compare(const void * ref, const void * element);
 static int32_t kern_pair_16_compare(const void * ref, const void * element);
 
 #if LV_USE_FONT_COMPRESSED
-    static void decompress(const uint8_t * in, uint8_t * out, int32_t w, int32_t h, uint8_t bpp, bool prefilter);
-    static inline void decompress_line(uint8_t * out, int32_t w);
+    static void decompress(const uint8_t * in, uint8_t * out, int32_t w, int32_t h, uint32_t stride, uint8_t bpp,
+                           bool prefilter);
+    static inline void decompress_line(lv_font_fmt_rle_t * rle, uint8_t * out, int32_t w);
     static inline uint8_t get_bits(const uint8_t * in, uint32_t bit_pos, uint8_t len);
-    static inline void rle_init(const uint8_t * in,  uint8_t bpp);
-    static inline uint8_t rle_next(void);
+    static inline void rle_init(lv_font_fmt_rle_t * rle, const uint8_t * in,  uint8_t bpp);
+    static inline uint8_t rle_next(lv_font_fmt_rle_t * rle);
 #endif /*LV_USE_FONT_COMPRESSED*/
 
+#if LV_USE_FONT_COMPRESSED && LV_FONT_FMT_TXT_CACHE_SIZE > 0
+    static bool font_cache_create_cb(font_cache_data_t * node, void * user_data);
+    static void font_cache_free_cb(font_cache_data_t * node, void * user_data);
+    static lv_cache_compare_res_t font_cache_compare_cb(const font_cache_data_t * lhs, const font_cache_data_t * rhs);
+#endif
+
 /**********************
  *  STATIC VARIABLES
  **********************/
@@ -150,8 +171,34 @@ const void * lv_font_get_bitmap_fmt_txt(lv_font_glyph_dsc_t * g_dsc, uint32_t un
     /*Handle compressed bitmap*/
     else {
 #if LV_USE_FONT_COMPRESSED
+        uint32_t stride = draw_buf->header.stride;
+#if LV_FONT_FMT_TXT_CACHE_SIZE > 0
+        /*Copy the glyph from the cache, it's decompressed on a miss. Too large glyphs bypass the cache*/
+        font_cache_data_t search_key;
+        lv_memzero(&search_key, sizeof(search_key));
+        search_key.slot.size = (uint32_t)gdsc->box_w * gdsc->box_h;
+        search_key.font = font;
+        search_key.gid = gid;
+
+        lv_cache_entry_t * entry = NULL;
+        if(font_cache && search_key.slot.size <= LV_FONT_FMT_TXT_CACHE_SIZE / 4) {
+            entry = lv_cache_acquire_or_create(font_cache, &search_key, NULL);
+        }
+
+        if(entry) {
+            const uint8_t * src = ((font_cache_data_t *)lv_cache_entry_get_data(entry))->bitmap;
+            int32_t y;
+            for(y = 0; y < gdsc->box_h; y++) {
+                lv_memcpy(bitmap_out, src, gdsc->box_w);
+                bitmap_out += stride;
+                src += gdsc->box_w;
+            }
+            lv_cache_release(font_cache, entry, NULL);
+            return draw_buf;
+        }
+#endif /*LV_FONT_FMT_TXT_CACHE_SIZE > 0*/
         bool prefilter = fdsc->bitmap_format == LV_FONT_FMT_TXT_COMPRESSED;
-        decompress(&fdsc->glyph_bitmap[gdsc->bitmap_index], bitmap_out, gdsc->box_w, gdsc->box_h,
+        decompress(&fdsc->glyph_bitmap[gdsc->bitmap_index], bitmap_out, gdsc->box_w, gdsc->box_h, stride,
                    (uint8_t)fdsc->bpp, prefilter);
         return draw_buf;
 #else /*!LV_USE_FONT_COMPRESSED*/
@@ -208,6 +255,39 @@ bool lv_font_get_glyph_dsc_fmt_txt(const lv_font_t * font, lv_font_glyph_dsc_t *
     return true;
 }
 
+void _lv_font_fmt_txt_cache_init(void)
+{
+#if LV_USE_FONT_COMPRESSED && LV_FONT_FMT_TXT_CACHE_SIZE > 0
+    lv_cache_ops_t ops = {
+        .compare_cb = (lv_cache_compare_cb_t)font_cache_compare_cb,
+        .create_cb = (lv_cache_create_cb_t)font_cache_create_cb,
+        .free_cb = (lv_cache_free_cb_t)font_cache_free_cb,
+    };
+
+    font_cache = lv_cache_create(&lv_cache_class_lru_rb_size, sizeof(font_cache_data_t), LV_FONT_FMT_TXT_CACHE_SIZE,
+                                 ops);
+#endif
+}
+
+void _lv_font_fmt_txt_cache_deinit(void)
+{
+#if LV_USE_FONT_COMPRESSED && LV_FONT_FMT_TXT_CACHE_SIZE > 0
+    if(font_cache) lv_cache_destroy(font_cache, NULL);
+    font_cache = NULL;
+#endif
+}
+
+void lv_font_fmt_txt_cache_drop(const lv_font_t * font)
+{
+#if LV_USE_FONT_COMPRESSED && LV_FONT_FMT_TXT_CACHE_SIZE > 0
+    /*The cache can't be searched by font only, and fonts are rarely freed*/
+    LV_UNUSED(font);
+    if(font_cache) lv_cache_drop_all(font_cache, NULL);
+#else
+    LV_UNUSED(font);
+#endif
+}
+
 /**********************
  *   STATIC FUNCTIONS
  **********************/
@@ -344,11 +424,14 @@ static int32_t kern_pair_16_compare(const void * ref, const void * element)
  * The compress a glyph's bitmap
  * @param in the compressed bitmap
  * @param out buffer to store the result
- * @param px_num number of pixels in the glyph (width * height)
+ * @param w width of the glyph
+ * @param h height of the glyph
+ * @param stride stride of `out` in bytes
  * @param bpp bit per pixel (bpp = 3 will be converted to bpp = 4)
  * @param prefilter true: the lines are XORed
  */
-static void decompress(const uint8_t * in, uint8_t * out, int32_t w, int32_t h, uint8_t bpp, bool prefilter)
+static void decompress(const uint8_t * in, uint8_t * out, int32_t w, int32_t h, uint32_t stride, uint8_t bpp,
+                       bool prefilter)
 {
     const lv_opa_t * opa_table;
     switch(bpp) {
@@ -366,60 +449,82 @@ static void decompress(const uint8_t * in, uint8_t * out, int32_t w, int32_t h,
             return;
     }
 
-    rle_init(in, bpp);
+    /*The state is local so glyphs can be decompressed by more draw units at once*/
+    lv_font_fmt_rle_t rle;
+    rle_init(&rle, in, bpp);
 
-    uint8_t * line_buf1 = lv_malloc(w);
+    uint8_t * line_buf1 = lv_malloc(prefilter ? w * 2 : w);
+    LV_ASSERT_MALLOC(line_buf1);
+    if(line_buf1 == NULL) return;
 
-    uint8_t * line_buf2 = NULL;
-
-    if(prefilter) {
-        line_buf2 = lv_malloc(w);
-    }
-
-    decompress_line(line_buf1, w);
+    uint8_t * line_buf2 = line_buf1 + w;
 
     int32_t y;
     int32_t x;
-    uint32_t stride = lv_draw_buf_width_to_stride(w, LV_COLOR_FORMAT_A8);
 
+    decompress_line(&rle, line_buf1, w);
+
+#ifdef LV_FONT_FMT_TXT_OPA_LINE
+    LV_FONT_FMT_TXT_OPA_LINE(out, line_buf1, opa_table, w);
+#else
     for(x = 0; x < w; x++) {
         out[x] = opa_table[line_buf1[x]];
     }
+#endif
     out += stride;
 
     for(y = 1; y < h; y++) {
         if(prefilter) {
-            decompress_line(line_buf2, w);
+            decompress_line(&rle, line_buf2, w);
 
+#ifdef LV_FONT_FMT_TXT_PREFILTER_LINE
+            LV_FONT_FMT_TXT_PREFILTER_LINE(out, line_buf1, line_buf2, opa_table, w);
+#else
             for(x = 0; x < w; x++) {
                 line_buf1[x] = line_buf2[x] ^ line_buf1[x];
                 out[x] = opa_table[line_buf1[x]];
             }
+#endif
         }
         else {
-            decompress_line(line_buf1, w);
+            decompress_line(&rle, line_buf1, w);
 
+#ifdef LV_FONT_FMT_TXT_OPA_LINE
+            LV_FONT_FMT_TXT_OPA_LINE(out, line_buf1, opa_table, w);
+#else
             for(x = 0; x < w; x++) {
                 out[x] = opa_table[line_buf1[x]];
             }
+#endif
         }
         out += stride;
     }
 
+    LV_UNUSED(x);
     lv_free(line_buf1);
-    lv_free(line_buf2);
 }
 
 /**
  * Decompress one line. Store one pixel per byte
+ * @param rle the decompression state
  * @param out output buffer
  * @param w width of the line in pixel count
  */
-static inline void decompress_line(uint8_t * out, int32_t w)
+static inline void decompress_line(lv_font_fmt_rle_t * rle, uint8_t * out, int32_t w)
 {
-    int32_t i;
-    for(i = 0; i < w; i++) {
-        out[i] = rle_next();
+    int32_t i = 0;
+    while(i < w) {
+        /*A counted repeat returns `prev_v` until the last one, fill those at once*/
+        if(rle->state == RLE_STATE_COUNTER && rle->count > 1) {
+            int32_t n = LV_MIN((int32_t)rle->count - 1, w - i);
+            lv_memset(&out[i], rle->prev_v, n);
+            rle->count -= n;
+            i += n;
+        }
+        else {
+            out[i] = rle_next(rle);
+            i++;
+        }
     }
 }
 
@@ -465,9 +570,8 @@ static inline uint8_t get_bits(const uint8_t * in, uint32_t bit_pos, uint8_t len
     }
 }
 
-static inline void rle_init(const uint8_t * in,  uint8_t bpp)
+static inline void rle_init(lv_font_fmt_rle_t * rle, const uint8_t * in,  uint8_t bpp)
 {
-    lv_font_fmt_rle_t * rle = &font_rle;
     rle->in = in;
     rle->bpp = bpp;
     rle->state = RLE_STATE_SINGLE;
@@ -476,11 +580,10 @@ static inline void rle_init(const uint8_t * in,  uint8_t bpp)
     rle->count = 0;
 }
 
-static inline uint8_t rle_next(void)
+static inline uint8_t rle_next(lv_font_fmt_rle_t * rle)
 {
     uint8_t v = 0;
     uint8_t ret = 0;
-    lv_font_fmt_rle_t * rle = &font_rle;
 
     if(rle->state == RLE_STATE_SINGLE) {
         ret = get_bits(rle->in, rle->rdp, rle->bpp);
@@ -535,6 +638,56 @@ static inline uint8_t rle_next(void)
 }
 #endif /*LV_USE_FONT_COMPRESSED*/
 
+#if LV_USE_FONT_COMPRESSED && LV_FONT_FMT_TXT_CACHE_SIZE > 0
+
+/*-----------------
+ * Cache Callbacks
+ *----------------*/
+
+static bool font_cache_create_cb(font_cache_data_t * node, void * user_data)
+{
+    LV_UNUSED(user_data);
+
+    const lv_font_fmt_txt_dsc_t * fdsc = node->font->dsc;
+    const lv_font_fmt_txt_glyph_dsc_t * gdsc = &fdsc->glyph_dsc[node->gid];
+
+    /*Store the glyph without padding, it's copied to the draw buffer anyway*/
+    uint8_t * bitmap = lv_malloc(node->slot.size);
+    if(bitmap == NULL) {
+        LV_LOG_WARN("Out of memory");
+        return false;
+    }
+
+    bool prefilter = fdsc->bitmap_format == LV_FONT_FMT_TXT_COMPRESSED;
+    decompress(&fdsc->glyph_bitmap[gdsc->bitmap_index], bitmap, gdsc->box_w, gdsc->box_h, gdsc->box_w,
+               (uint8_t)fdsc->bpp, prefilter);
+
+    node->bitmap = bitmap;
+    return true;
+}
+
+static void font_cache_free_cb(font_cache_data_t * node, void * user_data)
+{
+    LV_UNUSED(user_data);
+
+    lv_free(node->bitmap);
+}
+
+static lv_cache_compare_res_t font_cache_compare_cb(const font_cache_data_t * lhs, const font_cache_data_t * rhs)
+{
+    if(lhs->font != rhs->font) {
+        return lhs->font > rhs->font ? 1 : -1;
+    }
+
+    if(lhs->gid != rhs->gid) {
+        return lhs->gid > rhs->gid ? 1 : -1;
+    }
+
+    return 0;
+}
+
+#endif /*LV_USE_FONT_COMPRESSED && LV_FONT_FMT_TXT_CACHE_SIZE > 0*/
+
 /** Code Comparator.
  *
  *  Compares the value of both input arguments.
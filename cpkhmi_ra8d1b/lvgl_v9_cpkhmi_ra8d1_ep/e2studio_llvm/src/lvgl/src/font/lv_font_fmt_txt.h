@@ -236,6 +236,23 @@ const void * lv_font_get_bitmap_fmt_txt(lv_font_glyph_dsc_t * g_dsc, uint32_t un
 bool lv_font_get_glyph_dsc_fmt_txt(const lv_font_t * font, lv_font_glyph_dsc_t * dsc_out, uint32_t unicode_letter,
                                    uint32_t unicode_letter_next);
 
+/**
+ * Drop the decompressed glyphs of a font from the glyph cache.
+ * Needs to be called before a font using the compressed format is freed.
+ * @param font pointer to font
+ */
+void lv_font_fmt_txt_cache_drop(const lv_font_t * font);
+
+/**
+ * Initialize the cache of decompressed glyphs. Called in `lv_init()`.
+ */
+void _lv_font_fmt_txt_cache_init(void);
+
+/**
+ * Free the cache of decompressed glyphs. Called in `lv_deinit()`.
+ */
+void _lv_font_fmt_txt_cache_deinit(void);
+
 /**********************
  *      MACROS
  **********************/
@@ -222,10 +222,8 @@ static void grid_update(lv_obj_t * cont, void * user_data)
  */
 static void calc(lv_obj_t * cont, _lv_grid_calc_t * calc_out)
 {
-    if(lv_obj_get_child(cont, 0) == NULL) {
-        lv_memzero(calc_out, sizeof(_lv_grid_calc_t));
-        return;
-    }
+    lv_memzero(calc_out, sizeof(_lv_grid_calc_t));
+    if(lv_obj_get_child(cont, 0) == NULL) return;
 
     calc_rows(cont, calc_out);
     calc_cols(cont, calc_out);
@@ -256,10 +254,9 @@ static void calc(lv_obj_t * cont, _lv_grid_calc_t * calc_out)
  */
 static void calc_free(_lv_grid_calc_t * calc)
 {
+    /*`w` and `h` are in the same allocation as `x` and `y`*/
     lv_free(calc->x);
     lv_free(calc->y);
-    lv_free(calc->w);
-    lv_free(calc->h);
 }
 
 static void calc_cols(lv_obj_t * cont, _lv_grid_calc_t * c)
@@ -289,29 +286,35 @@ static void calc_cols(lv_obj_t * cont, _lv_grid_calc_t * c)
     int32_t cont_w = lv_obj_get_content_width(cont);
 
     c->col_num = count_tracks(col_templ);
-    c->x = lv_malloc(sizeof(int32_t) * c->col_num);
-    c->w = lv_malloc(sizeof(int32_t) * c->col_num);
+    /*The positions and sizes share one allocation*/
+    c->x = lv_malloc(sizeof(int32_t) * c->col_num * 2);
+    LV_ASSERT_MALLOC(c->x);
+    c->w = c->x + c->col_num;
 
-    /*Set sizes for CONTENT cells*/
+    /*Set sizes for CONTENT cells. Visit the children only once and update the track they are in
+     *instead of scanning all the children for each CONTENT track.*/
     uint32_t i;
+    bool has_content = false;
     for(i = 0; i < c->col_num; i++) {
-        int32_t size = LV_COORD_MIN;
         if(IS_CONTENT(col_templ[i])) {
-            /*Check the size of children of this cell*/
-            uint32_t ci;
-            for(ci = 0; ci < lv_obj_get_child_count(cont); ci++) {
-                lv_obj_t * item = lv_obj_get_child(cont, ci);
-                if(lv_obj_has_flag_any(item, LV_OBJ_FLAG_IGNORE_LAYOUT | LV_OBJ_FLAG_HIDDEN | LV_OBJ_FLAG_FLOATING)) continue;
-                uint32_t col_span = get_col_span(item);
-                if(col_span != 1) continue;
-
-                uint32_t col_pos = get_col_pos(item);
-                if(col_pos != i) continue;
-
-                size = LV_MAX(size, lv_obj_get_width(item));
-            }
-            if(size >= 0) c->w[i] = size;
-            else c->w[i] = 0;
+            c->w[i] = 0;
+            has_content = true;
+        }
+    }
+
+    if(has_content) {
+        uint32_t child_cnt = lv_obj_get_child_count(cont);
+        uint32_t ci;
+        for(ci = 0; ci < child_cnt; ci++) {
+            lv_obj_t * item = cont->spec_attr->children[ci];
+            if(lv_obj_has_flag_any(item, LV_OBJ_FLAG_IGNORE_LAYOUT | LV_OBJ_FLAG_HIDDEN | LV_OBJ_FLAG_FLOATING)) continue;
+            uint32_t col_span = get_col_span(item);
+            if(col_span != 1) continue;
+
+            uint32_t col_pos = get_col_pos(item);
+            if(col_pos >= c->col_num || !IS_CONTENT(col_templ[col_pos])) continue;
+
+            c->w[col_pos] = LV_MAX(c->w[col_pos], lv_obj_get_width(item));
         }
     }
 
@@ -383,28 +386,33 @@ static void calc_rows(lv_obj_t * cont, _lv_grid_calc_t * c)
     }
 
     c->row_num = count_tracks(row_templ);
-    c->y = lv_malloc(sizeof(int32_t) * c->row_num);
-    c->h = lv_malloc(sizeof(int32_t) * c->row_num);
-    /*Set sizes for CONTENT cells*/
+    c->y = lv_malloc(sizeof(int32_t) * c->row_num * 2);
+    LV_ASSERT_MALLOC(c->y);
+    c->h = c->y + c->row_num;
+
+    /*Set sizes for CONTENT cells in one pass over the children*/
     uint32_t i;
+    bool has_content = false;
     for(i = 0; i < c->row_num; i++) {
-        int32_t size = LV_COORD_MIN;
         if(IS_CONTENT(row_templ[i])) {
-            /*Check the size of children of this cell*/
-            uint32_t ci;
-            for(ci = 0; ci < lv_obj_get_child_count(cont); ci++) {
-                lv_obj_t * item = lv_obj_get_child(cont, ci);
-                if(lv_obj_has_flag_any(item, LV_OBJ_FLAG_IGNORE_LAYOUT | LV_OBJ_FLAG_HIDDEN | LV_OBJ_FLAG_FLOATING)) continue;
-                uint32_t row_span = get_row_span(item);
-                if(row_span != 1) continue;
-
-                uint32_t row_pos = get_row_pos(item);
-                if(row_pos != i) continue;
-
-                size = LV_MAX(size, lv_obj_get_height(item));
-            }
-            if(size >= 0) c->h[i] = size;
-            else c->h[i] = 0;
+            c->h[i] = 0;
+            has_content = true;
+        }
+    }
+
+    if(has_content) {
+        uint32_t child_cnt = lv_obj_get_child_count(cont);
+        uint32_t ci;
+        for(ci = 0; ci < child_cnt; ci++) {
+            lv_obj_t * item = cont->spec_attr->children[ci];
+            if(lv_obj_has_flag_any(item, LV_OBJ_FLAG_IGNORE_LAYOUT | LV_OBJ_FLAG_HIDDEN | LV_OBJ_FLAG_FLOATING)) continue;
+            uint32_t row_span = get_row_span(item);
+            if(row_span != 1) continue;
+
+            uint32_t row_pos = get_row_pos(item);
+            if(row_pos >= c->row_num || !IS_CONTENT(row_templ[row_pos])) continue;
+
+            c->h[row_pos] = LV_MAX(c->h[row_pos], lv_obj_get_height(item));
         }
     }
 
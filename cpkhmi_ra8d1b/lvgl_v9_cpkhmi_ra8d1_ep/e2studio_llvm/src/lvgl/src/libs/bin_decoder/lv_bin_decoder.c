@@ -24,6 +24,7 @@
 /*********************
  *      DEFINES
  *********************/
+#define COMPRESSED_HEADER_SIZE  12
 
 /**********************
  *      TYPEDEFS
@@ -31,11 +32,15 @@
 
 /**
  * Data format for compressed image data.
+ * If `band_rows` is not 0 the image is split to bands of `band_rows` lines, each compressed on its own.
+ * `data` then starts with `band count + 1` uint32_t offsets (from `data`) of the bands and the end of the last one,
+ * so any band can be decompressed without the others.
  */
 
 typedef struct _lv_image_compressed_t {
     uint32_t method: 4; /*Compression method, see `lv_image_compress_t`*/
-    uint32_t reserved : 28;  /*Reserved to be used later*/
+    uint32_t band_rows : 12; /*Lines per independently compressed band, 0: the whole image is one stream*/
+    uint32_t reserved : 16;  /*Reserved to be used later*/
     uint32_t compressed_size;  /*Compressed data size in byte*/
     uint32_t decompressed_size;  /*Decompressed data size in byte*/
     const uint8_t * data; /*Compressed data*/
@@ -50,6 +55,11 @@ typedef struct {
     lv_draw_buf_t * decompressed;       /*Decompressed data could be used directly, thus must also be draw buf*/
     lv_draw_buf_t c_array;              /*An C-array image that need to be converted to a draw buf*/
     lv_draw_buf_t * decoded_partial;    /*A draw buf for decoded image via get_area_cb*/
+    uint32_t * band_offsets;            /*Offset table of a banded compressed image*/
+    uint8_t * band_input;               /*Compressed band read from file*/
+    uint8_t * band_output;              /*The last decompressed band*/
+    int32_t band_index;                 /*Band in `band_output`, -1 if none*/
+    lv_draw_buf_t band;                 /*Part of `band_output` returned via get_area_cb*/
 } decoder_data_t;
 
 /**********************
@@ -70,6 +80,14 @@ static lv_result_t decode_compressed(lv_image_decoder_t * decoder, lv_image_deco
 static lv_fs_res_t fs_read_file_at(lv_fs_file_t * f, uint32_t pos, void * buff, uint32_t btr, uint32_t * br);
 
 static lv_result_t decompress_image(lv_image_decoder_dsc_t * dsc, const lv_image_compressed_t * compressed);
+static uint32_t decompress_data(uint32_t method, const uint8_t * input, uint32_t input_len, uint8_t * output,
+                                uint32_t output_len, uint32_t pixel_byte);
+static uint32_t get_pixel_byte(lv_color_format_t cf);
+static bool is_band_streamable(lv_color_format_t cf);
+static lv_result_t open_banded(lv_image_decoder_dsc_t * dsc);
+static lv_result_t decompress_band(lv_image_decoder_dsc_t * dsc, int32_t band);
+static lv_result_t get_area_banded(lv_image_decoder_dsc_t * dsc, const lv_area_t * full_area,
+                                   lv_area_t * decoded_area);
 
 static void bin_decoder_cache_free_cb(lv_image_cache_data_t * cached_data, void * user_data);
 
@@ -386,6 +404,8 @@ lv_result_t lv_bin_decoder_get_area(lv_image_decoder_t * decoder, lv_image_decod
         return LV_RESULT_INVALID;
     }
 
+    if(decoder_data->band_offsets) return get_area_banded(dsc, full_area, decoded_area);
+
     lv_fs_file_t * f = decoder_data->f;
     uint32_t bpp = lv_color_format_get_bpp(cf);
     int32_t w_px = lv_area_get_width(full_area);
@@ -535,6 +555,9 @@ static void free_decoder_data(lv_image_decoder_dsc_t * dsc)
     if(decoder_data->decoded) lv_draw_buf_destroy(decoder_data->decoded);
     if(decoder_data->decompressed) lv_draw_buf_destroy(decoder_data->decompressed);
     lv_free(decoder_data->palette);
+    lv_free(decoder_data->band_offsets);
+    lv_free(decoder_data->band_input);
+    lv_free(decoder_data->band_output);
     lv_free(decoder_data);
     dsc->user_data = NULL;
 }
@@ -888,10 +911,10 @@ static lv_result_t decode_compressed(lv_image_decoder_t * decoder, lv_image_deco
         }
 
         compressed_len -= sizeof(lv_image_header_t);
-        compressed_len -= 12;
+        compressed_len -= COMPRESSED_HEADER_SIZE;
 
         /*Read compress header*/
-        len = 12;
+        len = COMPRESSED_HEADER_SIZE;
         res = fs_read_file_at(f, sizeof(lv_image_header_t), compressed, len, &rn);
         if(res != LV_FS_RES_OK || rn != len) {
             LV_LOG_WARN("Read compressed header failed: %d", res);
@@ -903,6 +926,9 @@ static lv_result_t decode_compressed(lv_image_decoder_t * decoder, lv_image_deco
             return LV_RESULT_INVALID;
         }
 
+        /*Bands are read from the file one by one when drawn*/
+        if(compressed->band_rows && is_band_streamable(dsc->header.cf)) return open_banded(dsc);
+
         file_buf = lv_malloc(compressed_len);
         if(file_buf == NULL) {
             LV_LOG_WARN("No memory for compressed file");
@@ -926,7 +952,7 @@ static lv_result_t decode_compressed(lv_image_decoder_t * decoder, lv_image_deco
         compressed_len = image->data_size;
 
         /*Read compress header*/
-        len = 12;
+        len = COMPRESSED_HEADER_SIZE;
         compressed_len -= len;
         lv_memcpy(compressed, image->data, len);
         compressed->data = image->data + len;
@@ -934,12 +960,21 @@ static lv_result_t decode_compressed(lv_image_decoder_t * decoder, lv_image_deco
             LV_LOG_WARN("Compressed size mismatch: %" LV_PRIu32" != %" LV_PRIu32, compressed->compressed_size, compressed_len);
             return LV_RESULT_INVALID;
         }
+
+        /*Bands are decompressed straight from the variable when drawn*/
+        if(compressed->band_rows && is_band_streamable(dsc->header.cf)) return open_banded(dsc);
     }
     else {
         LV_LOG_WARN("Compressed image only support file or variable");
         return LV_RESULT_INVALID;
     }
 
+    if(compressed->band_rows) {
+        lv_free(file_buf);
+        LV_LOG_WARN("Banded compression is not supported for CF: %d", dsc->header.cf);
+        return LV_RESULT_INVALID;
+    }
+
     res = decompress_image(dsc, compressed);
     compressed->data = NULL; /*No need to store the data any more*/
     lv_free(file_buf);
@@ -1052,7 +1087,6 @@ static lv_result_t decompress_image(lv_image_decoder_dsc_t * dsc, const lv_image
     uint8_t * img_data;
     uint32_t out_len = compressed->decompressed_size;
     uint32_t input_len = compressed->compressed_size;
-    LV_UNUSED(input_len);
 
     /**
      * @todo
@@ -1076,54 +1110,207 @@ static lv_result_t decompress_image(lv_image_decoder_dsc_t * dsc, const lv_image
 
     img_data = decompressed->data;
 
-    if(compressed->method == LV_IMAGE_COMPRESS_RLE) {
+    uint32_t len = decompress_data(compressed->method, compressed->data, input_len, img_data, out_len,
+                                   get_pixel_byte(dsc->header.cf));
+    if(len != compressed->decompressed_size) {
+        LV_LOG_WARN("Decompress failed: %" LV_PRIu32 ", got: %" LV_PRIu32, out_len, len);
+        lv_draw_buf_destroy(decompressed);
+        return LV_RESULT_INVALID;
+    }
+
+    decoder_data->decompressed = decompressed; /*Free on decoder close*/
+    return LV_RESULT_OK;
+}
+
+static uint32_t decompress_data(uint32_t method, const uint8_t * input, uint32_t input_len, uint8_t * output,
+                                uint32_t output_len, uint32_t pixel_byte)
+{
+    LV_UNUSED(input);
+    LV_UNUSED(input_len);
+    LV_UNUSED(output);
+    LV_UNUSED(output_len);
+    LV_UNUSED(pixel_byte);
+
+    if(method == LV_IMAGE_COMPRESS_RLE) {
 #if LV_USE_RLE
-        /*Compress always happen on byte*/
-        uint32_t pixel_byte;
-        if(dsc->header.cf == LV_COLOR_FORMAT_RGB565A8)
-            pixel_byte = 2;
-        else
-            pixel_byte = (lv_color_format_get_bpp(dsc->header.cf) + 7) >> 3;
-        const uint8_t * input = compressed->data;
-        uint8_t * output = img_data;
-        uint32_t len;
-        len = lv_rle_decompress(input, input_len, output, out_len, pixel_byte);
-        if(len != compressed->decompressed_size) {
-            LV_LOG_WARN("Decompress failed: %" LV_PRIu32 ", got: %" LV_PRIu32, out_len, len);
-            lv_draw_buf_destroy(decompressed);
-            return LV_RESULT_INVALID;
-        }
+        return lv_rle_decompress(input, input_len, output, output_len, pixel_byte);
 #else
         LV_LOG_WARN("RLE decompress is not enabled");
-        lv_draw_buf_destroy(decompressed);
-        return LV_RESULT_INVALID;
+        return 0;
 #endif
     }
-    else if(compressed->method == LV_IMAGE_COMPRESS_LZ4) {
+    else if(method == LV_IMAGE_COMPRESS_LZ4) {
 #if LV_USE_LZ4
-        const char * input = (const char *)compressed->data;
-        char * output = (char *)img_data;
-        int len;
-        len = LZ4_decompress_safe(input, output, input_len, out_len);
-        if(len < 0 || (uint32_t)len != compressed->decompressed_size) {
-            LV_LOG_WARN("Decompress failed: %" LV_PRId32 ", got: %" LV_PRId32, out_len, len);
-            lv_draw_buf_destroy(decompressed);
-            return LV_RESULT_INVALID;
-        }
+        int len = LZ4_decompress_safe((const char *)input, (char *)output, input_len, output_len);
+        return len < 0 ? 0 : (uint32_t)len;
 #else
         LV_LOG_WARN("LZ4 decompress is not enabled");
-        lv_draw_buf_destroy(decompressed);
-        return LV_RESULT_INVALID;
+        return 0;
 #endif
     }
+
+    LV_LOG_WARN("Unknown compression method: %d", (int)method);
+    return 0;
+}
+
+/**
+ * RLE works on pixels, but RGB565A8 is compressed as a 2 byte block for both planes
+ */
+static uint32_t get_pixel_byte(lv_color_format_t cf)
+{
+    if(cf == LV_COLOR_FORMAT_RGB565A8) return 2;
+    return (lv_color_format_get_bpp(cf) + 7) >> 3;
+}
+
+/**
+ * The formats which get_area_cb can return directly from a decompressed band
+ */
+static bool is_band_streamable(lv_color_format_t cf)
+{
+    return cf == LV_COLOR_FORMAT_ARGB8888 || cf == LV_COLOR_FORMAT_XRGB8888 || cf == LV_COLOR_FORMAT_RGB888
+           || cf == LV_COLOR_FORMAT_RGB565;
+}
+
+/**
+ * Prepare a banded image to be decompressed band by band in get_area_cb.
+ * Only the offset table and one band are kept in RAM, `dsc->decoded` stays NULL.
+ */
+static lv_result_t open_banded(lv_image_decoder_dsc_t * dsc)
+{
+    decoder_data_t * decoder_data = dsc->user_data;
+    const lv_image_compressed_t * compressed = &decoder_data->compressed;
+    uint32_t band_rows = compressed->band_rows;
+    uint32_t stride = dsc->header.stride;
+    uint32_t band_count = (dsc->header.h + band_rows - 1) / band_rows;
+    uint32_t table_size = (band_count + 1) * sizeof(uint32_t);
+
+    if(compressed->decompressed_size < stride * dsc->header.h || compressed->compressed_size < table_size) {
+        LV_LOG_WARN("Invalid banded image");
+        return LV_RESULT_INVALID;
+    }
+
+    uint32_t * offsets = lv_malloc(table_size);
+    LV_ASSERT_MALLOC(offsets);
+    if(offsets == NULL) return LV_RESULT_INVALID;
+    decoder_data->band_offsets = offsets; /*Free on decoder close*/
+
+    if(dsc->src_type == LV_IMAGE_SRC_FILE) {
+        uint32_t rn;
+        lv_fs_res_t res = fs_read_file_at(decoder_data->f, sizeof(lv_image_header_t) + COMPRESSED_HEADER_SIZE,
+                                          offsets, table_size, &rn);
+        if(res != LV_FS_RES_OK || rn != table_size) {
+            LV_LOG_WARN("Read band offsets failed: %d", res);
+            return LV_RESULT_INVALID;
+        }
+    }
     else {
-        LV_UNUSED(img_data);
-        LV_LOG_WARN("Unknown compression method: %d", compressed->method);
-        lv_draw_buf_destroy(decompressed);
+        lv_memcpy(offsets, compressed->data, table_size); /*May be unaligned in the variable*/
+    }
+
+    uint32_t max_input = 0;
+    uint32_t i;
+    for(i = 0; i < band_count; i++) {
+        if(offsets[i + 1] < offsets[i]) break;
+        max_input = LV_MAX(max_input, offsets[i + 1] - offsets[i]);
+    }
+
+    if(offsets[0] != table_size || i != band_count || offsets[band_count] != compressed->compressed_size) {
+        LV_LOG_WARN("Invalid band offsets");
         return LV_RESULT_INVALID;
     }
 
-    decoder_data->decompressed = decompressed; /*Free on decoder close*/
+    /*RLE may write a padding pixel after the last line of a band*/
+    decoder_data->band_output = lv_malloc(band_rows * stride + get_pixel_byte(dsc->header.cf));
+    LV_ASSERT_MALLOC(decoder_data->band_output);
+    if(decoder_data->band_output == NULL) return LV_RESULT_INVALID;
+
+    if(dsc->src_type == LV_IMAGE_SRC_FILE) {
+        decoder_data->band_input = lv_malloc(max_input);
+        LV_ASSERT_MALLOC(decoder_data->band_input);
+        if(decoder_data->band_input == NULL) return LV_RESULT_INVALID;
+    }
+
+    decoder_data->band_index = -1;
+    return LV_RESULT_OK;
+}
+
+/**
+ * Decompress a band to `band_output` unless it's already there
+ */
+static lv_result_t decompress_band(lv_image_decoder_dsc_t * dsc, int32_t band)
+{
+    decoder_data_t * decoder_data = dsc->user_data;
+    const lv_image_compressed_t * compressed = &decoder_data->compressed;
+
+    if(decoder_data->band_index == band) return LV_RESULT_OK;
+    decoder_data->band_index = -1;
+
+    uint32_t band_rows = compressed->band_rows;
+    uint32_t rows = LV_MIN(band_rows, dsc->header.h - band * band_rows);
+    uint32_t expected = rows * dsc->header.stride;
+    uint32_t pixel_byte = get_pixel_byte(dsc->header.cf);
+    uint32_t input_len = decoder_data->band_offsets[band + 1] - decoder_data->band_offsets[band];
+    const uint8_t * input;
+
+    if(dsc->src_type == LV_IMAGE_SRC_FILE) {
+        uint32_t rn;
+        uint32_t pos = sizeof(lv_image_header_t) + COMPRESSED_HEADER_SIZE + decoder_data->band_offsets[band];
+        lv_fs_res_t res = fs_read_file_at(decoder_data->f, pos, decoder_data->band_input, input_len, &rn);
+        if(res != LV_FS_RES_OK || rn != input_len) {
+            LV_LOG_WARN("Read band %" LV_PRId32 " failed: %d", band, res);
+            return LV_RESULT_INVALID;
+        }
+        input = decoder_data->band_input;
+    }
+    else {
+        input = compressed->data + decoder_data->band_offsets[band];
+    }
+
+    uint32_t len = decompress_data(compressed->method, input, input_len, decoder_data->band_output,
+                                   expected + pixel_byte, pixel_byte);
+    if(len < expected) {
+        LV_LOG_WARN("Decompress band %" LV_PRId32 " failed: %" LV_PRIu32 ", got: %" LV_PRIu32, band, expected, len);
+        return LV_RESULT_INVALID;
+    }
+
+    decoder_data->band_index = band;
+    return LV_RESULT_OK;
+}
+
+/**
+ * Return the requested area band by band. The decoded draw buf points into the band with the image's stride,
+ * so nothing is copied and only the bands touching `full_area` are decompressed.
+ */
+static lv_result_t get_area_banded(lv_image_decoder_dsc_t * dsc, const lv_area_t * full_area,
+                                   lv_area_t * decoded_area)
+{
+    decoder_data_t * decoder_data = dsc->user_data;
+    int32_t band_rows = decoder_data->compressed.band_rows;
+    int32_t y = decoded_area->y1 == LV_COORD_MIN ? full_area->y1 : decoded_area->y2 + 1;
+
+    if(y > full_area->y2) return LV_RESULT_INVALID;
+
+    int32_t band = y / band_rows;
+    if(decompress_band(dsc, band) != LV_RESULT_OK) return LV_RESULT_INVALID;
+
+    int32_t band_y1 = band * band_rows;
+    decoded_area->x1 = full_area->x1;
+    decoded_area->x2 = full_area->x2;
+    decoded_area->y1 = y;
+    decoded_area->y2 = LV_MIN(band_y1 + band_rows - 1, full_area->y2);
+
+    uint32_t stride = dsc->header.stride;
+    lv_draw_buf_t * decoded = &decoder_data->band;
+    decoded->header = dsc->header;
+    decoded->header.flags &= ~LV_IMAGE_FLAGS_COMPRESSED;
+    decoded->header.w = lv_area_get_width(decoded_area);
+    decoded->header.h = lv_area_get_height(decoded_area);
+    decoded->data_size = stride * decoded->header.h;
+    decoded->data = decoder_data->band_output + (y - band_y1) * stride
+                    + decoded_area->x1 * lv_color_format_get_bpp(dsc->header.cf) / 8;
+    decoded->unaligned_data = decoded->data;
+
+    dsc->decoded = decoded;
     return LV_RESULT_OK;
 }
 
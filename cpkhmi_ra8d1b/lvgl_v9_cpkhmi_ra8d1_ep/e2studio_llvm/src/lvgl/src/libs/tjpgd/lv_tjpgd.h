@@ -13,6 +13,8 @@ extern "C" {
 /*********************
  *      INCLUDES
  *********************/
+#include "../../lv_conf_internal.h"
+#include "../../draw/lv_draw_buf.h"
 
 #if LV_USE_TJPGD
 
@@ -24,6 +26,31 @@ extern "C" {
  *      TYPEDEFS
  **********************/
 
+typedef struct _lv_tjpgd_backend_t lv_tjpgd_backend_t;
+
+/**
+ * Decode a whole JPEG image.
+ * @param backend       pointer to the backend
+ * @param data          the JPEG stream
+ * @param data_size     size of `data` in bytes
+ * @param decoded       draw buffer to decode into. Its size is the size of the image and
+ *                      the color format is RGB565 with 16 bit color depth, RGB888 otherwise.
+ * @return              LV_RESULT_OK: the image is decoded;
+ *                      LV_RESULT_INVALID: the image is not supported, the software decoder will stream it
+ */
+typedef lv_result_t (*lv_tjpgd_decode_cb_t)(lv_tjpgd_backend_t * backend, const uint8_t * data, uint32_t data_size,
+                                            lv_draw_buf_t * decoded);
+
+/**
+ * Decodes whole JPEG images instead of the streaming software decoder, e.g. a hardware codec.
+ * The decoded images are added to the image cache.
+ */
+struct _lv_tjpgd_backend_t {
+    const char * name;
+    lv_tjpgd_decode_cb_t decode_cb;
+    void * user_data;
+};
+
 /**********************
  * GLOBAL PROTOTYPES
  **********************/
@@ -32,6 +59,30 @@ void lv_tjpgd_init(void);
 
 void lv_tjpgd_deinit(void);
 
+/**
+ * Set the backend to decode whole JPEG images with.
+ * @param backend       pointer to a static backend, NULL to stream every image with the software decoder
+ */
+void lv_tjpgd_set_backend(lv_tjpgd_backend_t * backend);
+
+/**
+ * Get the backend set by `lv_tjpgd_set_backend()`.
+ * @return              pointer to the backend or NULL
+ */
+lv_tjpgd_backend_t * lv_tjpgd_get_backend(void);
+
+/**
+ * Decode a whole image with the software decoder. It can be used as the `decode_cb` of a backend,
+ * e.g. to stand in for a hardware codec or to keep the decoded images in the image cache.
+ * @param backend       not used
+ * @param data          the JPEG stream
+ * @param data_size     size of `data` in bytes
+ * @param decoded       draw buffer with the size of the image, RGB565 or RGB888
+ * @return              LV_RESULT_OK: the image is decoded; LV_RESULT_INVALID: on error
+ */
+lv_result_t lv_tjpgd_decode_sw(lv_tjpgd_backend_t * backend, const uint8_t * data, uint32_t data_size,
+                               lv_draw_buf_t * decoded);
+
 /**********************
  *      MACROS
  **********************/
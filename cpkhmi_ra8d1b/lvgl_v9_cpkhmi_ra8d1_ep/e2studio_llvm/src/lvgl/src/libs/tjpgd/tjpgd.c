@@ -25,6 +25,11 @@
 /----------------------------------------------------------------------------*/
 
 #include "tjpgd.h"
+#include "../../lv_conf_internal.h"
+
+#if LV_USE_DRAW_SW_ASM == LV_DRAW_SW_ASM_HELIUM
+    #include "tjpgd_mve.h"
+#endif
 
 
 #if JD_FASTDECODE == 2
@@ -607,6 +612,7 @@ JRESULT jd_restart(
 /* Apply Inverse-DCT in Arai Algorithm (see also aa_idct.png)            */
 /*-----------------------------------------------------------------------*/
 
+#ifndef TJPGD_BLOCK_IDCT
 static void block_idct(
     int32_t * src,  /* Input block data (de-quantized and pre-scaled for Arai Algorithm) */
     jd_yuv_t * dst  /* Pointer to the destination to store the block as byte array */
@@ -724,6 +730,7 @@ static void block_idct(
         src += 8; /* Next row */
     }
 }
+#endif /* TJPGD_BLOCK_IDCT */
 
 
 
@@ -805,7 +812,11 @@ JRESULT jd_mcu_load(
                     }
                 }
                 else {
+#ifdef TJPGD_BLOCK_IDCT
+                    TJPGD_BLOCK_IDCT(tmp, bp);  /* Apply IDCT and store the block to the MCU buffer */
+#else
                     block_idct(tmp, bp);    /* Apply IDCT and store the block to the MCU buffer */
+#endif
                 }
             }
         }
@@ -930,6 +941,117 @@ JRESULT jd_mcu_output(
 
 
 
+/*-----------------------------------------------------------------------*/
+/* Convert up to 8 pixels of a block row from YCbCr                      */
+/*-----------------------------------------------------------------------*/
+
+static void ycc_to_rgb888(
+    uint8_t * pix,          /* Output, B, G, R byte order */
+    const jd_yuv_t * py,    /* Y component */
+    const jd_yuv_t * pc,    /* Cb component, Cr is 64 entries later */
+    unsigned int n,         /* Number of pixels */
+    unsigned int hsub       /* 1: chroma is shared by two pixels */
+)
+{
+    const int CVACC = (sizeof(int) > 2) ? 1024 : 128;   /* Adaptive accuracy for both 16-/32-bit systems */
+    unsigned int ix;
+    int yy, cb, cr;
+
+    for(ix = 0; ix < n; ix++) {
+        cb = pc[ix >> hsub] - 128;  /* Get Cb/Cr component and remove offset */
+        cr = pc[64 + (ix >> hsub)] - 128;
+        yy = py[ix];
+        *pix++ = /*B*/ BYTECLIP(yy + ((int)(1.772 * CVACC) * cb) / CVACC);
+        *pix++ = /*G*/ BYTECLIP(yy - ((int)(0.344 * CVACC) * cb + (int)(0.714 * CVACC) * cr) / CVACC);
+        *pix++ = /*R*/ BYTECLIP(yy + ((int)(1.402 * CVACC) * cr) / CVACC);
+    }
+}
+
+#ifndef TJPGD_YCC_TO_RGB565
+static void ycc_to_rgb565(
+    uint16_t * pix,         /* Output */
+    const jd_yuv_t * py,    /* Y component */
+    const jd_yuv_t * pc,    /* Cb component, Cr is 64 entries later */
+    unsigned int n,         /* Number of pixels */
+    unsigned int hsub       /* 1: chroma is shared by two pixels */
+)
+{
+    unsigned int ix;
+    int yy, cb, cr, r, g, b;
+
+    /* The fractions are in Q15 so that 16-bit SIMD can produce the same result */
+    for(ix = 0; ix < n; ix++) {
+        cb = pc[ix >> hsub] - 128;
+        cr = pc[64 + (ix >> hsub)] - 128;
+        yy = py[ix];
+        b = yy + cb + ((cb * 25297) >> 15);                         /* 1.772 * Cb */
+        g = yy - ((cb * 11272) >> 15) - ((cr * 23396) >> 15);       /* 0.344 * Cb + 0.714 * Cr */
+        r = yy + cr + ((cr * 13173) >> 15);                         /* 1.402 * Cr */
+        b = b < 0 ? 0 : (b > 255 ? 255 : b);
+        g = g < 0 ? 0 : (g > 255 ? 255 : g);
+        r = r < 0 ? 0 : (r > 255 ? 255 : r);
+        *pix++ = (uint16_t)(((r & 0xF8) << 8) | ((g & 0xFC) << 3) | (b >> 3));
+    }
+}
+#endif /* TJPGD_YCC_TO_RGB565 */
+
+
+
+
+/*-----------------------------------------------------------------------*/
+/* Output an MCU: Convert YCrCb to RGB into a frame buffer               */
+/*-----------------------------------------------------------------------*/
+
+JRESULT jd_mcu_output_buf(
+    JDEC * jd,          /* Pointer to the decompressor object */
+    uint8_t * buf,      /* Position of the MCU in the frame buffer */
+    size_t stride,      /* Bytes per line of the frame buffer */
+    uint8_t fmt,        /* 0: RGB888 (B, G, R byte order), 1: RGB565 */
+    unsigned int x,     /* MCU location in the image */
+    unsigned int y      /* MCU location in the image */
+)
+{
+    unsigned int mx, my, rx, ry, iy, bx, n, hsub;
+    const jd_yuv_t * py, * pc;
+    uint8_t * pix;
+
+
+    if(JD_USE_SCALE && jd->scale) return JDR_PAR;   /* Descaled output is not supported here */
+
+    mx = jd->msx * 8;
+    my = jd->msy * 8;                 /* MCU size (pixel) */
+    rx = (x + mx <= jd->width) ? mx : jd->width - x;    /* Clip at right/bottom end of image */
+    ry = (y + my <= jd->height) ? my : jd->height - y;
+    hsub = jd->msx - 1;
+
+    for(iy = 0; iy < ry; iy++) {
+        pc = jd->mcubuf + jd->msx * jd->msy * 64 + (iy >> (jd->msy - 1)) * 8;  /* Chroma blocks follow the Y blocks */
+        pix = buf + iy * stride;
+        for(bx = 0; bx * 8 < rx; bx++) {    /* Convert the row of each Y block */
+            py = jd->mcubuf + ((iy >> 3) * jd->msx + bx) * 64 + (iy & 7) * 8;
+            n = rx - bx * 8;
+            if(n > 8) n = 8;
+            if(fmt == 1) {
+#ifdef TJPGD_YCC_TO_RGB565
+                TJPGD_YCC_TO_RGB565((uint16_t *)pix, py, pc + ((bx * 8) >> hsub), n, hsub);
+#else
+                ycc_to_rgb565((uint16_t *)pix, py, pc + ((bx * 8) >> hsub), n, hsub);
+#endif
+                pix += n * 2;
+            }
+            else {
+                ycc_to_rgb888(pix, py, pc + ((bx * 8) >> hsub), n, hsub);
+                pix += n * 3;
+            }
+        }
+    }
+
+    return JDR_OK;
+}
+
+
+
+
 /*-----------------------------------------------------------------------*/
 /* Analyze the JPEG image and Initialize decompressor object             */
 /*-----------------------------------------------------------------------*/
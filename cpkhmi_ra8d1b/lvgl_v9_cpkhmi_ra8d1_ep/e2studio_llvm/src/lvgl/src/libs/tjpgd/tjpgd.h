@@ -93,6 +93,8 @@ JRESULT jd_mcu_load(JDEC * jd);
 
 JRESULT jd_mcu_output(JDEC * jd, int (*outfunc)(JDEC *, void *, JRECT *), unsigned int x, unsigned int y);
 
+JRESULT jd_mcu_output_buf(JDEC * jd, uint8_t * buf, size_t stride, uint8_t fmt, unsigned int x, unsigned int y);
+
 JRESULT jd_restart(JDEC * jd, uint16_t rstn);
 
 
@@ -166,6 +166,58 @@
     #endif
 #endif  /*LV_USE_MALLOC == LV_STDLIB_BUILTIN*/
 
+/*Allocate the objects, their special attributes and style arrays, and the draw tasks and their descriptors
+ *from chunks of fixed size blocks instead of allocating them one by one with `lv_malloc()`.
+ *The emptied chunks are kept for reuse until `lv_mem_slab_trim_all()` is called.*/
+#ifndef LV_MEM_SLAB
+    #ifdef _LV_KCONFIG_PRESENT
+        #ifdef CONFIG_LV_MEM_SLAB
+            #define LV_MEM_SLAB CONFIG_LV_MEM_SLAB
+        #else
+            #define LV_MEM_SLAB 0
+        #endif
+    #else
+        #define LV_MEM_SLAB 1
+    #endif
+#endif
+
+#if LV_USE_STDLIB_STRING == LV_STDLIB_BUILTIN
+    /*Pass the copies and fills of at least this many bytes to `LV_STRING_OFFLOAD_MEMCPY/MEMSET`, e.g. to do them with a DMA.
+     *`bool my_memcpy(void * dst, const void * src, size_t len)` and `bool my_memset(void * dst, uint8_t v, size_t len)`
+     *should return only when the data is written and visible to the CPU, or return false to let the CPU do it.
+     *The copies of `lv_memmove()` can overlap if `dst < src`. 0: to disable*/
+    #ifndef LV_STRING_OFFLOAD_SIZE
+        #ifdef CONFIG_LV_STRING_OFFLOAD_SIZE
+            #define LV_STRING_OFFLOAD_SIZE CONFIG_LV_STRING_OFFLOAD_SIZE
+        #else
+            #define LV_STRING_OFFLOAD_SIZE 0
+        #endif
+    #endif
+    #if LV_STRING_OFFLOAD_SIZE
+        #ifndef LV_STRING_OFFLOAD_INCLUDE
+            #ifdef CONFIG_LV_STRING_OFFLOAD_INCLUDE
+                #define LV_STRING_OFFLOAD_INCLUDE CONFIG_LV_STRING_OFFLOAD_INCLUDE
+            #else
+                #undef LV_STRING_OFFLOAD_INCLUDE
+            #endif
+        #endif
+        #ifndef LV_STRING_OFFLOAD_MEMCPY
+            #ifdef CONFIG_LV_STRING_OFFLOAD_MEMCPY
+                #define LV_STRING_OFFLOAD_MEMCPY CONFIG_LV_STRING_OFFLOAD_MEMCPY
+            #else
+                #undef LV_STRING_OFFLOAD_MEMCPY
+            #endif
+        #endif
+        #ifndef LV_STRING_OFFLOAD_MEMSET
+            #ifdef CONFIG_LV_STRING_OFFLOAD_MEMSET
+                #define LV_STRING_OFFLOAD_MEMSET CONFIG_LV_STRING_OFFLOAD_MEMSET
+            #else
+                #undef LV_STRING_OFFLOAD_MEMSET
+            #endif
+        #endif
+    #endif
+#endif  /*LV_USE_STDLIB_STRING == LV_STDLIB_BUILTIN*/
+
 /*====================
    HAL SETTINGS
  *====================*/
@@ -311,7 +363,7 @@
     #if LV_DRAW_SW_COMPLEX == 1
         /*Allow buffering some shadow calculation.
         *LV_DRAW_SW_SHADOW_CACHE_SIZE is the max. shadow size to buffer, where shadow size is `shadow_width + radius`
-        *Caching has LV_DRAW_SW_SHADOW_CACHE_SIZE^2 RAM cost*/
+        *Caching has up to 2 * LV_DRAW_SW_SHADOW_CACHE_SIZE^2 RAM cost per entry*/
         #ifndef LV_DRAW_SW_SHADOW_CACHE_SIZE
             #ifdef CONFIG_LV_DRAW_SW_SHADOW_CACHE_SIZE
                 #define LV_DRAW_SW_SHADOW_CACHE_SIZE CONFIG_LV_DRAW_SW_SHADOW_CACHE_SIZE
@@ -320,10 +372,19 @@
             #endif
         #endif
 
+        /*Number of different shadows (shadow width, radius and size) to cache*/
+        #ifndef LV_DRAW_SW_SHADOW_CACHE_CNT
+            #ifdef CONFIG_LV_DRAW_SW_SHADOW_CACHE_CNT
+                #define LV_DRAW_SW_SHADOW_CACHE_CNT CONFIG_LV_DRAW_SW_SHADOW_CACHE_CNT
+            #else
+                #define LV_DRAW_SW_SHADOW_CACHE_CNT 4
+            #endif
+        #endif
+
         /* Set number of maximally cached circle data.
         * The circumference of 1/4 circle are saved for anti-aliasing
-        * radius * 4 bytes are used per circle (the most often used radiuses are saved)
-        * 0: to disable caching */
+        * radius * 6 bytes are used per circle (the most often used radiuses are saved)
+        * The circles are kept between the refreshes */
         #ifndef LV_DRAW_SW_CIRCLE_CACHE_SIZE
             #ifdef CONFIG_LV_DRAW_SW_CIRCLE_CACHE_SIZE
                 #define LV_DRAW_SW_CIRCLE_CACHE_SIZE CONFIG_LV_DRAW_SW_CIRCLE_CACHE_SIZE
@@ -810,6 +871,20 @@
     #endif
 #endif
 
+/* In LV_DISPLAY_RENDER_MODE_DIRECT move the rendered pixels of a scrolled opaque container
+ * in the draw buffer and render only the newly visible part */
+#ifndef LV_SCROLL_BLIT
+    #ifdef _LV_KCONFIG_PRESENT
+        #ifdef CONFIG_LV_SCROLL_BLIT
+            #define LV_SCROLL_BLIT CONFIG_LV_SCROLL_BLIT
+        #else
+            #define LV_SCROLL_BLIT 0
+        #endif
+    #else
+        #define LV_SCROLL_BLIT          1
+    #endif
+#endif
+
 /* Add `id` field to `lv_obj_t` */
 #ifndef LV_USE_OBJ_ID
     #ifdef CONFIG_LV_USE_OBJ_ID
@@ -1246,6 +1321,16 @@
     #endif
 #endif
 
+/*Size of the cache of decompressed glyphs in bytes, the least recently used glyphs are dropped first.
+ *Compressed glyphs are decompressed on every draw without it. 0: to disable caching*/
+#ifndef LV_FONT_FMT_TXT_CACHE_SIZE
+    #ifdef CONFIG_LV_FONT_FMT_TXT_CACHE_SIZE
+        #define LV_FONT_FMT_TXT_CACHE_SIZE CONFIG_LV_FONT_FMT_TXT_CACHE_SIZE
+    #else
+        #define LV_FONT_FMT_TXT_CACHE_SIZE 0
+    #endif
+#endif
+
 /*Enable drawing placeholders when glyph dsc is not found*/
 #ifndef LV_USE_FONT_PLACEHOLDER
     #ifdef _LV_KCONFIG_PRESENT
@@ -1614,6 +1699,17 @@
             #define LV_LABEL_LONG_TXT_HINT 1  /*Store some extra info in labels to speed up drawing of very long texts*/
         #endif
     #endif
+    #ifndef LV_LABEL_LINE_CACHE
+        #ifdef _LV_KCONFIG_PRESENT
+            #ifdef CONFIG_LV_LABEL_LINE_CACHE
+                #define LV_LABEL_LINE_CACHE CONFIG_LV_LABEL_LINE_CACHE
+            #else
+                #define LV_LABEL_LINE_CACHE 0
+            #endif
+        #else
+            #define LV_LABEL_LINE_CACHE 1     /*Keep the line breaks and letter widths (12 bytes/line + 2 bytes/letter) to draw without measuring the text*/
+        #endif
+    #endif
     #ifndef LV_LABEL_WAIT_CHAR_COUNT
         #ifdef CONFIG_LV_LABEL_WAIT_CHAR_COUNT
             #define LV_LABEL_WAIT_CHAR_COUNT CONFIG_LV_LABEL_WAIT_CHAR_COUNT
@@ -27,6 +27,13 @@ extern "C" {
  * GLOBAL PROTOTYPES
  **********************/
 void lv_image_cache_drop(const void * src);
+
+/**
+ * Drop the cached header of an image source.
+ * Needed if the image is changed in place, e.g. a buffer is freed and allocated again with an other size.
+ * @param src   the image source, or NULL to drop all the headers
+ */
+void lv_image_header_cache_drop(const void * src);
 /*************************
  *    GLOBAL VARIABLES
  *************************/
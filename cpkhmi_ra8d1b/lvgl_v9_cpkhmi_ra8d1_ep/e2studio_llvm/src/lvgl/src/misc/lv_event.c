@@ -10,6 +10,7 @@
 #include "../core/lv_global.h"
 #include "../stdlib/lv_mem.h"
 #include "lv_assert.h"
+#include "lv_math.h"
 #include <stddef.h>
 
 /*********************
@@ -19,6 +20,9 @@
 #define event_head LV_GLOBAL_DEFAULT()->event_header
 #define event_last_id LV_GLOBAL_DEFAULT()->event_last_register_id
 
+/*Bit of the event code in `code_mask`. The last bit is shared by all the larger codes.*/
+#define EVENT_CODE_BIT(code) ((uint64_t)1 << LV_MIN((uint32_t)(code), 63U))
+
 /**********************
  *      TYPEDEFS
  **********************/
@@ -26,6 +30,7 @@
 /**********************
  *  STATIC PROTOTYPES
  **********************/
+static void mask_add(lv_event_list_t * list, lv_event_code_t filter);
 
 /**********************
  *  STATIC VARIABLES
@@ -64,9 +69,13 @@ lv_result_t lv_event_send(lv_event_list_t * list, lv_event_t * e, bool preproces
 {
     if(list == NULL) return LV_RESULT_OK;
 
+    /*Most of the events (e.g. drawing, cover check) have no callback: skip them without walking the list*/
+    uint64_t mask = preprocess ? list->preprocess_code_mask : list->code_mask;
+    if((mask & EVENT_CODE_BIT(e->code)) == 0) return LV_RESULT_OK;
+
     uint32_t i = 0;
-    lv_event_dsc_t * dsc = lv_array_at(list, 0);
-    for(i = 0; i < lv_array_size(list); i++) {
+    lv_event_dsc_t * dsc = lv_array_at(&list->array, 0);
+    for(i = 0; i < lv_array_size(&list->array); i++) {
         if(dsc[i].cb == NULL) continue;
         bool is_preprocessed = (dsc[i].filter & LV_EVENT_PREPROCESS) != 0;
         if(is_preprocessed != preprocess) continue;
@@ -92,24 +101,25 @@ void lv_event_add(lv_event_list_t * list, lv_event_cb_t cb, lv_event_code_t filt
     dsc.filter = filter;
     dsc.user_data = user_data;
 
-    if(lv_array_size(list) == 0) {
+    if(lv_array_size(&list->array) == 0) {
         /*event list hasn't been initialized.*/
-        lv_array_init(list, 1, sizeof(lv_event_dsc_t));
+        lv_array_init(&list->array, 1, sizeof(lv_event_dsc_t));
     }
 
-    lv_array_push_back(list, &dsc);
+    lv_array_push_back(&list->array, &dsc);
+    mask_add(list, filter);
 }
 
 uint32_t lv_event_get_count(lv_event_list_t * list)
 {
     LV_ASSERT_NULL(list);
-    return lv_array_size(list);
+    return lv_array_size(&list->array);
 }
 
 lv_event_dsc_t * lv_event_get_dsc(lv_event_list_t * list, uint32_t index)
 {
     LV_ASSERT_NULL(list);
-    return lv_array_at(list, index);
+    return lv_array_at(&list->array, index);
 }
 
 lv_event_cb_t lv_event_dsc_get_cb(lv_event_dsc_t * dsc)
@@ -128,13 +138,33 @@ void * lv_event_dsc_get_user_data(lv_event_dsc_t * dsc)
 bool lv_event_remove(lv_event_list_t * list, uint32_t index)
 {
     LV_ASSERT_NULL(list);
-    return lv_array_remove(list, index);
+    if(lv_array_remove(&list->array, index) != LV_RESULT_OK) return false;
+
+    /*Another descriptor might use the same code so build the masks again*/
+    list->code_mask = 0;
+    list->preprocess_code_mask = 0;
+    uint32_t i;
+    lv_event_dsc_t * dsc = lv_array_at(&list->array, 0);
+    for(i = 0; i < lv_array_size(&list->array); i++) {
+        mask_add(list, dsc[i].filter);
+    }
+
+    return true;
 }
 
 void lv_event_remove_all(lv_event_list_t * list)
 {
     LV_ASSERT_NULL(list);
-    lv_array_deinit(list);
+    lv_array_deinit(&list->array);
+    list->code_mask = 0;
+    list->preprocess_code_mask = 0;
+}
+
+bool lv_event_list_has_code(const lv_event_list_t * list, lv_event_code_t code)
+{
+    LV_ASSERT_NULL(list);
+    uint64_t bit = EVENT_CODE_BIT(code);
+    return ((list->code_mask | list->preprocess_code_mask) & bit) != 0;
 }
 
 void * lv_event_get_current_target(lv_event_t * e)
@@ -191,3 +221,12 @@ void _lv_event_mark_deleted(void * target)
 /**********************
  *   STATIC FUNCTIONS
  **********************/
+
+static void mask_add(lv_event_list_t * list, lv_event_code_t filter)
+{
+    lv_event_code_t code = filter & ~LV_EVENT_PREPROCESS;
+    uint64_t bit = code == LV_EVENT_ALL ? UINT64_MAX : EVENT_CODE_BIT(code);
+
+    if(filter & LV_EVENT_PREPROCESS) list->preprocess_code_mask |= bit;
+    else list->code_mask |= bit;
+}
@@ -53,6 +53,8 @@ typedef struct {
         uint32_t flush_start;
         uint32_t flush_elaps_sum;
         uint32_t flush_cnt;
+        uint32_t layout_elaps_sum;
+        uint32_t layout_cnt;
     } measured;
 
     struct {
@@ -61,6 +63,7 @@ typedef struct {
         uint32_t refr_avg_time;
         uint32_t render_avg_time;       /**< Pure rendering time without flush time*/
         uint32_t flush_avg_time;        /**< Pure flushing time without rendering time*/
+        uint32_t layout_avg_time;       /**< Time of a layout update which had something to do*/
         uint32_t cpu_avg_total;
         uint32_t fps_avg_total;
         uint32_t run_cnt;
@@ -0,0 +1,80 @@
+/**
+ * @file lv_string_builtin_mve.h
+ *
+ */
+
+#ifndef LV_STRING_BUILTIN_MVE_H
+#define LV_STRING_BUILTIN_MVE_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*********************
+ *      INCLUDES
+ *********************/
+#include <stdint.h>
+#include <stddef.h>
+
+/*********************
+ *      DEFINES
+ *********************/
+
+#define LV_STRING_MEMCPY(dst, src, len) \
+    _lv_string_memcpy_mve(dst, src, len)
+
+#define LV_STRING_MEMSET(dst, v, len) \
+    _lv_string_memset_mve(dst, v, len)
+
+/**********************
+ *      MACROS
+ **********************/
+
+/**********************
+ *      TYPEDEFS
+ **********************/
+
+/**********************
+ * GLOBAL PROTOTYPES
+ **********************/
+
+/*Copy 16 bytes at once. Byte loads and stores have no alignment requirement,
+ *so `dst` and `src` can be aligned differently. The tail is predicated.*/
+static inline void _lv_string_memcpy_mve(uint8_t * dst, const uint8_t * src, size_t len)
+{
+    __asm volatile(
+        ".p2align 2                                             \n"
+        "wlstp.8            lr, %[len], 1f                      \n"
+        "2:                                                     \n"
+        "vldrb.u8           q0, [%[src]], #16                   \n"
+        "vstrb.8            q0, [%[dst]], #16                   \n"
+        "letp               lr, 2b                              \n"
+        "1:                                                     \n"
+        : [dst] "+r"(dst),
+        [src] "+r"(src)
+        : [len] "r"(len)
+        : "q0", "memory", "r14", "cc");
+}
+
+/*Fill 16 bytes at once, the tail is predicated*/
+static inline void _lv_string_memset_mve(uint8_t * dst, uint8_t v, size_t len)
+{
+    __asm volatile(
+        ".p2align 2                                             \n"
+        "vdup.8             q0, %[v]                            \n"
+        "wlstp.8            lr, %[len], 1f                      \n"
+        "2:                                                     \n"
+        "vstrb.8            q0, [%[dst]], #16                   \n"
+        "letp               lr, 2b                              \n"
+        "1:                                                     \n"
+        : [dst] "+r"(dst)
+        : [len] "r"(len),
+        [v] "r"((uint32_t)v)
+        : "q0", "memory", "r14", "cc");
+}
+
+#ifdef __cplusplus
+} /*extern "C"*/
+#endif
+
+#endif /*LV_STRING_BUILTIN_MVE_H*/
@@ -6,6 +6,7 @@
  *      INCLUDES
  *********************/
 #include "lv_mem.h"
+#include "lv_mem_slab.h"
 #include "lv_string.h"
 #include "../misc/lv_assert.h"
 #include "../misc/lv_log.h"
@@ -161,6 +162,14 @@ void lv_mem_monitor(lv_mem_monitor_t * mon_p)
 {
     lv_memzero(mon_p, sizeof(lv_mem_monitor_t));
     lv_mem_monitor_core(mon_p);
+
+    lv_mem_slab_t * slab = lv_mem_slab_get_next(NULL);
+    while(slab) {
+        uint32_t slab_size = slab->chunk_cnt * slab->block_cnt * slab->block_size;
+        mon_p->slab_size += slab_size;
+        mon_p->slab_free_size += slab_size - slab->used_cnt * slab->block_size;
+        slab = lv_mem_slab_get_next(slab);
+    }
 }
 
 /**********************
@@ -43,6 +43,8 @@ typedef struct {
     uint32_t max_used; /**< Max size of Heap memory used*/
     uint8_t used_pct; /**< Percentage used*/
     uint8_t frag_pct; /**< Amount of fragmentation*/
+    uint32_t slab_size; /**< Size of the blocks of the slabs. It's part of the used heap memory.*/
+    uint32_t slab_free_size; /**< Size of the unused blocks of the slabs*/
 } lv_mem_monitor_t;
 
 /**********************
@@ -126,7 +128,8 @@ lv_result_t lv_mem_test_core(void);
 lv_result_t lv_mem_test(void);
 
 /**
- * Give information about the work memory of dynamic allocation
+ * Give information about the work memory of dynamic allocation.
+ * The empty slab chunks are counted as free slab memory, call `lv_mem_slab_trim_all()` first to release them.
  * @param mon_p pointer to a lv_mem_monitor_t variable,
  *              the result of the analysis will be stored here
  */
@@ -0,0 +1,304 @@
+/**
+ * @file lv_mem_slab.c
+ *
+ */
+
+/*********************
+ *      INCLUDES
+ *********************/
+#include "lv_mem_slab.h"
+#include "lv_mem.h"
+#include "lv_string.h"
+#include "../misc/lv_assert.h"
+#include "../misc/lv_math.h"
+#include "../core/lv_global.h"
+
+/*********************
+ *      DEFINES
+ *********************/
+/*memset the freed blocks to 0xbb (just for testing purposes)*/
+#ifndef LV_MEM_ADD_JUNK
+    #define LV_MEM_ADD_JUNK  0
+#endif
+
+#define slab_head LV_GLOBAL_DEFAULT()->mem_slab_head
+
+/*The built-in heap aligns the allocations to the size of a pointer too*/
+#define BLOCK_ALIGN         sizeof(void *)
+#define CHUNK_HEADER_SIZE   LV_ALIGN_UP(sizeof(chunk_t), BLOCK_ALIGN)
+
+/*Each block starts with a pointer to its chunk, or NULL if it was allocated on the heap*/
+#define BLOCK_HEADER_SIZE   LV_ALIGN_UP(sizeof(chunk_t *), BLOCK_ALIGN)
+#define BLOCK_STRIDE(slab)  (BLOCK_HEADER_SIZE + (slab)->block_size)
+
+/**********************
+ *      TYPEDEFS
+ **********************/
+
+/*The header of the chunks. It's followed by the blocks.*/
+typedef struct _chunk_t {
+    struct _chunk_t * next;
+    uint32_t free_cnt;      /*Counted only when trimming*/
+} chunk_t;
+
+/**********************
+ *  STATIC PROTOTYPES
+ **********************/
+static bool add_chunk(lv_mem_slab_t * slab);
+static void * heap_alloc(lv_mem_slab_t * slab, size_t size);
+static inline chunk_t ** get_header(const void * data);
+
+/**********************
+ *  STATIC VARIABLES
+ **********************/
+
+/**********************
+ *      MACROS
+ **********************/
+
+/**********************
+ *   GLOBAL FUNCTIONS
+ **********************/
+
+void lv_mem_slab_init(lv_mem_slab_t * slab, const char * name, uint32_t block_size, uint32_t block_cnt)
+{
+    LV_ASSERT_NULL(slab);
+    LV_ASSERT(block_cnt > 0);
+
+    lv_memzero(slab, sizeof(lv_mem_slab_t));
+    slab->name = name;
+
+    /*The free blocks store the pointer to the next free block*/
+    block_size = LV_MAX(block_size, sizeof(void *));
+    slab->block_size = LV_ALIGN_UP(block_size, BLOCK_ALIGN);
+    slab->block_cnt = block_cnt;
+
+    slab->next = slab_head;
+    slab_head = slab;
+}
+
+void lv_mem_slab_deinit(lv_mem_slab_t * slab)
+{
+    LV_ASSERT_NULL(slab);
+
+    chunk_t * chunk = slab->chunk_head;
+    while(chunk) {
+        chunk_t * next = chunk->next;
+        lv_free(chunk);
+        chunk = next;
+    }
+
+    lv_mem_slab_t ** s = &slab_head;
+    while(*s) {
+        if(*s == slab) {
+            *s = slab->next;
+            break;
+        }
+        s = &(*s)->next;
+    }
+
+    lv_memzero(slab, sizeof(lv_mem_slab_t));
+}
+
+void * lv_mem_slab_alloc(lv_mem_slab_t * slab, size_t size)
+{
+    LV_ASSERT_NULL(slab);
+
+    if(LV_MEM_SLAB == 0 || size > slab->block_size) return heap_alloc(slab, size);
+
+    if(slab->free_head == NULL) {
+        if(!add_chunk(slab)) return NULL;
+    }
+
+    void * block = slab->free_head;
+    slab->free_head = *(void **)block;
+
+    slab->used_cnt++;
+    slab->max_used_cnt = LV_MAX(slab->max_used_cnt, slab->used_cnt);
+    slab->alloc_cnt++;
+
+    return block;
+}
+
+void * lv_mem_slab_alloc_zeroed(lv_mem_slab_t * slab, size_t size)
+{
+    void * data = lv_mem_slab_alloc(slab, size);
+    if(data) lv_memzero(data, size);
+    return data;
+}
+
+void * lv_mem_slab_realloc(lv_mem_slab_t * slab, void * data, size_t new_size)
+{
+    LV_ASSERT_NULL(slab);
+
+    if(new_size == 0) {
+        lv_mem_slab_free(slab, data);
+        return NULL;
+    }
+
+    if(data == NULL) return lv_mem_slab_alloc(slab, new_size);
+
+    if(*get_header(data)) {
+        if(new_size <= slab->block_size) return data;
+
+        void * new_data = lv_mem_slab_alloc(slab, new_size);
+        if(new_data == NULL) return NULL;
+        lv_memcpy(new_data, data, slab->block_size);
+        lv_mem_slab_free(slab, data);
+        return new_data;
+    }
+
+    /*It was allocated on the heap because it was larger than a block*/
+    if(LV_MEM_SLAB == 0 || new_size > slab->block_size) {
+        chunk_t ** header = lv_realloc(get_header(data), BLOCK_HEADER_SIZE + new_size);
+        if(header == NULL) return NULL;
+        return (uint8_t *)header + BLOCK_HEADER_SIZE;
+    }
+
+    void * new_data = lv_mem_slab_alloc(slab, new_size);
+    if(new_data == NULL) return NULL;
+    lv_memcpy(new_data, data, new_size);
+    lv_free(get_header(data));
+    return new_data;
+}
+
+void lv_mem_slab_free(lv_mem_slab_t * slab, void * data)
+{
+    LV_ASSERT_NULL(slab);
+    if(data == NULL) return;
+
+    if(*get_header(data) == NULL) {
+        lv_free(get_header(data));
+        return;
+    }
+
+#if LV_MEM_ADD_JUNK
+    lv_memset(data, 0xbb, slab->block_size);
+#endif
+
+    *(void **)data = slab->free_head;
+    slab->free_head = data;
+
+    slab->used_cnt--;
+}
+
+uint32_t lv_mem_slab_trim(lv_mem_slab_t * slab)
+{
+    LV_ASSERT_NULL(slab);
+
+    /*All blocks are free, so all chunks can be freed*/
+    if(slab->used_cnt == 0) {
+        uint32_t freed = slab->chunk_cnt * (CHUNK_HEADER_SIZE + BLOCK_STRIDE(slab) * slab->block_cnt);
+        chunk_t * chunk = slab->chunk_head;
+        while(chunk) {
+            chunk_t * next = chunk->next;
+            lv_free(chunk);
+            chunk = next;
+        }
+        slab->chunk_head = NULL;
+        slab->free_head = NULL;
+        slab->chunk_cnt = 0;
+        return freed;
+    }
+
+    /*There can't be a chunk with only free blocks*/
+    uint32_t free_cnt = slab->chunk_cnt * slab->block_cnt - slab->used_cnt;
+    if(free_cnt < slab->block_cnt) return 0;
+
+    chunk_t * chunk;
+    for(chunk = slab->chunk_head; chunk; chunk = chunk->next) {
+        chunk->free_cnt = 0;
+    }
+
+    void * b;
+    for(b = slab->free_head; b; b = *(void **)b) {
+        (*get_header(b))->free_cnt++;
+    }
+
+    /*Remove the blocks of the empty chunks from the free list*/
+    void ** b_prev = &slab->free_head;
+    while(*b_prev) {
+        if((*get_header(*b_prev))->free_cnt == slab->block_cnt) *b_prev = *(void **)(*b_prev);
+        else b_prev = (void **)(*b_prev);
+    }
+
+    uint32_t freed = 0;
+    chunk_t ** c = (chunk_t **)&slab->chunk_head;
+    while(*c) {
+        chunk = *c;
+        if(chunk->free_cnt == slab->block_cnt) {
+            *c = chunk->next;
+            lv_free(chunk);
+            slab->chunk_cnt--;
+            freed += CHUNK_HEADER_SIZE + BLOCK_STRIDE(slab) * slab->block_cnt;
+        }
+        else {
+            c = &chunk->next;
+        }
+    }
+
+    return freed;
+}
+
+uint32_t lv_mem_slab_trim_all(void)
+{
+    uint32_t freed = 0;
+    lv_mem_slab_t * slab;
+    for(slab = slab_head; slab; slab = slab->next) {
+        freed += lv_mem_slab_trim(slab);
+    }
+
+    return freed;
+}
+
+lv_mem_slab_t * lv_mem_slab_get_next(const lv_mem_slab_t * slab)
+{
+    if(slab == NULL) return slab_head;
+    else return slab->next;
+}
+
+/**********************
+ *   STATIC FUNCTIONS
+ **********************/
+
+static bool add_chunk(lv_mem_slab_t * slab)
+{
+    uint32_t chunk_size = CHUNK_HEADER_SIZE + BLOCK_STRIDE(slab) * slab->block_cnt;
+    chunk_t * chunk = lv_malloc(chunk_size);
+
+    /*Free the empty chunks of the other slabs and try again*/
+    if(chunk == NULL && lv_mem_slab_trim_all() > 0) chunk = lv_malloc(chunk_size);
+    if(chunk == NULL) return false;
+
+    chunk->free_cnt = 0;
+    chunk->next = slab->chunk_head;
+    slab->chunk_head = chunk;
+    slab->chunk_cnt++;
+
+    /*Add the blocks in reverse order to allocate them in order*/
+    uint8_t * blocks = (uint8_t *)chunk + CHUNK_HEADER_SIZE;
+    int32_t i;
+    for(i = slab->block_cnt - 1; i >= 0; i--) {
+        void * block = blocks + i * BLOCK_STRIDE(slab) + BLOCK_HEADER_SIZE;
+        *get_header(block) = chunk;
+        *(void **)block = slab->free_head;
+        slab->free_head = block;
+    }
+
+    return true;
+}
+
+static void * heap_alloc(lv_mem_slab_t * slab, size_t size)
+{
+    chunk_t ** header = lv_malloc(BLOCK_HEADER_SIZE + size);
+    if(header == NULL) return NULL;
+
+    *header = NULL;
+    slab->heap_alloc_cnt++;
+    return (uint8_t *)header + BLOCK_HEADER_SIZE;
+}
+
+static inline chunk_t ** get_header(const void * data)
+{
+    return (chunk_t **)((uint8_t *)data - BLOCK_HEADER_SIZE);
+}
@@ -76,12 +76,24 @@ typedef _lv_chart_axis_t lv_chart_axis_t;
 typedef uint8_t lv_chart_axis_t;
 #endif /*DOXYGEN*/
 
+/**
+ * Lock-free ring buffer to pass samples to a series from an other task or interrupt.
+ * There can be only one producer (`lv_chart_stream_push`) and the chart is the only consumer.
+ */
+typedef struct {
+    int32_t * buf;
+    uint32_t size;              /**< Size of `buf` in elements. At most `size - 1` samples can wait in the stream*/
+    volatile uint32_t head;     /**< Written only by the producer*/
+    volatile uint32_t tail;     /**< Written only by the chart*/
+} lv_chart_stream_t;
+
 /**
  * Descriptor a chart series
  */
 typedef struct {
     int32_t * x_points;
     int32_t * y_points;
+    lv_chart_stream_t * stream;
     lv_color_t color;
     uint32_t start_point;
     uint32_t hidden : 1;
@@ -112,6 +124,7 @@ typedef struct {
     uint32_t hdiv_cnt;      /**< Number of horizontal division lines*/
     uint32_t vdiv_cnt;      /**< Number of vertical division lines*/
     uint32_t point_cnt;    /**< Point number in a data line*/
+    lv_timer_t * stream_timer;  /**< Moves the samples from the streams to the series*/
     lv_chart_type_t type  : 3; /**< Line or column chart*/
     lv_chart_update_mode_t update_mode : 1;
 } lv_chart_t;
@@ -315,6 +328,16 @@ void lv_chart_set_all_value(lv_obj_t * obj, lv_chart_series_t * ser, int32_t val
  */
 void lv_chart_set_next_value(lv_obj_t * obj, lv_chart_series_t * ser, int32_t value);
 
+/**
+ * Add more Y values to a series according to the update mode policy.
+ * Works like calling `lv_chart_set_next_value` for each value but the chart is invalidated only once.
+ * @param obj       pointer to chart object
+ * @param ser       pointer to a data series on 'chart'
+ * @param values    the new values, the last one will be the newest point
+ * @param cnt       number of values. If more than the point count only the last values are used.
+ */
+void lv_chart_set_next_values(lv_obj_t * obj, lv_chart_series_t * ser, const int32_t values[], uint32_t cnt);
+
 /**
  * Set the next point's X and Y value according to the update mode policy.
  * @param obj       pointer to chart object
@@ -363,6 +386,35 @@ void lv_chart_set_ext_y_array(lv_obj_t * obj, lv_chart_series_t * ser, int32_t a
  */
 void lv_chart_set_ext_x_array(lv_obj_t * obj, lv_chart_series_t * ser, int32_t array[]);
 
+/**
+ * Initialize a stream to feed a series with samples from an other task or interrupt.
+ * @param stream    pointer to a stream, it needs to be static, global or dynamically allocated
+ * @param buf       buffer to store `size` samples. Should be large enough to hold the samples of a display refresh period.
+ * @param size      number of elements in `buf`, must be at least 2 as one element is always kept free
+ */
+void lv_chart_stream_init(lv_chart_stream_t * stream, int32_t buf[], uint32_t size);
+
+/**
+ * Add samples to a stream. Doesn't call any LVGL functions so it can be used from an interrupt (e.g. ADC DMA complete)
+ * or an other task while LVGL is running. Only one task/interrupt can push to a stream.
+ * @param stream    pointer to an initialized stream
+ * @param values    the samples to add
+ * @param cnt       number of samples
+ * @return          number of samples added. Less than `cnt` if the stream is full.
+ */
+uint32_t lv_chart_stream_push(lv_chart_stream_t * stream, const int32_t values[], uint32_t cnt);
+
+/**
+ * Feed a series from a stream. The chart moves the samples from the stream to the series
+ * in every display refresh period as `lv_chart_set_next_values` would do.
+ * The timer moving the samples runs only while a stream is attached to the chart.
+ * @param obj       pointer to a chart object
+ * @param ser       pointer to a data series on 'chart'
+ * @param stream    pointer to an initialized stream or NULL to detach the stream.
+ *                  A stream with a zero `size` is not attached.
+ */
+void lv_chart_set_series_stream(lv_obj_t * obj, lv_chart_series_t * ser, lv_chart_stream_t * stream);
+
 /**
  * Get the array of y values of a series
  * @param obj   pointer to a chart object
@@ -0,0 +1,69 @@
+/**
+ * @file lv_chart_mve.h
+ *
+ */
+
+#ifndef LV_CHART_MVE_H
+#define LV_CHART_MVE_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*********************
+ *      INCLUDES
+ *********************/
+#include <stdint.h>
+
+/*********************
+ *      DEFINES
+ *********************/
+
+#define LV_CHART_MIN_MAX(values, cnt, none, min, max) \
+    _lv_chart_min_max_mve(values, cnt, none, min, max)
+
+/**********************
+ *      MACROS
+ **********************/
+
+/**********************
+ *      TYPEDEFS
+ **********************/
+
+/**********************
+ * GLOBAL PROTOTYPES
+ **********************/
+
+/*Update `min` and `max` with the values which are not `none`, 4 values at once*/
+static inline void _lv_chart_min_max_mve(const int32_t * values, uint32_t cnt, int32_t none, int32_t * min,
+                                         int32_t * max)
+{
+    int32_t min_act = *min;
+    int32_t max_act = *max;
+
+    __asm volatile(
+        ".p2align 2                                             \n"
+        "wlstp.32           lr, %[cnt], 1f                      \n"
+        "2:                                                     \n"
+        "vldrw.u32          q0, [%[values]], #16                \n"
+        "vptt.i32           ne, q0, %[none]                     \n"
+        "vminvt.s32         %[min], q0                          \n"
+        "vmaxvt.s32         %[max], q0                          \n"
+        "letp               lr, 2b                              \n"
+        "1:                                                     \n"
+        : [values] "+r"(values),
+        [min] "+r"(min_act),
+        [max] "+r"(max_act)
+        : [cnt] "r"(cnt),
+        [none] "r"(none)
+        : "q0", "memory", "r14", "cc");
+
+    *min = min_act;
+    *max = max_act;
+}
+
+#ifdef __cplusplus
+} /*extern "C"*/
+#endif
+
+#endif /*LV_CHART_MVE_H*/
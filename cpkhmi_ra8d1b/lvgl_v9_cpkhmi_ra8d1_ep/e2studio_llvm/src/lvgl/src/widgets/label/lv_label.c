@@ -53,6 +53,16 @@ static void set_ofs_y_anim(void * obj, int32_t v);
 static size_t get_text_length(const char * text);
 static void copy_text_to_label(lv_label_t * label, const char * text);
 static lv_text_flag_t get_label_flags(lv_label_t * label);
+#if LV_LABEL_LINE_CACHE
+    static void lines_update(lv_obj_t * obj, const lv_font_t * font, int32_t letter_space, int32_t max_w,
+                             lv_text_flag_t flag);
+    static bool lines_is_valid(lv_obj_t * obj, const lv_font_t * font, int32_t letter_space, int32_t max_w,
+                               lv_text_flag_t flag);
+    static void lines_get_size(lv_obj_t * obj, const lv_font_t * font, int32_t line_space, lv_point_t * size);
+    static void lines_free(lv_obj_t * obj);
+#endif
+static void get_text_size(lv_obj_t * obj, lv_point_t * size, const lv_font_t * font, int32_t letter_space,
+                          int32_t line_space, int32_t max_w, lv_text_flag_t flag);
 static void calculate_x_coordinate(int32_t * x, const lv_text_align_t align, const char * txt,
                                    uint32_t length, const lv_font_t * font, int32_t letter_space, lv_area_t * txt_coords);
 
@@ -100,6 +110,10 @@ void lv_label_set_text(lv_obj_t * obj, const char * text)
     /*If text is NULL then just refresh with the current text*/
     if(text == NULL) text = label->text;
 
+#if LV_LABEL_LINE_CACHE
+    lines_free(obj); /*The lines are valid only for the same text*/
+#endif
+
     const size_t text_len = get_text_length(text);
 
     /*If set its own text then reallocate it (maybe its size changed)*/
@@ -140,6 +154,9 @@ void lv_label_set_text_fmt(lv_obj_t * obj, const char * fmt, ...)
 
     lv_obj_invalidate(obj);
     lv_label_t * label = (lv_label_t *)obj;
+#if LV_LABEL_LINE_CACHE
+    lines_free(obj); /*The lines are valid only for the same text*/
+#endif
 
     /*If text is NULL then refresh*/
     if(fmt == NULL) {
@@ -165,6 +182,9 @@ void lv_label_set_text_static(lv_obj_t * obj, const char * text)
 {
     LV_ASSERT_OBJ(obj, MY_CLASS);
     lv_label_t * label = (lv_label_t *)obj;
+#if LV_LABEL_LINE_CACHE
+    lines_free(obj); /*The lines are valid only for the same text*/
+#endif
 
     if(label->static_txt == 0 && label->text != NULL) {
         lv_free(label->text);
@@ -611,6 +631,9 @@ void lv_label_cut_text(lv_obj_t * obj, uint32_t pos, uint32_t cnt)
     char * label_txt = lv_label_get_text(obj);
     /*Delete the characters*/
     _lv_text_cut(label_txt, pos, cnt);
+#if LV_LABEL_LINE_CACHE
+    lines_free(obj); /*The lines are valid only for the same text*/
+#endif
 
     /*Refresh the label*/
     lv_label_refr_text(obj);
@@ -661,6 +684,10 @@ static void lv_label_destructor(const lv_obj_class_t * class_p, lv_obj_t * obj)
     lv_label_dot_tmp_free(obj);
     if(!label->static_txt) lv_free(label->text);
     label->text = NULL;
+
+#if LV_LABEL_LINE_CACHE
+    lines_free(obj);
+#endif
 }
 
 static void lv_label_event(const lv_obj_class_t * class_p, lv_event_t * e)
@@ -742,6 +769,14 @@ static void draw_main(lv_event_t * e)
     lv_obj_init_draw_label_dsc(obj, LV_PART_MAIN, &label_draw_dsc);
     lv_bidi_calculate_align(&label_draw_dsc.align, &label_draw_dsc.bidi_dir, label->text);
 
+#if LV_LABEL_LINE_CACHE
+    /*Normally the lines were calculated when the text, style or size changed,
+     *so moving or scrolling the label doesn't measure the text again*/
+    if(lines_is_valid(obj, label_draw_dsc.font, label_draw_dsc.letter_space, lv_area_get_width(&txt_coords), flag)) {
+        label_draw_dsc.lines = &label->lines;
+    }
+#endif
+
     label_draw_dsc.sel_start = lv_label_get_text_selection_start(obj);
     label_draw_dsc.sel_end = lv_label_get_text_selection_end(obj);
     if(label_draw_dsc.sel_start != LV_DRAW_LABEL_NO_TXT_SEL && label_draw_dsc.sel_end != LV_DRAW_LABEL_NO_TXT_SEL) {
@@ -754,8 +789,8 @@ static void draw_main(lv_event_t * e)
     if((label->long_mode == LV_LABEL_LONG_SCROLL || label->long_mode == LV_LABEL_LONG_SCROLL_CIRCULAR) &&
        (label_draw_dsc.align == LV_TEXT_ALIGN_CENTER || label_draw_dsc.align == LV_TEXT_ALIGN_RIGHT)) {
         lv_point_t size;
-        lv_text_get_size(&size, label->text, label_draw_dsc.font, label_draw_dsc.letter_space, label_draw_dsc.line_space,
-                         LV_COORD_MAX, flag);
+        get_text_size(obj, &size, label_draw_dsc.font, label_draw_dsc.letter_space, label_draw_dsc.line_space,
+                      LV_COORD_MAX, flag);
         if(size.x > lv_area_get_width(&txt_coords)) {
             label_draw_dsc.align = LV_TEXT_ALIGN_LEFT;
         }
@@ -787,8 +822,8 @@ static void draw_main(lv_event_t * e)
 
     if(label->long_mode == LV_LABEL_LONG_SCROLL_CIRCULAR) {
         lv_point_t size;
-        lv_text_get_size(&size, label->text, label_draw_dsc.font, label_draw_dsc.letter_space, label_draw_dsc.line_space,
-                         LV_COORD_MAX, flag);
+        get_text_size(obj, &size, label_draw_dsc.font, label_draw_dsc.letter_space, label_draw_dsc.line_space,
+                      LV_COORD_MAX, flag);
 
         /*Draw the text again on label to the original to make a circular effect */
         if(size.x > lv_area_get_width(&txt_coords)) {
@@ -862,7 +897,11 @@ static void lv_label_refr_text(lv_obj_t * obj)
     if(label->expand != 0) flag |= LV_TEXT_FLAG_EXPAND;
     if(lv_obj_get_style_width(obj, LV_PART_MAIN) == LV_SIZE_CONTENT && !obj->w_layout) flag |= LV_TEXT_FLAG_FIT;
 
-    lv_text_get_size(&size, label->text, font, letter_space, line_space, max_w, flag);
+#if LV_LABEL_LINE_CACHE
+    /*E.g. a style change of the parent refreshes the label too, but the lines are still the same*/
+    if(!lines_is_valid(obj, font, letter_space, max_w, flag)) lines_update(obj, font, letter_space, max_w, flag);
+#endif
+    get_text_size(obj, &size, font, letter_space, line_space, max_w, flag);
 
     lv_obj_refresh_self_size(obj);
 
@@ -1114,6 +1153,9 @@ static void lv_label_refr_text(lv_obj_t * obj)
                 }
                 label->text[byte_id_ori + LV_LABEL_DOT_NUM] = '\0';
                 label->dot_end                              = letter_id + LV_LABEL_DOT_NUM;
+#if LV_LABEL_LINE_CACHE
+                lines_update(obj, font, letter_space, max_w, flag);
+#endif
             }
         }
     }
@@ -1146,6 +1188,9 @@ static void lv_label_revert_dots(lv_obj_t * obj)
     lv_label_dot_tmp_free(obj);
 
     label->dot_end = LV_LABEL_DOT_END_INV;
+#if LV_LABEL_LINE_CACHE
+    lines_free(obj); /*The lines are valid only for the same text*/
+#endif
 }
 
 /**
@@ -1255,6 +1300,158 @@ static lv_text_flag_t get_label_flags(lv_label_t * label)
     return flag;
 }
 
+#if LV_LABEL_LINE_CACHE
+
+/**
+ * Calculate the line breaks and the letter widths the same way as `lv_text_get_size` and the drawing do.
+ */
+static void lines_update(lv_obj_t * obj, const lv_font_t * font, int32_t letter_space, int32_t max_w,
+                         lv_text_flag_t flag)
+{
+    lv_label_t * label = (lv_label_t *)obj;
+    lv_draw_label_lines_t * lines = &label->lines;
+    const char * txt = label->text;
+
+    lines_free(obj);
+    if(txt == NULL || font == NULL) return;
+
+    uint32_t line_cap = 8;
+    lines->line = lv_malloc(line_cap * sizeof(lv_draw_label_line_t));
+    if(lines->line == NULL) return;
+
+    uint32_t letter_cnt = _lv_text_get_encoded_length(txt);
+#if LV_USE_BIDI == 0
+    /*With BIDI the letters are drawn in visual order so their widths are measured while drawing*/
+    if(letter_cnt > 0) lines->letter_w = lv_malloc(letter_cnt * sizeof(uint16_t));
+#endif
+
+    int32_t line_max_w = (flag & LV_TEXT_FLAG_EXPAND) ? LV_COORD_MAX : max_w;
+    uint32_t line_cnt = 0;
+    uint32_t letter_idx = 0;
+    uint32_t line_start = 0;
+    while(txt[line_start] != '\0') {
+        uint32_t line_end = line_start + _lv_text_get_next_line(&txt[line_start], font, letter_space, line_max_w, NULL, flag);
+
+        /*Keep place for the closing element too*/
+        if(line_cnt + 2 > line_cap) {
+            line_cap *= 2;
+            lv_draw_label_line_t * new_line = lv_realloc(lines->line, line_cap * sizeof(lv_draw_label_line_t));
+            if(new_line == NULL) {
+                lines_free(obj);
+                return;
+            }
+            lines->line = new_line;
+        }
+
+        /*Measure the letters as lv_text_get_width() does*/
+        int32_t w = 0;
+        uint32_t i = 0;
+        lines->line[line_cnt].start = line_start;
+        lines->line[line_cnt].letter_start = letter_idx;
+        while(i < line_end - line_start) {
+            uint32_t letter;
+            uint32_t letter_next;
+            _lv_text_encoded_letter_next_2(&txt[line_start], &letter, &letter_next, &i);
+
+            uint16_t letter_w = lv_font_get_glyph_width(font, letter, letter_next);
+            if(lines->letter_w && letter_idx < letter_cnt) lines->letter_w[letter_idx] = letter_w;
+            letter_idx++;
+
+            if(letter_w > 0) w += letter_w + letter_space;
+        }
+        if(w > 0) w -= letter_space;
+
+        lines->line[line_cnt].w = w;
+        line_cnt++;
+        line_start = line_end;
+    }
+
+    lines->line[line_cnt].start = line_start;
+    lines->line[line_cnt].letter_start = letter_idx;
+    lines->line[line_cnt].w = 0;
+    lines->line_cnt = line_cnt;
+    lines->font = font;
+    lines->letter_space = letter_space;
+    lines->max_w = max_w;
+    lines->flag = flag;
+
+    /*Only a broken UTF-8 text can be counted differently; measure its letters while drawing*/
+    if(lines->letter_w && letter_idx != letter_cnt) {
+        lv_free(lines->letter_w);
+        lines->letter_w = NULL;
+    }
+}
+
+static bool lines_is_valid(lv_obj_t * obj, const lv_font_t * font, int32_t letter_space, int32_t max_w,
+                           lv_text_flag_t flag)
+{
+    lv_label_t * label = (lv_label_t *)obj;
+    const lv_draw_label_lines_t * lines = &label->lines;
+
+    if(lines->line == NULL || label->text == NULL) return false;
+    if(lines->font != font || lines->letter_space != letter_space || lines->flag != flag) return false;
+    /*The width doesn't matter if the lines are not wrapped*/
+    if((flag & LV_TEXT_FLAG_EXPAND) == 0 && lines->max_w != max_w) return false;
+
+    /*The text might have been modified directly in its buffer*/
+    return lines->line[lines->line_cnt].start == lv_strlen(label->text);
+}
+
+/**
+ * Get the size of the text from the lines as `lv_text_get_size` would calculate it.
+ */
+static void lines_get_size(lv_obj_t * obj, const lv_font_t * font, int32_t line_space, lv_point_t * size)
+{
+    lv_label_t * label = (lv_label_t *)obj;
+    const lv_draw_label_lines_t * lines = &label->lines;
+    int32_t letter_height = lv_font_get_line_height(font);
+
+    size->x = 0;
+    size->y = 0;
+    uint32_t i;
+    for(i = 0; i < lines->line_cnt; i++) {
+        size->x = LV_MAX(size->x, lines->line[i].w);
+        size->y += letter_height + line_space;
+    }
+
+    /*Make the text one line taller if the last character is '\n' or '\r'*/
+    uint32_t len = lines->line[lines->line_cnt].start;
+    if(len != 0 && (label->text[len - 1] == '\n' || label->text[len - 1] == '\r')) {
+        size->y += letter_height + line_space;
+    }
+
+    /*Correction with the last line space or set the height manually if the text is empty*/
+    if(size->y == 0) size->y = letter_height;
+    else size->y -= line_space;
+}
+
+static void lines_free(lv_obj_t * obj)
+{
+    lv_label_t * label = (lv_label_t *)obj;
+    lv_free(label->lines.line);
+    lv_free(label->lines.letter_w);
+    lv_memzero(&label->lines, sizeof(lv_draw_label_lines_t));
+}
+
+#endif /*LV_LABEL_LINE_CACHE*/
+
+/**
+ * Get the size of the label's text. Use the calculated lines if they are still valid.
+ */
+static void get_text_size(lv_obj_t * obj, lv_point_t * size, const lv_font_t * font, int32_t letter_space,
+                          int32_t line_space, int32_t max_w, lv_text_flag_t flag)
+{
+    lv_label_t * label = (lv_label_t *)obj;
+#if LV_LABEL_LINE_CACHE
+    if(lines_is_valid(obj, font, letter_space, max_w, flag)) {
+        lines_get_size(obj, font, line_space, size);
+        return;
+    }
+#endif
+
+    lv_text_get_size(size, label->text, font, letter_space, line_space, max_w, flag);
+}
+
 /* Function created because of this pattern be used in multiple functions */
 static void calculate_x_coordinate(int32_t * x, const lv_text_align_t align, const char * txt, uint32_t length,
                                    const lv_font_t * font, int32_t letter_space, lv_area_t * txt_coords)
@@ -55,6 +55,13 @@ typedef struct {
     char txt[];
 } lv_table_cell_t;
 
+/**
+ * Provide the text of a cell in data source mode.
+ * It's called only for the visible cells while drawing, the returned string needs to be valid only until the next call.
+ * Return NULL or "" for an empty cell.
+ */
+typedef const char * (*lv_table_cell_value_cb_t)(lv_obj_t * obj, uint32_t row, uint32_t col, void * user_data);
+
 /*Data of table*/
 typedef struct {
     lv_obj_t obj;
@@ -62,9 +69,13 @@ typedef struct {
     uint32_t row_cnt;
     lv_table_cell_t ** cell_data;
     int32_t * row_h;
+    int32_t * row_h_sum;    /**< Fenwick tree of the row heights to find a row by coordinate in O(log n)*/
     int32_t * col_w;
     uint32_t col_act;
     uint32_t row_act;
+    lv_table_cell_value_cb_t cell_value_cb;
+    void * cell_value_cb_user_data;
+    int32_t virtual_row_h;  /**< Height of every row in data source mode*/
 } lv_table_t;
 
 LV_ATTRIBUTE_EXTERN_DATA extern const lv_obj_class_t lv_table_class;
@@ -157,6 +168,19 @@ void lv_table_clear_cell_ctrl(lv_obj_t * obj, uint32_t row, uint32_t col, lv_tab
  */
 void lv_table_set_cell_user_data(lv_obj_t * obj, uint16_t row, uint16_t col, void * user_data);
 
+/**
+ * Switch the table to data source mode. The cells are not stored but `cb` is called to get the text of the visible cells.
+ * The table doesn't allocate anything per row, so the number of rows can be very large.
+ * All the rows have the same height (one line of text and the paddings) and the texts are cropped.
+ * Storing values, control bits and user data of the cells is not supported in this mode.
+ * @param obj       pointer to a Table object
+ * @param cb        the callback to get the cells' text or NULL to go back to storing the cells.
+ *                  The cells are cleared in both cases.
+ * @param user_data custom data passed to `cb`
+ * @note            Use `lv_table_set_row_count` to set the number of rows and `lv_obj_invalidate` if the data has changed
+ */
+void lv_table_set_cell_value_cb(lv_obj_t * obj, lv_table_cell_value_cb_t cb, void * user_data);
+
 /*=====================
  * Getter functions
  *====================*/
@@ -1,5 +1,5 @@
 #define LV_MEM_SIZE         (32 * 1024 * 1024)
-#define LV_SHADOW_CACHE_SIZE    (8 * 1024)
+#define LV_DRAW_SW_SHADOW_CACHE_SIZE    64
 #define LV_USE_LOG              1
 #define LV_LOG_LEVEL            LV_LOG_LEVEL_TRACE
 #define LV_LOG_PRINTF           1
@@ -41,6 +41,7 @@
 #define LV_FONT_DEFAULT         &lv_font_montserrat_14
 #define LV_FONT_FMT_TXT_LARGE   1
 #define LV_USE_FONT_COMPRESSED  1
+#define LV_FONT_FMT_TXT_CACHE_SIZE  (16 * 1024)
 #define LV_USE_BIDI 1
 #define LV_USE_ARABIC_PERSIAN_CHARS 1
 #define LV_USE_PERF_MONITOR         1
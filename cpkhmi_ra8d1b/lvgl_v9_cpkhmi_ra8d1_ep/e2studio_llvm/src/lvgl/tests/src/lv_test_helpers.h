@@ -14,6 +14,9 @@
 
 static inline uint32_t lv_test_get_free_mem(void)
 {
+    /*The empty chunks of the slabs are kept for reuse, they are not leaked*/
+    lv_mem_slab_trim_all();
+
     lv_mem_monitor_t m1;
     lv_mem_monitor(&m1);
     return m1.free_size;
@@ -0,0 +1,89 @@
+#if LV_BUILD_TEST
+#include "../lvgl.h"
+#include "lv_test_helpers.h"
+
+#include "unity/unity.h"
+
+void setUp(void)
+{
+    /* Function run before every test */
+    lv_obj_set_flex_flow(lv_screen_active(), LV_FLEX_FLOW_ROW_WRAP);
+    lv_obj_set_flex_align(lv_screen_active(), LV_FLEX_ALIGN_SPACE_EVENLY, LV_FLEX_ALIGN_CENTER, LV_FLEX_ALIGN_SPACE_EVENLY);
+}
+
+void tearDown(void)
+{
+    /* Function run after every test */
+    lv_obj_clean(lv_screen_active());
+    lv_obj_set_layout(lv_screen_active(), LV_LAYOUT_NONE);
+}
+
+static lv_obj_t * shadow_obj_create(int32_t w, int32_t h, int32_t sw, int32_t radius, int32_t spread, bool bg)
+{
+    lv_obj_t * obj = lv_obj_create(lv_screen_active());
+    lv_obj_remove_style_all(obj);
+    lv_obj_set_size(obj, w, h);
+    lv_obj_set_style_radius(obj, radius, 0);
+    lv_obj_set_style_bg_color(obj, lv_palette_lighten(LV_PALETTE_BLUE, 3), 0);
+    lv_obj_set_style_bg_opa(obj, bg ? LV_OPA_COVER : LV_OPA_TRANSP, 0);
+    lv_obj_set_style_shadow_width(obj, sw, 0);
+    lv_obj_set_style_shadow_spread(obj, spread, 0);
+    lv_obj_set_style_shadow_color(obj, lv_palette_darken(LV_PALETTE_BLUE_GREY, 3), 0);
+    lv_obj_set_style_shadow_opa(obj, LV_OPA_COVER, 0);
+    lv_obj_set_style_margin_all(obj, sw / 2 + LV_ABS(spread), 0);
+    return obj;
+}
+
+static void variants_create(void)
+{
+    static const int32_t sws[] = {1, 2, 3, 8, 15, 30};
+    static const int32_t radii[] = {0, 6, LV_RADIUS_CIRCLE};
+
+    uint32_t i;
+    uint32_t j;
+    for(i = 0; i < sizeof(sws) / sizeof(sws[0]); i++) {
+        for(j = 0; j < sizeof(radii) / sizeof(radii[0]); j++) {
+            shadow_obj_create(60, 30, sws[i], radii[j], 0, (i + j) & 1);
+        }
+    }
+
+    /*Spread and offset*/
+    lv_obj_t * obj = shadow_obj_create(50, 50, 20, 10, 6, true);
+    lv_obj_set_style_shadow_offset_x(obj, 5, 0);
+    lv_obj_set_style_shadow_offset_y(obj, 8, 0);
+    obj = shadow_obj_create(50, 50, 20, 10, -4, true);
+    lv_obj_set_style_shadow_opa(obj, LV_OPA_50, 0);
+
+    /*The same shadow width and radius on small objects whose other sides reach into the corner*/
+    shadow_obj_create(12, 12, 24, 4, 0, true);
+    shadow_obj_create(12, 40, 24, 4, 0, false);
+    shadow_obj_create(40, 12, 24, 4, 0, true);
+    shadow_obj_create(80, 80, 24, 4, 0, true);
+}
+
+void test_draw_box_shadow_variants(void)
+{
+    variants_create();
+    TEST_ASSERT_EQUAL_SCREENSHOT("draw/box_shadow.png");
+
+    /*Draw them again to use the corners which are already calculated*/
+    lv_obj_invalidate(lv_screen_active());
+    TEST_ASSERT_EQUAL_SCREENSHOT("draw/box_shadow.png");
+}
+
+void test_draw_box_shadow_same_corner_different_size(void)
+{
+    lv_obj_set_layout(lv_screen_active(), LV_LAYOUT_NONE);
+
+    /*Same shadow width and radius but the small rectangle's sides reach into the corner too*/
+    lv_obj_t * big = shadow_obj_create(200, 200, 24, 4, 0, true);
+    lv_obj_set_pos(big, 100, 100);
+    lv_refr_now(NULL);
+
+    lv_obj_delete(big);
+    lv_obj_t * small = shadow_obj_create(12, 12, 24, 4, 0, true);
+    lv_obj_set_pos(small, 100, 100);
+    TEST_ASSERT_EQUAL_SCREENSHOT("draw/box_shadow_small.png");
+}
+
+#endif
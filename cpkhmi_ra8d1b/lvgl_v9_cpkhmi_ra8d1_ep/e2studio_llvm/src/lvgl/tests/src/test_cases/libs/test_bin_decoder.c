@@ -0,0 +1,166 @@
+#if LV_BUILD_TEST
+#include "../lvgl.h"
+
+#include "unity/unity.h"
+
+#include "../../src/libs/lz4/lz4.h"
+#include <stdio.h>
+
+#define IMG_W           20
+#define IMG_H           21
+#define IMG_STRIDE      (IMG_W * 4)
+#define BAND_ROWS       8
+#define BAND_COUNT      ((IMG_H + BAND_ROWS - 1) / BAND_ROWS)
+#define BANDED_FILE     "src/test_files/banded.bin"
+
+static uint8_t pixels[IMG_H * IMG_STRIDE];
+static uint8_t image_data[12 + (BAND_COUNT + 1) * 4 + 2 * IMG_H * IMG_STRIDE];
+static lv_image_dsc_t image;
+
+static uint32_t compress_rle(const uint8_t * in, uint32_t len, uint8_t * out)
+{
+    /*Literal runs only, which is still a valid RLE stream*/
+    uint32_t out_len = 0;
+    while(len) {
+        uint32_t px = LV_MIN(len / 4, 127);
+        out[out_len++] = 0x80 | px;
+        lv_memcpy(&out[out_len], in, px * 4);
+        out_len += px * 4;
+        in += px * 4;
+        len -= px * 4;
+    }
+
+    return out_len;
+}
+
+static void create_banded_image(lv_image_compress_t method)
+{
+    uint32_t table_size = (BAND_COUNT + 1) * 4;
+    uint8_t * data = image_data + 12;
+    uint32_t offsets[BAND_COUNT + 1];
+    uint32_t pos = table_size;
+    uint32_t i;
+
+    for(i = 0; i < BAND_COUNT; i++) {
+        uint32_t rows = LV_MIN(BAND_ROWS, IMG_H - i * BAND_ROWS);
+        const uint8_t * band = &pixels[i * BAND_ROWS * IMG_STRIDE];
+        offsets[i] = pos;
+        if(method == LV_IMAGE_COMPRESS_RLE) {
+            pos += compress_rle(band, rows * IMG_STRIDE, &data[pos]);
+        }
+        else {
+            pos += LZ4_compress_default((const char *)band, (char *)&data[pos], rows * IMG_STRIDE,
+                                        sizeof(image_data) - 12 - pos);
+        }
+    }
+    offsets[BAND_COUNT] = pos;
+    lv_memcpy(data, offsets, table_size);
+
+    uint32_t header[3] = {method | (BAND_ROWS << 4), pos, IMG_H * IMG_STRIDE};
+    lv_memcpy(image_data, header, sizeof(header));
+
+    lv_memzero(&image, sizeof(image));
+    image.header.magic = LV_IMAGE_HEADER_MAGIC;
+    image.header.cf = LV_COLOR_FORMAT_XRGB8888;
+    image.header.flags = LV_IMAGE_FLAGS_COMPRESSED;
+    image.header.w = IMG_W;
+    image.header.h = IMG_H;
+    image.header.stride = IMG_STRIDE;
+    image.data_size = 12 + pos;
+    image.data = image_data;
+}
+
+static void check_area(const void * src, const lv_area_t * full_area)
+{
+    lv_image_decoder_dsc_t dsc;
+    TEST_ASSERT_EQUAL(LV_RESULT_OK, lv_image_decoder_open(&dsc, src, NULL));
+    TEST_ASSERT_NULL(dsc.decoded);  /*Nothing is decompressed before get_area*/
+
+    lv_area_t decoded_area;
+    decoded_area.x1 = LV_COORD_MIN;
+    decoded_area.y1 = LV_COORD_MIN;
+    decoded_area.x2 = LV_COORD_MIN;
+    decoded_area.y2 = LV_COORD_MIN;
+
+    int32_t next_y = full_area->y1;
+    int32_t w = lv_area_get_width(full_area);
+    while(lv_image_decoder_get_area(&dsc, full_area, &decoded_area) == LV_RESULT_OK) {
+        TEST_ASSERT_EQUAL_INT32(next_y, decoded_area.y1);
+        TEST_ASSERT_EQUAL_INT32(full_area->x1, decoded_area.x1);
+        TEST_ASSERT_EQUAL_INT32(full_area->x2, decoded_area.x2);
+        TEST_ASSERT_TRUE(decoded_area.y2 < (decoded_area.y1 / BAND_ROWS + 1) * BAND_ROWS);
+
+        const lv_draw_buf_t * decoded = dsc.decoded;
+        int32_t y;
+        for(y = decoded_area.y1; y <= decoded_area.y2; y++) {
+            const uint8_t * line = (const uint8_t *)decoded->data + (y - decoded_area.y1) * decoded->header.stride;
+            TEST_ASSERT_EQUAL_MEMORY(&pixels[y * IMG_STRIDE + full_area->x1 * 4], line, w * 4);
+        }
+        next_y = decoded_area.y2 + 1;
+    }
+
+    TEST_ASSERT_EQUAL_INT32(full_area->y2 + 1, next_y);
+    lv_image_decoder_close(&dsc);
+}
+
+void setUp(void)
+{
+    uint32_t i;
+    for(i = 0; i < sizeof(pixels); i++) pixels[i] = (uint8_t)(i * 7 + i / IMG_STRIDE);
+}
+
+void tearDown(void)
+{
+    /* Function run after every test */
+}
+
+static void check_banded(lv_image_compress_t method)
+{
+    create_banded_image(method);
+
+    lv_area_t full = {0, 0, IMG_W - 1, IMG_H - 1};
+    check_area(&image, &full);
+
+    lv_area_t part = {3, 6, 10, 17};
+    check_area(&image, &part);
+}
+
+void test_bin_decoder_banded_rle(void)
+{
+    check_banded(LV_IMAGE_COMPRESS_RLE);
+}
+
+void test_bin_decoder_banded_lz4(void)
+{
+    check_banded(LV_IMAGE_COMPRESS_LZ4);
+}
+
+void test_bin_decoder_banded_file(void)
+{
+    create_banded_image(LV_IMAGE_COMPRESS_LZ4);
+
+    FILE * f = fopen(BANDED_FILE, "wb");
+    TEST_ASSERT_NOT_NULL(f);
+    fwrite(&image.header, sizeof(image.header), 1, f);
+    fwrite(image_data, 1, image.data_size, f);
+    fclose(f);
+
+    lv_area_t full = {0, 0, IMG_W - 1, IMG_H - 1};
+    check_area("A:" BANDED_FILE, &full);
+
+    lv_area_t part = {3, 6, 10, 17};
+    check_area("A:" BANDED_FILE, &part);
+
+    remove(BANDED_FILE);
+}
+
+void test_bin_decoder_banded_bad_offsets(void)
+{
+    create_banded_image(LV_IMAGE_COMPRESS_LZ4);
+    image_data[12 + 4 + 3] = 0x7F;  /*Point the second band past the end*/
+
+    lv_image_decoder_dsc_t dsc;
+    TEST_ASSERT_EQUAL(LV_RESULT_INVALID, lv_image_decoder_open(&dsc, &image, NULL));
+}
+
+#endif
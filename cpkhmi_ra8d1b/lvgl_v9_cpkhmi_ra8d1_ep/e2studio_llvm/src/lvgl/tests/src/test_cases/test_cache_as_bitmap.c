@@ -0,0 +1,154 @@
+#if LV_BUILD_TEST
+#include "../lvgl.h"
+
+#include "unity/unity.h"
+
+static uint32_t draw_cnt;
+
+static void draw_main_cb(lv_event_t * e)
+{
+    LV_UNUSED(e);
+    draw_cnt++;
+}
+
+static lv_obj_t * panel_create(void)
+{
+    lv_obj_t * panel = lv_obj_create(lv_screen_active());
+    lv_obj_set_size(panel, 300, 200);
+    lv_obj_center(panel);
+    lv_obj_set_style_shadow_width(panel, 20, 0);
+    lv_obj_set_flex_flow(panel, LV_FLEX_FLOW_COLUMN);
+
+    lv_obj_t * btn = lv_button_create(panel);
+    lv_obj_t * label = lv_label_create(btn);
+    lv_label_set_text(label, "Cached button");
+
+    lv_obj_t * arc = lv_arc_create(panel);
+    lv_obj_set_size(arc, 80, 80);
+    lv_arc_set_value(arc, 40);
+    lv_obj_add_event_cb(arc, draw_main_cb, LV_EVENT_DRAW_MAIN, NULL);
+
+    return panel;
+}
+
+static void refresh(void)
+{
+    lv_obj_invalidate(lv_screen_active());
+    lv_refr_now(NULL);
+}
+
+#if LV_USE_SNAPSHOT
+static void test_same_as_normal(lv_obj_t * panel, uint32_t tolerance)
+{
+    lv_image_dsc_t * ref = lv_snapshot_take(lv_screen_active(), LV_COLOR_FORMAT_ARGB8888);
+    TEST_ASSERT_NOT_NULL(ref);
+
+    lv_obj_add_flag(panel, LV_OBJ_FLAG_CACHE_AS_BITMAP);
+    lv_image_dsc_t * cached = lv_snapshot_take(lv_screen_active(), LV_COLOR_FORMAT_ARGB8888);
+    TEST_ASSERT_NOT_NULL(cached);
+
+    /*Blending the semi-transparent pixels twice can round differently.
+     *The edges of transformed bitmaps are also interpolated a little differently.*/
+    TEST_ASSERT_EQUAL_UINT32(ref->data_size, cached->data_size);
+    uint32_t i;
+    uint32_t max_diff = 0;
+    for(i = 0; i < ref->data_size; i++) {
+        uint32_t diff = LV_ABS(ref->data[i] - cached->data[i]);
+        max_diff = LV_MAX(max_diff, diff);
+    }
+    TEST_ASSERT_LESS_OR_EQUAL_UINT32(tolerance, max_diff);
+
+    lv_snapshot_free(ref);
+    lv_snapshot_free(cached);
+}
+#endif
+
+void setUp(void)
+{
+    draw_cnt = 0;
+}
+
+void tearDown(void)
+{
+    lv_obj_clean(lv_screen_active());
+}
+
+void test_cache_as_bitmap_redraw_from_cache(void)
+{
+    lv_obj_t * panel = panel_create();
+    lv_obj_add_flag(panel, LV_OBJ_FLAG_CACHE_AS_BITMAP);
+    refresh();
+    TEST_ASSERT_EQUAL_UINT32(1, draw_cnt);
+
+    /*The parent is redrawn but the panel can be blitted from the cache*/
+    refresh();
+    refresh();
+    TEST_ASSERT_EQUAL_UINT32(1, draw_cnt);
+
+    /*Moving the whole panel doesn't change its content either*/
+    lv_obj_set_style_translate_x(lv_screen_active(), 10, 0);
+    refresh();
+    TEST_ASSERT_EQUAL_UINT32(1, draw_cnt);
+}
+
+void test_cache_as_bitmap_child_invalidates(void)
+{
+    lv_obj_t * panel = panel_create();
+    lv_obj_add_flag(panel, LV_OBJ_FLAG_CACHE_AS_BITMAP);
+    refresh();
+    TEST_ASSERT_EQUAL_UINT32(1, draw_cnt);
+
+    /*A change in a descendant renders the panel again, but only once*/
+    lv_obj_t * label = lv_obj_get_child(lv_obj_get_child(panel, 0), 0);
+    lv_label_set_text(label, "Changed");
+    lv_refr_now(NULL);
+    TEST_ASSERT_EQUAL_UINT32(2, draw_cnt);
+    refresh();
+    TEST_ASSERT_EQUAL_UINT32(2, draw_cnt);
+
+    /*A new size needs a new bitmap*/
+    lv_obj_set_width(panel, 350);
+    lv_refr_now(NULL);
+    TEST_ASSERT_EQUAL_UINT32(3, draw_cnt);
+
+    /*Without the flag it's drawn normally again*/
+    lv_obj_remove_flag(panel, LV_OBJ_FLAG_CACHE_AS_BITMAP);
+    refresh();
+    refresh();
+    TEST_ASSERT_EQUAL_UINT32(5, draw_cnt);
+}
+
+void test_cache_as_bitmap_nested(void)
+{
+    lv_obj_t * panel = panel_create();
+    lv_obj_t * inner = lv_obj_get_child(panel, 1);
+    lv_obj_add_flag(panel, LV_OBJ_FLAG_CACHE_AS_BITMAP);
+    lv_obj_add_flag(inner, LV_OBJ_FLAG_CACHE_AS_BITMAP);
+    refresh();
+    TEST_ASSERT_EQUAL_UINT32(1, draw_cnt);
+
+    /*The outer panel is rendered again, the inner one is still cached*/
+    lv_obj_set_style_bg_color(lv_obj_get_child(panel, 0), lv_palette_main(LV_PALETTE_RED), 0);
+    lv_refr_now(NULL);
+    TEST_ASSERT_EQUAL_UINT32(1, draw_cnt);
+
+    lv_arc_set_value(inner, 60);
+    lv_refr_now(NULL);
+    TEST_ASSERT_EQUAL_UINT32(2, draw_cnt);
+}
+
+void test_cache_as_bitmap_same_as_normal(void)
+{
+#if LV_USE_SNAPSHOT
+    lv_obj_t * panel = panel_create();
+    test_same_as_normal(panel, 2);
+
+    /*Draw the cached bitmap with the object's transformation*/
+    lv_obj_remove_flag(panel, LV_OBJ_FLAG_CACHE_AS_BITMAP);
+    lv_obj_set_style_transform_rotation(panel, 300, 0);
+    lv_obj_set_style_opa(panel, LV_OPA_70, 0);
+    test_same_as_normal(panel, 10);
+#endif
+}
+
+#endif
@@ -0,0 +1,260 @@
+#if LV_BUILD_TEST
+#include "../lvgl.h"
+
+#include "unity/unity.h"
+
+static lv_mem_slab_t slab;
+
+static lv_mem_slab_t * find_slab(const char * name)
+{
+    lv_mem_slab_t * s = lv_mem_slab_get_next(NULL);
+    while(s) {
+        if(lv_strcmp(s->name, name) == 0) return s;
+        s = lv_mem_slab_get_next(s);
+    }
+
+    return NULL;
+}
+
+void setUp(void)
+{
+    lv_mem_slab_init(&slab, "test", 24, 4);
+}
+
+void tearDown(void)
+{
+    lv_mem_slab_deinit(&slab);
+    lv_obj_clean(lv_screen_active());
+}
+
+void test_mem_slab_reuse_freed_block(void)
+{
+    void * a = lv_mem_slab_alloc(&slab, 24);
+    void * b = lv_mem_slab_alloc(&slab, 10);
+    TEST_ASSERT_NOT_NULL(a);
+    TEST_ASSERT_NOT_NULL(b);
+    TEST_ASSERT_EQUAL_UINT32(2, slab.used_cnt);
+    TEST_ASSERT_EQUAL_UINT32(1, slab.chunk_cnt);
+
+    lv_mem_slab_free(&slab, a);
+    TEST_ASSERT_EQUAL_UINT32(1, slab.used_cnt);
+
+    void * c = lv_mem_slab_alloc(&slab, 24);
+    TEST_ASSERT_EQUAL_PTR(a, c);
+    TEST_ASSERT_EQUAL_UINT32(2, slab.max_used_cnt);
+    TEST_ASSERT_EQUAL_UINT32(3, slab.alloc_cnt);
+
+    lv_mem_slab_free(&slab, b);
+    lv_mem_slab_free(&slab, c);
+    TEST_ASSERT_EQUAL_UINT32(0, slab.used_cnt);
+}
+
+void test_mem_slab_add_and_trim_chunks(void)
+{
+    void * blocks[5];
+    uint32_t i;
+    for(i = 0; i < 5; i++) {
+        blocks[i] = lv_mem_slab_alloc_zeroed(&slab, 24);
+        TEST_ASSERT_NOT_NULL(blocks[i]);
+    }
+    TEST_ASSERT_EQUAL_UINT32(2, slab.chunk_cnt);
+
+    /*The chunk of the last block is still in use*/
+    for(i = 0; i < 4; i++) lv_mem_slab_free(&slab, blocks[i]);
+    TEST_ASSERT_GREATER_THAN_UINT32(4 * 24, lv_mem_slab_trim(&slab));
+    TEST_ASSERT_EQUAL_UINT32(1, slab.chunk_cnt);
+    TEST_ASSERT_EQUAL_UINT32(1, slab.used_cnt);
+    TEST_ASSERT_EQUAL_UINT32(0, lv_mem_slab_trim(&slab));
+
+    /*The remaining 3 free blocks of the chunk are still available*/
+    for(i = 0; i < 3; i++) blocks[i] = lv_mem_slab_alloc(&slab, 24);
+    TEST_ASSERT_EQUAL_UINT32(1, slab.chunk_cnt);
+
+    for(i = 0; i < 3; i++) lv_mem_slab_free(&slab, blocks[i]);
+    lv_mem_slab_free(&slab, blocks[4]);
+    lv_mem_slab_trim(&slab);
+    TEST_ASSERT_EQUAL_UINT32(0, slab.chunk_cnt);
+    TEST_ASSERT_NULL(slab.free_head);
+}
+
+void test_mem_slab_free_blocks_of_many_chunks(void)
+{
+    void * blocks[32];
+    uint32_t i;
+    for(i = 0; i < 32; i++) blocks[i] = lv_mem_slab_alloc(&slab, 24);
+    TEST_ASSERT_EQUAL_UINT32(8, slab.chunk_cnt);
+
+    /*Every chunk keeps a used block*/
+    for(i = 0; i < 32; i++) {
+        if(i % 4 != 3) lv_mem_slab_free(&slab, blocks[i]);
+    }
+    TEST_ASSERT_EQUAL_UINT32(8, slab.used_cnt);
+    TEST_ASSERT_EQUAL_UINT32(0, lv_mem_slab_trim(&slab));
+
+    /*Empty every second chunk*/
+    for(i = 3; i < 32; i += 8) lv_mem_slab_free(&slab, blocks[i]);
+    lv_mem_slab_trim(&slab);
+    TEST_ASSERT_EQUAL_UINT32(4, slab.chunk_cnt);
+    TEST_ASSERT_EQUAL_UINT32(4, slab.used_cnt);
+
+    for(i = 7; i < 32; i += 8) lv_mem_slab_free(&slab, blocks[i]);
+    TEST_ASSERT_EQUAL_UINT32(0, slab.used_cnt);
+}
+
+void test_mem_slab_large_alloc_uses_the_heap(void)
+{
+    void * a = lv_mem_slab_alloc(&slab, 100);
+    TEST_ASSERT_NOT_NULL(a);
+    TEST_ASSERT_EQUAL_UINT32(0, slab.used_cnt);
+    TEST_ASSERT_EQUAL_UINT32(0, slab.chunk_cnt);
+    TEST_ASSERT_EQUAL_UINT32(1, slab.heap_alloc_cnt);
+
+    lv_mem_slab_free(&slab, a);
+}
+
+void test_mem_slab_realloc(void)
+{
+    uint8_t * a = lv_mem_slab_alloc(&slab, 16);
+    uint32_t i;
+    for(i = 0; i < 16; i++) a[i] = i;
+
+    /*Doesn't fit into a block anymore*/
+    a = lv_mem_slab_realloc(&slab, a, 100);
+    TEST_ASSERT_EQUAL_UINT32(0, slab.used_cnt);
+    for(i = 0; i < 16; i++) TEST_ASSERT_EQUAL_UINT8(i, a[i]);
+
+    /*Stays on the heap*/
+    a = lv_mem_slab_realloc(&slab, a, 200);
+    TEST_ASSERT_EQUAL_UINT32(0, slab.used_cnt);
+    for(i = 0; i < 16; i++) TEST_ASSERT_EQUAL_UINT8(i, a[i]);
+
+    /*Fits again*/
+    a = lv_mem_slab_realloc(&slab, a, 20);
+    TEST_ASSERT_EQUAL_UINT32(1, slab.used_cnt);
+    for(i = 0; i < 16; i++) TEST_ASSERT_EQUAL_UINT8(i, a[i]);
+
+    TEST_ASSERT_EQUAL_PTR(a, lv_mem_slab_realloc(&slab, a, 8));
+
+    TEST_ASSERT_NULL(lv_mem_slab_realloc(&slab, a, 0));
+    TEST_ASSERT_EQUAL_UINT32(0, slab.used_cnt);
+}
+
+void test_mem_slab_monitor(void)
+{
+    lv_mem_slab_trim_all();
+    lv_mem_monitor_t mon_before;
+    lv_mem_monitor(&mon_before);
+
+    void * a = lv_mem_slab_alloc(&slab, 24);
+
+    lv_mem_monitor_t mon;
+    lv_mem_monitor(&mon);
+    TEST_ASSERT_EQUAL_UINT32(mon_before.slab_size + 4 * 24, mon.slab_size);
+    TEST_ASSERT_EQUAL_UINT32(mon_before.slab_free_size + 3 * 24, mon.slab_free_size);
+
+    /*The empty chunk is kept by the monitor*/
+    lv_mem_slab_free(&slab, a);
+    lv_mem_monitor(&mon);
+    TEST_ASSERT_EQUAL_UINT32(1, slab.chunk_cnt);
+    TEST_ASSERT_EQUAL_UINT32(mon_before.slab_size + 4 * 24, mon.slab_size);
+    TEST_ASSERT_EQUAL_UINT32(mon_before.slab_free_size + 4 * 24, mon.slab_free_size);
+
+    lv_mem_slab_trim_all();
+    lv_mem_monitor(&mon);
+    TEST_ASSERT_EQUAL_UINT32(0, slab.chunk_cnt);
+    TEST_ASSERT_EQUAL_UINT32(mon_before.slab_size, mon.slab_size);
+}
+
+void test_mem_slab_objects(void)
+{
+    lv_mem_slab_t * obj_slab = find_slab("obj");
+    lv_mem_slab_t * spec_attr_slab = find_slab("obj_spec_attr");
+    lv_mem_slab_t * style_slab = find_slab("obj_style");
+    TEST_ASSERT_NOT_NULL(obj_slab);
+    TEST_ASSERT_NOT_NULL(spec_attr_slab);
+    TEST_ASSERT_NOT_NULL(style_slab);
+
+    /*The screen keeps its special attributes after the parent is deleted*/
+    lv_obj_t * parent = lv_obj_create(lv_screen_active());
+    lv_obj_delete(parent);
+
+    uint32_t obj_used = obj_slab->used_cnt;
+    uint32_t spec_attr_used = spec_attr_slab->used_cnt;
+    uint32_t style_used = style_slab->used_cnt;
+
+    parent = lv_obj_create(lv_screen_active());
+    uint32_t i;
+    for(i = 0; i < 20; i++) {
+        lv_obj_t * obj = lv_obj_create(parent);
+        lv_obj_set_style_bg_color(obj, lv_color_hex(0xff0000), 0);
+    }
+
+    TEST_ASSERT_EQUAL_UINT32(obj_used + 21, obj_slab->used_cnt);
+    TEST_ASSERT_EQUAL_UINT32(spec_attr_used + 1, spec_attr_slab->used_cnt);
+    TEST_ASSERT_EQUAL_UINT32(style_used + 21, style_slab->used_cnt);
+
+    lv_obj_delete(parent);
+    TEST_ASSERT_EQUAL_UINT32(obj_used, obj_slab->used_cnt);
+    TEST_ASSERT_EQUAL_UINT32(spec_attr_used, spec_attr_slab->used_cnt);
+    TEST_ASSERT_EQUAL_UINT32(style_used, style_slab->used_cnt);
+}
+
+void test_mem_slab_widget_sizes(void)
+{
+    lv_mem_slab_t * obj_slab = find_slab("obj");
+    lv_mem_slab_t * obj_large_slab = find_slab("obj_large");
+    TEST_ASSERT_NOT_NULL(obj_large_slab);
+
+    uint32_t obj_used = obj_slab->used_cnt;
+    uint32_t obj_large_used = obj_large_slab->used_cnt;
+    uint32_t heap_alloc_cnt = obj_slab->heap_alloc_cnt + obj_large_slab->heap_alloc_cnt;
+
+    lv_obj_t * button = lv_button_create(lv_screen_active());
+    lv_obj_t * label = lv_label_create(button);
+    lv_obj_t * image = lv_image_create(lv_screen_active());
+    lv_obj_t * checkbox = lv_checkbox_create(lv_screen_active());
+
+    TEST_ASSERT_EQUAL_UINT32(obj_used + 1, obj_slab->used_cnt);
+    TEST_ASSERT_EQUAL_UINT32(obj_large_used + 3, obj_large_slab->used_cnt);
+    TEST_ASSERT_EQUAL_UINT32(heap_alloc_cnt, obj_slab->heap_alloc_cnt + obj_large_slab->heap_alloc_cnt);
+
+    lv_obj_delete(button);
+    lv_obj_delete(image);
+    TEST_ASSERT_EQUAL_UINT32(obj_used, obj_slab->used_cnt);
+    TEST_ASSERT_EQUAL_UINT32(obj_large_used + 1, obj_large_slab->used_cnt);
+
+    lv_obj_delete(checkbox);
+    TEST_ASSERT_EQUAL_UINT32(obj_large_used, obj_large_slab->used_cnt);
+    (void)label;
+}
+
+void test_mem_slab_draw_tasks(void)
+{
+    lv_mem_slab_t * task_slab = find_slab("draw_task");
+    lv_mem_slab_t * dsc_slab = find_slab("draw_dsc");
+    TEST_ASSERT_NOT_NULL(task_slab);
+    TEST_ASSERT_NOT_NULL(dsc_slab);
+
+    uint32_t task_alloc_cnt = task_slab->alloc_cnt;
+    uint32_t dsc_alloc_cnt = dsc_slab->alloc_cnt;
+
+    lv_obj_t * label = lv_label_create(lv_screen_active());
+    lv_label_set_text(label, "Hello");
+    lv_obj_set_style_border_width(label, 2, 0);
+    lv_refr_now(NULL);
+
+    TEST_ASSERT_GREATER_THAN_UINT32(task_alloc_cnt, task_slab->alloc_cnt);
+    TEST_ASSERT_GREATER_THAN_UINT32(dsc_alloc_cnt, dsc_slab->alloc_cnt);
+    TEST_ASSERT_EQUAL_UINT32(0, task_slab->heap_alloc_cnt);
+    TEST_ASSERT_EQUAL_UINT32(0, dsc_slab->heap_alloc_cnt);
+
+#if LV_USE_VECTOR_GRAPHIC
+    TEST_ASSERT_GREATER_OR_EQUAL_UINT32(sizeof(lv_draw_vector_task_dsc_t), dsc_slab->block_size);
+#endif
+
+    /*All draw tasks are freed when the refreshing is ready*/
+    TEST_ASSERT_EQUAL_UINT32(0, task_slab->used_cnt);
+    TEST_ASSERT_EQUAL_UINT32(0, dsc_slab->used_cnt);
+}
+
+#endif
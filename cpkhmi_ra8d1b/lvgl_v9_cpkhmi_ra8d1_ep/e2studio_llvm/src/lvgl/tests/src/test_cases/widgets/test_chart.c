@@ -3,6 +3,8 @@
 
 #include "unity/unity.h"
 
+#include "lv_test_helpers.h"
+
 static lv_obj_t * active_screen = NULL;
 static lv_obj_t * chart = NULL;
 
@@ -104,4 +106,159 @@ void test_chart_one_point_when_setting_point_count_to_zero(void)
     TEST_ASSERT_EQUAL(1u, lv_chart_get_point_count(chart));
 }
 
+void test_chart_set_next_values_should_work_as_set_next_value(void)
+{
+    lv_chart_set_point_count(chart, 50);
+    lv_chart_series_t * ser_one = lv_chart_add_series(chart, red_color, LV_CHART_AXIS_PRIMARY_Y);
+    lv_chart_series_t * ser_batch = lv_chart_add_series(chart, red_color, LV_CHART_AXIS_PRIMARY_Y);
+
+    int32_t values[130];
+    uint32_t i;
+    for(i = 0; i < 130; i++) values[i] = i * 3;
+
+    for(i = 0; i < 30; i++) lv_chart_set_next_value(chart, ser_one, values[i]);
+    lv_chart_set_next_values(chart, ser_batch, values, 30);
+    TEST_ASSERT_EQUAL_UINT32(ser_one->start_point, ser_batch->start_point);
+    TEST_ASSERT_EQUAL_INT32_ARRAY(ser_one->y_points, ser_batch->y_points, 50);
+
+    /*Wrap around the end of the array*/
+    for(i = 30; i < 60; i++) lv_chart_set_next_value(chart, ser_one, values[i]);
+    lv_chart_set_next_values(chart, ser_batch, &values[30], 30);
+    TEST_ASSERT_EQUAL_UINT32(ser_one->start_point, ser_batch->start_point);
+    TEST_ASSERT_EQUAL_INT32_ARRAY(ser_one->y_points, ser_batch->y_points, 50);
+
+    /*More values than points*/
+    for(i = 60; i < 130; i++) lv_chart_set_next_value(chart, ser_one, values[i]);
+    lv_chart_set_next_values(chart, ser_batch, &values[60], 70);
+    TEST_ASSERT_EQUAL_UINT32(ser_one->start_point, ser_batch->start_point);
+    TEST_ASSERT_EQUAL_INT32_ARRAY(ser_one->y_points, ser_batch->y_points, 50);
+
+    lv_chart_remove_series(chart, ser_one);
+    lv_chart_remove_series(chart, ser_batch);
+}
+
+void test_chart_stream_should_feed_the_series(void)
+{
+    static int32_t stream_buf[16];
+    lv_chart_stream_t stream;
+    lv_chart_stream_init(&stream, stream_buf, 16);
+
+    lv_chart_set_point_count(chart, 40);
+    lv_chart_series_t * ser = lv_chart_add_series(chart, red_color, LV_CHART_AXIS_PRIMARY_Y);
+    lv_chart_set_series_stream(chart, ser, &stream);
+
+    int32_t values[40];
+    uint32_t i;
+    for(i = 0; i < 40; i++) values[i] = i + 100;
+
+    /*One place is always kept free*/
+    TEST_ASSERT_EQUAL_UINT32(15, lv_chart_stream_push(&stream, values, 20));
+    TEST_ASSERT_EQUAL_UINT32(0, lv_chart_stream_push(&stream, values, 1));
+
+    lv_test_wait(LV_DEF_REFR_PERIOD * 2);
+    TEST_ASSERT_EQUAL_UINT32(15, ser->start_point);
+    TEST_ASSERT_EQUAL_INT32_ARRAY(values, ser->y_points, 15);
+
+    /*Wrap around in the stream*/
+    TEST_ASSERT_EQUAL_UINT32(10, lv_chart_stream_push(&stream, &values[15], 10));
+    lv_test_wait(LV_DEF_REFR_PERIOD * 2);
+    TEST_ASSERT_EQUAL_UINT32(25, ser->start_point);
+    TEST_ASSERT_EQUAL_INT32_ARRAY(values, ser->y_points, 25);
+
+    lv_chart_remove_series(chart, ser);
+}
+
+void test_chart_stream_timer_runs_only_while_a_stream_is_attached(void)
+{
+    static int32_t stream_buf[16];
+    lv_chart_stream_t stream;
+    lv_chart_stream_init(&stream, stream_buf, 16);
+
+    lv_chart_t * chart_p = (lv_chart_t *)chart;
+    lv_chart_series_t * ser1 = lv_chart_add_series(chart, red_color, LV_CHART_AXIS_PRIMARY_Y);
+    lv_chart_series_t * ser2 = lv_chart_add_series(chart, red_color, LV_CHART_AXIS_PRIMARY_Y);
+    TEST_ASSERT_NULL(chart_p->stream_timer);
+
+    lv_chart_set_series_stream(chart, ser1, &stream);
+    lv_chart_set_series_stream(chart, ser2, &stream);
+    TEST_ASSERT_NOT_NULL(chart_p->stream_timer);
+
+    lv_chart_set_series_stream(chart, ser1, NULL);
+    TEST_ASSERT_NOT_NULL(chart_p->stream_timer);
+
+    /*Removing the last series with a stream deletes the timer too*/
+    lv_chart_remove_series(chart, ser2);
+    TEST_ASSERT_NULL(chart_p->stream_timer);
+
+    /*A stream without buffer is not attached*/
+    lv_chart_stream_t empty_stream = {0};
+    lv_chart_set_series_stream(chart, ser1, &empty_stream);
+    TEST_ASSERT_NULL(ser1->stream);
+    TEST_ASSERT_NULL(chart_p->stream_timer);
+
+    lv_chart_remove_series(chart, ser1);
+}
+
+static int32_t line_y1[200];
+static int32_t line_y2[200];
+static uint32_t line_cnt;
+
+static void series_line_cb(lv_event_t * e)
+{
+    lv_draw_task_t * draw_task = lv_event_get_draw_task(e);
+    lv_draw_line_dsc_t * line_dsc = draw_task->draw_dsc;
+    if(draw_task->type != LV_DRAW_TASK_TYPE_LINE || line_dsc->base.part != LV_PART_ITEMS) return;
+
+    TEST_ASSERT_EQUAL(line_dsc->p1.x, line_dsc->p2.x);
+    int32_t x = (int32_t)line_dsc->p1.x - chart->coords.x1;
+    line_y1[x] = (int32_t)line_dsc->p1.y - chart->coords.y1;
+    line_y2[x] = (int32_t)line_dsc->p2.y - chart->coords.y1;
+    line_cnt++;
+}
+
+void test_chart_crowded_line_should_connect_min_and_max(void)
+{
+    lv_obj_set_size(chart, 200, 100);
+    lv_obj_set_style_pad_all(chart, 0, 0);
+    lv_obj_set_style_border_width(chart, 0, 0);
+    lv_chart_set_div_line_count(chart, 0, 0);
+    lv_chart_set_point_count(chart, 3000);
+    lv_chart_set_range(chart, LV_CHART_AXIS_PRIMARY_Y, 0, 1000);
+    lv_chart_series_t * ser = lv_chart_add_series(chart, red_color, LV_CHART_AXIS_PRIMARY_Y);
+
+    /*Start from the middle of the array to test wrapping around*/
+    static int32_t values[4500];
+    uint32_t i;
+    for(i = 0; i < 4500; i++) values[i] = (i * 7919) % 1000;
+    values[4000] = LV_CHART_POINT_NONE;
+    lv_chart_set_next_values(chart, ser, values, 4500);
+
+    lv_obj_add_flag(chart, LV_OBJ_FLAG_SEND_DRAW_TASK_EVENTS);
+    lv_obj_add_event_cb(chart, series_line_cb, LV_EVENT_DRAW_TASK_ADDED, NULL);
+    line_cnt = 0;
+    lv_refr_now(NULL);
+    TEST_ASSERT_EQUAL_UINT32(200, line_cnt);
+
+    /*Each column has a line between the smallest and largest value of its points and the first point of the next column*/
+    int32_t x;
+    for(x = 0; x < 200; x++) {
+        uint32_t first = (x * 2999 + 199) / 200;
+        uint32_t last = LV_MIN(((x + 1) * 2999 + 199) / 200, 2999);
+        int32_t min = INT32_MAX;
+        int32_t max = INT32_MIN;
+        for(i = first; i <= last; i++) {
+            int32_t v = values[1500 + i];
+            if(v == LV_CHART_POINT_NONE) continue;
+            min = LV_MIN(min, v);
+            max = LV_MAX(max, v);
+        }
+
+        TEST_ASSERT_EQUAL_INT32(100 - max * 100 / 1000, line_y1[x]);
+        if(min == max) TEST_ASSERT_EQUAL_INT32(100 - min * 100 / 1000 + 1, line_y2[x]);
+        else TEST_ASSERT_EQUAL_INT32(100 - min * 100 / 1000, line_y2[x]);
+    }
+
+    lv_chart_remove_series(chart, ser);
+}
+
 #endif
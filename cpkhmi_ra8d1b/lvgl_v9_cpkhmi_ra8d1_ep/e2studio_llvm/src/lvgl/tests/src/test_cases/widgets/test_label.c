@@ -592,4 +592,145 @@ void test_label_rtl_dot_long_mode(void)
     TEST_ASSERT_EQUAL_SCREENSHOT("widgets/label_rtl_dot_long_mode.png");
 }
 
+static lv_obj_t * line_test_label_create(lv_obj_t * parent, lv_text_align_t align, int32_t letter_space,
+                                         int32_t line_space)
+{
+    lv_obj_t * obj = lv_label_create(parent);
+    lv_obj_set_width(obj, 180);
+    lv_obj_set_style_text_align(obj, align, 0);
+    lv_obj_set_style_text_letter_space(obj, letter_space, 0);
+    lv_obj_set_style_text_line_space(obj, line_space, 0);
+    lv_label_set_text(obj, long_text_multiline);
+    return obj;
+}
+
+static void line_test_scene_create(lv_obj_t ** cont_out, lv_obj_t ** clip_out)
+{
+    lv_obj_t * cont = lv_obj_create(lv_screen_active());
+    lv_obj_set_size(cont, 800, 480);
+    lv_obj_set_flex_flow(cont, LV_FLEX_FLOW_ROW_WRAP);
+
+    line_test_label_create(cont, LV_TEXT_ALIGN_LEFT, 0, 0);
+    line_test_label_create(cont, LV_TEXT_ALIGN_CENTER, 2, 4);
+    line_test_label_create(cont, LV_TEXT_ALIGN_RIGHT, -1, -2);
+
+    lv_obj_t * dot_label = line_test_label_create(cont, LV_TEXT_ALIGN_CENTER, 1, 0);
+    lv_label_set_long_mode(dot_label, LV_LABEL_LONG_DOT);
+    lv_obj_set_height(dot_label, 50);
+
+    lv_obj_t * scroll_label = line_test_label_create(cont, LV_TEXT_ALIGN_CENTER, 0, 0);
+    lv_label_set_long_mode(scroll_label, LV_LABEL_LONG_SCROLL_CIRCULAR);
+    lv_label_set_text(scroll_label, long_text);
+
+    /*A tall label scrolled out of the top to jump to the first visible line*/
+    lv_obj_t * clip = lv_obj_create(lv_screen_active());
+    lv_obj_set_size(clip, 300, 200);
+    lv_obj_align(clip, LV_ALIGN_BOTTOM_MID, 0, -20);
+    lv_obj_t * tall_label = line_test_label_create(clip, LV_TEXT_ALIGN_RIGHT, 0, 3);
+    lv_obj_set_width(tall_label, 250);
+    lv_obj_set_style_text_font(tall_label, &lv_font_montserrat_24, 0);
+    lv_label_set_text_fmt(tall_label, "%s\n%s", long_text_multiline, long_text_multiline);
+    lv_obj_scroll_to_y(clip, 75, LV_ANIM_OFF);
+
+    *cont_out = cont;
+    *clip_out = clip;
+}
+
+void test_label_lines(void)
+{
+    lv_obj_t * cont;
+    lv_obj_t * clip;
+    line_test_scene_create(&cont, &clip);
+
+    TEST_ASSERT_EQUAL_SCREENSHOT("widgets/label_lines.png");
+
+    /*Scrolling the parent must not change the look of the labels*/
+    lv_obj_scroll_by(clip, 0, -10, LV_ANIM_OFF);
+    lv_obj_scroll_by(clip, 0, 10, LV_ANIM_OFF);
+    TEST_ASSERT_EQUAL_SCREENSHOT("widgets/label_lines.png");
+
+    lv_obj_delete(cont);
+    lv_obj_delete(clip);
+}
+
+#if LV_LABEL_LINE_CACHE
+static void lines_drop_event_cb(lv_event_t * e)
+{
+    lv_draw_task_t * draw_task = lv_event_get_draw_task(e);
+    if(draw_task->type != LV_DRAW_TASK_TYPE_LABEL) return;
+
+    /*Draw as if there were no line cache*/
+    lv_draw_label_dsc_t * label_dsc = draw_task->draw_dsc;
+    label_dsc->lines = NULL;
+}
+
+static void lines_drop_add(lv_obj_t * parent)
+{
+    uint32_t i;
+    for(i = 0; i < lv_obj_get_child_count(parent); i++) {
+        lv_obj_t * child = lv_obj_get_child(parent, i);
+        if(!lv_obj_check_type(child, &lv_label_class)) continue;
+        lv_obj_add_flag(child, LV_OBJ_FLAG_SEND_DRAW_TASK_EVENTS);
+        lv_obj_add_event_cb(child, lines_drop_event_cb, LV_EVENT_DRAW_TASK_ADDED, NULL);
+    }
+}
+#endif
+
+void test_label_lines_draw_the_same_as_without_cache(void)
+{
+#if LV_LABEL_LINE_CACHE
+    extern uint8_t * last_flushed_buf;
+    static uint8_t fb_with_lines[800 * 480 * 4];
+
+    lv_obj_t * cont;
+    lv_obj_t * clip;
+    line_test_scene_create(&cont, &clip);
+    lv_obj_invalidate(lv_screen_active());
+    lv_refr_now(NULL);
+    uint8_t * fb = lv_draw_buf_align(last_flushed_buf, LV_COLOR_FORMAT_ARGB8888);
+    lv_memcpy(fb_with_lines, fb, sizeof(fb_with_lines));
+
+    lines_drop_add(cont);
+    lines_drop_add(clip);
+    lv_obj_invalidate(lv_screen_active());
+    lv_refr_now(NULL);
+    TEST_ASSERT_EQUAL_MEMORY(fb_with_lines, fb, sizeof(fb_with_lines));
+
+    lv_obj_delete(cont);
+    lv_obj_delete(clip);
+#endif
+}
+
+void test_label_lines_are_kept_on_scroll(void)
+{
+#if LV_LABEL_LINE_CACHE
+    lv_obj_t * cont = lv_obj_create(lv_screen_active());
+    lv_obj_set_size(cont, 300, 200);
+    lv_obj_t * obj = line_test_label_create(cont, LV_TEXT_ALIGN_CENTER, 0, 0);
+    lv_obj_set_y(obj, 300);
+    lv_refr_now(NULL);
+
+    lv_label_t * obj_label = (lv_label_t *)obj;
+    const lv_draw_label_line_t * line = obj_label->lines.line;
+    TEST_ASSERT_NOT_NULL(line);
+    TEST_ASSERT_GREATER_THAN_UINT32(3, obj_label->lines.line_cnt);
+    TEST_ASSERT_EQUAL_UINT32(strlen(long_text_multiline), line[obj_label->lines.line_cnt].start);
+
+    /*Only the position changes, the lines are not calculated again*/
+    lv_obj_scroll_by(cont, 0, -150, LV_ANIM_OFF);
+    lv_refr_now(NULL);
+    TEST_ASSERT_EQUAL_PTR(line, obj_label->lines.line);
+
+    /*Changing the text or the width updates them*/
+    lv_label_set_text(obj, "a\nb");
+    TEST_ASSERT_EQUAL_UINT32(2, obj_label->lines.line_cnt);
+    lv_obj_set_width(obj, 20);
+    lv_label_set_text(obj, long_text);
+    lv_obj_update_layout(obj);
+    TEST_ASSERT_EQUAL_INT32(20, obj_label->lines.max_w);
+
+    lv_obj_delete(cont);
+#endif
+}
+
 #endif
@@ -0,0 +1,144 @@
+/***********************************************************************************************************************
+ * File Name    : ospi_asset.c
+ * Description  : Read side of the OSPI asset store. Assets are used in place through the memory-mapped (XIP) window,
+ *                nothing is copied to RAM.
+ **********************************************************************************************************************/
+
+/*
+* Copyright (c) 2024 Renesas Electronics Corporation and/or its affiliates
+*
+* SPDX-License-Identifier: BSD-3-Clause
+*/
+
+#include <string.h>
+#include "ospi_asset.h"
+
+/*******************************************************************************************************************//**
+ * @addtogroup ospi_asset
+ * @{
+ **********************************************************************************************************************/
+
+/* CRC-32 (IEEE 802.3, reflected) nibble table */
+static const uint32_t g_ospi_asset_crc_table[16] =
+{
+    0x00000000U, 0x1DB71064U, 0x3B6E20C8U, 0x26D930ACU, 0x76DC4190U, 0x6B6B51F4U, 0x4DB26158U, 0x5005713CU,
+    0xEDB88320U, 0xF00F9344U, 0xD6D6A3E8U, 0xCB61B38CU, 0x9B64C2B0U, 0x86D3D2D4U, 0xA00AE278U, 0xBDBDF21CU
+};
+
+/*******************************************************************************************************************//**
+ * @brief       Check the header and index of a store.
+ * @param[out]  p_store     Mounted store
+ * @param[in]   p_base      Start of the store in the mapped window
+ * @retval      true        The store is valid
+ * @retval      false       No store, or the index is damaged
+ **********************************************************************************************************************/
+bool ospi_asset_mount(ospi_asset_store_t * p_store, void const * p_base)
+{
+    ospi_asset_header_t const * p_header  = (ospi_asset_header_t const *) p_base;
+    ospi_asset_entry_t const  * p_entries = (ospi_asset_entry_t const *) (p_header + 1);
+    uint32_t                    index     = 0U;
+
+    memset(p_store, 0, sizeof(*p_store));
+
+    if ((OSPI_ASSET_MAGIC != p_header->magic) || (OSPI_ASSET_VERSION != p_header->version))
+    {
+        return false;
+    }
+    index = sizeof(ospi_asset_entry_t) * p_header->count;
+    if ((sizeof(*p_header) + index) > p_header->total_size)
+    {
+        return false;
+    }
+    if (p_header->index_crc != ospi_asset_crc32(0U, p_entries, index))
+    {
+        return false;
+    }
+    for (uint32_t i = 0U; i < p_header->count; i++)
+    {
+        if (((p_entries[i].offset % OSPI_ASSET_ALIGN) != 0U) ||
+            (p_entries[i].offset > p_header->total_size) ||
+            (p_entries[i].size > (p_header->total_size - p_entries[i].offset)))
+        {
+            return false;
+        }
+    }
+
+    p_store->p_base    = (uint8_t const *) p_base;
+    p_store->p_header  = p_header;
+    p_store->p_entries = p_entries;
+
+    return true;
+}
+
+uint32_t ospi_asset_count(ospi_asset_store_t const * p_store)
+{
+    return (NULL != p_store->p_header) ? p_store->p_header->count : 0U;
+}
+
+ospi_asset_entry_t const * ospi_asset_at(ospi_asset_store_t const * p_store, uint32_t index)
+{
+    return (index < ospi_asset_count(p_store)) ? &p_store->p_entries[index] : NULL;
+}
+
+/*******************************************************************************************************************//**
+ * @brief       Look an asset up by name. A leading '/' is ignored.
+ * @param[in]   p_store     Mounted store
+ * @param[in]   p_name      Asset name
+ * @retval      Entry, or NULL if there is none with that name
+ **********************************************************************************************************************/
+ospi_asset_entry_t const * ospi_asset_find(ospi_asset_store_t const * p_store, char const * p_name)
+{
+    uint32_t count = ospi_asset_count(p_store);
+
+    while ('/' == *p_name)
+    {
+        p_name++;
+    }
+    for (uint32_t i = 0U; i < count; i++)
+    {
+        if (0 == strncmp(p_store->p_entries[i].name, p_name, OSPI_ASSET_NAME_MAX))
+        {
+            return &p_store->p_entries[i];
+        }
+    }
+
+    return NULL;
+}
+
+/*******************************************************************************************************************//**
+ * @brief       Address of the asset data in the mapped window. Can be handed to Dave2D or LVGL directly.
+ **********************************************************************************************************************/
+void const * ospi_asset_data(ospi_asset_store_t const * p_store, ospi_asset_entry_t const * p_entry)
+{
+    return p_store->p_base + p_entry->offset;
+}
+
+/*******************************************************************************************************************//**
+ * @brief       Check the data of one asset against its CRC. Reads the whole asset, meant for update and debug.
+ **********************************************************************************************************************/
+bool ospi_asset_verify(ospi_asset_store_t const * p_store, ospi_asset_entry_t const * p_entry)
+{
+    return p_entry->crc == ospi_asset_crc32(0U, ospi_asset_data(p_store, p_entry), p_entry->size);
+}
+
+/*******************************************************************************************************************//**
+ * @brief       CRC-32 as used by zlib. Pass the previous result as crc to continue over several buffers, 0 to start.
+ **********************************************************************************************************************/
+uint32_t ospi_asset_crc32(uint32_t crc, void const * p_data, uint32_t size)
+{
+    uint8_t const * p = (uint8_t const *) p_data;
+
+    crc = ~crc;
+    for (uint32_t i = 0U; i < size; i++)
+    {
+        crc ^= p[i];
+        crc  = (crc >> 4) ^ g_ospi_asset_crc_table[crc & 0x0FU];
+        crc  = (crc >> 4) ^ g_ospi_asset_crc_table[crc & 0x0FU];
+    }
+
+    return ~crc;
+}
+
+/*******************************************************************************************************************//**
+ * @} (end addtogroup ospi_asset)
+ **********************************************************************************************************************/
@@ -0,0 +1,105 @@
+/***********************************************************************************************************************
+ * File Name    : ospi_asset.h
+ * Description  : Contains data structures and functions used in ospi_asset.c
+ **********************************************************************************************************************/
+
+/*
+* Copyright (c) 2024 Renesas Electronics Corporation and/or its affiliates
+*
+* SPDX-License-Identifier: BSD-3-Clause
+*/
+
+#ifndef OSPI_ASSET_H_
+#define OSPI_ASSET_H_
+
+#include <stdint.h>
+#include <stdbool.h>
+
+/*******************************************************************************************************************//**
+ * @addtogroup ospi_asset
+ * @{
+ **********************************************************************************************************************/
+
+/* Asset store layout in the memory-mapped OSPI window:
+ *
+ *   +---------------------+  base
+ *   | ospi_asset_header_t |
+ *   | ospi_asset_entry_t  |  x count
+ *   +---------------------+  OSPI_ASSET_ALIGN aligned
+ *   | asset data          |  every asset starts OSPI_ASSET_ALIGN aligned
+ *   +---------------------+  base + total_size
+ *
+ * The header and index are programmed last, so an interrupted write leaves no valid magic behind.
+ * All fields are little endian. */
+
+/******************************************************************************
+ Macro definitions
+ ******************************************************************************/
+#define OSPI_ASSET_STORE_ADDRESS    (0x90040000U)   /* First 256KB sector of CS1 above the demo and calibration area */
+#define OSPI_ASSET_MAGIC            (0x5341534FU)   /* "OSAS" */
+#define OSPI_ASSET_VERSION          (1U)
+#define OSPI_ASSET_ALIGN            (256U)          /* Flash page, also a multiple of the 32 byte cache line */
+#define OSPI_ASSET_NAME_MAX         (24U)           /* Including the terminating NUL */
+
+/* Image color formats, same values as lv_color_format_t */
+#define OSPI_ASSET_CF_A8            (0x0EU)
+#define OSPI_ASSET_CF_RGB888        (0x0FU)
+#define OSPI_ASSET_CF_ARGB8888      (0x10U)
+#define OSPI_ASSET_CF_RGB565        (0x12U)
+
+/******************************************************************************
+ Typedef definitions
+ ******************************************************************************/
+typedef enum e_ospi_asset_type
+{
+    OSPI_ASSET_TYPE_RAW   = 0,                      /* Opaque blob, e.g. an LVGL binary font */
+    OSPI_ASSET_TYPE_IMAGE = 1,                      /* Pixel data, cf/w/h/stride describe it */
+} ospi_asset_type_t;
+
+typedef struct st_ospi_asset_header
+{
+    uint32_t magic;
+    uint16_t version;
+    uint16_t count;                                 /* Entries following the header */
+    uint32_t total_size;                            /* Header, index and data */
+    uint32_t index_crc;                             /* CRC-32 of the entries */
+    uint32_t reserved[4];
+} ospi_asset_header_t;
+
+typedef struct st_ospi_asset_entry
+{
+    char     name[OSPI_ASSET_NAME_MAX];
+    uint32_t offset;                                /* From the store base, OSPI_ASSET_ALIGN aligned */
+    uint32_t size;
+    uint32_t crc;                                   /* CRC-32 of the data */
+    uint8_t  type;                                  /* ospi_asset_type_t */
+    uint8_t  cf;                                    /* Image: lv_color_format_t */
+    uint16_t stride;                                /* Image: bytes per row */
+    uint16_t w;
+    uint16_t h;
+} ospi_asset_entry_t;
+
+/** Mounted store, only pointers into the mapped window */
+typedef struct st_ospi_asset_store
+{
+    uint8_t const            * p_base;
+    ospi_asset_header_t const * p_header;
+    ospi_asset_entry_t const  * p_entries;
+} ospi_asset_store_t;
+
+/******************************************************************************
+ Function prototypes
+ ******************************************************************************/
+bool                       ospi_asset_mount(ospi_asset_store_t * p_store, void const * p_base);
+uint32_t                   ospi_asset_count(ospi_asset_store_t const * p_store);
+ospi_asset_entry_t const * ospi_asset_at(ospi_asset_store_t const * p_store, uint32_t index);
+ospi_asset_entry_t const * ospi_asset_find(ospi_asset_store_t const * p_store, char const * p_name);
+void const               * ospi_asset_data(ospi_asset_store_t const * p_store, ospi_asset_entry_t const * p_entry);
+bool                       ospi_asset_verify(ospi_asset_store_t const * p_store, ospi_asset_entry_t const * p_entry);
+uint32_t                   ospi_asset_crc32(uint32_t crc, void const * p_data, uint32_t size);
+
+/*******************************************************************************************************************//**
+ * @} (end addtogroup ospi_asset)
+ **********************************************************************************************************************/
+
+#endif /* OSPI_ASSET_H_ */
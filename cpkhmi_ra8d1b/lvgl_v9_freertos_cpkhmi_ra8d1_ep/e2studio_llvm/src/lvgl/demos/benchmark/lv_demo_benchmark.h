@@ -25,6 +25,17 @@ extern "C" {
  *      TYPEDEFS
  **********************/
 
+/** The measurements of a scene in `lv_demo_benchmark_run_headless()`*/
+typedef struct {
+    const char * name;
+    uint32_t frame_cnt;         /**< Number of rendered frames*/
+    uint32_t render_time_us;    /**< Sum of the render times (`LV_EVENT_RENDER_START` to `LV_EVENT_RENDER_READY`)*/
+    uint32_t frame_time_us;     /**< Sum of the frame times including the timers, animations and layout too*/
+    uint32_t draw_task_cnt;     /**< Number of created draw tasks*/
+    uint32_t layer_mem_max_kb;  /**< Peak memory used by the layers. Can vary if the draw units run in threads*/
+    uint32_t mem_max_used;      /**< Peak heap usage after the frames. 0 if `lv_mem_monitor()` is not supported*/
+} lv_demo_benchmark_result_t;
+
 /**********************
  * GLOBAL PROTOTYPES
  **********************/
@@ -34,6 +45,32 @@ extern "C" {
 
 void lv_demo_benchmark(void);
 
+/**
+ * Run all scenes synchronously without showing them, e.g. for regression tests on a PC.
+ * Each scene renders `frame_cnt` frames and the tick is advanced by `frame_period` ms
+ * before every frame, independently of the real time. This way the rendered frames are
+ * the same in every run, only the measured times can be different.
+ * @param frame_cnt     number of frames to render in each scene
+ * @param frame_period  virtual time between the frames in ms
+ * @param time_cb       return a free running time in microseconds to measure the render times or NULL
+ */
+void lv_demo_benchmark_run_headless(uint32_t frame_cnt, uint32_t frame_period, uint32_t (*time_cb)(void));
+
+/**
+ * Get the result of a scene measured by `lv_demo_benchmark_run_headless()`
+ * @param scene     index of the scene
+ * @return          pointer to the result or NULL if there is no such scene
+ */
+const lv_demo_benchmark_result_t * lv_demo_benchmark_get_result(uint32_t scene);
+
+/**
+ * Write the results of `lv_demo_benchmark_run_headless()` to a buffer as JSON
+ * @param buf       buffer for the string
+ * @param buf_size  size of the buffer
+ * @return          length of the string or 0 if the buffer was too small
+ */
+uint32_t lv_demo_benchmark_get_json(char * buf, uint32_t buf_size);
+
 /**********************
  *      MACROS
  **********************/
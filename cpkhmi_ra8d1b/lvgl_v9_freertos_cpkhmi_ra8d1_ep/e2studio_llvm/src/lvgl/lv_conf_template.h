@@ -56,6 +56,24 @@
     #endif
 #endif  /*LV_USE_MALLOC == LV_STDLIB_BUILTIN*/
 
+/*Allocate the objects, their special attributes and style arrays, and the draw tasks and their descriptors
+ *from chunks of fixed size blocks instead of allocating them one by one with `lv_malloc()`.
+ *The emptied chunks are kept for reuse until `lv_mem_slab_trim_all()` is called.*/
+#define LV_MEM_SLAB 1
+
+#if LV_USE_STDLIB_STRING == LV_STDLIB_BUILTIN
+    /*Pass the copies and fills of at least this many bytes to `LV_STRING_OFFLOAD_MEMCPY/MEMSET`, e.g. to do them with a DMA.
+     *`bool my_memcpy(void * dst, const void * src, size_t len)` and `bool my_memset(void * dst, uint8_t v, size_t len)`
+     *should return only when the data is written and visible to the CPU, or return false to let the CPU do it.
+     *The copies of `lv_memmove()` can overlap if `dst < src`. 0: to disable*/
+    #define LV_STRING_OFFLOAD_SIZE 0
+    #if LV_STRING_OFFLOAD_SIZE
+        #undef LV_STRING_OFFLOAD_INCLUDE
+        #undef LV_STRING_OFFLOAD_MEMCPY
+        #undef LV_STRING_OFFLOAD_MEMSET
+    #endif
+#endif  /*LV_USE_STDLIB_STRING == LV_STDLIB_BUILTIN*/
+
 /*====================
    HAL SETTINGS
  *====================*/
@@ -119,13 +137,16 @@
     #if LV_DRAW_SW_COMPLEX == 1
         /*Allow buffering some shadow calculation.
         *LV_DRAW_SW_SHADOW_CACHE_SIZE is the max. shadow size to buffer, where shadow size is `shadow_width + radius`
-        *Caching has LV_DRAW_SW_SHADOW_CACHE_SIZE^2 RAM cost*/
+        *Caching has up to 2 * LV_DRAW_SW_SHADOW_CACHE_SIZE^2 RAM cost per entry*/
         #define LV_DRAW_SW_SHADOW_CACHE_SIZE 0
 
+        /*Number of different shadows (shadow width, radius and size) to cache*/
+        #define LV_DRAW_SW_SHADOW_CACHE_CNT 4
+
         /* Set number of maximally cached circle data.
         * The circumference of 1/4 circle are saved for anti-aliasing
-        * radius * 4 bytes are used per circle (the most often used radiuses are saved)
-        * 0: to disable caching */
+        * radius * 6 bytes are used per circle (the most often used radiuses are saved)
+        * The circles are kept between the refreshes */
         #define LV_DRAW_SW_CIRCLE_CACHE_SIZE 4
     #endif
 
@@ -286,6 +307,10 @@
 /* Add 2 x 32 bit variables to each lv_obj_t to speed up getting style properties */
 #define LV_OBJ_STYLE_CACHE      0
 
+/* In LV_DISPLAY_RENDER_MODE_DIRECT move the rendered pixels of a scrolled opaque container
+ * in the draw buffer and render only the newly visible part */
+#define LV_SCROLL_BLIT          1
+
 /* Add `id` field to `lv_obj_t` */
 #define LV_USE_OBJ_ID           0
 
@@ -410,6 +435,10 @@
 /*Enables/disables support for compressed fonts.*/
 #define LV_USE_FONT_COMPRESSED 0
 
+/*Size of the cache of decompressed glyphs in bytes, the least recently used glyphs are dropped first.
+ *Compressed glyphs are decompressed on every draw without it. 0: to disable caching*/
+#define LV_FONT_FMT_TXT_CACHE_SIZE 0
+
 /*Enable drawing placeholders when glyph dsc is not found*/
 #define LV_USE_FONT_PLACEHOLDER 1
 
@@ -506,6 +535,7 @@
 #if LV_USE_LABEL
     #define LV_LABEL_TEXT_SELECTION 1 /*Enable selecting text of the label*/
     #define LV_LABEL_LONG_TXT_HINT 1  /*Store some extra info in labels to speed up drawing of very long texts*/
+    #define LV_LABEL_LINE_CACHE 1     /*Keep the line breaks and letter widths (12 bytes/line + 2 bytes/letter) to draw without measuring the text*/
     #define LV_LABEL_WAIT_CHAR_COUNT 3  /*The count of wait chart*/
 #endif
 
@@ -32,6 +32,7 @@ extern "C" {
 #include "../misc/lv_timer.h"
 #include "../others/sysmon/lv_sysmon.h"
 #include "../stdlib/builtin/lv_tlsf.h"
+#include "../stdlib/lv_mem_slab.h"
 
 #if LV_USE_FONT_COMPRESSED
 #include "../font/lv_font_fmt_txt.h"
@@ -71,6 +72,12 @@ typedef struct _lv_global_t {
     uint32_t style_last_custom_prop_id;
     uint8_t * style_custom_prop_flag_lookup_table;
 
+    lv_mem_slab_t * mem_slab_head;
+    lv_mem_slab_t obj_slab;
+    lv_mem_slab_t obj_large_slab;
+    lv_mem_slab_t obj_spec_attr_slab;
+    lv_mem_slab_t obj_style_slab;
+
     lv_ll_t group_ll;
     lv_group_t * group_default;
 
@@ -110,7 +117,7 @@ typedef struct _lv_global_t {
     lv_draw_sw_shadow_cache_t sw_shadow_cache;
 #endif
 #if LV_DRAW_SW_COMPLEX
-    _lv_draw_sw_mask_radius_circle_dsc_arr_t sw_circle_cache;
+    _lv_draw_sw_mask_circle_cache_t sw_circle_cache;
 #endif
 
 #if LV_USE_LOG
@@ -161,8 +168,12 @@ typedef struct _lv_global_t {
     lv_cache_t * tiny_ttf_cache;
 #endif
 
-#if LV_USE_FONT_COMPRESSED
-    lv_font_fmt_rle_t font_fmt_rle;
+#if LV_USE_TJPGD
+    struct _lv_tjpgd_backend_t * tjpgd_backend;
+#endif
+
+#if LV_USE_FONT_COMPRESSED && LV_FONT_FMT_TXT_CACHE_SIZE > 0
+    lv_cache_t * font_fmt_txt_cache;
 #endif
 
 #if LV_USE_SPAN != 0
@@ -179,6 +190,8 @@ typedef struct _lv_global_t {
 
 #if LV_USE_SYSMON && LV_USE_PERF_MONITOR
     lv_sysmon_backend_data_t sysmon_perf;
+    uint32_t layout_elaps_sum;      /*Time spent in `lv_obj_update_layout`, collected by the perf. monitor*/
+    uint32_t layout_cnt;
 #endif
 
 #if LV_USE_SYSMON && LV_USE_MEM_MONITOR
@@ -19,6 +19,8 @@
 #include "../misc/lv_log.h"
 #include "../tick/lv_tick.h"
 #include "../stdlib/lv_string.h"
+#include "../core/lv_global.h"
+#include "../widgets/label/lv_label.h"
 #include <stdint.h>
 #include <string.h>
 
@@ -30,6 +32,17 @@
 #define LV_OBJ_DEF_HEIGHT   (LV_DPX(50))
 #define STYLE_TRANSITION_MAX 32
 
+/*Labels are the most common widgets larger than `lv_obj_t`*/
+#if LV_USE_LABEL
+    #define OBJ_LARGE_SIZE      sizeof(lv_label_t)
+#else
+    #define OBJ_LARGE_SIZE      (2 * sizeof(lv_obj_t))
+#endif
+#define obj_slab_p &(LV_GLOBAL_DEFAULT()->obj_slab)
+#define obj_large_slab_p &(LV_GLOBAL_DEFAULT()->obj_large_slab)
+#define obj_spec_attr_slab_p &(LV_GLOBAL_DEFAULT()->obj_spec_attr_slab)
+#define obj_style_slab_p &(LV_GLOBAL_DEFAULT()->obj_style_slab)
+
 /**********************
  *      TYPEDEFS
  **********************/
@@ -44,6 +57,7 @@ static void lv_obj_event(const lv_obj_class_t * class_p, lv_event_t * e);
 static void draw_scrollbar(lv_obj_t * obj, lv_layer_t * layer);
 static lv_result_t scrollbar_init_draw_dsc(lv_obj_t * obj, lv_draw_rect_dsc_t * dsc);
 static bool obj_valid_child(const lv_obj_t * parent, const lv_obj_t * obj_to_find);
+static bool depends_on_parent_size(lv_obj_t * obj);
 static void update_obj_state(lv_obj_t * obj, lv_state_t new_state);
 #if LV_USE_OBJ_PROPERTY
     static lv_result_t lv_obj_set_any(lv_obj_t *, lv_prop_id_t, const lv_property_t *);
@@ -95,6 +109,25 @@ const lv_obj_class_t lv_obj_class = {
  *   GLOBAL FUNCTIONS
  **********************/
 
+void _lv_obj_core_init(void)
+{
+    /*Widgets of the size of `lv_obj_t` (e.g. buttons) use the "obj" blocks, the others up to the size of
+     *a label (e.g. images, switches, checkboxes) use the "obj_large" blocks.
+     *Larger widgets and objects with more than 8 styles are allocated on the heap.*/
+    lv_mem_slab_init(obj_slab_p, "obj", sizeof(lv_obj_t), 16);
+    lv_mem_slab_init(obj_large_slab_p, "obj_large", OBJ_LARGE_SIZE, 16);
+    lv_mem_slab_init(obj_spec_attr_slab_p, "obj_spec_attr", sizeof(_lv_obj_spec_attr_t), 16);
+    lv_mem_slab_init(obj_style_slab_p, "obj_style", 8 * sizeof(_lv_obj_style_t), 16);
+}
+
+void _lv_obj_core_deinit(void)
+{
+    lv_mem_slab_deinit(obj_slab_p);
+    lv_mem_slab_deinit(obj_large_slab_p);
+    lv_mem_slab_deinit(obj_spec_attr_slab_p);
+    lv_mem_slab_deinit(obj_style_slab_p);
+}
+
 lv_obj_t * lv_obj_create(lv_obj_t * parent)
 {
     LV_LOG_INFO("begin");
@@ -146,6 +179,8 @@ void lv_obj_add_flag(lv_obj_t * obj, lv_obj_flag_t f)
         lv_obj_invalidate_area(obj, &hor_area);
         lv_obj_invalidate_area(obj, &ver_area);
     }
+
+    if(f & LV_OBJ_FLAG_CACHE_AS_BITMAP) lv_obj_invalidate(obj);
 }
 
 void lv_obj_remove_flag(lv_obj_t * obj, lv_obj_flag_t f)
@@ -174,6 +209,10 @@ void lv_obj_remove_flag(lv_obj_t * obj, lv_obj_flag_t f)
         lv_obj_mark_layout_as_dirty(lv_obj_get_parent(obj));
     }
 
+    if(f & LV_OBJ_FLAG_CACHE_AS_BITMAP) {
+        _lv_obj_free_bitmap_cache(obj);
+        lv_obj_invalidate(obj);
+    }
 }
 
 void lv_obj_update_flag(lv_obj_t * obj, lv_obj_flag_t f, bool v)
@@ -262,7 +301,7 @@ void lv_obj_allocate_spec_attr(lv_obj_t * obj)
     LV_ASSERT_OBJ(obj, MY_CLASS);
 
     if(obj->spec_attr == NULL) {
-        obj->spec_attr = lv_malloc_zeroed(sizeof(_lv_obj_spec_attr_t));
+        obj->spec_attr = lv_mem_slab_alloc_zeroed(obj_spec_attr_slab_p, sizeof(_lv_obj_spec_attr_t));
         LV_ASSERT_MALLOC(obj->spec_attr);
         if(obj->spec_attr == NULL) return;
 
@@ -375,7 +414,9 @@ static void lv_obj_destructor(const lv_obj_class_t * class_p, lv_obj_t * obj)
 
         lv_event_remove_all(&obj->spec_attr->event_list);
 
-        lv_free(obj->spec_attr);
+        _lv_obj_free_bitmap_cache(obj);
+
+        lv_mem_slab_free(obj_spec_attr_slab_p, obj->spec_attr);
         obj->spec_attr = NULL;
     }
 
@@ -683,11 +724,17 @@ static void lv_obj_event(const lv_obj_class_t * class_p, lv_event_t * e)
             lv_obj_mark_layout_as_dirty(obj);
         }
 
+        /*If the top left corner hasn't moved only the children sized or aligned relative to this object are affected.
+         *The children positioned by a layout are updated by the layout anyway.*/
+        const lv_area_t * ori = lv_event_get_param(e);
+        bool moved = ori == NULL || ori->x1 != obj->coords.x1 || ori->y1 != obj->coords.y1 ||
+                     lv_obj_get_style_base_dir(obj, LV_PART_MAIN) == LV_BASE_DIR_RTL;
+
         uint32_t i;
         uint32_t child_cnt = lv_obj_get_child_count(obj);
         for(i = 0; i < child_cnt; i++) {
             lv_obj_t * child = obj->spec_attr->children[i];
-            lv_obj_mark_layout_as_dirty(child);
+            if(moved || depends_on_parent_size(child)) lv_obj_mark_layout_as_dirty(child);
         }
     }
     else if(code == LV_EVENT_CHILD_CHANGED) {
@@ -821,6 +868,24 @@ static bool obj_valid_child(const lv_obj_t * parent, const lv_obj_t * obj_to_fin
     return false;
 }
 
+static bool depends_on_parent_size(lv_obj_t * obj)
+{
+    if(LV_COORD_IS_PCT(lv_obj_get_style_width(obj, LV_PART_MAIN))) return true;
+    if(LV_COORD_IS_PCT(lv_obj_get_style_height(obj, LV_PART_MAIN))) return true;
+    if(LV_COORD_IS_PCT(lv_obj_get_style_min_width(obj, LV_PART_MAIN))) return true;
+    if(LV_COORD_IS_PCT(lv_obj_get_style_max_width(obj, LV_PART_MAIN))) return true;
+    if(LV_COORD_IS_PCT(lv_obj_get_style_min_height(obj, LV_PART_MAIN))) return true;
+    if(LV_COORD_IS_PCT(lv_obj_get_style_max_height(obj, LV_PART_MAIN))) return true;
+
+    if(lv_obj_is_layout_positioned(obj)) return false;
+
+    if(LV_COORD_IS_PCT(lv_obj_get_style_x(obj, LV_PART_MAIN))) return true;
+    if(LV_COORD_IS_PCT(lv_obj_get_style_y(obj, LV_PART_MAIN))) return true;
+
+    lv_align_t align = lv_obj_get_style_align(obj, LV_PART_MAIN);
+    return align != LV_ALIGN_DEFAULT && align != LV_ALIGN_TOP_LEFT;
+}
+
 #if LV_USE_OBJ_PROPERTY
 static lv_result_t lv_obj_set_any(lv_obj_t * obj, lv_prop_id_t id, const lv_property_t * prop)
 {
@@ -117,6 +117,7 @@ typedef enum {
 #if LV_USE_FLEX
     LV_OBJ_FLAG_FLEX_IN_NEW_TRACK = (1L << 21),     /**< Start a new flex track on this item*/
 #endif
+    LV_OBJ_FLAG_CACHE_AS_BITMAP = (1L << 22), /**< Render the object with its children once and redraw it from that bitmap until something invalidates them*/
 
     LV_OBJ_FLAG_LAYOUT_1        = (1L << 23), /**< Custom flag, free to use by layouts*/
     LV_OBJ_FLAG_LAYOUT_2        = (1L << 24), /**< Custom flag, free to use by layouts*/
@@ -155,6 +156,7 @@ enum {
     LV_PROPERTY_ID(OBJ, FLAG_SEND_DRAW_TASK_EVENTS, LV_PROPERTY_TYPE_INT,       19),
     LV_PROPERTY_ID(OBJ, FLAG_OVERFLOW_VISIBLE,      LV_PROPERTY_TYPE_INT,       20),
     LV_PROPERTY_ID(OBJ, FLAG_FLEX_IN_NEW_TRACK,     LV_PROPERTY_TYPE_INT,       21),
+    LV_PROPERTY_ID(OBJ, FLAG_CACHE_AS_BITMAP,       LV_PROPERTY_TYPE_INT,       22),
     LV_PROPERTY_ID(OBJ, FLAG_LAYOUT_1,              LV_PROPERTY_TYPE_INT,       23),
     LV_PROPERTY_ID(OBJ, FLAG_LAYOUT_2,              LV_PROPERTY_TYPE_INT,       24),
     LV_PROPERTY_ID(OBJ, FLAG_WIDGET_1,              LV_PROPERTY_TYPE_INT,       25),
@@ -205,6 +207,8 @@ typedef struct {
 
     lv_point_t scroll;              /**< The current X/Y scroll offset*/
 
+    lv_draw_buf_t * bitmap_cache;   /**< The object rendered with its children if `LV_OBJ_FLAG_CACHE_AS_BITMAP` is set*/
+
     int32_t ext_click_pad;          /**< Extra click padding in all direction*/
     int32_t ext_draw_size;          /**< EXTend the size in every direction for drawing.*/
 
@@ -214,6 +218,7 @@ typedef struct {
     uint16_t scroll_snap_y : 2;     /**< Where to align the snappable children vertically*/
     uint16_t scroll_dir : 4;        /**< The allowed scroll direction(s), see `lv_dir_t`*/
     uint16_t layer_type : 2;        /**< Cache the layer type here. Element of @lv_intermediate_layer_type_t */
+    uint16_t bitmap_cache_valid : 1; /**< `bitmap_cache` still shows the object and its children*/
 } _lv_obj_spec_attr_t;
 
 struct _lv_obj_t {
@@ -233,6 +238,7 @@ struct _lv_obj_t {
     lv_obj_flag_t flags;
     lv_state_t state;
     uint16_t layout_inv : 1;
+    uint16_t child_layout_inv : 1;      /*A descendant has `layout_inv` or `readjust_scroll_after_layout` set*/
     uint16_t readjust_scroll_after_layout : 1;
     uint16_t scr_layout_inv : 1;
     uint16_t skip_trans : 1;
@@ -240,12 +246,27 @@ struct _lv_obj_t {
     uint16_t h_layout   : 1;
     uint16_t w_layout   : 1;
     uint16_t is_deleting : 1;
+    uint16_t layout_visiting : 1;           /*The layout of the object or its children is being updated*/
+    uint16_t scrollbar_inv_after_layout : 1;
+    uint16_t large_slab : 1;                /*Allocated from the "obj_large" slab*/
 };
 
 /**********************
  * GLOBAL PROTOTYPES
  **********************/
 
+/**
+ * Initialize the memory slabs of the objects.
+ * Called by LVGL in `lv_init()`
+ */
+void _lv_obj_core_init(void);
+
+/**
+ * Deinitialize the memory slabs of the objects.
+ * Called by LVGL in `lv_deinit()`
+ */
+void _lv_obj_core_deinit(void);
+
 /**
  * Create a base object (a rectangle)
  * @param parent    pointer to a parent object. If NULL then a screen will be created.
@@ -107,6 +107,19 @@ int32_t _lv_obj_get_ext_draw_size(const lv_obj_t * obj);
 
 lv_layer_type_t _lv_obj_get_layer_type(const lv_obj_t * obj);
 
+/**
+ * Mark the cached bitmap of the object and of its parents as outdated.
+ * They will be rendered again when they are drawn next time.
+ * @param obj       pointer to an object
+ */
+void _lv_obj_invalidate_bitmap_cache(const lv_obj_t * obj);
+
+/**
+ * Free the cached bitmap of an object (if any)
+ * @param obj       pointer to an object
+ */
+void _lv_obj_free_bitmap_cache(lv_obj_t * obj);
+
 /**********************
  *      MACROS
  **********************/
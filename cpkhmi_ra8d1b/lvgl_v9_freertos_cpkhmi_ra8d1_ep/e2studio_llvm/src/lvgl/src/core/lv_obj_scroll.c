@@ -11,6 +11,7 @@
 #include "../indev/lv_indev.h"
 #include "../indev/lv_indev_scroll.h"
 #include "../display/lv_display.h"
+#include "lv_refr.h"
 
 /*********************
  *      DEFINES
@@ -36,6 +37,12 @@ static void scroll_y_anim(void * obj, int32_t v);
 static void scroll_completed_completed_cb(lv_anim_t * a);
 static void scroll_area_into_view(const lv_area_t * area, lv_obj_t * child, lv_point_t * scroll_value,
                                   lv_anim_enable_t anim_en);
+#if LV_SCROLL_BLIT
+static void scroll_invalidate(lv_obj_t * obj, int32_t dx, int32_t dy);
+static bool scroll_blit_get_area(lv_obj_t * obj, lv_area_t * area);
+static bool scroll_blit_has_draw_cb(const lv_obj_t * obj);
+static bool scroll_blit_is_covered(lv_obj_t * obj, const lv_area_t * area);
+#endif
 
 /**********************
  *  STATIC VARIABLES
@@ -414,13 +421,22 @@ lv_result_t _lv_obj_scroll_by_raw(lv_obj_t * obj, int32_t x, int32_t y)
 
     lv_obj_allocate_spec_attr(obj);
 
+#if LV_SCROLL_BLIT
+    /*The old scrollbars would be moved with the content*/
+    lv_obj_scrollbar_invalidate(obj);
+#endif
+
     obj->spec_attr->scroll.x += x;
     obj->spec_attr->scroll.y += y;
 
     lv_obj_move_children_by(obj, x, y, true);
     lv_result_t res = lv_obj_send_event(obj, LV_EVENT_SCROLL, NULL);
     if(res != LV_RESULT_OK) return res;
+#if LV_SCROLL_BLIT
+    scroll_invalidate(obj, x, y);
+#else
     lv_obj_invalidate(obj);
+#endif
     return LV_RESULT_OK;
 }
 
@@ -793,3 +809,194 @@ static void scroll_area_into_view(const lv_area_t * area, lv_obj_t * child, lv_p
     scroll_value->y += anim_en == LV_ANIM_OFF ? 0 : y_scroll;
     lv_obj_scroll_by(parent, x_scroll, y_scroll, anim_en);
 }
+
+#if LV_SCROLL_BLIT
+
+/**
+ * Invalidate a scrolled object. If possible only the pixels of the object are moved in the draw buffer
+ * and only the parts which are not moved with the children are invalidated.
+ * @param obj       pointer to the scrolled object
+ * @param dx        the children were moved by this many pixels horizontally
+ * @param dy        the children were moved by this many pixels vertically
+ */
+static void scroll_invalidate(lv_obj_t * obj, int32_t dx, int32_t dy)
+{
+    lv_area_t blit_area;
+    if(!scroll_blit_get_area(obj, &blit_area) ||
+       !_lv_inv_scroll_area(lv_obj_get_display(obj), &blit_area, dx, dy)) {
+        lv_obj_invalidate(obj);
+        return;
+    }
+
+    /*The border, outline and the rounded corners are not moved*/
+    lv_area_t ring[4];
+    int8_t ring_cnt = _lv_area_diff(ring, &obj->coords, &blit_area);
+    int8_t i;
+    for(i = 0; i < ring_cnt; i++) {
+        lv_obj_invalidate_area(obj, &ring[i]);
+    }
+
+    /*The new scrollbars*/
+    lv_obj_scrollbar_invalidate(obj);
+
+    /*Floating children stay in place. The refresher invalidates their old pixels in the moved area too.*/
+    uint32_t child_cnt = lv_obj_get_child_count(obj);
+    uint32_t c;
+    for(c = 0; c < child_cnt; c++) {
+        lv_obj_t * child = obj->spec_attr->children[c];
+        if(lv_obj_has_flag(child, LV_OBJ_FLAG_FLOATING)) lv_obj_invalidate(child);
+    }
+}
+
+/**
+ * Get the area of a scrolled object whose pixels can be moved in the draw buffer.
+ * It's the inner part of the object without the border and rounding where only the
+ * uniform background and the children are drawn.
+ * @param obj       pointer to the scrolled object
+ * @param area      store the area here
+ * @return          true: the pixels of `area` can be moved; false: the object needs to be redrawn
+ */
+static bool scroll_blit_get_area(lv_obj_t * obj, lv_area_t * area)
+{
+    lv_display_t * disp = lv_obj_get_display(obj);
+    if(lv_obj_get_screen(obj) != lv_display_get_screen_active(disp)) return false;
+
+    /*During screen load animation the screens might be moved or faded*/
+    if(lv_display_get_screen_prev(disp)) return false;
+
+    if(lv_obj_has_flag(obj, LV_OBJ_FLAG_OVERFLOW_VISIBLE)) return false;
+
+    /*The background needs to be the same everywhere to keep it on the exposed parts too*/
+    if(lv_obj_get_style_bg_opa(obj, LV_PART_MAIN) < LV_OPA_COVER) return false;
+    if(lv_obj_get_style_opa_recursive(obj, LV_PART_MAIN) < LV_OPA_COVER) return false;
+    if(lv_obj_get_style_bg_grad_dir(obj, LV_PART_MAIN) != LV_GRAD_DIR_NONE) return false;
+    if(lv_obj_get_style_bg_image_src(obj, LV_PART_MAIN) != NULL) return false;
+
+    if(scroll_blit_has_draw_cb(obj)) return false;
+
+    /*Only the draw buffer of the display is moved, but not the layers or bitmap caches*/
+    const lv_obj_t * parent = obj;
+    while(parent) {
+        if(_lv_obj_get_layer_type(parent) != LV_LAYER_TYPE_NONE) return false;
+        if(lv_obj_has_flag(parent, LV_OBJ_FLAG_CACHE_AS_BITMAP)) return false;
+        if(parent != obj && lv_obj_get_style_clip_corner(parent, LV_PART_MAIN)) return false;
+        parent = lv_obj_get_parent(parent);
+    }
+
+    int32_t inset = lv_obj_get_style_border_width(obj, LV_PART_MAIN);
+    int32_t outline_pad = lv_obj_get_style_outline_pad(obj, LV_PART_MAIN);
+    if(outline_pad < 0 && lv_obj_get_style_outline_width(obj, LV_PART_MAIN) > 0 &&
+       lv_obj_get_style_outline_opa(obj, LV_PART_MAIN) > LV_OPA_MIN) {
+        inset = LV_MAX(inset, -outline_pad);
+    }
+
+    int32_t w = lv_obj_get_width(obj);
+    int32_t h = lv_obj_get_height(obj);
+    int32_t radius = lv_obj_get_style_radius(obj, LV_PART_MAIN);
+    radius = LV_MIN(radius, LV_MIN(w, h) / 2);
+
+    *area = obj->coords;
+    area->x1 += inset;
+    area->x2 -= inset;
+    area->y1 += LV_MAX(inset, radius);
+    area->y2 -= LV_MAX(inset, radius);
+    if(lv_area_get_width(area) <= 0 || lv_area_get_height(area) <= 0) return false;
+
+    if(!lv_obj_area_is_visible(obj, area)) return false;
+
+    return !scroll_blit_is_covered(obj, area);
+}
+
+/**
+ * Check if anything else than the built-in drawing of the base object can draw on an object
+ * @param obj       pointer to an object
+ * @return          true: the object has other draw callbacks
+ */
+static bool scroll_blit_has_draw_cb(const lv_obj_t * obj)
+{
+    if(lv_obj_has_flag(obj, LV_OBJ_FLAG_SEND_DRAW_TASK_EVENTS)) return true;
+
+    const lv_obj_class_t * class_p = obj->class_p;
+    while(class_p && class_p != &lv_obj_class) {
+        if(class_p->event_cb) return true;
+        class_p = class_p->base_class;
+    }
+
+    if(obj->spec_attr == NULL) return false;
+
+    static const lv_event_code_t draw_codes[] = {
+        LV_EVENT_DRAW_MAIN_BEGIN, LV_EVENT_DRAW_MAIN, LV_EVENT_DRAW_MAIN_END,
+        LV_EVENT_DRAW_POST_BEGIN, LV_EVENT_DRAW_POST, LV_EVENT_DRAW_POST_END,
+    };
+    uint32_t i;
+    for(i = 0; i < sizeof(draw_codes) / sizeof(draw_codes[0]); i++) {
+        if(lv_event_list_has_code(&obj->spec_attr->event_list, draw_codes[i])) return true;
+    }
+
+    return false;
+}
+
+/**
+ * Check if anything is drawn on an area of an object after the object
+ * @param obj       pointer to an object
+ * @param area      the area to check
+ * @return          true: an other object or the parents might draw on `area`
+ */
+static bool scroll_blit_is_covered(lv_obj_t * obj, const lv_area_t * area)
+{
+    lv_area_t tmp;
+    lv_obj_t * child = obj;
+    lv_obj_t * parent = lv_obj_get_parent(obj);
+    while(parent) {
+        /*The siblings after the child are drawn on it*/
+        uint32_t child_cnt = lv_obj_get_child_count(parent);
+        uint32_t i;
+        for(i = lv_obj_get_index(child) + 1; i < child_cnt; i++) {
+            lv_obj_t * sibling = parent->spec_attr->children[i];
+            if(lv_obj_has_flag(sibling, LV_OBJ_FLAG_HIDDEN)) continue;
+
+            lv_area_t sibling_area = sibling->coords;
+            int32_t ext_size = _lv_obj_get_ext_draw_size(sibling);
+            lv_area_increase(&sibling_area, ext_size, ext_size);
+            lv_obj_get_transformed_area(sibling, &sibling_area, true, false);
+            if(_lv_area_intersect(&tmp, &sibling_area, area)) return true;
+        }
+
+        /*The parent draws its scrollbars and maybe its border after the children*/
+        if(lv_obj_get_style_border_post(parent, LV_PART_MAIN)) return true;
+        if(scroll_blit_has_draw_cb(parent)) return true;
+
+        lv_area_t hor_area;
+        lv_area_t ver_area;
+        lv_obj_get_scrollbar_area(parent, &hor_area, &ver_area);
+        if(_lv_area_intersect(&tmp, &hor_area, area)) return true;
+        if(_lv_area_intersect(&tmp, &ver_area, area)) return true;
+
+        child = parent;
+        parent = lv_obj_get_parent(parent);
+    }
+
+    /*The top and system layers are drawn on the screen*/
+    lv_display_t * disp = lv_obj_get_display(obj);
+    lv_obj_t * layers[2] = {lv_display_get_layer_top(disp), lv_display_get_layer_sys(disp)};
+    uint32_t l;
+    for(l = 0; l < 2; l++) {
+        if(layers[l] == NULL) continue;
+        uint32_t child_cnt = lv_obj_get_child_count(layers[l]);
+        uint32_t i;
+        for(i = 0; i < child_cnt; i++) {
+            lv_obj_t * layer_child = layers[l]->spec_attr->children[i];
+            if(lv_obj_has_flag(layer_child, LV_OBJ_FLAG_HIDDEN)) continue;
+
+            lv_area_t child_area = layer_child->coords;
+            int32_t ext_size = _lv_obj_get_ext_draw_size(layer_child);
+            lv_area_increase(&child_area, ext_size, ext_size);
+            lv_obj_get_transformed_area(layer_child, &child_area, true, false);
+            if(_lv_area_intersect(&tmp, &child_area, area)) return true;
+        }
+    }
+
+    return false;
+}
+
+#endif /*LV_SCROLL_BLIT*/
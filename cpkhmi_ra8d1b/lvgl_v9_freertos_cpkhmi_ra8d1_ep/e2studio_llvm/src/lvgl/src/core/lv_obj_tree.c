@@ -567,7 +567,7 @@ static void obj_delete_core(lv_obj_t * obj)
     }
 
     /*Free the object itself*/
-    lv_free(obj);
+    _lv_obj_free(obj);
 }
 
 static lv_obj_tree_walk_res_t walk_core(lv_obj_t * obj, lv_obj_tree_walk_cb_t cb, void * user_data)
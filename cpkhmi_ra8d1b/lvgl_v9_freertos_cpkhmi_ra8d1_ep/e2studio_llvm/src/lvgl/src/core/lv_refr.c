@@ -17,6 +17,7 @@
 #include "../draw/lv_draw.h"
 #include "../font/lv_font_fmt_txt.h"
 #include "../stdlib/lv_string.h"
+#include "../misc/cache/lv_image_cache.h"
 #include "lv_global.h"
 
 /*********************
@@ -41,10 +42,16 @@ static void refr_area_part(lv_layer_t * layer);
 static lv_obj_t * lv_refr_get_top_obj(const lv_area_t * area_p, lv_obj_t * obj);
 static void refr_obj_and_children(lv_layer_t * layer, lv_obj_t * top_obj);
 static void refr_obj(lv_layer_t * layer, lv_obj_t * obj);
+static lv_result_t refr_obj_from_bitmap_cache(lv_layer_t * layer, lv_obj_t * obj);
+static lv_result_t bitmap_cache_update(lv_obj_t * obj, const lv_area_t * area);
 static uint32_t get_max_row(lv_display_t * disp, int32_t area_w, int32_t area_h);
 static void draw_buf_flush(lv_display_t * disp);
 static void call_flush_cb(lv_display_t * disp, const lv_area_t * area, uint8_t * px_map);
 static void wait_for_flushing(lv_display_t * disp);
+#if LV_SCROLL_BLIT
+    static void refr_scroll_blit_prepare(void);
+    static void refr_scroll_blit(void);
+#endif
 
 /**********************
  *  STATIC VARIABLES
@@ -303,6 +310,70 @@ void _lv_inv_area(lv_display_t * disp, const lv_area_t * area_p)
     lv_display_send_event(disp, LV_EVENT_REFR_REQUEST, NULL);
 }
 
+#if LV_SCROLL_BLIT
+bool _lv_inv_scroll_area(lv_display_t * disp, const lv_area_t * area_p, int32_t dx, int32_t dy)
+{
+    if(!disp) disp = lv_display_get_default();
+    if(!disp) return false;
+    if(!lv_display_is_invalidation_enabled(disp)) return false;
+
+    LV_ASSERT_MSG(!disp->rendering_in_progress, "Invalidate area is not allowed during rendering.");
+
+    /*Only in direct mode the draw buffer has the rendered pixels at their place on the screen*/
+    if(disp->render_mode != LV_DISPLAY_RENDER_MODE_DIRECT) return false;
+    if(lv_display_get_rotation(disp) != LV_DISPLAY_ROTATION_0) return false;
+
+    lv_area_t scr_area;
+    scr_area.x1 = 0;
+    scr_area.y1 = 0;
+    scr_area.x2 = lv_display_get_horizontal_resolution(disp) - 1;
+    scr_area.y2 = lv_display_get_vertical_resolution(disp) - 1;
+
+    lv_area_t com_area;
+    if(!_lv_area_intersect(&com_area, area_p, &scr_area)) return false;
+
+    /*Let the driver reject the area, e.g. if it would round it*/
+    lv_area_t driver_area = com_area;
+    lv_result_t res = lv_display_send_event(disp, LV_EVENT_INVALIDATE_AREA, &driver_area);
+    if(res != LV_RESULT_OK || !_lv_area_is_equal(&driver_area, &com_area)) return false;
+
+    if(disp->scroll_blit_pending) {
+        /*Another area is moved already*/
+        if(!_lv_area_is_equal(&disp->scroll_blit_area, &com_area)) return false;
+
+        /*The areas invalidated since the previous scroll are moved by this scroll only,
+         *but the refresher redraws them at their place and moved by the summed delta.
+         *Invalidate them moved by this scroll too.*/
+        uint32_t inv_cnt = disp->inv_p;
+        uint32_t i;
+        for(i = 0; i < inv_cnt; i++) {
+            lv_area_t moved_area;
+            if(!_lv_area_intersect(&moved_area, &disp->inv_areas[i], &com_area)) continue;
+            lv_area_move(&moved_area, dx, dy);
+            if(!_lv_area_intersect(&moved_area, &moved_area, &com_area)) continue;
+            _lv_inv_area(disp, &moved_area);
+        }
+
+        dx += disp->scroll_blit_delta.x;
+        dy += disp->scroll_blit_delta.y;
+    }
+
+    /*Nothing remains from the rendered pixels, just redraw the whole area*/
+    if(LV_ABS(dx) >= lv_area_get_width(&com_area) || LV_ABS(dy) >= lv_area_get_height(&com_area)) {
+        disp->scroll_blit_pending = 0;
+        return false;
+    }
+
+    disp->scroll_blit_area = com_area;
+    disp->scroll_blit_delta.x = dx;
+    disp->scroll_blit_delta.y = dy;
+    disp->scroll_blit_pending = 1;
+
+    lv_display_send_event(disp, LV_EVENT_REFR_REQUEST, NULL);
+    return true;
+}
+#endif
+
 /**
  * Get the display which is being refreshed
  * @return the display being refreshed
@@ -365,12 +436,26 @@ void _lv_display_refr_timer(lv_timer_t * tmr)
     /*Do nothing if there is no active screen*/
     if(disp_refr->act_scr == NULL) {
         disp_refr->inv_p = 0;
+#if LV_SCROLL_BLIT
+        disp_refr->scroll_blit_pending = 0;
+#endif
         LV_LOG_WARN("there is no active screen");
         goto refr_finish;
     }
 
+#if LV_SCROLL_BLIT
+    if(disp_refr->scroll_blit_pending) {
+        /*Sync before invalidating more areas to have all the pixels to move in the draw buffer*/
+        refr_sync_areas();
+        refr_scroll_blit_prepare();
+    }
+#endif
+
     lv_refr_join_area();
     refr_sync_areas();
+#if LV_SCROLL_BLIT
+    refr_scroll_blit();
+#endif
     refr_invalid_areas();
 
     if(disp_refr->inv_p == 0) goto refr_finish;
@@ -394,10 +479,21 @@ void _lv_display_refr_timer(lv_timer_t * tmr)
         *sync_area = disp_refr->inv_areas[i];
     }
 
+#if LV_SCROLL_BLIT
+    /*The moved pixels are in the other buffer only*/
+    if(disp_refr->scroll_blit_act) {
+        lv_area_t * sync_area = _lv_ll_ins_tail(&disp_refr->sync_areas);
+        *sync_area = disp_refr->scroll_blit_area;
+    }
+#endif
+
 refr_clean_up:
     lv_memzero(disp_refr->inv_areas, sizeof(disp_refr->inv_areas));
     lv_memzero(disp_refr->inv_area_joined, sizeof(disp_refr->inv_area_joined));
     disp_refr->inv_p = 0;
+#if LV_SCROLL_BLIT
+    disp_refr->scroll_blit_act = 0;
+#endif
 
 refr_finish:
 
@@ -532,6 +628,68 @@ static void refr_sync_areas(void)
     LV_PROFILER_END;
 }
 
+#if LV_SCROLL_BLIT
+/**
+ * Invalidate the parts of the scrolled area which can't be moved from the rendered pixels
+ */
+static void refr_scroll_blit_prepare(void)
+{
+    disp_refr->scroll_blit_act = 0;
+    if(!disp_refr->scroll_blit_pending) return;
+    disp_refr->scroll_blit_pending = 0;
+
+    const lv_area_t * blit_area = &disp_refr->scroll_blit_area;
+    int32_t dx = disp_refr->scroll_blit_delta.x;
+    int32_t dy = disp_refr->scroll_blit_delta.y;
+    if(dx == 0 && dy == 0) return;
+
+    /*The rendered pixels of an invalidated area are outdated so they can't be moved either.
+     *The areas might be invalidated before or after scrolling, so redraw them on both places.*/
+    uint32_t inv_cnt = disp_refr->inv_p;
+    uint32_t i;
+    for(i = 0; i < inv_cnt; i++) {
+        lv_area_t moved_area;
+        if(!_lv_area_intersect(&moved_area, &disp_refr->inv_areas[i], blit_area)) continue;
+        lv_area_move(&moved_area, dx, dy);
+        if(!_lv_area_intersect(&moved_area, &moved_area, blit_area)) continue;
+        _lv_inv_area(disp_refr, &moved_area);
+    }
+
+    /*Redraw where the pixels are moved from outside of the area*/
+    lv_area_t moved_blit_area = *blit_area;
+    lv_area_move(&moved_blit_area, dx, dy);
+    lv_area_t exposed[4];
+    int8_t exposed_cnt = _lv_area_diff(exposed, blit_area, &moved_blit_area);
+    int8_t j;
+    for(j = 0; j < exposed_cnt; j++) {
+        _lv_inv_area(disp_refr, &exposed[j]);
+    }
+
+    /*It's not worth to move the pixels if the whole area is redrawn anyway*/
+    for(i = 0; i < disp_refr->inv_p; i++) {
+        if(_lv_area_is_in(blit_area, &disp_refr->inv_areas[i], 0)) return;
+    }
+
+    disp_refr->scroll_blit_act = 1;
+}
+
+/**
+ * Move the rendered pixels of the scrolled area in the draw buffer
+ */
+static void refr_scroll_blit(void)
+{
+    if(!disp_refr->scroll_blit_act) return;
+
+    LV_PROFILER_BEGIN;
+    /*Don't modify the buffer while it's being sent to the display*/
+    wait_for_flushing(disp_refr);
+
+    lv_draw_buf_move(disp_refr->buf_act, &disp_refr->scroll_blit_area,
+                     disp_refr->scroll_blit_delta.x, disp_refr->scroll_blit_delta.y);
+    LV_PROFILER_END;
+}
+#endif
+
 /**
  * Refresh the joined areas
  */
@@ -557,6 +715,11 @@ static void refr_invalid_areas(void)
     disp_refr->last_part = 0;
     disp_refr->rendering_in_progress = true;
 
+#if LV_SCROLL_BLIT
+    /*The moved area is flushed last*/
+    if(disp_refr->scroll_blit_act) last_i = -1;
+#endif
+
     for(i = 0; i < (int32_t)disp_refr->inv_p; i++) {
         /*Refresh the unjoined areas*/
         if(disp_refr->inv_area_joined[i] == 0) {
@@ -567,6 +730,15 @@ static void refr_invalid_areas(void)
         }
     }
 
+#if LV_SCROLL_BLIT
+    if(disp_refr->scroll_blit_act) {
+        disp_refr->refreshed_area = disp_refr->scroll_blit_area;
+        disp_refr->last_area = 1;
+        disp_refr->last_part = 1;
+        draw_buf_flush(disp_refr);
+    }
+#endif
+
     disp_refr->rendering_in_progress = false;
     LV_PROFILER_END;
 }
@@ -882,6 +1054,11 @@ void refr_obj(lv_layer_t * layer, lv_obj_t * obj)
 {
     if(lv_obj_has_flag(obj, LV_OBJ_FLAG_HIDDEN)) return;
 
+    /*If the bitmap can't be rendered (e.g. out of memory) draw the object normally*/
+    if(lv_obj_has_flag(obj, LV_OBJ_FLAG_CACHE_AS_BITMAP)) {
+        if(refr_obj_from_bitmap_cache(layer, obj) == LV_RESULT_OK) return;
+    }
+
     lv_layer_type_t layer_type = _lv_obj_get_layer_type(obj);
     if(layer_type == LV_LAYER_TYPE_NONE) {
         lv_obj_redraw(layer, obj);
@@ -949,6 +1126,120 @@ void refr_obj(lv_layer_t * layer, lv_obj_t * obj)
     }
 }
 
+/**
+ * Draw an object and its children from the object's cached bitmap.
+ * The bitmap is rendered first if it was invalidated since it was rendered last time.
+ * @param layer     the layer to draw to
+ * @param obj       pointer to an object with `LV_OBJ_FLAG_CACHE_AS_BITMAP`
+ * @return          LV_RESULT_OK: drawn (or not visible); LV_RESULT_INVALID: the bitmap couldn't be rendered
+ */
+static lv_result_t refr_obj_from_bitmap_cache(lv_layer_t * layer, lv_obj_t * obj)
+{
+    lv_opa_t opa = lv_obj_get_style_opa_layered(obj, 0);
+    if(opa < LV_OPA_MIN) return LV_RESULT_OK;
+
+    int32_t ext_draw_size = _lv_obj_get_ext_draw_size(obj);
+    lv_area_t obj_coords_ext;
+    lv_obj_get_coords(obj, &obj_coords_ext);
+    lv_area_increase(&obj_coords_ext, ext_draw_size, ext_draw_size);
+
+    lv_area_t draw_area = obj_coords_ext;
+    if(_lv_obj_get_layer_type(obj) == LV_LAYER_TYPE_TRANSFORM) {
+        lv_obj_get_transformed_area(obj, &draw_area, false, false);
+    }
+    if(!_lv_area_intersect(&draw_area, &draw_area, &layer->_clip_area)) return LV_RESULT_OK;
+
+    if(bitmap_cache_update(obj, &obj_coords_ext) != LV_RESULT_OK) return LV_RESULT_INVALID;
+
+    lv_draw_image_dsc_t draw_dsc;
+    lv_draw_image_dsc_init(&draw_dsc);
+    draw_dsc.pivot.x = obj->coords.x1 + lv_obj_get_style_transform_pivot_x(obj, 0) - obj_coords_ext.x1;
+    draw_dsc.pivot.y = obj->coords.y1 + lv_obj_get_style_transform_pivot_y(obj, 0) - obj_coords_ext.y1;
+
+    draw_dsc.opa = opa;
+    draw_dsc.rotation = lv_obj_get_style_transform_rotation(obj, 0);
+    while(draw_dsc.rotation > 3600) draw_dsc.rotation -= 3600;
+    while(draw_dsc.rotation < 0) draw_dsc.rotation += 3600;
+    draw_dsc.scale_x = lv_obj_get_style_transform_scale_x(obj, 0);
+    draw_dsc.scale_y = lv_obj_get_style_transform_scale_y(obj, 0);
+    draw_dsc.skew_x = lv_obj_get_style_transform_skew_x(obj, 0);
+    draw_dsc.skew_y = lv_obj_get_style_transform_skew_y(obj, 0);
+    draw_dsc.blend_mode = lv_obj_get_style_blend_mode(obj, 0);
+    draw_dsc.antialias = disp_refr->antialiasing;
+    draw_dsc.src = obj->spec_attr->bitmap_cache;
+
+    lv_draw_image(layer, &draw_dsc, &obj_coords_ext);
+
+    return LV_RESULT_OK;
+}
+
+/**
+ * Render an object with its children into its cached bitmap if the bitmap is missing or outdated
+ * @param obj       pointer to an object
+ * @param area      the area of the object to cache (the coordinates with the extra draw size)
+ * @return          LV_RESULT_OK: the bitmap is up to date; LV_RESULT_INVALID: couldn't allocate the bitmap
+ */
+static lv_result_t bitmap_cache_update(lv_obj_t * obj, const lv_area_t * area)
+{
+    int32_t w = lv_area_get_width(area);
+    int32_t h = lv_area_get_height(area);
+
+    lv_obj_allocate_spec_attr(obj);
+    if(obj->spec_attr == NULL) return LV_RESULT_INVALID;
+
+    lv_draw_buf_t * cache = obj->spec_attr->bitmap_cache;
+    if(cache && (cache->header.w != w || cache->header.h != h)) {
+        _lv_obj_free_bitmap_cache(obj);
+        cache = NULL;
+    }
+
+    if(cache && obj->spec_attr->bitmap_cache_valid) return LV_RESULT_OK;
+
+    LV_PROFILER_BEGIN;
+    if(cache == NULL) {
+        cache = lv_draw_buf_create(w, h, LV_COLOR_FORMAT_ARGB8888, LV_STRIDE_AUTO);
+        if(cache == NULL) {
+            LV_LOG_WARN("Couldn't allocate the cached bitmap. Drawing the object normally.");
+            LV_PROFILER_END;
+            return LV_RESULT_INVALID;
+        }
+        obj->spec_attr->bitmap_cache = cache;
+    }
+    else {
+        /*The content changes, so the image cache can't keep the old one*/
+        lv_image_cache_drop(cache);
+    }
+
+    lv_draw_buf_clear(cache, NULL);
+
+    /*Render the object into its own layer like a snapshot.
+     *The new layer is the head of the display's layer list until it's ready,
+     *so the layers created while rendering are dispatched and freed with it.*/
+    lv_layer_t cache_layer;
+    lv_memzero(&cache_layer, sizeof(cache_layer));
+    cache_layer.draw_buf = cache;
+    cache_layer.buf_area = *area;
+    cache_layer.color_format = LV_COLOR_FORMAT_ARGB8888;
+    cache_layer._clip_area = *area;
+
+    lv_layer_t * layer_head_ori = disp_refr->layer_head;
+    disp_refr->layer_head = &cache_layer;
+
+    /*Set it before drawing so that invalidating something while drawing marks it outdated again*/
+    obj->spec_attr->bitmap_cache_valid = 1;
+    lv_obj_redraw(&cache_layer, obj);
+
+    while(cache_layer.draw_task_head) {
+        lv_draw_dispatch_wait_for_request();
+        lv_draw_dispatch();
+    }
+
+    disp_refr->layer_head = layer_head_ori;
+
+    LV_PROFILER_END;
+    return LV_RESULT_OK;
+}
+
 static uint32_t get_max_row(lv_display_t * disp, int32_t area_w, int32_t area_h)
 {
     bool has_alpha = lv_color_format_has_alpha(disp->color_format);
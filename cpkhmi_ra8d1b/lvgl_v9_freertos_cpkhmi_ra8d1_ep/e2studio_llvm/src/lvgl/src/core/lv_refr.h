@@ -75,6 +75,21 @@ void lv_obj_redraw(lv_layer_t * layer, lv_obj_t * obj);
  */
 void _lv_inv_area(lv_display_t * disp, const lv_area_t * area_p);
 
+#if LV_SCROLL_BLIT
+/**
+ * Mark an area as scrolled: in the next refresh its already rendered pixels are moved by `dx` and `dy`
+ * in the draw buffer and only the newly visible part and the invalidated areas are redrawn.
+ * Everything else drawn on the area should move together with the content.
+ * It works only with `LV_DISPLAY_RENDER_MODE_DIRECT` and one area at a time.
+ * @param disp      pointer to display (NULL to use the default display)
+ * @param area_p    the scrolled area
+ * @param dx        horizontal movement of the content
+ * @param dy        vertical movement of the content
+ * @return          true: the area will be moved; false: it can't be moved, invalidate it instead
+ */
+bool _lv_inv_scroll_area(lv_display_t * disp, const lv_area_t * area_p, int32_t dx, int32_t dy);
+#endif
+
 /**
  * Get the display which is being refreshed
  * @return the display being refreshed
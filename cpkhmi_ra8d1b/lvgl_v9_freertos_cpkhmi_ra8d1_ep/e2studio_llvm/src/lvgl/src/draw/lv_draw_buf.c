@@ -29,6 +29,7 @@ static void * buf_align(void * buf, lv_color_format_t color_format);
 static void * draw_buf_malloc(size_t size_bytes, lv_color_format_t color_format);
 static void draw_buf_free(void * buf);
 static uint32_t width_to_stride(uint32_t w, lv_color_format_t color_format);
+static void buf_move(lv_draw_buf_t * draw_buf, const lv_area_t * area, int32_t dx, int32_t dy);
 static uint32_t _calculate_draw_buf_size(uint32_t w, uint32_t h, lv_color_format_t cf, uint32_t stride);
 
 /**********************
@@ -51,6 +52,7 @@ void _lv_draw_buf_init_handlers(void)
     handlers.align_pointer_cb = buf_align;
     handlers.invalidate_cache_cb = NULL;
     handlers.width_to_stride_cb = width_to_stride;
+    handlers.buf_move_cb = buf_move;
 }
 
 lv_draw_buf_handlers_t * lv_draw_buf_get_handlers(void)
@@ -147,6 +149,14 @@ void lv_draw_buf_copy(lv_draw_buf_t * dest, const lv_area_t * dest_area,
     }
 }
 
+void lv_draw_buf_move(lv_draw_buf_t * draw_buf, const lv_area_t * area, int32_t dx, int32_t dy)
+{
+    LV_ASSERT_NULL(draw_buf);
+    if(dx == 0 && dy == 0) return;
+
+    if(handlers.buf_move_cb) handlers.buf_move_cb(draw_buf, area, dx, dy);
+}
+
 lv_result_t lv_draw_buf_init(lv_draw_buf_t * draw_buf, uint32_t w, uint32_t h, lv_color_format_t cf, uint32_t stride,
                              void * data, uint32_t data_size)
 {
@@ -408,6 +418,35 @@ static uint32_t width_to_stride(uint32_t w, lv_color_format_t color_format)
     return (width_byte + LV_DRAW_BUF_STRIDE_ALIGN - 1) & ~(LV_DRAW_BUF_STRIDE_ALIGN - 1);
 }
 
+static void buf_move(lv_draw_buf_t * draw_buf, const lv_area_t * area, int32_t dx, int32_t dy)
+{
+    /*Only the part of the area where the pixels are moved to is written*/
+    lv_area_t dest_area = *area;
+    lv_area_move(&dest_area, dx, dy);
+    if(!_lv_area_intersect(&dest_area, &dest_area, area)) return;
+
+    uint32_t stride = draw_buf->header.stride;
+    uint32_t line_size = lv_area_get_width(&dest_area) * lv_color_format_get_size(draw_buf->header.cf);
+    int32_t h = lv_area_get_height(&dest_area);
+    uint8_t * dest_bufc = lv_draw_buf_goto_xy(draw_buf, dest_area.x1, dest_area.y1);
+    uint8_t * src_bufc = lv_draw_buf_goto_xy(draw_buf, dest_area.x1 - dx, dest_area.y1 - dy);
+
+    /*When moving down start from the last line to not overwrite the lines which are not moved yet*/
+    int32_t step = stride;
+    if(dy > 0) {
+        dest_bufc += (h - 1) * stride;
+        src_bufc += (h - 1) * stride;
+        step = -step;
+    }
+
+    int32_t y;
+    for(y = 0; y < h; y++) {
+        lv_memmove(dest_bufc, src_bufc, line_size);
+        dest_bufc += step;
+        src_bufc += step;
+    }
+}
+
 static void * draw_buf_malloc(size_t size_bytes, lv_color_format_t color_format)
 {
     if(handlers.buf_malloc_cb) return handlers.buf_malloc_cb(size_bytes, color_format);
@@ -79,7 +79,7 @@ LV_ATTRIBUTE_FAST_MEM void lv_draw_label(lv_layer_t * layer, const lv_draw_label
     LV_PROFILER_BEGIN;
     lv_draw_task_t * t = lv_draw_add_task(layer, coords);
 
-    t->draw_dsc = lv_malloc(sizeof(*dsc));
+    t->draw_dsc = lv_draw_dsc_malloc(sizeof(*dsc));
     lv_memcpy(t->draw_dsc, dsc, sizeof(*dsc));
     t->type = LV_DRAW_TASK_TYPE_LABEL;
 
@@ -177,52 +177,72 @@ void lv_draw_label_iterate_characters(lv_draw_unit_t * draw_unit, const lv_draw_
 
     uint32_t line_start     = 0;
     int32_t last_line_start = -1;
+    uint32_t line_end;
+
+    /*Use the line breaks and letter widths calculated in advance if possible*/
+    const lv_draw_label_lines_t * lines = dsc->lines;
+    if((dsc->flag & LV_TEXT_FLAG_EXPAND) || line_height <= 0) lines = NULL;
+    uint32_t line_idx = 0;
+    uint32_t letter_idx = 0;
+
+    if(lines) {
+        /*Jump to the first visible line*/
+        int32_t hidden_h = draw_unit->clip_area->y1 - (pos.y + line_height_font);
+        if(hidden_h > 0) line_idx = (hidden_h + line_height - 1) / line_height;
+        if(line_idx >= lines->line_cnt) return;
+
+        pos.y += (int32_t)line_idx * line_height;
+        line_start = lines->line[line_idx].start;
+        line_end = lines->line[line_idx + 1].start;
+    }
+    else {
+        /*Check the hint to use the cached info*/
+        if(dsc->hint && y_ofs == 0 && coords->y1 < 0) {
+            /*If the label changed too much recalculate the hint.*/
+            if(LV_ABS(dsc->hint->coord_y - coords->y1) > LV_LABEL_HINT_UPDATE_TH - 2 * line_height) {
+                dsc->hint->line_start = -1;
+            }
+            last_line_start = dsc->hint->line_start;
+        }
 
-    /*Check the hint to use the cached info*/
-    if(dsc->hint && y_ofs == 0 && coords->y1 < 0) {
-        /*If the label changed too much recalculate the hint.*/
-        if(LV_ABS(dsc->hint->coord_y - coords->y1) > LV_LABEL_HINT_UPDATE_TH - 2 * line_height) {
-            dsc->hint->line_start = -1;
+        /*Use the hint if it's valid*/
+        if(dsc->hint && last_line_start >= 0) {
+            line_start = last_line_start;
+            pos.y += dsc->hint->y;
         }
-        last_line_start = dsc->hint->line_start;
-    }
 
-    /*Use the hint if it's valid*/
-    if(dsc->hint && last_line_start >= 0) {
-        line_start = last_line_start;
-        pos.y += dsc->hint->y;
-    }
+        line_end = line_start + _lv_text_get_next_line(&dsc->text[line_start], font, dsc->letter_space, w, NULL, dsc->flag);
 
-    uint32_t line_end = line_start + _lv_text_get_next_line(&dsc->text[line_start], font, dsc->letter_space, w, NULL,
-                                                            dsc->flag);
+        /*Go the first visible line*/
+        while(pos.y + line_height_font < draw_unit->clip_area->y1) {
+            /*Go to next line*/
+            line_start = line_end;
+            line_end += _lv_text_get_next_line(&dsc->text[line_start], font, dsc->letter_space, w, NULL, dsc->flag);
+            pos.y += line_height;
 
-    /*Go the first visible line*/
-    while(pos.y + line_height_font < draw_unit->clip_area->y1) {
-        /*Go to next line*/
-        line_start = line_end;
-        line_end += _lv_text_get_next_line(&dsc->text[line_start], font, dsc->letter_space, w, NULL, dsc->flag);
-        pos.y += line_height;
+            /*Save at the threshold coordinate*/
+            if(dsc->hint && pos.y >= -LV_LABEL_HINT_UPDATE_TH && dsc->hint->line_start < 0) {
+                dsc->hint->line_start = line_start;
+                dsc->hint->y          = pos.y - coords->y1;
+                dsc->hint->coord_y    = coords->y1;
+            }
 
-        /*Save at the threshold coordinate*/
-        if(dsc->hint && pos.y >= -LV_LABEL_HINT_UPDATE_TH && dsc->hint->line_start < 0) {
-            dsc->hint->line_start = line_start;
-            dsc->hint->y          = pos.y - coords->y1;
-            dsc->hint->coord_y    = coords->y1;
+            if(dsc->text[line_start] == '\0') return;
         }
-
-        if(dsc->text[line_start] == '\0') return;
     }
 
     /*Align to middle*/
     if(align == LV_TEXT_ALIGN_CENTER) {
-        line_width = lv_text_get_width(&dsc->text[line_start], line_end - line_start, font, dsc->letter_space);
+        line_width = lines ? lines->line[line_idx].w :
+                     lv_text_get_width(&dsc->text[line_start], line_end - line_start, font, dsc->letter_space);
 
         pos.x += (lv_area_get_width(coords) - line_width) / 2;
 
     }
     /*Align to the right*/
     else if(align == LV_TEXT_ALIGN_RIGHT) {
-        line_width = lv_text_get_width(&dsc->text[line_start], line_end - line_start, font, dsc->letter_space);
+        line_width = lines ? lines->line[line_idx].w :
+                     lv_text_get_width(&dsc->text[line_start], line_end - line_start, font, dsc->letter_space);
         pos.x += lv_area_get_width(coords) - line_width;
     }
 
@@ -256,6 +276,7 @@ void lv_draw_label_iterate_characters(lv_draw_unit_t * draw_unit, const lv_draw_
 
         /*Write all letter of a line*/
         i = 0;
+        if(lines) letter_idx = lines->line[line_idx].letter_start;
 #if LV_USE_BIDI
         char * bidi_txt = lv_malloc(line_end - line_start + 1);
         LV_ASSERT_MALLOC(bidi_txt);
@@ -280,7 +301,8 @@ void lv_draw_label_iterate_characters(lv_draw_unit_t * draw_unit, const lv_draw_
             uint32_t letter_next;
             _lv_text_encoded_letter_next_2(bidi_txt, &letter, &letter_next, &i);
 
-            letter_w = lv_font_get_glyph_width(font, letter, letter_next);
+            if(lines && lines->letter_w) letter_w = lines->letter_w[letter_idx++];
+            else letter_w = lv_font_get_glyph_width(font, letter, letter_next);
 
             /*Always set the bg_coordinates for placeholder drawing*/
             bg_coords.x1 = pos.x;
@@ -333,20 +355,27 @@ void lv_draw_label_iterate_characters(lv_draw_unit_t * draw_unit, const lv_draw_
 #endif
         /*Go to next line*/
         line_start = line_end;
-        line_end += _lv_text_get_next_line(&dsc->text[line_start], font, dsc->letter_space, w, NULL, dsc->flag);
+        if(lines) {
+            line_idx++;
+            if(line_idx >= lines->line_cnt) break;
+            line_end = lines->line[line_idx + 1].start;
+        }
+        else {
+            line_end += _lv_text_get_next_line(&dsc->text[line_start], font, dsc->letter_space, w, NULL, dsc->flag);
+        }
 
         pos.x = coords->x1;
         /*Align to middle*/
         if(align == LV_TEXT_ALIGN_CENTER) {
-            line_width =
-                lv_text_get_width(&dsc->text[line_start], line_end - line_start, font, dsc->letter_space);
+            line_width = lines ? lines->line[line_idx].w :
+                         lv_text_get_width(&dsc->text[line_start], line_end - line_start, font, dsc->letter_space);
 
             pos.x += (lv_area_get_width(coords) - line_width) / 2;
         }
         /*Align to the right*/
         else if(align == LV_TEXT_ALIGN_RIGHT) {
-            line_width =
-                lv_text_get_width(&dsc->text[line_start], line_end - line_start, font, dsc->letter_space);
+            line_width = lines ? lines->line[line_idx].w :
+                         lv_text_get_width(&dsc->text[line_start], line_end - line_start, font, dsc->letter_space);
             pos.x += lv_area_get_width(coords) - line_width;
         }
 
@@ -17,14 +17,24 @@
 #include "../../stdlib/lv_string.h"
 #include "../lv_draw_mask.h"
 
+#if LV_USE_DRAW_SW_ASM == LV_DRAW_SW_ASM_HELIUM
+    #include "lv_draw_sw_box_shadow_mve.h"
+#endif
+
 /*********************
  *      DEFINES
  *********************/
 #define SHADOW_UPSCALE_SHIFT    6
 #define SHADOW_ENHANCE          1
 
-#if defined(LV_DRAW_SW_SHADOW_CACHE_SIZE) && LV_DRAW_SW_SHADOW_CACHE_SIZE > 0
-    #define shadow_cache LV_GLOBAL_DEFAULT()->sw_shadow_cache
+/*`n / d` with a multiplication. Exact if `n * d < 2^32` and `d >= 2`*/
+#define SHADOW_RECIPROCAL(d)    (0xFFFFFFFFU / (uint32_t)(d) + 1)
+#define SHADOW_DIV(n, recip)    ((uint32_t)(((uint64_t)(n) * (recip)) >> 32))
+
+#if LV_DRAW_SW_SHADOW_CACHE_SIZE
+    #define SHADOW_CACHE_LIFE_MAX           1000
+    #define SHADOW_CACHE_AGING(life, size)  life = LV_MIN(life + 1 + ((size) >> 3), SHADOW_CACHE_LIFE_MAX)
+    #define shadow_cache                    LV_GLOBAL_DEFAULT()->sw_shadow_cache
 #endif
 
 /**********************
@@ -38,6 +48,11 @@
 LV_ATTRIBUTE_FAST_MEM static void shadow_draw_corner_buf(const lv_area_t * coords, uint16_t * sh_buf, int32_t s,
                                                          int32_t r);
 LV_ATTRIBUTE_FAST_MEM static void shadow_blur_corner(int32_t size, int32_t sw, uint16_t * sh_ups_buf);
+static void shadow_mirror_corner(lv_opa_t * sh_buf, int32_t size);
+#if LV_DRAW_SW_SHADOW_CACHE_SIZE
+static _lv_draw_sw_shadow_cache_entry_t * shadow_cache_get(const lv_area_t * core_area, int32_t sw, int32_t r);
+static void shadow_cache_release(_lv_draw_sw_shadow_cache_entry_t * entry);
+#endif
 #endif /*LV_DRAW_SW_COMPLEX*/
 
 /**********************
@@ -52,6 +67,24 @@ LV_ATTRIBUTE_FAST_MEM static void shadow_blur_corner(int32_t size, int32_t sw, u
  *   GLOBAL FUNCTIONS
  **********************/
 
+#if LV_DRAW_SW_SHADOW_CACHE_SIZE
+void _lv_draw_sw_box_shadow_cache_init(void)
+{
+    lv_memzero(shadow_cache.entries, sizeof(shadow_cache.entries));
+    lv_mutex_init(&shadow_cache.mutex);
+}
+
+void _lv_draw_sw_box_shadow_cache_deinit(void)
+{
+    uint32_t i;
+    for(i = 0; i < LV_DRAW_SW_SHADOW_CACHE_CNT; i++) {
+        lv_free(shadow_cache.entries[i].buf);
+    }
+    lv_memzero(shadow_cache.entries, sizeof(shadow_cache.entries));
+    lv_mutex_delete(&shadow_cache.mutex);
+}
+#endif
+
 void lv_draw_sw_box_shadow(lv_draw_unit_t * draw_unit, const lv_draw_box_shadow_dsc_t * dsc, const lv_area_t * coords)
 {
     /*Calculate the rectangle which is blurred to get the shadow in `shadow_area`*/
@@ -94,31 +127,23 @@ void lv_draw_sw_box_shadow(lv_draw_unit_t * draw_unit, const lv_draw_box_shadow_
     /*Get how many pixels are affected by the blur on the corners*/
     int32_t corner_size = dsc->width  + r_sh;
 
-    lv_opa_t * sh_buf;
+    /*`sh_buf` is the top right corner followed by its horizontally mirrored version.
+     *The sides are drawn by repeating the last row or column of the corner.*/
+    lv_opa_t * sh_buf = NULL;
+    lv_opa_t * sh_buf_alloc = NULL;
 
 #if LV_DRAW_SW_SHADOW_CACHE_SIZE
-    lv_draw_sw_shadow_cache_t * cache = &shadow_cache;
-    if(cache->cache_size == corner_size && cache->cache_r == r_sh) {
-        /*Use the cache if available*/
-        sh_buf = lv_malloc(corner_size * corner_size);
-        lv_memcpy(sh_buf, cache->cache, corner_size * corner_size);
-    }
-    else {
+    _lv_draw_sw_shadow_cache_entry_t * cache_entry = shadow_cache_get(&core_area, dsc->width, r_sh);
+    if(cache_entry) sh_buf = cache_entry->buf;
+#endif /*LV_DRAW_SW_SHADOW_CACHE_SIZE*/
+
+    if(sh_buf == NULL) {
         /*A larger buffer is required for calculation*/
-        sh_buf = lv_malloc(corner_size * corner_size * sizeof(uint16_t));
-        shadow_draw_corner_buf(&core_area, (uint16_t *)sh_buf, dsc->width, r_sh);
-
-        /*Cache the corner if it fits into the cache size*/
-        if((uint32_t)corner_size * corner_size < sizeof(cache->cache)) {
-            lv_memcpy(cache->cache, sh_buf, corner_size * corner_size);
-            cache->cache_size = corner_size;
-            cache->cache_r = r_sh;
-        }
+        sh_buf_alloc = lv_malloc(corner_size * corner_size * sizeof(uint16_t));
+        shadow_draw_corner_buf(&core_area, (uint16_t *)sh_buf_alloc, dsc->width, r_sh);
+        shadow_mirror_corner(sh_buf_alloc, corner_size);
+        sh_buf = sh_buf_alloc;
     }
-#else
-    sh_buf = lv_malloc(corner_size * corner_size * sizeof(uint16_t));
-    shadow_draw_corner_buf(&core_area, (uint16_t *)sh_buf, dsc->width, r_sh);
-#endif /*LV_DRAW_SW_SHADOW_CACHE_SIZE*/
 
     /*Skip a lot of masking if the background will cover the shadow that would be masked out*/
     bool simple = dsc->bg_cover;
@@ -376,22 +401,8 @@ void lv_draw_sw_box_shadow(lv_draw_unit_t * draw_unit, const lv_draw_box_shadow_
         }
     }
 
-    /*Mirror the shadow corner buffer horizontally*/
-    sh_buf_tmp = sh_buf ;
-    for(y = 0; y < corner_size; y++) {
-        int32_t x;
-        lv_opa_t * start = sh_buf_tmp;
-        lv_opa_t * end = sh_buf_tmp + corner_size - 1;
-        for(x = 0; x < corner_size / 2; x++) {
-            lv_opa_t tmp = *start;
-            *start = *end;
-            *end = tmp;
-
-            start++;
-            end--;
-        }
-        sh_buf_tmp += corner_size;
-    }
+    /*Use the horizontally mirrored corner on the left side*/
+    sh_buf += corner_size * corner_size;
 
     /*Left side*/
     blend_area.x1 = shadow_area.x1;
@@ -549,8 +560,12 @@ void lv_draw_sw_box_shadow(lv_draw_unit_t * draw_unit, const lv_draw_box_shadow_
     if(!simple) {
         lv_draw_sw_mask_free_param(&mask_rout_param);
     }
-    lv_free(sh_buf);
+    lv_free(sh_buf_alloc);
     lv_free(mask_buf);
+
+#if LV_DRAW_SW_SHADOW_CACHE_SIZE
+    if(cache_entry) shadow_cache_release(cache_entry);
+#endif
 }
 #endif /*LV_USE_DRAW_SW*/
 
@@ -636,11 +651,9 @@ LV_ATTRIBUTE_FAST_MEM static void shadow_draw_corner_buf(const lv_area_t * coord
     sw += sw_ori & 1;
     if(sw > 1) {
         uint32_t i;
-        uint32_t max_v_div = (LV_OPA_COVER << SHADOW_UPSCALE_SHIFT) / sw;
+        uint32_t sw_recip = SHADOW_RECIPROCAL(sw);
         for(i = 0; i < (uint32_t)size * size; i++) {
-            if(sh_buf[i] == 0) continue;
-            else if(sh_buf[i] == LV_OPA_COVER) sh_buf[i] = max_v_div;
-            else  sh_buf[i] = (sh_buf[i] << SHADOW_UPSCALE_SHIFT) / sw;
+            sh_buf[i] = SHADOW_DIV((uint32_t)sh_buf[i] << SHADOW_UPSCALE_SHIFT, sw_recip);
         }
 
         shadow_blur_corner(size, sw, sh_buf);
@@ -687,43 +700,169 @@ LV_ATTRIBUTE_FAST_MEM static void shadow_blur_corner(int32_t size, int32_t sw, u
         lv_memcpy(sh_ups_tmp_buf, sh_ups_blur_buf, size * sizeof(uint16_t));
         sh_ups_tmp_buf += size;
     }
+    lv_free(sh_ups_blur_buf);
 
-    /*Vertical blur*/
+    /*Normalize. The values are smaller than 2^16 so the reciprocal gives the exact quotient*/
+    uint32_t sw_recip = SHADOW_RECIPROCAL(sw);
+#ifdef LV_DRAW_SW_SHADOW_NORMALIZE
+    LV_DRAW_SW_SHADOW_NORMALIZE(sh_ups_buf, sw_recip, size * size);
+#else
     uint32_t i;
-    uint32_t max_v = LV_OPA_COVER << SHADOW_UPSCALE_SHIFT;
-    uint32_t max_v_div = max_v / sw;
     for(i = 0; i < (uint32_t)size * size; i++) {
-        if(sh_ups_buf[i] == 0) continue;
-        else if(sh_ups_buf[i] == max_v) sh_ups_buf[i] = max_v_div;
-        else sh_ups_buf[i] = sh_ups_buf[i] / sw;
+        sh_ups_buf[i] = SHADOW_DIV(sh_ups_buf[i], sw_recip);
     }
+#endif
+
+    /*Vertical blur. The rows are processed together to read the memory sequentially.
+     *A result row can be written back only when it's not read anymore, i.e. `s_right + 1` rows later,
+     *so keep the latest result rows in a ring buffer.*/
+    int32_t ring_cnt = s_right + 1;
+    int32_t * sum_buf = lv_malloc(size * sizeof(int32_t));
+    uint16_t * ring_buf = lv_malloc(ring_cnt * size * sizeof(uint16_t));
+    LV_ASSERT_MALLOC(sum_buf);
+    LV_ASSERT_MALLOC(ring_buf);
 
     for(x = 0; x < size; x++) {
-        sh_ups_tmp_buf = &sh_ups_buf[x];
-        int32_t v = sh_ups_tmp_buf[0] * sw;
-        for(y = 0; y < size ; y++, sh_ups_tmp_buf += size) {
-            sh_ups_blur_buf[y] = v < 0 ? 0 : (v >> SHADOW_UPSCALE_SHIFT);
-
-            /*Forget the top pixel*/
-            uint32_t top_val;
-            if(y - s_right <= 0) top_val = sh_ups_tmp_buf[0];
-            else top_val = sh_ups_buf[(y - s_right) * size + x];
-            v -= top_val;
-
-            /*Add the bottom pixel*/
-            uint32_t bottom_val;
-            if(y + s_left + 1 < size) bottom_val = sh_ups_buf[(y + s_left + 1) * size + x];
-            else bottom_val = sh_ups_buf[(size - 1) * size + x];
-            v += bottom_val;
+        sum_buf[x] = sh_ups_buf[x] * sw;
+    }
+
+    for(y = 0; y < size; y++) {
+        uint16_t * res_row = &ring_buf[(y % ring_cnt) * size];
+        if(y >= ring_cnt) {
+            lv_memcpy(&sh_ups_buf[(y - ring_cnt) * size], res_row, size * sizeof(uint16_t));
         }
 
-        /*Write back the result into `sh_ups_buf`*/
-        sh_ups_tmp_buf = &sh_ups_buf[x];
-        for(y = 0; y < size; y++, sh_ups_tmp_buf += size) {
-            (*sh_ups_tmp_buf) = sh_ups_blur_buf[y];
+        /*Forget the top pixels and add the bottom pixels*/
+        const uint16_t * top_row = &sh_ups_buf[(y - s_right <= 0 ? y : y - s_right) * size];
+        const uint16_t * bottom_row = &sh_ups_buf[LV_MIN(y + s_left + 1, size - 1) * size];
+
+#ifdef LV_DRAW_SW_SHADOW_BLUR_ROW
+        LV_DRAW_SW_SHADOW_BLUR_ROW(sum_buf, top_row, bottom_row, res_row, size);
+#else
+        for(x = 0; x < size; x++) {
+            int32_t v = sum_buf[x];
+            res_row[x] = v < 0 ? 0 : (v >> SHADOW_UPSCALE_SHIFT);
+            sum_buf[x] = v - top_row[x] + bottom_row[x];
         }
+#endif
     }
 
-    lv_free(sh_ups_blur_buf);
+    /*Write back the remaining rows*/
+    for(y = LV_MAX(size - ring_cnt, 0); y < size; y++) {
+        lv_memcpy(&sh_ups_buf[y * size], &ring_buf[(y % ring_cnt) * size], size * sizeof(uint16_t));
+    }
+
+    lv_free(sum_buf);
+    lv_free(ring_buf);
 }
+
+/**
+ * Store the horizontally mirrored version of the corner after the corner
+ * @param sh_buf    the corner in the first `size * size` bytes, at least `2 * size * size` bytes large
+ * @param size      shadow width + radius
+ */
+static void shadow_mirror_corner(lv_opa_t * sh_buf, int32_t size)
+{
+    const lv_opa_t * src = sh_buf;
+    lv_opa_t * dest = sh_buf + size * size;
+    int32_t y;
+    for(y = 0; y < size; y++) {
+        int32_t x;
+        for(x = 0; x < size; x++) {
+            dest[x] = src[size - 1 - x];
+        }
+        src += size;
+        dest += size;
+    }
+}
+
+#if LV_DRAW_SW_SHADOW_CACHE_SIZE
+
+/**
+ * Get a cache entry with the blurred and mirrored corner of a shadow.
+ * Calculate the corner if it's not cached yet.
+ * @param core_area the rectangle to blur
+ * @param sw        shadow width
+ * @param r         the clamped radius of the shadow
+ * @return          the cache entry or NULL if the corner can't be cached.
+ *                  Release it with `shadow_cache_release()`.
+ */
+static _lv_draw_sw_shadow_cache_entry_t * shadow_cache_get(const lv_area_t * core_area, int32_t sw, int32_t r)
+{
+    int32_t size = sw + r;
+    if(size > LV_DRAW_SW_SHADOW_CACHE_SIZE) return NULL;
+
+    /*The sides longer than this don't reach into the corner, so they result in the same corner*/
+    int32_t w = LV_MIN(lv_area_get_width(core_area), sw + 2 * r);
+    int32_t h = LV_MIN(lv_area_get_height(core_area), sw + 2 * r);
+
+    lv_mutex_lock(&shadow_cache.mutex);
+
+    uint32_t i;
+    _lv_draw_sw_shadow_cache_entry_t * entries = shadow_cache.entries;
+    for(i = 0; i < LV_DRAW_SW_SHADOW_CACHE_CNT; i++) {
+        if(entries[i].ready && entries[i].sw == sw && entries[i].r == r && entries[i].w == w && entries[i].h == h) {
+            entries[i].used_cnt++;
+            SHADOW_CACHE_AGING(entries[i].life, size);
+            lv_mutex_unlock(&shadow_cache.mutex);
+            return &entries[i];
+        }
+    }
+
+    /*If not cached use the free entry with lowest life*/
+    _lv_draw_sw_shadow_cache_entry_t * entry = NULL;
+    for(i = 0; i < LV_DRAW_SW_SHADOW_CACHE_CNT; i++) {
+        if(entries[i].used_cnt == 0) {
+            if(!entry) entry = &entries[i];
+            else if(entries[i].life < entry->life) entry = &entries[i];
+        }
+    }
+
+    /*All entries are being drawn. The caller will calculate the corner for itself.*/
+    if(!entry) {
+        lv_mutex_unlock(&shadow_cache.mutex);
+        return NULL;
+    }
+
+    /*Reserve the entry and calculate the corner without blocking the other units*/
+    entry->sw = sw;
+    entry->r = r;
+    entry->w = w;
+    entry->h = h;
+    entry->used_cnt = 1;
+    entry->ready = false;
+    entry->life = 0;
+    SHADOW_CACHE_AGING(entry->life, size);
+    lv_mutex_unlock(&shadow_cache.mutex);
+
+    /*The calculation needs `size * size` 16 bit values, the result is `2 * size * size` bytes*/
+    lv_opa_t * buf = lv_realloc(entry->buf, size * size * sizeof(uint16_t));
+    if(buf) {
+        shadow_draw_corner_buf(core_area, (uint16_t *)buf, sw, r);
+        shadow_mirror_corner(buf, size);
+    }
+
+    lv_mutex_lock(&shadow_cache.mutex);
+    if(buf) {
+        entry->buf = buf;
+        entry->ready = true;
+    }
+    else {
+        entry->used_cnt = 0;
+        entry = NULL;
+    }
+    lv_mutex_unlock(&shadow_cache.mutex);
+
+    return entry;
+}
+
+static void shadow_cache_release(_lv_draw_sw_shadow_cache_entry_t * entry)
+{
+    lv_mutex_lock(&shadow_cache.mutex);
+    entry->used_cnt--;
+    lv_mutex_unlock(&shadow_cache.mutex);
+}
+
+#endif /*LV_DRAW_SW_SHADOW_CACHE_SIZE*/
+
 #endif /*LV_DRAW_SW_COMPLEX*/
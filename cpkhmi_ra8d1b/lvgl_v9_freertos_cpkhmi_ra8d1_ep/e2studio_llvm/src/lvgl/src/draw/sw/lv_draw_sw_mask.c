@@ -22,6 +22,7 @@
  *********************/
 #define CIRCLE_CACHE_LIFE_MAX           1000
 #define CIRCLE_CACHE_AGING(life, r)     life = LV_MIN(life + (r < 16 ? 1 : (r >> 4)), 1000)
+#define CIRCLE_CACHE_HASH(r)            (((uint32_t)(r) * 2654435761U >> 16) % LV_DRAW_SW_CIRCLE_CACHE_SIZE)
 #define circle_cache_mutex              LV_GLOBAL_DEFAULT()->draw_info.circle_cache_mutex
 #define _circle_cache                   LV_GLOBAL_DEFAULT()->sw_circle_cache
 
@@ -63,6 +64,9 @@ static void circ_next(lv_point_t * c, int32_t * tmp);
 static void circ_calc_aa4(_lv_draw_sw_mask_radius_circle_dsc_t * c, int32_t radius);
 static lv_opa_t * get_next_line(_lv_draw_sw_mask_radius_circle_dsc_t * c, int32_t y, int32_t * len,
                                 int32_t * x_start);
+static _lv_draw_sw_mask_radius_circle_dsc_t * circle_cache_find(int32_t radius);
+static void circle_cache_insert(const _lv_draw_sw_mask_radius_circle_dsc_t * entry);
+static void circle_cache_free_all(void);
 LV_ATTRIBUTE_FAST_MEM static inline lv_opa_t mask_mix(lv_opa_t mask_act, lv_opa_t mask_new);
 
 /**********************
@@ -84,6 +88,7 @@ void lv_draw_sw_mask_init(void)
 
 void lv_draw_sw_mask_deinit(void)
 {
+    circle_cache_free_all();
     lv_mutex_delete(&circle_cache_mutex);
 }
 
@@ -108,33 +113,28 @@ LV_ATTRIBUTE_FAST_MEM lv_draw_sw_mask_res_t lv_draw_sw_mask_apply(void * masks[]
 
 void lv_draw_sw_mask_free_param(void * p)
 {
-    lv_mutex_lock(&circle_cache_mutex);
+    /*The cached circles are kept until the end of the refresh, only the not cached ones need to be freed*/
     _lv_draw_sw_mask_common_dsc_t * pdsc = p;
     if(pdsc->type == LV_DRAW_SW_MASK_TYPE_RADIUS) {
         lv_draw_sw_mask_radius_param_t * radius_p = (lv_draw_sw_mask_radius_param_t *) p;
-        if(radius_p->circle) {
-            if(radius_p->circle->life < 0) {
-                lv_free(radius_p->circle->cir_opa);
-                lv_free(radius_p->circle);
-            }
-            else {
-                radius_p->circle->used_cnt--;
-            }
+        if(radius_p->circle && radius_p->circle->life < 0) {
+            lv_free(radius_p->circle->buf);
+            lv_free(radius_p->circle);
         }
     }
-
-    lv_mutex_unlock(&circle_cache_mutex);
 }
 
 void _lv_draw_sw_mask_cleanup(void)
 {
-    uint8_t i;
-    for(i = 0; i < LV_DRAW_SW_CIRCLE_CACHE_SIZE; i++) {
-        if(_circle_cache[i].buf) {
-            lv_free(_circle_cache[i].buf);
-        }
-        lv_memzero(&(_circle_cache[i]), sizeof(_circle_cache[i]));
+    /*Nothing is drawn now, so the hash table can be changed.
+     *Add the new circles in place of the least used ones.*/
+    uint32_t i;
+    for(i = 0; i < _circle_cache.new_cnt; i++) {
+        circle_cache_insert(&_circle_cache.new_entries[i]);
     }
+
+    lv_memzero(_circle_cache.new_entries, sizeof(_circle_cache.new_entries));
+    _circle_cache.new_cnt = 0;
 }
 
 void lv_draw_sw_mask_line_points_init(lv_draw_sw_mask_line_param_t * param, int32_t p1x, int32_t p1y,
@@ -310,47 +310,49 @@ void lv_draw_sw_mask_radius_init(lv_draw_sw_mask_radius_param_t * param, const l
         return;
     }
 
+    /*The hash table is not changed during the refresh, so it's safe to read without locking.
+     *The aging is not protected, a lost update only makes it a little less precise.*/
+    _lv_draw_sw_mask_radius_circle_dsc_t * entry = circle_cache_find(radius);
+    if(entry) {
+        CIRCLE_CACHE_AGING(entry->life, radius);
+        param->circle = entry;
+        return;
+    }
+
     lv_mutex_lock(&circle_cache_mutex);
 
+    /*Maybe an other mask has already calculated it in this refresh*/
     uint32_t i;
-
-    /*Try to reuse a circle cache entry*/
-    for(i = 0; i < LV_DRAW_SW_CIRCLE_CACHE_SIZE; i++) {
-        if(_circle_cache[i].radius == radius) {
-            _circle_cache[i].used_cnt++;
-            CIRCLE_CACHE_AGING(_circle_cache[i].life, radius);
-            param->circle = &(_circle_cache[i]);
+    for(i = 0; i < _circle_cache.new_cnt; i++) {
+        if(_circle_cache.new_entries[i].radius == radius) {
+            entry = &_circle_cache.new_entries[i];
+            CIRCLE_CACHE_AGING(entry->life, radius);
+            param->circle = entry;
             lv_mutex_unlock(&circle_cache_mutex);
             return;
         }
     }
 
-    /*If not cached use the free entry with lowest life*/
-    _lv_draw_sw_mask_radius_circle_dsc_t * entry = NULL;
-    for(i = 0; i < LV_DRAW_SW_CIRCLE_CACHE_SIZE; i++) {
-        if(_circle_cache[i].used_cnt == 0) {
-            if(!entry) entry = &(_circle_cache[i]);
-            else if(_circle_cache[i].life < entry->life) entry = &(_circle_cache[i]);
-        }
-    }
-
-    /*There is no unused entry. Allocate one temporarily*/
-    if(!entry) {
-        entry = lv_malloc_zeroed(sizeof(_lv_draw_sw_mask_radius_circle_dsc_t));
-        LV_ASSERT_MALLOC(entry);
-        entry->life = -1;
-    }
-    else {
-        entry->used_cnt++;
+    /*Calculate it and add it to the cache at the end of the refresh*/
+    if(_circle_cache.new_cnt < LV_DRAW_SW_CIRCLE_CACHE_SIZE) {
+        entry = &_circle_cache.new_entries[_circle_cache.new_cnt];
+        circ_calc_aa4(entry, radius);
         entry->life = 0;
         CIRCLE_CACHE_AGING(entry->life, radius);
+        _circle_cache.new_cnt++;
+        param->circle = entry;
+        lv_mutex_unlock(&circle_cache_mutex);
+        return;
     }
 
-    param->circle = entry;
-
-    circ_calc_aa4(param->circle, radius);
     lv_mutex_unlock(&circle_cache_mutex);
 
+    /*Too many new circles in this refresh. Allocate one temporarily*/
+    entry = lv_malloc_zeroed(sizeof(_lv_draw_sw_mask_radius_circle_dsc_t));
+    LV_ASSERT_MALLOC(entry);
+    circ_calc_aa4(entry, radius);
+    entry->life = -1;
+    param->circle = entry;
 }
 
 void lv_draw_sw_mask_fade_init(lv_draw_sw_mask_fade_param_t * param, const lv_area_t * coords, lv_opa_t opa_top,
@@ -909,18 +911,36 @@ LV_ATTRIBUTE_FAST_MEM static lv_draw_sw_mask_res_t lv_draw_mask_radius(lv_opa_t
     int32_t i;
 
     if(outer == false) {
-        for(i = 0; i < aa_len; i++) {
-            lv_opa_t opa = aa_opa[aa_len - i - 1];
-            if(cir_x_right + i >= 0 && cir_x_right + i < len) {
-                mask_buf[cir_x_right + i] = mask_mix(opa, mask_buf[cir_x_right + i]);
+        if(cir_x_left < cir_x_right) {
+            /*The two sides don't overlap, so they can be mixed separately on the clipped ranges.
+             *The left side uses the opacities in reversed order.*/
+            int32_t i_start = LV_MAX(0, -cir_x_right);
+            int32_t i_end = LV_MIN(aa_len, len - cir_x_right);
+            for(i = i_start; i < i_end; i++) {
+                mask_buf[cir_x_right + i] = mask_mix(aa_opa[aa_len - i - 1], mask_buf[cir_x_right + i]);
+            }
+
+            int32_t left_start = cir_x_left - aa_len + 1;
+            i_start = LV_MAX(0, -left_start);
+            i_end = LV_MIN(aa_len, len - left_start);
+            for(i = i_start; i < i_end; i++) {
+                mask_buf[left_start + i] = mask_mix(aa_opa[i], mask_buf[left_start + i]);
             }
-            if(cir_x_left - i >= 0 && cir_x_left - i < len) {
-                mask_buf[cir_x_left - i] = mask_mix(opa, mask_buf[cir_x_left - i]);
+        }
+        else {
+            for(i = 0; i < aa_len; i++) {
+                lv_opa_t opa = aa_opa[aa_len - i - 1];
+                if(cir_x_right + i >= 0 && cir_x_right + i < len) {
+                    mask_buf[cir_x_right + i] = mask_mix(opa, mask_buf[cir_x_right + i]);
+                }
+                if(cir_x_left - i >= 0 && cir_x_left - i < len) {
+                    mask_buf[cir_x_left - i] = mask_mix(opa, mask_buf[cir_x_left - i]);
+                }
             }
         }
 
         /*Clean the right side*/
-        cir_x_right = LV_CLAMP(0, cir_x_right + i, len);
+        cir_x_right = LV_CLAMP(0, cir_x_right + aa_len, len);
         lv_memzero(&mask_buf[cir_x_right], len - cir_x_right);
 
         /*Clean the left side*/
@@ -928,13 +948,29 @@ LV_ATTRIBUTE_FAST_MEM static lv_draw_sw_mask_res_t lv_draw_mask_radius(lv_opa_t
         lv_memzero(&mask_buf[0], cir_x_left);
     }
     else {
-        for(i = 0; i < aa_len; i++) {
-            lv_opa_t opa = 255 - (aa_opa[aa_len - 1 - i]);
-            if(cir_x_right + i >= 0 && cir_x_right + i < len) {
-                mask_buf[cir_x_right + i] = mask_mix(opa, mask_buf[cir_x_right + i]);
+        if(cir_x_left < cir_x_right) {
+            int32_t i_start = LV_MAX(0, -cir_x_right);
+            int32_t i_end = LV_MIN(aa_len, len - cir_x_right);
+            for(i = i_start; i < i_end; i++) {
+                mask_buf[cir_x_right + i] = mask_mix(255 - aa_opa[aa_len - 1 - i], mask_buf[cir_x_right + i]);
             }
-            if(cir_x_left - i >= 0 && cir_x_left - i < len) {
-                mask_buf[cir_x_left - i] = mask_mix(opa, mask_buf[cir_x_left - i]);
+
+            int32_t left_start = cir_x_left - aa_len + 1;
+            i_start = LV_MAX(0, -left_start);
+            i_end = LV_MIN(aa_len, len - left_start);
+            for(i = i_start; i < i_end; i++) {
+                mask_buf[left_start + i] = mask_mix(255 - aa_opa[i], mask_buf[left_start + i]);
+            }
+        }
+        else {
+            for(i = 0; i < aa_len; i++) {
+                lv_opa_t opa = 255 - (aa_opa[aa_len - 1 - i]);
+                if(cir_x_right + i >= 0 && cir_x_right + i < len) {
+                    mask_buf[cir_x_right + i] = mask_mix(opa, mask_buf[cir_x_right + i]);
+                }
+                if(cir_x_left - i >= 0 && cir_x_left - i < len) {
+                    mask_buf[cir_x_left - i] = mask_mix(opa, mask_buf[cir_x_left - i]);
+                }
             }
         }
 
@@ -1224,6 +1260,75 @@ static lv_opa_t * get_next_line(_lv_draw_sw_mask_radius_circle_dsc_t * c, int32_
     return &c->cir_opa[c->opa_start_on_y[y]];
 }
 
+/**
+ * Look up a circle in the hash table
+ * @param radius    the radius of the circle
+ * @return          the cached circle or NULL if not found
+ */
+static _lv_draw_sw_mask_radius_circle_dsc_t * circle_cache_find(int32_t radius)
+{
+    _lv_draw_sw_mask_radius_circle_dsc_t * entries = _circle_cache.entries;
+    uint32_t idx = CIRCLE_CACHE_HASH(radius);
+    uint32_t i;
+    for(i = 0; i < LV_DRAW_SW_CIRCLE_CACHE_SIZE; i++) {
+        if(entries[idx].radius == radius) return &entries[idx];
+        if(entries[idx].radius == 0) return NULL;   /*Not in the probe sequence*/
+
+        idx++;
+        if(idx == LV_DRAW_SW_CIRCLE_CACHE_SIZE) idx = 0;
+    }
+
+    return NULL;
+}
+
+/**
+ * Add a circle to the hash table. If the table is full the least used circle is replaced.
+ * Can be called only when no masks are used.
+ * @param entry     the circle to add. Its buffer is taken over by the cache.
+ */
+static void circle_cache_insert(const _lv_draw_sw_mask_radius_circle_dsc_t * entry)
+{
+    _lv_draw_sw_mask_radius_circle_dsc_t * entries = _circle_cache.entries;
+    uint32_t idx = CIRCLE_CACHE_HASH(entry->radius);
+    uint32_t i;
+
+    /*Use the first free slot of the probe sequence*/
+    for(i = 0; i < LV_DRAW_SW_CIRCLE_CACHE_SIZE; i++) {
+        if(entries[idx].radius == 0) {
+            entries[idx] = *entry;
+            return;
+        }
+
+        idx++;
+        if(idx == LV_DRAW_SW_CIRCLE_CACHE_SIZE) idx = 0;
+    }
+
+    /*The table is full. Replacing an entry in place keeps the probe sequences of the others unbroken.
+     *Halve the life of the others so that the circles which are not used anymore are replaced later.*/
+    _lv_draw_sw_mask_radius_circle_dsc_t * replace = &entries[0];
+    for(i = 1; i < LV_DRAW_SW_CIRCLE_CACHE_SIZE; i++) {
+        if(entries[i].life < replace->life) replace = &entries[i];
+    }
+
+    for(i = 0; i < LV_DRAW_SW_CIRCLE_CACHE_SIZE; i++) {
+        entries[i].life >>= 1;
+    }
+
+    lv_free(replace->buf);
+    *replace = *entry;
+}
+
+static void circle_cache_free_all(void)
+{
+    uint32_t i;
+    for(i = 0; i < LV_DRAW_SW_CIRCLE_CACHE_SIZE; i++) {
+        lv_free(_circle_cache.entries[i].buf);
+        lv_free(_circle_cache.new_entries[i].buf);
+    }
+
+    lv_memzero(&_circle_cache, sizeof(_circle_cache));
+}
+
 LV_ATTRIBUTE_FAST_MEM static inline lv_opa_t mask_mix(lv_opa_t mask_act, lv_opa_t mask_new)
 {
     if(mask_new >= LV_OPA_MAX) return mask_act;
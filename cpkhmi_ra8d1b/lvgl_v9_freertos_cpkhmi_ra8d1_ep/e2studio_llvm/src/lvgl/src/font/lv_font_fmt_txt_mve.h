@@ -0,0 +1,96 @@
+/**
+ * @file lv_font_fmt_txt_mve.h
+ *
+ */
+
+#ifndef LV_FONT_FMT_TXT_MVE_H
+#define LV_FONT_FMT_TXT_MVE_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*********************
+ *      INCLUDES
+ *********************/
+#include <stdint.h>
+
+/*********************
+ *      DEFINES
+ *********************/
+
+#define LV_FONT_FMT_TXT_OPA_LINE(out, line, opa_table, w) \
+    _lv_font_fmt_txt_opa_line_mve(out, line, opa_table, w)
+
+#define LV_FONT_FMT_TXT_PREFILTER_LINE(out, prev, line, opa_table, w) \
+    _lv_font_fmt_txt_prefilter_line_mve(out, prev, line, opa_table, w)
+
+/**********************
+ *      MACROS
+ **********************/
+
+/**********************
+ *      TYPEDEFS
+ **********************/
+
+/**********************
+ * GLOBAL PROTOTYPES
+ **********************/
+
+/*out[x] = opa_table[line[x]], 16 pixels at once with a gather load*/
+static inline void _lv_font_fmt_txt_opa_line_mve(uint8_t * out, const uint8_t * line, const uint8_t * opa_table,
+                                                 int32_t w)
+{
+    if(w <= 0) {
+        return;
+    }
+
+    __asm volatile(
+        ".p2align 2                                             \n"
+        "wlstp.8            lr, %[w], 1f                        \n"
+        "2:                                                     \n"
+        "vldrb.u8           q0, [%[line]], #16                  \n"
+        "vldrb.u8           q1, [%[table], q0]                  \n"
+        "vstrb.8            q1, [%[out]], #16                   \n"
+        "letp               lr, 2b                              \n"
+        "1:                                                     \n"
+        : [out] "+r"(out),
+        [line] "+r"(line)
+        : [table] "r"(opa_table),
+        [w] "r"(w)
+        : "q0", "q1", "memory", "r14", "cc");
+}
+
+/*prev[x] ^= line[x]; out[x] = opa_table[prev[x]]*/
+static inline void _lv_font_fmt_txt_prefilter_line_mve(uint8_t * out, uint8_t * prev, const uint8_t * line,
+                                                       const uint8_t * opa_table, int32_t w)
+{
+    if(w <= 0) {
+        return;
+    }
+
+    __asm volatile(
+        ".p2align 2                                             \n"
+        "wlstp.8            lr, %[w], 1f                        \n"
+        "2:                                                     \n"
+        "vldrb.u8           q0, [%[prev]]                       \n"
+        "vldrb.u8           q1, [%[line]], #16                  \n"
+        "veor               q0, q0, q1                          \n"
+        "vstrb.8            q0, [%[prev]], #16                  \n"
+        "vldrb.u8           q2, [%[table], q0]                  \n"
+        "vstrb.8            q2, [%[out]], #16                   \n"
+        "letp               lr, 2b                              \n"
+        "1:                                                     \n"
+        : [out] "+r"(out),
+        [prev] "+r"(prev),
+        [line] "+r"(line)
+        : [table] "r"(opa_table),
+        [w] "r"(w)
+        : "q0", "q1", "q2", "memory", "r14", "cc");
+}
+
+#ifdef __cplusplus
+} /*extern "C"*/
+#endif
+
+#endif /*LV_FONT_FMT_TXT_MVE_H*/
@@ -29,7 +29,7 @@ typedef struct Table {
 #define LZW_CACHE_SIZE              (LZW_TABLE_SIZE * 4)
 #endif
 
-static gd_GIF  * gif_open(gd_GIF * gif);
+static gd_GIF  * gif_open(gd_GIF * gif, lv_color_format_t cf);
 static bool f_gif_open(gd_GIF * gif, const void * path, bool is_file);
 static void f_gif_read(gd_GIF * gif, void * buf, size_t len);
 static int f_gif_seek(gd_GIF * gif, size_t pos, int k);
@@ -49,7 +49,7 @@ read_num(gd_GIF * gif)
 }
 
 gd_GIF *
-gd_open_gif_file(const char * fname)
+gd_open_gif_file(const char * fname, lv_color_format_t cf)
 {
     gd_GIF gif_base;
     memset(&gif_base, 0, sizeof(gif_base));
@@ -57,11 +57,11 @@ gd_open_gif_file(const char * fname)
     bool res = f_gif_open(&gif_base, fname, true);
     if(!res) return NULL;
 
-    return gif_open(&gif_base);
+    return gif_open(&gif_base, cf);
 }
 
 gd_GIF *
-gd_open_gif_data(const void * data)
+gd_open_gif_data(const void * data, lv_color_format_t cf)
 {
     gd_GIF gif_base;
     memset(&gif_base, 0, sizeof(gif_base));
@@ -69,16 +69,53 @@ gd_open_gif_data(const void * data)
     bool res = f_gif_open(&gif_base, data, false);
     if(!res) return NULL;
 
-    return gif_open(&gif_base);
+    return gif_open(&gif_base, cf);
 }
 
-static gd_GIF * gif_open(gd_GIF * gif_base)
+static void
+fill_bg(gd_GIF * gif, int i, uint16_t w, uint16_t h, uint8_t opa)
+{
+    uint8_t * bgcolor = &gif->palette->colors[gif->bgindex * 3];
+    int j, k;
+
+    if(gif->cf == LV_COLOR_FORMAT_RGB565) {
+        /* There is no alpha channel, transparent areas get the background color too */
+        uint16_t c = lv_color_to_u16(lv_color_make(bgcolor[0], bgcolor[1], bgcolor[2]));
+        uint16_t * dst = (uint16_t *) gif->canvas + i;
+#ifdef GIFDEC_FILL_BG_RGB565
+        GIFDEC_FILL_BG_RGB565(dst, w, h, gif->width, c);
+#else
+        for(j = 0; j < h; j++) {
+            for(k = 0; k < w; k++) dst[k] = c;
+            dst += gif->width;
+        }
+#endif
+        return;
+    }
+
+#ifdef GIFDEC_FILL_BG
+    LV_UNUSED(j);
+    LV_UNUSED(k);
+    GIFDEC_FILL_BG(&gif->canvas[i * 4], w, h, gif->width, bgcolor, opa);
+#else
+    for(j = 0; j < h; j++) {
+        for(k = 0; k < w; k++) {
+            gif->canvas[(i + k) * 4 + 0] = *(bgcolor + 2);
+            gif->canvas[(i + k) * 4 + 1] = *(bgcolor + 1);
+            gif->canvas[(i + k) * 4 + 2] = *(bgcolor + 0);
+            gif->canvas[(i + k) * 4 + 3] = opa;
+        }
+        i += gif->width;
+    }
+#endif
+}
+
+static gd_GIF * gif_open(gd_GIF * gif_base, lv_color_format_t cf)
 {
     uint8_t sigver[3];
     uint16_t width, height, depth;
     uint8_t fdsz, bgidx, aspect;
-    uint8_t * bgcolor;
-    int gct_sz;
+    int gct_sz, px_size;
     gd_GIF * gif = NULL;
 
     /* Header */
@@ -113,41 +150,36 @@ static gd_GIF * gif_open(gd_GIF * gif_base)
     /* Aspect Ratio */
     f_gif_read(gif_base, &aspect, 1);
     /* Create gd_GIF Structure. */
+    if(cf != LV_COLOR_FORMAT_RGB565) cf = LV_COLOR_FORMAT_ARGB8888;
+    px_size = lv_color_format_get_size(cf);
 #if LV_GIF_CACHE_DECODE_DATA
-    gif = lv_malloc(sizeof(gd_GIF) + 5 * width * height + LZW_CACHE_SIZE);
+    gif = lv_malloc(sizeof(gd_GIF) + (px_size + 1) * width * height + LZW_CACHE_SIZE);
     #else
-    gif = lv_malloc(sizeof(gd_GIF) + 5 * width * height);
+    gif = lv_malloc(sizeof(gd_GIF) + (px_size + 1) * width * height);
     #endif
     if(!gif) goto fail;
     memcpy(gif, gif_base, sizeof(gd_GIF));
     gif->width  = width;
     gif->height = height;
     gif->depth  = depth;
+    gif->cf = cf;
     /* Read GCT */
     gif->gct.size = gct_sz;
     f_gif_read(gif, gif->gct.colors, 3 * gif->gct.size);
     gif->palette = &gif->gct;
     gif->bgindex = bgidx;
     gif->canvas = (uint8_t *) &gif[1];
-    gif->frame = &gif->canvas[4 * width * height];
+    gif->frame = &gif->canvas[px_size * width * height];
     if(gif->bgindex) {
         memset(gif->frame, gif->bgindex, gif->width * gif->height);
     }
-    bgcolor = &gif->palette->colors[gif->bgindex * 3];
     #if LV_GIF_CACHE_DECODE_DATA
     gif->lzw_cache = gif->frame + width * height;
     #endif
 
-#ifdef GIFDEC_FILL_BG
-    GIFDEC_FILL_BG(gif->canvas, gif->width * gif->height, 1, gif->width * gif->height, bgcolor, 0xff);
-#else
-    for(int i = 0; i < gif->width * gif->height; i++) {
-        gif->canvas[i * 4 + 0] = *(bgcolor + 2);
-        gif->canvas[i * 4 + 1] = *(bgcolor + 1);
-        gif->canvas[i * 4 + 2] = *(bgcolor + 0);
-        gif->canvas[i * 4 + 3] = 0xff;
-    }
-#endif
+    fill_bg(gif, 0, gif->width, gif->height, 0xff);
+    gif->dw = gif->width;
+    gif->dh = gif->height;
     gif->anim_start = f_gif_seek(gif, 0, LV_FS_SEEK_CUR);
     gif->loop_count = -1;
     goto ok;
@@ -351,8 +383,8 @@ read_image_data(gd_GIF *gif, int interlace)
     end = f_gif_seek(gif, 0, LV_FS_SEEK_CUR);
     f_gif_seek(gif, start, LV_FS_SEEK_SET);
 
-    linesize = gif->width;
-    ptr_base = &gif->frame[gif->fy * linesize + gif->fx];
+    linesize = gif->fw;
+    ptr_base = gif->frame;
     ptr_row_start = ptr_base;
     ptr = ptr_row_start;
     sub_len = shift = 0;
@@ -584,7 +616,7 @@ read_image_data(gd_GIF * gif, int interlace)
             y = p / gif->fw;
             if(interlace)
                 y = interlaced_line_index((int) gif->fh, y);
-            gif->frame[(gif->fy + y) * gif->width + gif->fx + x] = entry.suffix;
+            gif->frame[y * gif->fw + x] = entry.suffix;
             if(entry.prefix == 0xFFF)
                 break;
             else
@@ -615,6 +647,11 @@ read_image(gd_GIF * gif)
     gif->fy = read_num(gif);
     gif->fw = read_num(gif);
     gif->fh = read_num(gif);
+    if(gif->fx + gif->fw > gif->width || gif->fy + gif->fh > gif->height) {
+        LV_LOG_WARN("frame is out of the canvas\n");
+        gif->fw = gif->fh = 0;
+        return -1;
+    }
     f_gif_read(gif, &fisrz, 1);
     interlace = fisrz & 0x40;
     /* Ignore Sort Flag. */
@@ -635,25 +672,56 @@ static void
 render_frame_rect(gd_GIF * gif, uint8_t * buffer)
 {
     int i = gif->fy * gif->width + gif->fx;
-#ifdef GIFDEC_RENDER_FRAME
-    GIFDEC_RENDER_FRAME(&buffer[i * 4], gif->fw, gif->fh, gif->width,
-                        &gif->frame[i], gif->palette->colors,
-                        gif->gce.transparency ? gif->gce.tindex : 0x100);
-#else
+    uint16_t tindex = gif->gce.transparency ? gif->gce.tindex : 0x100;
+    const uint8_t * frame = gif->frame;
     int j, k;
     uint8_t index, * color;
 
+    if(gif->cf == LV_COLOR_FORMAT_RGB565) {
+        uint16_t * dst = (uint16_t *) buffer + i;
+#ifdef GIFDEC_RENDER_FRAME_RGB565
+        LV_UNUSED(j);
+        LV_UNUSED(k);
+        LV_UNUSED(index);
+        LV_UNUSED(color);
+        GIFDEC_RENDER_FRAME_RGB565(dst, gif->fw, gif->fh, gif->width, gif->frame, gif->palette->colors, tindex);
+#else
+        for(j = 0; j < gif->fh; j++) {
+            for(k = 0; k < gif->fw; k++) {
+                index = frame[k];
+                if(index != tindex) {
+                    color = &gif->palette->colors[index * 3];
+                    dst[k] = lv_color_to_u16(lv_color_make(color[0], color[1], color[2]));
+                }
+            }
+            frame += gif->fw;
+            dst += gif->width;
+        }
+#endif
+        return;
+    }
+
+#ifdef GIFDEC_RENDER_FRAME
+    LV_UNUSED(j);
+    LV_UNUSED(k);
+    LV_UNUSED(index);
+    LV_UNUSED(color);
+    LV_UNUSED(frame);
+    GIFDEC_RENDER_FRAME(&buffer[i * 4], gif->fw, gif->fh, gif->width,
+                        gif->frame, gif->palette->colors, tindex);
+#else
     for(j = 0; j < gif->fh; j++) {
         for(k = 0; k < gif->fw; k++) {
-            index = gif->frame[(gif->fy + j) * gif->width + gif->fx + k];
+            index = frame[k];
             color = &gif->palette->colors[index * 3];
-            if(!gif->gce.transparency || index != gif->gce.tindex) {
+            if(index != tindex) {
                 buffer[(i + k) * 4 + 0] = *(color + 2);
                 buffer[(i + k) * 4 + 1] = *(color + 1);
                 buffer[(i + k) * 4 + 2] = *(color + 0);
                 buffer[(i + k) * 4 + 3] = 0xFF;
             }
         }
+        frame += gif->fw;
         i += gif->width;
     }
 #endif
@@ -662,37 +730,38 @@ render_frame_rect(gd_GIF * gif, uint8_t * buffer)
 static void
 dispose(gd_GIF * gif)
 {
-    int i;
-    uint8_t * bgcolor;
     switch(gif->gce.disposal) {
         case 2: /* Restore to background color. */
-            bgcolor = &gif->palette->colors[gif->bgindex * 3];
-
-            uint8_t opa = 0xff;
-            if(gif->gce.transparency) opa = 0x00;
-
-            i = gif->fy * gif->width + gif->fx;
-#ifdef GIFDEC_FILL_BG
-            GIFDEC_FILL_BG(&(gif->canvas[i * 4]), gif->fw, gif->fh, gif->width, bgcolor, opa);
-#else
-            int j, k;
-            for(j = 0; j < gif->fh; j++) {
-                for(k = 0; k < gif->fw; k++) {
-                    gif->canvas[(i + k) * 4 + 0] = *(bgcolor + 2);
-                    gif->canvas[(i + k) * 4 + 1] = *(bgcolor + 1);
-                    gif->canvas[(i + k) * 4 + 2] = *(bgcolor + 0);
-                    gif->canvas[(i + k) * 4 + 3] = opa;
-                }
-                i += gif->width;
-            }
-#endif
+            fill_bg(gif, gif->fy * gif->width + gif->fx, gif->fw, gif->fh, gif->gce.transparency ? 0x00 : 0xff);
             break;
         case 3: /* Restore to previous, i.e., don't update canvas.*/
             break;
         default:
-            /* Add frame non-transparent pixels to canvas. */
-            render_frame_rect(gif, gif->canvas);
+            /* Add frame non-transparent pixels to canvas unless it was rendered there already. */
+            if(!gif->frame_on_canvas) render_frame_rect(gif, gif->canvas);
+    }
+    gif->frame_on_canvas = 0;
+}
+
+static void
+join_dirty(gd_GIF * gif, uint16_t x, uint16_t y, uint16_t w, uint16_t h)
+{
+    uint16_t x2, y2;
+
+    if(w == 0 || h == 0) return;
+    if(gif->dw == 0 || gif->dh == 0) {
+        gif->dx = x;
+        gif->dy = y;
+        gif->dw = w;
+        gif->dh = h;
+        return;
     }
+    x2 = MAX(gif->dx + gif->dw, x + w);
+    y2 = MAX(gif->dy + gif->dh, y + h);
+    gif->dx = MIN(gif->dx, x);
+    gif->dy = MIN(gif->dy, y);
+    gif->dw = x2 - gif->dx;
+    gif->dh = y2 - gif->dy;
 }
 
 /* Return 1 if got a frame; 0 if got GIF trailer; -1 if error. */
@@ -701,12 +770,16 @@ gd_get_frame(gd_GIF * gif)
 {
     char sep;
 
+    /* Only the disposed area and the new frame rectangle can change on the canvas. */
+    gif->dw = gif->dh = 0;
+    if(gif->gce.disposal == 2) join_dirty(gif, gif->fx, gif->fy, gif->fw, gif->fh);
     dispose(gif);
     f_gif_read(gif, &sep, 1);
     while(sep != ',') {
         if(sep == ';') {
             f_gif_seek(gif, gif->anim_start, LV_FS_SEEK_SET);
             if(gif->loop_count == 1 || gif->loop_count < 0) {
+                join_dirty(gif, gif->fx, gif->fy, gif->fw, gif->fh);
                 return 0;
             }
             else if(gif->loop_count > 1) {
@@ -720,6 +793,7 @@ gd_get_frame(gd_GIF * gif)
     }
     if(read_image(gif) == -1)
         return -1;
+    join_dirty(gif, gif->fx, gif->fy, gif->fw, gif->fh);
     return 1;
 }
 
@@ -727,6 +801,7 @@ void
 gd_render_frame(gd_GIF * gif, uint8_t * buffer)
 {
     render_frame_rect(gif, buffer);
+    if(buffer == gif->canvas) gif->frame_on_canvas = 1;
 }
 
 void
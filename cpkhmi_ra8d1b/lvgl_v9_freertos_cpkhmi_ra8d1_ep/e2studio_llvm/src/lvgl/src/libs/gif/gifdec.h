@@ -3,6 +3,7 @@
 
 #include <stdint.h>
 #include "../../misc/lv_fs.h"
+#include "../../misc/lv_color.h"
 
 #if LV_USE_GIF
 
@@ -41,16 +42,22 @@ typedef struct _gd_GIF {
     void (*comment)(struct _gd_GIF * gif);
     void (*application)(struct _gd_GIF * gif, char id[8], char auth[3]);
     uint16_t fx, fy, fw, fh;
+    /* Canvas area changed by the last gd_get_frame() and gd_render_frame() */
+    uint16_t dx, dy, dw, dh;
     uint8_t bgindex;
+    /* LV_COLOR_FORMAT_ARGB8888 or LV_COLOR_FORMAT_RGB565 */
+    lv_color_format_t cf;
+    uint8_t frame_on_canvas;
+    /* The frame holds the indices of the fw x fh frame rectangle only */
     uint8_t * canvas, * frame;
     #if LV_GIF_CACHE_DECODE_DATA
     uint8_t *lzw_cache;
     #endif
 } gd_GIF;
 
-gd_GIF * gd_open_gif_file(const char * fname);
+gd_GIF * gd_open_gif_file(const char * fname, lv_color_format_t cf);
 
-gd_GIF * gd_open_gif_data(const void * data);
+gd_GIF * gd_open_gif_data(const void * data, lv_color_format_t cf);
 
 void gd_render_frame(gd_GIF * gif, uint8_t * buffer);
 
@@ -26,6 +26,12 @@ extern "C" {
 #define GIFDEC_RENDER_FRAME(dst, w, h, stride, frame, pattern, tindex) \
     _gifdec_render_frame_mve(dst, w, h, stride, frame, pattern, tindex)
 
+#define GIFDEC_FILL_BG_RGB565(dst, w, h, stride, color) \
+    _gifdec_fill_bg_rgb565_mve(dst, w, h, stride, color)
+
+#define GIFDEC_RENDER_FRAME_RGB565(dst, w, h, stride, frame, pattern, tindex) \
+    _gifdec_render_frame_rgb565_mve(dst, w, h, stride, frame, pattern, tindex)
+
 /**********************
  *      MACROS
  **********************/
@@ -67,6 +73,7 @@ static inline void _gifdec_fill_bg_mve(uint8_t * dst, uint16_t w, uint16_t h, ui
         : "r0", "q0", "memory", "r14", "cc");
 }
 
+/*The frame is packed with a stride of `w`, only `dst` uses `stride`*/
 static inline void _gifdec_render_frame_mve(uint8_t * dst, uint16_t w, uint16_t h, uint16_t stride, uint8_t * frame,
                                             uint8_t * pattern, uint16_t tindex)
 {
@@ -119,7 +126,7 @@ static inline void _gifdec_render_frame_mve(uint8_t * dst, uint16_t w, uint16_t
         "1:                                                     \n"
         "mov            r0, %[stride], LSL #2                   \n"
         "add            %[dst], r0                              \n"
-        "add            %[frame], %[stride]                     \n"
+        "add            %[frame], %[w]                          \n"
         "subs           %[h], #1                                \n"
         "bne            3b                                      \n"
 
@@ -133,6 +140,95 @@ static inline void _gifdec_render_frame_mve(uint8_t * dst, uint16_t w, uint16_t
         : "r0", "r1", "r2", "q0", "q1", "q2", "q3", "q4", "q5", "q6", "q7", "memory", "r14", "cc");
 }
 
+static inline void _gifdec_fill_bg_rgb565_mve(uint16_t * dst, uint16_t w, uint16_t h, uint16_t stride,
+                                              uint16_t color)
+{
+    if(w == 0 || h == 0) {
+        return;
+    }
+
+    __asm volatile(
+        ".p2align 2                                             \n"
+        "vdup.16             q0, %[src]                         \n"
+        "3:                                                     \n"
+        "mov                 r0, %[dst]                         \n"
+
+        "wlstp.16            lr, %[w], 1f                       \n"
+        "2:                                                     \n"
+
+        "vstrh.16            q0, [r0], #16                      \n"
+        "letp                lr, 2b                             \n"
+        "1:                                                     \n"
+        "add                 %[dst], %[iTargetStride]           \n"
+        "subs                %[h], #1                           \n"
+        "bne                 3b                                 \n"
+        : [dst] "+r"(dst),
+        [h] "+r"(h)
+        : [src] "r"(color),
+        [w] "r"(w),
+        [iTargetStride] "r"(stride * sizeof(uint16_t))
+        : "r0", "q0", "memory", "r14", "cc");
+}
+
+/*Like _gifdec_render_frame_mve() but packs the palette colors to RGB565*/
+static inline void _gifdec_render_frame_rgb565_mve(uint16_t * dst, uint16_t w, uint16_t h, uint16_t stride,
+                                                   uint8_t * frame, uint8_t * pattern, uint16_t tindex)
+{
+    if(w == 0 || h == 0) {
+        return;
+    }
+
+    __asm volatile(
+        "3:                                                     \n"
+        "mov            r1, %[dst]                              \n"
+        "mov            r2, %[frame]                            \n"
+
+        "wlstp.16       lr, %[w], 1f                            \n"
+        "2:                                                     \n"
+
+        "mov            r0, #3                                  \n"
+        "vldrb.u16      q4, [r2], #8                            \n"
+        "vmul.u16       q5, q4, r0                              \n"
+
+        "mov            r0, #1                                  \n"
+        "vldrb.u16      q2, [%[pattern], q5]                    \n" /* load 8 pixel r*/
+
+        "vadd.u16       q5, q5, r0                              \n"
+        "vldrb.u16      q1, [%[pattern], q5]                    \n" /* load 8 pixel g*/
+
+        "vadd.u16       q5, q5, r0                              \n"
+        "vldrb.u16      q0, [%[pattern], q5]                    \n" /* load 8 pixel b*/
+
+        "vshr.u16       q0, q0, #3                              \n"
+        "vshr.u16       q1, q1, #2                              \n"
+        "vsli.16        q0, q1, #5                              \n" /* make 8 pixel gb*/
+        "vshr.u16       q2, q2, #3                              \n"
+        "vsli.16        q0, q2, #11                             \n" /* make 8 pixel rgb*/
+
+        "vcmp.i16       ne, q4, %[tindex]                       \n"
+        "vpst                                                   \n"
+        "vstrht.16      q0, [r1]                                \n"
+        "add            r1, r1, #16                             \n"
+
+        "letp           lr, 2b                                  \n"
+
+        "1:                                                     \n"
+        "mov            r0, %[stride], LSL #1                   \n"
+        "add            %[dst], r0                              \n"
+        "add            %[frame], %[w]                          \n"
+        "subs           %[h], #1                                \n"
+        "bne            3b                                      \n"
+
+        : [dst] "+r"(dst),
+        [frame] "+r"(frame),
+        [h] "+r"(h)
+        : [pattern] "r"(pattern),
+        [w] "r"(w),
+        [stride] "r"(stride),
+        [tindex] "r"(tindex)
+        : "r0", "r1", "r2", "q0", "q1", "q2", "q4", "q5", "memory", "r14", "cc");
+}
+
 #ifdef __cplusplus
 } /*extern "C"*/
 #endif
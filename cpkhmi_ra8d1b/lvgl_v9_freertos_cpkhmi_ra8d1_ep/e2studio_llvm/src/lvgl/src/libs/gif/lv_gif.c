@@ -26,6 +26,7 @@
 static void lv_gif_constructor(const lv_obj_class_t * class_p, lv_obj_t * obj);
 static void lv_gif_destructor(const lv_obj_class_t * class_p, lv_obj_t * obj);
 static void next_frame_task_cb(lv_timer_t * t);
+static void invalidate_frame(lv_obj_t * obj);
 
 /**********************
  *  STATIC VARIABLES
@@ -71,10 +72,10 @@ void lv_gif_set_src(lv_obj_t * obj, const void * src)
 
     if(lv_image_src_get_type(src) == LV_IMAGE_SRC_VARIABLE) {
         const lv_image_dsc_t * img_dsc = src;
-        gifobj->gif = gd_open_gif_data(img_dsc->data);
+        gifobj->gif = gd_open_gif_data(img_dsc->data, gifobj->cf);
     }
     else if(lv_image_src_get_type(src) == LV_IMAGE_SRC_FILE) {
-        gifobj->gif = gd_open_gif_file(src);
+        gifobj->gif = gd_open_gif_file(src, gifobj->cf);
     }
     if(gifobj->gif == NULL) {
         LV_LOG_WARN("Couldn't load the source");
@@ -82,9 +83,11 @@ void lv_gif_set_src(lv_obj_t * obj, const void * src)
     }
 
     gifobj->imgdsc.data = gifobj->gif->canvas;
-    gifobj->imgdsc.header.cf = LV_COLOR_FORMAT_ARGB8888;
+    gifobj->imgdsc.header.cf = gifobj->gif->cf;
     gifobj->imgdsc.header.h = gifobj->gif->height;
     gifobj->imgdsc.header.w = gifobj->gif->width;
+    gifobj->imgdsc.header.stride = gifobj->gif->width * lv_color_format_get_size(gifobj->gif->cf);
+    gifobj->imgdsc.data_size = gifobj->imgdsc.header.stride * gifobj->gif->height;
     gifobj->last_call = lv_tick_get();
 
     lv_image_set_src(obj, &gifobj->imgdsc);
@@ -96,6 +99,18 @@ void lv_gif_set_src(lv_obj_t * obj, const void * src)
 
 }
 
+void lv_gif_set_color_format(lv_obj_t * obj, lv_color_format_t cf)
+{
+    lv_gif_t * gifobj = (lv_gif_t *) obj;
+
+    if(cf != LV_COLOR_FORMAT_ARGB8888 && cf != LV_COLOR_FORMAT_RGB565) {
+        LV_LOG_WARN("Unsupported color format: %d", cf);
+        return;
+    }
+
+    gifobj->cf = cf;
+}
+
 void lv_gif_restart(lv_obj_t * obj)
 {
     lv_gif_t * gifobj = (lv_gif_t *) obj;
@@ -139,6 +154,7 @@ static void lv_gif_constructor(const lv_obj_class_t * class_p, lv_obj_t * obj)
     lv_gif_t * gifobj = (lv_gif_t *) obj;
 
     gifobj->gif = NULL;
+    gifobj->cf = LV_COLOR_FORMAT_ARGB8888;
     gifobj->timer = lv_timer_create(next_frame_task_cb, 10, obj);
     lv_timer_pause(gifobj->timer);
 }
@@ -175,7 +191,39 @@ static void next_frame_task_cb(lv_timer_t * t)
     gd_render_frame(gifobj->gif, (uint8_t *)gifobj->imgdsc.data);
 
     lv_image_cache_drop(lv_image_get_src(obj));
-    lv_obj_invalidate(obj);
+    invalidate_frame(obj);
+}
+
+/**
+ * Invalidate only the part of the canvas changed by the last frame.
+ * Transformed and tiled images are invalidated entirely.
+ */
+static void invalidate_frame(lv_obj_t * obj)
+{
+    lv_gif_t * gifobj = (lv_gif_t *) obj;
+    lv_image_t * img = (lv_image_t *) obj;
+    gd_GIF * gif = gifobj->gif;
+
+    if(gif->dw == 0 || gif->dh == 0) return;
+
+    if(img->rotation != 0 || img->scale_x != LV_SCALE_NONE || img->scale_y != LV_SCALE_NONE ||
+       img->align >= _LV_IMAGE_ALIGN_AUTO_TRANSFORM) {
+        lv_obj_invalidate(obj);
+        return;
+    }
+
+    /*Same placement as in the image's draw event*/
+    lv_area_t img_area = {obj->coords.x1, obj->coords.y1,
+                          obj->coords.x1 + img->w - 1, obj->coords.y1 + img->h - 1
+                         };
+    lv_area_align(&obj->coords, &img_area, img->align, img->offset.x, img->offset.y);
+
+    lv_area_t a;
+    a.x1 = img_area.x1 + gif->dx;
+    a.y1 = img_area.y1 + gif->dy;
+    a.x2 = a.x1 + gif->dw - 1;
+    a.y2 = a.y1 + gif->dh - 1;
+    lv_obj_invalidate_area(obj, &a);
 }
 
 #endif /*LV_USE_GIF*/
@@ -33,6 +33,7 @@ typedef struct {
     lv_timer_t * timer;
     lv_image_dsc_t imgdsc;
     uint32_t last_call;
+    lv_color_format_t cf;
 } lv_gif_t;
 
 LV_ATTRIBUTE_EXTERN_DATA extern const lv_obj_class_t lv_gif_class;
@@ -56,6 +57,14 @@ lv_obj_t * lv_gif_create(lv_obj_t * parent);
  */
 void lv_gif_set_src(lv_obj_t * obj, const void * src);
 
+/**
+ * Set the color format of the decoded frames. Takes effect on the next `lv_gif_set_src()`.
+ * @param obj       pointer to a gif object
+ * @param cf        `LV_COLOR_FORMAT_ARGB8888` (default) or `LV_COLOR_FORMAT_RGB565`.
+ *                  RGB565 halves the frame buffer but transparent pixels get the background color.
+ */
+void lv_gif_set_color_format(lv_obj_t * obj, lv_color_format_t cf);
+
 /**
  * Restart a gif animation.
  * @param obj pointer to a gif obj
@@ -13,15 +13,36 @@
 #include "tjpgd.h"
 #include "lv_tjpgd.h"
 #include "../../misc/lv_fs.h"
+#include "../../core/lv_global.h"
 
 /*********************
  *      DEFINES
  *********************/
 #define TJPGD_WORKBUFF_SIZE             4096    //Recommended by TJPGD library
 
+/*Decode to the color format of the display so the image is drawn without conversion*/
+#if LV_COLOR_DEPTH == 16
+    #define TJPGD_CF                    LV_COLOR_FORMAT_RGB565
+#else
+    #define TJPGD_CF                    LV_COLOR_FORMAT_RGB888
+#endif
+
+#define tjpgd_backend LV_GLOBAL_DEFAULT()->tjpgd_backend
+
 /**********************
  *      TYPEDEFS
  **********************/
+typedef struct {
+    JDEC jd;
+    lv_fs_file_t file;
+    bool is_file;
+    const uint8_t * data;       /*The JPEG stream if it's in memory*/
+    uint32_t data_size;
+    uint32_t data_pos;
+    int32_t y;                  /*Top of the next MCU row*/
+    lv_draw_buf_t * row;        /*A row of MCUs, streamed to the draw unit*/
+    uint32_t pool[TJPGD_WORKBUFF_SIZE / sizeof(uint32_t)];
+} tjpgd_session_t;
 
 /**********************
  *  STATIC PROTOTYPES
@@ -32,6 +53,16 @@ static lv_result_t decoder_open(lv_image_decoder_t * decoder, lv_image_decoder_d
 static lv_result_t decoder_get_area(lv_image_decoder_t * decoder, lv_image_decoder_dsc_t * dsc,
                                     const lv_area_t * full_area, lv_area_t * decoded_area);
 static void decoder_close(lv_image_decoder_t * decoder, lv_image_decoder_dsc_t * dsc);
+static void tjpgd_decoder_cache_free_cb(lv_image_cache_data_t * cached_data, void * user_data);
+static lv_result_t decode_with_backend(lv_image_decoder_t * decoder, lv_image_decoder_dsc_t * dsc,
+                                       tjpgd_session_t * session);
+static lv_result_t session_open(tjpgd_session_t * session, const void * src, lv_image_src_t src_type);
+static lv_result_t session_open_data(tjpgd_session_t * session, const uint8_t * data, uint32_t data_size);
+static lv_result_t session_rewind(tjpgd_session_t * session);
+static lv_result_t session_prepare(tjpgd_session_t * session);
+static void session_close(tjpgd_session_t * session);
+static JRESULT decode_mcu_row(tjpgd_session_t * session, uint8_t * buf, uint32_t stride, uint8_t fmt,
+                              int32_t x1, int32_t x2);
 static size_t input_func(JDEC * jd, uint8_t * buff, size_t ndata);
 static int is_jpg(const uint8_t * raw_data, size_t len);
 
@@ -54,6 +85,7 @@ void lv_tjpgd_init(void)
     lv_image_decoder_set_open_cb(dec, decoder_open);
     lv_image_decoder_set_get_area_cb(dec, decoder_get_area);
     lv_image_decoder_set_close_cb(dec, decoder_close);
+    lv_image_decoder_set_cache_free_cb(dec, (lv_cache_free_cb_t)tjpgd_decoder_cache_free_cb);
 }
 
 void lv_tjpgd_deinit(void)
@@ -65,6 +97,55 @@ void lv_tjpgd_deinit(void)
             break;
         }
     }
+
+    tjpgd_backend = NULL;
+}
+
+void lv_tjpgd_set_backend(lv_tjpgd_backend_t * backend)
+{
+    tjpgd_backend = backend;
+}
+
+lv_tjpgd_backend_t * lv_tjpgd_get_backend(void)
+{
+    return tjpgd_backend;
+}
+
+lv_result_t lv_tjpgd_decode_sw(lv_tjpgd_backend_t * backend, const uint8_t * data, uint32_t data_size,
+                               lv_draw_buf_t * decoded)
+{
+    LV_UNUSED(backend);
+
+    uint8_t fmt;
+    if(decoded->header.cf == LV_COLOR_FORMAT_RGB565) fmt = 1;
+    else if(decoded->header.cf == LV_COLOR_FORMAT_RGB888) fmt = 0;
+    else return LV_RESULT_INVALID;
+
+    tjpgd_session_t * session = lv_malloc_zeroed(sizeof(tjpgd_session_t));
+    LV_ASSERT_MALLOC(session);
+    if(session == NULL) return LV_RESULT_INVALID;
+
+    lv_result_t res = session_open_data(session, data, data_size);
+    JDEC * jd = &session->jd;
+    if(res == LV_RESULT_OK && (jd->width != decoded->header.w || jd->height != decoded->header.h)) {
+        LV_LOG_WARN("the draw buffer is %dx%d, the image is %dx%d", (int)decoded->header.w, (int)decoded->header.h,
+                    (int)jd->width, (int)jd->height);
+        res = LV_RESULT_INVALID;
+    }
+
+    uint32_t stride = decoded->header.stride;
+    while(res == LV_RESULT_OK && session->y < jd->height) {
+        uint8_t * buf = (uint8_t *)decoded->data + session->y * stride;
+        JRESULT rc = decode_mcu_row(session, buf, stride, fmt, 0, jd->width - 1);
+        if(rc != JDR_OK) {
+            LV_LOG_WARN("decoding error: %d", rc);
+            res = LV_RESULT_INVALID;
+        }
+        session->y += jd->msy * 8;
+    }
+
+    lv_free(session);
+    return res;
 }
 
 /**********************
@@ -83,182 +164,133 @@ static lv_result_t decoder_info(lv_image_decoder_t * decoder, const void * src,
         const uint32_t raw_data_size = img_dsc->data_size;
 
         if(is_jpg(raw_data, raw_data_size) == true) {
-#if LV_USE_FS_MEMFS
             header->cf = LV_COLOR_FORMAT_RAW;
             header->w = img_dsc->header.w;
             header->h = img_dsc->header.h;
             header->stride = img_dsc->header.w * 3;
             return LV_RESULT_OK;
-#else
-            LV_LOG_WARN("LV_USE_FS_MEMFS needs to enabled to decode from data");
-            return LV_RESULT_INVALID;
-#endif
         }
     }
     else if(src_type == LV_IMAGE_SRC_FILE) {
         const char * fn = src;
         if((lv_strcmp(lv_fs_get_ext(fn), "jpg") == 0) || (lv_strcmp(lv_fs_get_ext(fn), "jpeg") == 0)) {
-            lv_fs_file_t f;
-            lv_fs_res_t res;
-            res = lv_fs_open(&f, fn, LV_FS_MODE_RD);
-            if(res != LV_FS_RES_OK) return LV_RESULT_INVALID;
-
-            uint8_t workb[TJPGD_WORKBUFF_SIZE];
-            JDEC jd;
-            JRESULT rc = jd_prepare(&jd, input_func, workb, TJPGD_WORKBUFF_SIZE, &f);
-            if(rc) {
-                LV_LOG_WARN("jd_prepare error: %d", rc);
-                lv_fs_close(&f);
-                return LV_RESULT_INVALID;
+            tjpgd_session_t * session = lv_malloc_zeroed(sizeof(tjpgd_session_t));
+            LV_ASSERT_MALLOC(session);
+            if(session == NULL) return LV_RESULT_INVALID;
+
+            lv_result_t res = session_open(session, src, src_type);
+            if(res == LV_RESULT_OK) {
+                header->cf = LV_COLOR_FORMAT_RAW;
+                header->w = session->jd.width;
+                header->h = session->jd.height;
+                header->stride = session->jd.width * 3;
+                session_close(session);
             }
-            header->cf = LV_COLOR_FORMAT_RAW;
-            header->w = jd.width;
-            header->h = jd.height;
-            header->stride = jd.width * 3;
 
-            lv_fs_close(&f);
-            return LV_RESULT_OK;
+            lv_free(session);
+            return res;
         }
     }
     return LV_RESULT_INVALID;
 }
 
-static size_t input_func(JDEC * jd, uint8_t * buff, size_t ndata)
-{
-    lv_fs_file_t * f = jd->device;
-    if(!f) return 0;
-
-    if(buff) {
-        uint32_t rn = 0;
-        lv_fs_read(f, buff, (uint32_t)ndata, &rn);
-        return rn;
-    }
-    else {
-        uint32_t pos;
-        lv_fs_tell(f, &pos);
-        lv_fs_seek(f, (uint32_t)(ndata + pos),  LV_FS_SEEK_SET);
-        return ndata;
-    }
-    return 0;
-}
-
 /**
- * Decode a JPG image and return the decoded data.
+ * Open a JPG image. It's decoded by the backend if there is one, streamed in rows of MCUs otherwise.
  * @param decoder pointer to the decoder
  * @param dsc     pointer to the decoder descriptor
  * @return LV_RESULT_OK: no error; LV_RESULT_INVALID: can't open the image
  */
 static lv_result_t decoder_open(lv_image_decoder_t * decoder, lv_image_decoder_dsc_t * dsc)
 {
-    LV_UNUSED(decoder);
-    lv_fs_file_t * f = lv_malloc(sizeof(lv_fs_file_t));
-    if(dsc->src_type == LV_IMAGE_SRC_VARIABLE) {
-#if LV_USE_FS_MEMFS
-        const lv_image_dsc_t * img_dsc = dsc->src;
-        if(is_jpg(img_dsc->data, img_dsc->data_size) == true) {
-            lv_fs_path_ex_t path;
-            lv_fs_make_path_from_buffer(&path, LV_FS_MEMFS_LETTER, img_dsc->data, img_dsc->data_size);
-            lv_fs_res_t res;
-            res = lv_fs_open(f, (const char *)&path, LV_FS_MODE_RD);
-            if(res != LV_FS_RES_OK) {
-                lv_free(f);
-                return LV_RESULT_INVALID;
-            }
-        }
-#else
-        LV_LOG_WARN("LV_USE_FS_MEMFS needs to enabled to decode from data");
+    tjpgd_session_t * session = lv_malloc_zeroed(sizeof(tjpgd_session_t));
+    LV_ASSERT_MALLOC(session);
+    if(session == NULL) return LV_RESULT_INVALID;
+
+    if(session_open(session, dsc->src, dsc->src_type) != LV_RESULT_OK) {
+        lv_free(session);
         return LV_RESULT_INVALID;
-#endif
-    }
-    else if(dsc->src_type == LV_IMAGE_SRC_FILE) {
-        const char * fn = dsc->src;
-        if((lv_strcmp(lv_fs_get_ext(fn), "jpg") == 0) || (lv_strcmp(lv_fs_get_ext(fn), "jpeg") == 0)) {
-            lv_fs_res_t res;
-            res = lv_fs_open(f, fn, LV_FS_MODE_RD);
-            if(res != LV_FS_RES_OK) {
-                lv_free(f);
-                return LV_RESULT_INVALID;
-            }
-        }
     }
 
-    uint8_t * workb_temp = lv_malloc(TJPGD_WORKBUFF_SIZE);
-    JDEC * jd = lv_malloc(sizeof(JDEC));
-    dsc->user_data = jd;
-    JRESULT rc = jd_prepare(jd, input_func, workb_temp, (size_t)TJPGD_WORKBUFF_SIZE, f);
-    if(rc) return rc;
-
-    dsc->header.cf = LV_COLOR_FORMAT_RGB888;
+    JDEC * jd = &session->jd;
+    dsc->header.cf = TJPGD_CF;
     dsc->header.w = jd->width;
     dsc->header.h = jd->height;
-    dsc->header.stride = jd->width * 3;
+    dsc->header.stride = lv_draw_buf_width_to_stride(jd->width, TJPGD_CF);
 
-    if(rc != JDR_OK) {
-        lv_free(workb_temp);
-        lv_free(jd);
+    if(tjpgd_backend) {
+        if(decode_with_backend(decoder, dsc, session) == LV_RESULT_OK) {
+            session_close(session);
+            lv_free(session);
+            return LV_RESULT_OK;
+        }
+
+        /*The backend may have read the file, start over*/
+        if(session_rewind(session) != LV_RESULT_OK) {
+            session_close(session);
+            lv_free(session);
+            return LV_RESULT_INVALID;
+        }
+    }
+
+    session->row = lv_draw_buf_create(jd->width, jd->msy * 8, TJPGD_CF, LV_STRIDE_AUTO);
+    if(session->row == NULL) {
+        LV_LOG_WARN("out of memory");
+        session_close(session);
+        lv_free(session);
         return LV_RESULT_INVALID;
     }
 
+    dsc->user_data = session;
     return LV_RESULT_OK;
 }
 
+/**
+ * Decode the next row of MCUs. The rows above `full_area` are only loaded, the MCUs
+ * left and right to it are not converted and decoding stops below it.
+ */
 static lv_result_t decoder_get_area(lv_image_decoder_t * decoder, lv_image_decoder_dsc_t * dsc,
                                     const lv_area_t * full_area, lv_area_t * decoded_area)
 {
     LV_UNUSED(decoder);
-    LV_UNUSED(full_area);
 
-    JDEC * jd = dsc->user_data;
-    lv_draw_buf_t * decoded = (void *)dsc->decoded;
-    if(decoded == NULL) decoded = lv_malloc_zeroed(sizeof(lv_draw_buf_t));
-    dsc->decoded = decoded;
+    tjpgd_session_t * session = dsc->user_data;
+    if(session == NULL) return LV_RESULT_INVALID;
 
-    uint32_t  mx, my;
-    mx = jd->msx * 8;
-    my = jd->msy * 8;         /* Size of the MCU (pixel) */
-    if(decoded_area->y1 == LV_COORD_MIN) {
-        decoded_area->y1 = 0;
-        decoded_area->y2 = my - 1;
-        decoded_area->x1 = -mx;
-        decoded_area->x2 = -1;
-        jd->scale = 0;
-        jd->dcv[2] = jd->dcv[1] = jd->dcv[0] = 0;   /* Initialize DC values */
-        jd->rst = 0;
-        jd->rsc = 0;
-        decoded->data = jd->workbuf;
-        decoded->header = dsc->header;
-        decoded->header.stride = mx * 3;
+    JDEC * jd = &session->jd;
+    int32_t my = jd->msy * 8;   /* Height of the MCU (pixel) */
+
+    if(decoded_area->y1 == LV_COORD_MIN && session->y != 0) {
+        if(session_rewind(session) != LV_RESULT_OK) return LV_RESULT_INVALID;
     }
 
-    decoded_area->x1 += mx;
-    decoded_area->x2 += mx;
+    uint8_t fmt = TJPGD_CF == LV_COLOR_FORMAT_RGB565 ? 1 : 0;
+    lv_draw_buf_t * row = session->row;
+    JRESULT rc;
 
-    if(decoded_area->x1 >= jd->width) {
-        decoded_area->x1 = 0;
-        decoded_area->x2 = mx - 1;
-        decoded_area->y1 += my;
-        decoded_area->y2 += my;
+    /*The stream can't be skipped, load the MCUs above the area without converting them*/
+    while(session->y + my <= full_area->y1) {
+        rc = decode_mcu_row(session, NULL, 0, fmt, 0, 0);
+        if(rc != JDR_OK) return LV_RESULT_INVALID;
+        session->y += my;
     }
 
-    decoded->header.w = mx;
-    decoded->header.h = my;
-    decoded->data_size = decoded->header.stride * decoded->header.h;
+    if(session->y > full_area->y2 || session->y >= jd->height) return LV_RESULT_INVALID;
 
-    /* Process restart interval if enabled */
-    JRESULT rc;
-    if(jd->nrst && jd->rst++ == jd->nrst) {
-        rc = jd_restart(jd, jd->rsc++);
-        if(rc != JDR_OK) return rc;
-        jd->rst = 1;
+    rc = decode_mcu_row(session, row->data, row->header.stride, fmt, full_area->x1, full_area->x2);
+    if(rc != JDR_OK) {
+        LV_LOG_WARN("decoding error: %d", rc);
+        return LV_RESULT_INVALID;
     }
 
-    /* Load an MCU (decompress huffman coded stream, dequantize and apply IDCT) */
-    rc = jd_mcu_load(jd);
-    if(rc != JDR_OK) return rc;
+    decoded_area->x1 = 0;
+    decoded_area->x2 = jd->width - 1;
+    decoded_area->y1 = session->y;
+    decoded_area->y2 = LV_MIN(session->y + my, jd->height) - 1;
+
+    row->header.h = lv_area_get_height(decoded_area);
+    dsc->decoded = row;
 
-    /* Output the MCU (YCbCr to RGB, scaling and output) */
-    rc = jd_mcu_output(jd, NULL, decoded_area->x1, decoded_area->y1);
-    if(rc != JDR_OK) return rc;
+    session->y += my;
 
     return LV_RESULT_OK;
 }
@@ -271,12 +303,233 @@ static lv_result_t decoder_get_area(lv_image_decoder_t * decoder, lv_image_decod
 static void decoder_close(lv_image_decoder_t * decoder, lv_image_decoder_dsc_t * dsc)
 {
     LV_UNUSED(decoder);
-    JDEC * jd = dsc->user_data;
-    lv_fs_close(jd->device);
-    lv_free(jd->device);
-    lv_free(jd->pool_original);
-    lv_free(jd);
-    lv_free((void *)dsc->decoded);
+
+    tjpgd_session_t * session = dsc->user_data;
+    if(session) {
+        session_close(session);
+        lv_draw_buf_destroy(session->row);
+        lv_free(session);
+        dsc->user_data = NULL;
+    }
+    else if(dsc->args.no_cache || LV_CACHE_DEF_SIZE == 0) {
+        lv_draw_buf_destroy((lv_draw_buf_t *)dsc->decoded);
+    }
+    else {
+        lv_cache_release(dsc->cache, dsc->cache_entry, NULL);
+    }
+}
+
+static void tjpgd_decoder_cache_free_cb(lv_image_cache_data_t * cached_data, void * user_data)
+{
+    LV_UNUSED(user_data);
+
+    if(cached_data->src_type == LV_IMAGE_SRC_FILE) lv_free((void *)cached_data->src);
+    lv_draw_buf_destroy((lv_draw_buf_t *)cached_data->decoded);
+}
+
+/**
+ * Decode the whole image with the backend and add it to the image cache.
+ * @return LV_RESULT_OK: `dsc->decoded` is set; LV_RESULT_INVALID: the image needs to be streamed
+ */
+static lv_result_t decode_with_backend(lv_image_decoder_t * decoder, lv_image_decoder_dsc_t * dsc,
+                                       tjpgd_session_t * session)
+{
+    const uint8_t * data = session->data;
+    uint32_t data_size = session->data_size;
+    uint8_t * file_data = NULL;
+
+    if(session->is_file) {
+        uint32_t br = 0;
+        lv_fs_seek(&session->file, 0, LV_FS_SEEK_END);
+        lv_fs_tell(&session->file, &data_size);
+        lv_fs_seek(&session->file, 0, LV_FS_SEEK_SET);
+
+        file_data = lv_malloc(data_size);
+        if(file_data == NULL) return LV_RESULT_INVALID;
+
+        lv_fs_read(&session->file, file_data, data_size, &br);
+        if(br != data_size) {
+            lv_free(file_data);
+            return LV_RESULT_INVALID;
+        }
+        data = file_data;
+    }
+
+    lv_draw_buf_t * decoded = lv_draw_buf_create(dsc->header.w, dsc->header.h, TJPGD_CF, LV_STRIDE_AUTO);
+    lv_result_t res = LV_RESULT_INVALID;
+    if(decoded) res = tjpgd_backend->decode_cb(tjpgd_backend, data, data_size, decoded);
+
+    lv_free(file_data);
+
+    if(res != LV_RESULT_OK) {
+        LV_LOG_INFO("%s can't decode the image, streaming it", tjpgd_backend->name);
+        if(decoded) lv_draw_buf_destroy(decoded);
+        return LV_RESULT_INVALID;
+    }
+
+    dsc->decoded = decoded;
+
+    if(dsc->args.no_cache) return LV_RESULT_OK;
+
+#if LV_CACHE_DEF_SIZE > 0
+    lv_image_cache_data_t search_key;
+    lv_memzero(&search_key, sizeof(search_key));
+    search_key.src_type = dsc->src_type;
+    search_key.src = dsc->src;
+    search_key.slot.size = decoded->data_size;
+
+    lv_cache_entry_t * entry = lv_image_decoder_add_to_cache(decoder, &search_key, decoded, NULL);
+    if(entry == NULL) {
+        lv_draw_buf_destroy(decoded);
+        dsc->decoded = NULL;
+        return LV_RESULT_INVALID;
+    }
+    dsc->cache_entry = entry;
+#else
+    LV_UNUSED(decoder);
+#endif
+
+    return LV_RESULT_OK;
+}
+
+static lv_result_t session_open(tjpgd_session_t * session, const void * src, lv_image_src_t src_type)
+{
+    if(src_type == LV_IMAGE_SRC_VARIABLE) {
+        const lv_image_dsc_t * img_dsc = src;
+        if(is_jpg(img_dsc->data, img_dsc->data_size) == false) return LV_RESULT_INVALID;
+        return session_open_data(session, img_dsc->data, img_dsc->data_size);
+    }
+
+    if(src_type == LV_IMAGE_SRC_FILE) {
+        const char * fn = src;
+        if((lv_strcmp(lv_fs_get_ext(fn), "jpg") != 0) && (lv_strcmp(lv_fs_get_ext(fn), "jpeg") != 0)) {
+            return LV_RESULT_INVALID;
+        }
+
+        lv_fs_res_t res = lv_fs_open(&session->file, fn, LV_FS_MODE_RD);
+        if(res != LV_FS_RES_OK) return LV_RESULT_INVALID;
+        session->is_file = true;
+
+        if(session_prepare(session) != LV_RESULT_OK) {
+            session_close(session);
+            return LV_RESULT_INVALID;
+        }
+        return LV_RESULT_OK;
+    }
+
+    return LV_RESULT_INVALID;
+}
+
+static lv_result_t session_open_data(tjpgd_session_t * session, const uint8_t * data, uint32_t data_size)
+{
+    session->data = data;
+    session->data_size = data_size;
+    session->data_pos = 0;
+
+    return session_prepare(session);
+}
+
+static lv_result_t session_rewind(tjpgd_session_t * session)
+{
+    if(session->is_file) lv_fs_seek(&session->file, 0, LV_FS_SEEK_SET);
+    else session->data_pos = 0;
+
+    return session_prepare(session);
+}
+
+static lv_result_t session_prepare(tjpgd_session_t * session)
+{
+    JDEC * jd = &session->jd;
+    JRESULT rc = jd_prepare(jd, input_func, session->pool, sizeof(session->pool), session);
+    if(rc != JDR_OK) {
+        LV_LOG_WARN("jd_prepare error: %d", rc);
+        return LV_RESULT_INVALID;
+    }
+
+    jd->scale = 0;
+    jd->dcv[2] = jd->dcv[1] = jd->dcv[0] = 0;   /* Initialize DC values */
+    jd->rst = 0;
+    jd->rsc = 0;
+    session->y = 0;
+
+    return LV_RESULT_OK;
+}
+
+static void session_close(tjpgd_session_t * session)
+{
+    if(session->is_file) {
+        lv_fs_close(&session->file);
+        session->is_file = false;
+    }
+}
+
+/**
+ * Load a row of MCUs and convert the ones between `x1` and `x2`.
+ * @param session   the decoding session, `session->y` is the top of the row
+ * @param buf       start of the row in the output, NULL to only load the MCUs
+ * @param stride    stride of `buf` in bytes
+ * @param fmt       0: RGB888, 1: RGB565
+ * @param x1        first column to convert
+ * @param x2        last column to convert
+ * @return          JDR_OK or the tjpgd error
+ */
+static JRESULT decode_mcu_row(tjpgd_session_t * session, uint8_t * buf, uint32_t stride, uint8_t fmt,
+                              int32_t x1, int32_t x2)
+{
+    JDEC * jd = &session->jd;
+    int32_t mx = jd->msx * 8;   /* Width of the MCU (pixel) */
+    uint32_t px_size = fmt == 1 ? 2 : 3;
+    int32_t x;
+    JRESULT rc;
+
+    for(x = 0; x < jd->width; x += mx) {
+        /* Process restart interval if enabled */
+        if(jd->nrst && jd->rst++ == jd->nrst) {
+            rc = jd_restart(jd, jd->rsc++);
+            if(rc != JDR_OK) return rc;
+            jd->rst = 1;
+        }
+
+        /* Load an MCU (decompress huffman coded stream, dequantize and apply IDCT) */
+        rc = jd_mcu_load(jd);
+        if(rc != JDR_OK) return rc;
+
+        /* Output the MCU (YCbCr to RGB) if it's in the area */
+        if(buf && x + mx > x1 && x <= x2) {
+            rc = jd_mcu_output_buf(jd, buf + x * px_size, stride, fmt, x, session->y);
+            if(rc != JDR_OK) return rc;
+        }
+    }
+
+    return JDR_OK;
+}
+
+static size_t input_func(JDEC * jd, uint8_t * buff, size_t ndata)
+{
+    tjpgd_session_t * session = jd->device;
+    if(!session) return 0;
+
+    if(session->is_file) {
+        lv_fs_file_t * f = &session->file;
+        if(buff) {
+            uint32_t rn = 0;
+            lv_fs_read(f, buff, (uint32_t)ndata, &rn);
+            return rn;
+        }
+        else {
+            uint32_t pos;
+            lv_fs_tell(f, &pos);
+            lv_fs_seek(f, (uint32_t)(ndata + pos),  LV_FS_SEEK_SET);
+            return ndata;
+        }
+    }
+
+    uint32_t left = session->data_size - session->data_pos;
+    if(ndata > left) ndata = left;
+    if(buff) lv_memcpy(buff, session->data + session->data_pos, ndata);
+    session->data_pos += (uint32_t)ndata;
+
+    return ndata;
 }
 
 static int is_jpg(const uint8_t * raw_data, size_t len)
@@ -0,0 +1,219 @@
+/**
+ * @file tjpgd_mve.h
+ *
+ */
+
+#ifndef TJPGD_MVE_H
+#define TJPGD_MVE_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*********************
+ *      INCLUDES
+ *********************/
+#include <stdint.h>
+#include "tjpgd.h"
+
+/*********************
+ *      DEFINES
+ *********************/
+
+/*The vector IDCT stores the rows as 16 bit values*/
+#if JD_FASTDECODE >= 1
+#define TJPGD_BLOCK_IDCT(src, dst) \
+    _tjpgd_block_idct_mve(src, dst)
+
+#define TJPGD_YCC_TO_RGB565(pix, py, pc, n, hsub) \
+    _tjpgd_ycc_to_rgb565_mve(pix, py, pc, n, hsub)
+#endif
+
+/**********************
+ *      MACROS
+ **********************/
+
+/*One pass of the Arai IDCT on 4 lanes. A0..A7 address the 8 elements of the lanes, they are transformed in place.
+ *The even part is parked in the slots it's written to at the end, so q7 stays free for a gather base.*/
+#define _TJPGD_IDCT_PASS(A0, A1, A2, A3, A4, A5, A6, A7)                  \
+    "vldrw.u32          q0, " A0 "                          \n"             \
+    "vldrw.u32          q1, " A2 "                          \n"             \
+    "vldrw.u32          q2, " A4 "                          \n"             \
+    "vldrw.u32          q3, " A6 "                          \n"             \
+    "vadd.i32           q0, q0, %[dc]                       \n"             \
+    "vadd.i32           q4, q0, q2                          \n" /*t10*/     \
+    "vsub.i32           q5, q0, q2                          \n" /*t12*/     \
+    "vsub.i32           q6, q1, q3                          \n"             \
+    "vmul.i32           q6, q6, %[m13]                      \n"             \
+    "vshr.s32           q6, q6, #12                         \n" /*t11*/     \
+    "vadd.i32           q3, q3, q1                          \n"             \
+    "vsub.i32           q6, q6, q3                          \n"             \
+    "vadd.i32           q0, q4, q3                          \n" /*v0*/      \
+    "vsub.i32           q3, q4, q3                          \n" /*v3*/      \
+    "vadd.i32           q1, q6, q5                          \n" /*v1*/      \
+    "vsub.i32           q2, q5, q6                          \n" /*v2*/      \
+    "vstrw.32           q0, " A0 "                          \n"             \
+    "vstrw.32           q2, " A2 "                          \n"             \
+    "vstrw.32           q3, " A4 "                          \n"             \
+    "vstrw.32           q1, " A6 "                          \n"             \
+    "vldrw.u32          q3, " A7 "                          \n" /*v4*/      \
+    "vldrw.u32          q4, " A1 "                          \n" /*v5*/      \
+    "vldrw.u32          q5, " A5 "                          \n" /*v6*/      \
+    "vldrw.u32          q6, " A3 "                          \n" /*v7*/      \
+    "vsub.i32           q0, q4, q3                          \n" /*t10*/     \
+    "vadd.i32           q1, q4, q3                          \n" /*t11*/     \
+    "vsub.i32           q2, q5, q6                          \n" /*t12*/     \
+    "vadd.i32           q6, q6, q5                          \n"             \
+    "vsub.i32           q4, q1, q6                          \n"             \
+    "vmul.i32           q4, q4, %[m13]                      \n"             \
+    "vshr.s32           q4, q4, #12                         \n" /*v5*/      \
+    "vadd.i32           q6, q6, q1                          \n" /*v7*/      \
+    "vadd.i32           q3, q0, q2                          \n"             \
+    "vmul.i32           q3, q3, %[m5]                       \n"             \
+    "vshr.s32           q3, q3, #12                         \n" /*t13*/     \
+    "vmul.i32           q1, q0, %[m2]                       \n"             \
+    "vshr.s32           q1, q1, #12                         \n"             \
+    "vsub.i32           q1, q3, q1                          \n"             \
+    "vmul.i32           q5, q2, %[m4]                       \n"             \
+    "vshr.s32           q5, q5, #12                         \n"             \
+    "vsub.i32           q5, q3, q5                          \n"             \
+    "vsub.i32           q5, q5, q6                          \n" /*v6*/      \
+    "vsub.i32           q4, q4, q5                          \n" /*v5*/      \
+    "vsub.i32           q1, q1, q4                          \n" /*v4*/      \
+    "vldrw.u32          q0, " A0 "                          \n" /*v0*/      \
+    "vadd.i32           q2, q0, q6                          \n"             \
+    "vstrw.32           q2, " A0 "                          \n"             \
+    "vsub.i32           q2, q0, q6                          \n"             \
+    "vstrw.32           q2, " A7 "                          \n"             \
+    "vldrw.u32          q0, " A6 "                          \n" /*v1*/      \
+    "vadd.i32           q2, q0, q5                          \n"             \
+    "vstrw.32           q2, " A1 "                          \n"             \
+    "vsub.i32           q2, q0, q5                          \n"             \
+    "vstrw.32           q2, " A6 "                          \n"             \
+    "vldrw.u32          q0, " A2 "                          \n" /*v2*/      \
+    "vadd.i32           q2, q0, q4                          \n"             \
+    "vstrw.32           q2, " A2 "                          \n"             \
+    "vsub.i32           q2, q0, q4                          \n"             \
+    "vstrw.32           q2, " A5 "                          \n"             \
+    "vldrw.u32          q0, " A4 "                          \n" /*v3*/      \
+    "vadd.i32           q2, q0, q1                          \n"             \
+    "vstrw.32           q2, " A3 "                          \n"             \
+    "vsub.i32           q2, q0, q1                          \n"             \
+    "vstrw.32           q2, " A4 "                          \n"
+
+/**********************
+ *      TYPEDEFS
+ **********************/
+
+/**********************
+ * GLOBAL PROTOTYPES
+ **********************/
+
+#if JD_FASTDECODE >= 1
+
+/*Same arithmetic as block_idct(). The column pass works on 4 columns at once, the row pass gathers 4 rows.*/
+static inline void _tjpgd_block_idct_mve(int32_t * src, jd_yuv_t * dst)
+{
+    const int32_t m13 = (int32_t)(1.41421 * 4096), m2 = (int32_t)(1.08239 * 4096), m4 = (int32_t)(2.61313 * 4096),
+                  m5 = (int32_t)(1.84776 * 4096);
+    uint32_t rows[4];
+    int32_t * p;
+    int i;
+
+    for(i = 0; i < 2; i++) {
+        p = src + i * 4;
+        __asm volatile(
+            _TJPGD_IDCT_PASS("[%[p]]", "[%[p], #32]", "[%[p], #64]", "[%[p], #96]",
+                             "[%[p], #128]", "[%[p], #160]", "[%[p], #192]", "[%[p], #224]")
+            :
+            : [p] "r"(p), [dc] "r"(0), [m13] "r"(m13), [m2] "r"(m2), [m4] "r"(m4), [m5] "r"(m5)
+            : "q0", "q1", "q2", "q3", "q4", "q5", "q6", "memory");
+    }
+
+    for(i = 0; i < 2; i++) {
+        p = src + i * 32;
+        rows[0] = (uint32_t)(uintptr_t)&p[0];
+        rows[1] = (uint32_t)(uintptr_t)&p[8];
+        rows[2] = (uint32_t)(uintptr_t)&p[16];
+        rows[3] = (uint32_t)(uintptr_t)&p[24];
+        __asm volatile(
+            "vldrw.u32          q7, [%[rows]]                       \n"
+            _TJPGD_IDCT_PASS("[q7]", "[q7, #4]", "[q7, #8]", "[q7, #12]",
+                             "[q7, #16]", "[q7, #20]", "[q7, #24]", "[q7, #28]")
+            :
+            : [rows] "r"(rows), [dc] "r"(128L << 8), [m13] "r"(m13), [m2] "r"(m2), [m4] "r"(m4), [m5] "r"(m5)
+            : "q0", "q1", "q2", "q3", "q4", "q5", "q6", "q7", "memory");
+    }
+
+    /*Descale 8 bits and narrow to the MCU buffer*/
+    __asm volatile(
+        ".p2align 2                                             \n"
+        "wlstp.32           lr, %[n], 1f                        \n"
+        "2:                                                     \n"
+        "vldrw.u32          q0, [%[src]], #16                   \n"
+        "vshr.s32           q0, q0, #8                          \n"
+        "vstrh.32           q0, [%[dst]], #8                    \n"
+        "letp               lr, 2b                              \n"
+        "1:                                                     \n"
+        : [src] "+r"(src),
+        [dst] "+r"(dst)
+        : [n] "r"(64)
+        : "q0", "memory", "r14", "cc");
+}
+
+/*Same arithmetic as ycc_to_rgb565(), vqdmulh gives (a * b) >> 15*/
+static inline void _tjpgd_ycc_to_rgb565_mve(uint16_t * pix, const jd_yuv_t * py, const jd_yuv_t * pc,
+                                            unsigned int n, unsigned int hsub)
+{
+    static const uint16_t chroma_idx[2][8] = {
+        {0, 1, 2, 3, 4, 5, 6, 7},
+        {0, 0, 1, 1, 2, 2, 3, 3},
+    };
+
+    __asm volatile(
+        "vldrh.u16          q7, [%[idx]]                        \n"
+        "vctp.16            %[n]                                \n"
+        "vpsttt                                                 \n"
+        "vldrht.u16         q0, [%[py]]                         \n"
+        "vldrht.u16         q1, [%[cb], q7, uxtw #1]            \n"
+        "vldrht.u16         q2, [%[cr], q7, uxtw #1]            \n"
+        "vsub.i16           q1, q1, %[c128]                     \n"
+        "vsub.i16           q2, q2, %[c128]                     \n"
+        "vqdmulh.s16        q3, q1, %[kb]                       \n"
+        "vadd.i16           q3, q3, q1                          \n"
+        "vadd.i16           q3, q3, q0                          \n" /*B*/
+        "vqdmulh.s16        q4, q2, %[kr]                       \n"
+        "vadd.i16           q4, q4, q2                          \n"
+        "vadd.i16           q4, q4, q0                          \n" /*R*/
+        "vqdmulh.s16        q5, q1, %[kgb]                      \n"
+        "vqdmulh.s16        q6, q2, %[kgr]                      \n"
+        "vsub.i16           q5, q0, q5                          \n"
+        "vsub.i16           q5, q5, q6                          \n" /*G*/
+        "vmov.i16           q6, #0                              \n"
+        "vmov.i16           q7, #255                            \n"
+        "vmax.s16           q3, q3, q6                          \n"
+        "vmin.s16           q3, q3, q7                          \n"
+        "vmax.s16           q4, q4, q6                          \n"
+        "vmin.s16           q4, q4, q7                          \n"
+        "vmax.s16           q5, q5, q6                          \n"
+        "vmin.s16           q5, q5, q7                          \n"
+        "vshr.u16           q3, q3, #3                          \n"
+        "vshr.u16           q5, q5, #2                          \n"
+        "vsli.16            q3, q5, #5                          \n"
+        "vshr.u16           q4, q4, #3                          \n"
+        "vsli.16            q3, q4, #11                         \n"
+        "vpst                                                   \n"
+        "vstrht.16          q3, [%[pix]]                        \n"
+        :
+        : [pix] "r"(pix), [py] "r"(py), [cb] "r"(pc), [cr] "r"(pc + 64), [idx] "r"(chroma_idx[hsub]),
+        [n] "r"(n), [c128] "r"(128), [kb] "r"(25297), [kr] "r"(13173), [kgb] "r"(11272), [kgr] "r"(23396)
+        : "q0", "q1", "q2", "q3", "q4", "q5", "q6", "q7", "memory");
+}
+
+#endif /*JD_FASTDECODE >= 1*/
+
+#ifdef __cplusplus
+} /*extern "C"*/
+#endif
+
+#endif /*TJPGD_MVE_H*/
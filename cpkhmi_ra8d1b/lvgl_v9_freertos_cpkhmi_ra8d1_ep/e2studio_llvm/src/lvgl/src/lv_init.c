@@ -22,6 +22,7 @@
 #include "libs/lodepng/lv_lodepng.h"
 #include "libs/libpng/lv_libpng.h"
 #include "draw/lv_draw.h"
+#include "font/lv_font_fmt_txt.h"
 #include "misc/lv_async.h"
 #include "misc/lv_fs.h"
 #if LV_USE_DRAW_VGLITE
@@ -96,11 +97,6 @@ static inline void lv_global_init(lv_global_t * global)
     global->area_trans_cache.angle_prev = INT32_MIN;
     global->event_last_register_id = _LV_EVENT_LAST;
     lv_rand_set_seed(0x1234ABCD);
-
-#if defined(LV_DRAW_SW_SHADOW_CACHE_SIZE) && LV_DRAW_SW_SHADOW_CACHE_SIZE > 0
-    global->sw_shadow_cache.cache_size = -1;
-    global->sw_shadow_cache.cache_r = -1;
-#endif
 }
 
 static inline void _lv_cleanup_devices(lv_global_t * global)
@@ -192,6 +188,8 @@ void lv_init(void)
     lv_windows_platform_init();
 #endif
 
+    _lv_obj_core_init();
+
     _lv_obj_style_init();
 
     /*Initialize the screen refresh system*/
@@ -304,6 +302,10 @@ void lv_init(void)
     lv_tiny_ttf_init();
 #endif
 
+#if LV_USE_FONT_COMPRESSED
+    _lv_font_fmt_txt_cache_init();
+#endif
+
     lv_initialized = true;
 
     LV_LOG_TRACE("finished");
@@ -345,6 +347,10 @@ void lv_deinit(void)
     lv_tiny_ttf_deinit();
 #endif
 
+#if LV_USE_FONT_COMPRESSED
+    _lv_font_fmt_txt_cache_deinit();
+#endif
+
 #if LV_USE_THEME_DEFAULT
     lv_theme_default_deinit();
 #endif
@@ -363,6 +369,8 @@ void lv_deinit(void)
 
     _lv_obj_style_deinit();
 
+    _lv_obj_core_deinit();
+
 #if LV_USE_DRAW_PXP
     lv_draw_pxp_deinit();
 #endif
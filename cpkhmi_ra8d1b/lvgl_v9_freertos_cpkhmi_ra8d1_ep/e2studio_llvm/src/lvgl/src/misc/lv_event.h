@@ -116,7 +116,17 @@ typedef enum {
                                       before the class default event processing */
 } lv_event_code_t;
 
-typedef lv_array_t lv_event_list_t;
+/**
+ * The event descriptors of an object, display or input device.
+ * Each bit of the masks tells if there might be a descriptor for an event code
+ * (the last bit stands for the codes above it, e.g. the registered custom events),
+ * so events without a callback can be skipped without walking the array.
+ */
+typedef struct {
+    lv_array_t array;
+    uint64_t code_mask;             /**< Codes of the callbacks called after the class' event handler*/
+    uint64_t preprocess_code_mask;  /**< Codes of the callbacks added with `LV_EVENT_PREPROCESS`*/
+} lv_event_list_t;
 
 struct _lv_event_t {
     void * current_target;
@@ -160,6 +170,14 @@ bool lv_event_remove(lv_event_list_t * list, uint32_t index);
 
 void lv_event_remove_all(lv_event_list_t * list);
 
+/**
+ * Check if an event code would call any of the callbacks of a list
+ * @param list      pointer to an event list
+ * @param code      the event code to check (without `LV_EVENT_PREPROCESS`)
+ * @return          true: there is a callback for `code` or for all events
+ */
+bool lv_event_list_has_code(const lv_event_list_t * list, lv_event_code_t code);
+
 /**
  * Get the object originally targeted by the event. It's the same even if the event is bubbled.
  * @param e     pointer to the event descriptor
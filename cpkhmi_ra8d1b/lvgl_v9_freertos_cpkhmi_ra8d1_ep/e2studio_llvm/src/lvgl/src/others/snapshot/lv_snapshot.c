@@ -130,9 +130,11 @@ lv_result_t lv_snapshot_take_to_buf(lv_obj_t * obj, lv_color_format_t cf, lv_ima
     _lv_refr_set_disp_refreshing(disp_new);
     lv_obj_redraw(&layer, obj);
 
+    /*Dispatch the whole display as the layers created while drawing (e.g. for transformed
+     *widgets) are added after `layer` and need to be dispatched and freed too.*/
     while(layer.draw_task_head) {
         lv_draw_dispatch_wait_for_request();
-        lv_draw_dispatch_layer(NULL, &layer);
+        lv_draw_dispatch();
     }
 
     disp_new->layer_head = layer_old;
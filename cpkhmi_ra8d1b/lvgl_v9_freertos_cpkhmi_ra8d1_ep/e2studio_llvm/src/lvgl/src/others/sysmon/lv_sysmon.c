@@ -153,6 +153,12 @@ static void perf_update_timer_cb(lv_timer_t * t)
     lv_sysmon_perf_info_t * info = lv_timer_get_user_data(t);
     info->calculated.run_cnt++;
 
+    /*The layout time is measured by the core, not by display events*/
+    info->measured.layout_elaps_sum = LV_GLOBAL_DEFAULT()->layout_elaps_sum;
+    info->measured.layout_cnt = LV_GLOBAL_DEFAULT()->layout_cnt;
+    LV_GLOBAL_DEFAULT()->layout_elaps_sum = 0;
+    LV_GLOBAL_DEFAULT()->layout_cnt = 0;
+
     info->calculated.fps = info->measured.refr_interval_sum ? (1000 * info->measured.refr_cnt /
                                                                info->measured.refr_interval_sum) : 0;
     info->calculated.cpu = 100 - LV_SYSMON_GET_IDLE();
@@ -164,6 +170,8 @@ static void perf_update_timer_cb(lv_timer_t * t)
     info->calculated.render_avg_time = info->measured.render_cnt ? ((info->measured.render_elaps_sum -
                                                                      info->measured.flush_elaps_sum) /
                                                                     info->measured.render_cnt) : 0;
+    info->calculated.layout_avg_time = info->measured.layout_cnt ? (info->measured.layout_elaps_sum /
+                                                                    info->measured.layout_cnt) : 0;
 
     info->calculated.cpu_avg_total = ((info->calculated.cpu_avg_total * (info->calculated.run_cnt - 1)) +
                                       info->calculated.cpu) / info->calculated.run_cnt;
@@ -190,9 +198,11 @@ static void perf_observer_cb(lv_observer_t * observer, lv_subject_t * subject)
     LV_LOG("sysmon: "
            "%" LV_PRIu32 " FPS (refr_cnt: %" LV_PRIu32 " | redraw_cnt: %" LV_PRIu32 " | flush_cnt: %" LV_PRIu32 "), "
            "refr %" LV_PRIu32 "ms (render %" LV_PRIu32 "ms | flush %" LV_PRIu32 "ms), "
+           "layout %" LV_PRIu32 "ms (layout_cnt: %" LV_PRIu32 "), "
            "CPU %" LV_PRIu32 "%%\n",
            perf->calculated.fps, perf->measured.refr_cnt, perf->measured.render_cnt, perf->measured.flush_cnt,
-           perf->calculated.refr_avg_time, perf->calculated.render_real_avg_time, perf->calculated.flush_avg_time,
+           perf->calculated.refr_avg_time, perf->calculated.render_avg_time, perf->calculated.flush_avg_time,
+           perf->calculated.layout_avg_time, perf->measured.layout_cnt,
            perf->calculated.cpu);
 #else
     lv_label_set_text_fmt(
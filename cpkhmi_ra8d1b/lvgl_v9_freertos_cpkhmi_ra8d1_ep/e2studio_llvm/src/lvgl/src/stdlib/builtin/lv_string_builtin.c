@@ -13,6 +13,14 @@
 #include "../../stdlib/lv_string.h"
 #include "../../stdlib/lv_mem.h"
 
+#if LV_USE_DRAW_SW_ASM == LV_DRAW_SW_ASM_HELIUM
+    #include "lv_string_builtin_mve.h"
+#endif
+
+#ifdef LV_STRING_OFFLOAD_INCLUDE
+    #include LV_STRING_OFFLOAD_INCLUDE
+#endif
+
 /*********************
  *      DEFINES
  *********************/
@@ -69,26 +77,16 @@ LV_ATTRIBUTE_FAST_MEM void * lv_memcpy(void * dst, const void * src, size_t len)
         return dst;
     }
 
-    lv_uintptr_t d_align = (lv_uintptr_t)d8 & ALIGN_MASK;
-    lv_uintptr_t s_align = (lv_uintptr_t)s8 & ALIGN_MASK;
-
-    /*Byte copy for unaligned memories*/
-    if(s_align != d_align) {
-        while(len > 32) {
-            _REPEAT8(_COPY(d8, s8));
-            _REPEAT8(_COPY(d8, s8));
-            _REPEAT8(_COPY(d8, s8));
-            _REPEAT8(_COPY(d8, s8));
-            len -= 32;
-        }
-        while(len) {
-            _COPY(d8, s8)
-            len--;
-        }
-        return dst;
-    }
+#if LV_STRING_OFFLOAD_SIZE
+    if(len >= LV_STRING_OFFLOAD_SIZE && LV_STRING_OFFLOAD_MEMCPY(dst, src, len)) return dst;
+#endif
 
-    /*Make the memories aligned*/
+#ifdef LV_STRING_MEMCPY
+    LV_STRING_MEMCPY(d8, s8, len);
+    return dst;
+#else
+    /*Make the destination aligned*/
+    lv_uintptr_t d_align = (lv_uintptr_t)d8 & ALIGN_MASK;
     if(d_align) {
         d_align = ALIGN_MASK + 1 - d_align;
         while(d_align && len) {
@@ -99,25 +97,56 @@ LV_ATTRIBUTE_FAST_MEM void * lv_memcpy(void * dst, const void * src, size_t len)
     }
 
     uint32_t * d32 = (uint32_t *)d8;
-    const uint32_t * s32 = (uint32_t *)s8;
-    while(len > 32) {
-        _REPEAT8(_COPY(d32, s32))
-        len -= 32;
+    lv_uintptr_t s_align = (lv_uintptr_t)s8 & 0x3;
+    if(s_align == 0) {
+        const uint32_t * s32 = (const uint32_t *)s8;
+        while(len > 32) {
+            _REPEAT8(_COPY(d32, s32))
+            len -= 32;
+        }
+        s8 = (const uint8_t *)s32;
+    }
+    else {
+        /*Read aligned words from the source and shift them together.
+         *Stop before the last word as it might be out of the source.*/
+        const uint32_t * s32 = (const uint32_t *)(s8 - s_align);
+        uint32_t shift = s_align * 8;
+        uint32_t w_prev = *s32++;
+        while(len >= 8) {
+            uint32_t w = *s32++;
+#if LV_BIG_ENDIAN_SYSTEM
+            *d32 = (w_prev << shift) | (w >> (32 - shift));
+#else
+            *d32 = (w_prev >> shift) | (w << (32 - shift));
+#endif
+            d32++;
+            w_prev = w;
+            len -= 4;
+        }
+        s8 = (const uint8_t *)s32 - 4 + s_align;
     }
 
     d8 = (uint8_t *)d32;
-    s8 = (const uint8_t *)s32;
     while(len) {
         _COPY(d8, s8)
         len--;
     }
 
     return dst;
+#endif
 }
 
 LV_ATTRIBUTE_FAST_MEM void lv_memset(void * dst, uint8_t v, size_t len)
 {
     uint8_t * d8 = (uint8_t *)dst;
+
+#if LV_STRING_OFFLOAD_SIZE
+    if(len >= LV_STRING_OFFLOAD_SIZE && LV_STRING_OFFLOAD_MEMSET(dst, v, len)) return;
+#endif
+
+#ifdef LV_STRING_MEMSET
+    LV_STRING_MEMSET(d8, v, len);
+#else
     uintptr_t d_align = (lv_uintptr_t) d8 & ALIGN_MASK;
 
     /*Make the address aligned*/
@@ -143,6 +172,7 @@ LV_ATTRIBUTE_FAST_MEM void lv_memset(void * dst, uint8_t v, size_t len)
         _SET(d8, v);
         len--;
     }
+#endif
 }
 
 LV_ATTRIBUTE_FAST_MEM void * lv_memmove(void * dst, const void * src, size_t len)
@@ -0,0 +1,134 @@
+/**
+ * @file lv_mem_slab.h
+ *
+ */
+
+#ifndef LV_MEM_SLAB_H
+#define LV_MEM_SLAB_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*********************
+ *      INCLUDES
+ *********************/
+#include "../lv_conf_internal.h"
+
+#include <stdint.h>
+#include <stddef.h>
+#include <stdbool.h>
+
+/*********************
+ *      DEFINES
+ *********************/
+
+/**********************
+ *      TYPEDEFS
+ **********************/
+
+/**
+ * A slab allocates blocks of the same size from larger chunks allocated on the heap.
+ * Allocations larger than the block size are passed to the heap.
+ * Every allocation is preceded by a pointer to its chunk (NULL for the heap),
+ * so freeing doesn't need to search the chunks.
+ * It's not thread safe, so it's meant to be used only from the LVGL thread.
+ */
+typedef struct _lv_mem_slab_t {
+    struct _lv_mem_slab_t * next;   /**< The next slab in the list of all slabs*/
+    const char * name;              /**< Name of the type allocated in the slab*/
+    void * free_head;               /**< Linked list of the free blocks*/
+    void * chunk_head;              /**< Linked list of the chunks*/
+    uint32_t block_size;            /**< Size of a block in bytes*/
+    uint32_t block_cnt;             /**< Number of blocks in a chunk*/
+    uint32_t chunk_cnt;             /**< Number of the allocated chunks*/
+    uint32_t used_cnt;              /**< Number of blocks in use*/
+    uint32_t max_used_cnt;          /**< Max number of blocks used at the same time*/
+    uint32_t alloc_cnt;             /**< Number of allocations served from the blocks*/
+    uint32_t heap_alloc_cnt;        /**< Number of allocations passed to the heap*/
+} lv_mem_slab_t;
+
+/**********************
+ * GLOBAL PROTOTYPES
+ **********************/
+
+/**
+ * Initialize a slab and add it to the list of slabs
+ * @param slab          pointer to a slab
+ * @param name          name of the type allocated in the slab. Only the pointer is saved.
+ * @param block_size    size of a block in bytes
+ * @param block_cnt     number of blocks to allocate at once
+ */
+void lv_mem_slab_init(lv_mem_slab_t * slab, const char * name, uint32_t block_size, uint32_t block_cnt);
+
+/**
+ * Free all chunks of a slab and remove it from the list of slabs.
+ * The blocks still in use become invalid.
+ * @param slab          pointer to a slab
+ */
+void lv_mem_slab_deinit(lv_mem_slab_t * slab);
+
+/**
+ * Allocate memory from a slab
+ * @param slab          pointer to a slab
+ * @param size          requested size in bytes. If larger than the block size the heap is used.
+ * @return              pointer to the allocated uninitialized memory, or NULL on failure
+ */
+void * lv_mem_slab_alloc(lv_mem_slab_t * slab, size_t size);
+
+/**
+ * Allocate zeroed memory from a slab
+ * @param slab          pointer to a slab
+ * @param size          requested size in bytes. If larger than the block size the heap is used.
+ * @return              pointer to the allocated zeroed memory, or NULL on failure
+ */
+void * lv_mem_slab_alloc_zeroed(lv_mem_slab_t * slab, size_t size);
+
+/**
+ * Reallocate a memory allocated from a slab
+ * @param slab          pointer to a slab
+ * @param data          pointer to a memory allocated from `slab` or NULL
+ * @param new_size      the new size in bytes. 0 frees `data`.
+ * @return              pointer to the new memory, or NULL on failure or if `new_size` is 0
+ */
+void * lv_mem_slab_realloc(lv_mem_slab_t * slab, void * data, size_t new_size);
+
+/**
+ * Free a memory allocated from a slab
+ * @param slab          pointer to a slab
+ * @param data          pointer to a memory allocated from `slab`. NULL is ignored.
+ */
+void lv_mem_slab_free(lv_mem_slab_t * slab, void * data);
+
+/**
+ * Free the chunks of a slab which have no used blocks
+ * @param slab          pointer to a slab
+ * @return              number of freed bytes (without the allocator's overhead)
+ */
+uint32_t lv_mem_slab_trim(lv_mem_slab_t * slab);
+
+/**
+ * Free the chunks of all slabs which have no used blocks.
+ * The slabs never free their chunks on their own (except when a new chunk can't be allocated),
+ * so call it when the memory is needed elsewhere, e.g. after deleting a screen.
+ * Not thread safe, call it from the LVGL thread.
+ * @return              number of freed bytes (without the allocator's overhead)
+ */
+uint32_t lv_mem_slab_trim_all(void);
+
+/**
+ * Iterate through the slabs, e.g. to print their statistics
+ * @param slab          pointer to the current slab or NULL to get the first one
+ * @return              the next slab or NULL if there are no more
+ */
+lv_mem_slab_t * lv_mem_slab_get_next(const lv_mem_slab_t * slab);
+
+/**********************
+ *      MACROS
+ **********************/
+
+#ifdef __cplusplus
+} /*extern "C"*/
+#endif
+
+#endif /*LV_MEM_SLAB_H*/
@@ -11,6 +11,10 @@
 
 #include "../../misc/lv_assert.h"
 
+#if LV_USE_DRAW_SW_ASM == LV_DRAW_SW_ASM_HELIUM
+    #include "lv_chart_mve.h"
+#endif
+
 /*********************
  *      DEFINES
  *********************/
@@ -34,11 +38,19 @@ static void lv_chart_event(const lv_obj_class_t * class_p, lv_event_t * e);
 
 static void draw_div_lines(lv_obj_t * obj, lv_layer_t * layer);
 static void draw_series_line(lv_obj_t * obj, lv_layer_t * layer);
+static void draw_series_line_crowded(lv_obj_t * obj, lv_layer_t * layer, lv_chart_series_t * ser,
+                                     lv_draw_line_dsc_t * line_dsc);
 static void draw_series_bar(lv_obj_t * obj, lv_layer_t * layer);
 static void draw_series_scatter(lv_obj_t * obj, lv_layer_t * layer);
 static void draw_cursors(lv_obj_t * obj, lv_layer_t * layer);
 static uint32_t get_index_from_x(lv_obj_t * obj, int32_t x);
 static void invalidate_point(lv_obj_t * obj, uint32_t i);
+static void invalidate_points(lv_obj_t * obj, uint32_t first, uint32_t cnt);
+static void get_point_inv_area(lv_obj_t * obj, uint32_t i, lv_area_t * area);
+static bool get_min_max(lv_chart_t * chart, lv_chart_series_t * ser, uint32_t first, uint32_t last, int32_t * min,
+                        int32_t * max);
+static void stream_timer_cb(lv_timer_t * t);
+static void stream_timer_update(lv_obj_t * obj);
 static void new_points_alloc(lv_obj_t * obj, lv_chart_series_t * ser, uint32_t cnt, int32_t ** a);
 
 /**********************
@@ -317,7 +329,9 @@ lv_chart_series_t * lv_chart_add_series(lv_obj_t * obj, lv_color_t color, lv_cha
     /* Set series properties on successful allocation */
     ser->color = color;
     ser->start_point = 0;
+    ser->stream = NULL;
     ser->y_ext_buf_assigned = false;
+    ser->x_ext_buf_assigned = false;
     ser->hidden = 0;
     ser->x_axis_sec = axis & LV_CHART_AXIS_SECONDARY_X ? 1 : 0;
     ser->y_axis_sec = axis & LV_CHART_AXIS_SECONDARY_Y ? 1 : 0;
@@ -345,6 +359,8 @@ void lv_chart_remove_series(lv_obj_t * obj, lv_chart_series_t * series)
     _lv_ll_remove(&chart->series_ll, series);
     lv_free(series);
 
+    stream_timer_update(obj);
+
     return;
 }
 
@@ -467,6 +483,35 @@ void lv_chart_set_next_value(lv_obj_t * obj, lv_chart_series_t * ser, int32_t va
     invalidate_point(obj, ser->start_point);
 }
 
+void lv_chart_set_next_values(lv_obj_t * obj, lv_chart_series_t * ser, const int32_t values[], uint32_t cnt)
+{
+    LV_ASSERT_OBJ(obj, MY_CLASS);
+    LV_ASSERT_NULL(ser);
+
+    lv_chart_t * chart  = (lv_chart_t *)obj;
+    if(cnt == 0) return;
+
+    /*The older values would be overwritten anyway*/
+    if(cnt > chart->point_cnt) {
+        uint32_t skip = cnt - chart->point_cnt;
+        ser->start_point = (ser->start_point + skip) % chart->point_cnt;
+        values += skip;
+        cnt = chart->point_cnt;
+    }
+
+    uint32_t first = ser->start_point;
+    uint32_t copied = 0;
+    while(copied < cnt) {
+        uint32_t len = LV_MIN(cnt - copied, chart->point_cnt - ser->start_point);
+        lv_memcpy(&ser->y_points[ser->start_point], &values[copied], len * sizeof(int32_t));
+        copied += len;
+        ser->start_point = (ser->start_point + len) % chart->point_cnt;
+    }
+
+    /*The new points and the next one as it's the gap in circular mode*/
+    invalidate_points(obj, first, cnt + 1);
+}
+
 void lv_chart_set_next_value2(lv_obj_t * obj, lv_chart_series_t * ser, int32_t x_value, int32_t y_value)
 {
     LV_ASSERT_OBJ(obj, MY_CLASS);
@@ -536,6 +581,51 @@ void lv_chart_set_ext_x_array(lv_obj_t * obj, lv_chart_series_t * ser, int32_t a
     lv_obj_invalidate(obj);
 }
 
+void lv_chart_stream_init(lv_chart_stream_t * stream, int32_t buf[], uint32_t size)
+{
+    LV_ASSERT_NULL(stream);
+    LV_ASSERT_NULL(buf);
+    LV_ASSERT(size > 0);
+
+    stream->buf = buf;
+    stream->size = size;
+    stream->head = 0;
+    stream->tail = 0;
+}
+
+uint32_t lv_chart_stream_push(lv_chart_stream_t * stream, const int32_t values[], uint32_t cnt)
+{
+    /*Write the samples through a volatile pointer so that they are stored before `head` is updated*/
+    volatile int32_t * buf = stream->buf;
+    uint32_t head = stream->head;
+    uint32_t free_cnt = (stream->tail + stream->size - head - 1) % stream->size;
+    if(cnt > free_cnt) cnt = free_cnt;
+
+    uint32_t i;
+    for(i = 0; i < cnt; i++) {
+        buf[head] = values[i];
+        head++;
+        if(head == stream->size) head = 0;
+    }
+
+    stream->head = head;
+    return cnt;
+}
+
+void lv_chart_set_series_stream(lv_obj_t * obj, lv_chart_series_t * ser, lv_chart_stream_t * stream)
+{
+    LV_ASSERT_OBJ(obj, MY_CLASS);
+    LV_ASSERT_NULL(ser);
+
+    if(stream && stream->size == 0) {
+        LV_LOG_WARN("The stream has no buffer");
+        return;
+    }
+
+    ser->stream = stream;
+    stream_timer_update(obj);
+}
+
 int32_t * lv_chart_get_y_array(const lv_obj_t * obj, lv_chart_series_t * ser)
 {
     LV_UNUSED(obj);
@@ -605,6 +695,7 @@ static void lv_chart_constructor(const lv_obj_class_t * class_p, lv_obj_t * obj)
     chart->pressed_point_id  = LV_CHART_POINT_NONE;
     chart->type        = LV_CHART_TYPE_LINE;
     chart->update_mode = LV_CHART_UPDATE_MODE_SHIFT;
+    chart->stream_timer = NULL;
 
     LV_TRACE_OBJ_CREATE("finished");
 }
@@ -615,6 +706,8 @@ static void lv_chart_destructor(const lv_obj_class_t * class_p, lv_obj_t * obj)
     LV_TRACE_OBJ_CREATE("begin");
 
     lv_chart_t * chart = (lv_chart_t *)obj;
+    if(chart->stream_timer) lv_timer_delete(chart->stream_timer);
+
     lv_chart_series_t * ser;
     while(chart->series_ll.head) {
         ser = _lv_ll_get_head(&chart->series_ll);
@@ -812,6 +905,11 @@ static void draw_series_line(lv_obj_t * obj, lv_layer_t * layer)
         line_dsc.base.id2 = 0;
         point_dsc_default.base.id2 = 0;
 
+        if(crowded_mode) {
+            draw_series_line_crowded(obj, layer, ser, &line_dsc);
+            continue;
+        }
+
         int32_t start_point = chart->update_mode == LV_CHART_UPDATE_MODE_SHIFT ? ser->start_point : 0;
 
         line_dsc.p1.x = x_ofs;
@@ -823,9 +921,6 @@ static void draw_series_line(lv_obj_t * obj, lv_layer_t * layer)
         y_tmp  = y_tmp / (chart->ymax[ser->y_axis_sec] - chart->ymin[ser->y_axis_sec]);
         line_dsc.p2.y   = h - y_tmp + y_ofs;
 
-        lv_value_precise_t y_min = line_dsc.p2.y;
-        lv_value_precise_t y_max = line_dsc.p2.y;
-
         for(i = 0; i < chart->point_cnt; i++) {
             line_dsc.p1.x = line_dsc.p2.x;
             line_dsc.p1.y = line_dsc.p2.y;
@@ -846,49 +941,27 @@ static void draw_series_line(lv_obj_t * obj, lv_layer_t * layer)
 
             /*Don't draw the first point. A second point is also required to draw the line*/
             if(i != 0) {
-                if(crowded_mode) {
-                    if(ser->y_points[p_prev] != LV_CHART_POINT_NONE && ser->y_points[p_act] != LV_CHART_POINT_NONE) {
-                        /*Draw only one vertical line between the min and max y-values on the same x-value*/
-                        y_max = LV_MAX(y_max, line_dsc.p2.y);
-                        y_min = LV_MIN(y_min, line_dsc.p2.y);
-                        if(line_dsc.p1.x != line_dsc.p2.x) {
-                            lv_value_precise_t y_cur = line_dsc.p2.y;
-                            line_dsc.p2.x--;         /*It's already on the next x value*/
-                            line_dsc.p1.x = line_dsc.p2.x;
-                            line_dsc.p1.y = y_min;
-                            line_dsc.p2.y = y_max;
-                            if(line_dsc.p1.y == line_dsc.p2.y) line_dsc.p2.y++;    /*If they are the same no line will be drawn*/
-                            lv_draw_line(layer, &line_dsc);
-                            line_dsc.p2.x++;         /*Compensate the previous x--*/
-                            y_min = y_cur;  /*Start the line of the next x from the current last y*/
-                            y_max = y_cur;
-                        }
-                    }
-                }
-                else {
-                    lv_area_t point_area;
-                    point_area.x1 = (int32_t)line_dsc.p1.x - point_w;
-                    point_area.x2 = (int32_t)line_dsc.p1.x + point_w;
-                    point_area.y1 = (int32_t)line_dsc.p1.y - point_h;
-                    point_area.y2 = (int32_t)line_dsc.p1.y + point_h;
-
-                    if(ser->y_points[p_prev] != LV_CHART_POINT_NONE && ser->y_points[p_act] != LV_CHART_POINT_NONE) {
-                        line_dsc.base.id2 = i;
-                        lv_draw_line(layer, &line_dsc);
-                    }
+                lv_area_t point_area;
+                point_area.x1 = (int32_t)line_dsc.p1.x - point_w;
+                point_area.x2 = (int32_t)line_dsc.p1.x + point_w;
+                point_area.y1 = (int32_t)line_dsc.p1.y - point_h;
+                point_area.y2 = (int32_t)line_dsc.p1.y + point_h;
 
-                    if(point_w && point_h && ser->y_points[p_prev] != LV_CHART_POINT_NONE) {
-                        point_dsc_default.base.id2 = i - 1;
-                        lv_draw_rect(layer, &point_dsc_default, &point_area);
-                    }
+                if(ser->y_points[p_prev] != LV_CHART_POINT_NONE && ser->y_points[p_act] != LV_CHART_POINT_NONE) {
+                    line_dsc.base.id2 = i;
+                    lv_draw_line(layer, &line_dsc);
                 }
 
+                if(point_w && point_h && ser->y_points[p_prev] != LV_CHART_POINT_NONE) {
+                    point_dsc_default.base.id2 = i - 1;
+                    lv_draw_rect(layer, &point_dsc_default, &point_area);
+                }
             }
             p_prev = p_act;
         }
 
         /*Draw the last point*/
-        if(!crowded_mode && i == chart->point_cnt) {
+        if(i == chart->point_cnt) {
 
             if(ser->y_points[p_act] != LV_CHART_POINT_NONE) {
                 lv_area_t point_area;
@@ -908,6 +981,52 @@ static void draw_series_line(lv_obj_t * obj, lv_layer_t * layer)
     layer->_clip_area = clip_area_ori;
 }
 
+/**
+ * Draw a series which has more points than the width of the chart.
+ * Only one vertical line is drawn in each pixel column between the smallest and largest value of the points there,
+ * so the drawing cost depends on the width of the chart and not on the number of points.
+ */
+static void draw_series_line_crowded(lv_obj_t * obj, lv_layer_t * layer, lv_chart_series_t * ser,
+                                     lv_draw_line_dsc_t * line_dsc)
+{
+    lv_chart_t * chart  = (lv_chart_t *)obj;
+    int32_t border_width = lv_obj_get_style_border_width(obj, LV_PART_MAIN);
+    int32_t w     = lv_obj_get_content_width(obj);
+    int32_t h     = lv_obj_get_content_height(obj);
+    int32_t x_ofs = obj->coords.x1 + lv_obj_get_style_pad_left(obj, LV_PART_MAIN) + border_width -
+                    lv_obj_get_scroll_left(obj);
+    int32_t y_ofs = obj->coords.y1 + lv_obj_get_style_pad_top(obj, LV_PART_MAIN) + border_width -
+                    lv_obj_get_scroll_top(obj);
+    int32_t ymin = chart->ymin[ser->y_axis_sec];
+    int32_t yrange = chart->ymax[ser->y_axis_sec] - ymin;
+    uint32_t last_id = chart->point_cnt - 1;
+
+    /*Only the columns in the clip area. The last point is on the right edge, it's drawn in the last column.*/
+    int32_t x_start = LV_MAX(layer->_clip_area.x1 - line_dsc->width - x_ofs, 0);
+    int32_t x_end = LV_MIN(layer->_clip_area.x2 + line_dsc->width - x_ofs, w - 1);
+
+    int32_t x;
+    for(x = x_start; x <= x_end; x++) {
+        /*The points in this column and the first point of the next column to connect them*/
+        uint32_t first = ((uint32_t)x * last_id + w - 1) / w;
+        uint32_t last = ((uint32_t)(x + 1) * last_id + w - 1) / w;
+        if(first > last_id) break;
+        if(last > last_id) last = last_id;
+
+        int32_t min;
+        int32_t max;
+        if(!get_min_max(chart, ser, first, last, &min, &max)) continue;
+
+        line_dsc->p1.x = x + x_ofs;
+        line_dsc->p2.x = line_dsc->p1.x;
+        line_dsc->p1.y = h - ((max - ymin) * h) / yrange + y_ofs;
+        line_dsc->p2.y = h - ((min - ymin) * h) / yrange + y_ofs;
+        if(line_dsc->p1.y == line_dsc->p2.y) line_dsc->p2.y++;    /*If they are the same no line will be drawn*/
+        line_dsc->base.id2 = first;
+        lv_draw_line(layer, line_dsc);
+    }
+}
+
 static void draw_series_scatter(lv_obj_t * obj, lv_layer_t * layer)
 {
 
@@ -1226,41 +1345,65 @@ static void invalidate_point(lv_obj_t * obj, uint32_t i)
     lv_chart_t * chart  = (lv_chart_t *)obj;
     if(i >= chart->point_cnt) return;
 
-    int32_t w  = lv_obj_get_content_width(obj);
-    int32_t scroll_left = lv_obj_get_scroll_left(obj);
+    invalidate_points(obj, i, 1);
+}
+
+/**
+ * Invalidate the points from `first` (wrapping around at the end of the series)
+ * @param obj       pointer to a chart
+ * @param first     index of the first point
+ * @param cnt       number of points
+ */
+static void invalidate_points(lv_obj_t * obj, uint32_t first, uint32_t cnt)
+{
+    lv_chart_t * chart  = (lv_chart_t *)obj;
 
     /*In shift mode the whole chart changes so the whole object*/
-    if(chart->update_mode == LV_CHART_UPDATE_MODE_SHIFT) {
+    if(chart->update_mode == LV_CHART_UPDATE_MODE_SHIFT || cnt >= chart->point_cnt) {
         lv_obj_invalidate(obj);
         return;
     }
 
-    if(chart->type == LV_CHART_TYPE_LINE) {
+    if(first + cnt > chart->point_cnt) {
+        invalidate_points(obj, 0, first + cnt - chart->point_cnt);
+        cnt = chart->point_cnt - first;
+    }
+
+    lv_area_t a;
+    lv_area_t a_last;
+    get_point_inv_area(obj, first, &a);
+    get_point_inv_area(obj, first + cnt - 1, &a_last);
+    _lv_area_join(&a, &a, &a_last);
+    lv_obj_invalidate_area(obj, &a);
+}
+
+/*Get the area which needs to be redrawn if point `i` changes*/
+static void get_point_inv_area(lv_obj_t * obj, uint32_t i, lv_area_t * area)
+{
+    lv_chart_t * chart  = (lv_chart_t *)obj;
+
+    int32_t w  = lv_obj_get_content_width(obj);
+    int32_t scroll_left = lv_obj_get_scroll_left(obj);
+
+    lv_area_copy(area, &obj->coords);
+
+    if(chart->type == LV_CHART_TYPE_LINE && chart->point_cnt > 1) {
         int32_t bwidth = lv_obj_get_style_border_width(obj, LV_PART_MAIN);
         int32_t pleft = lv_obj_get_style_pad_left(obj, LV_PART_MAIN);
         int32_t x_ofs = obj->coords.x1 + pleft + bwidth - scroll_left;
         int32_t line_width = lv_obj_get_style_line_width(obj, LV_PART_ITEMS);
         int32_t point_w = lv_obj_get_style_width(obj, LV_PART_INDICATOR);
 
-        lv_area_t coords;
-        lv_area_copy(&coords, &obj->coords);
-        coords.y1 -= line_width + point_w;
-        coords.y2 += line_width + point_w;
+        area->y1 -= line_width + point_w;
+        area->y2 += line_width + point_w;
 
-        if(i < chart->point_cnt - 1) {
-            coords.x1 = ((w * i) / (chart->point_cnt - 1)) + x_ofs - line_width - point_w;
-            coords.x2 = ((w * (i + 1)) / (chart->point_cnt - 1)) + x_ofs + line_width + point_w;
-            lv_obj_invalidate_area(obj, &coords);
-        }
-
-        if(i > 0) {
-            coords.x1 = ((w * (i - 1)) / (chart->point_cnt - 1)) + x_ofs - line_width - point_w;
-            coords.x2 = ((w * i) / (chart->point_cnt - 1)) + x_ofs + line_width + point_w;
-            lv_obj_invalidate_area(obj, &coords);
-        }
+        /*The lines to the previous and next points*/
+        uint32_t prev = i > 0 ? i - 1 : i;
+        uint32_t next = i < chart->point_cnt - 1 ? i + 1 : i;
+        area->x1 = ((w * prev) / (chart->point_cnt - 1)) + x_ofs - line_width - point_w;
+        area->x2 = ((w * next) / (chart->point_cnt - 1)) + x_ofs + line_width + point_w;
     }
     else if(chart->type == LV_CHART_TYPE_BAR) {
-        lv_area_t col_a;
         /*Gap between the column on ~adjacent X*/
         int32_t block_gap = lv_obj_get_style_pad_column(obj, LV_PART_MAIN);
 
@@ -1271,15 +1414,98 @@ static void invalidate_point(lv_obj_t * obj, uint32_t i)
         x_act = (int32_t)((int32_t)(block_w) * i) ;
         x_act += obj->coords.x1 + bwidth + lv_obj_get_style_pad_left(obj, LV_PART_MAIN);
 
-        lv_obj_get_coords(obj, &col_a);
-        col_a.x1 = x_act - scroll_left;
-        col_a.x2 = col_a.x1 + block_w;
-        col_a.x1 -= block_gap;
+        area->x1 = x_act - scroll_left;
+        area->x2 = area->x1 + block_w;
+        area->x1 -= block_gap;
+    }
+}
 
-        lv_obj_invalidate_area(obj, &col_a);
+/**
+ * Get the smallest and largest value of the points from `first` to `last` (inclusive) in drawing order
+ * @param chart     pointer to a chart
+ * @param ser       pointer to a series
+ * @param first     the first point to check
+ * @param last      the last point to check
+ * @param min       store the smallest value here
+ * @param max       store the largest value here
+ * @return          false if all points are `LV_CHART_POINT_NONE`
+ */
+static bool get_min_max(lv_chart_t * chart, lv_chart_series_t * ser, uint32_t first, uint32_t last, int32_t * min,
+                        int32_t * max)
+{
+    uint32_t start_point = chart->update_mode == LV_CHART_UPDATE_MODE_SHIFT ? ser->start_point : 0;
+    uint32_t id = (start_point + first) % chart->point_cnt;
+    uint32_t cnt = last - first + 1;
+
+    *min = INT32_MAX;
+    *max = INT32_MIN;
+
+    /*The points can wrap around at the end of the array*/
+    while(cnt) {
+        uint32_t len = LV_MIN(cnt, chart->point_cnt - id);
+        const int32_t * values = &ser->y_points[id];
+#ifdef LV_CHART_MIN_MAX
+        LV_CHART_MIN_MAX(values, len, LV_CHART_POINT_NONE, min, max);
+#else
+        uint32_t i;
+        for(i = 0; i < len; i++) {
+            if(values[i] == LV_CHART_POINT_NONE) continue;
+            if(values[i] < *min) *min = values[i];
+            if(values[i] > *max) *max = values[i];
+        }
+#endif
+        cnt -= len;
+        id = 0;
     }
-    else {
-        lv_obj_invalidate(obj);
+
+    return *min <= *max;
+}
+
+static void stream_timer_cb(lv_timer_t * t)
+{
+    lv_obj_t * obj = lv_timer_get_user_data(t);
+    lv_chart_t * chart  = (lv_chart_t *)obj;
+
+    lv_chart_series_t * ser;
+    _LV_LL_READ(&chart->series_ll, ser) {
+        lv_chart_stream_t * stream = ser->stream;
+        if(stream == NULL) continue;
+
+        uint32_t head = stream->head;
+        uint32_t tail = stream->tail;
+        if(head < tail) {
+            lv_chart_set_next_values(obj, ser, &stream->buf[tail], stream->size - tail);
+            tail = 0;
+        }
+
+        lv_chart_set_next_values(obj, ser, &stream->buf[tail], head - tail);
+        stream->tail = head;
+    }
+}
+
+/**
+ * Create the stream timer when the first stream is attached and delete it when the last is detached
+ * @param obj       pointer to a chart object
+ */
+static void stream_timer_update(lv_obj_t * obj)
+{
+    lv_chart_t * chart  = (lv_chart_t *)obj;
+
+    bool has_stream = false;
+    lv_chart_series_t * ser;
+    _LV_LL_READ(&chart->series_ll, ser) {
+        if(ser->stream) {
+            has_stream = true;
+            break;
+        }
+    }
+
+    if(has_stream && chart->stream_timer == NULL) {
+        chart->stream_timer = lv_timer_create(stream_timer_cb, LV_DEF_REFR_PERIOD, obj);
+    }
+    else if(!has_stream && chart->stream_timer) {
+        lv_timer_delete(chart->stream_timer);
+        chart->stream_timer = NULL;
     }
 }
 
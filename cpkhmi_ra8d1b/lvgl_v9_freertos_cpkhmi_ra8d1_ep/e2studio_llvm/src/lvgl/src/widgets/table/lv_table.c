@@ -44,12 +44,24 @@ static size_t get_cell_txt_len(const char * txt);
 static void copy_cell_txt(lv_table_cell_t * dst, const char * txt);
 static void get_cell_area(lv_obj_t * obj, uint32_t row, uint32_t col, lv_area_t * area);
 static void scroll_to_selected_cell(lv_obj_t * obj);
+static void free_cells(lv_obj_t * obj);
+static void row_h_sum_build(lv_table_t * table);
+static void row_h_sum_add(lv_table_t * table, uint32_t row, int32_t diff);
+static int32_t get_row_y(lv_table_t * table, uint32_t row);
+static int32_t get_row_h(lv_table_t * table, uint32_t row);
+static uint32_t get_row_at(lv_table_t * table, int32_t y);
+static const char * get_cell_txt(lv_obj_t * obj, uint32_t row, uint32_t col);
 
 static inline bool is_cell_empty(void * cell)
 {
     return cell == NULL;
 }
 
+static inline bool is_data_source(lv_table_t * table)
+{
+    return table->cell_value_cb != NULL;
+}
+
 /**********************
  *  STATIC VARIABLES
  **********************/
@@ -92,6 +104,11 @@ void lv_table_set_cell_value(lv_obj_t * obj, uint32_t row, uint32_t col, const c
 
     lv_table_t * table = (lv_table_t *)obj;
 
+    if(is_data_source(table)) {
+        LV_LOG_WARN("not supported in data source mode");
+        return;
+    }
+
     /*Auto expand*/
     if(col >= table->col_cnt) lv_table_set_column_count(obj, col + 1);
     if(row >= table->row_cnt) lv_table_set_row_count(obj, row + 1);
@@ -126,6 +143,11 @@ void lv_table_set_cell_value_fmt(lv_obj_t * obj, uint32_t row, uint32_t col, con
     LV_ASSERT_NULL(fmt);
 
     lv_table_t * table = (lv_table_t *)obj;
+
+    if(is_data_source(table)) {
+        LV_LOG_WARN("not supported in data source mode");
+        return;
+    }
     if(col >= table->col_cnt) {
         lv_table_set_column_count(obj, col + 1);
     }
@@ -208,10 +230,21 @@ void lv_table_set_row_count(lv_obj_t * obj, uint32_t row_cnt)
     uint32_t old_row_cnt = table->row_cnt;
     table->row_cnt         = row_cnt;
 
+    /*Nothing is stored per row, so it's O(1) regardless of the number of rows*/
+    if(is_data_source(table)) {
+        lv_obj_refresh_self_size(obj);
+        lv_obj_invalidate(obj);
+        return;
+    }
+
     table->row_h = lv_realloc(table->row_h, table->row_cnt * sizeof(table->row_h[0]));
     LV_ASSERT_MALLOC(table->row_h);
     if(table->row_h == NULL) return;
 
+    table->row_h_sum = lv_realloc(table->row_h_sum, table->row_cnt * sizeof(table->row_h_sum[0]));
+    LV_ASSERT_MALLOC(table->row_h_sum);
+    if(table->row_h_sum == NULL) return;
+
     /*Free the unused cells*/
     if(old_row_cnt > row_cnt) {
         uint32_t old_cell_cnt = old_row_cnt * table->col_cnt;
@@ -237,7 +270,8 @@ void lv_table_set_row_count(lv_obj_t * obj, uint32_t row_cnt)
         lv_memzero(&table->cell_data[old_cell_cnt], (new_cell_cnt - old_cell_cnt) * sizeof(table->cell_data[0]));
     }
 
-    refr_size_form_row(obj, 0);
+    /*The height of the existing rows doesn't change, only the new ones needs to be measured*/
+    refr_size_form_row(obj, LV_MIN(old_row_cnt, row_cnt));
 }
 
 void lv_table_set_column_count(lv_obj_t * obj, uint32_t col_cnt)
@@ -251,40 +285,42 @@ void lv_table_set_column_count(lv_obj_t * obj, uint32_t col_cnt)
     uint32_t old_col_cnt = table->col_cnt;
     table->col_cnt         = col_cnt;
 
-    lv_table_cell_t ** new_cell_data = lv_malloc(table->row_cnt * table->col_cnt * sizeof(lv_table_cell_t *));
-    LV_ASSERT_MALLOC(new_cell_data);
-    if(new_cell_data == NULL) return;
-    uint32_t new_cell_cnt = table->col_cnt * table->row_cnt;
+    if(!is_data_source(table)) {
+        lv_table_cell_t ** new_cell_data = lv_malloc(table->row_cnt * table->col_cnt * sizeof(lv_table_cell_t *));
+        LV_ASSERT_MALLOC(new_cell_data);
+        if(new_cell_data == NULL) return;
+        uint32_t new_cell_cnt = table->col_cnt * table->row_cnt;
 
-    lv_memzero(new_cell_data, new_cell_cnt * sizeof(table->cell_data[0]));
+        lv_memzero(new_cell_data, new_cell_cnt * sizeof(table->cell_data[0]));
 
-    /*The new column(s) messes up the mapping of `cell_data`*/
-    uint32_t old_col_start;
-    uint32_t new_col_start;
-    uint32_t min_col_cnt = LV_MIN(old_col_cnt, col_cnt);
-    uint32_t row;
-    for(row = 0; row < table->row_cnt; row++) {
-        old_col_start = row * old_col_cnt;
-        new_col_start = row * col_cnt;
-
-        lv_memcpy(&new_cell_data[new_col_start], &table->cell_data[old_col_start],
-                  sizeof(new_cell_data[0]) * min_col_cnt);
-
-        /*Free the old cells (only if the table becomes smaller)*/
-        int32_t i;
-        for(i = 0; i < (int32_t)old_col_cnt - (int32_t)col_cnt; i++) {
-            uint32_t idx = old_col_start + min_col_cnt + i;
-            if(table->cell_data[idx]->user_data) {
-                lv_free(table->cell_data[idx]->user_data);
-                table->cell_data[idx]->user_data = NULL;
+        /*The new column(s) messes up the mapping of `cell_data`*/
+        uint32_t old_col_start;
+        uint32_t new_col_start;
+        uint32_t min_col_cnt = LV_MIN(old_col_cnt, col_cnt);
+        uint32_t row;
+        for(row = 0; row < table->row_cnt; row++) {
+            old_col_start = row * old_col_cnt;
+            new_col_start = row * col_cnt;
+
+            lv_memcpy(&new_cell_data[new_col_start], &table->cell_data[old_col_start],
+                      sizeof(new_cell_data[0]) * min_col_cnt);
+
+            /*Free the old cells (only if the table becomes smaller)*/
+            int32_t i;
+            for(i = 0; i < (int32_t)old_col_cnt - (int32_t)col_cnt; i++) {
+                uint32_t idx = old_col_start + min_col_cnt + i;
+                if(table->cell_data[idx]->user_data) {
+                    lv_free(table->cell_data[idx]->user_data);
+                    table->cell_data[idx]->user_data = NULL;
+                }
+                lv_free(table->cell_data[idx]);
+                table->cell_data[idx] = NULL;
             }
-            lv_free(table->cell_data[idx]);
-            table->cell_data[idx] = NULL;
         }
-    }
 
-    lv_free(table->cell_data);
-    table->cell_data = new_cell_data;
+        lv_free(table->cell_data);
+        table->cell_data = new_cell_data;
+    }
 
     /*Initialize the new column widths if any*/
     table->col_w = lv_realloc(table->col_w, col_cnt * sizeof(table->col_w[0]));
@@ -318,6 +354,11 @@ void lv_table_add_cell_ctrl(lv_obj_t * obj, uint32_t row, uint32_t col, lv_table
 
     lv_table_t * table = (lv_table_t *)obj;
 
+    if(is_data_source(table)) {
+        LV_LOG_WARN("not supported in data source mode");
+        return;
+    }
+
     /*Auto expand*/
     if(col >= table->col_cnt) lv_table_set_column_count(obj, col + 1);
     if(row >= table->row_cnt) lv_table_set_row_count(obj, row + 1);
@@ -343,6 +384,11 @@ void lv_table_clear_cell_ctrl(lv_obj_t * obj, uint32_t row, uint32_t col, lv_tab
 
     lv_table_t * table = (lv_table_t *)obj;
 
+    if(is_data_source(table)) {
+        LV_LOG_WARN("not supported in data source mode");
+        return;
+    }
+
     /*Auto expand*/
     if(col >= table->col_cnt) lv_table_set_column_count(obj, col + 1);
     if(row >= table->row_cnt) lv_table_set_row_count(obj, row + 1);
@@ -368,6 +414,11 @@ void lv_table_set_cell_user_data(lv_obj_t * obj, uint16_t row, uint16_t col, voi
 
     lv_table_t * table = (lv_table_t *)obj;
 
+    if(is_data_source(table)) {
+        LV_LOG_WARN("not supported in data source mode");
+        return;
+    }
+
     /*Auto expand*/
     if(col >= table->col_cnt) lv_table_set_column_count(obj, col + 1);
     if(row >= table->row_cnt) lv_table_set_row_count(obj, row + 1);
@@ -391,6 +442,29 @@ void lv_table_set_cell_user_data(lv_obj_t * obj, uint16_t row, uint16_t col, voi
     table->cell_data[cell]->user_data = user_data;
 }
 
+void lv_table_set_cell_value_cb(lv_obj_t * obj, lv_table_cell_value_cb_t cb, void * user_data)
+{
+    LV_ASSERT_OBJ(obj, MY_CLASS);
+
+    lv_table_t * table = (lv_table_t *)obj;
+
+    free_cells(obj);
+    table->cell_value_cb = cb;
+    table->cell_value_cb_user_data = user_data;
+
+    if(cb == NULL) {
+        uint32_t cell_cnt = table->row_cnt * table->col_cnt;
+        table->cell_data = lv_malloc_zeroed(cell_cnt * sizeof(table->cell_data[0]));
+        table->row_h = lv_malloc(table->row_cnt * sizeof(table->row_h[0]));
+        table->row_h_sum = lv_malloc(table->row_cnt * sizeof(table->row_h_sum[0]));
+        LV_ASSERT_MALLOC(table->cell_data);
+        LV_ASSERT_MALLOC(table->row_h);
+        LV_ASSERT_MALLOC(table->row_h_sum);
+    }
+
+    refr_size_form_row(obj, 0);
+}
+
 /*=====================
  * Getter functions
  *====================*/
@@ -404,6 +478,9 @@ const char * lv_table_get_cell_value(lv_obj_t * obj, uint32_t row, uint32_t col)
         LV_LOG_WARN("invalid row or column");
         return "";
     }
+
+    if(is_data_source(table)) return get_cell_txt(obj, row, col);
+
     uint32_t cell = row * table->col_cnt + col;
 
     if(is_cell_empty(table->cell_data[cell])) return "";
@@ -450,6 +527,8 @@ bool lv_table_has_cell_ctrl(lv_obj_t * obj, uint32_t row, uint32_t col, lv_table
         LV_LOG_WARN("invalid row or column");
         return false;
     }
+    if(is_data_source(table)) return false;
+
     uint32_t cell = row * table->col_cnt + col;
 
     if(is_cell_empty(table->cell_data[cell])) return false;
@@ -472,6 +551,8 @@ void * lv_table_get_cell_user_data(lv_obj_t * obj, uint16_t row, uint16_t col)
         LV_LOG_WARN("invalid row or column");
         return NULL;
     }
+    if(is_data_source(table)) return NULL;
+
     uint32_t cell = row * table->col_cnt + col;
 
     if(is_cell_empty(table->cell_data[cell])) return NULL;
@@ -494,8 +575,10 @@ static void lv_table_constructor(const lv_obj_class_t * class_p, lv_obj_t * obj)
     table->row_cnt = 1;
     table->col_w = lv_malloc(table->col_cnt * sizeof(table->col_w[0]));
     table->row_h = lv_malloc(table->row_cnt * sizeof(table->row_h[0]));
+    table->row_h_sum = lv_malloc(table->row_cnt * sizeof(table->row_h_sum[0]));
     table->col_w[0] = LV_DPI_DEF;
     table->row_h[0] = LV_DPI_DEF;
+    table->row_h_sum[0] = LV_DPI_DEF;
     table->cell_data = lv_realloc(table->cell_data, table->row_cnt * table->col_cnt * sizeof(lv_table_cell_t *));
     table->cell_data[0] = NULL;
 
@@ -506,21 +589,8 @@ static void lv_table_destructor(const lv_obj_class_t * class_p, lv_obj_t * obj)
 {
     LV_UNUSED(class_p);
     lv_table_t * table = (lv_table_t *)obj;
-    /*Free the cell texts*/
-    uint32_t i;
-    for(i = 0; i < table->col_cnt * table->row_cnt; i++) {
-        if(table->cell_data[i]) {
-            if(table->cell_data[i]->user_data) {
-                lv_free(table->cell_data[i]->user_data);
-                table->cell_data[i]->user_data = NULL;
-            }
-            lv_free(table->cell_data[i]);
-            table->cell_data[i] = NULL;
-        }
-    }
 
-    if(table->cell_data) lv_free(table->cell_data);
-    if(table->row_h) lv_free(table->row_h);
+    free_cells(obj);
     if(table->col_w) lv_free(table->col_w);
 }
 
@@ -547,8 +617,7 @@ static void lv_table_event(const lv_obj_class_t * class_p, lv_event_t * e)
         int32_t w = 0;
         for(i = 0; i < table->col_cnt; i++) w += table->col_w[i];
 
-        int32_t h = 0;
-        for(i = 0; i < table->row_cnt; i++) h += table->row_h[i];
+        int32_t h = get_row_y(table, table->row_cnt);
 
         p->x = w - 1;
         p->y = h - 1;
@@ -684,15 +753,22 @@ static void draw_main(lv_event_t * e)
     uint32_t row;
     uint32_t cell = 0;
 
-    cell_area.y2 = obj->coords.y1 + bg_top - 1 - lv_obj_get_scroll_y(obj) + border_width;
+    /*Skip the rows above the clip area*/
+    int32_t rows_y1 = obj->coords.y1 + bg_top - lv_obj_get_scroll_y(obj) + border_width;
+    uint32_t row_start = get_row_at(table, clip_area.y1 - rows_y1);
+    if(row_start >= table->row_cnt) row_start = table->row_cnt ? table->row_cnt - 1 : 0;
+    cell = row_start * table->col_cnt;
+
+    cell_area.y2 = rows_y1 + get_row_y(table, row_start) - 1;
     cell_area.x1 = 0;
     cell_area.x2 = 0;
     int32_t scroll_x = lv_obj_get_scroll_x(obj) ;
     bool rtl = lv_obj_get_style_base_dir(obj, LV_PART_MAIN) == LV_BASE_DIR_RTL;
+    bool data_source = is_data_source(table);
 
     /*Handle custom drawer*/
-    for(row = 0; row < table->row_cnt; row++) {
-        int32_t h_row = table->row_h[row];
+    for(row = row_start; row < table->row_cnt; row++) {
+        int32_t h_row = get_row_h(table, row);
 
         cell_area.y1 = cell_area.y2 + 1;
         cell_area.y2 = cell_area.y1 + h_row - 1;
@@ -703,8 +779,18 @@ static void draw_main(lv_event_t * e)
         else cell_area.x2 = obj->coords.x1 + bg_left - 1 - scroll_x + border_width;
 
         for(col = 0; col < table->col_cnt; col++) {
+            /*In data source mode there are no control bits, the cells are cropped as the rows have fixed height*/
             lv_table_cell_ctrl_t ctrl = 0;
-            if(table->cell_data[cell]) ctrl = table->cell_data[cell]->ctrl;
+            const char * txt = NULL;
+            if(data_source) {
+                ctrl = LV_TABLE_CELL_CTRL_TEXT_CROP;
+                txt = get_cell_txt(obj, row, col);
+                if(txt[0] == '\0') txt = NULL;
+            }
+            else if(table->cell_data[cell]) {
+                ctrl = table->cell_data[cell]->ctrl;
+                txt = table->cell_data[cell]->txt;
+            }
 
             if(rtl) {
                 cell_area.x2 = cell_area.x1 - 1;
@@ -716,7 +802,7 @@ static void draw_main(lv_event_t * e)
             }
 
             uint32_t col_merge = 0;
-            for(col_merge = 0; col_merge + col < table->col_cnt - 1; col_merge++) {
+            for(col_merge = 0; !data_source && col_merge + col < table->col_cnt - 1; col_merge++) {
                 lv_table_cell_t * next_cell_data = table->cell_data[cell + col_merge];
 
                 if(is_cell_empty(next_cell_data)) break;
@@ -788,7 +874,7 @@ static void draw_main(lv_event_t * e)
 
             lv_draw_rect(layer, &rect_dsc_act, &cell_area_border);
 
-            if(table->cell_data[cell]) {
+            if(txt) {
                 const int32_t cell_left = lv_obj_get_style_pad_left(obj, LV_PART_ITEMS);
                 const int32_t cell_right = lv_obj_get_style_pad_right(obj, LV_PART_ITEMS);
                 const int32_t cell_top = lv_obj_get_style_pad_top(obj, LV_PART_ITEMS);
@@ -805,7 +891,7 @@ static void draw_main(lv_event_t * e)
                 bool crop = ctrl & LV_TABLE_CELL_CTRL_TEXT_CROP;
                 if(crop) txt_flags = LV_TEXT_FLAG_EXPAND;
 
-                lv_text_get_size(&txt_size, table->cell_data[cell]->txt, label_dsc_def.font,
+                lv_text_get_size(&txt_size, txt, label_dsc_def.font,
                                  label_dsc_act.letter_space, label_dsc_act.line_space,
                                  lv_area_get_width(&txt_area), txt_flags);
 
@@ -820,7 +906,9 @@ static void draw_main(lv_event_t * e)
                 label_mask_ok = _lv_area_intersect(&label_clip_area, &clip_area, &cell_area);
                 if(label_mask_ok) {
                     layer->_clip_area = label_clip_area;
-                    label_dsc_act.text = table->cell_data[cell]->txt;
+                    label_dsc_act.text = txt;
+                    /*The text of the callback is valid only until its next call*/
+                    label_dsc_act.text_local = data_source;
                     lv_draw_label(layer, &label_dsc_act, &txt_area);
                     layer->_clip_area = clip_area;
                 }
@@ -850,11 +938,19 @@ static void refr_size_form_row(lv_obj_t * obj, uint32_t start_row)
     const int32_t maxh = lv_obj_get_style_max_height(obj, LV_PART_ITEMS);
 
     lv_table_t * table = (lv_table_t *)obj;
-    uint32_t i;
-    for(i = start_row; i < table->row_cnt; i++) {
-        int32_t calculated_height = get_row_height(obj, i, font, letter_space, line_space,
-                                                   cell_pad_left, cell_pad_right, cell_pad_top, cell_pad_bottom);
-        table->row_h[i] = LV_CLAMP(minh, calculated_height, maxh);
+    if(is_data_source(table)) {
+        /*The cells are not measured, every row is one line high*/
+        int32_t h = lv_font_get_line_height(font) + cell_pad_top + cell_pad_bottom;
+        table->virtual_row_h = LV_CLAMP(minh, h, maxh);
+    }
+    else {
+        uint32_t i;
+        for(i = start_row; i < table->row_cnt; i++) {
+            int32_t calculated_height = get_row_height(obj, i, font, letter_space, line_space,
+                                                       cell_pad_left, cell_pad_right, cell_pad_top, cell_pad_bottom);
+            table->row_h[i] = LV_CLAMP(minh, calculated_height, maxh);
+        }
+        row_h_sum_build(table);
     }
 
     lv_obj_refresh_self_size(obj);
@@ -881,6 +977,7 @@ static void refr_cell_size(lv_obj_t * obj, uint32_t row, uint32_t col)
 
     int32_t prev_row_size = table->row_h[row];
     table->row_h[row] = LV_CLAMP(minh, calculated_height, maxh);
+    row_h_sum_add(table, row, table->row_h[row] - prev_row_size);
 
     /*If the row height haven't changed invalidate only this cell*/
     if(prev_row_size == table->row_h[row]) {
@@ -999,13 +1096,7 @@ static lv_result_t get_pressed_cell(lv_obj_t * obj, uint32_t * row, uint32_t * c
         y -= obj->coords.y1;
         y -= lv_obj_get_style_pad_top(obj, LV_PART_MAIN);
 
-        *row = 0;
-        tmp = 0;
-
-        for(*row = 0; *row < table->row_cnt; (*row)++) {
-            tmp += table->row_h[*row];
-            if(y < tmp) break;
-        }
+        *row = get_row_at(table, y);
     }
 
     return LV_RESULT_OK;
@@ -1058,15 +1149,10 @@ static void get_cell_area(lv_obj_t * obj, uint32_t row, uint32_t col, lv_area_t
         area->x2 = area->x1 + table->col_w[col] - 1;
     }
 
-    uint32_t r;
-    area->y1 = 0;
-    for(r = 0; r < row; r++) {
-        area->y1 += table->row_h[r];
-    }
-
+    area->y1 = get_row_y(table, row);
     area->y1 += lv_obj_get_style_pad_top(obj, 0);
     area->y1 -= lv_obj_get_scroll_y(obj);
-    area->y2 = area->y1 + table->row_h[row] - 1;
+    area->y2 = area->y1 + get_row_h(table, row) - 1;
 
 }
 
@@ -1091,4 +1177,104 @@ static void scroll_to_selected_cell(lv_obj_t * obj)
     }
 
 }
+
+/*Free the cells and the row heights*/
+static void free_cells(lv_obj_t * obj)
+{
+    lv_table_t * table = (lv_table_t *)obj;
+
+    if(table->cell_data) {
+        uint32_t i;
+        for(i = 0; i < table->col_cnt * table->row_cnt; i++) {
+            if(table->cell_data[i]) {
+                if(table->cell_data[i]->user_data) {
+                    lv_free(table->cell_data[i]->user_data);
+                    table->cell_data[i]->user_data = NULL;
+                }
+                lv_free(table->cell_data[i]);
+                table->cell_data[i] = NULL;
+            }
+        }
+        lv_free(table->cell_data);
+        table->cell_data = NULL;
+    }
+
+    if(table->row_h) lv_free(table->row_h);
+    if(table->row_h_sum) lv_free(table->row_h_sum);
+    table->row_h = NULL;
+    table->row_h_sum = NULL;
+}
+
+/* `row_h_sum` is a Fenwick tree: `row_h_sum[i - 1]` is the sum of the last `i & -i` row heights up to row `i - 1`.
+ * This way both the y coordinate of a row and the row at a y coordinate can be found in O(log n),
+ * and changing a row's height is O(log n) too. */
+static void row_h_sum_build(lv_table_t * table)
+{
+    uint32_t i;
+    for(i = 0; i < table->row_cnt; i++) table->row_h_sum[i] = table->row_h[i];
+
+    for(i = 1; i <= table->row_cnt; i++) {
+        uint32_t parent = i + (i & (~i + 1));
+        if(parent <= table->row_cnt) table->row_h_sum[parent - 1] += table->row_h_sum[i - 1];
+    }
+}
+
+static void row_h_sum_add(lv_table_t * table, uint32_t row, int32_t diff)
+{
+    uint32_t i;
+    for(i = row + 1; i <= table->row_cnt; i += i & (~i + 1)) {
+        table->row_h_sum[i - 1] += diff;
+    }
+}
+
+/*Get the sum of the heights of the rows above `row`*/
+static int32_t get_row_y(lv_table_t * table, uint32_t row)
+{
+    if(is_data_source(table)) return (int32_t)row * table->virtual_row_h;
+
+    int32_t y = 0;
+    uint32_t i;
+    for(i = row; i > 0; i -= i & (~i + 1)) {
+        y += table->row_h_sum[i - 1];
+    }
+
+    return y;
+}
+
+static int32_t get_row_h(lv_table_t * table, uint32_t row)
+{
+    if(is_data_source(table)) return table->virtual_row_h;
+    else return table->row_h[row];
+}
+
+/*Get the row at `y` (relative to the first row). Returns `row_cnt` if `y` is below the last row.*/
+static uint32_t get_row_at(lv_table_t * table, int32_t y)
+{
+    if(y < 0) return 0;
+
+    if(is_data_source(table)) {
+        if(table->virtual_row_h <= 0) return table->row_cnt;
+        return LV_MIN((uint32_t)(y / table->virtual_row_h), table->row_cnt);
+    }
+
+    uint32_t row = 0;
+    uint32_t step = 1;
+    while(step <= table->row_cnt / 2) step <<= 1;
+
+    for(; step > 0; step >>= 1) {
+        if(row + step <= table->row_cnt && table->row_h_sum[row + step - 1] <= y) {
+            row += step;
+            y -= table->row_h_sum[row - 1];
+        }
+    }
+
+    return row;
+}
+
+static const char * get_cell_txt(lv_obj_t * obj, uint32_t row, uint32_t col)
+{
+    lv_table_t * table = (lv_table_t *)obj;
+    const char * txt = table->cell_value_cb(obj, row, col, table->cell_value_cb_user_data);
+    return txt ? txt : "";
+}
 #endif
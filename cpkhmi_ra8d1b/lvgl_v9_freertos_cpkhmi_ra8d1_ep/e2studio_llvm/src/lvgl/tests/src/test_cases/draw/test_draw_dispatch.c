@@ -0,0 +1,205 @@
+#if LV_BUILD_TEST
+#include "../lvgl.h"
+
+#include "unity/unity.h"
+#include <time.h>
+
+#define CANVAS_W    256
+#define CANVAS_H    256
+#define TILE_SIZE   4
+
+/*A draw unit which only pretends drawing to measure the dispatching*/
+#define BENCH_UNIT_ID       200
+#define BENCH_INFLIGHT_CNT  4
+
+typedef struct {
+    lv_draw_unit_t base_unit;
+    lv_layer_t * layer;
+    lv_draw_task_t * tasks[BENCH_INFLIGHT_CNT];
+    uint32_t task_cnt;
+} bench_unit_t;
+
+static uint8_t canvas_buf[LV_CANVAS_BUF_SIZE(CANVAS_W, CANVAS_H, 32, LV_DRAW_BUF_STRIDE_ALIGN)];
+static lv_obj_t * canvas;
+static bench_unit_t * bench_unit;
+
+static void fill(lv_layer_t * layer, int32_t x, int32_t y, int32_t w, int32_t h, lv_color_t color)
+{
+    lv_draw_rect_dsc_t dsc;
+    lv_draw_rect_dsc_init(&dsc);
+    dsc.bg_color = color;
+    lv_area_t a = {x, y, x + w - 1, y + h - 1};
+    lv_draw_rect(layer, &dsc, &a);
+}
+
+static uint32_t get_px(int32_t x, int32_t y)
+{
+    lv_color32_t c = lv_canvas_get_px(canvas, x, y);
+    return lv_color_to_u32(lv_color_make(c.red, c.green, c.blue)) & 0xffffff;
+}
+
+/*Add `cnt` tiles. With `overlap` each tile overlaps the next one.*/
+static void add_tiles(lv_layer_t * layer, uint32_t cnt, bool overlap)
+{
+    uint32_t col_cnt = CANVAS_W / TILE_SIZE;
+    uint32_t i;
+    for(i = 0; i < cnt; i++) {
+        int32_t x = (i % col_cnt) * TILE_SIZE;
+        int32_t y = (i / col_cnt) * TILE_SIZE;
+        int32_t w = overlap ? TILE_SIZE * 2 : TILE_SIZE;
+        fill(layer, x, y, w, TILE_SIZE, lv_color_hex(0x000010 * (i % 16)));
+    }
+}
+
+static int32_t bench_evaluate(lv_draw_unit_t * draw_unit, lv_draw_task_t * task)
+{
+    bench_unit_t * u = (bench_unit_t *)draw_unit;
+    if(u->layer) {
+        task->preferred_draw_unit_id = BENCH_UNIT_ID;
+        task->preference_score = 0;
+    }
+    return 0;
+}
+
+/*Work like a GPU with a few tasks in flight: finish the oldest task and take new ones*/
+static int32_t bench_dispatch(lv_draw_unit_t * draw_unit, lv_layer_t * layer)
+{
+    bench_unit_t * u = (bench_unit_t *)draw_unit;
+    if(layer != u->layer) return -1;
+
+    if(u->task_cnt > 0) {
+        u->tasks[0]->state = LV_DRAW_TASK_STATE_READY;
+        u->task_cnt--;
+        lv_memmove(&u->tasks[0], &u->tasks[1], u->task_cnt * sizeof(lv_draw_task_t *));
+    }
+
+    while(u->task_cnt < BENCH_INFLIGHT_CNT) {
+        lv_draw_task_t * t = lv_draw_get_next_available_task(layer, NULL, BENCH_UNIT_ID);
+        if(t == NULL) break;
+        t->state = LV_DRAW_TASK_STATE_IN_PROGRESS;
+        u->tasks[u->task_cnt] = t;
+        u->task_cnt++;
+    }
+
+    return u->task_cnt;
+}
+
+/*Return the time of adding and dispatching `cnt` tiles in microseconds*/
+static void bench_tiles(uint32_t cnt, bool overlap, uint32_t * add_us, uint32_t * dispatch_us)
+{
+    if(bench_unit == NULL) {
+        bench_unit = lv_draw_create_unit(sizeof(bench_unit_t));
+        bench_unit->base_unit.evaluate_cb = bench_evaluate;
+        bench_unit->base_unit.dispatch_cb = bench_dispatch;
+    }
+
+    lv_layer_t layer;
+    lv_canvas_init_layer(canvas, &layer);
+    bench_unit->layer = &layer;
+
+    clock_t start = clock();
+    add_tiles(&layer, cnt, overlap);
+    clock_t added = clock();
+    while(layer.draw_task_head) {
+        lv_draw_dispatch_layer(NULL, &layer);
+    }
+    clock_t end = clock();
+
+    bench_unit->layer = NULL;
+    *add_us = (uint32_t)((double)(added - start) * 1000000 / CLOCKS_PER_SEC);
+    *dispatch_us = (uint32_t)((double)(end - added) * 1000000 / CLOCKS_PER_SEC);
+}
+
+void setUp(void)
+{
+    canvas = lv_canvas_create(lv_screen_active());
+    lv_canvas_set_buffer(canvas, canvas_buf, CANVAS_W, CANVAS_H, LV_COLOR_FORMAT_XRGB8888);
+    lv_canvas_fill_bg(canvas, lv_color_white(), LV_OPA_COVER);
+}
+
+void tearDown(void)
+{
+    lv_obj_clean(lv_screen_active());
+}
+
+void test_draw_dispatch_overlapping_tasks_in_order(void)
+{
+    lv_layer_t layer;
+    lv_canvas_init_layer(canvas, &layer);
+
+    fill(&layer, 0, 0, 100, 100, lv_color_hex(0xff0000));
+    fill(&layer, 50, 50, 100, 100, lv_color_hex(0x00ff00));
+    fill(&layer, 200, 0, 50, 50, lv_color_hex(0x0000ff));
+    fill(&layer, 75, 75, 10, 10, lv_color_hex(0xffff00));
+
+    lv_canvas_finish_layer(canvas, &layer);
+
+    TEST_ASSERT_EQUAL_HEX32(0xff0000, get_px(10, 10));
+    TEST_ASSERT_EQUAL_HEX32(0x00ff00, get_px(60, 60));
+    TEST_ASSERT_EQUAL_HEX32(0xffff00, get_px(80, 80));
+    TEST_ASSERT_EQUAL_HEX32(0x0000ff, get_px(220, 20));
+    TEST_ASSERT_EQUAL_HEX32(0xffffff, get_px(180, 20));
+}
+
+void test_draw_dispatch_dependent_count(void)
+{
+    lv_layer_t layer;
+    lv_canvas_init_layer(canvas, &layer);
+
+    fill(&layer, 0, 0, 50, 50, lv_color_hex(0xff0000));
+    fill(&layer, 25, 25, 50, 50, lv_color_hex(0x00ff00));
+    fill(&layer, 40, 40, 50, 50, lv_color_hex(0x0000ff));
+    fill(&layer, 200, 200, 50, 50, lv_color_hex(0x0000ff));
+
+    /*The tasks of a canvas layer are dispatched only by `lv_canvas_finish_layer`*/
+    lv_draw_task_t * t = layer.draw_task_head;
+    TEST_ASSERT_EQUAL_UINT32(2, lv_draw_get_dependent_count(t));
+    TEST_ASSERT_EQUAL_UINT32(1, lv_draw_get_dependent_count(t->next));
+    TEST_ASSERT_EQUAL_UINT32(0, lv_draw_get_dependent_count(t->next->next));
+    TEST_ASSERT_EQUAL_UINT32(0, lv_draw_get_dependent_count(t->next->next->next));
+
+    /*Only the first and the last tasks are independent*/
+    uint8_t id = t->preferred_draw_unit_id;
+    lv_draw_task_t * t_av = lv_draw_get_next_available_task(&layer, NULL, id);
+    TEST_ASSERT_EQUAL_PTR(t, t_av);
+    t_av = lv_draw_get_next_available_task(&layer, t_av, id);
+    TEST_ASSERT_EQUAL_PTR(t->next->next->next, t_av);
+    TEST_ASSERT_NULL(lv_draw_get_next_available_task(&layer, t_av, id));
+
+    /*Not taken by the draw unit so it's available again*/
+    TEST_ASSERT_EQUAL_PTR(t, lv_draw_get_next_available_task(&layer, NULL, id));
+
+    lv_canvas_finish_layer(canvas, &layer);
+    TEST_ASSERT_NULL(layer.draw_task_head);
+    TEST_ASSERT_EQUAL_HEX32(0x0000ff, get_px(45, 45));
+}
+
+void test_draw_dispatch_many_tasks(void)
+{
+    lv_layer_t layer;
+    lv_canvas_init_layer(canvas, &layer);
+    add_tiles(&layer, CANVAS_W / TILE_SIZE * CANVAS_H / TILE_SIZE, true);
+    lv_canvas_finish_layer(canvas, &layer);
+
+    TEST_ASSERT_EQUAL_HEX32(0x000000, get_px(0, 0));
+    TEST_ASSERT_EQUAL_HEX32(0x000010, get_px(TILE_SIZE, 0));
+    TEST_ASSERT_EQUAL_HEX32(0x0000f0, get_px(CANVAS_W - 1, CANVAS_H - 1));
+}
+
+void test_draw_dispatch_benchmark(void)
+{
+    uint32_t cnt;
+    for(cnt = 256; cnt <= 4096; cnt *= 2) {
+        uint32_t add_us;
+        uint32_t dispatch_us;
+        bench_tiles(cnt, false, &add_us, &dispatch_us);
+        TEST_PRINTF("%d independent tasks: add %d us, dispatch %d us (%d ns/task)",
+                    (int)cnt, (int)add_us, (int)dispatch_us, (int)(dispatch_us * 1000 / cnt));
+
+        bench_tiles(cnt, true, &add_us, &dispatch_us);
+        TEST_PRINTF("%d overlapping tasks: add %d us, dispatch %d us (%d ns/task)",
+                    (int)cnt, (int)add_us, (int)dispatch_us, (int)(dispatch_us * 1000 / cnt));
+    }
+}
+
+#endif
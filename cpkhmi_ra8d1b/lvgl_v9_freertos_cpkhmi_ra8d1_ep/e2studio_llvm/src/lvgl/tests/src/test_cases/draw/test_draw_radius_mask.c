@@ -0,0 +1,89 @@
+#if LV_BUILD_TEST
+#include "../lvgl.h"
+
+#include "unity/unity.h"
+
+void setUp(void)
+{
+    /* Function run before every test */
+    lv_obj_set_flex_flow(lv_screen_active(), LV_FLEX_FLOW_ROW_WRAP);
+    lv_obj_set_flex_align(lv_screen_active(), LV_FLEX_ALIGN_SPACE_EVENLY, LV_FLEX_ALIGN_CENTER, LV_FLEX_ALIGN_SPACE_EVENLY);
+}
+
+void tearDown(void)
+{
+    /* Function run after every test */
+    lv_obj_clean(lv_screen_active());
+    lv_obj_set_layout(lv_screen_active(), LV_LAYOUT_NONE);
+}
+
+static lv_obj_t * rounded_obj_create(lv_obj_t * parent, int32_t w, int32_t h, int32_t radius)
+{
+    lv_obj_t * obj = lv_obj_create(parent);
+    lv_obj_remove_style_all(obj);
+    lv_obj_set_size(obj, w, h);
+    lv_obj_set_style_radius(obj, radius, 0);
+    lv_obj_set_style_bg_opa(obj, LV_OPA_COVER, 0);
+    lv_obj_set_style_bg_color(obj, lv_palette_main(LV_PALETTE_BLUE), 0);
+    lv_obj_set_style_border_width(obj, 3, 0);
+    lv_obj_set_style_border_color(obj, lv_palette_darken(LV_PALETTE_BLUE, 3), 0);
+    lv_obj_set_style_border_opa(obj, LV_OPA_70, 0);
+    return obj;
+}
+
+static void radii_create(void)
+{
+    /*More different radii than the cache size to use every cache path*/
+    int32_t r;
+    for(r = 1; r <= 40; r += 3) {
+        rounded_obj_create(lv_screen_active(), 50 + r, 30 + r, r);
+    }
+
+    /*Circles where the left and right anti-aliased pixels meet*/
+    rounded_obj_create(lv_screen_active(), 9, 9, LV_RADIUS_CIRCLE);
+    rounded_obj_create(lv_screen_active(), 20, 20, LV_RADIUS_CIRCLE);
+    rounded_obj_create(lv_screen_active(), 61, 61, LV_RADIUS_CIRCLE);
+
+    /*Clip the children on the rounded corner and use outer masks for the outline*/
+    lv_obj_t * parent = rounded_obj_create(lv_screen_active(), 120, 80, 25);
+    lv_obj_set_style_clip_corner(parent, true, 0);
+    lv_obj_set_style_outline_width(parent, 4, 0);
+    lv_obj_set_style_outline_pad(parent, 2, 0);
+    lv_obj_set_style_outline_color(parent, lv_palette_main(LV_PALETTE_RED), 0);
+    lv_obj_t * child = rounded_obj_create(parent, 100, 60, 12);
+    lv_obj_set_pos(child, -30, -20);
+    lv_obj_set_style_bg_color(child, lv_palette_main(LV_PALETTE_GREEN), 0);
+}
+
+void test_draw_radius_mask_cache(void)
+{
+    radii_create();
+
+    /*The circles are calculated in the first refresh, cached in the second and reused in the third*/
+    TEST_ASSERT_EQUAL_SCREENSHOT("draw/radius_mask.png");
+    lv_obj_invalidate(lv_screen_active());
+    TEST_ASSERT_EQUAL_SCREENSHOT("draw/radius_mask.png");
+    lv_obj_invalidate(lv_screen_active());
+    TEST_ASSERT_EQUAL_SCREENSHOT("draw/radius_mask.png");
+}
+
+void test_draw_radius_mask_clipped(void)
+{
+    lv_obj_set_layout(lv_screen_active(), LV_LAYOUT_NONE);
+
+    /*Partially out of the screen on every side to clip the anti-aliased pixels*/
+    lv_obj_t * obj = rounded_obj_create(lv_screen_active(), 200, 150, 60);
+    lv_obj_set_pos(obj, -55, -40);
+    obj = rounded_obj_create(lv_screen_active(), 200, 150, 60);
+    lv_obj_align(obj, LV_ALIGN_BOTTOM_RIGHT, 57, 43);
+    obj = rounded_obj_create(lv_screen_active(), 150, 150, LV_RADIUS_CIRCLE);
+    lv_obj_align(obj, LV_ALIGN_TOP_RIGHT, 70, -20);
+    obj = rounded_obj_create(lv_screen_active(), 120, 120, LV_RADIUS_CIRCLE);
+    lv_obj_align(obj, LV_ALIGN_BOTTOM_LEFT, -61, 30);
+
+    TEST_ASSERT_EQUAL_SCREENSHOT("draw/radius_mask_clipped.png");
+    lv_obj_invalidate(lv_screen_active());
+    TEST_ASSERT_EQUAL_SCREENSHOT("draw/radius_mask_clipped.png");
+}
+
+#endif
@@ -0,0 +1,154 @@
+#if LV_BUILD_TEST
+#include "../lvgl.h"
+
+#include "unity/unity.h"
+
+#include "lv_test_helpers.h"
+#include <stdio.h>
+
+#define GIF_FILE        "../examples/libs/gif/bulb.gif"     /*60x80, most frames update a small rectangle*/
+#define GIF_FRAMES      200     /*The animation loops forever, go around once and a bit more*/
+
+static uint8_t * gif_data;
+static lv_image_dsc_t gif_dsc;
+static lv_area_t inv_area;
+static uint32_t inv_cnt;
+
+static void load_gif(void)
+{
+    FILE * f = fopen(GIF_FILE, "rb");
+    TEST_ASSERT_NOT_NULL(f);
+    fseek(f, 0, SEEK_END);
+    long size = ftell(f);
+    fseek(f, 0, SEEK_SET);
+
+    gif_data = lv_malloc(size);
+    TEST_ASSERT_NOT_NULL(gif_data);
+    TEST_ASSERT_EQUAL(size, fread(gif_data, 1, size, f));
+    fclose(f);
+
+    lv_memzero(&gif_dsc, sizeof(gif_dsc));
+    gif_dsc.data = gif_data;
+    gif_dsc.data_size = size;
+}
+
+static void invalidate_area_cb(lv_event_t * e)
+{
+    const lv_area_t * a = lv_event_get_param(e);
+    if(inv_cnt == 0) inv_area = *a;
+    else _lv_area_join(&inv_area, &inv_area, a);
+    inv_cnt++;
+}
+
+void setUp(void)
+{
+    load_gif();
+}
+
+void tearDown(void)
+{
+    lv_obj_clean(lv_screen_active());
+    lv_display_remove_event_cb_with_user_data(lv_display_get_default(), invalidate_area_cb, NULL);
+    lv_free(gif_data);
+}
+
+void test_gif_dirty_area(void)
+{
+    gd_GIF * gif = gd_open_gif_data(gif_data, LV_COLOR_FORMAT_ARGB8888);
+    TEST_ASSERT_NOT_NULL(gif);
+
+    uint32_t px_cnt = gif->width * gif->height;
+    uint32_t * prev = lv_malloc(px_cnt * 4);
+    uint32_t * canvas = (uint32_t *)gif->canvas;
+    uint32_t dirty_sum = 0;
+    uint32_t frames;
+
+    for(frames = 0; frames < GIF_FRAMES; frames++) {
+        TEST_ASSERT_EQUAL(1, gd_get_frame(gif));
+        lv_memcpy(prev, canvas, px_cnt * 4);
+        gd_render_frame(gif, gif->canvas);
+
+        /*Every pixel changed by the frame has to be in the dirty area*/
+        uint32_t x, y;
+        for(y = 0; y < gif->height; y++) {
+            for(x = 0; x < gif->width; x++) {
+                if(prev[y * gif->width + x] == canvas[y * gif->width + x]) continue;
+                TEST_ASSERT_TRUE(x >= gif->dx && x < gif->dx + gif->dw);
+                TEST_ASSERT_TRUE(y >= gif->dy && y < gif->dy + gif->dh);
+            }
+        }
+        dirty_sum += gif->dw * gif->dh;
+    }
+
+    TEST_ASSERT_TRUE(dirty_sum < frames * px_cnt / 4);
+
+    lv_free(prev);
+    gd_close_gif(gif);
+}
+
+void test_gif_rgb565(void)
+{
+    gd_GIF * gif_argb = gd_open_gif_data(gif_data, LV_COLOR_FORMAT_ARGB8888);
+    gd_GIF * gif_565 = gd_open_gif_data(gif_data, LV_COLOR_FORMAT_RGB565);
+    TEST_ASSERT_NOT_NULL(gif_argb);
+    TEST_ASSERT_NOT_NULL(gif_565);
+    TEST_ASSERT_EQUAL(LV_COLOR_FORMAT_RGB565, gif_565->cf);
+
+    uint32_t px_cnt = gif_argb->width * gif_argb->height;
+    uint32_t frames;
+    for(frames = 0; frames < GIF_FRAMES; frames++) {
+        TEST_ASSERT_EQUAL(1, gd_get_frame(gif_argb));
+        TEST_ASSERT_EQUAL(1, gd_get_frame(gif_565));
+        gd_render_frame(gif_argb, gif_argb->canvas);
+        gd_render_frame(gif_565, gif_565->canvas);
+
+        const lv_color32_t * argb = (const lv_color32_t *)gif_argb->canvas;
+        const uint16_t * rgb565 = (const uint16_t *)gif_565->canvas;
+        uint32_t i;
+        for(i = 0; i < px_cnt; i++) {
+            TEST_ASSERT_EQUAL_HEX16(lv_color_to_u16(lv_color_make(argb[i].red, argb[i].green, argb[i].blue)), rgb565[i]);
+        }
+    }
+
+    gd_close_gif(gif_argb);
+    gd_close_gif(gif_565);
+}
+
+void test_gif_invalidate_frame_area(void)
+{
+    lv_obj_t * obj = lv_gif_create(lv_screen_active());
+    lv_obj_set_pos(obj, 100, 50);
+    lv_gif_set_src(obj, &gif_dsc);
+    lv_refr_now(NULL);
+
+    lv_display_add_event_cb(lv_display_get_default(), invalidate_area_cb, LV_EVENT_INVALIDATE_AREA, NULL);
+
+    gd_GIF * gif = ((lv_gif_t *)obj)->gif;
+    uint32_t frames = 0;
+    while(frames < 20) {
+        inv_cnt = 0;
+        lv_test_wait(gif->gce.delay * 10);
+        if(inv_cnt == 0) continue;
+
+        TEST_ASSERT_EQUAL_INT32(100 + gif->dx, inv_area.x1);
+        TEST_ASSERT_EQUAL_INT32(50 + gif->dy, inv_area.y1);
+        TEST_ASSERT_EQUAL_INT32(gif->dw, lv_area_get_width(&inv_area));
+        TEST_ASSERT_EQUAL_INT32(gif->dh, lv_area_get_height(&inv_area));
+        frames++;
+    }
+}
+
+void test_gif_rgb565_widget(void)
+{
+    lv_obj_t * obj = lv_gif_create(lv_screen_active());
+    lv_gif_set_color_format(obj, LV_COLOR_FORMAT_RGB565);
+    lv_gif_set_src(obj, &gif_dsc);
+
+    lv_gif_t * gifobj = (lv_gif_t *)obj;
+    TEST_ASSERT_NOT_NULL(gifobj->gif);
+    TEST_ASSERT_EQUAL(LV_COLOR_FORMAT_RGB565, gifobj->imgdsc.header.cf);
+    TEST_ASSERT_EQUAL_UINT32(60 * 2, gifobj->imgdsc.header.stride);
+    lv_refr_now(NULL);
+}
+
+#endif
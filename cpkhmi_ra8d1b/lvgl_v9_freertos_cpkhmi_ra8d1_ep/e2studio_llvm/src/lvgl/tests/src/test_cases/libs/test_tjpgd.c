@@ -4,6 +4,8 @@
 #include "unity/unity.h"
 #include "lv_test_helpers.h"
 
+static uint32_t backend_calls;
+
 void setUp(void)
 {
     /* Function run before every test */
@@ -64,4 +66,76 @@ void test_tjpgd_1(void)
     lv_libjpeg_turbo_init();
 }
 
+static lv_result_t backend_decode(lv_tjpgd_backend_t * backend, const uint8_t * data, uint32_t data_size,
+                                  lv_draw_buf_t * decoded)
+{
+    backend_calls++;
+    if(backend->user_data) return LV_RESULT_INVALID;    /*Refuse the image*/
+    return lv_tjpgd_decode_sw(backend, data, data_size, decoded);
+}
+
+static void check_backend(bool refuse)
+{
+    static lv_tjpgd_backend_t backend;
+    backend.name = "test";
+    backend.decode_cb = backend_decode;
+    backend.user_data = refuse ? &backend : NULL;
+
+    lv_libjpeg_turbo_deinit();
+    lv_tjpgd_set_backend(&backend);
+    backend_calls = 0;
+
+    create_images();
+    TEST_ASSERT_EQUAL_SCREENSHOT("libs/jpg_1.png");
+    TEST_ASSERT_GREATER_THAN_UINT32(0, backend_calls);
+
+    lv_obj_clean(lv_screen_active());
+    lv_image_cache_drop(NULL);
+    lv_tjpgd_set_backend(NULL);
+    lv_libjpeg_turbo_init();
+}
+
+void test_tjpgd_backend(void)
+{
+    check_backend(false);
+}
+
+void test_tjpgd_backend_fallback(void)
+{
+    check_backend(true);
+}
+
+void test_tjpgd_rgb565(void)
+{
+    LV_IMG_DECLARE(test_img_lvgl_logo_jpg);
+    const lv_image_dsc_t * img = &test_img_lvgl_logo_jpg;
+    uint32_t w = img->header.w;
+    uint32_t h = img->header.h;
+
+    lv_draw_buf_t * rgb888 = lv_draw_buf_create(w, h, LV_COLOR_FORMAT_RGB888, LV_STRIDE_AUTO);
+    lv_draw_buf_t * rgb565 = lv_draw_buf_create(w, h, LV_COLOR_FORMAT_RGB565, LV_STRIDE_AUTO);
+    TEST_ASSERT_EQUAL(LV_RESULT_OK, lv_tjpgd_decode_sw(NULL, img->data, img->data_size, rgb888));
+    TEST_ASSERT_EQUAL(LV_RESULT_OK, lv_tjpgd_decode_sw(NULL, img->data, img->data_size, rgb565));
+
+    /*The RGB565 conversion is in Q15, allow 1 LSB difference*/
+    uint32_t x, y;
+    for(y = 0; y < h; y++) {
+        const uint8_t * c24 = (const uint8_t *)rgb888->data + y * rgb888->header.stride;
+        const uint16_t * c16 = (const uint16_t *)((const uint8_t *)rgb565->data + y * rgb565->header.stride);
+        for(x = 0; x < w; x++) {
+            TEST_ASSERT_INT_WITHIN(1, c24[x * 3 + 0] >> 3, c16[x] & 0x1F);
+            TEST_ASSERT_INT_WITHIN(1, c24[x * 3 + 1] >> 2, (c16[x] >> 5) & 0x3F);
+            TEST_ASSERT_INT_WITHIN(1, c24[x * 3 + 2] >> 3, c16[x] >> 11);
+        }
+    }
+
+    /*The size of the image has to match*/
+    lv_draw_buf_t * small = lv_draw_buf_create(w / 2, h, LV_COLOR_FORMAT_RGB565, LV_STRIDE_AUTO);
+    TEST_ASSERT_EQUAL(LV_RESULT_INVALID, lv_tjpgd_decode_sw(NULL, img->data, img->data_size, small));
+
+    lv_draw_buf_destroy(rgb888);
+    lv_draw_buf_destroy(rgb565);
+    lv_draw_buf_destroy(small);
+}
+
 #endif
@@ -0,0 +1,93 @@
+#if LV_BUILD_TEST
+#include "../lvgl.h"
+#include "../demos/lv_demos.h"
+
+#include "unity/unity.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+
+#define FRAME_CNT       10
+#define FRAME_PERIOD    33
+#define SCENE_MAX       32
+
+static uint32_t draw_unit_cnt(void)
+{
+    uint32_t cnt = 0;
+    lv_draw_unit_t * u;
+    for(u = LV_GLOBAL_DEFAULT()->draw_info.unit_head; u; u = u->next) cnt++;
+    return cnt;
+}
+
+static uint32_t time_us_cb(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint32_t)(ts.tv_sec * 1000000 + ts.tv_nsec / 1000);
+}
+
+void setUp(void)
+{
+    /* Function run before every test */
+}
+
+void tearDown(void)
+{
+    /* Function run after every test */
+}
+
+void test_demo_benchmark_headless(void)
+{
+#if LV_USE_DEMO_BENCHMARK
+    static char json[8192];
+    uint32_t task_cnt[SCENE_MAX];
+    uint32_t unit_cnt = draw_unit_cnt();
+
+    lv_demo_benchmark_run_headless(FRAME_CNT, FRAME_PERIOD, time_us_cb);
+
+    /*The draw unit counting the tasks is removed at the end*/
+    TEST_ASSERT_EQUAL_UINT32(unit_cnt, draw_unit_cnt());
+
+    uint32_t scene_cnt = 0;
+    const lv_demo_benchmark_result_t * res;
+    while((res = lv_demo_benchmark_get_result(scene_cnt)) != NULL) {
+        TEST_ASSERT_LESS_THAN(SCENE_MAX, scene_cnt);
+        TEST_ASSERT_EQUAL_UINT32(FRAME_CNT, res->frame_cnt);
+        TEST_ASSERT_GREATER_THAN_UINT32(0, res->draw_task_cnt);
+        task_cnt[scene_cnt] = res->draw_task_cnt;
+        scene_cnt++;
+    }
+    TEST_ASSERT_GREATER_THAN_UINT32(0, scene_cnt);
+
+    uint32_t len = lv_demo_benchmark_get_json(json, sizeof(json));
+    TEST_ASSERT_GREATER_THAN_UINT32(0, len);
+    TEST_ASSERT_EQUAL_UINT32(strlen(json), len);
+    TEST_ASSERT_EQUAL_CHAR('{', json[0]);
+    TEST_ASSERT_NOT_NULL(strstr(json, "\"name\": \"Containers with opa_layer\""));
+    TEST_ASSERT_EQUAL_UINT32(0, lv_demo_benchmark_get_json(json, 64));
+
+    /*Set LVGL_BENCHMARK_JSON to a file path to save the results, e.g. on CI*/
+    const char * path = getenv("LVGL_BENCHMARK_JSON");
+    if(path) {
+        lv_demo_benchmark_get_json(json, sizeof(json));
+        FILE * f = fopen(path, "w");
+        TEST_ASSERT_NOT_NULL(f);
+        fputs(json, f);
+        fclose(f);
+    }
+
+    /*The rendered frames are the same in each run.
+     *The layer memory peak depends on the timing of the draw threads.*/
+    lv_demo_benchmark_run_headless(FRAME_CNT, FRAME_PERIOD, NULL);
+    uint32_t i;
+    for(i = 0; i < scene_cnt; i++) {
+        res = lv_demo_benchmark_get_result(i);
+        TEST_ASSERT_EQUAL_UINT32(task_cnt[i], res->draw_task_cnt);
+        TEST_ASSERT_EQUAL_UINT32(0, res->render_time_us);
+    }
+    TEST_ASSERT_EQUAL_UINT32(unit_cnt, draw_unit_cnt());
+#endif
+}
+
+#endif
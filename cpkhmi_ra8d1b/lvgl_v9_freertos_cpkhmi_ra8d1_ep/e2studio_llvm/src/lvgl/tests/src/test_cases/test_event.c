@@ -3,6 +3,26 @@
 
 #include "unity/unity.h"
 
+#define TREE_DEPTH      64
+#define ROUNDS          10
+
+void setUp(void)
+{
+    /* Function run before every test */
+}
+
+void tearDown(void)
+{
+    /* Function run after every test */
+    lv_obj_clean(lv_screen_active());
+}
+
+static void count_cb(lv_event_t * e)
+{
+    uint32_t * cnt = lv_event_get_user_data(e);
+    (*cnt)++;
+}
+
 static void event_object_deletion_cb(const lv_obj_class_t * cls, lv_event_t * e)
 {
     LV_UNUSED(cls);
@@ -23,4 +43,86 @@ void test_event_object_deletion(void)
     lv_obj_send_event(obj, LV_EVENT_VALUE_CHANGED, NULL);
 }
 
+void test_event_filter(void)
+{
+    lv_obj_t * obj = lv_obj_create(lv_screen_active());
+    uint32_t value_cnt = 0;
+    uint32_t all_cnt = 0;
+    uint32_t pre_cnt = 0;
+
+    lv_obj_add_event_cb(obj, count_cb, LV_EVENT_VALUE_CHANGED, &value_cnt);
+    lv_obj_send_event(obj, LV_EVENT_CLICKED, NULL);
+    TEST_ASSERT_EQUAL_UINT32(0, value_cnt);
+    lv_obj_send_event(obj, LV_EVENT_VALUE_CHANGED, NULL);
+    TEST_ASSERT_EQUAL_UINT32(1, value_cnt);
+
+    lv_obj_add_event_cb(obj, count_cb, LV_EVENT_ALL, &all_cnt);
+    lv_obj_add_event_cb(obj, count_cb, LV_EVENT_CLICKED | LV_EVENT_PREPROCESS, &pre_cnt);
+    lv_obj_send_event(obj, LV_EVENT_CLICKED, NULL);
+    lv_obj_send_event(obj, LV_EVENT_VALUE_CHANGED, NULL);
+    TEST_ASSERT_EQUAL_UINT32(2, value_cnt);
+    TEST_ASSERT_EQUAL_UINT32(2, all_cnt);
+    TEST_ASSERT_EQUAL_UINT32(1, pre_cnt);
+
+    /*The other callbacks still get their events after removing one*/
+    TEST_ASSERT_TRUE(lv_obj_remove_event_cb_with_user_data(obj, count_cb, &all_cnt));
+    lv_obj_send_event(obj, LV_EVENT_CLICKED, NULL);
+    lv_obj_send_event(obj, LV_EVENT_VALUE_CHANGED, NULL);
+    lv_obj_send_event(obj, LV_EVENT_PRESSED, NULL);
+    TEST_ASSERT_EQUAL_UINT32(3, value_cnt);
+    TEST_ASSERT_EQUAL_UINT32(2, all_cnt);
+    TEST_ASSERT_EQUAL_UINT32(2, pre_cnt);
+
+    /*Registered events share a bit but are still called only for their own code*/
+    uint32_t custom_code_1 = lv_event_register_id();
+    uint32_t custom_code_2 = lv_event_register_id();
+    uint32_t custom_cnt = 0;
+    lv_obj_add_event_cb(obj, count_cb, custom_code_1, &custom_cnt);
+    lv_obj_send_event(obj, custom_code_2, NULL);
+    TEST_ASSERT_EQUAL_UINT32(0, custom_cnt);
+    lv_obj_send_event(obj, custom_code_1, NULL);
+    TEST_ASSERT_EQUAL_UINT32(1, custom_cnt);
+}
+
+void test_event_deep_tree(void)
+{
+    static lv_obj_t * objs[TREE_DEPTH];
+    lv_obj_t * parent = lv_screen_active();
+    uint32_t other_cnt = 0;
+    uint32_t i;
+    for(i = 0; i < TREE_DEPTH; i++) {
+        objs[i] = lv_obj_create(parent);
+        /*Typical objects with callbacks for other events*/
+        lv_obj_add_event_cb(objs[i], count_cb, LV_EVENT_CLICKED, &other_cnt);
+        lv_obj_add_event_cb(objs[i], count_cb, LV_EVENT_VALUE_CHANGED | LV_EVENT_PREPROCESS, &other_cnt);
+        if(i > 0) lv_obj_add_flag(objs[i], LV_OBJ_FLAG_EVENT_BUBBLE);
+        parent = objs[i];
+    }
+
+    uint32_t draw_cnt = 0;
+    uint32_t pressing_cnt = 0;
+    lv_obj_add_event_cb(objs[0], count_cb, LV_EVENT_DRAW_MAIN_BEGIN, &draw_cnt);
+    lv_obj_add_event_cb(objs[0], count_cb, LV_EVENT_PRESSING, &pressing_cnt);
+
+    /*Only the lists with a callback for the code need to be walked*/
+    lv_event_list_t * list = &objs[TREE_DEPTH - 1]->spec_attr->event_list;
+    TEST_ASSERT_FALSE(lv_event_list_has_code(list, LV_EVENT_DRAW_MAIN_BEGIN));
+    TEST_ASSERT_FALSE(lv_event_list_has_code(list, LV_EVENT_PRESSING));
+    TEST_ASSERT_TRUE(lv_event_list_has_code(list, LV_EVENT_CLICKED));
+    TEST_ASSERT_TRUE(lv_event_list_has_code(&objs[0]->spec_attr->event_list, LV_EVENT_PRESSING));
+
+    /*Send a per-frame event to each object and bubble an event from the deepest one*/
+    uint32_t r;
+    for(r = 0; r < ROUNDS; r++) {
+        for(i = 0; i < TREE_DEPTH; i++) {
+            lv_obj_send_event(objs[i], LV_EVENT_DRAW_MAIN_BEGIN, NULL);
+        }
+        lv_obj_send_event(objs[TREE_DEPTH - 1], LV_EVENT_PRESSING, NULL);
+    }
+
+    TEST_ASSERT_EQUAL_UINT32(ROUNDS, draw_cnt);
+    TEST_ASSERT_EQUAL_UINT32(ROUNDS, pressing_cnt);
+    TEST_ASSERT_EQUAL_UINT32(0, other_cnt);
+}
+
 #endif
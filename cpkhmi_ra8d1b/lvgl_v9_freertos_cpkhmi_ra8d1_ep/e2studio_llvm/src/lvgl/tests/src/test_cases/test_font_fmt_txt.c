@@ -0,0 +1,117 @@
+#if LV_BUILD_TEST
+#include "../lvgl.h"
+
+#include "unity/unity.h"
+
+#include "../../src/core/lv_global.h"
+#include <time.h>
+
+#define BENCH_ROUNDS    1000
+#define BENCH_TEXT      "Temperature 23.5 C, Humidity 41%"   /*A working set that fits into the cache*/
+
+/*Both fonts are generated with the same options, only the compression differs*/
+static const lv_font_t * font_plain = &lv_font_montserrat_28;
+static const lv_font_t * font_compressed = &lv_font_montserrat_28_compressed;
+
+static lv_draw_buf_t * glyph_bitmap(const lv_font_t * font, uint32_t letter)
+{
+    lv_font_glyph_dsc_t g;
+    if(!lv_font_get_glyph_dsc(font, &g, letter, 0)) return NULL;
+    if(g.box_w == 0 || g.box_h == 0) return NULL;
+
+    lv_draw_buf_t * draw_buf = lv_draw_buf_create(g.box_w, g.box_h, LV_COLOR_FORMAT_A8, LV_STRIDE_AUTO);
+    TEST_ASSERT_NOT_NULL(draw_buf);
+    TEST_ASSERT_NOT_NULL(lv_font_get_glyph_bitmap(&g, letter, draw_buf));
+
+    return draw_buf;
+}
+
+static void check_glyphs(void)
+{
+    uint32_t letter;
+    for(letter = 0x21; letter < 0x7F; letter++) {
+        lv_draw_buf_t * expected = glyph_bitmap(font_plain, letter);
+        lv_draw_buf_t * decoded = glyph_bitmap(font_compressed, letter);
+        TEST_ASSERT_NOT_NULL(expected);
+        TEST_ASSERT_NOT_NULL(decoded);
+
+        uint32_t y;
+        for(y = 0; y < expected->header.h; y++) {
+            TEST_ASSERT_EQUAL_MEMORY((uint8_t *)expected->data + y * expected->header.stride,
+                                     (uint8_t *)decoded->data + y * decoded->header.stride, expected->header.w);
+        }
+
+        lv_draw_buf_destroy(expected);
+        lv_draw_buf_destroy(decoded);
+    }
+}
+
+static double glyphs_per_sec(void)
+{
+    lv_font_glyph_dsc_t g;
+    lv_draw_buf_t * draw_buf = lv_draw_buf_create(64, 64, LV_COLOR_FORMAT_A8, LV_STRIDE_AUTO);
+    uint32_t glyphs = 0;
+    uint32_t i;
+    const char * c;
+
+    clock_t start = clock();
+    for(i = 0; i < BENCH_ROUNDS; i++) {
+        for(c = BENCH_TEXT; *c; c++) {
+            uint32_t letter = (uint32_t) * c;
+            lv_font_get_glyph_dsc(font_compressed, &g, letter, 0);
+            lv_draw_buf_reshape(draw_buf, LV_COLOR_FORMAT_A8, g.box_w, g.box_h, LV_STRIDE_AUTO);
+            lv_font_get_glyph_bitmap(&g, letter, draw_buf);
+            glyphs++;
+        }
+    }
+    double sec = (double)(clock() - start) / CLOCKS_PER_SEC;
+
+    lv_draw_buf_destroy(draw_buf);
+    return sec > 0 ? glyphs / sec : 0;
+}
+
+void setUp(void)
+{
+    lv_font_fmt_txt_cache_drop(font_compressed);
+}
+
+void tearDown(void)
+{
+    /* Function run after every test */
+}
+
+void test_font_fmt_txt_decompress(void)
+{
+    lv_cache_t * cache = LV_GLOBAL_DEFAULT()->font_fmt_txt_cache;
+    LV_GLOBAL_DEFAULT()->font_fmt_txt_cache = NULL;
+
+    check_glyphs();
+
+    LV_GLOBAL_DEFAULT()->font_fmt_txt_cache = cache;
+}
+
+void test_font_fmt_txt_cache(void)
+{
+    TEST_ASSERT_NOT_NULL(LV_GLOBAL_DEFAULT()->font_fmt_txt_cache);
+
+    check_glyphs();     /*Decompressed into the cache*/
+    check_glyphs();     /*Copied from the cache*/
+
+    lv_font_fmt_txt_cache_drop(font_compressed);
+    check_glyphs();
+}
+
+void test_font_fmt_txt_benchmark(void)
+{
+    lv_cache_t * cache = LV_GLOBAL_DEFAULT()->font_fmt_txt_cache;
+    LV_GLOBAL_DEFAULT()->font_fmt_txt_cache = NULL;
+    double uncached = glyphs_per_sec();
+    LV_GLOBAL_DEFAULT()->font_fmt_txt_cache = cache;
+
+    double cached = glyphs_per_sec();
+
+    TEST_PRINTF("montserrat_28_compressed: %d glyphs/s decompressed, %d glyphs/s cached",
+                (int)uncached, (int)cached);
+}
+
+#endif
@@ -0,0 +1,205 @@
+#if LV_BUILD_TEST
+#include "../lvgl.h"
+
+#include "unity/unity.h"
+
+#include <time.h>
+
+#define ITEM_CNT        1200
+#define GRID_COLS       12
+#define GRID_ROWS       (ITEM_CNT / GRID_COLS)
+#define BENCH_ROUNDS    10
+
+static void layout_changed_cb(lv_event_t * e)
+{
+    uint32_t * cnt = lv_event_get_user_data(e);
+    (*cnt)++;
+}
+
+static lv_obj_t * cont_create(lv_obj_t * parent)
+{
+    lv_obj_t * cont = lv_obj_create(parent);
+    lv_obj_remove_style_all(cont);
+    return cont;
+}
+
+static void count_layout_changes(lv_obj_t * cont, uint32_t * cnt)
+{
+    *cnt = 0;
+    lv_obj_add_event_cb(cont, layout_changed_cb, LV_EVENT_LAYOUT_CHANGED, cnt);
+}
+
+static int32_t grid_row_h(uint32_t row)
+{
+    return 5 + row % 3;
+}
+
+static lv_obj_t * item_create(lv_obj_t * parent, int32_t w, int32_t h)
+{
+    lv_obj_t * item = lv_obj_create(parent);
+    lv_obj_remove_style_all(item);
+    lv_obj_set_size(item, w, h);
+    return item;
+}
+
+static lv_obj_t * flex_create(lv_obj_t * parent)
+{
+    lv_obj_t * cont = cont_create(parent);
+    lv_obj_set_size(cont, 400, LV_SIZE_CONTENT);
+    lv_obj_set_flex_flow(cont, LV_FLEX_FLOW_ROW_WRAP);
+
+    uint32_t i;
+    for(i = 0; i < ITEM_CNT; i++) {
+        item_create(cont, 10 + i % 5, 10);
+    }
+
+    return cont;
+}
+
+static lv_obj_t * grid_create(lv_obj_t * parent)
+{
+    static int32_t col_dsc[GRID_COLS + 1];
+    static int32_t row_dsc[GRID_ROWS + 1];
+    uint32_t i;
+    for(i = 0; i < GRID_COLS; i++) col_dsc[i] = LV_GRID_CONTENT;
+    col_dsc[GRID_COLS] = LV_GRID_TEMPLATE_LAST;
+    for(i = 0; i < GRID_ROWS; i++) row_dsc[i] = LV_GRID_CONTENT;
+    row_dsc[GRID_ROWS] = LV_GRID_TEMPLATE_LAST;
+
+    lv_obj_t * cont = cont_create(parent);
+    lv_obj_set_size(cont, LV_SIZE_CONTENT, LV_SIZE_CONTENT);
+    lv_obj_set_grid_dsc_array(cont, col_dsc, row_dsc);
+
+    for(i = 0; i < ITEM_CNT; i++) {
+        uint32_t col = i % GRID_COLS;
+        uint32_t row = i / GRID_COLS;
+        lv_obj_t * item = item_create(cont, 10 + col, grid_row_h(row));
+        lv_obj_set_grid_cell(item, LV_GRID_ALIGN_START, col, 1, LV_GRID_ALIGN_START, row, 1);
+    }
+
+    return cont;
+}
+
+/*Relayout after resizing a single child, return the time of one round in microseconds*/
+static uint32_t relayout_time(lv_obj_t * cont)
+{
+    lv_obj_t * item = lv_obj_get_child(cont, ITEM_CNT / 2);
+    int32_t w = lv_obj_get_width(item);
+    uint32_t i;
+
+    clock_t start = clock();
+    for(i = 0; i < BENCH_ROUNDS; i++) {
+        lv_obj_set_width(item, i & 1 ? w : w + 1);
+        lv_obj_update_layout(cont);
+    }
+    double sec = (double)(clock() - start) / CLOCKS_PER_SEC;
+
+    return (uint32_t)(sec * 1000000 / BENCH_ROUNDS);
+}
+
+void setUp(void)
+{
+    /* Function run before every test */
+}
+
+void tearDown(void)
+{
+    lv_obj_clean(lv_screen_active());
+}
+
+void test_layout_stress_grid_content_tracks(void)
+{
+    lv_obj_t * cont = grid_create(lv_screen_active());
+    lv_obj_update_layout(cont);
+
+    /*Every column is as wide as its items, every row as high as its highest item*/
+    int32_t h = 0;
+    uint32_t row;
+    for(row = 0; row < GRID_ROWS; row++) h += grid_row_h(row);
+    TEST_ASSERT_EQUAL_INT32(GRID_COLS * 10 + GRID_COLS * (GRID_COLS - 1) / 2, lv_obj_get_width(cont));
+    TEST_ASSERT_EQUAL_INT32(h, lv_obj_get_height(cont));
+
+    lv_obj_t * item = lv_obj_get_child(cont, GRID_COLS * 4 + 3);
+    TEST_ASSERT_EQUAL_INT32(10 + 11 + 12, lv_obj_get_x(item));
+    TEST_ASSERT_EQUAL_INT32(5 + 6 + 7 + 5, lv_obj_get_y(item));
+
+    /*A wider item makes its whole column wider*/
+    lv_obj_set_width(lv_obj_get_child(cont, GRID_COLS * 7 + 1), 30);
+    lv_obj_update_layout(cont);
+    TEST_ASSERT_EQUAL_INT32(10 + 30 + 12, lv_obj_get_x(item));
+}
+
+void test_layout_stress_only_dirty_subtree(void)
+{
+    lv_obj_t * flex = flex_create(lv_screen_active());
+    lv_obj_t * grid = grid_create(lv_screen_active());
+    lv_obj_update_layout(lv_screen_active());
+
+    uint32_t flex_cnt;
+    uint32_t grid_cnt;
+    count_layout_changes(flex, &flex_cnt);
+    count_layout_changes(grid, &grid_cnt);
+    int32_t grid_w = lv_obj_get_width(grid);
+
+    /*Changing an item of the flex container must not relayout the grid*/
+    lv_obj_t * item = lv_obj_get_child(flex, 10);
+    lv_obj_set_width(item, 40);
+    lv_obj_update_layout(lv_screen_active());
+    TEST_ASSERT_NOT_EQUAL(0, flex_cnt);
+    TEST_ASSERT_EQUAL_UINT32(0, grid_cnt);
+    TEST_ASSERT_EQUAL_INT32(40, lv_obj_get_width(item));
+
+    flex_cnt = 0;
+    lv_obj_set_width(lv_obj_get_child(grid, 0), 50);
+    lv_obj_update_layout(lv_screen_active());
+    TEST_ASSERT_EQUAL_UINT32(0, flex_cnt);
+    TEST_ASSERT_NOT_EQUAL(0, grid_cnt);
+    TEST_ASSERT_EQUAL_INT32(grid_w + 40, lv_obj_get_width(grid));
+
+    /*Nothing is dirty, nothing to do*/
+    flex_cnt = 0;
+    grid_cnt = 0;
+    lv_obj_update_layout(lv_screen_active());
+    TEST_ASSERT_EQUAL_UINT32(0, flex_cnt);
+    TEST_ASSERT_EQUAL_UINT32(0, grid_cnt);
+}
+
+void test_layout_stress_nested_dirty(void)
+{
+    /*A change deep in the tree still has to reach the top through the content sized containers*/
+    lv_obj_t * parent = lv_screen_active();
+    lv_obj_t * leaf = NULL;
+    uint32_t i;
+    for(i = 0; i < 10; i++) {
+        lv_obj_t * cont = cont_create(parent);
+        lv_obj_set_size(cont, LV_SIZE_CONTENT, LV_SIZE_CONTENT);
+        lv_obj_set_flex_flow(cont, LV_FLEX_FLOW_COLUMN);
+        item_create(cont, 10, 10);
+        leaf = item_create(cont, 10, 10);
+        parent = cont;
+    }
+
+    lv_obj_t * top = lv_obj_get_child(lv_screen_active(), 0);
+    lv_obj_update_layout(lv_screen_active());
+    TEST_ASSERT_EQUAL_INT32(20, lv_obj_get_height(parent));
+    TEST_ASSERT_EQUAL_INT32(10 * 20, lv_obj_get_height(top));
+
+    lv_obj_set_height(leaf, 15);
+    lv_obj_update_layout(lv_screen_active());
+    TEST_ASSERT_EQUAL_INT32(25, lv_obj_get_height(parent));
+    TEST_ASSERT_EQUAL_INT32(10 * 20 + 5, lv_obj_get_height(top));
+}
+
+void test_layout_stress_benchmark(void)
+{
+    lv_obj_t * flex = flex_create(lv_screen_active());
+    lv_obj_t * grid = grid_create(lv_screen_active());
+    lv_obj_update_layout(lv_screen_active());
+
+    uint32_t flex_us = relayout_time(flex);
+    uint32_t grid_us = relayout_time(grid);
+
+    TEST_PRINTF("%d children: flex relayout %d us, grid relayout %d us", ITEM_CNT, (int)flex_us, (int)grid_us);
+}
+
+#endif
@@ -0,0 +1,214 @@
+#if LV_BUILD_TEST
+#include "../lvgl.h"
+
+#include "unity/unity.h"
+#include "lv_test_indev.h"
+
+#define FB_SIZE (800 * 480 * 4)
+
+static uint8_t fb_scrolled[FB_SIZE];
+static uint32_t draw_cnt;
+
+static void draw_main_cb(lv_event_t * e)
+{
+    LV_UNUSED(e);
+    draw_cnt++;
+}
+
+static uint8_t * fb_get(void)
+{
+    extern uint8_t * last_flushed_buf;
+    return lv_draw_buf_align(last_flushed_buf, LV_COLOR_FORMAT_ARGB8888);
+}
+
+/*Scroll with the mouse as the `LV_STATE_SCROLLED` state is kept only while the list is dragged*/
+static void drag_start(lv_obj_t * list)
+{
+    lv_area_t coords;
+    lv_obj_get_coords(list, &coords);
+    lv_test_mouse_move_to(lv_area_get_width(&coords) / 2 + coords.x1, lv_area_get_height(&coords) / 2 + coords.y1);
+    lv_test_mouse_press();
+    lv_test_indev_wait(50);
+}
+
+static void drag_in_steps(int32_t dx, int32_t dy, uint32_t steps)
+{
+    uint32_t i;
+    for(i = 0; i < steps; i++) {
+        lv_test_mouse_move_by(dx, dy);
+        lv_test_indev_wait(50);
+    }
+}
+
+static lv_obj_t * list_create(void)
+{
+    lv_obj_t * list = lv_list_create(lv_screen_active());
+    lv_obj_set_size(lv_screen_active(), 800, 480);
+    lv_obj_set_size(list, 300, 360);
+    lv_obj_center(list);
+    lv_obj_set_style_radius(list, 12, 0);
+    lv_obj_set_scrollbar_mode(list, LV_SCROLLBAR_MODE_ON);
+
+    uint32_t i;
+    for(i = 0; i < 40; i++) {
+        lv_list_add_button(list, LV_SYMBOL_FILE, "List item");
+    }
+
+    /*A button which remains in the middle while scrolling*/
+    lv_obj_add_event_cb(lv_obj_get_child(list, 5), draw_main_cb, LV_EVENT_DRAW_MAIN, NULL);
+
+    lv_obj_invalidate(lv_screen_active());
+    lv_refr_now(NULL);
+
+    return list;
+}
+
+/*The moved pixels needs to be the same as the fully redrawn ones*/
+static void test_same_as_redrawn(void)
+{
+    lv_memcpy(fb_scrolled, fb_get(), FB_SIZE);
+
+    lv_obj_invalidate(lv_screen_active());
+    lv_refr_now(NULL);
+
+    TEST_ASSERT_EQUAL_MEMORY(fb_get(), fb_scrolled, FB_SIZE);
+}
+
+void setUp(void)
+{
+    draw_cnt = 0;
+}
+
+void tearDown(void)
+{
+    lv_test_mouse_release();
+    lv_test_indev_wait(1000);
+    lv_obj_clean(lv_screen_active());
+    lv_obj_clean(lv_layer_top());
+}
+
+void test_scroll_blit_down(void)
+{
+    lv_obj_t * list = list_create();
+
+    drag_start(list);
+    drag_in_steps(0, -7, 30);
+    test_same_as_redrawn();
+}
+
+void test_scroll_blit_up(void)
+{
+    lv_obj_t * list = list_create();
+    lv_obj_scroll_to_y(list, 600, LV_ANIM_OFF);
+    lv_refr_now(NULL);
+
+    drag_start(list);
+    drag_in_steps(0, 13, 20);
+    test_same_as_redrawn();
+}
+
+void test_scroll_blit_horizontal(void)
+{
+    lv_obj_t * list = list_create();
+    lv_obj_t * wide = lv_obj_create(list);
+    lv_obj_set_size(wide, 600, 40);
+    lv_obj_set_style_bg_color(wide, lv_palette_main(LV_PALETTE_RED), 0);
+    lv_obj_t * label = lv_label_create(wide);
+    lv_label_set_text(label, "A wide item with a long text to scroll horizontally");
+    lv_obj_move_to_index(wide, 2);
+    lv_refr_now(NULL);
+
+    drag_start(list);
+    drag_in_steps(-9, 0, 20);
+    test_same_as_redrawn();
+}
+
+void test_scroll_blit_with_changing_children(void)
+{
+    lv_obj_t * list = list_create();
+    lv_obj_t * btn = lv_obj_get_child(list, 3);
+    lv_obj_t * floating = lv_button_create(list);
+    lv_obj_add_flag(floating, LV_OBJ_FLAG_FLOATING);
+    lv_obj_align(floating, LV_ALIGN_BOTTOM_RIGHT, 0, 0);
+    lv_refr_now(NULL);
+
+    drag_start(list);
+    drag_in_steps(0, -6, 3);
+
+    uint32_t i;
+    for(i = 0; i < 10; i++) {
+        lv_obj_set_style_bg_color(btn, lv_palette_main(i % 2 ? LV_PALETTE_RED : LV_PALETTE_BLUE), 0);
+        drag_in_steps(0, -6, 1);
+    }
+
+    test_same_as_redrawn();
+}
+
+void test_scroll_blit_twice_in_one_refresh(void)
+{
+    lv_obj_t * list = list_create();
+    lv_obj_set_scrollbar_mode(list, LV_SCROLLBAR_MODE_OFF);
+    lv_obj_t * btn = lv_obj_get_child(list, 8);
+    lv_refr_now(NULL);
+
+    /*The button is invalidated between the two scrolls.
+     *Scroll back to not have its new place between its old places.
+     *Scroll without the scroll events as they would change the state and invalidate the list.*/
+    _lv_obj_scroll_by_raw(list, 0, -200);
+    lv_obj_set_style_bg_color(btn, lv_palette_main(LV_PALETTE_RED), 0);
+    _lv_obj_scroll_by_raw(list, 0, 100);
+    lv_refr_now(NULL);
+
+    test_same_as_redrawn();
+}
+
+void test_scroll_blit_redraws_only_the_exposed_part(void)
+{
+    lv_obj_t * list = list_create();
+    lv_obj_set_scrollbar_mode(list, LV_SCROLLBAR_MODE_OFF);
+    drag_start(list);
+    drag_in_steps(0, -7, 3);
+
+    /*Wait for the style transitions of the scrolled state*/
+    lv_test_indev_wait(500);
+
+    draw_cnt = 0;
+    drag_in_steps(0, -7, 10);
+    TEST_ASSERT_EQUAL_UINT32(0, draw_cnt);
+    test_same_as_redrawn();
+}
+
+void test_scroll_blit_falls_back_to_redraw(void)
+{
+    lv_obj_t * list = list_create();
+    lv_obj_set_scrollbar_mode(list, LV_SCROLLBAR_MODE_OFF);
+    lv_obj_set_style_bg_grad_color(list, lv_palette_main(LV_PALETTE_GREEN), 0);
+    lv_obj_set_style_bg_grad_dir(list, LV_GRAD_DIR_VER, 0);
+    drag_start(list);
+    drag_in_steps(0, -7, 3);
+
+    /*Wait for the style transitions of the scrolled state*/
+    lv_test_indev_wait(500);
+
+    draw_cnt = 0;
+    drag_in_steps(0, -7, 10);
+    TEST_ASSERT_EQUAL_UINT32(10, draw_cnt);
+    test_same_as_redrawn();
+}
+
+void test_scroll_blit_under_top_layer(void)
+{
+    lv_obj_t * list = list_create();
+    lv_obj_t * overlay = lv_obj_create(lv_layer_top());
+    lv_obj_set_size(overlay, 100, 100);
+    lv_obj_center(overlay);
+    lv_obj_set_style_bg_opa(overlay, LV_OPA_50, 0);
+    lv_obj_remove_flag(overlay, LV_OBJ_FLAG_CLICKABLE);
+    lv_refr_now(NULL);
+
+    drag_start(list);
+    drag_in_steps(0, -7, 10);
+    test_same_as_redrawn();
+}
+
+#endif
@@ -0,0 +1,90 @@
+#if LV_BUILD_TEST
+#include "../lvgl.h"
+
+#include "unity/unity.h"
+
+#include <string.h>
+
+#define BUF_SIZE    320
+#define GUARD       8
+
+static uint8_t src_buf[BUF_SIZE + 2 * GUARD];
+static uint8_t dst_buf[BUF_SIZE + 2 * GUARD];
+static uint8_t ref_buf[BUF_SIZE + 2 * GUARD];
+
+static const size_t lengths[] = {0, 1, 2, 3, 4, 5, 7, 8, 15, 16, 17, 31, 32, 33, 63, 64, 65, 100, 255, 256, 257, BUF_SIZE - GUARD};
+
+void setUp(void)
+{
+    uint32_t i;
+    for(i = 0; i < sizeof(src_buf); i++) src_buf[i] = (uint8_t)(i * 7 + 3);
+}
+
+void tearDown(void)
+{
+    /* Function run after every test */
+}
+
+void test_string_memcpy_alignments(void)
+{
+    uint32_t s_ofs;
+    uint32_t d_ofs;
+    uint32_t i;
+
+    for(s_ofs = 0; s_ofs < GUARD; s_ofs++) {
+        for(d_ofs = 0; d_ofs < GUARD; d_ofs++) {
+            for(i = 0; i < sizeof(lengths) / sizeof(lengths[0]); i++) {
+                size_t len = lengths[i];
+                memset(dst_buf, 0xAA, sizeof(dst_buf));
+                memset(ref_buf, 0xAA, sizeof(ref_buf));
+
+                void * res = lv_memcpy(dst_buf + GUARD + d_ofs, src_buf + GUARD + s_ofs, len);
+                memcpy(ref_buf + GUARD + d_ofs, src_buf + GUARD + s_ofs, len);
+
+                TEST_ASSERT_EQUAL_PTR(dst_buf + GUARD + d_ofs, res);
+                TEST_ASSERT_EQUAL_MEMORY(ref_buf, dst_buf, sizeof(dst_buf));
+            }
+        }
+    }
+}
+
+void test_string_memset_alignments(void)
+{
+    uint32_t d_ofs;
+    uint32_t i;
+
+    for(d_ofs = 0; d_ofs < GUARD; d_ofs++) {
+        for(i = 0; i < sizeof(lengths) / sizeof(lengths[0]); i++) {
+            size_t len = lengths[i];
+            memset(dst_buf, 0xAA, sizeof(dst_buf));
+            memset(ref_buf, 0xAA, sizeof(ref_buf));
+
+            lv_memset(dst_buf + GUARD + d_ofs, 0x5C, len);
+            memset(ref_buf + GUARD + d_ofs, 0x5C, len);
+
+            TEST_ASSERT_EQUAL_MEMORY(ref_buf, dst_buf, sizeof(dst_buf));
+        }
+    }
+}
+
+void test_string_memmove_overlap(void)
+{
+    uint32_t ofs;
+
+    /*Both directions, closer and farther than a word*/
+    for(ofs = 1; ofs < 2 * GUARD; ofs++) {
+        memcpy(dst_buf, src_buf, sizeof(dst_buf));
+        memcpy(ref_buf, src_buf, sizeof(ref_buf));
+        lv_memmove(dst_buf, dst_buf + ofs, 200);
+        memmove(ref_buf, ref_buf + ofs, 200);
+        TEST_ASSERT_EQUAL_MEMORY(ref_buf, dst_buf, sizeof(dst_buf));
+
+        memcpy(dst_buf, src_buf, sizeof(dst_buf));
+        memcpy(ref_buf, src_buf, sizeof(ref_buf));
+        lv_memmove(dst_buf + ofs, dst_buf, 200);
+        memmove(ref_buf + ofs, ref_buf, 200);
+        TEST_ASSERT_EQUAL_MEMORY(ref_buf, dst_buf, sizeof(dst_buf));
+    }
+}
+
+#endif
@@ -2,6 +2,8 @@
 #include "../lvgl.h"
 
 #include "unity/unity.h"
+#include "lv_test_indev.h"
+#include <string.h>
 
 static lv_obj_t * scr = NULL;
 static lv_obj_t * table = NULL;
@@ -264,4 +266,140 @@ void test_table_should_reduce_cells_with_more_than_one_row(void)
     }
 }
 
+/*Press the table at `y` (relative to the first row) and return the pressed row*/
+static uint32_t press_row_at(int32_t y)
+{
+    lv_obj_update_layout(table);
+    int32_t y_abs = y - lv_obj_get_scroll_y(table) + table->coords.y1 + lv_obj_get_style_pad_top(table, LV_PART_MAIN);
+    lv_test_mouse_move_to(table->coords.x1 + 10, y_abs);
+    lv_test_mouse_press();
+    lv_test_indev_wait(50);
+
+    uint32_t row;
+    uint32_t col;
+    lv_table_get_selected_cell(table, &row, &col);
+
+    lv_test_mouse_release();
+    lv_test_indev_wait(50);
+    return row;
+}
+
+void test_table_row_positions_should_follow_row_heights(void)
+{
+    lv_table_t * table_ptr = (lv_table_t *) table;
+    lv_obj_set_height(table, 300);
+
+    uint32_t row;
+    for(row = 0; row < 200; row++) {
+        lv_table_set_cell_value(table, row, 0, row % 7 ? "Row" : "Row\nwith\nlines");
+    }
+
+    /*Change the height of some rows after the others were added*/
+    lv_table_set_cell_value(table, 30, 0, "Taller\nrow");
+    lv_table_set_cell_value(table, 35, 0, "Lower");
+    lv_table_set_row_count(table, 150);
+
+    int32_t y = 0;
+    for(row = 0; row < 150; row++) {
+        if(row % 10 == 0) {
+            lv_obj_scroll_to_y(table, y, LV_ANIM_OFF);
+            TEST_ASSERT_EQUAL_UINT32(row, press_row_at(y + table_ptr->row_h[row] / 2));
+        }
+        y += table_ptr->row_h[row];
+    }
+
+    /*The table reports the coordinate of its last pixel as self size*/
+    lv_obj_update_layout(table);
+    TEST_ASSERT_EQUAL_INT32(y - 1, lv_obj_get_self_height(table));
+}
+
+static uint32_t cell_value_cb_cnt;
+
+static const char * cell_value_cb(lv_obj_t * obj, uint32_t row, uint32_t col, void * user_data)
+{
+    LV_UNUSED(obj);
+    static char buf[32];
+    cell_value_cb_cnt++;
+
+    if(col == 1) return NULL;
+    lv_snprintf(buf, sizeof(buf), "%s %" LV_PRIu32, (const char *)user_data, row);
+    return buf;
+}
+
+void test_table_data_source_should_handle_many_rows(void)
+{
+    lv_table_t * table_ptr = (lv_table_t *) table;
+    lv_table_set_cell_value(table, 0, 0, "Stored");
+    lv_table_set_column_count(table, 2);
+    lv_table_set_cell_value_cb(table, cell_value_cb, "Log");
+    lv_table_set_row_count(table, 100000);
+    lv_obj_set_height(table, 300);
+
+    TEST_ASSERT_NULL(table_ptr->cell_data);
+    TEST_ASSERT_NULL(table_ptr->row_h);
+    TEST_ASSERT_EQUAL_UINT32(100000, lv_table_get_row_count(table));
+    TEST_ASSERT_EQUAL_STRING("Log 0", lv_table_get_cell_value(table, 0, 0));
+    TEST_ASSERT_EQUAL_STRING("", lv_table_get_cell_value(table, 0, 1));
+
+    /*The setters are ignored*/
+    lv_table_set_cell_value(table, 5, 0, "Stored");
+    lv_table_add_cell_ctrl(table, 5, 0, LV_TABLE_CELL_CTRL_MERGE_RIGHT);
+    TEST_ASSERT_EQUAL_STRING("Log 5", lv_table_get_cell_value(table, 5, 0));
+    TEST_ASSERT_FALSE(lv_table_has_cell_ctrl(table, 5, 0, LV_TABLE_CELL_CTRL_MERGE_RIGHT));
+
+    lv_obj_update_layout(table);
+    int32_t row_h = table_ptr->virtual_row_h;
+    TEST_ASSERT_GREATER_THAN(0, row_h);
+    TEST_ASSERT_EQUAL_INT32(100000 * row_h - 1, lv_obj_get_self_height(table));
+
+    /*Only the visible rows are fetched*/
+    lv_obj_scroll_to_y(table, 70000 * row_h, LV_ANIM_OFF);
+    cell_value_cb_cnt = 0;
+    lv_obj_invalidate(table);
+    lv_refr_now(NULL);
+    TEST_ASSERT_GREATER_THAN(0, cell_value_cb_cnt);
+    TEST_ASSERT_LESS_OR_EQUAL(2 * (300 / row_h + 2), cell_value_cb_cnt);
+
+    TEST_ASSERT_EQUAL_UINT32(70003, press_row_at(70003 * row_h + row_h / 2));
+
+    /*Back to stored cells*/
+    lv_table_set_cell_value_cb(table, NULL, NULL);
+    TEST_ASSERT_EQUAL_STRING("", lv_table_get_cell_value(table, 5, 0));
+    lv_table_set_cell_value(table, 5, 0, "Stored");
+    TEST_ASSERT_EQUAL_STRING("Stored", lv_table_get_cell_value(table, 5, 0));
+
+    lv_table_set_row_count(table, 10);
+    lv_obj_scroll_to_y(table, 0, LV_ANIM_OFF);
+    TEST_ASSERT_EQUAL_UINT32(5, press_row_at(5 * table_ptr->row_h[0] + 1));
+}
+
+void test_table_data_source_should_draw_the_texts_of_deferred_cells(void)
+{
+    static uint8_t canvas_buf[LV_CANVAS_BUF_SIZE(200, 200, 32, LV_DRAW_BUF_STRIDE_ALIGN)];
+    lv_obj_t * canvas = lv_canvas_create(scr);
+    lv_canvas_set_buffer(canvas, canvas_buf, 200, 200, LV_COLOR_FORMAT_XRGB8888);
+    lv_canvas_fill_bg(canvas, lv_color_white(), LV_OPA_COVER);
+
+    lv_table_set_cell_value_cb(table, cell_value_cb, "Log");
+    lv_table_set_row_count(table, 2);
+    lv_obj_set_size(table, 200, 200);
+    lv_obj_update_layout(table);
+
+    /*The tasks of a canvas layer are drawn only by `lv_canvas_finish_layer`,
+     *i.e. after the callback was called for all the cells*/
+    lv_layer_t layer;
+    lv_canvas_init_layer(canvas, &layer);
+    lv_obj_redraw(&layer, table);
+    lv_canvas_finish_layer(canvas, &layer);
+
+    lv_area_t content;
+    lv_obj_get_content_coords(table, &content);
+    int32_t row_h = ((lv_table_t *) table)->virtual_row_h;
+    lv_draw_buf_t * draw_buf = lv_canvas_get_draw_buf(canvas);
+    uint32_t stride = draw_buf->header.stride;
+    const uint8_t * row_0 = (const uint8_t *)draw_buf->data + content.y1 * stride;
+    const uint8_t * row_1 = row_0 + row_h * stride;
+    TEST_ASSERT_NOT_EQUAL(0, memcmp(row_0, row_1, row_h * stride));
+}
+
 #endif
@@ -0,0 +1,245 @@
+/*
+* Copyright (c) 2020 - 2024 Renesas Electronics Corporation and/or its affiliates
+*
+* SPDX-License-Identifier: BSD-3-Clause
+*/
+
+/*********************
+ *      INCLUDES
+ *********************/
+#include "lv_port_fs_ospi.h"
+
+#if LV_USE_FS_OSPI
+
+#include "../ospi_asset.h"
+
+/*********************
+ *      DEFINES
+ *********************/
+
+/**********************
+ *      TYPEDEFS
+ **********************/
+typedef struct {
+    const ospi_asset_entry_t * entry;
+    const uint8_t * data;
+    uint32_t pos;
+} ospi_file_t;
+
+typedef struct {
+    uint32_t index;
+} ospi_dir_t;
+
+/**********************
+ *  STATIC PROTOTYPES
+ **********************/
+static void * fs_open(lv_fs_drv_t * drv, const char * path, lv_fs_mode_t mode);
+static lv_fs_res_t fs_close(lv_fs_drv_t * drv, void * file_p);
+static lv_fs_res_t fs_read(lv_fs_drv_t * drv, void * file_p, void * buf, uint32_t btr, uint32_t * br);
+static lv_fs_res_t fs_seek(lv_fs_drv_t * drv, void * file_p, uint32_t pos, lv_fs_whence_t whence);
+static lv_fs_res_t fs_tell(lv_fs_drv_t * drv, void * file_p, uint32_t * pos_p);
+
+static void * fs_dir_open(lv_fs_drv_t * drv, const char * path);
+static lv_fs_res_t fs_dir_read(lv_fs_drv_t * drv, void * rddir_p, char * fn, uint32_t fn_len);
+static lv_fs_res_t fs_dir_close(lv_fs_drv_t * drv, void * rddir_p);
+
+/**********************
+ *  STATIC VARIABLES
+ **********************/
+static ospi_asset_store_t store;
+static lv_image_dsc_t * image_dscs;     /*One per asset, built on first use*/
+
+/**********************
+ *      MACROS
+ **********************/
+
+/**********************
+ *   GLOBAL FUNCTIONS
+ **********************/
+
+lv_result_t lv_port_fs_ospi_init(void)
+{
+    if(!ospi_asset_mount(&store, (const void *)LV_FS_OSPI_ADDRESS)) {
+        LV_LOG_WARN("no asset store at 0x%08x", (unsigned int)LV_FS_OSPI_ADDRESS);
+        return LV_RESULT_INVALID;
+    }
+
+    static lv_fs_drv_t fs_drv;
+    lv_fs_drv_init(&fs_drv);
+
+    fs_drv.letter = LV_FS_OSPI_LETTER;
+    fs_drv.open_cb = fs_open;
+    fs_drv.close_cb = fs_close;
+    fs_drv.read_cb = fs_read;
+    fs_drv.seek_cb = fs_seek;
+    fs_drv.tell_cb = fs_tell;
+
+    fs_drv.dir_close_cb = fs_dir_close;
+    fs_drv.dir_open_cb = fs_dir_open;
+    fs_drv.dir_read_cb = fs_dir_read;
+
+    lv_fs_drv_register(&fs_drv);
+
+    return LV_RESULT_OK;
+}
+
+const lv_image_dsc_t * lv_port_fs_ospi_image(const char * name)
+{
+    const ospi_asset_entry_t * entry = ospi_asset_find(&store, name);
+    if(entry == NULL || entry->type != OSPI_ASSET_TYPE_IMAGE) return NULL;
+
+    if(image_dscs == NULL) {
+        image_dscs = lv_malloc_zeroed(sizeof(lv_image_dsc_t) * ospi_asset_count(&store));
+        LV_ASSERT_MALLOC(image_dscs);
+        if(image_dscs == NULL) return NULL;
+    }
+
+    lv_image_dsc_t * dsc = &image_dscs[entry - ospi_asset_at(&store, 0)];
+    if(dsc->data == NULL) {
+        dsc->header.magic = LV_IMAGE_HEADER_MAGIC;
+        dsc->header.cf = entry->cf;
+        dsc->header.w = entry->w;
+        dsc->header.h = entry->h;
+        dsc->header.stride = entry->stride;
+        dsc->data_size = entry->size;
+        dsc->data = ospi_asset_data(&store, entry);
+    }
+
+    return dsc;
+}
+
+/**********************
+ *   STATIC FUNCTIONS
+ **********************/
+
+/**
+ * Open an asset for reading. The store is read only.
+ * @param drv   pointer to a driver where this function belongs
+ * @param path  asset name, e.g. "/font_20.bin"
+ * @param mode  only LV_FS_MODE_RD
+ * @return      a file descriptor or NULL on error
+ */
+static void * fs_open(lv_fs_drv_t * drv, const char * path, lv_fs_mode_t mode)
+{
+    LV_UNUSED(drv);
+
+    if(mode != LV_FS_MODE_RD) return NULL;
+
+    const ospi_asset_entry_t * entry = ospi_asset_find(&store, path);
+    if(entry == NULL) return NULL;
+
+    ospi_file_t * file = lv_malloc(sizeof(ospi_file_t));
+    if(file == NULL) return NULL;
+
+    file->entry = entry;
+    file->data = ospi_asset_data(&store, entry);
+    file->pos = 0;
+
+    return file;
+}
+
+static lv_fs_res_t fs_close(lv_fs_drv_t * drv, void * file_p)
+{
+    LV_UNUSED(drv);
+
+    lv_free(file_p);
+
+    return LV_FS_RES_OK;
+}
+
+/**
+ * Read from an asset. This is a copy out of the XIP window, images should use lv_port_fs_ospi_image() instead.
+ */
+static lv_fs_res_t fs_read(lv_fs_drv_t * drv, void * file_p, void * buf, uint32_t btr, uint32_t * br)
+{
+    LV_UNUSED(drv);
+
+    ospi_file_t * file = file_p;
+    uint32_t left = file->entry->size - file->pos;
+    if(btr > left) btr = left;
+
+    lv_memcpy(buf, file->data + file->pos, btr);
+    file->pos += btr;
+    *br = btr;
+
+    return LV_FS_RES_OK;
+}
+
+static lv_fs_res_t fs_seek(lv_fs_drv_t * drv, void * file_p, uint32_t pos, lv_fs_whence_t whence)
+{
+    LV_UNUSED(drv);
+
+    ospi_file_t * file = file_p;
+    uint32_t size = file->entry->size;
+
+    switch(whence) {
+        case LV_FS_SEEK_SET:
+            break;
+        case LV_FS_SEEK_CUR:
+            pos += file->pos;
+            break;
+        case LV_FS_SEEK_END:
+            pos += size;
+            break;
+        default:
+            return LV_FS_RES_INV_PARAM;
+    }
+
+    file->pos = LV_MIN(pos, size);
+
+    return LV_FS_RES_OK;
+}
+
+static lv_fs_res_t fs_tell(lv_fs_drv_t * drv, void * file_p, uint32_t * pos_p)
+{
+    LV_UNUSED(drv);
+
+    *pos_p = ((ospi_file_t *)file_p)->pos;
+
+    return LV_FS_RES_OK;
+}
+
+/**
+ * List the assets. The store is flat, so only the root can be opened.
+ */
+static void * fs_dir_open(lv_fs_drv_t * drv, const char * path)
+{
+    LV_UNUSED(drv);
+
+    while(*path == '/') path++;
+    if(*path != '\0') return NULL;
+
+    return lv_malloc_zeroed(sizeof(ospi_dir_t));
+}
+
+static lv_fs_res_t fs_dir_read(lv_fs_drv_t * drv, void * rddir_p, char * fn, uint32_t fn_len)
+{
+    LV_UNUSED(drv);
+
+    ospi_dir_t * dir = rddir_p;
+    const ospi_asset_entry_t * entry = ospi_asset_at(&store, dir->index);
+
+    if(fn_len == 0) return LV_FS_RES_INV_PARAM;
+
+    if(entry == NULL) {
+        fn[0] = '\0';
+    }
+    else {
+        lv_strncpy(fn, entry->name, fn_len - 1);
+        fn[fn_len - 1] = '\0';
+        dir->index++;
+    }
+
+    return LV_FS_RES_OK;
+}
+
+static lv_fs_res_t fs_dir_close(lv_fs_drv_t * drv, void * rddir_p)
+{
+    LV_UNUSED(drv);
+
+    lv_free(rddir_p);
+
+    return LV_FS_RES_OK;
+}
+
+#endif /*LV_USE_FS_OSPI*/
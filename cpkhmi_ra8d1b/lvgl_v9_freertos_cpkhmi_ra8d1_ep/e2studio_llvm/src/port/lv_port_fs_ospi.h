@@ -0,0 +1,63 @@
+
+/*
+* Copyright (c) 2020 - 2024 Renesas Electronics Corporation and/or its affiliates
+*
+* SPDX-License-Identifier: BSD-3-Clause
+*/
+
+#ifndef LV_PORT_FS_OSPI_H
+#define LV_PORT_FS_OSPI_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*********************
+ *      INCLUDES
+ *********************/
+#if defined(LV_LVGL_H_INCLUDE_SIMPLE)
+#include "lvgl.h"
+#else
+#include "lvgl/lvgl.h"
+#endif
+
+#if LV_USE_FS_OSPI
+
+/*********************
+ *      DEFINES
+ *********************/
+
+/**********************
+ *      TYPEDEFS
+ **********************/
+
+/**********************
+ * GLOBAL PROTOTYPES
+ **********************/
+
+/**
+ * Mount the asset store at LV_FS_OSPI_ADDRESS and register it as drive LV_FS_OSPI_LETTER.
+ * The OSPI has to be open and memory-mapped already (see the ospi_nor example).
+ * @return  LV_RESULT_OK if a valid store was found
+ */
+lv_result_t lv_port_fs_ospi_init(void);
+
+/**
+ * Image descriptor of an image asset, with the pixel data left in place in the OSPI window.
+ * Can be passed to lv_image_set_src(); Dave2D reads the pixels straight from flash.
+ * @param name  asset name, e.g. "logo"
+ * @return      descriptor, or NULL if there is no image asset with that name
+ */
+const lv_image_dsc_t * lv_port_fs_ospi_image(const char * name);
+
+/**********************
+ *      MACROS
+ **********************/
+
+#endif /*LV_USE_FS_OSPI*/
+
+#ifdef __cplusplus
+} /*extern "C"*/
+#endif
+
+#endif /*LV_PORT_FS_OSPI_H*/
@@ -35,8 +35,6 @@
 
 static void touchpad_init(void);
 static void touchpad_read(lv_indev_t * indev, lv_indev_data_t * data);
-static bool touchpad_is_pressed(void);
-static void touchpad_get_xy(int32_t * x, int32_t * y, touch_event_t * touch);
 #if 0
 static void mouse_init(void);
 static void mouse_read(lv_indev_t * indev, lv_indev_data_t * data);
@@ -60,6 +58,7 @@ static bool button_is_pressed(uint8_t id);
  *  STATIC VARIABLES
  **********************/
 lv_indev_t * indev_touchpad;
+static touch_sample_t touch_sample;  /*The last report passed to LVGL*/
 #if 0
 lv_indev_t * indev_mouse;
 lv_indev_t * indev_keypad;
@@ -179,6 +178,17 @@ void lv_port_indev_init(void)
 #endif
 }
 
+uint32_t lv_port_indev_get_touch_points(lv_point_t * points)
+{
+    uint32_t i;
+    for(i = 0; i < touch_sample.point_cnt; i++) {
+        points[i].x = (int32_t)touch_sample.points[i].x;
+        points[i].y = (int32_t)touch_sample.points[i].y;
+    }
+
+    return touch_sample.point_cnt;
+}
+
 /**********************
  *   STATIC FUNCTIONS
  **********************/
@@ -190,27 +200,33 @@ void lv_port_indev_init(void)
 /*Initialize your touchpad*/
 static void touchpad_init(void)
 {
+    fsp_err_t err;
 
+    /*The touch thread reads the GT911 and queues the reports*/
+    err = touch_task_start(&g_i2c_master1_ctrl);
+    if (FSP_SUCCESS != err)
+    {
+        __BKPT(0);
+    }
 }
 
-/*Will be called by the library to read the touchpad*/
+/*Will be called by the library to read the touchpad.
+ *Takes the queued reports in order (buffered mode); the last one is kept until a new comes.*/
 static void touchpad_read(lv_indev_t * indev_drv, lv_indev_data_t * data)
 {
     FSP_PARAMETER_NOT_USED(indev_drv);
     static int32_t last_x = 0;
     static int32_t last_y = 0;
 
-    static touch_event_t touch_event = TOUCH_EVENT_NONE;
+    if(touch_sample_get(&touch_sample)) {
+        data->continue_reading = touch_sample_count() != 0;
+    }
 
     /*Save the pressed coordinates and the state*/
-    if(touchpad_is_pressed()) {
-        touchpad_get_xy(&last_x, &last_y, &touch_event);
-        if ((TOUCH_EVENT_DOWN == touch_event) || (TOUCH_EVENT_MOVE == touch_event))
-        {
-            data->state = LV_INDEV_STATE_PRESSED;
-        } else {
-            data->state = LV_INDEV_STATE_RELEASED;
-        }
+    if(touch_sample.point_cnt != 0) {
+        last_x = (int32_t)touch_sample.points[0].x;
+        last_y = (int32_t)touch_sample.points[0].y;
+        data->state = LV_INDEV_STATE_PRESSED;
     }
     else {
         data->state = LV_INDEV_STATE_RELEASED;
@@ -221,74 +237,6 @@ static void touchpad_read(lv_indev_t * indev_drv, lv_indev_data_t * data)
     data->point.y = last_y;
 }
 
-/*Return true is the touchpad is pressed*/
-static bool touchpad_is_pressed(void)
-{
-    BaseType_t status;
-    bool touch_pressed = false;
-
-    status = xSemaphoreTake( g_irq_binary_semaphore, 0 );
-    if(pdTRUE == status)
-    {
-        touch_pressed = true;
-    }
-
-    return touch_pressed;
-}
-
-/*Get the x and y coordinates if the touchpad is pressed*/
-static void touchpad_get_xy(int32_t * x, int32_t * y, touch_event_t * touch_event)
-{
-    fsp_err_t err;
-        uint32_t number_of_coordinates;
-        uint8_t read_data[7];
-
-        TouchCordinate_t coordinates[6];
-        memset(coordinates, 0, sizeof(TouchCordinate_t));
-
-        err = rdSensorReg16_8(&g_i2c_master1_ctrl, GT911_REG_READ_COORD_ADDR, read_data);
-        if (FSP_SUCCESS != err)
-        {
-            __BKPT(0); //TODO: Better error handling
-        }
-
-        if (BUFFER_READY == (BUFFER_READY & read_data[0]))
-        {
-            number_of_coordinates = (read_data[0] & NUM_TOUCH_POINTS_MASK);
-            if (number_of_coordinates != 0)
-            {
-                for (uint8_t i = 0; i < number_of_coordinates; i++)
-                {
-                    err = rdSensorReg16_Multi(&g_i2c_master1_ctrl, (uint16_t)(GT911_REG_POINT1_X_ADDR + (i * 8)), read_data, 7 );
-                    if (FSP_SUCCESS != err)
-                    {
-                        __BKPT(0); //TODO: Better error handling
-                    }
-
-                    coordinates[i].x = (uint16_t)((read_data[2] << 8) | read_data[1]);
-                    coordinates[i].y = (uint16_t)((read_data[4] << 8) | read_data[3]);
-
-                }
-                *touch_event = TOUCH_EVENT_DOWN;
-            }
-            else
-            {
-                *touch_event = TOUCH_EVENT_UP;
-            }
-
-            /* Set status to 0, to wait for next touch event */
-            err = wrSensorReg16_8(&g_i2c_master1_ctrl, GT911_REG_READ_COORD_ADDR, 0);
-            if (FSP_SUCCESS != err)
-            {
-                __BKPT(0); //TODO: Better error handling
-            }
-        }
-
-        if(*touch_event == TOUCH_EVENT_MOVE || *touch_event == TOUCH_EVENT_DOWN) {
-            (*x) = (int32_t)coordinates[0].x;
-            (*y) = (int32_t)coordinates[0].y;
-        }
-}
 #if 0
 /*------------------
  * Mouse
@@ -30,6 +30,7 @@ extern "C" {
 /*********************
  *      DEFINES
  *********************/
+#define LV_PORT_INDEV_TOUCH_POINT_MAX   5
 
 /**********************
  *      TYPEDEFS
@@ -40,6 +41,13 @@ extern "C" {
  **********************/
 void lv_port_indev_init(void);
 
+/**
+ * Get all the touch points of the last report passed to LVGL, e.g. for multi-touch gestures.
+ * @param points    array of `LV_PORT_INDEV_TOUCH_POINT_MAX` elements to store the points
+ * @return          number of the pressed points
+ */
+uint32_t lv_port_indev_get_touch_points(lv_point_t * points);
+
 /**********************
  *      MACROS
  **********************/
@@ -17,9 +17,24 @@
 //#define WRITE_GT11_FW
 //#define DUMP_GT911_REGS
 
+/* The touch task reads the coordinates on the GT911 interrupt so the LVGL thread never waits for I2C */
+#define TOUCH_TASK_STACK_WORDS   512
+#define TOUCH_TASK_PRIORITY      2      /* Above the LVGL thread */
+#define TOUCH_QUEUE_LEN          8      /* Must be a power of 2 */
+
 
 
 static fsp_err_t productId(i2c_master_ctrl_t * p_api_ctr, char *target);
+static void touch_task_entry(void * pvParameters);
+static bool touch_read_sample(i2c_master_ctrl_t * p_api_ctrl, touch_sample_t * sample);
+static void touch_queue_push(const touch_sample_t * sample);
+
+/* Single producer (touch task), single consumer (LVGL thread) ring buffer.
+ * Only the touch task writes the head and only the LVGL thread writes the tail, so no lock is needed.
+ * A published report is never modified, so the reader can't see a half written one. */
+static touch_sample_t touch_queue[TOUCH_QUEUE_LEN];
+static volatile uint32_t touch_queue_head;
+static volatile uint32_t touch_queue_tail;
 
 #ifdef DUMP_GT911_REGS
 uint8_t g_read_config[184];
@@ -276,3 +291,119 @@ fsp_err_t enable_ts(i2c_master_ctrl_t * p_api_i2c_ctrl, external_irq_ctrl_t * p_
 
     return err;
 }
+
+fsp_err_t touch_task_start(i2c_master_ctrl_t * p_api_ctrl)
+{
+    BaseType_t status;
+
+    status = xTaskCreate(touch_task_entry, "Touch Thread", TOUCH_TASK_STACK_WORDS, (void *)p_api_ctrl,
+                         TOUCH_TASK_PRIORITY, NULL);
+
+    return (pdPASS == status) ? FSP_SUCCESS : FSP_ERR_OUT_OF_MEMORY;
+}
+
+/* Called from the LVGL thread. Returns the oldest report not read yet. */
+bool touch_sample_get(touch_sample_t * sample)
+{
+    uint32_t tail = touch_queue_tail;
+
+    if (tail == touch_queue_head)
+    {
+        return false;
+    }
+
+    /* Read the sample only after seeing the head which published it */
+    __DMB();
+    *sample = touch_queue[tail & (TOUCH_QUEUE_LEN - 1U)];
+    __DMB();
+    touch_queue_tail = tail + 1U;
+
+    return true;
+}
+
+uint32_t touch_sample_count(void)
+{
+    return touch_queue_head - touch_queue_tail;
+}
+
+static void touch_task_entry(void * pvParameters)
+{
+    i2c_master_ctrl_t * p_api_ctrl = (i2c_master_ctrl_t *)pvParameters;
+    touch_sample_t sample;
+
+    while (1)
+    {
+        /* Sleep until the GT911 has a new report. The I2C transfers wait on `g_i2c_event_group`. */
+        xSemaphoreTake(g_irq_binary_semaphore, portMAX_DELAY);
+
+        if (touch_read_sample(p_api_ctrl, &sample))
+        {
+            touch_queue_push(&sample);
+        }
+    }
+}
+
+/* Read all the points of a report with one transfer and acknowledge it */
+static bool touch_read_sample(i2c_master_ctrl_t * p_api_ctrl, touch_sample_t * sample)
+{
+    fsp_err_t err;
+    uint8_t status;
+    uint8_t read_data[GT911_MAX_TOUCH_POINTS * GT911_POINT_SIZE];
+
+    err = rdSensorReg16_8(p_api_ctrl, GT911_REG_READ_COORD_ADDR, &status);
+    if ((FSP_SUCCESS != err) || (BUFFER_READY != (BUFFER_READY & status)))
+    {
+        /* Nothing to report. A failed transfer is retried on the next interrupt. */
+        return false;
+    }
+
+    sample->point_cnt = (uint8_t)(status & NUM_TOUCH_POINTS_MASK);
+    if (sample->point_cnt > GT911_MAX_TOUCH_POINTS)
+    {
+        sample->point_cnt = GT911_MAX_TOUCH_POINTS;
+    }
+
+    if (sample->point_cnt != 0)
+    {
+        err = rdSensorReg16_Multi(p_api_ctrl, GT911_REG_POINT1_X_ADDR, read_data,
+                                  (uint32_t)(sample->point_cnt * GT911_POINT_SIZE));
+    }
+
+    if (FSP_SUCCESS == err)
+    {
+        for (uint8_t i = 0; i < sample->point_cnt; i++)
+        {
+            uint8_t * p_point = &read_data[i * GT911_POINT_SIZE];
+            sample->points[i].x = (uint16_t)((p_point[2] << 8) | p_point[1]);
+            sample->points[i].y = (uint16_t)((p_point[4] << 8) | p_point[3]);
+        }
+    }
+
+    /* Set status to 0, to wait for next touch event */
+    if (FSP_SUCCESS != wrSensorReg16_8(p_api_ctrl, GT911_REG_READ_COORD_ADDR, 0))
+    {
+        return false;
+    }
+
+    return (FSP_SUCCESS == err);
+}
+
+static void touch_queue_push(const touch_sample_t * sample)
+{
+    uint32_t head = touch_queue_head;
+    uint32_t free_cnt = TOUCH_QUEUE_LEN - (head - touch_queue_tail);
+
+    /* The LVGL thread is late. The last free slot is kept for a release, so a press or move is dropped
+     * when only that slot is left. A release can be dropped only when the queue is full, which means
+     * the last queued report is a release already and the dropped press/move reports were never queued. */
+    if ((0U == free_cnt) || ((1U == free_cnt) && (0U != sample->point_cnt)))
+    {
+        return;
+    }
+
+    touch_queue[head & (TOUCH_QUEUE_LEN - 1U)] = *sample;
+
+    /* Publish the head only after the sample is written */
+    __DMB();
+    touch_queue_head = head + 1U;
+}
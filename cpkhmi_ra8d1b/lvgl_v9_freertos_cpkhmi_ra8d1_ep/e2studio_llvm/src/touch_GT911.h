@@ -21,6 +21,15 @@ typedef enum
     TOUCH_EVENT_UP
 } touch_event_t;
 
+#define GT911_MAX_TOUCH_POINTS     5
+#define GT911_POINT_SIZE           8    /* Track id, x, y, size and a reserved byte per point */
+
+/* One coordinate report of the GT911 */
+typedef struct{
+    uint8_t  point_cnt;                                  /* 0: released */
+    TouchCordinate_t points[GT911_MAX_TOUCH_POINTS];
+}touch_sample_t;
+
 #define GT911_REG_PRODUCT_ID       0x8140
 #define GT911_REG_READ_COORD_ADDR  0x814E
 #define GT911_REG_POINT1_X_ADDR    0x814F
@@ -36,4 +45,7 @@ typedef enum
 
 fsp_err_t enable_ts(i2c_master_ctrl_t * p_api_i2c_ctrl, external_irq_ctrl_t * p_api_irq_ctrl);
 fsp_err_t init_ts(i2c_master_ctrl_t * p_api_ctrl);
+fsp_err_t touch_task_start(i2c_master_ctrl_t * p_api_ctrl);
+bool touch_sample_get(touch_sample_t * sample);
+uint32_t touch_sample_count(void);
 #endif
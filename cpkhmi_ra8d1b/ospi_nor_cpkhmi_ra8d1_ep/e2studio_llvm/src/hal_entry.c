@@ -24,6 +24,8 @@
 #include "hal_data.h"
 #include "ospi_b_ep.h"
 #include "ospi_b_commands.h"
+#include "ospi_asset_writer.h"
+#include "ospi_flash_job.h"
 
 void fsp_assert(fsp_err_t err);
 
@@ -37,6 +39,8 @@ FSP_CPP_FOOTER
 void handle_error(fsp_err_t err,  const char *err_str);
 void fsp_assert(fsp_err_t err);
 void ospi_test_wait_until_wip(void);
+static void ospi_asset_demo(void);
+static void ospi_flash_job_demo(void);
 
 uint8_t g_write_data[256];
 uint8_t g_read_data[256];
@@ -142,6 +146,12 @@ void hal_entry(void)
           }
       }
 
+      /* 资源库：写入后直接在映射地址上使用 */
+      ospi_asset_demo();
+
+      /* 后台写入：擦写由 SysTick 中断推进，主循环不被阻塞 */
+      ospi_flash_job_demo();
+
       // happy path
       __BKPT(0);
 
@@ -171,6 +181,143 @@ void ospi_test_wait_until_wip(void)
     }
 }
 
+/*******************************************************************************************************************//**
+ * Build a small asset store (an RGB565 gradient image and a raw blob), mount it and check it in place
+ **********************************************************************************************************************/
+#define ASSET_DEMO_W            (64U)
+#define ASSET_DEMO_H            (32U)
+
+static uint16_t g_asset_demo_image[ASSET_DEMO_W * ASSET_DEMO_H];
+static ospi_asset_writer_t g_asset_writer;
+
+static void ospi_asset_demo(void)
+{
+    fsp_err_t                  err     = FSP_SUCCESS;
+    ospi_asset_store_t         store   = {RESET_VALUE};
+    ospi_asset_entry_t const * p_entry = NULL;
+
+    for (uint32_t y = 0; y < ASSET_DEMO_H; y++)
+    {
+        for (uint32_t x = 0; x < ASSET_DEMO_W; x++)
+        {
+            g_asset_demo_image[y * ASSET_DEMO_W + x] = (uint16_t) (((x >> 1) << 11) | ((y << 1) << 5) | (x >> 1));
+        }
+    }
+
+    err = ospi_asset_writer_begin(&g_asset_writer, (uint8_t *) OSPI_ASSET_STORE_ADDRESS, 8U);
+    fsp_assert (err);
+    err = ospi_asset_writer_add_image(&g_asset_writer, "gradient", g_asset_demo_image, OSPI_ASSET_CF_RGB565,
+                                      ASSET_DEMO_W, ASSET_DEMO_H, ASSET_DEMO_W * sizeof(uint16_t));
+    fsp_assert (err);
+    err = ospi_asset_writer_add(&g_asset_writer, "pattern.bin", g_write_data, sizeof(g_write_data));
+    fsp_assert (err);
+    err = ospi_asset_writer_end(&g_asset_writer);
+    fsp_assert (err);
+
+    if (!ospi_asset_mount(&store, (void const *) OSPI_ASSET_STORE_ADDRESS))
+    {
+        fsp_assert (FSP_ERR_ASSERTION);
+    }
+
+    p_entry = ospi_asset_find(&store, "gradient");
+    if ((NULL == p_entry) || (OSPI_ASSET_TYPE_IMAGE != p_entry->type) || !ospi_asset_verify(&store, p_entry) ||
+        (0 != memcmp(ospi_asset_data(&store, p_entry), g_asset_demo_image, sizeof(g_asset_demo_image))))
+    {
+        fsp_assert (FSP_ERR_ASSERTION);
+    }
+
+    p_entry = ospi_asset_find(&store, "/pattern.bin");
+    if ((NULL == p_entry) || !ospi_asset_verify(&store, p_entry))
+    {
+        fsp_assert (FSP_ERR_ASSERTION);
+    }
+}
+
+/*******************************************************************************************************************//**
+ * Program 64KB through the job engine while the main loop keeps running, reading the window between suspend/resume
+ **********************************************************************************************************************/
+#define FLASH_JOB_DEMO_ADDRESS  ((uint8_t *) (OSPI_B_CS1_START_ADDRESS + 0x100000U))
+#define FLASH_JOB_DEMO_CHUNK    (16384U)
+#define FLASH_JOB_DEMO_JOBS     (4U)
+
+static uint8_t g_flash_job_src[FLASH_JOB_DEMO_CHUNK];
+static ospi_flash_job_t g_flash_jobs[FLASH_JOB_DEMO_JOBS];
+static volatile uint32_t g_flash_jobs_done;
+static volatile fsp_err_t g_flash_job_err;
+
+static void flash_job_demo_callback(ospi_flash_job_t * p_job, fsp_err_t result)
+{
+    FSP_PARAMETER_NOT_USED(p_job);
+
+    if (FSP_SUCCESS != result)
+    {
+        g_flash_job_err = result;
+    }
+    g_flash_jobs_done++;
+}
+
+static void ospi_flash_job_demo(void)
+{
+    fsp_err_t         err        = FSP_SUCCESS;
+    uint32_t          idle_loops = RESET_VALUE;
+    volatile uint32_t xip_word   = RESET_VALUE;
+
+    for (uint32_t i = 0; i < sizeof(g_flash_job_src); i++)
+    {
+        g_flash_job_src[i] = (uint8_t) (i * 7U + (i >> 8));
+    }
+
+    err = ospi_flash_job_open();
+    fsp_assert (err);
+    err = ospi_flash_job_region_set(FLASH_JOB_DEMO_ADDRESS, FLASH_JOB_DEMO_ADDRESS + OSPI_B_SECTOR_SIZE_256K);
+    fsp_assert (err);
+
+    for (uint32_t i = 0; i < FLASH_JOB_DEMO_JOBS; i++)
+    {
+        g_flash_jobs[i].type       = OSPI_FLASH_JOB_PROGRAM;
+        g_flash_jobs[i].p_dest     = FLASH_JOB_DEMO_ADDRESS + (i * FLASH_JOB_DEMO_CHUNK);
+        g_flash_jobs[i].p_src      = g_flash_job_src;
+        g_flash_jobs[i].size       = FLASH_JOB_DEMO_CHUNK;
+        g_flash_jobs[i].p_callback = flash_job_demo_callback;
+        err = ospi_flash_job_submit(&g_flash_jobs[i]);
+        fsp_assert (err);
+    }
+
+    /* The application keeps running; now and then it reads the flash in place, e.g. an image for the display */
+    while (g_flash_jobs_done < FLASH_JOB_DEMO_JOBS)
+    {
+        idle_loops++;
+        if (0U == (idle_loops % 100000U))
+        {
+            err = ospi_flash_job_suspend();
+            fsp_assert (err);
+            xip_word = *(volatile uint32_t *) OSPI_ASSET_STORE_ADDRESS;
+            err = ospi_flash_job_resume();
+            fsp_assert (err);
+        }
+    }
+    FSP_PARAMETER_NOT_USED(xip_word);
+    fsp_assert (g_flash_job_err);
+
+    /* Let a trailing erase-ahead finish */
+    while (ospi_flash_job_busy())
+    {
+    }
+    err = ospi_flash_job_close();
+    fsp_assert (err);
+
+#if defined(__DCACHE_PRESENT) && (__DCACHE_PRESENT == 1U)
+    SCB_InvalidateDCache_by_Addr(FLASH_JOB_DEMO_ADDRESS, (int32_t) (FLASH_JOB_DEMO_JOBS * FLASH_JOB_DEMO_CHUNK));
+#endif
+    for (uint32_t i = 0; i < FLASH_JOB_DEMO_JOBS; i++)
+    {
+        if (0 != memcmp(FLASH_JOB_DEMO_ADDRESS + (i * FLASH_JOB_DEMO_CHUNK), g_flash_job_src, FLASH_JOB_DEMO_CHUNK))
+        {
+            fsp_assert (FSP_ERR_ASSERTION);
+        }
+    }
+}
+
 /*******************************************************************************************************************//**
  * This function is called at various points during the startup process.  This implementation uses the event that is
  * called right before main() to set up the pins.
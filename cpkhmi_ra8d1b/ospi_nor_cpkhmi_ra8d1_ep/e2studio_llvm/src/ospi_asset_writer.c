@@ -0,0 +1,234 @@
+/***********************************************************************************************************************
+ * File Name    : ospi_asset_writer.c
+ * Description  : Builds an OSPI asset store in flash, see ospi_asset.h for the layout. Written once, e.g. by a
+ *                provisioning build, in whatever protocol the OSPI is set to (8D-8D-8D for speed).
+ **********************************************************************************************************************/
+
+/*
+* Copyright (c) 2024 Renesas Electronics Corporation and/or its affiliates
+*
+* SPDX-License-Identifier: BSD-3-Clause
+*/
+
+#include <string.h>
+#include "ospi_asset_writer.h"
+#include "ospi_b_ep.h"
+
+/*******************************************************************************************************************//**
+ * @addtogroup ospi_asset
+ * @{
+ **********************************************************************************************************************/
+
+#define OSPI_ASSET_ALIGN_UP(x)      (((x) + OSPI_ASSET_ALIGN - 1U) & ~(OSPI_ASSET_ALIGN - 1U))
+#define OSPI_ASSET_CACHE_LINE       (32U)
+
+static fsp_err_t ospi_asset_program (ospi_asset_writer_t * p_writer, uint8_t * p_dest, void const * p_src,
+                                     uint32_t size);
+static fsp_err_t ospi_asset_erase_ahead (ospi_asset_writer_t * p_writer, uint8_t const * p_end);
+static void      ospi_asset_invalidate (void const * p_addr, uint32_t size);
+
+/*******************************************************************************************************************//**
+ * @brief       Start a new store. Nothing is erased yet, sectors are erased just ahead of the data written to them.
+ * @param[out]  p_writer        Writer state
+ * @param[in]   p_base          Store address in the mapped window, sector aligned
+ * @param[in]   capacity        Index entries to reserve, up to OSPI_ASSET_WRITER_MAX
+ * @retval      FSP_SUCCESS     Upon successful operation
+ * @retval      FSP_ERR_INVALID_ARGUMENT    Unaligned base or capacity out of range
+ **********************************************************************************************************************/
+fsp_err_t ospi_asset_writer_begin (ospi_asset_writer_t * p_writer, uint8_t * p_base, uint32_t capacity)
+{
+    uint32_t sector = (OSPI_B_SECTOR_4K_END_ADDRESS < (uint32_t) p_base) ? OSPI_B_SECTOR_SIZE_256K : OSPI_B_SECTOR_SIZE_4K;
+
+    if ((0U != ((uint32_t) p_base % sector)) || (0U == capacity) || (OSPI_ASSET_WRITER_MAX < capacity))
+    {
+        return FSP_ERR_INVALID_ARGUMENT;
+    }
+
+    memset(p_writer, 0, sizeof(*p_writer));
+    p_writer->p_base       = p_base;
+    p_writer->capacity     = capacity;
+    p_writer->offset       = OSPI_ASSET_ALIGN_UP(sizeof(ospi_asset_header_t) + (capacity * sizeof(ospi_asset_entry_t)));
+    p_writer->p_erased_end = p_base;
+
+    return FSP_SUCCESS;
+}
+
+/*******************************************************************************************************************//**
+ * @brief       Append a raw asset.
+ * @param[in]   p_writer        Writer state
+ * @param[in]   p_name          Asset name, shorter than OSPI_ASSET_NAME_MAX
+ * @param[in]   p_data          Asset data, anywhere except the OSPI window
+ * @param[in]   size            Bytes
+ * @retval      FSP_SUCCESS     Upon successful operation
+ * @retval      FSP_ERR_OVERFLOW            The index is full
+ * @retval      FSP_ERR_INVALID_ARGUMENT    Name too long
+ * @retval      Any Other Error code apart from FSP_SUCCESS Unsuccessful operation
+ **********************************************************************************************************************/
+fsp_err_t ospi_asset_writer_add (ospi_asset_writer_t * p_writer, char const * p_name, void const * p_data, uint32_t size)
+{
+    fsp_err_t            err     = FSP_SUCCESS;
+    ospi_asset_entry_t * p_entry = NULL;
+
+    if (p_writer->count >= p_writer->capacity)
+    {
+        return FSP_ERR_OVERFLOW;
+    }
+    if (strlen(p_name) >= OSPI_ASSET_NAME_MAX)
+    {
+        return FSP_ERR_INVALID_ARGUMENT;
+    }
+
+    err = ospi_asset_program(p_writer, p_writer->p_base + p_writer->offset, p_data, size);
+    if (FSP_SUCCESS != err)
+    {
+        return err;
+    }
+
+    p_entry = &p_writer->entries[p_writer->count];
+    memset(p_entry, 0, sizeof(*p_entry));
+    strncpy(p_entry->name, p_name, OSPI_ASSET_NAME_MAX - 1U);
+    p_entry->offset = p_writer->offset;
+    p_entry->size   = size;
+    p_entry->crc    = ospi_asset_crc32(0U, p_data, size);
+    p_entry->type   = OSPI_ASSET_TYPE_RAW;
+
+    p_writer->count++;
+    p_writer->offset = OSPI_ASSET_ALIGN_UP(p_writer->offset + size);
+
+    return FSP_SUCCESS;
+}
+
+/*******************************************************************************************************************//**
+ * @brief       Append an image, stride * h bytes of pixel data in color format cf (OSPI_ASSET_CF_xxx).
+ **********************************************************************************************************************/
+fsp_err_t ospi_asset_writer_add_image (ospi_asset_writer_t * p_writer, char const * p_name, void const * p_data,
+                                       uint8_t cf, uint16_t w, uint16_t h, uint16_t stride)
+{
+    fsp_err_t            err     = ospi_asset_writer_add(p_writer, p_name, p_data, (uint32_t) stride * h);
+    ospi_asset_entry_t * p_entry = NULL;
+
+    if (FSP_SUCCESS == err)
+    {
+        p_entry         = &p_writer->entries[p_writer->count - 1U];
+        p_entry->type   = OSPI_ASSET_TYPE_IMAGE;
+        p_entry->cf     = cf;
+        p_entry->w      = w;
+        p_entry->h      = h;
+        p_entry->stride = stride;
+    }
+
+    return err;
+}
+
+/*******************************************************************************************************************//**
+ * @brief       Program the index and the header, which makes the store valid.
+ * @param[in]   p_writer        Writer state
+ * @retval      FSP_SUCCESS     Upon successful operation
+ * @retval      Any Other Error code apart from FSP_SUCCESS Unsuccessful operation
+ **********************************************************************************************************************/
+fsp_err_t ospi_asset_writer_end (ospi_asset_writer_t * p_writer)
+{
+    fsp_err_t       err    = FSP_SUCCESS;
+    uint8_t const * p_head = (uint8_t const *) &p_writer->header;
+    uint32_t        index  = p_writer->count * sizeof(ospi_asset_entry_t);
+    uint32_t        size   = sizeof(ospi_asset_header_t) + index;
+    uint32_t        first  = (size < OSPI_ASSET_PROGRAM_SIZE) ? size : OSPI_ASSET_PROGRAM_SIZE;
+
+    p_writer->header.magic      = OSPI_ASSET_MAGIC;
+    p_writer->header.version    = OSPI_ASSET_VERSION;
+    p_writer->header.count      = (uint16_t) p_writer->count;
+    p_writer->header.total_size = p_writer->offset;
+    p_writer->header.index_crc  = ospi_asset_crc32(0U, p_writer->entries, index);
+
+    /* Every chunk is programmed once, the one holding the magic last */
+    err = ospi_asset_program(p_writer, p_writer->p_base + first, p_head + first, size - first);
+    if (FSP_SUCCESS != err)
+    {
+        return err;
+    }
+    err = ospi_asset_program(p_writer, p_writer->p_base, p_head, first);
+
+    /* Drop whatever the CPU cached from the window while it was being programmed */
+    ospi_asset_invalidate(p_writer->p_base, p_writer->offset);
+
+    return err;
+}
+
+/*******************************************************************************************************************//**
+ * @brief       Program size bytes at p_dest in OSPI_ASSET_PROGRAM_SIZE pieces that never cross a page. Each piece
+ *              is staged in RAM and padded with 0xFF, which leaves erased flash untouched.
+ **********************************************************************************************************************/
+static fsp_err_t ospi_asset_program (ospi_asset_writer_t * p_writer, uint8_t * p_dest, void const * p_src,
+                                     uint32_t size)
+{
+    fsp_err_t       err   = FSP_SUCCESS;
+    uint8_t const * p_in  = (uint8_t const *) p_src;
+    uint8_t       * p_out = (uint8_t *) ((uint32_t) p_dest & ~(OSPI_ASSET_PROGRAM_SIZE - 1U));
+    uint32_t        lead  = (uint32_t) (p_dest - p_out);
+    uint32_t        chunk = 0U;
+    uint8_t         stage[OSPI_ASSET_PROGRAM_SIZE] BSP_ALIGN_VARIABLE(4);
+
+    err = ospi_asset_erase_ahead(p_writer, p_dest + size);
+    if (FSP_SUCCESS != err)
+    {
+        return err;
+    }
+
+    while (size > 0U)
+    {
+        chunk = OSPI_ASSET_PROGRAM_SIZE - lead;
+        chunk = (chunk < size) ? chunk : size;
+        memset(stage, 0xFF, sizeof(stage));
+        memcpy(&stage[lead], p_in, chunk);
+
+        err = R_OSPI_B_Write(&g_ospi_b_ctrl, stage, p_out, OSPI_ASSET_PROGRAM_SIZE);
+        fsp_assert (err);
+        err = ospi_b_wait_operation(OSPI_B_TIME_WRITE);
+        fsp_assert (err);
+
+        p_in  += chunk;
+        p_out += OSPI_ASSET_PROGRAM_SIZE;
+        size  -= chunk;
+        lead   = 0U;
+    }
+
+    return err;
+}
+
+/*******************************************************************************************************************//**
+ * @brief       Erase the sectors between the erased end and p_end, using the sector size of each address.
+ **********************************************************************************************************************/
+static fsp_err_t ospi_asset_erase_ahead (ospi_asset_writer_t * p_writer, uint8_t const * p_end)
+{
+    fsp_err_t err        = FSP_SUCCESS;
+    uint32_t  erase_time = 0U;
+
+    while (p_writer->p_erased_end < p_end)
+    {
+        err = ospi_b_erase_operation(p_writer->p_erased_end, &erase_time);
+        if (FSP_SUCCESS != err)
+        {
+            return err;
+        }
+        p_writer->p_erased_end += (OSPI_B_SECTOR_4K_END_ADDRESS < (uint32_t) p_writer->p_erased_end)
+                                  ? OSPI_B_SECTOR_SIZE_256K : OSPI_B_SECTOR_SIZE_4K;
+    }
+
+    return err;
+}
+
+static void ospi_asset_invalidate (void const * p_addr, uint32_t size)
+{
+#if defined(__DCACHE_PRESENT) && (__DCACHE_PRESENT == 1U)
+    uint32_t start = (uint32_t) p_addr & ~(OSPI_ASSET_CACHE_LINE - 1U);
+
+    SCB_InvalidateDCache_by_Addr((void *) start, (int32_t) (((uint32_t) p_addr + size) - start));
+#else
+    FSP_PARAMETER_NOT_USED(p_addr);
+    FSP_PARAMETER_NOT_USED(size);
+#endif
+}
+
+/*******************************************************************************************************************//**
+ * @} (end addtogroup ospi_asset)
+ **********************************************************************************************************************/
@@ -0,0 +1,56 @@
+/***********************************************************************************************************************
+ * File Name    : ospi_asset_writer.h
+ * Description  : Contains data structures and functions used in ospi_asset_writer.c
+ **********************************************************************************************************************/
+
+/*
+* Copyright (c) 2024 Renesas Electronics Corporation and/or its affiliates
+*
+* SPDX-License-Identifier: BSD-3-Clause
+*/
+
+#ifndef OSPI_ASSET_WRITER_H_
+#define OSPI_ASSET_WRITER_H_
+
+#include "hal_data.h"
+#include "ospi_asset.h"
+
+/*******************************************************************************************************************//**
+ * @addtogroup ospi_asset
+ * @{
+ **********************************************************************************************************************/
+
+/******************************************************************************
+ Macro definitions
+ ******************************************************************************/
+#define OSPI_ASSET_WRITER_MAX       (32U)       /* Assets per store */
+#define OSPI_ASSET_PROGRAM_SIZE     (64U)       /* Bytes per R_OSPI_B_Write(), the combination size of the driver */
+
+/******************************************************************************
+ Typedef definitions
+ ******************************************************************************/
+typedef struct st_ospi_asset_writer
+{
+    uint8_t          * p_base;
+    uint32_t           capacity;                        /* Index entries reserved in front of the data */
+    uint32_t           count;
+    uint32_t           offset;                          /* Next free data offset */
+    uint8_t          * p_erased_end;                    /* Flash is erased up to here */
+    ospi_asset_header_t header;                         /* Header and entries are the flash image of the index */
+    ospi_asset_entry_t entries[OSPI_ASSET_WRITER_MAX];
+} ospi_asset_writer_t;
+
+/******************************************************************************
+ Function prototypes
+ ******************************************************************************/
+fsp_err_t ospi_asset_writer_begin (ospi_asset_writer_t * p_writer, uint8_t * p_base, uint32_t capacity);
+fsp_err_t ospi_asset_writer_add (ospi_asset_writer_t * p_writer, char const * p_name, void const * p_data, uint32_t size);
+fsp_err_t ospi_asset_writer_add_image (ospi_asset_writer_t * p_writer, char const * p_name, void const * p_data,
+                                       uint8_t cf, uint16_t w, uint16_t h, uint16_t stride);
+fsp_err_t ospi_asset_writer_end (ospi_asset_writer_t * p_writer);
+
+/*******************************************************************************************************************//**
+ * @} (end addtogroup ospi_asset)
+ **********************************************************************************************************************/
+
+#endif /* OSPI_ASSET_WRITER_H_ */
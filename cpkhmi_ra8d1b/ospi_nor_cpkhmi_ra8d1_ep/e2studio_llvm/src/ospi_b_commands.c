@@ -133,6 +133,26 @@ spi_flash_direct_transfer_t g_ospi_b_direct_transfer [OSPI_B_TRANSFER_MAX] =
     .data_length    = OSPI_B_DATA_LENGTH_ONE,
     .dummy_cycles   = OSPI_B_DUMMY_CYCLE_READ_STATUS_SPI
     },
+    [OSPI_B_TRANSFER_SUSPEND_SPI] =
+    {
+    .command        = OSPI_B_COMMAND_SUSPEND_SPI,
+    .address        = OSPI_B_ADDRESS_DUMMY,
+    .data           = OSPI_B_DATA_DUMMY,
+    .command_length = OSPI_B_COMMAND_LENGTH_SPI,
+    .address_length = OSPI_B_ADDRESS_LENGTH_ZERO,
+    .data_length    = OSPI_B_DATA_LENGTH_ZERO,
+    .dummy_cycles   = OSPI_B_DUMMY_CYCLE_WRITE_SPI
+    },
+    [OSPI_B_TRANSFER_RESUME_SPI] =
+    {
+    .command        = OSPI_B_COMMAND_RESUME_SPI,
+    .address        = OSPI_B_ADDRESS_DUMMY,
+    .data           = OSPI_B_DATA_DUMMY,
+    .command_length = OSPI_B_COMMAND_LENGTH_SPI,
+    .address_length = OSPI_B_ADDRESS_LENGTH_ZERO,
+    .data_length    = OSPI_B_DATA_LENGTH_ZERO,
+    .dummy_cycles   = OSPI_B_DUMMY_CYCLE_WRITE_SPI
+    },
 
     /* Transfer structure for OPI mode */
     [OSPI_B_TRANSFER_WRITE_ENABLE_OPI] =
@@ -205,6 +225,26 @@ spi_flash_direct_transfer_t g_ospi_b_direct_transfer [OSPI_B_TRANSFER_MAX] =
     .data_length    = OSPI_B_DATA_LENGTH_FOUR,
     .dummy_cycles   = OSPI_B_DUMMY_CYCLE_READ_STATUS_OPI
     },
+    [OSPI_B_TRANSFER_SUSPEND_OPI] =
+    {
+    .command        = OSPI_B_COMMAND_SUSPEND_OPI,
+    .address        = OSPI_B_ADDRESS_DUMMY,
+    .data           = OSPI_B_DATA_DUMMY,
+    .command_length = OSPI_B_COMMAND_LENGTH_OPI,
+    .address_length = OSPI_B_ADDRESS_LENGTH_ZERO,
+    .data_length    = OSPI_B_DATA_LENGTH_ZERO,
+    .dummy_cycles   = OSPI_B_DUMMY_CYCLE_WRITE_OPI
+    },
+    [OSPI_B_TRANSFER_RESUME_OPI] =
+    {
+    .command        = OSPI_B_COMMAND_RESUME_OPI,
+    .address        = OSPI_B_ADDRESS_DUMMY,
+    .data           = OSPI_B_DATA_DUMMY,
+    .command_length = OSPI_B_COMMAND_LENGTH_OPI,
+    .address_length = OSPI_B_ADDRESS_LENGTH_ZERO,
+    .data_length    = OSPI_B_DATA_LENGTH_ZERO,
+    .dummy_cycles   = OSPI_B_DUMMY_CYCLE_WRITE_OPI
+    },
 };
 
 /*******************************************************************************************************************//**
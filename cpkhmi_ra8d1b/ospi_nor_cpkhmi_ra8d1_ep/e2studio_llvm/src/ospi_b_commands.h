@@ -41,6 +41,10 @@
 #define OSPI_B_COMMAND_READ_REGISTER_OPI            (0x6565)
 #define OSPI_B_COMMAND_READ_DEVICE_ID_SPI           (0x9F)
 #define OSPI_B_COMMAND_READ_DEVICE_ID_OPI           (0x9F9F)
+#define OSPI_B_COMMAND_SUSPEND_SPI                  (0x75)          // Program/erase suspend
+#define OSPI_B_COMMAND_SUSPEND_OPI                  (0x7575)
+#define OSPI_B_COMMAND_RESUME_SPI                   (0x7A)          // Program/erase resume
+#define OSPI_B_COMMAND_RESUME_OPI                   (0x7A7A)
 
 /* Macro for OSPI command length */
 #define OSPI_B_COMMAND_LENGTH_SPI                   (1U)
@@ -99,6 +103,8 @@ typedef enum e_ospi_b_transfer
     OSPI_B_TRANSFER_READ_VOLA_SPI,
     OSPI_B_TRANSFER_READ_DATA_SPI,
     OSPI_B_TRANSFER_READ_DEVICE_ID_SPI,
+    OSPI_B_TRANSFER_SUSPEND_SPI,
+    OSPI_B_TRANSFER_RESUME_SPI,
 
     OSPI_B_TRANSFER_WRITE_ENABLE_OPI,
     OSPI_B_TRANSFER_WRITE_CFR2V_OPI,
@@ -109,6 +115,8 @@ typedef enum e_ospi_b_transfer
     OSPI_B_TRANSFER_READ_CFR3V_OPI,
     OSPI_B_TRANSFER_READ_CFR5V_OPI,
     OSPI_B_TRANSFER_READ_DEVICE_ID_OPI,
+    OSPI_B_TRANSFER_SUSPEND_OPI,
+    OSPI_B_TRANSFER_RESUME_OPI,
     OSPI_B_TRANSFER_MAX
 } ospi_b_transfer_t;
 
@@ -0,0 +1,573 @@
+/***********************************************************************************************************************
+ * File Name    : ospi_flash_job.c
+ * Description  : Queued, non-blocking erase/program of the OSPI flash. Instead of spinning on the WIP bit, the engine
+ *                polls the status from a periodic tick and starts the next operation as soon as the device is ready,
+ *                so the application keeps running while firmware or assets are written.
+ **********************************************************************************************************************/
+
+/*
+* Copyright (c) 2024 Renesas Electronics Corporation and/or its affiliates
+*
+* SPDX-License-Identifier: BSD-3-Clause
+*/
+
+#include <string.h>
+#include "ospi_flash_job.h"
+#include "ospi_b_ep.h"
+#include "ospi_b_commands.h"
+
+/*******************************************************************************************************************//**
+ * @addtogroup ospi_flash_job
+ * @{
+ **********************************************************************************************************************/
+
+/******************************************************************************
+ Macro definitions
+ ******************************************************************************/
+#define OSPI_FLASH_JOB_TICKS(us)        ((((us) / 1000U) * OSPI_FLASH_JOB_TICK_HZ) / 1000U + 2U)
+#define OSPI_FLASH_JOB_ERASE_AHEAD      (OSPI_B_SECTOR_SIZE_256K)   /* Idle erase window beyond the last program */
+#define OSPI_FLASH_JOB_SUSPEND_US       (100U)                      /* Suspend latency, tSL is 40us or less */
+
+/******************************************************************************
+ Typedef definitions
+ ******************************************************************************/
+typedef struct st_ospi_flash_engine
+{
+    bool               open;
+    bool               in_flight;                           /* Erase or program started, WIP not yet cleared */
+    bool               suspended;                           /* Held by ospi_flash_job_suspend() */
+    bool               op_suspended;                        /* The device accepted a suspend command */
+    uint32_t           timeout;                             /* Ticks left for the operation in flight */
+    ospi_flash_job_t * p_op_job;                            /* Job of the operation, NULL for idle erase-ahead */
+    ospi_flash_job_t * p_head;
+    ospi_flash_job_t * p_tail;
+
+    /* Update region, programmed front to back and erased just ahead of the data */
+    uint8_t          * p_region_start;
+    uint8_t          * p_region_end;
+    uint8_t          * p_erased_end;
+    uint8_t          * p_written_end;
+    uint8_t          * p_erase_sector;                      /* Sector of the erase in flight that moved p_erased_end */
+    bool               erase_ahead_held;                    /* Idle erase-ahead failed, wait for the next job */
+
+    /* Double buffered staging, the next chunk is prepared while the current one programs */
+    uint8_t            stage[2][OSPI_FLASH_JOB_PROGRAM_SIZE];
+    uint32_t           stage_index;
+    uint32_t           staged;                              /* Job bytes in stage[stage_index], 0 if none */
+    uint8_t          * p_staged_dest;
+} ospi_flash_engine_t;
+
+/* External variables */
+extern spi_flash_direct_transfer_t g_ospi_b_direct_transfer [OSPI_B_TRANSFER_MAX];
+
+/******************************************************************************
+ Private global variables and functions
+ ******************************************************************************/
+static ospi_flash_engine_t g_flash_engine BSP_ALIGN_VARIABLE(4);
+
+static void      ospi_flash_job_issue (void);
+static void      ospi_flash_job_complete (fsp_err_t result);
+static fsp_err_t ospi_flash_job_erase_start (uint8_t * p_address);
+static fsp_err_t ospi_flash_job_program_start (ospi_flash_job_t * p_job);
+static void      ospi_flash_job_stage (ospi_flash_job_t * p_job);
+static uint32_t  ospi_flash_job_sector_size (uint8_t const * p_address);
+static bool      ospi_flash_job_in_region (uint8_t const * p_address);
+static bool      ospi_flash_job_pending (void);
+static void      ospi_flash_job_tick_start (void);
+static void      ospi_flash_job_tick_stop (void);
+
+/*******************************************************************************************************************//**
+ * @brief       Prepare the engine. g_ospi_b must be open and the flash configured.
+ * @retval      FSP_SUCCESS     Upon successful operation
+ * @retval      FSP_ERR_ALREADY_OPEN    Engine is open
+ **********************************************************************************************************************/
+fsp_err_t ospi_flash_job_open (void)
+{
+    if (g_flash_engine.open)
+    {
+        return FSP_ERR_ALREADY_OPEN;
+    }
+
+    memset(&g_flash_engine, 0, sizeof(g_flash_engine));
+
+#if OSPI_FLASH_JOB_USE_SYSTICK
+    SysTick->CTRL = SysTick_CTRL_CLKSOURCE_Msk;
+    SysTick->LOAD = (SystemCoreClock / OSPI_FLASH_JOB_TICK_HZ) - 1U;
+    SysTick->VAL  = 0U;
+    NVIC_SetPriority(SysTick_IRQn, OSPI_FLASH_JOB_TICK_PRIORITY);
+#endif
+
+    g_flash_engine.open = true;
+
+    return FSP_SUCCESS;
+}
+
+/*******************************************************************************************************************//**
+ * @brief       Stop the engine.
+ * @retval      FSP_SUCCESS     Upon successful operation
+ * @retval      FSP_ERR_IN_USE  Jobs are still pending
+ **********************************************************************************************************************/
+fsp_err_t ospi_flash_job_close (void)
+{
+    if (ospi_flash_job_busy())
+    {
+        return FSP_ERR_IN_USE;
+    }
+
+    ospi_flash_job_tick_stop();
+    g_flash_engine.open = false;
+
+    return FSP_SUCCESS;
+}
+
+/*******************************************************************************************************************//**
+ * @brief       Declare the area an update is about to program, e.g. a firmware slot or the asset store. Program jobs
+ *              in it erase each sector right before its first byte is written, and while the queue is empty the
+ *              engine erases up to OSPI_FLASH_JOB_ERASE_AHEAD past the last program, so the next job starts at once.
+ *              The region is expected to be written front to back. Pass NULL to clear it.
+ * @param[in]   p_start         Sector aligned start
+ * @param[in]   p_end           End, exclusive
+ * @retval      FSP_SUCCESS     Upon successful operation
+ * @retval      FSP_ERR_INVALID_ARGUMENT    Unaligned start or empty region
+ * @retval      FSP_ERR_IN_USE  Jobs are pending
+ **********************************************************************************************************************/
+fsp_err_t ospi_flash_job_region_set (uint8_t * p_start, uint8_t * p_end)
+{
+    if ((NULL != p_start) &&
+        ((p_end <= p_start) || (0U != ((uint32_t) p_start % ospi_flash_job_sector_size(p_start)))))
+    {
+        return FSP_ERR_INVALID_ARGUMENT;
+    }
+    if (ospi_flash_job_busy())
+    {
+        return FSP_ERR_IN_USE;
+    }
+
+    g_flash_engine.p_region_start   = p_start;
+    g_flash_engine.p_region_end     = (NULL != p_start) ? p_end : NULL;
+    g_flash_engine.p_erased_end     = p_start;
+    g_flash_engine.p_written_end    = p_start;
+    g_flash_engine.erase_ahead_held = false;
+
+    if (ospi_flash_job_pending() && !g_flash_engine.suspended)
+    {
+        ospi_flash_job_tick_start();
+    }
+
+    return FSP_SUCCESS;
+}
+
+/*******************************************************************************************************************//**
+ * @brief       Queue a job. It starts on the next tick, the callback reports the result.
+ * @param[in]   p_job           Job, owned by the caller until its callback
+ * @retval      FSP_SUCCESS     Upon successful operation
+ * @retval      FSP_ERR_NOT_OPEN            Engine is not open
+ * @retval      FSP_ERR_INVALID_ARGUMENT    Empty job, missing source or destination outside the mapped window
+ **********************************************************************************************************************/
+fsp_err_t ospi_flash_job_submit (ospi_flash_job_t * p_job)
+{
+    if (!g_flash_engine.open)
+    {
+        return FSP_ERR_NOT_OPEN;
+    }
+    if ((NULL == p_job) || (0U == p_job->size) || ((uint32_t) p_job->p_dest < OSPI_B_CS1_START_ADDRESS) ||
+        ((OSPI_FLASH_JOB_PROGRAM == p_job->type) && (NULL == p_job->p_src)))
+    {
+        return FSP_ERR_INVALID_ARGUMENT;
+    }
+
+    p_job->p_next = NULL;
+    p_job->done   = 0U;
+
+    /* The job may need the sector the idle erase-ahead failed on, let it retry the erase */
+    g_flash_engine.erase_ahead_held = false;
+
+    FSP_CRITICAL_SECTION_DEFINE;
+    FSP_CRITICAL_SECTION_ENTER;
+    if (NULL == g_flash_engine.p_tail)
+    {
+        g_flash_engine.p_head = p_job;
+    }
+    else
+    {
+        g_flash_engine.p_tail->p_next = p_job;
+    }
+    g_flash_engine.p_tail = p_job;
+    FSP_CRITICAL_SECTION_EXIT;
+
+    if (!g_flash_engine.suspended)
+    {
+        ospi_flash_job_tick_start();
+    }
+
+    return FSP_SUCCESS;
+}
+
+/*******************************************************************************************************************//**
+ * @brief       True while jobs are queued or an operation is in flight. Idle erase-ahead does not count.
+ **********************************************************************************************************************/
+bool ospi_flash_job_busy (void)
+{
+    return (NULL != g_flash_engine.p_head) || g_flash_engine.in_flight;
+}
+
+/*******************************************************************************************************************//**
+ * @brief       Hold the engine and suspend the erase or program in flight, so the mapped window can be read.
+ *              Keep the suspension short, the device rejects a new suspend until the operation made some progress.
+ * @retval      FSP_SUCCESS     Upon successful operation, the window is readable
+ * @retval      FSP_ERR_TIMEOUT The device did not suspend
+ * @retval      Any Other Error code apart from FSP_SUCCESS Unsuccessful operation
+ **********************************************************************************************************************/
+fsp_err_t ospi_flash_job_suspend (void)
+{
+    fsp_err_t                   err      = FSP_SUCCESS;
+    spi_flash_status_t          status   = {0};
+    spi_flash_direct_transfer_t transfer = {0};
+
+    /* With the tick off the poll cannot run, the engine state is ours */
+    ospi_flash_job_tick_stop();
+    if (g_flash_engine.suspended)
+    {
+        return FSP_SUCCESS;
+    }
+    g_flash_engine.suspended = true;
+
+    if (!g_flash_engine.in_flight)
+    {
+        return FSP_SUCCESS;
+    }
+
+    transfer = (SPI_FLASH_PROTOCOL_EXTENDED_SPI == g_ospi_b_ctrl.spi_protocol)
+             ? g_ospi_b_direct_transfer[OSPI_B_TRANSFER_SUSPEND_SPI]
+             : g_ospi_b_direct_transfer[OSPI_B_TRANSFER_SUSPEND_OPI];
+    err = R_OSPI_B_DirectTransfer(&g_ospi_b_ctrl, &transfer, SPI_FLASH_DIRECT_TRANSFER_DIR_WRITE);
+    if (FSP_SUCCESS != err)
+    {
+        return err;
+    }
+    g_flash_engine.op_suspended = true;
+
+    for (uint32_t i = 0U; i < OSPI_FLASH_JOB_SUSPEND_US; i++)
+    {
+        err = R_OSPI_B_StatusGet(&g_ospi_b_ctrl, &status);
+        if ((FSP_SUCCESS != err) || !status.write_in_progress)
+        {
+            return err;
+        }
+        R_BSP_SoftwareDelay(1, BSP_DELAY_UNITS_MICROSECONDS);
+    }
+
+    return FSP_ERR_TIMEOUT;
+}
+
+/*******************************************************************************************************************//**
+ * @brief       Resume the suspended operation and let the engine continue.
+ * @retval      FSP_SUCCESS     Upon successful operation
+ * @retval      Any Other Error code apart from FSP_SUCCESS Unsuccessful operation
+ **********************************************************************************************************************/
+fsp_err_t ospi_flash_job_resume (void)
+{
+    fsp_err_t                   err      = FSP_SUCCESS;
+    spi_flash_direct_transfer_t transfer = {0};
+
+    if (!g_flash_engine.suspended)
+    {
+        return FSP_SUCCESS;
+    }
+
+    if (g_flash_engine.op_suspended)
+    {
+        transfer = (SPI_FLASH_PROTOCOL_EXTENDED_SPI == g_ospi_b_ctrl.spi_protocol)
+                 ? g_ospi_b_direct_transfer[OSPI_B_TRANSFER_RESUME_SPI]
+                 : g_ospi_b_direct_transfer[OSPI_B_TRANSFER_RESUME_OPI];
+        err = R_OSPI_B_DirectTransfer(&g_ospi_b_ctrl, &transfer, SPI_FLASH_DIRECT_TRANSFER_DIR_WRITE);
+        if (FSP_SUCCESS != err)
+        {
+            return err;
+        }
+        g_flash_engine.op_suspended = false;
+    }
+
+    g_flash_engine.suspended = false;
+    if (ospi_flash_job_pending())
+    {
+        ospi_flash_job_tick_start();
+    }
+
+    return err;
+}
+
+/*******************************************************************************************************************//**
+ * @brief       Advance the engine: check the operation in flight and start the next one once the device is ready.
+ *              Called from the SysTick interrupt, or by the application when OSPI_FLASH_JOB_USE_SYSTICK is 0. It must
+ *              not run concurrently with itself or with suspend/resume.
+ **********************************************************************************************************************/
+void ospi_flash_job_poll (void)
+{
+    fsp_err_t          err    = FSP_SUCCESS;
+    spi_flash_status_t status = {0};
+
+    if (!g_flash_engine.open || g_flash_engine.suspended)
+    {
+        return;
+    }
+
+    if (g_flash_engine.in_flight)
+    {
+        err = R_OSPI_B_StatusGet(&g_ospi_b_ctrl, &status);
+        if (FSP_SUCCESS == err)
+        {
+            if (status.write_in_progress)
+            {
+                if (0U != --g_flash_engine.timeout)
+                {
+                    return;
+                }
+                err = FSP_ERR_TIMEOUT;
+            }
+        }
+        g_flash_engine.in_flight = false;
+
+        if (FSP_SUCCESS != err)
+        {
+            /* The sector is not erased, a later program in it has to erase it again */
+            if (NULL != g_flash_engine.p_erase_sector)
+            {
+                g_flash_engine.p_erased_end = g_flash_engine.p_erase_sector;
+            }
+
+            if ((NULL != g_flash_engine.p_op_job) && (g_flash_engine.p_op_job == g_flash_engine.p_head))
+            {
+                ospi_flash_job_complete(err);
+            }
+            else
+            {
+                /* Erase-ahead failed, leave the sector to the job that needs it */
+                g_flash_engine.erase_ahead_held = true;
+            }
+        }
+    }
+
+    ospi_flash_job_issue();
+}
+
+#if OSPI_FLASH_JOB_USE_SYSTICK
+void SysTick_Handler (void)
+{
+    ospi_flash_job_poll();
+}
+#endif
+
+/*******************************************************************************************************************//**
+ * @brief       Start the next erase or program, completing jobs that have nothing left to do.
+ **********************************************************************************************************************/
+static void ospi_flash_job_issue (void)
+{
+    fsp_err_t          err    = FSP_SUCCESS;
+    ospi_flash_job_t * p_job  = NULL;
+    uint8_t          * p_at   = NULL;
+    uint8_t          * p_base = NULL;
+    uint32_t           step   = 0U;
+
+    while (true)
+    {
+        p_job                         = g_flash_engine.p_head;
+        g_flash_engine.p_op_job       = p_job;
+        g_flash_engine.p_erase_sector = NULL;
+        if (NULL == p_job)
+        {
+            /* Idle, erase ahead of the data that is most likely written next */
+            if ((NULL != g_flash_engine.p_region_start) && !g_flash_engine.erase_ahead_held &&
+                (g_flash_engine.p_erased_end < g_flash_engine.p_region_end) &&
+                (g_flash_engine.p_erased_end < (g_flash_engine.p_written_end + OSPI_FLASH_JOB_ERASE_AHEAD)) &&
+                (FSP_SUCCESS == ospi_flash_job_erase_start(g_flash_engine.p_erased_end)))
+            {
+                g_flash_engine.p_erase_sector = g_flash_engine.p_erased_end;
+                g_flash_engine.p_erased_end  += ospi_flash_job_sector_size(g_flash_engine.p_erased_end);
+                return;
+            }
+            ospi_flash_job_tick_stop();
+            return;
+        }
+
+        if (p_job->done >= p_job->size)
+        {
+            ospi_flash_job_complete(FSP_SUCCESS);
+            continue;
+        }
+
+        p_at = p_job->p_dest + p_job->done;
+        if (OSPI_FLASH_JOB_ERASE == p_job->type)
+        {
+            step   = ospi_flash_job_sector_size(p_at);
+            p_base = p_at - ((uint32_t) p_at % step);
+            err    = ospi_flash_job_erase_start(p_base);
+            if ((FSP_SUCCESS == err) && (p_base == g_flash_engine.p_erased_end))
+            {
+                g_flash_engine.p_erase_sector = p_base;
+                g_flash_engine.p_erased_end  += step;
+            }
+            p_job->done += step - (uint32_t) (p_at - p_base);
+        }
+        else
+        {
+            step = OSPI_FLASH_JOB_PROGRAM_SIZE - ((uint32_t) p_at % OSPI_FLASH_JOB_PROGRAM_SIZE);
+            step = (step < (p_job->size - p_job->done)) ? step : (p_job->size - p_job->done);
+            if (ospi_flash_job_in_region(p_at) && ((p_at + step) > g_flash_engine.p_erased_end))
+            {
+                /* The sector is not erased yet, erase it first and program on a later tick */
+                err = ospi_flash_job_erase_start(g_flash_engine.p_erased_end);
+                if (FSP_SUCCESS == err)
+                {
+                    g_flash_engine.p_erase_sector = g_flash_engine.p_erased_end;
+                    g_flash_engine.p_erased_end  += ospi_flash_job_sector_size(g_flash_engine.p_erased_end);
+                }
+            }
+            else
+            {
+                err = ospi_flash_job_program_start(p_job);
+            }
+        }
+
+        if (FSP_SUCCESS != err)
+        {
+            ospi_flash_job_complete(err);
+            continue;
+        }
+
+        return;
+    }
+}
+
+/*******************************************************************************************************************//**
+ * @brief       Remove the head job and report the result.
+ **********************************************************************************************************************/
+static void ospi_flash_job_complete (fsp_err_t result)
+{
+    ospi_flash_job_t * p_job = g_flash_engine.p_head;
+
+    FSP_CRITICAL_SECTION_DEFINE;
+    FSP_CRITICAL_SECTION_ENTER;
+    g_flash_engine.p_head = p_job->p_next;
+    if (NULL == g_flash_engine.p_head)
+    {
+        g_flash_engine.p_tail = NULL;
+    }
+    FSP_CRITICAL_SECTION_EXIT;
+
+    g_flash_engine.staged = 0U;
+
+    if (NULL != p_job->p_callback)
+    {
+        p_job->p_callback(p_job, result);
+    }
+}
+
+static fsp_err_t ospi_flash_job_erase_start (uint8_t * p_address)
+{
+    fsp_err_t err  = FSP_SUCCESS;
+    uint32_t  size = ospi_flash_job_sector_size(p_address);
+
+    err = R_OSPI_B_Erase(&g_ospi_b_ctrl, p_address, size);
+    if (FSP_SUCCESS == err)
+    {
+        g_flash_engine.in_flight = true;
+        g_flash_engine.timeout   = (OSPI_B_SECTOR_SIZE_256K == size) ? OSPI_FLASH_JOB_TICKS(OSPI_B_TIME_ERASE_256K)
+                                                                      : OSPI_FLASH_JOB_TICKS(OSPI_B_TIME_ERASE_4K);
+    }
+
+    return err;
+}
+
+/*******************************************************************************************************************//**
+ * @brief       Program the staged chunk of the job, then stage the following one while the device is busy.
+ **********************************************************************************************************************/
+static fsp_err_t ospi_flash_job_program_start (ospi_flash_job_t * p_job)
+{
+    fsp_err_t err   = FSP_SUCCESS;
+    uint8_t * p_buf = NULL;
+
+    if (0U == g_flash_engine.staged)
+    {
+        ospi_flash_job_stage(p_job);
+    }
+    p_buf = g_flash_engine.stage[g_flash_engine.stage_index];
+
+    err = R_OSPI_B_Write(&g_ospi_b_ctrl, p_buf, g_flash_engine.p_staged_dest, OSPI_FLASH_JOB_PROGRAM_SIZE);
+    if (FSP_SUCCESS != err)
+    {
+        return err;
+    }
+    g_flash_engine.in_flight = true;
+    g_flash_engine.timeout   = OSPI_FLASH_JOB_TICKS(OSPI_B_TIME_WRITE);
+
+    p_job->done += g_flash_engine.staged;
+    if ((p_job->p_dest + p_job->done) > g_flash_engine.p_written_end)
+    {
+        g_flash_engine.p_written_end = p_job->p_dest + p_job->done;
+    }
+
+    g_flash_engine.stage_index ^= 1U;
+    g_flash_engine.staged       = 0U;
+    if (p_job->done < p_job->size)
+    {
+        ospi_flash_job_stage(p_job);
+    }
+
+    return err;
+}
+
+/*******************************************************************************************************************//**
+ * @brief       Copy the next chunk of the job into the free staging buffer, padded with 0xFF to a whole
+ *              OSPI_FLASH_JOB_PROGRAM_SIZE block which leaves the rest of the block as it is.
+ **********************************************************************************************************************/
+static void ospi_flash_job_stage (ospi_flash_job_t * p_job)
+{
+    uint8_t * p_at  = p_job->p_dest + p_job->done;
+    uint32_t  lead  = (uint32_t) p_at % OSPI_FLASH_JOB_PROGRAM_SIZE;
+    uint32_t  chunk = OSPI_FLASH_JOB_PROGRAM_SIZE - lead;
+    uint8_t * p_buf = g_flash_engine.stage[g_flash_engine.stage_index];
+
+    chunk = (chunk < (p_job->size - p_job->done)) ? chunk : (p_job->size - p_job->done);
+    memset(p_buf, 0xFF, OSPI_FLASH_JOB_PROGRAM_SIZE);
+    memcpy(&p_buf[lead], p_job->p_src + p_job->done, chunk);
+
+    g_flash_engine.staged        = chunk;
+    g_flash_engine.p_staged_dest = p_at - lead;
+}
+
+static uint32_t ospi_flash_job_sector_size (uint8_t const * p_address)
+{
+    return (OSPI_B_SECTOR_4K_END_ADDRESS < (uint32_t) p_address) ? OSPI_B_SECTOR_SIZE_256K : OSPI_B_SECTOR_SIZE_4K;
+}
+
+static bool ospi_flash_job_in_region (uint8_t const * p_address)
+{
+    return (p_address >= g_flash_engine.p_region_start) && (p_address < g_flash_engine.p_region_end);
+}
+
+/* Anything for the tick to do, including idle erase-ahead */
+static bool ospi_flash_job_pending (void)
+{
+    return ospi_flash_job_busy() ||
+           ((NULL != g_flash_engine.p_region_start) && !g_flash_engine.erase_ahead_held &&
+            (g_flash_engine.p_erased_end < g_flash_engine.p_region_end));
+}
+
+static void ospi_flash_job_tick_start (void)
+{
+#if OSPI_FLASH_JOB_USE_SYSTICK
+    SysTick->CTRL |= SysTick_CTRL_TICKINT_Msk | SysTick_CTRL_ENABLE_Msk;
+#endif
+}
+
+static void ospi_flash_job_tick_stop (void)
+{
+#if OSPI_FLASH_JOB_USE_SYSTICK
+    SysTick->CTRL &= ~(SysTick_CTRL_TICKINT_Msk | SysTick_CTRL_ENABLE_Msk);
+#endif
+}
+
+/*******************************************************************************************************************//**
+ * @} (end addtogroup ospi_flash_job)
+ **********************************************************************************************************************/
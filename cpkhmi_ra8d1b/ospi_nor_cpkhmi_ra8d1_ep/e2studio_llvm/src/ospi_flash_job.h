@@ -0,0 +1,80 @@
+/***********************************************************************************************************************
+ * File Name    : ospi_flash_job.h
+ * Description  : Contains data structures and functions used in ospi_flash_job.c
+ **********************************************************************************************************************/
+
+/*
+* Copyright (c) 2024 Renesas Electronics Corporation and/or its affiliates
+*
+* SPDX-License-Identifier: BSD-3-Clause
+*/
+
+#ifndef OSPI_FLASH_JOB_H_
+#define OSPI_FLASH_JOB_H_
+
+#include "hal_data.h"
+
+/*******************************************************************************************************************//**
+ * @addtogroup ospi_flash_job
+ * @{
+ **********************************************************************************************************************/
+
+/******************************************************************************
+ Macro definitions
+ ******************************************************************************/
+/* The engine is driven by ospi_flash_job_poll(). With OSPI_FLASH_JOB_USE_SYSTICK it owns SysTick and polls from its
+ * interrupt while jobs are pending; set it to 0 to call ospi_flash_job_poll() from a timer callback or a task. */
+#ifndef OSPI_FLASH_JOB_USE_SYSTICK
+#define OSPI_FLASH_JOB_USE_SYSTICK      (1)
+#endif
+#define OSPI_FLASH_JOB_TICK_HZ          (20000U)    /* Status poll rate, 50us is about one 64 byte program */
+#define OSPI_FLASH_JOB_TICK_PRIORITY    (14U)       /* Keep below the display and touch interrupts */
+#define OSPI_FLASH_JOB_PROGRAM_SIZE     (64U)       /* Bytes per R_OSPI_B_Write(), the combination size of the driver */
+
+/******************************************************************************
+ Typedef definitions
+ ******************************************************************************/
+typedef enum e_ospi_flash_job_type
+{
+    OSPI_FLASH_JOB_ERASE   = 0,                     /* Erase the sectors covering p_dest .. p_dest + size */
+    OSPI_FLASH_JOB_PROGRAM = 1,                     /* Program p_src to p_dest, erasing first inside the region */
+} ospi_flash_job_type_t;
+
+typedef struct st_ospi_flash_job ospi_flash_job_t;
+
+/** Called from the poll context (the SysTick interrupt by default) when a job is finished */
+typedef void (* ospi_flash_job_callback_t)(ospi_flash_job_t * p_job, fsp_err_t result);
+
+/** Job owned by the caller. It and p_src must stay valid until the callback. Program jobs that split one stream
+ *  should break it at OSPI_FLASH_JOB_PROGRAM_SIZE boundaries, otherwise the shared block is programmed twice. */
+struct st_ospi_flash_job
+{
+    ospi_flash_job_type_t     type;
+    uint8_t                 * p_dest;               /* In the mapped window */
+    uint8_t const           * p_src;                /* Program only, RAM or internal flash */
+    uint32_t                  size;
+    ospi_flash_job_callback_t p_callback;           /* Optional */
+    void                    * p_context;
+
+    /* Private to the engine */
+    ospi_flash_job_t        * p_next;
+    uint32_t                  done;
+};
+
+/******************************************************************************
+ Function prototypes
+ ******************************************************************************/
+fsp_err_t ospi_flash_job_open (void);
+fsp_err_t ospi_flash_job_close (void);
+fsp_err_t ospi_flash_job_region_set (uint8_t * p_start, uint8_t * p_end);
+fsp_err_t ospi_flash_job_submit (ospi_flash_job_t * p_job);
+bool      ospi_flash_job_busy (void);
+fsp_err_t ospi_flash_job_suspend (void);
+fsp_err_t ospi_flash_job_resume (void);
+void      ospi_flash_job_poll (void);
+
+/*******************************************************************************************************************//**
+ * @} (end addtogroup ospi_flash_job)
+ **********************************************************************************************************************/
+
+#endif /* OSPI_FLASH_JOB_H_ */